@@ -0,0 +1,213 @@
+/**
+ * @file    benchmarkCompiledMath.cpp
+ * @brief   Compares evaluating kinetic laws with SBMLTransforms against
+ *          evaluating them compiled with CompiledMath.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <cstdlib>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/SBMLTransforms.h>
+#include <sbml/math/CompiledMath.h>
+#include <sbml/common/extern.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ * Builds a small model whose rate law calls a function definition.
+ */
+static SBMLDocument*
+createModel ()
+{
+  SBMLDocument* document = new SBMLDocument(3, 1);
+  Model* model = document->createModel();
+
+  FunctionDefinition* fd = model->createFunctionDefinition();
+  fd->setId("hill");
+  ASTNode* math = SBML_parseL3Formula("lambda(x, k, n, x^n / (k^n + x^n))");
+  fd->setMath(math);
+  delete math;
+
+  const char* ids[] = { "S", "Vmax", "Km", "K", "n", "kd" };
+  const double values[] = { 2.0, 10.0, 0.5, 1.5, 2.0, 0.1 };
+  for (unsigned int i = 0; i < 6; ++i)
+  {
+    Parameter* p = model->createParameter();
+    p->setId(ids[i]);
+    p->setValue(values[i]);
+    p->setConstant(true);
+  }
+
+  Reaction* r = model->createReaction();
+  r->setId("R");
+  KineticLaw* kl = r->createKineticLaw();
+  math = SBML_parseL3Formula(
+    "Vmax * S / (Km + S) * hill(S, K, n) - piecewise(kd * S, S > K, 0)");
+  kl->setMath(math);
+  delete math;
+
+  return document;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  if (argc > 3)
+  {
+    cout << endl << "Usage: benchmarkCompiledMath [evaluations] [filename]"
+         << endl << endl;
+    return 1;
+  }
+
+  unsigned int evaluations = 100000;
+  if (argc > 1)
+  {
+    evaluations = (unsigned int) atoi(argv[1]);
+  }
+
+  SBMLDocument* document = (argc > 2) ? readSBML(argv[2]) : createModel();
+  Model* model = document->getModel();
+  if (document->getNumErrors(LIBSBML_SEV_ERROR) > 0 || model == NULL)
+  {
+    document->printErrors(cerr);
+    delete document;
+    return 1;
+  }
+
+#ifdef __BORLANDC__
+  unsigned long start, stop;
+#else
+  unsigned long long start, stop;
+#endif
+
+  SBMLTransforms::IdValueMap modelValues;
+  SBMLTransforms::getComponentValuesForModel(model, modelValues);
+
+  cout << endl;
+  cout << setw(12) << "reaction"
+       << setw(12) << "variables"
+       << setw(18) << "transforms (ms)"
+       << setw(16) << "compiled (ms)"
+       << setw(14) << "batch (ms)" << endl;
+
+  for (unsigned int i = 0; i < model->getNumReactions(); ++i)
+  {
+    const Reaction* r = model->getReaction(i);
+    if (!r->isSetKineticLaw() || !r->getKineticLaw()->isSetMath()) continue;
+    const ASTNode* math = r->getKineticLaw()->getMath();
+
+    CompiledMath compiled(math, model);
+    unsigned int numVariables = compiled.getNumVariables();
+    vector<double> initial;
+    compiled.getInitialValues(model, initial);
+
+    // one value set per evaluation, scaling the first variable
+    vector<double> values(evaluations * numVariables);
+    for (unsigned int n = 0; n < evaluations; ++n)
+    {
+      for (unsigned int v = 0; v < numVariables; ++v)
+      {
+        values[n * numVariables + v] = initial[v];
+      }
+      if (numVariables > 0)
+      {
+        values[n * numVariables] *= 1.0 + (double)n / evaluations;
+      }
+    }
+
+    double check = 0;
+    SBMLTransforms::IdValueMap scan(modelValues);
+    start = getCurrentMillis();
+    for (unsigned int n = 0; n < evaluations; ++n)
+    {
+      for (unsigned int v = 0; v < numVariables; ++v)
+      {
+        scan[compiled.getVariable(v)] =
+          make_pair(values[n * numVariables + v], false);
+      }
+      check += SBMLTransforms::evaluateASTNode(math, scan, model);
+    }
+    stop = getCurrentMillis();
+    unsigned long long byTransforms = stop - start;
+
+    double compiledCheck = 0;
+    start = getCurrentMillis();
+    for (unsigned int n = 0; n < evaluations; ++n)
+    {
+      compiledCheck += compiled.evaluate(numVariables > 0 ?
+                                         &values[n * numVariables] : NULL);
+    }
+    stop = getCurrentMillis();
+    unsigned long long byCompiled = stop - start;
+
+    vector<double> results(evaluations);
+    start = getCurrentMillis();
+    compiled.evaluate(numVariables > 0 ? &values[0] : NULL, evaluations,
+                      &results[0]);
+    stop = getCurrentMillis();
+    unsigned long long byBatch = stop - start;
+
+    cout << setw(12) << r->getId()
+         << setw(12) << numVariables
+         << setw(18) << byTransforms
+         << setw(16) << byCompiled
+         << setw(14) << byBatch;
+    if (!(check == compiledCheck) && !(check != check))
+    {
+      cout << "  (results differ)";
+    }
+    cout << endl;
+  }
+
+  cout << endl << "(" << evaluations << " evaluations per column)" << endl
+       << endl;
+
+  delete document;
+  return 0;
+}
+
+END_C_DECLS
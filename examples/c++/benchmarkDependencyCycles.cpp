@@ -0,0 +1,213 @@
+/**
+ * @file    benchmarkDependencyCycles.cpp
+ * @brief   Measures how the checks for cycles of dependencies scale with
+ *          the length of a chain of rules and functions.
+ *
+ * Each model has a chain of assignment rules, the rule for parameter i
+ * using parameter i+1, a chain of rate rules, the rule for parameter i
+ * using the rate of parameter i+1, and a chain of function definitions,
+ * function i calling function i+1.  In the cyclic variant the last three
+ * links of each chain refer back to each other.  Only the time taken by
+ * the three checks for cycles is reported.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/validator/ValidatorProfile.h>
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+static string
+createId (const char* prefix, unsigned int index)
+{
+  ostringstream id;
+  id << prefix << index;
+  return id.str();
+}
+
+
+static void
+setFormula (Rule* rule, const string& formula)
+{
+  ASTNode* math = SBML_parseL3Formula(formula.c_str());
+  rule->setMath(math);
+  delete math;
+}
+
+
+/*
+ * Creates a model with chains of the given length, which end in a cycle
+ * if the model is to be cyclic.
+ */
+static SBMLDocument*
+createModel (unsigned int size, bool cyclic)
+{
+  SBMLDocument* document = new SBMLDocument(3, 2);
+  Model* model = document->createModel();
+
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    Parameter* p = model->createParameter();
+    p->setId(createId("a", n));
+    p->setValue(1.0);
+    p->setConstant(false);
+
+    p = model->createParameter();
+    p->setId(createId("r", n));
+    p->setValue(1.0);
+    p->setConstant(false);
+  }
+
+  // the last link of each chain either ends it, or goes back two links
+  unsigned int last = size - 1;
+  unsigned int next;
+
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    next = (n < last) ? n + 1 : (cyclic ? n - 2 : size);
+
+    AssignmentRule* assignment = model->createAssignmentRule();
+    assignment->setVariable(createId("a", n));
+    setFormula(assignment, (next < size)
+                           ? createId("a", next) + " + 1" : string("1"));
+
+    RateRule* rate = model->createRateRule();
+    rate->setVariable(createId("r", n));
+    setFormula(rate, (next < size)
+                     ? "rateOf(" + createId("r", next) + ") + 1" : string("1"));
+
+    FunctionDefinition* fd = model->createFunctionDefinition();
+    fd->setId(createId("f", n));
+    string formula = (next < size)
+                     ? "lambda(x, " + createId("f", next) + "(x) + 1)"
+                     : string("lambda(x, x)");
+    ASTNode* math = SBML_parseL3Formula(formula.c_str());
+    fd->setMath(math);
+    delete math;
+  }
+
+  document->setConsistencyChecks(LIBSBML_CAT_IDENTIFIER_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_GENERAL_CONSISTENCY, true);
+  document->setConsistencyChecks(LIBSBML_CAT_SBO_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_MATHML_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_UNITS_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_MODELING_PRACTICE, false);
+  document->setConsistencyChecks(LIBSBML_CAT_OVERDETERMINED_MODEL, false);
+
+  return document;
+}
+
+
+/*
+ * Checks the document and returns the time taken by the three checks for
+ * cycles, as recorded in a ValidatorProfile; the number of errors logged
+ * is returned in numErrors.
+ */
+static double
+timeCheck (SBMLDocument* document, unsigned int& numErrors)
+{
+  static const unsigned int cycleChecks[] = { 20303, 20906, 20912 };
+
+  ValidatorProfile profile;
+  document->setValidationProfile(&profile);
+  numErrors = document->checkConsistency();
+  document->setValidationProfile(NULL);
+
+  double time = 0;
+  for (unsigned int n = 0; n < 3; ++n)
+  {
+    int index = profile.getIndex("ConsistencyValidator", cycleChecks[n]);
+    if (index >= 0) time += profile.getTime((unsigned int)index);
+  }
+
+  return 1000 * time;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  const unsigned int largest =
+    (argc > 1) ? (unsigned int)atoi(argv[1]) : 10000;
+
+  if (largest == 0)
+  {
+    cout << endl << "Usage: benchmarkDependencyCycles [largest-chain-length]"
+         << endl << endl;
+    return 1;
+  }
+
+  cout << endl << fixed << setprecision(1);
+  cout << setw(10) << "length"
+       << setw(16) << "chain (ms)"
+       << setw(8)  << "errors"
+       << setw(16) << "cyclic (ms)"
+       << setw(8)  << "errors" << endl;
+
+  for (unsigned int size = 10; size <= largest; size *= 10)
+  {
+    unsigned int chainErrors, cyclicErrors;
+
+    SBMLDocument* document = createModel(size, false);
+    double chainTime = timeCheck(document, chainErrors);
+    delete document;
+
+    document = createModel(size, true);
+    double cyclicTime = timeCheck(document, cyclicErrors);
+    delete document;
+
+    cout << setw(10) << size
+         << setw(16) << chainTime
+         << setw(8)  << chainErrors
+         << setw(16) << cyclicTime
+         << setw(8)  << cyclicErrors << endl;
+  }
+  cout << endl;
+
+  return 0;
+}
+
+END_C_DECLS
@@ -0,0 +1,146 @@
+/**
+ * @file    benchmarkIdLookup.cpp
+ * @brief   Measures the cost of looking up model elements by identifier
+ *          against the number of elements in the model.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/common/extern.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+static string
+makeId (const char* prefix, unsigned int n)
+{
+  ostringstream id;
+  id << prefix << n;
+  return id.str();
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  unsigned int lookups = 100000;
+  if (argc > 1)
+  {
+    lookups = (unsigned int) atoi(argv[1]);
+  }
+
+  const unsigned int sizes[] = { 1000, 5000, 10000, 50000 };
+
+#ifdef __BORLANDC__
+  unsigned long start, stop;
+#else
+  unsigned long long start, stop;
+#endif
+
+  cout << endl;
+  cout << setw(10) << "species"
+       << setw(14) << "build (ms)"
+       << setw(16) << "Model (ms)"
+       << setw(18) << "Document (ms)" << endl;
+
+  for (unsigned int s = 0; s < sizeof(sizes) / sizeof(sizes[0]); ++s)
+  {
+    unsigned int size = sizes[s];
+    SBMLDocument document(3, 1);
+    Model* model = document.createModel();
+
+    // the usual way of building a model: make sure the id is free,
+    // then add the element
+    start = getCurrentMillis();
+    for (unsigned int n = 0; n < size; ++n)
+    {
+      string id = makeId("s", n);
+      if (model->getSpecies(id) != NULL) continue;
+      Species* species = model->createSpecies();
+      species->setId(id);
+      species->setCompartment("c");
+    }
+    stop = getCurrentMillis();
+    unsigned long long build = stop - start;
+
+    srand(size);
+    start = getCurrentMillis();
+    for (unsigned int n = 0; n < lookups; ++n)
+    {
+      if (model->getSpecies(makeId("s", rand() % size)) == NULL)
+      {
+        cerr << "lookup failed" << endl;
+        return 1;
+      }
+    }
+    stop = getCurrentMillis();
+    unsigned long long byModel = stop - start;
+
+    document.enableElementIdIndex(true);
+    srand(size);
+    start = getCurrentMillis();
+    for (unsigned int n = 0; n < lookups; ++n)
+    {
+      if (document.getElementBySId(makeId("s", rand() % size)) == NULL)
+      {
+        cerr << "lookup failed" << endl;
+        return 1;
+      }
+    }
+    stop = getCurrentMillis();
+    unsigned long long byDocument = stop - start;
+
+    cout << setw(10) << size
+         << setw(14) << build
+         << setw(16) << byModel
+         << setw(18) << byDocument << endl;
+  }
+
+  cout << endl << "(" << lookups << " lookups per column)" << endl << endl;
+  return 0;
+}
+
+END_C_DECLS
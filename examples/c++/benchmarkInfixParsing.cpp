@@ -0,0 +1,218 @@
+/**
+ * @file    benchmarkInfixParsing.cpp
+ * @brief   Measures how many infix formulas per second the L3 parser reads
+ *          on one thread and on several threads at once.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/common/extern.h>
+#include "util.h"
+
+#ifdef LIBSBML_USE_THREADS
+#include <thread>
+#endif
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ * Builds the n-th formula, cycling through the kinds of expressions that
+ * rate laws and assignments are commonly written with.
+ */
+static string
+createFormula (unsigned int n)
+{
+  ostringstream formula;
+  switch (n % 8)
+  {
+  case 0:
+    formula << "k" << n << " * S" << n << " * c";
+    break;
+  case 1:
+    formula << "Vmax * S" << n << " / (Km + S" << n << ")";
+    break;
+  case 2:
+    formula << "k" << n << " * (1 - exp(-" << (n % 97) << ".5e-3 * time))";
+    break;
+  case 3:
+    formula << "piecewise(S" << n << ", S" << n << " > " << n
+            << " && time < 10, 0)";
+    break;
+  case 4:
+    formula << "S" << n << "^2 / (K^2 + S" << n << "^2) + log10(" << n << ")";
+    break;
+  case 5:
+    formula << "-(a" << n << " + b" << n << ") * sin(2 * pi * time / "
+            << (n % 13 + 1) << ")";
+    break;
+  case 6:
+    formula << "max(0, k" << n << " - abs(x" << n << " - 3.25 mole))";
+    break;
+  default:
+    formula << "f(x" << n << ", " << n << "e2, !(y < z) || x >= 1)";
+    break;
+  }
+  return formula.str();
+}
+
+
+/*
+ * Parses the given range of formulas, and writes each one back out, so
+ * that the results of several runs can be compared.
+ */
+static void
+parseFormulas (const vector<string>* formulas, size_t first, size_t last,
+               vector<string>* results)
+{
+  for (size_t n = first; n < last; ++n)
+  {
+    ASTNode* math = SBML_parseL3Formula((*formulas)[n].c_str());
+    if (math == NULL)
+    {
+      char* error = SBML_getLastParseL3Error();
+      (*results)[n] = string("error: ") + error;
+      free(error);
+      continue;
+    }
+
+    char* formula = SBML_formulaToL3String(math);
+    (*results)[n] = formula;
+    free(formula);
+    delete math;
+  }
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  const unsigned int size       = (argc > 1) ? (unsigned int)atoi(argv[1]) : 200000;
+  const unsigned int numThreads = (argc > 2) ? (unsigned int)atoi(argv[2]) : 4;
+
+  if (size == 0 || numThreads == 0)
+  {
+    cout << endl << "Usage: benchmarkInfixParsing [number-of-formulas] "
+         << "[number-of-threads]" << endl << endl;
+    return 1;
+  }
+
+#ifdef __BORLANDC__
+  unsigned long start, stop;
+#else
+  unsigned long long start, stop;
+#endif
+
+  vector<string> formulas;
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    formulas.push_back(createFormula(n));
+  }
+
+  vector<string> serial(size);
+  start = getCurrentMillis();
+  parseFormulas(&formulas, 0, size, &serial);
+  stop = getCurrentMillis();
+  unsigned long long serialTime = stop - start;
+
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    if (serial[n].compare(0, 6, "error:") == 0)
+    {
+      cerr << "'" << formulas[n] << "' could not be parsed: " << serial[n]
+           << endl;
+      return 1;
+    }
+  }
+
+  cout << endl;
+  cout << setw(10) << "threads"
+       << setw(12) << "time (ms)"
+       << setw(18) << "formulas / s" << endl;
+  cout << setw(10) << 1
+       << setw(12) << serialTime
+       << setw(18) << (unsigned long long)(size * 1000.0 / (serialTime + 1))
+       << endl;
+
+#ifdef LIBSBML_USE_THREADS
+  vector<string> parallel(size);
+  vector<std::thread> threads;
+  start = getCurrentMillis();
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    size_t first = (size_t)size * t / numThreads;
+    size_t last  = (size_t)size * (t + 1) / numThreads;
+    threads.push_back(std::thread(parseFormulas, &formulas, first, last,
+                                  &parallel));
+  }
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    threads[t].join();
+  }
+  stop = getCurrentMillis();
+  unsigned long long parallelTime = stop - start;
+
+  cout << setw(10) << numThreads
+       << setw(12) << parallelTime
+       << setw(18) << (unsigned long long)(size * 1000.0 / (parallelTime + 1))
+       << endl;
+
+  if (parallel != serial)
+  {
+    cerr << "formulas parsed on several threads differ" << endl;
+    return 1;
+  }
+#else
+  cout << endl << "libSBML was built without threads, so formulas are only "
+       << "parsed on one." << endl;
+#endif
+
+  cout << endl;
+  return 0;
+}
+
+END_C_DECLS
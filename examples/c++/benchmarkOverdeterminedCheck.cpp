@@ -0,0 +1,199 @@
+/**
+ * @file    benchmarkOverdeterminedCheck.cpp
+ * @brief   Measures how the check for overdetermined models scales with
+ *          the number of algebraic rules.
+ *
+ * Each model is a chain of algebraic rules, the rule i naming the
+ * parameters i+1 and i.  Matching each rule to the first free parameter
+ * it names leaves the last rule unmatched, and the only way to match it
+ * runs back through every other rule of the chain.  The overdetermined
+ * variant adds two rules for a single parameter.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+static ASTNode*
+createName (unsigned int index)
+{
+  ostringstream id;
+  id << "p" << index;
+
+  ASTNode* name = new ASTNode(AST_NAME);
+  name->setName(id.str().c_str());
+  return name;
+}
+
+
+/*
+ * Creates a model with a chain of the given number of algebraic rules,
+ * and one more rule if it is to be overdetermined.
+ */
+static SBMLDocument*
+createModel (unsigned int size, bool overdetermined)
+{
+  SBMLDocument* document = new SBMLDocument(3, 1);
+  Model* model = document->createModel();
+
+  // the overdetermined model has two more rules and two more parameters,
+  // one of them not named by any rule, so that the equations do not
+  // outnumber the variables and the matching has to be made
+  for (unsigned int n = 0; n < size + (overdetermined ? 2 : 0); ++n)
+  {
+    ostringstream id;
+    id << "p" << n;
+
+    Parameter* p = model->createParameter();
+    p->setId(id.str());
+    p->setValue(1.0);
+    p->setConstant(false);
+  }
+
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    ASTNode* math;
+    if (n + 1 < size)
+    {
+      math = new ASTNode(AST_PLUS);
+      math->addChild(createName(n + 1));
+      math->addChild(createName(n));
+    }
+    else
+    {
+      math = createName(n);
+    }
+
+    AlgebraicRule* rule = model->createAlgebraicRule();
+    rule->setMath(math);
+    delete math;
+  }
+
+  if (overdetermined)
+  {
+    // two rules for the one parameter left over
+    for (unsigned int n = 0; n < 2; ++n)
+    {
+      ASTNode* math = createName(size);
+      AlgebraicRule* rule = model->createAlgebraicRule();
+      rule->setMath(math);
+      delete math;
+    }
+  }
+
+  document->setConsistencyChecks(LIBSBML_CAT_IDENTIFIER_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_GENERAL_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_SBO_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_MATHML_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_UNITS_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_MODELING_PRACTICE, false);
+  document->setConsistencyChecks(LIBSBML_CAT_OVERDETERMINED_MODEL, true);
+
+  return document;
+}
+
+
+/*
+ * Checks the document and returns the time taken; the number of errors
+ * logged is returned in numErrors.
+ */
+static unsigned long long
+timeCheck (SBMLDocument* document, unsigned int& numErrors)
+{
+  unsigned long long start = getCurrentMillis();
+  numErrors = document->checkConsistency();
+  unsigned long long stop = getCurrentMillis();
+
+  return stop - start;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  const unsigned int largest =
+    (argc > 1) ? (unsigned int)atoi(argv[1]) : 100000;
+
+  if (largest == 0)
+  {
+    cout << endl << "Usage: benchmarkOverdeterminedCheck [largest-number-of-rules]"
+         << endl << endl;
+    return 1;
+  }
+
+  cout << endl;
+  cout << setw(10) << "rules"
+       << setw(16) << "chain (ms)"
+       << setw(8)  << "errors"
+       << setw(24) << "overdetermined (ms)"
+       << setw(8)  << "errors" << endl;
+
+  for (unsigned int size = 100; size <= largest; size *= 10)
+  {
+    unsigned int chainErrors, overErrors;
+
+    SBMLDocument* document = createModel(size, false);
+    unsigned long long chainTime = timeCheck(document, chainErrors);
+    delete document;
+
+    document = createModel(size, true);
+    unsigned long long overTime = timeCheck(document, overErrors);
+    delete document;
+
+    cout << setw(10) << size
+         << setw(16) << chainTime
+         << setw(8)  << chainErrors
+         << setw(24) << overTime
+         << setw(8)  << overErrors << endl;
+  }
+  cout << endl;
+
+  return 0;
+}
+
+END_C_DECLS
@@ -0,0 +1,257 @@
+/**
+ * @file    benchmarkReadFile.cpp
+ * @brief   Measures the read throughput of SBMLReader on a large file,
+ *          read through a stream or memory-mapped, with several chunk sizes.
+ *
+ * Two times are reported for each setting: the time to tokenize the XML
+ * with an XMLInputStream alone, which is where the input buffer matters,
+ * and the time to read the whole SBMLDocument.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdio>
+#include <cstdlib>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/common/extern.h>
+#include <sbml/xml/XMLInputStream.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ * Writes a model with the given number of species, each consumed by its
+ * own mass-action reaction, to the given file.
+ */
+static bool
+writeModel (const char* filename, unsigned int size)
+{
+  SBMLDocument document(3, 1);
+  Model* model = document.createModel();
+  model->setId("large");
+
+  Compartment* c = model->createCompartment();
+  c->setId("c");
+  c->setSize(1.0);
+  c->setSpatialDimensions(3.0);
+  c->setConstant(true);
+
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    ostringstream sid, kid, rid;
+    sid << "s" << n;
+    kid << "k" << n;
+    rid << "r" << n;
+
+    Species* s = model->createSpecies();
+    s->setId(sid.str());
+    s->setName("species " + sid.str());
+    s->setCompartment("c");
+    s->setInitialConcentration(1.0 + n);
+    s->setHasOnlySubstanceUnits(false);
+    s->setBoundaryCondition(false);
+    s->setConstant(false);
+
+    Parameter* k = model->createParameter();
+    k->setId(kid.str());
+    k->setValue(0.1 * n);
+    k->setConstant(true);
+
+    Reaction* r = model->createReaction();
+    r->setId(rid.str());
+    r->setReversible(false);
+    r->setFast(false);
+    SpeciesReference* sr = r->createReactant();
+    sr->setSpecies(sid.str());
+    sr->setStoichiometry(1.0);
+    sr->setConstant(true);
+
+    string formula = kid.str() + " * " + sid.str() + " * c";
+    ASTNode* rate = SBML_parseL3Formula(formula.c_str());
+    r->createKineticLaw()->setMath(rate);
+    delete rate;
+  }
+
+  return writeSBMLToFile(&document, filename) == 1;
+}
+
+
+/*
+ * Tokenizes the file the given number of times and returns the fastest
+ * time.
+ */
+static unsigned long long
+timeTokenize (const char* filename, unsigned int repeats,
+              unsigned int chunkSize, size_t memoryMapThreshold)
+{
+  unsigned long long best = 0;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    unsigned long long start = getCurrentMillis();
+    XMLInputStream stream(filename, true, "", NULL, chunkSize,
+                          memoryMapThreshold);
+    while (stream.isGood() && !stream.isEOF())
+    {
+      stream.next();
+    }
+    unsigned long long stop = getCurrentMillis();
+
+    if (stream.isError())
+    {
+      cerr << "file was not tokenized correctly" << endl;
+      return 0;
+    }
+
+    if (i == 0 || stop - start < best) best = stop - start;
+  }
+
+  return best;
+}
+
+
+/*
+ * Reads the file the given number of times and returns the fastest time.
+ */
+static unsigned long long
+timeRead (SBMLReader& reader, const char* filename, unsigned int repeats,
+          unsigned int expected)
+{
+  unsigned long long best = 0;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    unsigned long long start = getCurrentMillis();
+    SBMLDocument* document = reader.readSBMLFromFile(filename);
+    unsigned long long stop = getCurrentMillis();
+
+    if (document->getNumErrors() > 0 || document->getModel() == NULL ||
+        document->getModel()->getNumSpecies() != expected)
+    {
+      cerr << "file was not read correctly" << endl;
+      document->printErrors(cerr);
+      delete document;
+      return 0;
+    }
+    delete document;
+
+    if (i == 0 || stop - start < best) best = stop - start;
+  }
+
+  return best;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  const unsigned int chunkSizes[] = { 8192, 65536, 1048576 };
+  const unsigned int size    = (argc > 1) ? (unsigned int)atoi(argv[1]) : 50000;
+  const unsigned int repeats = 3;
+  const char* filename = "benchmarkReadFile.xml";
+
+  if (size == 0)
+  {
+    cout << endl << "Usage: benchmarkReadFile [number-of-species]" << endl
+         << endl;
+    return 1;
+  }
+
+  if (!writeModel(filename, size))
+  {
+    cerr << "could not write " << filename << endl;
+    return 1;
+  }
+
+  double megabytes = getFileSize(filename) / (1024.0 * 1024.0);
+
+  cout << endl << "File: " << filename << " (" << fixed << setprecision(1)
+       << megabytes << " MB, " << size << " species)" << endl << endl;
+  cout << setw(12) << ""
+       << setw(26) << "tokenize (MB/s)"
+       << setw(26) << "document (MB/s)" << endl;
+  cout << setw(12) << "chunk size"
+       << setw(13) << "stream" << setw(13) << "mapped"
+       << setw(13) << "stream" << setw(13) << "mapped" << endl;
+
+  int result = 0;
+
+  for (unsigned int i = 0; i < sizeof(chunkSizes) / sizeof(chunkSizes[0]); ++i)
+  {
+    unsigned long long times[4];
+
+    times[0] = timeTokenize(filename, repeats, chunkSizes[i], 0);
+    times[1] = timeTokenize(filename, repeats, chunkSizes[i], 1);
+
+    SBMLReader reader;
+    reader.setChunkSize(chunkSizes[i]);
+
+    reader.setMemoryMapThreshold(0);
+    times[2] = timeRead(reader, filename, repeats, size);
+
+    reader.setMemoryMapThreshold(1);
+    times[3] = timeRead(reader, filename, repeats, size);
+
+    cout << setw(12) << chunkSizes[i];
+    for (unsigned int t = 0; t < 4; ++t)
+    {
+      if (times[t] == 0)
+      {
+        result = 1;
+        break;
+      }
+      cout << setw(13) << setprecision(1) << megabytes * 1000.0 / times[t];
+    }
+    cout << endl;
+
+    if (result != 0) break;
+  }
+
+  remove(filename);
+
+  cout << endl;
+  return result;
+}
+
+END_C_DECLS
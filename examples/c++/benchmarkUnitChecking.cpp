@@ -0,0 +1,250 @@
+/**
+ * @file    benchmarkUnitChecking.cpp
+ * @brief   Measures how the checks of units scale with the number of
+ *          reactions in a model.
+ *
+ * Each reaction of the model converts one species into the next, with a
+ * kinetic law of the form cell * k * S1 * S2 * Km / (Km + S1), and has
+ * its own parameters k and Km.  In the mismatched variant Km is given in
+ * millimolar, so that every kinetic law adds quantities whose units do
+ * not match.  Only the units consistency checks are run, and both the
+ * time taken by checkConsistency() and the part of it spent in the units
+ * constraints are reported.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/validator/ValidatorProfile.h>
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+static string
+createId (const char* prefix, unsigned int index)
+{
+  ostringstream id;
+  id << prefix << index;
+  return id.str();
+}
+
+
+static void
+addUnit (UnitDefinition* ud, UnitKind_t kind, double exponent, int scale)
+{
+  Unit* unit = ud->createUnit();
+  unit->setKind(kind);
+  unit->setExponent(exponent);
+  unit->setScale(scale);
+  unit->setMultiplier(1.0);
+}
+
+
+/*
+ * Creates a model with the given number of reactions, in which the units
+ * of Km do not match those of the species if 'mismatched' is true.
+ */
+static SBMLDocument*
+createModel (unsigned int size, bool mismatched)
+{
+  SBMLDocument* document = new SBMLDocument(3, 2);
+  Model* model = document->createModel();
+  model->setTimeUnits("second");
+  model->setSubstanceUnits("mole");
+  model->setExtentUnits("mole");
+  model->setVolumeUnits("litre");
+
+  UnitDefinition* ud = model->createUnitDefinition();
+  ud->setId("mM");
+  addUnit(ud, UNIT_KIND_MOLE, 1, mismatched ? -3 : 0);
+  addUnit(ud, UNIT_KIND_LITRE, -1, 0);
+
+  ud = model->createUnitDefinition();
+  ud->setId("per_mM_per_second");
+  addUnit(ud, UNIT_KIND_MOLE, -1, 0);
+  addUnit(ud, UNIT_KIND_LITRE, 1, 0);
+  addUnit(ud, UNIT_KIND_SECOND, -1, 0);
+
+  Compartment* c = model->createCompartment();
+  c->setId("cell");
+  c->setSize(1.0);
+  c->setSpatialDimensions(3.0);
+  c->setUnits("litre");
+  c->setConstant(true);
+
+  for (unsigned int n = 0; n <= size; ++n)
+  {
+    Species* s = model->createSpecies();
+    s->setId(createId("S", n));
+    s->setCompartment("cell");
+    s->setInitialConcentration(1.0);
+    s->setSubstanceUnits("mole");
+    s->setHasOnlySubstanceUnits(false);
+    s->setBoundaryCondition(false);
+    s->setConstant(false);
+  }
+
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    Parameter* p = model->createParameter();
+    p->setId(createId("k", n));
+    p->setValue(1.0);
+    p->setUnits("per_mM_per_second");
+    p->setConstant(true);
+
+    p = model->createParameter();
+    p->setId(createId("Km", n));
+    p->setValue(1.0);
+    p->setUnits("mM");
+    p->setConstant(true);
+
+    Reaction* r = model->createReaction();
+    r->setId(createId("R", n));
+    r->setReversible(false);
+
+    SpeciesReference* sr = r->createReactant();
+    sr->setSpecies(createId("S", n));
+    sr->setStoichiometry(1.0);
+    sr->setConstant(true);
+
+    sr = r->createProduct();
+    sr->setSpecies(createId("S", n + 1));
+    sr->setStoichiometry(1.0);
+    sr->setConstant(true);
+
+    string formula = "cell * " + createId("k", n)
+                   + " * " + createId("S", n) + " * " + createId("S", n + 1)
+                   + " * " + createId("Km", n)
+                   + " / (" + createId("Km", n) + " + " + createId("S", n) + ")";
+    ASTNode* math = SBML_parseL3Formula(formula.c_str());
+    r->createKineticLaw()->setMath(math);
+    delete math;
+  }
+
+  document->setConsistencyChecks(LIBSBML_CAT_IDENTIFIER_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_GENERAL_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_SBO_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_MATHML_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_UNITS_CONSISTENCY, true);
+  document->setConsistencyChecks(LIBSBML_CAT_MODELING_PRACTICE, false);
+  document->setConsistencyChecks(LIBSBML_CAT_OVERDETERMINED_MODEL, false);
+
+  return document;
+}
+
+
+/*
+ * Checks the document and returns the time taken by checkConsistency();
+ * the time spent in the units constraints, as recorded in a
+ * ValidatorProfile, is returned in constraintTime and the number of
+ * errors logged in numErrors.
+ */
+static double
+timeCheck (SBMLDocument* document, double& constraintTime,
+           unsigned int& numErrors)
+{
+  ValidatorProfile profile;
+  document->setValidationProfile(&profile);
+
+  double start = ValidatorProfile::now();
+  numErrors = document->checkConsistency();
+  double stop = ValidatorProfile::now();
+
+  document->setValidationProfile(NULL);
+
+  constraintTime = 1000 * profile.getValidatorTime("UnitConsistencyValidator");
+  return 1000 * (stop - start);
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  const unsigned int largest =
+    (argc > 1) ? (unsigned int)atoi(argv[1]) : 1000;
+
+  if (largest == 0)
+  {
+    cout << endl << "Usage: benchmarkUnitChecking [largest-number-of-reactions]"
+         << endl << endl;
+    return 1;
+  }
+
+  cout << endl << fixed << setprecision(1);
+  cout << setw(10) << "reactions"
+       << setw(14) << "total (ms)"
+       << setw(14) << "units (ms)"
+       << setw(8)  << "errors"
+       << setw(18) << "mismatched (ms)"
+       << setw(14) << "units (ms)"
+       << setw(8)  << "errors" << endl;
+
+  for (unsigned int size = 10; size <= largest; size *= 10)
+  {
+    double matchedUnits, mismatchedUnits;
+    unsigned int matchedErrors, mismatchedErrors;
+
+    SBMLDocument* document = createModel(size, false);
+    double matchedTime = timeCheck(document, matchedUnits, matchedErrors);
+    delete document;
+
+    document = createModel(size, true);
+    double mismatchedTime =
+      timeCheck(document, mismatchedUnits, mismatchedErrors);
+    delete document;
+
+    cout << setw(10) << size
+         << setw(14) << matchedTime
+         << setw(14) << matchedUnits
+         << setw(8)  << matchedErrors
+         << setw(18) << mismatchedTime
+         << setw(14) << mismatchedUnits
+         << setw(8)  << mismatchedErrors << endl;
+  }
+  cout << endl;
+
+  return 0;
+}
+
+END_C_DECLS
@@ -0,0 +1,156 @@
+/**
+ * @file    benchmarkUnitsDataUpdate.cpp
+ * @brief   Measures how long it takes to bring the derived units of a model
+ *          up to date after a small edit.
+ *
+ * Each reaction of the model converts one species into the next, with a
+ * kinetic law of the form cell * k * S1 * Km / (Km + S1) and its own
+ * parameters k and Km.  The program reports the time taken to derive the
+ * units of the whole model with Model::populateListFormulaUnitsData(),
+ * and the average time taken by Model::updateListFormulaUnitsData() after
+ * each of a series of edits that change either one kinetic law or the
+ * units of one parameter.  Finally it checks that the updated units are
+ * the same as those derived from scratch.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/units/FormulaUnitsData.h>
+#include <sbml/validator/ValidatorProfile.h>
+
+#include "reactionChain.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+static const unsigned int numEdits = 20;
+
+
+/*
+ * Returns true if the two models have the same derived units.
+ */
+static bool
+haveSameUnits (Model* model1, Model* model2)
+{
+  unsigned int num = model1->getNumFormulaUnitsData();
+  if (num != model2->getNumFormulaUnitsData())
+  {
+    return false;
+  }
+
+  for (unsigned int n = 0; n < num; ++n)
+  {
+    FormulaUnitsData* fud1 = model1->getFormulaUnitsData(n);
+    FormulaUnitsData* fud2 = model2->getFormulaUnitsData(n);
+
+    if (fud1->getUnitReferenceId() != fud2->getUnitReferenceId()
+      || fud1->getContainsUndeclaredUnits() 
+                                      != fud2->getContainsUndeclaredUnits()
+      || !UnitDefinition::areIdentical(fud1->getUnitDefinition(),
+                                       fud2->getUnitDefinition()))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  const unsigned int largest =
+    (argc > 1) ? (unsigned int)atoi(argv[1]) : 1000;
+
+  if (largest == 0)
+  {
+    cout << endl << "Usage: benchmarkUnitsDataUpdate [largest-number-of-reactions]"
+         << endl << endl;
+    return 1;
+  }
+
+  cout << endl << fixed << setprecision(3);
+  cout << setw(10) << "reactions"
+       << setw(16) << "populate (ms)"
+       << setw(24) << "update after edit (ms)"
+       << setw(8)  << "same" << endl;
+
+  for (unsigned int size = 10; size <= largest; size *= 10)
+  {
+    SBMLDocument* document = createModel(size);
+    Model* model = document->getModel();
+
+    double start = ValidatorProfile::now();
+    model->populateListFormulaUnitsData();
+    double populateTime = 1000 * (ValidatorProfile::now() - start);
+
+    double updateTime = 0;
+    for (unsigned int edit = 0; edit < numEdits; ++edit)
+    {
+      editModel(model, edit);
+
+      start = ValidatorProfile::now();
+      model->updateListFormulaUnitsData();
+      updateTime += 1000 * (ValidatorProfile::now() - start);
+    }
+
+    Model* copy = model->clone();
+    copy->populateListFormulaUnitsData();
+    bool same = haveSameUnits(model, copy);
+    delete copy;
+    delete document;
+
+    cout << setw(10) << size
+         << setw(16) << populateTime
+         << setw(24) << updateTime / numEdits
+         << setw(8)  << (same ? "yes" : "no") << endl;
+  }
+  cout << endl;
+
+  return 0;
+}
+
+END_C_DECLS
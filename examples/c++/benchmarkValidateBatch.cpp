@@ -0,0 +1,236 @@
+/**
+ * @file    benchmarkValidateBatch.cpp
+ * @brief   Measures how fast libSBML checks the consistency of many small
+ *          models, one after the other.
+ *
+ * Each model is checked once with the validators created and initialized
+ * for it alone, as libSBML used to, and once with the initialized
+ * validators that are kept between documents.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+#include <cstdlib>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/validator/ValidatorCache.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ * Creates a small, valid model of a few species converted by mass action,
+ * varied slightly by the given index.
+ */
+static SBMLDocument*
+createModel (unsigned int index)
+{
+  SBMLDocument* document = new SBMLDocument(3, 1);
+  Model* model = document->createModel();
+
+  ostringstream id;
+  id << "model" << index;
+  model->setId(id.str());
+  model->setTimeUnits("second");
+  model->setSubstanceUnits("mole");
+  model->setExtentUnits("mole");
+  model->setVolumeUnits("litre");
+
+  UnitDefinition* ud = model->createUnitDefinition();
+  ud->setId("per_second");
+  Unit* u = ud->createUnit();
+  u->setKind(UNIT_KIND_SECOND);
+  u->setExponent(-1);
+  u->setScale(0);
+  u->setMultiplier(1);
+
+  Compartment* c = model->createCompartment();
+  c->setId("cell");
+  c->setSize(1.0);
+  c->setSpatialDimensions(3.0);
+  c->setUnits("litre");
+  c->setConstant(true);
+
+  const unsigned int numSpecies = 3 + index % 4;
+  for (unsigned int n = 0; n < numSpecies; ++n)
+  {
+    ostringstream sid, kid;
+    sid << "S" << n;
+    kid << "k" << n;
+
+    Species* s = model->createSpecies();
+    s->setId(sid.str());
+    s->setCompartment("cell");
+    s->setInitialAmount(n == 0 ? 10.0 : 0.0);
+    s->setSubstanceUnits("mole");
+    s->setHasOnlySubstanceUnits(true);
+    s->setBoundaryCondition(false);
+    s->setConstant(false);
+
+    if (n + 1 == numSpecies) break;
+
+    Parameter* k = model->createParameter();
+    k->setId(kid.str());
+    k->setValue(0.1 * (n + 1));
+    k->setUnits("per_second");
+    k->setConstant(true);
+  }
+
+  for (unsigned int n = 0; n + 1 < numSpecies; ++n)
+  {
+    ostringstream rid, reactant, product, law;
+    rid << "R" << n;
+    reactant << "S" << n;
+    product << "S" << n + 1;
+    law << "k" << n << " * " << reactant.str();
+
+    Reaction* r = model->createReaction();
+    r->setId(rid.str());
+    r->setReversible(false);
+    r->setFast(false);
+
+    SpeciesReference* sr = r->createReactant();
+    sr->setSpecies(reactant.str());
+    sr->setStoichiometry(1.0);
+    sr->setConstant(true);
+
+    sr = r->createProduct();
+    sr->setSpecies(product.str());
+    sr->setStoichiometry(1.0);
+    sr->setConstant(true);
+
+    KineticLaw* kl = r->createKineticLaw();
+    ASTNode* math = SBML_parseL3Formula(law.str().c_str());
+    kl->setMath(math);
+    delete math;
+  }
+
+  return document;
+}
+
+
+/*
+ * Checks the consistency of each document, emptying the cache of
+ * validators before each one if asked to, and returns the time taken.
+ */
+static unsigned long long
+timeBatch (const vector<SBMLDocument*>& documents, bool fresh,
+           unsigned int& numErrors)
+{
+  numErrors = 0;
+
+  unsigned long long start = getCurrentMillis();
+  for (size_t n = 0; n < documents.size(); ++n)
+  {
+    if (fresh) ValidatorCache::clear();
+
+    SBMLDocument* document = documents[n];
+    document->getErrorLog()->clearLog();
+    numErrors += document->checkConsistency();
+    numErrors += document->checkInternalConsistency();
+  }
+  unsigned long long stop = getCurrentMillis();
+
+  return stop - start;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  const unsigned int size    = (argc > 1) ? (unsigned int)atoi(argv[1]) : 2000;
+  const unsigned int repeats = 3;
+
+  if (size == 0)
+  {
+    cout << endl << "Usage: benchmarkValidateBatch [number-of-models]" << endl
+         << endl;
+    return 1;
+  }
+
+  vector<SBMLDocument*> documents;
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    SBMLDocument* document = createModel(n);
+    document->setConsistencyChecks(LIBSBML_CAT_UNITS_CONSISTENCY, true);
+    documents.push_back(document);
+  }
+
+  unsigned long long freshTime = 0, cachedTime = 0;
+  unsigned int freshErrors = 0, cachedErrors = 0;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    unsigned long long t = timeBatch(documents, true, freshErrors);
+    if (i == 0 || t < freshTime) freshTime = t;
+
+    t = timeBatch(documents, false, cachedErrors);
+    if (i == 0 || t < cachedTime) cachedTime = t;
+  }
+
+  for (size_t n = 0; n < documents.size(); ++n)
+  {
+    delete documents[n];
+  }
+
+  cout << endl << "Checking the consistency of " << size << " small models"
+       << endl << endl;
+  cout << "  " << setw(24) << left << "validators per model" << right
+       << setw(8) << freshTime << " ms  (" << freshErrors << " errors)"
+       << endl;
+  cout << "  " << setw(24) << left << "validators reused" << right
+       << setw(8) << cachedTime << " ms  (" << cachedErrors << " errors)"
+       << endl;
+  if (cachedTime > 0)
+  {
+    cout << endl << "  " << fixed << setprecision(1)
+         << 1000.0 * size / cachedTime << " models/s with reuse, "
+         << (double)freshTime / cachedTime << " times as many" << endl;
+  }
+  cout << endl;
+
+  return 0;
+}
+
+END_C_DECLS
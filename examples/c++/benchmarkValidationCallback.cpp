@@ -0,0 +1,204 @@
+/**
+ * @file    benchmarkValidationCallback.cpp
+ * @brief   Measures how soon the failures of a badly broken model are
+ *          reported with and without a ValidationCallback.
+ *
+ * Each reaction of the model has a kinetic law k * S that uses a
+ * parameter k that is never declared, so that checking the model finds
+ * one failure per reaction.  The program reports the time taken by
+ * SBMLDocument::checkConsistency() without a callback, after which all
+ * the failures can be read at once; the time until a ValidationCallback
+ * is given the first failure; and the time taken by a check that a
+ * callback stops after its first 100 failures.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/validator/ValidationCallback.h>
+#include <sbml/validator/ValidatorProfile.h>
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+static string
+createId (const char* prefix, unsigned int index)
+{
+  ostringstream id;
+  id << prefix << index;
+  return id.str();
+}
+
+
+/*
+ * Creates a model with the given number of reactions, each of which uses
+ * an undeclared parameter.
+ */
+static SBMLDocument*
+createModel (unsigned int size)
+{
+  SBMLDocument* document = new SBMLDocument(3, 2);
+  Model* model = document->createModel();
+
+  Compartment* c = model->createCompartment();
+  c->setId("cell");
+  c->setSize(1.0);
+  c->setSpatialDimensions(3.0);
+  c->setConstant(true);
+
+  for (unsigned int n = 0; n <= size; ++n)
+  {
+    Species* s = model->createSpecies();
+    s->setId(createId("S", n));
+    s->setCompartment("cell");
+    s->setInitialConcentration(1.0);
+    s->setHasOnlySubstanceUnits(false);
+    s->setBoundaryCondition(false);
+    s->setConstant(false);
+  }
+
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    Reaction* r = model->createReaction();
+    r->setId(createId("R", n));
+    r->setReversible(false);
+
+    SpeciesReference* sr = r->createReactant();
+    sr->setSpecies(createId("S", n));
+    sr->setStoichiometry(1.0);
+    sr->setConstant(true);
+
+    sr = r->createProduct();
+    sr->setSpecies(createId("S", n + 1));
+    sr->setStoichiometry(1.0);
+    sr->setConstant(true);
+
+    string formula = createId("k", n) + " * " + createId("S", n);
+    ASTNode* math = SBML_parseL3Formula(formula.c_str());
+    r->createKineticLaw()->setMath(math);
+    delete math;
+  }
+
+  return document;
+}
+
+
+/*
+ * Notes the time at which the first failure is given to it.
+ */
+class FirstFailure : public ValidationCallback
+{
+public:
+
+  FirstFailure () : mTime(0) { }
+
+  virtual int process (const SBMLError&)
+  {
+    if (getNumReported() == 1)
+    {
+      mTime = ValidatorProfile::now();
+    }
+    return LIBSBML_OPERATION_SUCCESS;
+  }
+
+  double mTime;
+};
+
+
+int
+main (int argc, char* argv[])
+{
+  const unsigned int largest =
+    (argc > 1) ? (unsigned int)atoi(argv[1]) : 10000;
+
+  if (largest == 0)
+  {
+    cout << endl << "Usage: benchmarkValidationCallback [largest-number-of-reactions]"
+         << endl << endl;
+    return 1;
+  }
+
+  cout << endl << fixed << setprecision(3);
+  cout << setw(10) << "reactions"
+       << setw(14) << "full (ms)"
+       << setw(10) << "errors"
+       << setw(20) << "first failure (ms)"
+       << setw(20) << "first 100 (ms)" << endl;
+
+  for (unsigned int size = 10; size <= largest; size *= 10)
+  {
+    SBMLDocument* document = createModel(size);
+    double start = ValidatorProfile::now();
+    unsigned int errors = document->checkConsistency();
+    double fullTime = 1000 * (ValidatorProfile::now() - start);
+    delete document;
+
+    FirstFailure callback;
+    document = createModel(size);
+    document->setValidationCallback(&callback);
+    start = ValidatorProfile::now();
+    document->checkConsistency();
+    double firstTime = 1000 * (callback.mTime - start);
+    delete document;
+
+    callback.setMaxErrors(100);
+    document = createModel(size);
+    document->setValidationCallback(&callback);
+    start = ValidatorProfile::now();
+    document->checkConsistency();
+    double stoppedTime = 1000 * (ValidatorProfile::now() - start);
+    delete document;
+
+    cout << setw(10) << size
+         << setw(14) << fullTime
+         << setw(10) << errors
+         << setw(20) << firstTime
+         << setw(20) << stoppedTime << endl;
+  }
+  cout << endl;
+
+  return 0;
+}
+
+END_C_DECLS
@@ -0,0 +1,221 @@
+/**
+ * @file    benchmarkWideMath.cpp
+ * @brief   Measures reading, formatting, parsing and unit checking of
+ *          math with very wide n-ary plus and times nodes.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/common/extern.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ * Builds a model with one reaction whose rate law is the product of a
+ * rate constant, a sum of width species and a product of width numbers.
+ */
+static SBMLDocument*
+createModel (unsigned int width)
+{
+  SBMLDocument* document = new SBMLDocument(3, 1);
+  Model* model = document->createModel();
+  model->setSubstanceUnits("mole");
+  model->setTimeUnits("second");
+  model->setExtentUnits("mole");
+
+  Compartment* c = model->createCompartment();
+  c->setId("c");
+  c->setSize(1.0);
+  c->setSpatialDimensions(3.0);
+  c->setUnits("litre");
+  c->setConstant(true);
+
+  ASTNode sum(AST_PLUS);
+  ASTNode product(AST_TIMES);
+  for (unsigned int n = 0; n < width; ++n)
+  {
+    ostringstream id;
+    id << "s" << n;
+
+    Species* s = model->createSpecies();
+    s->setId(id.str());
+    s->setCompartment("c");
+    s->setInitialAmount(1.0);
+    s->setSubstanceUnits("mole");
+    s->setHasOnlySubstanceUnits(true);
+    s->setBoundaryCondition(false);
+    s->setConstant(false);
+
+    ASTNode* name = new ASTNode(AST_NAME);
+    name->setName(id.str().c_str());
+    sum.addChild(name);
+
+    ASTNode* one = new ASTNode(AST_REAL);
+    one->setValue(1.0);
+    one->setUnits("dimensionless");
+    product.addChild(one);
+  }
+
+  Parameter* k = model->createParameter();
+  k->setId("k");
+  k->setValue(0.1);
+  k->setUnits("per_second");
+  k->setConstant(true);
+
+  UnitDefinition* ud = model->createUnitDefinition();
+  ud->setId("per_second");
+  Unit* u = ud->createUnit();
+  u->setKind(UNIT_KIND_SECOND);
+  u->setExponent(-1);
+  u->setScale(0);
+  u->setMultiplier(1.0);
+
+  ASTNode* rate = new ASTNode(AST_TIMES);
+  ASTNode* kname = new ASTNode(AST_NAME);
+  kname->setName("k");
+  rate->addChild(kname);
+  rate->addChild(sum.deepCopy());
+  rate->addChild(product.deepCopy());
+
+  Reaction* r = model->createReaction();
+  r->setId("R");
+  r->setReversible(false);
+  r->setFast(false);
+  SpeciesReference* sr = r->createReactant();
+  sr->setSpecies("s0");
+  sr->setStoichiometry(1.0);
+  sr->setConstant(true);
+  KineticLaw* kl = r->createKineticLaw();
+  kl->setMath(rate);
+  delete rate;
+
+  return document;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  const unsigned int widths[] = { 1000, 5000, 20000 };
+
+#ifdef __BORLANDC__
+  unsigned long start, stop;
+#else
+  unsigned long long start, stop;
+#endif
+
+  cout << endl;
+  cout << setw(10) << "children"
+       << setw(12) << "read (ms)"
+       << setw(14) << "infix (ms)"
+       << setw(14) << "parse (ms)"
+       << setw(14) << "units (ms)" << endl;
+
+  for (unsigned int w = 0; w < sizeof(widths) / sizeof(widths[0]); ++w)
+  {
+    unsigned int width = widths[w];
+    SBMLDocument* document = createModel(width);
+    const ASTNode* math =
+      document->getModel()->getReaction(0)->getKineticLaw()->getMath();
+    string sbml = writeSBMLToStdString(document);
+
+    // MathML <plus/> and <times/> are read as chains of binary nodes
+    start = getCurrentMillis();
+    SBMLDocument* read = readSBMLFromString(sbml.c_str());
+    stop = getCurrentMillis();
+    unsigned long long readTime = stop - start;
+    delete read;
+
+    start = getCurrentMillis();
+    char* formula = SBML_formulaToL3String(math);
+    stop = getCurrentMillis();
+    unsigned long long infixTime = stop - start;
+
+    // the infix parser keeps the operators n-ary
+    start = getCurrentMillis();
+    ASTNode* parsed = SBML_parseL3Formula(formula);
+    stop = getCurrentMillis();
+    unsigned long long parseTime = stop - start;
+    free(formula);
+
+    if (parsed == NULL || parsed->getNumChildren() != 3 ||
+        parsed->getChild(1)->getNumChildren() != width)
+    {
+      cerr << "formula was not parsed correctly" << endl;
+      delete parsed;
+      delete document;
+      return 1;
+    }
+    delete parsed;
+
+    document->setConsistencyChecks(LIBSBML_CAT_GENERAL_CONSISTENCY, false);
+    document->setConsistencyChecks(LIBSBML_CAT_IDENTIFIER_CONSISTENCY, false);
+    document->setConsistencyChecks(LIBSBML_CAT_MATHML_CONSISTENCY, false);
+    document->setConsistencyChecks(LIBSBML_CAT_SBO_CONSISTENCY, false);
+    document->setConsistencyChecks(LIBSBML_CAT_OVERDETERMINED_MODEL, false);
+    document->setConsistencyChecks(LIBSBML_CAT_MODELING_PRACTICE, false);
+    document->setConsistencyChecks(LIBSBML_CAT_UNITS_CONSISTENCY, true);
+
+    start = getCurrentMillis();
+    document->checkConsistency();
+    stop = getCurrentMillis();
+    unsigned long long unitsTime = stop - start;
+
+    cout << setw(10) << width
+         << setw(12) << readTime
+         << setw(14) << infixTime
+         << setw(14) << parseTime
+         << setw(14) << unitsTime << endl;
+
+    delete document;
+  }
+
+  cout << endl;
+  return 0;
+}
+
+END_C_DECLS
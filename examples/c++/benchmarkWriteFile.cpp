@@ -0,0 +1,256 @@
+/**
+ * @file    benchmarkWriteFile.cpp
+ * @brief   Measures how fast libSBML formats doubles and writes a model
+ *          that is made up mostly of numeric attributes.
+ *
+ * The first part compares the stream formatting libSBML used to write
+ * doubles with XMLOutputStream::formatDouble.  The second part reports the
+ * throughput of writeSBMLToString on a model with many numeric values.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <locale>
+#include <vector>
+#include <cstdlib>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/common/common.h>
+#include <sbml/xml/XMLOutputStream.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+/*
+ * Returns a mix of values as they turn up in models: short decimals,
+ * integers, and results of arithmetic that need all their digits.
+ */
+static vector<double>
+createValues (unsigned int size)
+{
+  vector<double> values;
+  values.reserve(size);
+
+  srand(1);
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    switch (n % 4)
+    {
+    case 0:  values.push_back((rand() % 100000) / 1000.0);      break;
+    case 1:  values.push_back((double)(rand() % 1000));         break;
+    case 2:  values.push_back(rand() / (double)RAND_MAX);       break;
+    default: values.push_back((rand() % 1000) * 1e-9 + 1e-12); break;
+    }
+  }
+
+  return values;
+}
+
+
+/*
+ * Formats the values the way XMLOutputStream used to, and returns the
+ * time taken.
+ */
+static unsigned long long
+timeStream (const vector<double>& values, size_t& length)
+{
+  ostringstream output;
+  output.imbue(locale::classic());
+
+  unsigned long long start = getCurrentMillis();
+  for (size_t n = 0; n < values.size(); ++n)
+  {
+    output.precision(LIBSBML_DOUBLE_PRECISION);
+    output << values[n] << ' ';
+  }
+  unsigned long long stop = getCurrentMillis();
+
+  length = output.str().size();
+  return stop - start;
+}
+
+
+/*
+ * Formats the values with XMLOutputStream::formatDouble, and returns the
+ * time taken.
+ */
+static unsigned long long
+timeFormatDouble (const vector<double>& values, size_t& length)
+{
+  string output;
+  char buffer[XMLOutputStream::DOUBLE_BUFFER_SIZE];
+
+  unsigned long long start = getCurrentMillis();
+  for (size_t n = 0; n < values.size(); ++n)
+  {
+    output.append(buffer, XMLOutputStream::formatDouble(buffer, values[n]));
+    output += ' ';
+  }
+  unsigned long long stop = getCurrentMillis();
+
+  length = output.size();
+  return stop - start;
+}
+
+
+/*
+ * Creates a model whose species, parameters and reactions carry numeric
+ * attributes taken from the given values.
+ */
+static SBMLDocument*
+createModel (const vector<double>& values)
+{
+  SBMLDocument* document = new SBMLDocument(3, 1);
+  Model* model = document->createModel();
+  model->setId("numbers");
+
+  Compartment* c = model->createCompartment();
+  c->setId("c");
+  c->setSize(1.0);
+  c->setSpatialDimensions(3.0);
+  c->setConstant(true);
+
+  for (size_t n = 0; n + 2 < values.size(); n += 3)
+  {
+    ostringstream sid, kid, rid;
+    sid << "s" << n;
+    kid << "k" << n;
+    rid << "r" << n;
+
+    Species* s = model->createSpecies();
+    s->setId(sid.str());
+    s->setCompartment("c");
+    s->setInitialConcentration(values[n]);
+    s->setHasOnlySubstanceUnits(false);
+    s->setBoundaryCondition(false);
+    s->setConstant(false);
+
+    Parameter* k = model->createParameter();
+    k->setId(kid.str());
+    k->setValue(values[n + 1]);
+    k->setConstant(true);
+
+    Reaction* r = model->createReaction();
+    r->setId(rid.str());
+    r->setReversible(false);
+    SpeciesReference* sr = r->createReactant();
+    sr->setSpecies(sid.str());
+    sr->setStoichiometry(values[n + 2]);
+    sr->setConstant(true);
+  }
+
+  return document;
+}
+
+
+int
+main (int argc, char* argv[])
+{
+  const unsigned int size    = (argc > 1) ? (unsigned int)atoi(argv[1]) : 300000;
+  const unsigned int repeats = 3;
+
+  if (size == 0)
+  {
+    cout << endl << "Usage: benchmarkWriteFile [number-of-values]" << endl
+         << endl;
+    return 1;
+  }
+
+  vector<double> values = createValues(size);
+
+  size_t streamLength = 0, formatLength = 0;
+  unsigned long long streamTime = 0, formatTime = 0;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    unsigned long long t = timeStream(values, streamLength);
+    if (i == 0 || t < streamTime) streamTime = t;
+
+    t = timeFormatDouble(values, formatLength);
+    if (i == 0 || t < formatTime) formatTime = t;
+  }
+
+  cout << endl << "Formatting " << size << " doubles" << endl << endl;
+  cout << "  " << setw(16) << left << "ostream" << right << setw(8)
+       << streamTime << " ms  (" << streamLength << " bytes)" << endl;
+  cout << "  " << setw(16) << left << "formatDouble" << right << setw(8)
+       << formatTime << " ms  (" << formatLength << " bytes)" << endl;
+
+  SBMLDocument* document = createModel(values);
+  unsigned long long writeTime = 0;
+  size_t length = 0;
+
+  for (unsigned int i = 0; i < repeats; ++i)
+  {
+    unsigned long long start = getCurrentMillis();
+    char* text = writeSBMLToString(document);
+    unsigned long long stop = getCurrentMillis();
+
+    if (text == NULL)
+    {
+      cerr << "the model could not be written" << endl;
+      delete document;
+      return 1;
+    }
+
+    length = strlen(text);
+    free(text);
+
+    if (i == 0 || stop - start < writeTime) writeTime = stop - start;
+  }
+
+  delete document;
+
+  cout << endl << "Writing a model of " << fixed << setprecision(1)
+       << length / (1024.0 * 1024.0) << " MB: " << writeTime << " ms";
+  if (writeTime > 0)
+  {
+    cout << " (" << length / (1024.0 * 1024.0) * 1000.0 / writeTime
+         << " MB/s)";
+  }
+  cout << endl << endl;
+
+  return 0;
+}
+
+END_C_DECLS
@@ -0,0 +1,312 @@
+/**
+ * @file    benchmarkFlattening.cpp
+ * @brief   Measures the time taken to flatten a deep and wide hierarchy of
+ *          submodels.
+ *
+ * The program builds a comp model of the given depth in which every model
+ * above the bottom level holds the given number of submodels of the model
+ * one level down, with the compartment of each submodel replaced by the
+ * compartment of its parent.  The model at the bottom has a chain of
+ * reactions, each with a kinetic law k * S, so that every instance of it
+ * has many identifiers to rename and many references to them.  The
+ * program reports the time the "flatten comp" converter takes for bottom
+ * models of 10, 100, ... reactions.  Given a number of threads, it also
+ * flattens each model on that many threads and checks that the flat
+ * model is the same.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <cstdlib>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/conversion/SBMLConverterRegistry.h>
+#include <sbml/validator/ValidatorProfile.h>
+
+#ifdef LIBSBML_HAS_PACKAGE_COMP
+#include <sbml/packages/comp/common/CompExtensionTypes.h>
+#endif
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+#ifdef LIBSBML_HAS_PACKAGE_COMP
+
+static string
+createId (const char* prefix, unsigned int index)
+{
+  ostringstream id;
+  id << prefix << index;
+  return id.str();
+}
+
+
+static Compartment*
+createCompartment (Model* model)
+{
+  Compartment* c = model->createCompartment();
+  c->setId("cell");
+  c->setSize(1.0);
+  c->setSpatialDimensions(3.0);
+  c->setConstant(true);
+  return c;
+}
+
+
+/*
+ * Fills the given model with a chain of the given number of reactions.
+ */
+static void
+createBottomModel (Model* model, unsigned int size)
+{
+  createCompartment(model);
+
+  for (unsigned int n = 0; n <= size; ++n)
+  {
+    Species* s = model->createSpecies();
+    s->setId(createId("S", n));
+    s->setCompartment("cell");
+    s->setInitialConcentration(1.0);
+    s->setHasOnlySubstanceUnits(false);
+    s->setBoundaryCondition(false);
+    s->setConstant(false);
+  }
+
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    Parameter* k = model->createParameter();
+    k->setId(createId("k", n));
+    k->setValue(0.1);
+    k->setConstant(true);
+
+    Reaction* r = model->createReaction();
+    r->setId(createId("R", n));
+    r->setReversible(false);
+
+    SpeciesReference* sr = r->createReactant();
+    sr->setSpecies(createId("S", n));
+    sr->setStoichiometry(1.0);
+    sr->setConstant(true);
+
+    sr = r->createProduct();
+    sr->setSpecies(createId("S", n + 1));
+    sr->setStoichiometry(1.0);
+    sr->setConstant(true);
+
+    string formula = createId("k", n) + " * " + createId("S", n);
+    ASTNode* math = SBML_parseL3Formula(formula.c_str());
+    r->createKineticLaw()->setMath(math);
+    delete math;
+  }
+}
+
+
+/*
+ * Fills the given model with 'width' submodels of the model 'modelRef',
+ * each of which has its compartment replaced by the one of this model.
+ */
+static void
+createUpperModel (Model* model, const string& modelRef, unsigned int width)
+{
+  Compartment* c = createCompartment(model);
+  CompSBasePlugin* cplug =
+    static_cast<CompSBasePlugin*>(c->getPlugin("comp"));
+  CompModelPlugin* mplug =
+    static_cast<CompModelPlugin*>(model->getPlugin("comp"));
+
+  for (unsigned int n = 0; n < width; ++n)
+  {
+    Submodel* submodel = mplug->createSubmodel();
+    submodel->setId(createId("sub", n));
+    submodel->setModelRef(modelRef);
+
+    ReplacedElement* re = cplug->createReplacedElement();
+    re->setSubmodelRef(submodel->getId());
+    re->setIdRef("cell");
+  }
+}
+
+
+/*
+ * Creates a document of the given depth, in which every model but the
+ * bottom one has 'width' submodels.
+ */
+static SBMLDocument*
+createDocument (unsigned int width, unsigned int depth, unsigned int size)
+{
+  SBMLNamespaces sbmlns(3, 1, "comp", 1);
+  SBMLDocument* document = new SBMLDocument(&sbmlns);
+  document->setPackageRequired("comp", true);
+  CompSBMLDocumentPlugin* dplug =
+    static_cast<CompSBMLDocumentPlugin*>(document->getPlugin("comp"));
+
+  ModelDefinition* bottom = dplug->createModelDefinition();
+  bottom->setId("level0");
+  createBottomModel(bottom, size);
+
+  for (unsigned int level = 1; level < depth; ++level)
+  {
+    ModelDefinition* md = dplug->createModelDefinition();
+    md->setId(createId("level", level));
+    createUpperModel(md, createId("level", level - 1), width);
+  }
+
+  Model* model = document->createModel();
+  model->setId("top");
+  createUpperModel(model, createId("level", depth - 1), width);
+
+  return document;
+}
+
+
+/*
+ * Flattens the document on the given number of threads, and returns the
+ * time taken in milliseconds, or a negative number if flattening failed.
+ */
+static double
+flatten (SBMLDocument* document, unsigned int threads)
+{
+  ConversionProperties props;
+  props.addOption("flatten comp");
+  props.addOption("performValidation", false);
+  props.addOption("numThreads", (int)threads);
+
+  SBMLConverter* converter =
+    SBMLConverterRegistry::getInstance().getConverterFor(props);
+  converter->setDocument(document);
+
+  double start = ValidatorProfile::now();
+  int result = converter->convert();
+  double time = 1000 * (ValidatorProfile::now() - start);
+  delete converter;
+
+  if (result != LIBSBML_OPERATION_SUCCESS)
+  {
+    cerr << "Flattening failed:" << endl;
+    document->printErrors(cerr);
+    return -1;
+  }
+
+  return time;
+}
+
+#endif  /* LIBSBML_HAS_PACKAGE_COMP */
+
+
+int
+main (int argc, char* argv[])
+{
+#ifdef LIBSBML_HAS_PACKAGE_COMP
+  const unsigned int width =
+    (argc > 1) ? (unsigned int)atoi(argv[1]) : 8;
+  const unsigned int depth =
+    (argc > 2) ? (unsigned int)atoi(argv[2]) : 3;
+  const unsigned int largest =
+    (argc > 3) ? (unsigned int)atoi(argv[3]) : 100;
+  const unsigned int threads =
+    (argc > 4) ? (unsigned int)atoi(argv[4]) : 1;
+
+  if (width == 0 || depth == 0 || largest == 0 || threads == 0)
+  {
+    cout << endl << "Usage: benchmarkFlattening [width] [depth] "
+         << "[largest-number-of-reactions] [threads]" << endl << endl;
+    return 1;
+  }
+
+  unsigned int instances = 1;
+  for (unsigned int level = 0; level < depth; ++level)
+  {
+    instances *= width;
+  }
+
+  cout << endl << instances << " instances of the bottom model"
+       << endl << endl << fixed << setprecision(3);
+  cout << setw(10) << "reactions"
+       << setw(12) << "elements"
+       << setw(16) << "flatten (ms)";
+  if (threads > 1)
+  {
+    ostringstream heading;
+    heading << threads << " threads (ms)";
+    cout << setw(20) << heading.str() << setw(8) << "same";
+  }
+  cout << endl;
+
+  for (unsigned int size = 10; size <= largest; size *= 10)
+  {
+    SBMLDocument* document = createDocument(width, depth, size);
+    SBMLDocument* copy = (threads > 1) ? document->clone() : NULL;
+
+    double time = flatten(document, 1);
+    double threadedTime = (copy != NULL) ? flatten(copy, threads) : 0;
+
+    if (time < 0 || threadedTime < 0)
+    {
+      delete document;
+      delete copy;
+      return 1;
+    }
+
+    List* elements = document->getModel()->getAllElements();
+    unsigned int numElements = elements->getSize();
+    delete elements;
+
+    cout << setw(10) << size
+         << setw(12) << numElements
+         << setw(16) << time;
+    if (copy != NULL)
+    {
+      bool same = writeSBMLToStdString(document) == writeSBMLToStdString(copy);
+      cout << setw(20) << threadedTime << setw(8) << (same ? "yes" : "NO");
+    }
+    cout << endl;
+
+    delete document;
+    delete copy;
+  }
+  cout << endl;
+
+  return 0;
+#else
+  cerr << "The version of libsbml being used does not have the comp"
+       << " package code enabled" << endl;
+  return 1;
+#endif
+}
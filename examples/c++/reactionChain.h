@@ -0,0 +1,191 @@
+/**
+ * @file    reactionChain.h
+ * @brief   The model edited by the benchmarks of incremental updates
+ *
+ * The model is a chain of reactions, each of which converts one species
+ * into the next, with a kinetic law of the form
+ * cell * k * S1 * Km / (Km + S1) and its own parameters k and Km.
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#ifndef reactionChain_h
+#define reactionChain_h
+
+#include <sstream>
+#include <string>
+
+#include <sbml/SBMLTypes.h>
+
+LIBSBML_CPP_NAMESPACE_USE
+
+
+static std::string
+createId (const char* prefix, unsigned int index)
+{
+  std::ostringstream id;
+  id << prefix << index;
+  return id.str();
+}
+
+
+static void
+addUnit (UnitDefinition* ud, UnitKind_t kind, double exponent)
+{
+  Unit* unit = ud->createUnit();
+  unit->setKind(kind);
+  unit->setExponent(exponent);
+  unit->setScale(0);
+  unit->setMultiplier(1.0);
+}
+
+
+static void
+setKineticLaw (Reaction* r, unsigned int n, bool withKm)
+{
+  std::string formula = "cell * " + createId("k", n) + " * " + createId("S", n);
+  if (withKm)
+  {
+    formula += " * " + createId("Km", n)
+             + " / (" + createId("Km", n) + " + " + createId("S", n) + ")";
+  }
+
+  ASTNode* math = SBML_parseL3Formula(formula.c_str());
+  r->getKineticLaw()->setMath(math);
+  delete math;
+}
+
+
+/*
+ * Creates a model with the given number of reactions.
+ */
+static SBMLDocument*
+createModel (unsigned int size)
+{
+  SBMLDocument* document = new SBMLDocument(3, 2);
+  Model* model = document->createModel();
+  model->setTimeUnits("second");
+  model->setSubstanceUnits("mole");
+  model->setExtentUnits("mole");
+  model->setVolumeUnits("litre");
+
+  UnitDefinition* ud = model->createUnitDefinition();
+  ud->setId("mM");
+  addUnit(ud, UNIT_KIND_MOLE, 1);
+  addUnit(ud, UNIT_KIND_LITRE, -1);
+
+  ud = model->createUnitDefinition();
+  ud->setId("per_second");
+  addUnit(ud, UNIT_KIND_SECOND, -1);
+
+  Compartment* c = model->createCompartment();
+  c->setId("cell");
+  c->setSize(1.0);
+  c->setSpatialDimensions(3.0);
+  c->setUnits("litre");
+  c->setConstant(true);
+
+  for (unsigned int n = 0; n <= size; ++n)
+  {
+    Species* s = model->createSpecies();
+    s->setId(createId("S", n));
+    s->setCompartment("cell");
+    s->setInitialConcentration(1.0);
+    s->setSubstanceUnits("mole");
+    s->setHasOnlySubstanceUnits(false);
+    s->setBoundaryCondition(false);
+    s->setConstant(false);
+  }
+
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    Parameter* p = model->createParameter();
+    p->setId(createId("k", n));
+    p->setValue(1.0);
+    p->setUnits("per_second");
+    p->setConstant(true);
+
+    p = model->createParameter();
+    p->setId(createId("Km", n));
+    p->setValue(1.0);
+    p->setUnits("mM");
+    p->setConstant(true);
+
+    Reaction* r = model->createReaction();
+    r->setId(createId("R", n));
+    r->setReversible(false);
+
+    SpeciesReference* sr = r->createReactant();
+    sr->setSpecies(createId("S", n));
+    sr->setStoichiometry(1.0);
+    sr->setConstant(true);
+
+    sr = r->createProduct();
+    sr->setSpecies(createId("S", n + 1));
+    sr->setStoichiometry(1.0);
+    sr->setConstant(true);
+
+    r->createKineticLaw();
+    setKineticLaw(r, n, true);
+  }
+
+  return document;
+}
+
+
+/*
+ * Makes the nth of a series of edits: even edits change a kinetic law,
+ * odd edits change the units of a parameter.
+ */
+static void
+editModel (Model* model, unsigned int edit)
+{
+  unsigned int size = model->getNumReactions();
+  unsigned int n = (edit * 7919) % size;
+
+  if (edit % 2 == 0)
+  {
+    setKineticLaw(model->getReaction(n), n, (edit / 2) % 2 == 1);
+  }
+  else
+  {
+    Parameter* p = model->getParameter(createId("Km", n));
+    p->setUnits(p->getUnits() == "mM" ? "mole" : "mM");
+  }
+}
+
+
+#endif  /* reactionChain_h */
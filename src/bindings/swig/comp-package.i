@@ -67,6 +67,12 @@
  */
 %ignore SBMLFileResolver::setAdditionalDirs(const std::vector<std::string>& dirs);
 
+/*
+ * The InstantiationCache is internal to flattening.
+ */
+%ignore CompModelPlugin::setInstantiationCache;
+%ignore CompModelPlugin::getInstantiationCache;
+
 
 %include <sbml/packages/comp/extension/CompExtension.h>
 %include <sbml/packages/comp/extension/CompSBasePlugin.h>
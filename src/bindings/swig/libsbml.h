@@ -110,6 +110,8 @@
 
 #include <sbml/validator/SBMLValidator.h>
 #include <sbml/validator/SBMLExternalValidator.h>
+#include <sbml/validator/ValidatorProfile.h>
+#include <sbml/validator/ValidationCallback.h>
 
 #include <sbml/xml/XMLAttributes.h>
 #include <sbml/xml/XMLNamespaces.h>
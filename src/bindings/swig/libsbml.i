@@ -47,6 +47,7 @@
 %feature("director") MathFilter;
 %feature("director") IdentifierTransformer;
 %feature("director") Callback;
+%feature("director") ValidationCallback;
 %ignore IdentifierTransformer::transform(const SBase* element);
 
 #pragma SWIG nowarn=473,401,844
@@ -207,6 +208,19 @@ LIBSBML_CPP_NAMESPACE_USE
 %ignore SBMLExternalValidator::getArguments;
 %ignore SBMLExternalValidator::setArguments;
 
+/**
+ * Ignore the methods ValidatorProfile only offers to the validators
+ */
+%ignore ValidatorProfile::record;
+%ignore ValidatorProfile::now;
+
+/**
+ * Ignore the methods ValidationCallback only offers to the validators
+ */
+%ignore ValidationCallback::start;
+%ignore ValidationCallback::report;
+%ignore ValidationCallback::getNumReportedErrors;
+
 /**
  * Ignore 'static ParentMap mParent;' in SBO.h
  */
@@ -495,6 +509,15 @@ LIBSBML_CPP_NAMESPACE_USE
 %ignore SBase::getAllElements;
 %ignore Model::renameIDs(List* elements, IdentifierTransformer* idTransformer);
 
+/**
+ * The overloads that rename several ids at once take a std::map, which is
+ * not wrapped; the one-id versions are.
+ */
+%ignore renameSIdRefs(const std::map<std::string, std::string>&);
+%ignore renameUnitSIdRefs(const std::map<std::string, std::string>&);
+%ignore renameMetaIdRefs(const std::map<std::string, std::string>&);
+%ignore SBase::getRenamedId;
+
 %extend Model
 {
    void renameIDs(ListWrapper<SBase>& elements, IdentifierTransformer *idTransformer)
@@ -841,6 +864,8 @@ as a comment in the output stream.
 
 %include sbml/validator/SBMLValidator.h
 %include sbml/validator/SBMLExternalValidator.h
+%include sbml/validator/ValidatorProfile.h
+%include sbml/validator/ValidationCallback.h
 
 %include sbml/xml/XMLAttributes.h
 %include sbml/xml/XMLConstructorException.h
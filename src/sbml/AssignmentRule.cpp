@@ -138,6 +138,16 @@ AssignmentRule::renameSIdRefs(const std::string& oldid, const std::string& newid
   }
 }
 
+void
+AssignmentRule::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  Rule::renameSIdRefs(renamed);
+  std::string newid;
+  if (getRenamedId(getVariable(), renamed, newid)) {
+    setVariable(newid);
+  }
+}
+
 /** @cond doxygenLibsbmlInternal */
 
 /*
@@ -485,6 +485,7 @@ Compartment::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -508,6 +509,7 @@ Compartment::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -686,6 +688,15 @@ Compartment::renameSIdRefs(const std::string& oldid, const std::string& newid)
   if (mOutside==oldid) mOutside= newid; //You know, just in case.
 }
 
+void
+Compartment::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  std::string newid;
+  if (getRenamedId(mCompartmentType, renamed, newid)) mCompartmentType = newid;
+  if (getRenamedId(mOutside, renamed, newid)) mOutside = newid;
+}
+
 void 
 Compartment::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -693,6 +704,14 @@ Compartment::renameUnitSIdRefs(const std::string& oldid, const std::string& newi
   if (mUnits==oldid) mUnits = newid;
 }
 
+void 
+Compartment::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  std::string newid;
+  if (getRenamedId(mUnits, renamed, newid)) mUnits = newid;
+}
+
 /*
  * Unsets the name of this SBML object.
  */
@@ -702,6 +721,7 @@ Compartment::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -1931,13 +1951,8 @@ ListOfCompartments::get (const std::string& sid)
 const Compartment*
 ListOfCompartments::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  {
-    result = find_if( mItems.begin(), mItems.end(), IdEq<Compartment>(sid) );
-    return (result == mItems.end()) ? NULL : 
-                                      static_cast <Compartment*> (*result);
-  }
+  unsigned int n = getIndexById(sid);
+  return (n < mItems.size()) ? static_cast <Compartment*> (mItems[n]) : NULL;
 }
 
 
@@ -1962,6 +1977,7 @@ ListOfCompartments::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <Compartment*> (item);
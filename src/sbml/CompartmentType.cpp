@@ -184,6 +184,7 @@ CompartmentType::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -207,6 +208,7 @@ CompartmentType::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -227,6 +229,7 @@ CompartmentType::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -741,11 +744,8 @@ ListOfCompartmentTypes::get (const std::string& sid)
 const CompartmentType*
 ListOfCompartmentTypes::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqCT(sid) );
-  return (result == mItems.end()) ? NULL : 
-                    static_cast <CompartmentType*> (*result);  
+  unsigned int n = getIndexById(sid);
+  return (n < mItems.size()) ? static_cast <CompartmentType*> (mItems[n]) : NULL;
 }
 
 
@@ -770,6 +770,7 @@ ListOfCompartmentTypes::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <CompartmentType*> (item);
@@ -418,6 +418,15 @@ Constraint::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+Constraint::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+
 void 
 Constraint::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -427,6 +436,15 @@ Constraint::renameUnitSIdRefs(const std::string& oldid, const std::string& newid
   }
 }
 
+void 
+Constraint::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+
 /** @cond doxygenLibsbmlInternal */
 void 
 Constraint::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
@@ -425,6 +425,15 @@ Delay::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+Delay::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+
 void 
 Delay::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -434,6 +443,15 @@ Delay::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void 
+Delay::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+
 /** @cond doxygenLibsbmlInternal */
 void 
 Delay::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
@@ -518,6 +518,7 @@ Event::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -541,6 +542,7 @@ Event::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -719,6 +721,7 @@ int
 Event::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty())
   {
@@ -740,6 +743,7 @@ Event::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -2228,10 +2232,8 @@ ListOfEvents::get (const std::string& sid)
 const Event*
 ListOfEvents::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqE(sid) );
-  return (result == mItems.end()) ? NULL : static_cast <Event*> (*result);
+  unsigned int n = getIndexById(sid);
+  return (n < mItems.size()) ? static_cast <Event*> (mItems[n]) : NULL;
 }
 
 
@@ -2256,6 +2258,7 @@ ListOfEvents::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <Event*> (item);
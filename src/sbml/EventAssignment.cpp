@@ -214,6 +214,7 @@ EventAssignment::setVariable (const std::string& sid)
   else
   {
     mVariable = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -223,6 +224,7 @@ int
 EventAssignment::unsetVariable ()
 {
   mVariable.erase();
+  updateElementIdIndex();
 
   if (mVariable.empty())
   {
@@ -739,6 +741,19 @@ EventAssignment::renameSIdRefs(const std::string& oldid, const std::string& newi
   }
 }
 
+void
+EventAssignment::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  std::string newid;
+  if (getRenamedId(mVariable, renamed, newid)) {
+    setVariable(newid);
+  }
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+
 void 
 EventAssignment::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -748,6 +763,15 @@ EventAssignment::renameUnitSIdRefs(const std::string& oldid, const std::string&
   }
 }
 
+void 
+EventAssignment::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+
 /** @cond doxygenLibsbmlInternal */
 void 
 EventAssignment::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
@@ -1132,11 +1156,8 @@ ListOfEventAssignments::get (const std::string& sid)
 const EventAssignment*
 ListOfEventAssignments::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqEA(sid) );
-  return (result == mItems.end()) ? NULL : 
-                    static_cast <EventAssignment*> (*result);
+  unsigned int n = getIndexById(sid);
+  return (n < mItems.size()) ? static_cast <EventAssignment*> (mItems[n]) : NULL;
 }
 
 
@@ -1161,6 +1182,7 @@ ListOfEventAssignments::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <EventAssignment*> (item);
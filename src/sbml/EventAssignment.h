@@ -629,12 +629,24 @@ public:
   virtual void renameSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /**
+   * @copydoc doc_renamesidrefmap_common
+   */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
   /**
    * @copydoc doc_renameunitsidref_common
    */
   virtual void renameUnitSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /**
+   * @copydoc doc_renameunitsidrefmap_common
+   */
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * Replace all nodes with the name 'id' from the child 'math' object with the provided function. 
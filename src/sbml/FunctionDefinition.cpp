@@ -231,6 +231,7 @@ FunctionDefinition::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -254,6 +255,7 @@ FunctionDefinition::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -304,6 +306,7 @@ FunctionDefinition::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -624,6 +627,15 @@ FunctionDefinition::renameUnitSIdRefs(const std::string& oldid, const std::strin
   }
 }
 
+void 
+FunctionDefinition::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+
 /** @cond doxygenLibsbmlInternal */
 
 /*
@@ -1225,12 +1237,8 @@ ListOfFunctionDefinitions::get (const std::string& sid)
 const FunctionDefinition*
 ListOfFunctionDefinitions::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqFD(sid) );
-  return (result == mItems.end()) ? NULL : 
-                             static_cast <FunctionDefinition*> (*result);
-
+  unsigned int n = getIndexById(sid);
+  return (n < mItems.size()) ? static_cast <FunctionDefinition*> (mItems[n]) : NULL;
 }
 
 
@@ -1255,6 +1263,7 @@ ListOfFunctionDefinitions::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <FunctionDefinition*> (item);
@@ -477,6 +477,12 @@ public:
   virtual void renameUnitSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /**
+   * @copydoc doc_renameunitsidrefmap_common
+   */
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
 
 
   #ifndef SWIG
@@ -217,6 +217,7 @@ InitialAssignment::setSymbol (const std::string& sid)
   else
   {
     mSymbol = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -226,6 +227,7 @@ int
 InitialAssignment::unsetSymbol ()
 {
   mSymbol.erase();
+  updateElementIdIndex();
 
   if (mSymbol.empty())
   {
@@ -718,6 +720,19 @@ InitialAssignment::renameSIdRefs(const std::string& oldid, const std::string& ne
   }
 }
 
+void
+InitialAssignment::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  std::string newid;
+  if (getRenamedId(mSymbol, renamed, newid)) {
+    setSymbol(newid);
+  }
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+
 void 
 InitialAssignment::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -727,6 +742,15 @@ InitialAssignment::renameUnitSIdRefs(const std::string& oldid, const std::string
   }
 }
 
+void 
+InitialAssignment::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+
 /** @cond doxygenLibsbmlInternal */
 void 
 InitialAssignment::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
@@ -1113,12 +1137,8 @@ ListOfInitialAssignments::get (const std::string& sid)
 const InitialAssignment*
 ListOfInitialAssignments::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqIA(sid) );
-  return (result == mItems.end()) ? NULL : 
-                              static_cast <InitialAssignment*> (*result);
-  
+  unsigned int n = getIndexById(sid);
+  return (n < mItems.size()) ? static_cast <InitialAssignment*> (mItems[n]) : NULL;
 }
 
 
@@ -1143,6 +1163,7 @@ ListOfInitialAssignments::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <InitialAssignment*> (item);
@@ -1552,6 +1552,29 @@ KineticLaw::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+KineticLaw::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  if (!isSetMath()) return;
+  //Local parameters hide the ids they share, so those are not renamed.
+  std::map<std::string, std::string> global;
+  const std::map<std::string, std::string>* toRename = &renamed;
+  for (unsigned int p = 0; p < getNumParameters() + getNumLocalParameters(); p++)
+  {
+    const SBase* param = (p < getNumParameters()) ?
+      static_cast<const SBase*>(getParameter(p)) :
+      static_cast<const SBase*>(getLocalParameter(p - getNumParameters()));
+    if (renamed.find(param->getId()) == renamed.end()) continue;
+    if (toRename == &renamed) {
+      global = renamed;
+      toRename = &global;
+    }
+    global.erase(param->getId());
+  }
+  mMath->renameSIdRefs(*toRename);
+}
+
 void 
 KineticLaw::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -1563,6 +1586,18 @@ KineticLaw::renameUnitSIdRefs(const std::string& oldid, const std::string& newid
   if (mSubstanceUnits == oldid) mSubstanceUnits = newid;
 }
 
+void 
+KineticLaw::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+  std::string newid;
+  if (getRenamedId(mTimeUnits, renamed, newid)) mTimeUnits = newid;
+  if (getRenamedId(mSubstanceUnits, renamed, newid)) mSubstanceUnits = newid;
+}
+
 /** @cond doxygenLibsbmlInternal */
 void 
 KineticLaw::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
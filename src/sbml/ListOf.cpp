@@ -44,6 +44,7 @@
 
 #include <sbml/SBMLVisitor.h>
 #include <sbml/ListOf.h>
+#include <sbml/SBMLDocument.h>
 #include <sbml/SBO.h>
 #include <sbml/common/common.h>
 #include <sbml/util/ElementFilter.h>
@@ -62,6 +63,8 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 ListOf::ListOf (unsigned int level, unsigned int version)
 : SBase(level,version)
 , mExplicitlyListed (false)
+, mIdLookupValid (false)
+, mIdLookupSize (0)
 {
     if (!hasValidLevelVersionNamespaceCombination())
     throw SBMLConstructorException();
@@ -74,6 +77,8 @@ ListOf::ListOf (unsigned int level, unsigned int version)
 ListOf::ListOf (SBMLNamespaces* sbmlns)
 : SBase(sbmlns)
 , mExplicitlyListed (false)
+, mIdLookupValid (false)
+, mIdLookupSize (0)
 {
     if (!hasValidLevelVersionNamespaceCombination())
     throw SBMLConstructorException();
@@ -110,7 +115,11 @@ struct Clone
 /*
  * Copy constructor. Creates a copy of this ListOf items.
  */
-ListOf::ListOf (const ListOf& orig) : SBase(orig), mItems()
+ListOf::ListOf (const ListOf& orig)
+  : SBase(orig)
+  , mItems()
+  , mIdLookupValid (false)
+  , mIdLookupSize (0)
 {
   mItems.resize( orig.size() );
   transform( orig.mItems.begin(), orig.mItems.end(), mItems.begin(), Clone() );
@@ -131,6 +140,7 @@ ListOf& ListOf::operator=(const ListOf& rhs)
     for_each( mItems.begin(), mItems.end(), Delete() );
     mItems.resize( rhs.size() );
     transform( rhs.mItems.begin(), rhs.mItems.end(), mItems.begin(), Clone() );
+    invalidateIdLookup();
     connectToChild();
   }
 
@@ -180,6 +190,7 @@ ListOf::insertAndOwn(int location, SBase* item)
   if (this->getItemTypeCode() == SBML_UNKNOWN )
   {
     mItems.insert( mItems.begin() + location, item );
+    invalidateIdLookup();
     item->connectToParent(this);
     return LIBSBML_OPERATION_SUCCESS;
   }
@@ -190,6 +201,7 @@ ListOf::insertAndOwn(int location, SBase* item)
   else
   {
     mItems.insert( mItems.begin() + location, item );
+    invalidateIdLookup();
     item->connectToParent(this);
     return LIBSBML_OPERATION_SUCCESS;
   }
@@ -223,6 +235,7 @@ ListOf::appendAndOwn (SBase* item)
   {
     mItems.push_back( item );
     item->connectToParent(this);
+    updateIdLookup(item);
     return LIBSBML_OPERATION_SUCCESS;
   }
   else if (!isValidTypeForList(item))
@@ -233,6 +246,7 @@ ListOf::appendAndOwn (SBase* item)
   {
     mItems.push_back( item );
     item->connectToParent(this);
+    updateIdLookup(item);
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -342,7 +356,11 @@ ListOf::clear (bool doDelete)
 {
   if (doDelete)
     for_each( mItems.begin(), mItems.end(), Delete() );
+  else
+    for (ListItemIter it = mItems.begin(); it != mItems.end(); ++it)
+      itemRemoved(*it);
   mItems.clear();
+  invalidateIdLookup();
 }
 
 int ListOf::removeFromParentAndDelete()
@@ -368,11 +386,156 @@ SBase*
 ListOf::remove (unsigned int n)
 {
   SBase* item = get(n);
-  if (item != NULL) mItems.erase( mItems.begin() + n );
+  if (item != NULL)
+  {
+    mItems.erase( mItems.begin() + n );
+    itemRemoved(item);
+  }
   return item;
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+bool
+ListOf::hasItem(const SBase* item) const
+{
+  for (ListItem::const_reverse_iterator it = mItems.rbegin(); it != mItems.rend(); ++it)
+  {
+    if (*it == item) return true;
+  }
+  return false;
+}
+
+
+void
+ListOf::itemRemoved(SBase* item)
+{
+  invalidateIdLookup();
+  if (mSBML != NULL && item != NULL)
+  {
+    mSBML->removeFromElementIdIndex(item, true);
+  }
+}
+
+
+void
+ListOf::invalidateIdLookup() const
+{
+  mIdLookup.clear();
+  mIdLookupValid = false;
+  mIdLookupSize = 0;
+}
+
+
+void
+ListOf::buildIdLookup() const
+{
+  unsigned int numItems = (unsigned int)mItems.size();
+  if (mIdLookupValid && mIdLookupSize == numItems)
+  {
+    return;
+  }
+
+  // items created while reading are added to mItems directly
+  mIdLookup.clear();
+  for (unsigned int n = 0; n < numItems; ++n)
+  {
+    const std::string& id = mItems[n]->getId();
+    if (!id.empty()) mIdLookup.insert(IdLookup::value_type(id, n));
+  }
+  mIdLookupValid = true;
+  mIdLookupSize = numItems;
+}
+
+
+unsigned int
+ListOf::getIndexById(const std::string& sid) const
+{
+  unsigned int numItems = (unsigned int)mItems.size();
+
+  if (sid.empty())
+  {
+    // items without an identifier are not in the map
+    for (unsigned int n = 0; n < numItems; ++n)
+    {
+      if (mItems[n]->getId().empty()) return n;
+    }
+    return numItems;
+  }
+
+  if (numItems == 0)
+  {
+    return 0;
+  }
+
+  for (int attempt = 0; attempt < 2; ++attempt)
+  {
+    buildIdLookup();
+
+    IdLookup::const_iterator it = mIdLookup.find(sid);
+    if (it == mIdLookup.end())
+    {
+      return numItems;
+    }
+    if (mItems[it->second]->getId() == sid)
+    {
+      return it->second;
+    }
+
+    // the item has been renamed since the map was built
+    invalidateIdLookup();
+  }
+
+  return numItems;
+}
+
+
+void
+ListOf::updateIdLookup(const SBase* item)
+{
+  if (!mIdLookupValid || item == NULL) return;
+
+  unsigned int numItems = (unsigned int)mItems.size();
+  unsigned int n = numItems;
+  if (numItems > 0 && mItems[numItems - 1] == item)
+  {
+    n = numItems - 1;
+  }
+  else
+  {
+    n = (unsigned int)(std::find(mItems.begin(), mItems.end(), item) 
+                       - mItems.begin());
+    if (n == numItems) return;
+  }
+
+  if (n >= mIdLookupSize)
+  {
+    if (n != mIdLookupSize || numItems != n + 1)
+    {
+      invalidateIdLookup();
+      return;
+    }
+    mIdLookupSize = numItems;
+  }
+
+  const std::string& id = item->getId();
+  if (id.empty()) return;
+
+  IdLookup::iterator it = mIdLookup.find(id);
+  if (it == mIdLookup.end())
+  {
+    mIdLookup.insert(IdLookup::value_type(id, n));
+  }
+  else if (it->second != n &&
+           (it->second > n || mItems[it->second]->getId() != id))
+  {
+    // the first item with this identifier may have changed
+    invalidateIdLookup();
+  }
+}
+/** @endcond */
+
+
 /*
  * @return the number of items in this ListOf items.
  */
@@ -466,6 +629,24 @@ ListOf::connectToChild()
 /** @endcond */
 
 
+/*
+ * A ListOf has no SIdRef or UnitSIdRef attributes of its own; its items
+ * are renamed as elements in their own right.
+ */
+void
+ListOf::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+}
+
+
+void
+ListOf::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+}
+
+
 /*
  * @return the typecode (int) of this SBML object or SBML_UNKNOWN
  * (default).
@@ -666,6 +847,7 @@ struct ListOfComparator
 void ListOf::sort()
 {
     std::sort(mItems.begin(), mItems.end(), ListOfComparator());
+    invalidateIdLookup();
 }
 
 
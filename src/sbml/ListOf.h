@@ -99,6 +99,7 @@
 #include <vector>
 #include <algorithm>
 #include <functional>
+#include <map>
 
 #include <sbml/SBase.h>
 
@@ -508,6 +509,22 @@ public:
   /** @endcond */
 
 
+  using SBase::renameSIdRefs;
+  using SBase::renameUnitSIdRefs;
+
+
+  /**
+   * @copydoc doc_renamesidrefmap_common
+   */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
+  /**
+   * @copydoc doc_renameunitsidrefmap_common
+   */
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
   /**
    * Returns the libSBML type code for this object, namely,
    * @sbmlconstant{SBML_LIST_OF, SBMLTypeCode_t}.
@@ -623,6 +640,45 @@ public:
   void sort();
   /** @endcond */
 
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Tells this ListOf that the identifier (as returned by getId()) of the
+   * given item has changed, so that lookups by identifier can follow.
+   */
+  void updateIdLookup(const SBase* item);
+  /** @endcond */
+
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Drops the map used for lookups by identifier, so that it is built
+   * again on the next lookup.
+   */
+  void invalidateIdLookup() const;
+  /** @endcond */
+
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Builds the map used for lookups by identifier now instead of on the
+   * first lookup.  Once it is built, and as long as the list is not
+   * changed, get(const std::string& sid) only reads, so the list can be
+   * searched from several threads at once.
+   */
+  void buildIdLookup() const;
+  /** @endcond */
+
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Returns true if the given object is one of the items of this ListOf.
+   * Items are usually looked for just after being appended, so the
+   * search starts at the end of the list.
+   */
+  bool hasItem(const SBase* item) const;
+  /** @endcond */
+
 protected:
   /** @cond doxygenLibsbmlInternal */
   typedef std::vector<SBase*>           ListItem;
@@ -660,10 +716,37 @@ protected:
   virtual bool isValidTypeForList(SBase * item);
 
 
+  /**
+   * Subclasses must call this method after taking an item out of mItems
+   * without deleting it, so that the parent SBMLDocument no longer
+   * reports the item or its children through its element identifier index.
+   */
+  void itemRemoved(SBase* item);
+
+
+  /**
+   * Returns the position of the first item whose getId() equals sid, or
+   * size() if there is none.
+   *
+   * The answer comes from a map from identifier to position that is built
+   * on first use and kept up to date as items are appended or renamed;
+   * other changes to the list make it be built again on the next call.
+   * Subclasses whose items are found by getId() should use this in their
+   * get(const std::string& sid) methods.
+   */
+  unsigned int getIndexById(const std::string& sid) const;
+
+
   ListItem mItems;
 
   bool mExplicitlyListed;
 
+  typedef std::map<std::string, unsigned int> IdLookup;
+
+  mutable IdLookup      mIdLookup;
+  mutable bool          mIdLookupValid;
+  mutable unsigned int  mIdLookupSize;
+
   /** @endcond */
 };
 
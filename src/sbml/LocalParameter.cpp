@@ -669,12 +669,8 @@ ListOfLocalParameters::get (const std::string& sid)
 const LocalParameter*
 ListOfLocalParameters::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqP(sid) );
-  return (result == mItems.end()) ? NULL : 
-                           static_cast <LocalParameter*> (*result);
-  
+  unsigned int n = getIndexById(sid);
+  return (n < mItems.size()) ? static_cast <LocalParameter*> (mItems[n]) : NULL;
 }
 
 
@@ -713,6 +709,7 @@ ListOfLocalParameters::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <LocalParameter*> (item);
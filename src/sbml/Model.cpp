@@ -247,6 +247,7 @@ Model& Model::operator=(const Model& rhs)
     mConstraints          = rhs.mConstraints;
     mReactions            = rhs.mReactions;
     mEvents               = rhs.mEvents;
+    mComponentValues.clear();
 
 
     if (this->mFormulaUnitsData  != NULL)
@@ -457,14 +458,13 @@ Model::renameIDs(List* elements, IdentifierTransformer* idTransformer)
   if (elements == NULL || elements->getSize() == 0 || idTransformer == NULL)
     return;
 
-  vector<pair<string, string> > renamedSIds;
-  vector<pair<string, string> > renamedUnitSIds;
-  vector<pair<string, string> > renamedMetaIds;
-  vector<pair<string, string> >::iterator it;
+  map<string, string> renamedSIds;
+  map<string, string> renamedUnitSIds;
+  map<string, string> renamedMetaIds;
 
-  for (unsigned long el=0; el < elements->getSize(); ++el) 
+  for (ListIterator iter = elements->begin(); iter != elements->end(); ++iter)
   {
-    SBase* element = static_cast<SBase*>(elements->get((unsigned int)el));
+    SBase* element = static_cast<SBase*>(*iter);
     string id = element->getId();
     string metaid = element->getMetaId();
     element->transformIdentifiers(idTransformer);
@@ -480,38 +480,40 @@ Model::renameIDs(List* elements, IdentifierTransformer* idTransformer)
       int type = element->getTypeCode();
       if (type==SBML_UNIT_DEFINITION) 
       {
-        renamedUnitSIds.push_back(make_pair(id, newid));
+        renamedUnitSIds.insert(make_pair(id, newid));
       }
       else 
       {
         //This is a little dangerous, but hey!  What's a little danger between friends!
         //(What we are assuming is that any attribute you can get with 'getId' is of the type 'SId')
-        renamedSIds.push_back(make_pair(id, newid));
+        renamedSIds.insert(make_pair(id, newid));
       }
     }
     if (metaid != newmetaid) 
   {
-      renamedMetaIds.push_back(make_pair(metaid, newmetaid));
+      renamedMetaIds.insert(make_pair(metaid, newmetaid));
     }
   }
 
-  for (unsigned long el = 0; el< elements->getSize(); ++el) 
+  // Rewrite the references to all the renamed ids in one pass over each
+  // element, rather than once per renamed id.
+  for (ListIterator iter = elements->begin(); iter != elements->end(); ++iter)
   {
-    SBase* element = static_cast<SBase*>(elements->get((unsigned int)el));
+    SBase* element = static_cast<SBase*>(*iter);
   
-    for (it = renamedSIds.begin(); it != renamedSIds.end(); ++it) 
-  {
-      element->renameSIdRefs((*it).first, (*it).second);
+    if (!renamedSIds.empty())
+    {
+      element->renameSIdRefs(renamedSIds);
     }
   
-    for (it = renamedUnitSIds.begin(); it != renamedUnitSIds.end(); ++it) 
-  {
-      element->renameUnitSIdRefs((*it).first, (*it).second);
+    if (!renamedUnitSIds.empty())
+    {
+      element->renameUnitSIdRefs(renamedUnitSIds);
     }
   
-    for (it = renamedMetaIds.begin(); it != renamedMetaIds.end(); ++it) 
-  {
-      element->renameMetaIdRefs((*it).first, (*it).second);
+    if (!renamedMetaIds.empty())
+    {
+      element->renameMetaIdRefs(renamedMetaIds);
     }
   }
 }
@@ -723,6 +725,7 @@ Model::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -746,6 +749,7 @@ Model::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -918,6 +922,7 @@ int
 Model::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty())
   {
@@ -939,6 +944,7 @@ Model::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -4519,6 +4525,16 @@ Model::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+Model::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  std::string newid;
+  if (getRenamedId(getConversionFactor(), renamed, newid)) {
+    setConversionFactor(newid);
+  }
+}
+
 void 
 Model::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -4531,6 +4547,19 @@ Model::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   if (mExtentUnits == oldid)    mExtentUnits = newid;
 }
 
+void 
+Model::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  std::string newid;
+  if (getRenamedId(mSubstanceUnits, renamed, newid)) mSubstanceUnits = newid;
+  if (getRenamedId(mTimeUnits, renamed, newid)) mTimeUnits = newid;
+  if (getRenamedId(mVolumeUnits, renamed, newid)) mVolumeUnits = newid;
+  if (getRenamedId(mAreaUnits, renamed, newid)) mAreaUnits = newid;
+  if (getRenamedId(mLengthUnits, renamed, newid)) mLengthUnits = newid;
+  if (getRenamedId(mExtentUnits, renamed, newid)) mExtentUnits = newid;
+}
+
 /** @cond doxygenLibsbmlInternal */
 /*
  * Subclasses should override this method to read (and store) XHTML,
@@ -5380,6 +5409,258 @@ Model::getElementPosition () const
 /** @endcond */
 
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * The signature of an entry in the list of FormulaUnitsData summarises
+ * everything its units are worked out from, so that
+ * updateListFormulaUnitsData() can tell which entries are out of date.
+ * The units state of an id is what the UnitFormulaFormatter reads when
+ * it finds the id in math.
+ */
+static void
+appendUnitsNumber(std::string& signature, double value)
+{
+  char number[32];
+  sprintf(number, "%.17g;", value);
+  signature.append(number);
+}
+
+
+static std::string
+getUnitsState(const Compartment* c)
+{
+  std::string state = "C" + c->getUnits() + ";";
+  appendUnitsNumber(state, c->getSpatialDimensionsAsDouble());
+  state += c->isSetSpatialDimensions() ? '1' : '0';
+
+  return state;
+}
+
+
+static std::string
+getUnitsState(const Parameter* p)
+{
+  return "P" + p->getUnits();
+}
+
+
+static std::string
+getUnitsState(const Model& m, const Species* s,
+              const std::map<std::string, std::string>& states)
+{
+  std::string state = "S" + s->getSubstanceUnits() + ";" 
+    + s->getSpatialSizeUnits() + ";"
+    + (s->getHasOnlySubstanceUnits() ? "1;" : "0;")
+    + s->getCompartment() + "=";
+
+  /* the ids of compartments and parameters come first in the states,
+   * unless the model has repeated ids
+   */
+  std::map<std::string, std::string>::const_iterator it =
+                                       states.find(s->getCompartment());
+  if (it != states.end() && it->second[0] == 'C')
+  {
+    state += it->second;
+  }
+  else if (m.getCompartment(s->getCompartment()) != NULL)
+  {
+    state += getUnitsState(m.getCompartment(s->getCompartment()));
+  }
+
+  const std::string& factor = s->isSetConversionFactor() ? 
+                          s->getConversionFactor() : m.getConversionFactor();
+  if (!factor.empty())
+  {
+    state += ";" + factor + "=";
+    it = states.find(factor);
+    if (it != states.end() && it->second[0] == 'P')
+    {
+      state += it->second;
+    }
+    else if (m.getParameter(factor) != NULL)
+    {
+      state += getUnitsState(m.getParameter(factor));
+    }
+  }
+
+  return state;
+}
+
+
+/*
+ * the ids are looked up in the order the UnitFormulaFormatter uses
+ */
+static void
+collectUnitsStates(const Model& m, std::map<std::string, std::string>& states)
+{
+  unsigned int n, j;
+
+  states.clear();
+
+  for (n = 0; n < m.getNumCompartments(); n++)
+  {
+    const Compartment* c = m.getCompartment(n);
+    states.insert(make_pair(c->getId(), getUnitsState(c)));
+  }
+
+  for (n = 0; n < m.getNumParameters(); n++)
+  {
+    const Parameter* p = m.getParameter(n);
+    if (states.find(p->getId()) == states.end())
+    {
+      states.insert(make_pair(p->getId(), getUnitsState(p)));
+    }
+  }
+
+  /* species are looked up before parameters */
+  for (n = 0; n < m.getNumSpecies(); n++)
+  {
+    const Species* s = m.getSpecies(n);
+    std::map<std::string, std::string>::iterator it = states.find(s->getId());
+    if (it == states.end())
+    {
+      states.insert(make_pair(s->getId(), getUnitsState(m, s, states)));
+    }
+    else if (it->second[0] == 'P')
+    {
+      it->second = getUnitsState(m, s, states);
+    }
+  }
+
+  for (n = 0; n < m.getNumReactions(); n++)
+  {
+    const Reaction* r = m.getReaction(n);
+    if (m.getLevel() > 2)
+    {
+      for (j = 0; j < r->getNumReactants(); j++)
+      {
+        states.insert(make_pair(r->getReactant(j)->getSpecies(), "R"));
+        states.insert(make_pair(r->getReactant(j)->getId(), "R"));
+      }
+      for (j = 0; j < r->getNumProducts(); j++)
+      {
+        states.insert(make_pair(r->getProduct(j)->getSpecies(), "R"));
+        states.insert(make_pair(r->getProduct(j)->getId(), "R"));
+      }
+    }
+  }
+
+  for (n = 0; n < m.getNumReactions(); n++)
+  {
+    states.insert(make_pair(m.getReaction(n)->getId(), "X"));
+  }
+}
+
+
+static void
+appendMathUnitsSignature(std::string& signature, const ASTNode* node,
+                         const std::map<std::string, std::string>& states)
+{
+  if (node == NULL)
+  {
+    signature += '~';
+    return;
+  }
+
+  char type[16];
+  sprintf(type, "(%d;", (int)(node->getType()));
+  signature.append(type);
+
+  switch (node->getType())
+  {
+  case AST_INTEGER:
+    appendUnitsNumber(signature, (double)(node->getInteger()));
+    break;
+  case AST_RATIONAL:
+    appendUnitsNumber(signature, (double)(node->getNumerator()));
+    appendUnitsNumber(signature, (double)(node->getDenominator()));
+    break;
+  case AST_REAL_E:
+    appendUnitsNumber(signature, node->getMantissa());
+    appendUnitsNumber(signature, (double)(node->getExponent()));
+    break;
+  case AST_REAL:
+    appendUnitsNumber(signature, node->getReal());
+    break;
+  default:
+    if (node->getName() != NULL)
+    {
+      signature += node->getName();
+    }
+    break;
+  }
+
+  if (node->isSetUnits())
+  {
+    signature += ";" + node->getUnits();
+  }
+
+  if (node->getType() == AST_NAME && node->getName() != NULL)
+  {
+    std::map<std::string, std::string>::const_iterator it =
+                                                states.find(node->getName());
+    if (it != states.end())
+    {
+      signature += "=" + it->second;
+    }
+  }
+
+  for (unsigned int n = 0; n < node->getNumChildren(); n++)
+  {
+    appendMathUnitsSignature(signature, node->getChild(n), states);
+  }
+
+  signature += ')';
+}
+
+
+/*
+ * the model wide units, and the unit and function definitions, are used
+ * by every entry
+ */
+static std::string
+getModelUnitsSignature(const Model& m,
+                       const std::map<std::string, std::string>& states)
+{
+  unsigned int n, j;
+  char version[32];
+
+  sprintf(version, "%u.%u;", m.getLevel(), m.getVersion());
+
+  std::string signature = version;
+  signature += m.getSubstanceUnits() + ";" + m.getTimeUnits() + ";"
+    + m.getVolumeUnits() + ";" + m.getAreaUnits() + ";"
+    + m.getLengthUnits() + ";" + m.getExtentUnits() + ";"
+    + m.getConversionFactor() + ";";
+
+  for (n = 0; n < m.getNumUnitDefinitions(); n++)
+  {
+    const UnitDefinition* ud = m.getUnitDefinition(n);
+    signature += "U" + ud->getId() + ";";
+
+    for (j = 0; j < ud->getNumUnits(); j++)
+    {
+      const Unit* u = ud->getUnit(j);
+      appendUnitsNumber(signature, (double)(u->getKind()));
+      appendUnitsNumber(signature, u->getExponentAsDouble());
+      appendUnitsNumber(signature, (double)(u->getScale()));
+      appendUnitsNumber(signature, u->getMultiplier());
+      appendUnitsNumber(signature, u->getOffset());
+    }
+  }
+
+  for (n = 0; n < m.getNumFunctionDefinitions(); n++)
+  {
+    const FunctionDefinition* fd = m.getFunctionDefinition(n);
+    signature += "F" + fd->getId() + ";";
+    appendMathUnitsSignature(signature, fd->getMath(), states);
+  }
+
+  return signature;
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 void Model::populatePerTimeUnitDefinition(FormulaUnitsData *fud)
 {
@@ -5414,14 +5695,30 @@ void Model::createSpeciesReferenceUnitsData(SpeciesReference* sr,
   
   if (sr->isSetStoichiometryMath())
   {
-    fud = createFormulaUnitsData(sr->getSpecies(), SBML_STOICHIOMETRY_MATH);
     sr->getStoichiometryMath()->setInternalId(sr->getSpecies());
+
+    std::string signature = 
+      getMathUnitsSignature(sr->getStoichiometryMath()->getMath());
+    if (reuseFormulaUnitsData(sr->getSpecies(), SBML_STOICHIOMETRY_MATH,
+                              signature))
+    {
+      return;
+    }
+
+    fud = createFormulaUnitsData(sr->getSpecies(), SBML_STOICHIOMETRY_MATH);
+    fud->setSignature(signature);
     
     createUnitsDataFromMath(unitFormatter, fud, 
                             sr->getStoichiometryMath()->getMath());
   }
   else if (sr->getLevel() > 2 && sr->isSetId())
   {
+    /* depends only on the model wide units */
+    if (reuseFormulaUnitsData(sr->getId(), SBML_SPECIES_REFERENCE, ""))
+    {
+      return;
+    }
+
     fud = createFormulaUnitsData(sr->getId(), SBML_SPECIES_REFERENCE);
     
     /* units will be dimensionless */
@@ -5457,6 +5754,61 @@ void
 Model::populateListFormulaUnitsData()
 {
   removeListFormulaUnitsData();
+  createListFormulaUnitsData();
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Brings the ListFormulaDataUnits up to date with the model, keeping
+ * the entries whose signature has not changed
+ */
+void
+Model::updateListFormulaUnitsData()
+{
+  if (mFormulaUnitsData == NULL)
+  {
+    populateListFormulaUnitsData();
+    return;
+  }
+
+  /* set the entries aside, to be moved back if they are up to date */
+  unsigned int size = mFormulaUnitsData->getSize();
+  while (size--)
+  {
+    FormulaUnitsData* fud =
+      static_cast<FormulaUnitsData*>( mFormulaUnitsData->remove(0) );
+    KeyValue key(fud->getUnitReferenceId(), fud->getComponentTypecode());
+    mPreviousUnitsData.insert(make_pair(key, fud));
+  }
+  delete mFormulaUnitsData;
+  mFormulaUnitsData = NULL;
+  mUnitsDataMap.clear();
+
+  createListFormulaUnitsData();
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+void
+Model::createListFormulaUnitsData()
+{
+  collectUnitsStates(*this, mUnitsStates);
+  mModelUnitsSignature = getModelUnitsSignature(*this, mUnitsStates);
+
+  /* every entry depends on the model wide units */
+  if (!mPreviousUnitsData.empty())
+  {
+    PreviousUnitsIter it = 
+      mPreviousUnitsData.find(KeyValue("substance", SBML_MODEL));
+    if (it == mPreviousUnitsData.end() 
+      || it->second->getSignature() != mModelUnitsSignature)
+    {
+      removePreviousUnitsData();
+    }
+  }
 
   UnitFormulaFormatter *unitFormatter = new UnitFormulaFormatter(this);
 
@@ -5490,6 +5842,67 @@ Model::populateListFormulaUnitsData()
   createEventUnitsData(unitFormatter);
 
   delete unitFormatter;
+
+  /* whatever is left of the previous list is out of date */
+  removePreviousUnitsData();
+  mUnitsStates.clear();
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+bool
+Model::reuseFormulaUnitsData(const std::string& id, int typecode,
+                             const std::string& signature)
+{
+  KeyValue key(id, typecode);
+  PreviousUnitsIter it  = mPreviousUnitsData.lower_bound(key);
+  PreviousUnitsIter end = mPreviousUnitsData.upper_bound(key);
+
+  for ( ; it != end; ++it)
+  {
+    if (it->second->getSignature() == signature)
+    {
+      FormulaUnitsData* fud = it->second;
+      mPreviousUnitsData.erase(it);
+
+      if (mFormulaUnitsData == NULL)
+      {
+        mFormulaUnitsData = new List();
+      }
+      mUnitsDataMap.insert(make_pair(key, fud));
+      mFormulaUnitsData->add(fud);
+
+      return true;
+    }
+  }
+
+  return false;
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+void
+Model::removePreviousUnitsData()
+{
+  for (PreviousUnitsIter it = mPreviousUnitsData.begin();
+       it != mPreviousUnitsData.end(); ++it)
+  {
+    delete it->second;
+  }
+  mPreviousUnitsData.clear();
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+std::string
+Model::getMathUnitsSignature(const ASTNode * math) const
+{
+  std::string signature;
+  appendMathUnitsSignature(signature, math, mUnitsStates);
+  return signature;
 }
 /** @endcond */
 
@@ -5516,8 +5929,14 @@ Model::removeListFormulaUnitsData()
 void
 Model::createSubstanceUnitsData()
 {
+  if (reuseFormulaUnitsData("substance", SBML_MODEL, mModelUnitsSignature))
+  {
+    return;
+  }
+
   UnitDefinition *ud = NULL;
   FormulaUnitsData *fud = createFormulaUnitsData("substance", SBML_MODEL);
+  fud->setSignature(mModelUnitsSignature);
   
   if (getLevel() < 3)
   {
@@ -5624,8 +6043,14 @@ Model::getL3SubstanceUD()
 void
 Model::createTimeUnitsData()
 {
+  if (reuseFormulaUnitsData("time", SBML_MODEL, mModelUnitsSignature))
+  {
+    return;
+  }
+
   UnitDefinition *ud = NULL;
   FormulaUnitsData *fud = createFormulaUnitsData("time", SBML_MODEL);
+  fud->setSignature(mModelUnitsSignature);
 
   if (getLevel() < 3)
   {
@@ -5732,8 +6157,14 @@ Model::getL3TimeUD()
 void
 Model::createVolumeUnitsData()
 {
+  if (reuseFormulaUnitsData("volume", SBML_MODEL, mModelUnitsSignature))
+  {
+    return;
+  }
+
   UnitDefinition *ud = NULL;
   FormulaUnitsData *fud = createFormulaUnitsData("volume", SBML_MODEL);
+  fud->setSignature(mModelUnitsSignature);
 
   if (getLevel() < 3)
   {
@@ -5840,8 +6271,14 @@ Model::getL3VolumeUD()
 void
 Model::createAreaUnitsData()
 {
+  if (reuseFormulaUnitsData("area", SBML_MODEL, mModelUnitsSignature))
+  {
+    return;
+  }
+
   UnitDefinition *ud = NULL;
   FormulaUnitsData *fud = createFormulaUnitsData("area", SBML_MODEL);
+  fud->setSignature(mModelUnitsSignature);
 
   if (getLevel() < 3)
   {
@@ -5950,8 +6387,14 @@ Model::getL3AreaUD()
 void
 Model::createLengthUnitsData()
 {
+  if (reuseFormulaUnitsData("length", SBML_MODEL, mModelUnitsSignature))
+  {
+    return;
+  }
+
   UnitDefinition *ud = NULL;
   FormulaUnitsData *fud = createFormulaUnitsData("length", SBML_MODEL);
+  fud->setSignature(mModelUnitsSignature);
 
   if (getLevel() < 3)
   {
@@ -6058,8 +6501,14 @@ Model::getL3LengthUD()
 void
 Model::createExtentUnitsData()
 {
+  if (reuseFormulaUnitsData("extent", SBML_MODEL, mModelUnitsSignature))
+  {
+    return;
+  }
+
   UnitDefinition *ud = NULL;
   FormulaUnitsData *fud = createFormulaUnitsData("extent", SBML_MODEL);
+  fud->setSignature(mModelUnitsSignature);
 
   if (getLevel() < 3)
   {
@@ -6144,8 +6593,14 @@ Model::getL3ExtentUD()
 void
 Model::createSubstancePerTimeUnitsData()
 {
+  if (reuseFormulaUnitsData("subs_per_time", SBML_UNKNOWN, mModelUnitsSignature))
+  {
+    return;
+  }
+
   UnitDefinition *ud = NULL;
   FormulaUnitsData *fud = createFormulaUnitsData("subs_per_time", SBML_UNKNOWN);
+  fud->setSignature(mModelUnitsSignature);
 
   if (getLevel() < 3)
   {
@@ -6244,7 +6699,14 @@ Model::createCompartmentUnitsData()
   {
     Compartment* c = getCompartment(n);
 
+    std::string signature = getUnitsState(c);
+    if (reuseFormulaUnitsData(c->getId(), SBML_COMPARTMENT, signature))
+    {
+      continue;
+    }
+
     fud = createFormulaUnitsData(c->getId(), SBML_COMPARTMENT);
+    fud->setSignature(signature);
     ud = unitFormatter.getUnitDefinitionFromCompartment(c);
 
     if (ud->getNumUnits() == 0)
@@ -6272,7 +6734,14 @@ Model::createSpeciesUnitsData()
   {
     Species* s = getSpecies(n);
 
+    std::string signature = getUnitsState(*this, s, mUnitsStates);
+    if (reuseFormulaUnitsData(s->getId(), SBML_SPECIES, signature))
+    {
+      continue;
+    }
+
     fud = createFormulaUnitsData(s->getId(), SBML_SPECIES);
+    fud->setSignature(signature);
 
     /* TO DO - sort out getUDFromSpecies
      */
@@ -6318,45 +6787,55 @@ Model::createL3SpeciesUnitsData()
   {
     Species* s = getSpecies(n);
 
-    /* create the substance unit */
-    unitFormatter.resetFlags();
-    fud = createFormulaUnitsData(s->getId() + "subs", SBML_SPECIES);
-    ud = unitFormatter.getSpeciesSubstanceUnitDefinition(s);
+    std::string signature = getUnitsState(*this, s, mUnitsStates);
 
-    if (ud->getNumUnits() == 0)
-    {
-      fud->setContainsParametersWithUndeclaredUnits(true);
-      fud->setCanIgnoreUndeclaredUnits(false);
-    }
-    else
+    /* create the substance unit */
+    if (!reuseFormulaUnitsData(s->getId() + "subs", SBML_SPECIES, signature))
     {
-      fud->setContainsParametersWithUndeclaredUnits
-                              (unitFormatter.getContainsUndeclaredUnits());
-      fud->setCanIgnoreUndeclaredUnits
-                                (unitFormatter.canIgnoreUndeclaredUnits());
-    }
-
-    fud->setSpeciesSubstanceUnitDefinition(ud);
+      unitFormatter.resetFlags();
+      fud = createFormulaUnitsData(s->getId() + "subs", SBML_SPECIES);
+      fud->setSignature(signature);
+      ud = unitFormatter.getSpeciesSubstanceUnitDefinition(s);
 
-    /* create the extent unit */
-    unitFormatter.resetFlags();
-    fud = createFormulaUnitsData(s->getId() + "extent", SBML_SPECIES);
-    ud = unitFormatter.getSpeciesExtentUnitDefinition(s);
+      if (ud->getNumUnits() == 0)
+      {
+        fud->setContainsParametersWithUndeclaredUnits(true);
+        fud->setCanIgnoreUndeclaredUnits(false);
+      }
+      else
+      {
+        fud->setContainsParametersWithUndeclaredUnits
+                                (unitFormatter.getContainsUndeclaredUnits());
+        fud->setCanIgnoreUndeclaredUnits
+                                  (unitFormatter.canIgnoreUndeclaredUnits());
+      }
 
-    if (ud->getNumUnits() == 0)
-    {
-      fud->setContainsParametersWithUndeclaredUnits(true);
-      fud->setCanIgnoreUndeclaredUnits(false);
+      fud->setSpeciesSubstanceUnitDefinition(ud);
     }
-    else
+
+    /* create the extent unit */
+    if (!reuseFormulaUnitsData(s->getId() + "extent", SBML_SPECIES, signature))
     {
-      fud->setContainsParametersWithUndeclaredUnits
-                              (unitFormatter.getContainsUndeclaredUnits());
-      fud->setCanIgnoreUndeclaredUnits
-                                (unitFormatter.canIgnoreUndeclaredUnits());
-    }
+      unitFormatter.resetFlags();
+      fud = createFormulaUnitsData(s->getId() + "extent", SBML_SPECIES);
+      fud->setSignature(signature);
+      ud = unitFormatter.getSpeciesExtentUnitDefinition(s);
 
-    fud->setSpeciesExtentUnitDefinition(ud);
+      if (ud->getNumUnits() == 0)
+      {
+        fud->setContainsParametersWithUndeclaredUnits(true);
+        fud->setCanIgnoreUndeclaredUnits(false);
+      }
+      else
+      {
+        fud->setContainsParametersWithUndeclaredUnits
+                                (unitFormatter.getContainsUndeclaredUnits());
+        fud->setCanIgnoreUndeclaredUnits
+                                  (unitFormatter.canIgnoreUndeclaredUnits());
+      }
+
+      fud->setSpeciesExtentUnitDefinition(ud);
+    }
   }
 }
 /** @endcond */
@@ -6374,9 +6853,16 @@ Model::createParameterUnitsData()
   {
     Parameter* p = getParameter(n);
 
+    std::string signature = getUnitsState(p);
+    if (reuseFormulaUnitsData(p->getId(), SBML_PARAMETER, signature))
+    {
+      continue;
+    }
+
     unitFormatter.resetFlags();
 
     fud = createFormulaUnitsData(p->getId(), SBML_PARAMETER);
+    fud->setSignature(signature);
 
     unitFormatter.resetFlags();
     ud = unitFormatter.getUnitDefinitionFromParameter(p);
@@ -6426,7 +6912,16 @@ Model::createInitialAssignmentUnitsData(UnitFormulaFormatter * unitFormatter)
   for (unsigned int n=0; n < getNumInitialAssignments(); n++)
   {
     InitialAssignment* ia = getInitialAssignment(n);
+
+    std::string signature = getMathUnitsSignature(ia->getMath());
+    if (reuseFormulaUnitsData(ia->getSymbol(), SBML_INITIAL_ASSIGNMENT,
+                              signature))
+    {
+      continue;
+    }
+
     fud = createFormulaUnitsData(ia->getSymbol(), SBML_INITIAL_ASSIGNMENT);
+    fud->setSignature(signature);
     createUnitsDataFromMath(unitFormatter, fud, ia->getMath());
   }
 }
@@ -6448,7 +6943,14 @@ Model::createConstraintUnitsData(UnitFormulaFormatter * unitFormatter)
     newID.assign(newId);
     c->setInternalId(newID);
 
+    std::string signature = getMathUnitsSignature(c->getMath());
+    if (reuseFormulaUnitsData(newID, SBML_CONSTRAINT, signature))
+    {
+      continue;
+    }
+
     fud = createFormulaUnitsData(newID, SBML_CONSTRAINT);
+    fud->setSignature(signature);
     createUnitsDataFromMath(unitFormatter, fud, c->getMath());
   }
 }
@@ -6475,13 +6977,20 @@ Model::createRuleUnitsData(UnitFormulaFormatter * unitFormatter)
       r->setInternalId(newID);
       static_cast <AlgebraicRule *> (r)->setInternalIdOnly();
       countAlg++;
-
-      fud = createFormulaUnitsData(newID, r->getTypeCode());
     }
     else
     {
-      fud = createFormulaUnitsData(r->getVariable(), r->getTypeCode());
+      newID = r->getVariable();
     }
+
+    std::string signature = getMathUnitsSignature(r->getMath());
+    if (reuseFormulaUnitsData(newID, r->getTypeCode(), signature))
+    {
+      continue;
+    }
+
+    fud = createFormulaUnitsData(newID, r->getTypeCode());
+    fud->setSignature(signature);
     createUnitsDataFromMath(unitFormatter, fud, r->getMath());
   }
 }
@@ -6502,7 +7011,7 @@ Model::createReactionUnitsData(UnitFormulaFormatter * unitFormatter)
     /* get units returned by kineticLaw formula */
     if (react->isSetKineticLaw())
     {
-      fud = createFormulaUnitsData(react->getId(), SBML_KINETIC_LAW);
+      KineticLaw* kl = react->getKineticLaw();
 
       /* set the id of the kinetic law 
        * normally a kinetic law doesnt have an id
@@ -6510,24 +7019,38 @@ Model::createReactionUnitsData(UnitFormulaFormatter * unitFormatter)
        * so we set it to be the reaction id so 
        * that searching the listFormulaUnitsData can find it
        */
-      react->getKineticLaw()->setInternalId(react->getId());
+      kl->setInternalId(react->getId());
 
-      // have to use the old way for now as unitFormatter needs to know
-      // if we are in a reaction so it can access localParameters
-      unitFormatter->resetFlags();
-      if(react->getKineticLaw()->isSetMath())
+      /* local parameters are looked up before anything else */
+      std::string signature = getMathUnitsSignature(kl->getMath());
+      for (unsigned int j = 0; j < kl->getNumParameters(); j++)
       {
-        ud = unitFormatter->getUnitDefinition
-                                  (react->getKineticLaw()->getMath(), true, (int)n);
-        fud->setContainsParametersWithUndeclaredUnits
+        signature += ";" + kl->getParameter(j)->getId() + "=" 
+                         + kl->getParameter(j)->getUnits();
+      }
+
+      if (!reuseFormulaUnitsData(react->getId(), SBML_KINETIC_LAW, signature))
+      {
+        fud = createFormulaUnitsData(react->getId(), SBML_KINETIC_LAW);
+        fud->setSignature(signature);
+
+        // have to use the old way for now as unitFormatter needs to know
+        // if we are in a reaction so it can access localParameters
+        ud = NULL;
+        unitFormatter->resetFlags();
+        if(kl->isSetMath())
+        {
+          ud = unitFormatter->getUnitDefinition(kl->getMath(), true, (int)n);
+          fud->setContainsParametersWithUndeclaredUnits
                                  (unitFormatter->getContainsUndeclaredUnits());
-        fud->setCanIgnoreUndeclaredUnits
+          fud->setCanIgnoreUndeclaredUnits
                                    (unitFormatter->canIgnoreUndeclaredUnits());
-      }
+        }
 
-      fud->setUnitDefinition(ud);
+        fud->setUnitDefinition(ud);
+      }
 
-      createLocalParameterUnitsData(react->getKineticLaw(), unitFormatter);
+      createLocalParameterUnitsData(kl, unitFormatter);
     }
 
     ///* get units returned by any stoichiometryMath set */
@@ -6561,9 +7084,15 @@ Model::createLocalParameterUnitsData(KineticLaw * kl,
     Parameter * lp = kl->getParameter(n);
     std::string lpId = lp->getId() + '_' + kl->getInternalId();
 
+    std::string units = lp->getUnits();
+    if (reuseFormulaUnitsData(lpId, SBML_LOCAL_PARAMETER, units))
+    {
+      continue;
+    }
+
     fud = createFormulaUnitsData(lpId, SBML_LOCAL_PARAMETER);
+    fud->setSignature(units);
 
-    std::string units = lp->getUnits();
     if (units.empty() == false)
     {
       char * charUnits = safe_strdup(units.c_str());
@@ -6690,11 +7219,21 @@ Model::createDelayUnitsData(UnitFormulaFormatter* unitFormatter, Event * e,
                             const std::string& eventId)
 {
   UnitDefinition *ud = NULL;
-  FormulaUnitsData *fud = createFormulaUnitsData(eventId, SBML_EVENT);
 
   Delay * d = e->getDelay();
   d->setInternalId(eventId);
 
+  /* the time units of the event are used as well */
+  std::string signature = getMathUnitsSignature(d->getMath()) 
+                          + ";" + e->getTimeUnits();
+  if (reuseFormulaUnitsData(eventId, SBML_EVENT, signature))
+  {
+    return;
+  }
+
+  FormulaUnitsData *fud = createFormulaUnitsData(eventId, SBML_EVENT);
+  fud->setSignature(signature);
+
   createUnitsDataFromMath(unitFormatter, fud, d->getMath());
 
   /* get event time definition */
@@ -6715,11 +7254,18 @@ void
 Model::createTriggerUnitsData(UnitFormulaFormatter* unitFormatter, Event * e,
   const std::string& eventId)
 {
-  FormulaUnitsData *fud = createFormulaUnitsData(eventId, SBML_TRIGGER);
-
   Trigger * d = e->getTrigger();
   d->setInternalId(eventId);
 
+  std::string signature = getMathUnitsSignature(d->getMath());
+  if (reuseFormulaUnitsData(eventId, SBML_TRIGGER, signature))
+  {
+    return;
+  }
+
+  FormulaUnitsData *fud = createFormulaUnitsData(eventId, SBML_TRIGGER);
+  fud->setSignature(signature);
+
   createUnitsDataFromMath(unitFormatter, fud, d->getMath());
 
   fud->setEventTimeUnitDefinition(NULL);
@@ -6732,10 +7278,17 @@ void
 Model::createPriorityUnitsData(UnitFormulaFormatter* unitFormatter, 
                                Priority * p, const std::string& eventId)
 {
-  FormulaUnitsData *fud = createFormulaUnitsData(eventId, SBML_PRIORITY);
-
   p->setInternalId(eventId);
 
+  std::string signature = getMathUnitsSignature(p->getMath());
+  if (reuseFormulaUnitsData(eventId, SBML_PRIORITY, signature))
+  {
+    return;
+  }
+
+  FormulaUnitsData *fud = createFormulaUnitsData(eventId, SBML_PRIORITY);
+  fud->setSignature(signature);
+
   createUnitsDataFromMath(unitFormatter, fud, p->getMath());
 }
 /** @endcond */
@@ -6747,7 +7300,15 @@ Model::createEventAssignmentUnitsData(UnitFormulaFormatter* unitFormatter,
                             EventAssignment * ea, const std::string& eventId)
 {
   std::string eaId = ea->getVariable() + eventId;
+
+  std::string signature = getMathUnitsSignature(ea->getMath());
+  if (reuseFormulaUnitsData(eaId, SBML_EVENT_ASSIGNMENT, signature))
+  {
+    return;
+  }
+
   FormulaUnitsData *fud = createFormulaUnitsData(eaId, SBML_EVENT_ASSIGNMENT);
+  fud->setSignature(signature);
 
   createUnitsDataFromMath(unitFormatter, fud, ea->getMath());
 }
@@ -8225,6 +8786,15 @@ Model_populateListFormulaUnitsData(Model_t *m)
 }
 
 
+LIBSBML_EXTERN
+void 
+Model_updateListFormulaUnitsData(Model_t *m)
+{
+  if (m != NULL) 
+    m->updateListFormulaUnitsData();
+}
+
+
 LIBSBML_EXTERN
 int 
 Model_isPopulatedListFormulaUnitsData(Model_t *m)
@@ -487,6 +487,8 @@ class LIBSBML_EXTERN Model : public SBase
   typedef std::pair<const std::string, int>   KeyValue;
   typedef std::map<KeyValue, FormulaUnitsData*> UnitsValueMap;
   typedef UnitsValueMap::const_iterator                  UnitsValueIter;
+  typedef std::multimap<KeyValue, FormulaUnitsData*> PreviousUnitsMap;
+  typedef PreviousUnitsMap::iterator                PreviousUnitsIter;
 #endif
   friend class SBMLDocument; //So that SBMLDocument can change the element namespace if it needs to.
 public:
@@ -2854,12 +2856,24 @@ public:
   virtual void renameSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /**
+   * @copydoc doc_renamesidrefmap_common
+   */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
   /**
    * @copydoc doc_renameunitsidref_common
    */
   virtual void renameUnitSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /**
+   * @copydoc doc_renameunitsidrefmap_common
+   */
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * Predicate returning @c true if the
@@ -3468,6 +3482,31 @@ public:
   void populateListFormulaUnitsData();
 
 
+  /**
+   * Brings the internal list of derived units for this Model object up to
+   * date with any changes made to the model since it was populated.
+   *
+   * Each entry of the list records a summary of the parts of the model
+   * its units were derived from: the math of the component, the units of
+   * the compartments, species and parameters that math refers to, and the
+   * units of the model as a whole.  This method derives units again only
+   * for the entries whose summary has changed, and for components that
+   * have been added, and keeps the others.  The resulting list is the same
+   * as the one populateListFormulaUnitsData() would create.
+   *
+   * If the list has not been populated, this method populates it.  A
+   * change to the unit definitions, function definitions or model-wide
+   * units of the model causes the whole list to be derived again.
+   *
+   * This method is called by SBMLDocument::checkConsistency() before
+   * checking the consistency of units, so that a model may be edited and
+   * validated again without recalculating the units of every component.
+   *
+   * @see populateListFormulaUnitsData()
+   */
+  void updateListFormulaUnitsData();
+
+
   /**
    * Predicate returning @c true if libSBML has derived units for the
    * components of this model.
@@ -4213,6 +4252,21 @@ protected:
   IdList                     mMetaidList;
   UnitsValueMap              mUnitsDataMap;
 
+  /* used while the list of FormulaUnitsData is built: the signature of
+   * the model-wide units, the units state of each id that math may refer
+   * to and the entries of the previous list that may be kept
+   */
+  std::string                                 mModelUnitsSignature;
+  std::map<std::string, std::string>          mUnitsStates;
+  PreviousUnitsMap                            mPreviousUnitsData;
+
+  /* the values used by SBMLTransforms::evaluateASTNode(node, model),
+   * stored by SBMLTransforms::mapComponentValues() and kept until
+   * SBMLTransforms::clearComponentValues(model) is called
+   */
+  mutable std::map<const std::string, std::pair<double, bool> > mComponentValues;
+  friend class SBMLTransforms;
+
 
   /* the validator classes need to be friends to access the 
    * protected constructor that takes no arguments
@@ -4254,6 +4308,34 @@ protected:
    */
   void removeListFormulaUnitsData();
 
+
+  /*
+   * Creates the entries of the list of FormulaUnitsData, keeping those of
+   * the previous list whose signature has not changed.
+   */
+  void createListFormulaUnitsData();
+
+
+  /*
+   * Moves an entry of the previous list with the given key and signature
+   * to the list, returning false if there is none.
+   */
+  bool reuseFormulaUnitsData(const std::string& id, int typecode,
+                             const std::string& signature);
+
+
+  /*
+   * Deletes the entries of the previous list that have not been kept.
+   */
+  void removePreviousUnitsData();
+
+
+  /*
+   * returns the signature of the given math, including the units state of
+   * each id it refers to
+   */
+  std::string getMathUnitsSignature(const ASTNode * math) const;
+
   
   /*
    * creates the substance units data item
@@ -6627,6 +6709,22 @@ Model_populateListFormulaUnitsData(Model_t *m);
 /** @endcond */
 
 
+/** @cond doxygenLibsbmlInternal */
+/**
+ * Brings the list of FormulaUnitsData of the given Model_t structure up to
+ * date with any changes made to the model since it was populated, deriving
+ * units again only for the components that have changed.
+ *
+ * @param m the Model_t structure.
+ *
+ * @memberof Model_t
+ */
+LIBSBML_EXTERN
+void 
+Model_updateListFormulaUnitsData(Model_t *m);
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 /**
  * Predicate returning @c 1 (true) or @c 0 (false) depending on whether 
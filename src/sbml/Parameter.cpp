@@ -341,6 +341,7 @@ Parameter::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -364,6 +365,7 @@ Parameter::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -435,6 +437,7 @@ Parameter::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -977,6 +980,13 @@ bool Parameter::isExplicitlySetConstant() const
 /** @endcond */
 
 
+void 
+Parameter::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  // a Parameter has no SIdRef attributes of its own
+  renamePluginSIdRefs(renamed);
+}
+
 void 
 Parameter::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -984,6 +994,14 @@ Parameter::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   if (mUnits == oldid) mUnits= newid;
 }
 
+void 
+Parameter::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  std::string newid;
+  if (getRenamedId(mUnits, renamed, newid)) mUnits = newid;
+}
+
 /** @cond doxygenLibsbmlInternal */
 /**
  * Subclasses should override this method to get the list of
@@ -1851,10 +1869,8 @@ ListOfParameters::get (const std::string& sid)
 const Parameter*
 ListOfParameters::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqP(sid) );
-  return (result == mItems.end()) ? NULL : static_cast <Parameter*> (*result);
+  unsigned int n = getIndexById(sid);
+  return (n < mItems.size()) ? static_cast <Parameter*> (mItems[n]) : NULL;
 }
 
 
@@ -1879,6 +1895,7 @@ ListOfParameters::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <Parameter*> (item);
@@ -691,6 +691,15 @@ public:
   virtual bool hasRequiredAttributes() const ;
 
 
+  using SBase::renameSIdRefs;
+
+
+  /**
+   * @copydoc doc_renamesidrefmap_common
+   */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
   /**
    * Renames all the @c UnitSIdRef attributes on this element.
    *
@@ -708,6 +717,12 @@ public:
   virtual void renameUnitSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /**
+   * @copydoc doc_renameunitsidrefmap_common
+   */
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
   /** @cond doxygenLibsbmlInternal */
   /* set a flag to indicate that a parameter should 
    * calculate its units from math */
@@ -284,6 +284,15 @@ Priority::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+Priority::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+
 void 
 Priority::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -293,6 +302,15 @@ Priority::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void 
+Priority::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+
 /** @cond doxygenLibsbmlInternal */
 void 
 Priority::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
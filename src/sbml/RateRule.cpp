@@ -433,6 +433,16 @@ RateRule::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+RateRule::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  Rule::renameSIdRefs(renamed);
+  std::string newid;
+  if (getRenamedId(getVariable(), renamed, newid)) {
+    setVariable(newid);
+  }
+}
+
 #endif /* __cplusplus */
 
 
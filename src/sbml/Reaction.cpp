@@ -333,6 +333,16 @@ Reaction::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+Reaction::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  std::string newid;
+  if (getRenamedId(mCompartment, renamed, newid)) {
+    setCompartment(newid);
+  }
+}
+
 /*
  * Initializes the fields of this Reaction to their defaults:
  *
@@ -523,6 +533,7 @@ Reaction::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -546,6 +557,7 @@ Reaction::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -660,6 +672,7 @@ Reaction::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -2534,10 +2547,8 @@ ListOfReactions::get (const std::string& sid)
 const Reaction*
 ListOfReactions::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEq<Reaction>(sid) );
-  return (result == mItems.end()) ? NULL : static_cast <Reaction*> (*result);
+  unsigned int n = getIndexById(sid);
+  return (n < mItems.size()) ? static_cast <Reaction*> (mItems[n]) : NULL;
 }
 
 
@@ -2562,6 +2573,7 @@ ListOfReactions::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
 
@@ -384,6 +384,7 @@ Rule::setVariable (const std::string& sid)
   else
   {
     mVariable = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -429,6 +430,7 @@ Rule::unsetVariable ()
   }
 
   mVariable.erase();
+  updateElementIdIndex();
 
   if (mVariable.empty()) 
   {
@@ -858,6 +860,24 @@ Rule::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+Rule::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+  else if (isSetFormula()) {
+    ASTNode* math = SBML_parseFormula(mFormula.c_str());
+    if (math==NULL) return;
+    math->renameSIdRefs(renamed);
+    char* formula = SBML_formulaToString(math);
+    setFormula(formula);
+    delete math;
+    delete formula;
+  }
+}
+
 void 
 Rule::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -876,6 +896,24 @@ Rule::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void 
+Rule::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+  else if (isSetFormula()) {
+    ASTNode* math = SBML_parseFormula(mFormula.c_str());
+    if (math==NULL) return;
+    math->renameUnitSIdRefs(renamed);
+    char* formula = SBML_formulaToString(math);
+    setFormula(formula);
+    delete math;
+    delete formula;
+  }
+}
+
 /** @cond doxygenLibsbmlInternal */
 void 
 Rule::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
@@ -1662,10 +1700,8 @@ ListOfRules::get (const std::string& sid)
 const Rule*
 ListOfRules::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqRule(sid) );
-  return (result == mItems.end()) ? NULL : static_cast <Rule*> (*result);
+  unsigned int n = getIndexById(sid);
+  return (n < mItems.size()) ? static_cast <Rule*> (mItems[n]) : NULL;
 }
 
 
@@ -1704,6 +1740,7 @@ ListOfRules::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <Rule*> (item);
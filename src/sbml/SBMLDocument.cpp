@@ -42,6 +42,8 @@
  * ---------------------------------------------------------------------- -->*/
 
 #include <iostream>
+#include <algorithm>
+#include <sstream>
 
 #include <sbml/xml/XMLAttributes.h>
 #include <sbml/xml/XMLNamespaces.h>
@@ -53,6 +55,7 @@
 #include <sbml/validator/SBMLInternalValidator.h>
 #include <sbml/validator/StrictUnitConsistencyValidator.h>
 #include <sbml/validator/UnitConsistencyValidator.h>
+#include <sbml/validator/ValidationCallback.h>
 
 #include <sbml/Model.h>
 #include <sbml/SBMLErrorLog.h>
@@ -127,6 +130,8 @@ SBMLDocument::SBMLDocument (unsigned int level, unsigned int version) :
  , mLocationURI     ("")
  , mRequiredAttrOfUnknownPkg()
  , mRequiredAttrOfUnknownDisabledPkg()
+ , mElementIdIndexEnabled (false)
+ , mElementIdIndexValid   (false)
 {
   if (mLevel   == 0 && mVersion == 0)  
   {
@@ -161,6 +166,8 @@ SBMLDocument::SBMLDocument (SBMLNamespaces* sbmlns) :
  , mLocationURI ("")
  , mRequiredAttrOfUnknownPkg()
  , mRequiredAttrOfUnknownDisabledPkg()
+ , mElementIdIndexEnabled (false)
+ , mElementIdIndexValid   (false)
 {
   if (!hasValidLevelVersionNamespaceCombination())
   {
@@ -232,6 +239,7 @@ SBMLDocument::SBMLDocument (SBMLNamespaces* sbmlns) :
  */
 SBMLDocument::~SBMLDocument ()
 {
+  clearElementIdIndex();
   if (mInternalValidator != NULL)
     delete mInternalValidator;
   if (mModel != NULL)
@@ -255,6 +263,8 @@ SBMLDocument::SBMLDocument (const SBMLDocument& orig)
  , mRequiredAttrOfUnknownPkg(orig.mRequiredAttrOfUnknownPkg)
  , mRequiredAttrOfUnknownDisabledPkg(orig.mRequiredAttrOfUnknownDisabledPkg)
  , mPkgUseDefaultNSMap()
+ , mElementIdIndexEnabled (orig.mElementIdIndexEnabled)
+ , mElementIdIndexValid   (false)
 {
   
   
@@ -263,6 +273,10 @@ SBMLDocument::SBMLDocument (const SBMLDocument& orig)
   mInternalValidator->setDocument(this);
   mInternalValidator->setApplicableValidators(orig.getApplicableValidators());
   mInternalValidator->setConversionValidators(orig.getConversionValidators());
+  mInternalValidator->setNumThreads(orig.getNumValidationThreads());
+  mInternalValidator->setRoundTripReadChecks(orig.isEnabledRoundTripReadChecks());
+  mInternalValidator->setProfile(orig.getValidationProfile());
+  mInternalValidator->setCallback(orig.getValidationCallback());
   
   if (orig.mModel != NULL) 
   {
@@ -282,6 +296,7 @@ SBMLDocument& SBMLDocument::operator=(const SBMLDocument& rhs)
   if(&rhs!=this)
   {
     this->SBase::operator =(rhs);
+    clearElementIdIndex();
     setSBMLDocument(this);
 
     mLevel                             = rhs.mLevel;
@@ -402,6 +417,12 @@ SBase*
 SBMLDocument::getElementBySId(const std::string& id)
 {
   if (id.empty()) return NULL;
+  if (mElementIdIndexEnabled)
+  {
+    bool answered = false;
+    SBase* obj = getElementFromIndex(mSIdIndex, id, true, answered);
+    if (answered) return obj;
+  }
   if (mModel != NULL) {
     if (mModel->getId() == id) return mModel;
     SBase* obj = mModel->getElementBySId(id);
@@ -416,6 +437,12 @@ SBMLDocument::getElementByMetaId(const std::string& metaid)
 {
   if (metaid.empty()) return NULL;
   if (getMetaId()==metaid) return this;
+  if (mElementIdIndexEnabled)
+  {
+    bool answered = false;
+    SBase* obj = getElementFromIndex(mMetaIdIndex, metaid, false, answered);
+    if (answered) return obj;
+  }
   if (mModel != NULL) {
     if (mModel->getMetaId() == metaid) return mModel;
     SBase * obj = mModel->getElementByMetaId(metaid);
@@ -685,40 +712,110 @@ SBMLDocument::setConsistencyChecksForConversion(SBMLErrorCategory_t category,
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+static bool
+isStopped(const ValidationCallback* callback)
+{
+  return callback != NULL && callback->isStopped();
+}
+
+
 /*
- * Performs a set of semantic consistency checks on the document.  Query
- * the results by calling getNumErrors() and getError().
- *
- * @return the number of failed checks (errors) encountered.
+ * Passes the errors in the log from the given index on to the callback,
+ * as the validators of packages and those added with addValidator() do
+ * not pass them on as they are found.
  */
-unsigned int
-SBMLDocument::checkConsistency ()
+static void
+reportErrors(ValidationCallback* callback, const SBMLErrorLog& log,
+             unsigned int from)
 {
-  // keep a copy of the override status
-  // and then override any change
-  XMLErrorSeverityOverride_t overrideStatus = 
-                                  getErrorLog()->getSeverityOverride();
-  getErrorLog()->setSeverityOverride(LIBSBML_OVERRIDE_DISABLED);
+  if (callback == NULL) return;
 
-  unsigned int numErrors = mInternalValidator->checkConsistency();
+  for (unsigned int n = from; n < log.getNumErrors(); ++n)
+  {
+    if (!callback->report(*log.getError(n))) break;
+  }
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+unsigned int
+SBMLDocument::checkPluginsAndValidators()
+{
+  unsigned int numErrors = 0;
 
-  for (unsigned int i = 0; i < getNumPlugins(); i++)
+  ValidationCallback* callback = getValidationCallback();
+  for (unsigned int i = 0; i < getNumPlugins() && !isStopped(callback); i++)
   {
+    unsigned int before = getNumErrors();
     numErrors += static_cast<SBMLDocumentPlugin*>
                       (getPlugin(i))->checkConsistency();
+    reportErrors(callback, mErrorLog, before);
   }
 
   list<SBMLValidator*>::iterator it;
-  for (it = mValidators.begin(); it != mValidators.end(); it++)
+  for (it = mValidators.begin(); 
+       it != mValidators.end() && !isStopped(callback); it++)
   {
     long newErrors = (*it)->validate(*this);
     if (newErrors > 0)
     {
+      unsigned int before = getNumErrors();
       mErrorLog.add((*it)->getFailures());
       numErrors += newErrors;
+      reportErrors(callback, mErrorLog, before);
     }
   }
 
+  return numErrors;
+}
+/** @endcond */
+
+
+/*
+ * Performs a set of semantic consistency checks on the document.  Query
+ * the results by calling getNumErrors() and getError().
+ *
+ * @return the number of failed checks (errors) encountered.
+ */
+unsigned int
+SBMLDocument::checkConsistency ()
+{
+  // keep a copy of the override status
+  // and then override any change
+  XMLErrorSeverityOverride_t overrideStatus = 
+                                  getErrorLog()->getSeverityOverride();
+  getErrorLog()->setSeverityOverride(LIBSBML_OVERRIDE_DISABLED);
+
+  unsigned int numErrors = mInternalValidator->checkConsistency();
+
+  numErrors += checkPluginsAndValidators();
+
+  // restore value of override
+  getErrorLog()->setSeverityOverride(overrideStatus);
+
+  return numErrors;
+}
+
+
+/*
+ * Performs the same consistency checks as checkConsistency(), but only
+ * checks again what has changed since this was last called.
+ */
+unsigned int
+SBMLDocument::checkConsistencyIncremental ()
+{
+  // keep a copy of the override status
+  // and then override any change
+  XMLErrorSeverityOverride_t overrideStatus = 
+                                  getErrorLog()->getSeverityOverride();
+  getErrorLog()->setSeverityOverride(LIBSBML_OVERRIDE_DISABLED);
+
+  unsigned int numErrors = mInternalValidator->checkConsistencyIncremental();
+
+  numErrors += checkPluginsAndValidators();
+
   // restore value of override
   getErrorLog()->setSeverityOverride(overrideStatus);
 
@@ -746,22 +843,7 @@ SBMLDocument::checkConsistencyWithStrictUnits ()
 
   unsigned int numErrors = mInternalValidator->checkConsistency();
 
-  for (unsigned int i = 0; i < getNumPlugins(); i++)
-  {
-    numErrors += static_cast<SBMLDocumentPlugin*>
-                      (getPlugin(i))->checkConsistency();
-  }
-
-  list<SBMLValidator*>::iterator it;
-  for (it = mValidators.begin(); it != mValidators.end(); it++)
-  {
-    long newErrors = (*it)->validate(*this);
-    if (newErrors > 0)
-    {
-      mErrorLog.add((*it)->getFailures());
-      numErrors += newErrors;
-    }
-  }
+  numErrors += checkPluginsAndValidators();
 
   // check we have no serious errors 
   bool seriousErrors = getNumErrors(LIBSBML_SEV_FATAL) > 0
@@ -1400,6 +1482,444 @@ SBMLDocument::isEnabledDefaultNS(const std::string& package)
 }
 
 
+int
+SBMLDocument::enableElementIdIndex(bool flag)
+{
+  if (!flag)
+  {
+    clearElementIdIndex();
+    mSIdWalkClasses.clear();
+    mMetaIdWalkClasses.clear();
+  }
+  mElementIdIndexEnabled = flag;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+bool
+SBMLDocument::isEnabledElementIdIndex() const
+{
+  return mElementIdIndexEnabled;
+}
+
+
+int
+SBMLDocument::setNumValidationThreads(unsigned int numThreads)
+{
+  mInternalValidator->setNumThreads(numThreads);
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+unsigned int
+SBMLDocument::getNumValidationThreads() const
+{
+  return mInternalValidator->getNumThreads();
+}
+
+
+int
+SBMLDocument::enableRoundTripReadChecks(bool flag)
+{
+  mInternalValidator->setRoundTripReadChecks(flag);
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+bool
+SBMLDocument::isEnabledRoundTripReadChecks() const
+{
+  return mInternalValidator->getRoundTripReadChecks();
+}
+
+
+int
+SBMLDocument::setValidationProfile(ValidatorProfile* profile)
+{
+  mInternalValidator->setProfile(profile);
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+ValidatorProfile*
+SBMLDocument::getValidationProfile() const
+{
+  return mInternalValidator->getProfile();
+}
+
+
+int
+SBMLDocument::setValidationCallback(ValidationCallback* callback)
+{
+  mInternalValidator->setCallback(callback);
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+ValidationCallback*
+SBMLDocument::getValidationCallback() const
+{
+  return mInternalValidator->getCallback();
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+void
+SBMLDocument::prepareForConcurrentReading()
+{
+  if (mElementIdIndexEnabled && !mElementIdIndexValid)
+  {
+    buildElementIdIndex();
+  }
+
+  List* all = getAllElements();
+  for (ListIterator it = all->begin(); it != all->end(); ++it)
+  {
+    SBase* element = static_cast<SBase*>(*it);
+    if (element->getTypeCode() == SBML_LIST_OF)
+    {
+      static_cast<ListOf*>(element)->buildIdLookup();
+    }
+    else if (element->getTypeCode() == SBML_KINETIC_LAW)
+    {
+      static_cast<KineticLaw*>(element)->getMath();
+    }
+    else if (dynamic_cast<Rule*>(element) != NULL)
+    {
+      static_cast<Rule*>(element)->getMath();
+    }
+  }
+  delete all;
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Returns the key under which the answers of the document walk are
+ * cached for the given element: its own type and those of its parent and
+ * grandparent.  The walk skips whole classes of elements (the PortSId,
+ * UnitSId and local parameter namespaces, rules and assignments whose
+ * getId() returns their variable, parameters local to an L2 kinetic law,
+ * ...), and which of them it skips is decided by the context an element
+ * sits in, not by the element alone.
+ */
+static std::string
+getWalkClass(const SBase* element)
+{
+  std::ostringstream key;
+  for (int depth = 0; depth < 3 && element != NULL; ++depth)
+  {
+    key << element->getPackageName() << ':' << element->getTypeCode() << '/';
+    element = element->getParentSBMLObject();
+  }
+  return key.str();
+}
+
+
+static void
+removeFromIndexEntry(std::vector<SBase*>& entry, const SBase* element)
+{
+  std::vector<SBase*>::iterator it =
+    std::find(entry.begin(), entry.end(), element);
+  if (it != entry.end()) entry.erase(it);
+}
+
+
+static void
+removeFromIndex(std::map<std::string, std::vector<SBase*> >& index,
+                const std::string& key, const SBase* element)
+{
+  if (key.empty()) return;
+  std::map<std::string, std::vector<SBase*> >::iterator entry = index.find(key);
+  if (entry == index.end()) return;
+  removeFromIndexEntry(entry->second, element);
+  if (entry->second.empty()) index.erase(entry);
+}
+
+
+/*
+ * Enters element under key, as far as the walk class of the element
+ * allows.  Returns false if the class has not been seen before.
+ */
+bool
+SBMLDocument::addToIndex(ElementIdIndex& index, WalkClassMap& classes,
+                         const std::string& key, SBase* element)
+{
+  if (key.empty()) return true;
+
+  WalkClassMap::const_iterator cls = classes.find(getWalkClass(element));
+  if (cls == classes.end()) return false;
+
+  switch (cls->second)
+  {
+  case WALK_FINDS:
+    index[key].push_back(element);
+    break;
+  case WALK_UNDECIDED:
+    {
+      // a NULL entry forces lookups of this key back to the walk
+      std::vector<SBase*>& entry = index[key];
+      entry.push_back(element);
+      if (std::find(entry.begin(), entry.end(), (SBase*)NULL) == entry.end())
+      {
+        entry.push_back(NULL);
+      }
+    }
+    break;
+  default:
+    break;
+  }
+  return true;
+}
+
+
+/*
+ * Asks the document walk (with the index switched off) for the given key
+ * and classifies the element's context by the answer.
+ */
+int
+SBMLDocument::probeWalk(SBase* element, const std::string& key, bool isSId)
+{
+  bool enabled = mElementIdIndexEnabled;
+  mElementIdIndexEnabled = false;
+  SBase* found = isSId ? getElementBySId(key) : getElementByMetaId(key);
+  mElementIdIndexEnabled = enabled;
+
+  if (found == element) return WALK_FINDS;
+  return (found == NULL) ? WALK_SKIPS : WALK_UNDECIDED;
+}
+
+
+void
+SBMLDocument::classifyWalk(const std::vector<SBase*>& elements, bool isSId)
+{
+  ElementIdIndex& index = isSId ? mSIdIndex : mMetaIdIndex;
+  WalkClassMap& classes = isSId ? mSIdWalkClasses : mMetaIdWalkClasses;
+
+  for (size_t i = 0; i < elements.size(); ++i)
+  {
+    SBase* element = elements[i];
+    const std::string& key = isSId ? element->getId() : element->getMetaId();
+    if (key.empty()) continue;
+
+    std::string cls = getWalkClass(element);
+    if (classes.find(cls) != classes.end()) continue;
+
+    // only an element with a unique key gives a clear answer
+    if (index[key].size() != 1) continue;
+
+    int found = probeWalk(element, key, isSId);
+    if (found != WALK_UNDECIDED)
+    {
+      classes[cls] = found;
+    }
+  }
+
+  // Classes whose keys all collide with other elements could not be
+  // probed.  Rules and assignments report their variable as id, which
+  // always collides with the variable itself; the walk never matches those
+  // derived ids, so they are left out rather than sending every lookup of
+  // the variable back to the walk.
+  for (size_t i = 0; i < elements.size(); ++i)
+  {
+    SBase* element = elements[i];
+    const std::string& key = isSId ? element->getId() : element->getMetaId();
+    if (key.empty()) continue;
+    std::string cls = getWalkClass(element);
+    if (classes.find(cls) == classes.end())
+    {
+      bool derivedId = isSId && key != element->getIdAttribute();
+      classes[cls] = derivedId ? WALK_SKIPS : WALK_UNDECIDED;
+    }
+  }
+}
+
+
+void
+SBMLDocument::updateElementIdIndex(SBase* element)
+{
+  if (!mElementIdIndexValid || element == NULL) return;
+
+  // an element taken out of its ListOf keeps its parent and document, but
+  // the walk no longer reaches it
+  if (!element->mInElementIdIndex && !isAttached(element)) return;
+
+  addToElementIdIndex(element);
+}
+
+
+/*
+ * Returns true if the document can be reached from the given element by
+ * going up from each object to its parent, and each object met on the
+ * way is still an item of the ListOf above it.
+ */
+bool
+SBMLDocument::isAttached(const SBase* element) const
+{
+  const SBase* child = element;
+  const SBase* parent = child->getParentSBMLObject();
+  while (parent != NULL)
+  {
+    const ListOf* list = dynamic_cast<const ListOf*>(parent);
+    if (list != NULL && !list->hasItem(child)) return false;
+
+    child = parent;
+    parent = child->getParentSBMLObject();
+  }
+  return child == this;
+}
+
+
+void
+SBMLDocument::addToElementIdIndex(SBase* element)
+{
+  const std::string& sid = element->isSetId() ? element->getId() : mEmptyString;
+  const std::string& metaid = element->getMetaId();
+
+  IndexedElementMap::iterator it = mIndexedElements.find(element);
+  if (it != mIndexedElements.end())
+  {
+    if (it->second.first == sid && it->second.second == metaid) return;
+    removeFromElementIdIndex(element, false);
+  }
+
+  if (sid.empty() && metaid.empty()) return;
+
+  if (!addToIndex(mSIdIndex, mSIdWalkClasses, sid, element) ||
+      !addToIndex(mMetaIdIndex, mMetaIdWalkClasses, metaid, element))
+  {
+    // an element in a context not seen before: classify it on next lookup
+    clearElementIdIndex();
+    return;
+  }
+  mIndexedElements[element] = std::make_pair(sid, metaid);
+  element->mInElementIdIndex = true;
+}
+
+
+void
+SBMLDocument::removeFromElementIdIndex(SBase* element, bool includeChildren)
+{
+  if (!mElementIdIndexValid || element == NULL) return;
+
+  IndexedElementMap::iterator it = mIndexedElements.find(element);
+  if (it != mIndexedElements.end())
+  {
+    removeFromIndex(mSIdIndex, it->second.first, element);
+    removeFromIndex(mMetaIdIndex, it->second.second, element);
+    mIndexedElements.erase(it);
+    element->mInElementIdIndex = false;
+  }
+
+  if (includeChildren)
+  {
+    List* children = element->getAllElements();
+    for (ListIterator child = children->begin(); child != children->end(); ++child)
+    {
+      removeFromElementIdIndex(static_cast<SBase*>(*child), false);
+    }
+    delete children;
+  }
+}
+
+
+void
+SBMLDocument::buildElementIdIndex()
+{
+  clearElementIdIndex();
+
+  std::vector<SBase*> elements;
+  elements.push_back(this);
+  List* all = getAllElements();
+  for (ListIterator it = all->begin(); it != all->end(); ++it)
+  {
+    elements.push_back(static_cast<SBase*>(*it));
+  }
+  delete all;
+
+  // enter every key first, so that the walk is only asked about keys
+  // that are unique in the document
+  for (size_t i = 0; i < elements.size(); ++i)
+  {
+    SBase* element = elements[i];
+    if (element->isSetId()) mSIdIndex[element->getId()].push_back(element);
+    if (element->isSetMetaId()) mMetaIdIndex[element->getMetaId()].push_back(element);
+  }
+  classifyWalk(elements, true);
+  classifyWalk(elements, false);
+  mSIdIndex.clear();
+  mMetaIdIndex.clear();
+
+  mElementIdIndexValid = true;
+  for (size_t i = 0; i < elements.size(); ++i)
+  {
+    addToElementIdIndex(elements[i]);
+  }
+}
+
+
+void
+SBMLDocument::clearElementIdIndex()
+{
+  IndexedElementMap::iterator it;
+  for (it = mIndexedElements.begin(); it != mIndexedElements.end(); ++it)
+  {
+    const_cast<SBase*>(it->first)->mInElementIdIndex = false;
+  }
+  mIndexedElements.clear();
+  mSIdIndex.clear();
+  mMetaIdIndex.clear();
+  mElementIdIndexValid = false;
+}
+
+
+/*
+ * Looks the key up in the given index.  'answered' is set to false when the
+ * caller has to fall back to walking the document, which is the case when
+ * several elements share the key (so that the first one in document order
+ * is returned, as before).  An entry whose element no longer carries the
+ * key means it was changed behind the index's back, so the index is built
+ * again.
+ */
+SBase*
+SBMLDocument::getElementFromIndex(ElementIdIndex& index,
+                                  const std::string& key,
+                                  bool isSId, bool& answered)
+{
+  answered = false;
+  for (int attempt = 0; attempt < 2; ++attempt)
+  {
+    if (!mElementIdIndexValid)
+    {
+      buildElementIdIndex();
+    }
+
+    ElementIdIndex::iterator it = index.find(key);
+    if (it == index.end())
+    {
+      answered = true;
+      return NULL;
+    }
+    if (it->second.size() != 1)
+    {
+      return NULL;
+    }
+
+    SBase* element = it->second.front();
+    const std::string& current = isSId ? element->getId() : element->getMetaId();
+    if (current == key)
+    {
+      answered = true;
+      return element;
+    }
+    clearElementIdIndex();
+  }
+  return NULL;
+}
+/** @endcond */
+
+
 int
 SBMLDocument::setPackageRequired(const std::string& package, bool flag)
 {
@@ -2394,6 +2914,14 @@ SBMLDocument_checkConsistency (SBMLDocument_t *d)
 }
 
 
+LIBSBML_EXTERN
+unsigned int
+SBMLDocument_checkConsistencyIncremental (SBMLDocument_t *d)
+{
+  return (d != NULL) ? d->checkConsistencyIncremental() : SBML_INT_MAX;
+}
+
+
 LIBSBML_EXTERN
 unsigned int
 SBMLDocument_checkInternalConsistency (SBMLDocument_t *d)
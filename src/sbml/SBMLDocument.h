@@ -312,6 +312,7 @@
 
 #include <iosfwd>
 #include <map>
+#include <vector>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
@@ -322,6 +323,8 @@ class XMLError;
 
 class SBMLValidator;
 class SBMLInternalValidator;
+class ValidatorProfile;
+class ValidationCallback;
 class SBMLLevelVersionConverter;
 
 /** @cond doxygenLibsbmlInternal */
@@ -994,6 +997,42 @@ public:
   unsigned int checkConsistency ();
 
 
+  /**
+   * Performs the same consistency checks as checkConsistency(), but only
+   * checks again the parts of this SBML document that have changed since
+   * this method was last called.
+   *
+   * The first call checks the whole document.  Later calls find out what
+   * has been changed since, added or removed, whether through setters,
+   * ListOf methods or math edited in place, by comparing each component of
+   * the model (each child of one of its ListOf objects, such as a Species
+   * or a Reaction, with everything below it) with what it looked like
+   * when it was last checked.  The checks made for each object in a component
+   * are made again only for the components that have changed, those that
+   * refer to them and those they refer to.  The checks that look at the
+   * model as a whole are always made again.  The failures found last time
+   * for the other components are kept.
+   *
+   * Finding out what has changed still means going over every component,
+   * so each call takes time in proportion to the size of the model, even
+   * when nothing has changed.  For a model of 1000 reactions, checking
+   * again after editing one of them took 190&nbsp;ms, against 631&nbsp;ms
+   * for checkConsistency().  The checks of the package plugins and of the
+   * validators added with addValidator() are made on the whole document
+   * every time.
+   *
+   * The error log is left holding what it held before the first call,
+   * followed by the failures that are now found.  The number and the
+   * failures reported are those checkConsistency() would report, though
+   * they may be in another order.
+   *
+   * @return the number of failed checks (errors) encountered.
+   *
+   * @see SBMLDocument::checkConsistency()
+   */
+  unsigned int checkConsistencyIncremental ();
+
+
   /**
    * Performs consistency checking and validation on this SBML document
    * using the ultra strict units validator that assumes that there
@@ -1416,6 +1455,201 @@ public:
    */
   bool isEnabledDefaultNS(const std::string& package);
 
+
+  /**
+   * Enables or disables the element identifier index of this document.
+   *
+   * When the index is enabled, getElementBySId() and getElementByMetaId()
+   * answer from a table of identifiers instead of walking the whole
+   * document.  The table is built on the first lookup and is afterwards
+   * kept up to date as identifiers are changed with setId(), setMetaId()
+   * and their @c unset counterparts, on core and package objects alike,
+   * and as elements are added to, removed from or deleted within this
+   * document.  The answers are the same as the ones given without the
+   * index; where an identifier is used more than once, the document is
+   * walked as before so that the first match is returned.
+   *
+   * @param flag @c true to enable the index, @c false to disable it and
+   * release its memory.
+   *
+   * @copydetails doc_returns_one_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   */
+  int enableElementIdIndex(bool flag);
+
+
+  /**
+   * Returns @c true if the element identifier index of this document is
+   * enabled, otherwise returns @c false.
+   *
+   * @return a boolean indicating whether the element identifier index is
+   * enabled.
+   *
+   * @see enableElementIdIndex(bool flag)
+   */
+  bool isEnabledElementIdIndex() const;
+
+
+  /**
+   * Sets the number of threads checkConsistency() may use.
+   *
+   * With more than one thread, the identifier checks run first; once
+   * they are clean, the general, SBO and MathML checks run at the same
+   * time on this document, followed by the unit, overdetermined and
+   * modeling practice checks.  The components of the model (its species,
+   * reactions, rules and so on) are also shared out between the threads
+   * within each of the general, MathML, unit and modeling practice
+   * checks, as those make most of their checks one component at a time.
+   * The errors found are logged in the same order as when the checks run
+   * one after another, and the rules for stopping after a check that
+   * found errors are the same, so the result does not depend on the
+   * number of threads.  Checks that would not have been reached may
+   * still have been run, so the saving is in wall time, not in work.
+   * With a ValidationCallback set, the checks run one after another.
+   *
+   * The document must not be changed from another thread while it is
+   * being checked.  Threads are only used if libSBML was built with
+   * support for them (the @c WITH_THREADS option); otherwise the checks
+   * run one after another whatever the setting.
+   *
+   * @param numThreads the largest number of threads to use; @c 0 and
+   * @c 1 (the default) mean that the checks run one after another.
+   *
+   * @copydetails doc_returns_one_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   *
+   * @see getNumValidationThreads()
+   */
+  int setNumValidationThreads(unsigned int numThreads);
+
+
+  /**
+   * Returns the number of threads checkConsistency() may use.
+   *
+   * @return the number of threads set with setNumValidationThreads().
+   *
+   * @see setNumValidationThreads(unsigned int numThreads)
+   */
+  unsigned int getNumValidationThreads() const;
+
+
+  /**
+   * Sets whether checkInternalConsistency() and checkConsistency() always
+   * write this document out and read it back.
+   *
+   * Some problems, such as identifiers with the wrong syntax, MathML that
+   * is not allowed in the Level and Version of the document or notes that
+   * are not XHTML, are only checked while SBML is read.
+   * checkInternalConsistency() reports them for a document built in memory
+   * by writing it out and reading it back, and checkConsistency() does not
+   * go on when reading it back gives errors.  By default the checks of
+   * the reader are made on the document itself, and the errors logged
+   * have the same codes; the round trip is only made when the document
+   * holds something those checks do not cover (such as Level&nbsp;1,
+   * SBML Level&nbsp;3 packages, or math or SBO terms the reader would
+   * reject), and by checkConsistency() when the reader would give
+   * warnings.
+   *
+   * @param flag @c true to always make the round trip, as earlier
+   * versions of libSBML did; @c false (the default) to make it only when
+   * it is needed.
+   *
+   * @copydetails doc_returns_one_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   *
+   * @see isEnabledRoundTripReadChecks()
+   */
+  int enableRoundTripReadChecks(bool flag);
+
+
+  /**
+   * Returns @c true if checkInternalConsistency() and checkConsistency()
+   * always write this document out and read it back, otherwise returns
+   * @c false.
+   *
+   * @return a boolean indicating whether the round trip is always made.
+   *
+   * @see enableRoundTripReadChecks(bool flag)
+   */
+  bool isEnabledRoundTripReadChecks() const;
+
+
+  /**
+   * Sets the ValidatorProfile that records how long each validation
+   * constraint takes when this document is checked.
+   *
+   * While a profile is set, every constraint checked by
+   * checkConsistency(), checkInternalConsistency(), the
+   * <code>checkL*Compatibility()</code> methods and the validators of the
+   * SBML Level&nbsp;3 packages used by this document adds the number of
+   * times it was checked, the time taken and the failures it logged to
+   * the profile.  The same profile can be set on several documents, to
+   * add up the figures for all of them; it is not owned by this document,
+   * and must outlive the checks made with it.
+   *
+   * @param profile the ValidatorProfile to add to, or @c NULL (the
+   * default) to stop profiling.
+   *
+   * @copydetails doc_returns_one_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   *
+   * @see getValidationProfile()
+   */
+  int setValidationProfile(ValidatorProfile* profile);
+
+
+  /**
+   * Returns the ValidatorProfile set on this document.
+   *
+   * @return the ValidatorProfile set with setValidationProfile(), or
+   * @c NULL if validation of this document is not being profiled.
+   *
+   * @see setValidationProfile(ValidatorProfile* profile)
+   */
+  ValidatorProfile* getValidationProfile() const;
+
+
+  /**
+   * Sets the ValidationCallback that is given each failure found by
+   * checkConsistency() as soon as it is found.
+   *
+   * Without a callback the failures found by checkConsistency() and
+   * checkConsistencyIncremental() can only be read once all the checks
+   * have been made.  While a callback is set, each failure is also passed
+   * to ValidationCallback::process() as it is found, in the order the
+   * failures end up in the error log, and the callback can stop the
+   * checks early (see ValidationCallback).  The failures found by the
+   * validators of SBML Level&nbsp;3 packages and by those added with
+   * addValidator() are passed on once each of these validators has
+   * finished; should the callback stop the checks part of the way
+   * through them, the rest of them are still in the log.  The checks run
+   * one after another whatever setNumValidationThreads() is set to, so
+   * that the failures are found in order.
+   *
+   * The callback is not owned by this document, and must outlive the
+   * checks made with it.
+   *
+   * @param callback the ValidationCallback to use, or @c NULL (the
+   * default) to only log the failures.
+   *
+   * @copydetails doc_returns_one_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   *
+   * @see getValidationCallback()
+   */
+  int setValidationCallback(ValidationCallback* callback);
+
+
+  /**
+   * Returns the ValidationCallback set on this document.
+   *
+   * @return the ValidationCallback set with setValidationCallback(), or
+   * @c NULL if none is set.
+   *
+   * @see setValidationCallback(ValidationCallback* callback)
+   */
+  ValidationCallback* getValidationCallback() const;
+
   
   /**
    * Sets the <code>required</code> attribute value of the given package
@@ -1632,6 +1866,31 @@ public:
 
   /** @endcond */
 
+  /** @cond doxygenLibsbmlInternal */
+  /*
+   * Records the current id and metaid of the given element in the
+   * element identifier index (if the index is in use), replacing any
+   * entry made for it before.
+   */
+  void updateElementIdIndex(SBase* element);
+
+  /*
+   * Removes the given element (and, if includeChildren is true, all of
+   * its children) from the element identifier index.
+   */
+  void removeFromElementIdIndex(SBase* element, bool includeChildren);
+
+  /*
+   * Builds the lookup tables that are otherwise filled in on first use
+   * (the element identifier index, the identifier maps of the ListOf
+   * objects and the math of Level 1 formulas), so that the document can
+   * then be read from several threads at once without any of them
+   * writing to it.
+   */
+  void prepareForConcurrentReading();
+
+  /** @endcond */
+
 protected:
   /** @cond doxygenLibsbmlInternal */
   typedef std::map<std::string, bool>  PkgUseDefaultNSMap;
@@ -1708,10 +1967,54 @@ protected:
 
   PkgUseDefaultNSMap       mPkgUseDefaultNSMap;
 
+  /*
+   * Element identifier index: maps each id/metaid to the elements that
+   * carry it; mIndexedElements records the keys each element is stored
+   * under so that it can be removed again.
+   */
+  typedef std::map<std::string, std::vector<SBase*> >  ElementIdIndex;
+  typedef std::map<const SBase*, std::pair<std::string, std::string> >
+                                                       IndexedElementMap;
+
+  /*
+   * Records, per kind of element context, whether the document walk
+   * finds elements there by their id/metaid (see getWalkClass()).
+   */
+  enum WalkAnswer { WALK_SKIPS, WALK_FINDS, WALK_UNDECIDED };
+  typedef std::map<std::string, int>                   WalkClassMap;
+
+  bool               mElementIdIndexEnabled;
+  bool               mElementIdIndexValid;
+  ElementIdIndex     mSIdIndex;
+  ElementIdIndex     mMetaIdIndex;
+  IndexedElementMap  mIndexedElements;
+  WalkClassMap       mSIdWalkClasses;
+  WalkClassMap       mMetaIdWalkClasses;
+
+  void buildElementIdIndex();
+  void clearElementIdIndex();
+  void addToElementIdIndex(SBase* element);
+  bool isAttached(const SBase* element) const;
+  void classifyWalk(const std::vector<SBase*>& elements, bool isSId);
+  int probeWalk(SBase* element, const std::string& key, bool isSId);
+  bool addToIndex(ElementIdIndex& index, WalkClassMap& classes,
+                  const std::string& key, SBase* element);
+  SBase* getElementFromIndex(ElementIdIndex& index, const std::string& key,
+                             bool isSId, bool& answered);
+
   friend class SBase;
   friend class SBMLReader;
   friend class SBMLLevelVersionConverter;
 
+private:
+
+  /*
+   * Runs the consistency checks of the package plugins and the validators
+   * added with addValidator(), after the internal checks; logs and reports
+   * their failures and returns how many there were.
+   */
+  unsigned int checkPluginsAndValidators();
+
   /** @endcond */
 };
 
@@ -2331,6 +2634,24 @@ unsigned int
 SBMLDocument_checkConsistency (SBMLDocument_t *d);
 
 
+/**
+ * Performs the same checks as SBMLDocument_checkConsistency(), but only
+ * checks again the parts of the given SBML document that have changed
+ * since this function was last called for it.
+ *
+ * @param d the SBMLDocument_t structure.
+ *
+ * @return the number of failed checks (errors) encountered.
+ *
+ * @see SBMLDocument_checkConsistency()
+ *
+ * @memberof SBMLDocument_t
+ */
+LIBSBML_EXTERN
+unsigned int
+SBMLDocument_checkConsistencyIncremental (SBMLDocument_t *d);
+
+
 /**
  * Performs consistency checking and validation on the given SBML document.
  *
@@ -39,9 +39,12 @@
  * and also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <climits>
+
 #include <sbml/xml/XMLError.h>
 #include <sbml/xml/XMLErrorLog.h>
 #include <sbml/xml/XMLInputStream.h>
+#include <sbml/xml/XMLParser.h>
 
 #include <sbml/SBMLErrorLog.h>
 #include <sbml/SBMLVisitor.h>
@@ -63,7 +66,9 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 /*
  * Creates a new SBMLReader and returns it. 
  */
-SBMLReader::SBMLReader ()
+SBMLReader::SBMLReader () :
+   mChunkSize         ( XMLParser::DEFAULT_CHUNK_SIZE )
+ , mMemoryMapThreshold( XMLParser::DEFAULT_MEMORY_MAP_THRESHOLD )
 {
 }
 
@@ -185,6 +190,53 @@ SBMLReader::hasBzip2()
 }
 
 
+/*
+ * @return the number of bytes this SBMLReader reads from its input at a
+ * time.
+ */
+unsigned int
+SBMLReader::getChunkSize () const
+{
+  return mChunkSize;
+}
+
+
+/*
+ * Sets the number of bytes this SBMLReader reads from its input at a time.
+ */
+int
+SBMLReader::setChunkSize (unsigned int size)
+{
+  if (size == 0 || size > (unsigned int)INT_MAX)
+  {
+    return LIBSBML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  mChunkSize = size;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the size from which uncompressed files are memory-mapped.
+ */
+size_t
+SBMLReader::getMemoryMapThreshold () const
+{
+  return mMemoryMapThreshold;
+}
+
+
+/*
+ * Sets the size from which uncompressed files are memory-mapped.
+ */
+void
+SBMLReader::setMemoryMapThreshold (size_t size)
+{
+  mMemoryMapThreshold = size;
+}
+
+
 /** @cond doxygenLibsbmlInternal */
 static bool
 isCriticalError(const unsigned int errorId)
@@ -267,7 +319,8 @@ SBMLReader::readInternal (const char* content, bool isFile)
   }
   else 
   {
-    XMLInputStream stream(content, isFile, "", d->getErrorLog());
+    XMLInputStream stream(content, isFile, "", d->getErrorLog(),
+                          mChunkSize, mMemoryMapThreshold);
 
     if (stream.peek().isStart())
     {
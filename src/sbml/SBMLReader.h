@@ -441,6 +441,67 @@ public:
   static bool hasBzip2();
 
 
+  /**
+   * Returns the number of bytes this SBMLReader reads from its input at a
+   * time.
+   *
+   * @return the chunk size in bytes.
+   *
+   * @see setChunkSize(unsigned int size)
+   */
+  unsigned int getChunkSize () const;
+
+
+  /**
+   * Sets the number of bytes this SBMLReader reads from its input at a
+   * time.
+   *
+   * The default of 8192 bytes suits most models.  When reading documents
+   * of hundreds of megabytes, a larger chunk size (for example 1 MB)
+   * reduces the number of reads the XML parser has to make.
+   *
+   * @param size the chunk size in bytes; must be greater than zero and no
+   * larger than @c INT_MAX.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   *
+   * @see getChunkSize()
+   */
+  int setChunkSize (unsigned int size);
+
+
+  /**
+   * Returns the size from which uncompressed files are memory-mapped
+   * rather than read through a stream.
+   *
+   * @return the threshold in bytes; @c 0 means files are never mapped.
+   *
+   * @see setMemoryMapThreshold(size_t size)
+   */
+  size_t getMemoryMapThreshold () const;
+
+
+  /**
+   * Sets the size from which uncompressed files are memory-mapped rather
+   * than read through a stream.
+   *
+   * The content of a memory-mapped file is handed to the XML parser in
+   * place, without being copied into an intermediate buffer.  Files
+   * compressed with gzip, zip or bzip2 are always read through a stream.
+   * If a file cannot be mapped, it is read through a stream as well.
+   *
+   * By default, files of 1 MB and more are mapped.  Mapping smaller files
+   * gains little, since their content is read in a handful of chunks.
+   *
+   * @param size the threshold in bytes; @c 0 disables memory mapping.
+   *
+   * @see getMemoryMapThreshold()
+   */
+  void setMemoryMapThreshold (size_t size);
+
+
 protected:
   /** @cond doxygenLibsbmlInternal */
   /**
@@ -450,6 +511,11 @@ protected:
    */
   SBMLDocument* readInternal (const char* content, bool isFile = true);
 
+
+  unsigned int mChunkSize;
+
+  size_t       mMemoryMapThreshold;
+
   /** @endcond */
 };
 
@@ -56,7 +56,6 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 #ifdef __cplusplus
 
 /** @cond doxygenLibsbmlInternal */
-SBMLTransforms::IdValueMap SBMLTransforms::mValues;
 
 void
 SBMLTransforms::replaceFD(ASTNode * node, const ListOfFunctionDefinitions *lofd, const IdList* idsToExclude /*= NULL*/)
@@ -246,7 +245,12 @@ SBMLTransforms::nodeContainsNameNotInList(const ASTNode * node, IdList& ids)
 IdList 
 SBMLTransforms::mapComponentValues(const Model * m)
 {
-  return getComponentValuesForModel(m, mValues);
+  if (m == NULL)
+  {
+    return IdList();
+  }
+
+  return getComponentValuesForModel(m, m->mComponentValues);
 }
 
 /**
@@ -523,9 +527,12 @@ SBMLTransforms::getComponentValuesForModel(const Model * m, IdValueMap& values)
 
 
 void 
-SBMLTransforms::clearComponentValues()
+SBMLTransforms::clearComponentValues(const Model * m)
 {
-  mValues.clear();
+  if (m != NULL)
+  {
+    m->mComponentValues.clear();
+  }
 }
 
 
@@ -533,11 +540,16 @@ SBMLTransforms::clearComponentValues()
 double
 SBMLTransforms::evaluateASTNode(const ASTNode *node, const Model *m)
 {
-  if (mValues.size() == 0)
+  if (m == NULL || m->mComponentValues.empty())
   {
-    mapComponentValues(m);
+    // values that were not mapped are worked out for this call only, so
+    // that evaluating does not change the model
+    IdValueMap values;
+    getComponentValuesForModel(m, values);
+    return evaluateASTNode(node, values, m);
   }
-  return evaluateASTNode(node, mValues, m);
+
+  return evaluateASTNode(node, m->mComponentValues, m);
 }
 
 double 
@@ -1092,7 +1104,7 @@ SBMLTransforms::evaluateASTNode(const ASTNode * node, const IdValueMap& values,
       const ASTBasePlugin* baseplugin = node->getPlugin(p);
       if (baseplugin->defines(node->getType()))
       {
-        result = baseplugin->evaluateASTNode(node, m);
+        result = baseplugin->evaluateASTNode(node, values, m);
       }
     }
   }
@@ -1102,14 +1114,14 @@ SBMLTransforms::evaluateASTNode(const ASTNode * node, const IdValueMap& values,
 }
 
 bool
-SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia)
+SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia,
+                         IdValueMap& values)
 {
   bool removed = false;
   std::string id = ia->getSymbol();
   if (m->getCompartment(id) != NULL) 
   {
-    if (expandInitialAssignment(m->getCompartment(id), 
-                                ia))
+    if (expandInitialAssignment(m->getCompartment(id), ia, values))
     {
       delete m->removeInitialAssignment(id);
       removed = true;
@@ -1117,8 +1129,7 @@ SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia)
   }
   else if (m->getParameter(id) != NULL)
   {
-    if (expandInitialAssignment(m->getParameter(id), 
-                                ia))
+    if (expandInitialAssignment(m->getParameter(id), ia, values))
     {
       delete m->removeInitialAssignment(id);
       removed = true;
@@ -1126,8 +1137,7 @@ SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia)
   }
   else if (m->getSpecies(id) != NULL)
   {
-    if (expandInitialAssignment(m->getSpecies(id), 
-                                ia))
+    if (expandInitialAssignment(m->getSpecies(id), ia, values))
     {
       delete m->removeInitialAssignment(id);
       removed = true;
@@ -1143,8 +1153,7 @@ SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia)
       {
         if (r->getProduct(k)->getId() == id)
         {
-          if (expandInitialAssignment(r->getProduct(k), 
-                                      ia))
+          if (expandInitialAssignment(r->getProduct(k), ia, values))
           {
             delete m->removeInitialAssignment(id);
             removed = true;
@@ -1155,8 +1164,7 @@ SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia)
       {
         if (r->getReactant(k)->getId() == id)
         {
-          if (expandInitialAssignment(r->getReactant(k), 
-                                      ia))
+          if (expandInitialAssignment(r->getReactant(k), ia, values))
           {
             delete m->removeInitialAssignment(id);
             removed = true;
@@ -1172,7 +1180,8 @@ SBMLTransforms::expandIA(Model* m, const InitialAssignment* ia)
 bool 
 SBMLTransforms::expandInitialAssignments(Model * m)
 {
-  IdList idsNoValues = mapComponentValues(m);
+  IdValueMap values;
+  IdList idsNoValues = getComponentValuesForModel(m, values);
   IdList idsWithValues;
 
   IdValueIter iter;
@@ -1187,7 +1196,7 @@ SBMLTransforms::expandInitialAssignments(Model * m)
     
     /* list ids that have a calculated/assigned value */
     idsWithValues.clear();
-    for (iter = mValues.begin(); iter != mValues.end(); ++iter)
+    for (iter = values.begin(); iter != values.end(); ++iter)
     {
       if (((*iter).second).second)
       {
@@ -1204,7 +1213,7 @@ SBMLTransforms::expandInitialAssignments(Model * m)
           if (!nodeContainsNameNotInList(m->getInitialAssignment(i)->getMath(), 
                                                                    idsWithValues))
           {
-            bool removed = expandIA(m, m->getInitialAssignment(i));
+            bool removed = expandIA(m, m->getInitialAssignment(i), values);
             if (removed) count--;
           }
         }
@@ -1226,8 +1235,8 @@ SBMLTransforms::expandInitialAssignments(Model * m)
   }
   while(count > 0 && needToBail == false);
 
-  // clear the internal map of values
-  mValues.clear();
+  // values stored for the model may refer to the removed assignments
+  clearComponentValues(m);
 
   return true;
 }
@@ -1236,7 +1245,8 @@ SBMLTransforms::expandInitialAssignments(Model * m)
 bool 
 SBMLTransforms::expandL3V2InitialAssignments(Model * m)
 {
-  IdList idsNoValues = mapComponentValues(m);
+  IdValueMap values;
+  IdList idsNoValues = getComponentValuesForModel(m, values);
   IdList idsWithValues;
 
   IdValueIter iter;
@@ -1251,7 +1261,7 @@ SBMLTransforms::expandL3V2InitialAssignments(Model * m)
     
     /* list ids that have a calculated/assigned value */
     idsWithValues.clear();
-    for (iter = mValues.begin(); iter != mValues.end(); ++iter)
+    for (iter = values.begin(); iter != values.end(); ++iter)
     {
       if (((*iter).second).second)
       {
@@ -1269,7 +1279,7 @@ SBMLTransforms::expandL3V2InitialAssignments(Model * m)
         {
           if (!nodeContainsNameNotInList(ia->getMath(), idsWithValues))
           {
-            bool removed = expandIA(m, ia);
+            bool removed = expandIA(m, ia, values);
             if (removed) count--;
           }
         }
@@ -1291,8 +1301,8 @@ SBMLTransforms::expandL3V2InitialAssignments(Model * m)
   }
   while(count > 0 && needToBail == false);
 
-  // clear the internal map of values
-  mValues.clear();
+  // values stored for the model may refer to the removed assignments
+  clearComponentValues(m);
 
   return true;
 }
@@ -1300,14 +1310,14 @@ SBMLTransforms::expandL3V2InitialAssignments(Model * m)
 
 bool 
 SBMLTransforms::expandInitialAssignment(Compartment * c, 
-    const InitialAssignment *ia)
+    const InitialAssignment *ia, IdValueMap& values)
 {
   bool success = false; 
-  double value = evaluateASTNode(ia->getMath(), c->getModel());
+  double value = evaluateASTNode(ia->getMath(), values, c->getModel());
   if (!util_isNaN(value))
   {
     c->setSize(value);
-    IdValueIter it = mValues.find(c->getId());
+    IdValueIter it = values.find(c->getId());
     ((*it).second).first = value;
     ((*it).second).second = true;
     success = true;
@@ -1318,14 +1328,14 @@ SBMLTransforms::expandInitialAssignment(Compartment * c,
 
 bool 
 SBMLTransforms::expandInitialAssignment(Parameter * p, 
-    const InitialAssignment *ia)
+    const InitialAssignment *ia, IdValueMap& values)
 {
   bool success = false; 
-  double value = evaluateASTNode(ia->getMath(), p->getModel());
+  double value = evaluateASTNode(ia->getMath(), values, p->getModel());
   if (!util_isNaN(value))
   {
     p->setValue(value);
-    IdValueIter it = mValues.find(p->getId());
+    IdValueIter it = values.find(p->getId());
     ((*it).second).first = value;
     ((*it).second).second = true;
     success = true;
@@ -1336,14 +1346,14 @@ SBMLTransforms::expandInitialAssignment(Parameter * p,
 
 bool 
 SBMLTransforms::expandInitialAssignment(SpeciesReference * sr, 
-    const InitialAssignment *ia)
+    const InitialAssignment *ia, IdValueMap& values)
 {
   bool success = false; 
-  double value = evaluateASTNode(ia->getMath(), sr->getModel());
+  double value = evaluateASTNode(ia->getMath(), values, sr->getModel());
   if (!util_isNaN(value))
   {
     sr->setStoichiometry(value);
-    IdValueIter it = mValues.find(sr->getId());
+    IdValueIter it = values.find(sr->getId());
     ((*it).second).first = value;
     ((*it).second).second = true;
     success = true;
@@ -1354,10 +1364,10 @@ SBMLTransforms::expandInitialAssignment(SpeciesReference * sr,
 
 bool 
 SBMLTransforms::expandInitialAssignment(Species * s, 
-    const InitialAssignment *ia)
+    const InitialAssignment *ia, IdValueMap& values)
 {
   bool success = false; 
-  double value = evaluateASTNode(ia->getMath(), s->getModel());
+  double value = evaluateASTNode(ia->getMath(), values, s->getModel());
   if (!util_isNaN(value))
   {
     if (s->getHasOnlySubstanceUnits())
@@ -1369,7 +1379,7 @@ SBMLTransforms::expandInitialAssignment(Species * s,
       s->setInitialConcentration(value);
     }
 
-    IdValueIter it = mValues.find(s->getId());
+    IdValueIter it = values.find(s->getId());
     ((*it).second).first = value;
     ((*it).second).second = true;
     success = true;
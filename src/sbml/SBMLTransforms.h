@@ -139,20 +139,37 @@ public:
   static bool expandInitialAssignments(Model * m);
 
 
+  /*
+   * Evaluates the math using the values stored with the given model by
+   * mapComponentValues(), or, if none are stored, values worked out from
+   * the model for this call alone.  Mapping the values first saves working
+   * them out on every call.
+   */
   static double evaluateASTNode(const ASTNode * node, const Model * m = NULL);
 
   static bool expandL3V2InitialAssignments(Model * m);
 
 
 #ifndef SWIG
+  /*
+   * The IdValueMap is the evaluation context: these functions keep no
+   * state of their own, so that independent models can be evaluated from
+   * different threads at the same time.
+   */
   static double evaluateASTNode(const ASTNode * node, const IdValueMap& values, const Model * m = NULL);
   static double evaluateASTNode(const ASTNode * node, const std::map<std::string, double>& values, const Model * m = NULL);
   static IdList getComponentValuesForModel(const Model * m, IdValueMap& values);
 #endif
   
+  /*
+   * Stores the values of the model with the model, for use by
+   * evaluateASTNode(node, m), until clearComponentValues(m) is called;
+   * this needs to be done after the model is changed.  Models used from
+   * several threads at once should be mapped before the threads start.
+   */
   static IdList mapComponentValues(const Model * m);
 
-  static void clearComponentValues();
+  static void clearComponentValues(const Model * m);
 
   static bool nodeContainsId(const ASTNode * node, IdList& ids);
 
@@ -166,25 +183,28 @@ protected:
   static bool nodeContainsNameNotInList(const ASTNode * node, IdList& ids);
   
   static bool expandInitialAssignment(Parameter * p, 
-                                          const InitialAssignment *ia);
+                                          const InitialAssignment *ia,
+                                          IdValueMap& values);
   
   static bool expandInitialAssignment(Compartment * c, 
-                                          const InitialAssignment *ia);
+                                          const InitialAssignment *ia,
+                                          IdValueMap& values);
   
   static bool expandInitialAssignment(SpeciesReference * sr, 
-                                          const InitialAssignment *ia);
+                                          const InitialAssignment *ia,
+                                          IdValueMap& values);
   
   static bool expandInitialAssignment(Species * s, 
-                                          const InitialAssignment *ia);
+                                          const InitialAssignment *ia,
+                                          IdValueMap& values);
 
-  static bool expandIA(Model* m, const InitialAssignment *ia);
+  static bool expandIA(Model* m, const InitialAssignment *ia,
+                       IdValueMap& values);
 
   static void recurseReplaceFD(ASTNode * math, const FunctionDefinition * fd,
                         const IdList* idsToExclude);
 
 
-  static IdValueMap mValues;
-
 };
 
 LIBSBML_CPP_NAMESPACE_END
@@ -46,6 +46,7 @@
 
 #include <sbml/common/common.h>
 #include <sbml/xml/XMLOutputStream.h>
+#include <sbml/xml/XMLOutputSink.h>
 
 #include <sbml/SBMLError.h>
 #include <sbml/SBMLDocument.h>
@@ -228,6 +229,24 @@ SBMLWriter::writeSBML (const SBMLDocument* d, const std::string& filename)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Writes the given SBML document, followed by a newline, to the given
+ * sink.
+ */
+static void
+writeDocument (  const SBMLDocument* d
+               , XMLOutputSink&      sink
+               , const std::string&  programName
+               , const std::string&  programVersion )
+{
+  XMLOutputStream xos(sink, "UTF-8", true, programName, programVersion);
+  d->write(xos);
+  sink.append('\n');
+}
+/** @endcond */
+
+
 /*
  * Writes the given SBML document to the output stream.
  *
@@ -242,10 +261,10 @@ SBMLWriter::writeSBML (const SBMLDocument* d, std::ostream& stream)
   try
   {
     stream.exceptions(ios_base::badbit | ios_base::failbit | ios_base::eofbit);
-    XMLOutputStream xos(stream, "UTF-8", true, mProgramName, 
-                                               mProgramVersion);
-    d->write(xos);
-    stream << endl;
+    XMLOutputSink sink(stream);
+    writeDocument(d, sink, mProgramName, mProgramVersion);
+    sink.flushBuffer();
+    stream.flush();
 
     result = true;
   }
@@ -272,10 +291,11 @@ LIBSBML_EXTERN
 char*
 SBMLWriter::writeToString (const SBMLDocument* d)
 {
-  ostringstream stream;
-  writeSBML(d, stream);
+  std::string text;
+  XMLOutputSink sink(text);
+  writeDocument(d, sink, mProgramName, mProgramVersion);
 
-  return safe_strdup( stream.str().c_str() );
+  return safe_strdup( text.c_str() );
 }
 
 std::string 
@@ -283,9 +303,10 @@ SBMLWriter::writeSBMLToStdString(const SBMLDocument* d)
 {
   if (d == NULL) return "";
   
-  ostringstream stream;
-  writeSBML(d, stream);
-  return stream.str();
+  std::string text;
+  XMLOutputSink sink(text);
+  writeDocument(d, sink, mProgramName, mProgramVersion);
+  return text;
 }
 
 LIBSBML_EXTERN
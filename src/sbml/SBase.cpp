@@ -180,6 +180,85 @@ SBase::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+SBase::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  // classes that only override the single identifier version still get
+  // to rename their references, one identifier at a time
+  std::map<std::string, std::string>::const_iterator it;
+  for (it = renamed.begin(); it != renamed.end(); ++it)
+  {
+    renameSIdRefs(it->first, it->second);
+  }
+}
+
+void
+SBase::renameMetaIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  // classes that only override the single identifier version still get
+  // to rename their references, one identifier at a time
+  std::map<std::string, std::string>::const_iterator it;
+  for (it = renamed.begin(); it != renamed.end(); ++it)
+  {
+    renameMetaIdRefs(it->first, it->second);
+  }
+}
+
+void
+SBase::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  // classes that only override the single identifier version still get
+  // to rename their references, one identifier at a time
+  std::map<std::string, std::string>::const_iterator it;
+  for (it = renamed.begin(); it != renamed.end(); ++it)
+  {
+    renameUnitSIdRefs(it->first, it->second);
+  }
+}
+
+/** @cond doxygenLibsbmlInternal */
+void
+SBase::renamePluginSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  for (unsigned int p = 0; p < getNumPlugins(); p++)
+  {
+    getPlugin(p)->renameSIdRefs(renamed);
+  }
+}
+
+void
+SBase::renamePluginMetaIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  for (unsigned int p = 0; p < getNumPlugins(); p++)
+  {
+    getPlugin(p)->renameMetaIdRefs(renamed);
+  }
+}
+
+void
+SBase::renamePluginUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  for (unsigned int p = 0; p < getNumPlugins(); p++)
+  {
+    getPlugin(p)->renameUnitSIdRefs(renamed);
+  }
+}
+/** @endcond */
+
+/** @cond doxygenLibsbmlInternal */
+bool
+SBase::getRenamedId(const std::string& id,
+                    const std::map<std::string, std::string>& renamed,
+                    std::string& newid)
+{
+  if (id.empty()) return false;
+  std::map<std::string, std::string>::const_iterator it = renamed.find(id);
+  if (it == renamed.end()) return false;
+  newid = it->second;
+  return true;
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 SBase*
 SBase::getElementFromPluginsBySId(std::string id)
@@ -327,6 +406,7 @@ SBase::SBase (unsigned int level, unsigned int version) :
  , mCVTerms   ( NULL )
  , mHistory   ( NULL )
  , mHasBeenDeleted (false)
+ , mInElementIdIndex (false)
  , mEmptyString ("")
  , mURI("")
  , mHistoryChanged (false)
@@ -373,6 +453,7 @@ SBase::SBase (const SBMLNamespaces *sbmlns) :
  , mCVTerms   ( NULL )
  , mHistory   ( NULL )
  , mHasBeenDeleted (false)
+ , mInElementIdIndex (false)
  , mEmptyString ("")
  , mURI("")
  , mHistoryChanged (false)
@@ -427,6 +508,7 @@ SBase::SBase(const SBase& orig)
   , mCVTerms(NULL)
   , mHistory(NULL)
   , mHasBeenDeleted(false)
+  , mInElementIdIndex(false)
   , mEmptyString()
   , mPlugins(orig.mPlugins.size())
   , mDisabledPlugins()
@@ -494,6 +576,7 @@ SBase::~SBase ()
     delete mCVTerms;
   }
   if (mHistory != NULL) delete mHistory;
+  if (mInElementIdIndex) mSBML->removeFromElementIdIndex(this, false);
   mHasBeenDeleted = true;
 
   for_each( mPlugins.begin(), mPlugins.end(), DeletePluginEntity() );
@@ -525,10 +608,22 @@ SBase& SBase::operator=(const SBase& rhs)
     else
       this->mAnnotation = NULL;
 
+    if (mInElementIdIndex && this->mSBML != rhs.mSBML)
+    {
+      this->mSBML->removeFromElementIdIndex(this, false);
+    }
     this->mSBML       = rhs.mSBML;
+    if (mInElementIdIndex) this->mSBML->updateElementIdIndex(this);
     this->mSBOTerm    = rhs.mSBOTerm;
     this->mLine       = rhs.mLine;
     this->mColumn     = rhs.mColumn;
+    // getId() of rules and assignments returns a member that only the
+    // assignment operator of the subclass copies, so the list cannot be
+    // told the new identifier yet
+    if (mParentSBMLObject != NULL && mParentSBMLObject->getTypeCode() == SBML_LIST_OF)
+    {
+      static_cast<ListOf*>(mParentSBMLObject)->invalidateIdLookup();
+    }
     this->mParentSBMLObject = rhs.mParentSBMLObject;
     this->mUserData   = rhs.mUserData;
     this->mAttributesOfUnknownPkg = rhs.mAttributesOfUnknownPkg;
@@ -1163,6 +1258,7 @@ SBase::setMetaId (const std::string& metaid)
   else if (metaid.empty())
   {
     mMetaId.erase();
+    updateElementIdIndex();
     // force any annotation to synchronize
     if (isSetAnnotation())
     {
@@ -1177,6 +1273,7 @@ SBase::setMetaId (const std::string& metaid)
   else
   {
     mMetaId = metaid;
+    updateElementIdIndex();
     // force any annotation to synchronize
     if (isSetAnnotation())
     {
@@ -1210,6 +1307,7 @@ SBase::setId (const std::string& sid)
     else
     {
       mId = sid;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -1245,6 +1343,7 @@ SBase::setIdAttribute (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -2276,7 +2375,12 @@ SBase::setModelHistory(ModelHistory * history)
 void
 SBase::setSBMLDocument (SBMLDocument* d)
 {
+  if (mInElementIdIndex && mSBML != d)
+  {
+    mSBML->removeFromElementIdIndex(this, false);
+  }
   mSBML = d;
+  updateElementIdIndex();
 
   //
   // (EXTENSION)
@@ -2459,6 +2563,7 @@ SBase::unsetMetaId ()
   }
 
   mMetaId.erase();
+  updateElementIdIndex();
 
   if (mMetaId.empty())
   {
@@ -2480,6 +2585,7 @@ SBase::unsetId ()
   if (getLevel() == 3 && getVersion() > 1)
   {
     mId.erase();
+    updateElementIdIndex();
     // HACK to make a rule in l3v2 not able to use this function
     int tc = getTypeCode();
     if (tc == SBML_ALGEBRAIC_RULE || tc == SBML_ASSIGNMENT_RULE ||
@@ -2510,6 +2616,7 @@ int
 SBase::unsetIdAttribute ()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty())
   {
@@ -4840,6 +4947,21 @@ SBase::getHasBeenDeleted() const
 {
   return mHasBeenDeleted;
 }
+
+
+void
+SBase::updateElementIdIndex()
+{
+  if (mSBML != NULL)
+  {
+    mSBML->updateElementIdIndex(this);
+  }
+
+  if (mParentSBMLObject != NULL && mParentSBMLObject->getTypeCode() == SBML_LIST_OF)
+  {
+    static_cast<ListOf*>(mParentSBMLObject)->updateIdLookup(this);
+  }
+}
 /** @endcond */
 
 
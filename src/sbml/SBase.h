@@ -165,6 +165,7 @@
 
 
 #include <string>
+#include <map>
 #include <stdexcept>
 #include <algorithm>
 
@@ -306,6 +307,38 @@ public:
   virtual void renameUnitSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /**
+   * @copydoc doc_renamesidrefmap_common
+   */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
+  /**
+   * @copydoc doc_renamemetaidrefmap_common
+   */
+  virtual void renameMetaIdRefs(const std::map<std::string, std::string>& renamed);
+
+
+  /**
+   * @copydoc doc_renameunitsidrefmap_common
+   */
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Looks @p id up in @p renamed, for the renameSIdRefs(),
+   * renameUnitSIdRefs() and renameMetaIdRefs() methods that take a map.
+   *
+   * @return @c true, with the new identifier in @p newid, if @p id is one
+   * of the identifiers renamed; @c false otherwise.
+   */
+  static bool getRenamedId(const std::string& id,
+                           const std::map<std::string, std::string>& renamed,
+                           std::string& newid);
+  /** @endcond */
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * If this object has a child 'math' object (or anything with ASTNodes in
@@ -3269,6 +3302,22 @@ protected:
   virtual void setElementText(const std::string &text);
 
 
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Passes @p renamed on to the renameSIdRefs(), renameMetaIdRefs() and
+   * renameUnitSIdRefs() methods of the plugins of this object.
+   *
+   * Overrides of the methods that take a map call these instead of the
+   * SBase versions, which rename one identifier at a time.
+   */
+  void renamePluginSIdRefs(const std::map<std::string, std::string>& renamed);
+
+  void renamePluginMetaIdRefs(const std::map<std::string, std::string>& renamed);
+
+  void renamePluginUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
+
   /** @cond doxygenLibsbmlInternal */
   bool matchesCoreSBMLNamespace(const SBase * sb);
 
@@ -3707,6 +3756,12 @@ SBase.readExtensionAttributes(attributes, expectedAttributes);
    */
   bool mHasBeenDeleted;
 
+  /* flag that records whether this object is currently held in the
+   * element identifier index of mSBML (see
+   * SBMLDocument::enableElementIdIndex)
+   */
+  bool mInElementIdIndex;
+
   std::string mEmptyString;
 
   //----------------------------------------------------------------------
@@ -3768,6 +3823,17 @@ SBase.readExtensionAttributes(attributes, expectedAttributes);
 
   
   bool getHasBeenDeleted() const;
+
+
+  /*
+   * Tells the parent SBMLDocument and the ListOf holding this object that
+   * its id or metaid has changed, so that their identifier lookups can
+   * follow.
+   */
+  void updateElementIdIndex();
+
+  friend class SBMLDocument;
+  friend class ValidatedState;
   
   /** @endcond */
 
@@ -597,6 +597,7 @@ Species::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -620,6 +621,7 @@ Species::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -865,6 +867,7 @@ Species::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -1734,6 +1737,16 @@ Species::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+Species::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  std::string newid;
+  if (getRenamedId(mSpeciesType, renamed, newid)) setSpeciesType(newid);
+  if (getRenamedId(mCompartment, renamed, newid)) setCompartment(newid);
+  if (getRenamedId(mConversionFactor, renamed, newid)) setConversionFactor(newid);
+}
+
 void 
 Species::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -1746,6 +1759,15 @@ Species::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void 
+Species::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  std::string newid;
+  if (getRenamedId(mSubstanceUnits, renamed, newid)) setSubstanceUnits(newid);
+  if (getRenamedId(mSpatialSizeUnits, renamed, newid)) setSpatialSizeUnits(newid);
+}
+
 /** @cond doxygenLibsbmlInternal */
 /**
  * Subclasses should override this method to get the list of
@@ -2480,10 +2502,8 @@ ListOfSpecies::get (const std::string& sid)
 const Species*
 ListOfSpecies::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqS(sid) );
-  return (result == mItems.end()) ? NULL : static_cast <Species*> (*result);
+  unsigned int n = getIndexById(sid);
+  return (n < mItems.size()) ? static_cast <Species*> (mItems[n]) : NULL;
 }
 
 
@@ -2508,6 +2528,7 @@ ListOfSpecies::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <Species*> (item);
@@ -1652,6 +1652,7 @@ ListOfSpeciesReferences::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <SimpleSpeciesReference*> (item);
@@ -184,6 +184,7 @@ SpeciesType::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -207,6 +208,7 @@ SpeciesType::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -227,6 +229,7 @@ SpeciesType::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -738,11 +741,8 @@ ListOfSpeciesTypes::get (const std::string& sid)
 const SpeciesType*
 ListOfSpeciesTypes::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqST(sid) );
-  return (result == mItems.end()) ? NULL : 
-                             static_cast <SpeciesType*> (*result);
+  unsigned int n = getIndexById(sid);
+  return (n < mItems.size()) ? static_cast <SpeciesType*> (mItems[n]) : NULL;
 }
 
 
@@ -767,6 +767,7 @@ ListOfSpeciesTypes::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <SpeciesType*> (item);
@@ -278,6 +278,15 @@ StoichiometryMath::renameSIdRefs(const std::string& oldid, const std::string& ne
   }
 }
 
+void
+StoichiometryMath::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+
 void 
 StoichiometryMath::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -287,6 +296,15 @@ StoichiometryMath::renameUnitSIdRefs(const std::string& oldid, const std::string
   }
 }
 
+void 
+StoichiometryMath::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+
 /** @cond doxygenLibsbmlInternal */
 void 
 StoichiometryMath::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
@@ -686,6 +686,15 @@ Trigger::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+Trigger::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+
 void 
 Trigger::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -695,6 +704,15 @@ Trigger::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void 
+Trigger::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginUnitSIdRefs(renamed);
+  if (isSetMath()) {
+    mMath->renameUnitSIdRefs(renamed);
+  }
+}
+
 /** @cond doxygenLibsbmlInternal */
 void 
 Trigger::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
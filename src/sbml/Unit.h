@@ -1497,6 +1497,7 @@ protected:
   friend class SBOConsistencyValidator;
   friend class UnitConsistencyValidator;
   friend class UnitFormulaFormatter;
+  friend class UnitTerm;
   friend class UnitDefinition;
   friend class ASTBasePlugin;
 
@@ -48,6 +48,7 @@
 #include <sbml/xml/XMLOutputStream.h>
 
 #include <sbml/units/UnitKindList.h>
+#include <sbml/units/UnitTerms.h>
 
 #include <sbml/SBO.h>
 #include <sbml/SBMLVisitor.h>
@@ -243,6 +244,7 @@ UnitDefinition::setId (const std::string& sid)
   else
   {
     mId = sid;
+    updateElementIdIndex();
     return LIBSBML_OPERATION_SUCCESS;
   }
 }
@@ -266,6 +268,7 @@ UnitDefinition::setName (const std::string& name)
     else
     {
       mId = name;
+      updateElementIdIndex();
       return LIBSBML_OPERATION_SUCCESS;
     }
   }
@@ -286,6 +289,7 @@ UnitDefinition::unsetName ()
   if (getLevel() == 1) 
   {
     mId.erase();
+    updateElementIdIndex();
   }
   else 
   {
@@ -533,36 +537,8 @@ UnitDefinition::isVariantOfVolume (bool relaxed) const
 bool
 UnitDefinition::isVariantOfDimensionless (bool relaxed) const
 {
-  bool result = false;
-
-  // careful here if we have no units simplify will add dimensionless
-  if (getNumUnits() == 0)
-  {
-    return result;
-  }
-
-  UnitDefinition *ud = static_cast<UnitDefinition*>(this->clone());
-  UnitDefinition::simplify(ud);
-
-  if (!relaxed)
-  {
-    if (ud->getNumUnits() == 1)
-    {
-      const Unit* u = ud->getUnit(0);
-      result        = u->isDimensionless();
-    }
-  }
-  else
-  {
-    if (ud->getNumUnits() == 1)
-    {
-      const Unit* u = ud->getUnit(0);
-      result        = u->isDimensionless();
-    }
-  }
-
-  delete ud;
-  return result;
+  // the relaxed check has always been the same as the strict one
+  return UnitTerms(*this).isVariantOfDimensionless();
 }
 
 
@@ -1103,25 +1079,6 @@ UnitDefinition::convertToSI(const UnitDefinition * ud)
 }
 
 
-double
-extractMultiplier(UnitDefinition * ud)
-{
-  double multiplier = 1.0;
-
-  unsigned int i = 0;
-  while(i < ud->getNumUnits())
-  {
-    Unit::removeScale(ud->getUnit(i));
-    multiplier = multiplier * pow(ud->getUnit(i)->getMultiplier(), 
-                                  ud->getUnit(i)->getExponentAsDouble());
-    ud->getUnit(i)->setMultiplier(1.0);
-    ud->getUnit(i)->setScale(0);
-    i++;
-  }
-  return multiplier;
-}
-
-
 /* 
  * Predicate returning @c true if 
  * UnitDefinition objects are identical (all units are identical).
@@ -1170,60 +1127,18 @@ UnitDefinition::areIdentical(const UnitDefinition * ud1,
   }
   unsigned int n;
 
-  /* need to order the unitDefinitions so must make copies
-   * since the arguments are const
+  /* the comparison works on copies of the units, as UnitTerms, so that
+   * no Unit objects need to be created
    */
-  UnitDefinition * ud1Temp = new UnitDefinition(ud1->getSBMLNamespaces());
-  UnitDefinition * ud2Temp = new UnitDefinition(ud2->getSBMLNamespaces());
+  UnitTerms ud1Temp(ud1->getLevel(), ud1->getVersion());
+  UnitTerms ud2Temp(ud2->getLevel(), ud2->getVersion());
 
   for ( n = 0; n < ud1->getNumUnits(); n++)
-    ud1Temp->addUnit(ud1->getUnit(n));
+    ud1Temp.addUnit(ud1->getUnit(n));
   for ( n = 0; n < ud2->getNumUnits(); n++)
-    ud2Temp->addUnit(ud2->getUnit(n));
+    ud2Temp.addUnit(ud2->getUnit(n));
 
-  UnitDefinition::simplify(ud1Temp);
-  UnitDefinition::simplify(ud2Temp);
-
-  if (ud1Temp->getNumUnits() == ud2Temp->getNumUnits())
-  {
-    UnitDefinition::reorder(ud1Temp);
-    UnitDefinition::reorder(ud2Temp);
-
-    if (ud1Temp->getNumUnits() > 1)
-    {
-      // different multipliers left on different units may not match
-      // but overall they 
-      // e.g (2m)(sec) is tha same unit as (m)(2sec) but unit by unit
-      // comparison will fail
-      double multiplier1 = extractMultiplier(ud1Temp);
-      double multiplier2 = extractMultiplier(ud2Temp);
-
-      if (util_isEqual(multiplier1, multiplier2) == false)
-      {
-        return identical;
-      }
-    }
-    
-    n = 0;
-    while (n < ud1Temp->getNumUnits())
-    {
-      if (!Unit::areIdentical(ud1Temp->getUnit(n), ud2Temp->getUnit(n)))
-      {
-        break;
-      }
-      else
-      {
-        n++;
-      }
-    }
-    if (n == ud1Temp->getNumUnits())
-    {
-      identical = true;
-    }
-  }
-
-  delete ud1Temp;
-  delete ud2Temp;
+  identical = UnitTerms::areIdentical(ud1Temp, ud2Temp);
 
   return identical;
 }
@@ -1267,36 +1182,7 @@ UnitDefinition::areEquivalent(const UnitDefinition * ud1, const UnitDefinition *
     return equivalent;
   }
 
-  unsigned int n;
-
-  UnitDefinition * ud1Temp = UnitDefinition::convertToSI(ud1);
-  UnitDefinition * ud2Temp = UnitDefinition::convertToSI(ud2);
-
-  if (ud1Temp->getNumUnits() == ud2Temp->getNumUnits())
-  {
-    UnitDefinition::reorder(ud1Temp);
-    UnitDefinition::reorder(ud2Temp);
-    
-    n = 0;
-    while (n < ud1Temp->getNumUnits())
-    {
-      if (!Unit::areEquivalent(ud1Temp->getUnit(n), ud2Temp->getUnit(n)))
-      {
-        break;
-      }
-      else
-      {
-        n++;
-      }
-    }
-    if (n == ud1Temp->getNumUnits())
-    {
-      equivalent = true;
-    }
-  }
-
-  delete ud1Temp;
-  delete ud2Temp;
+  equivalent = UnitTerms::areEquivalent(UnitTerms(*ud1), UnitTerms(*ud2));
 
   return equivalent;
 }
@@ -1327,66 +1213,7 @@ UnitDefinition::areIdenticalSIUnits(const UnitDefinition * ud1,
     return identical;
   }
 
-  unsigned int n;
-
-  /* need to order the unitDefinitions so must make copies
-   * since the arguments are const
-   */
-  UnitDefinition * ud1Temp = UnitDefinition::convertToSI(ud1);
-  UnitDefinition * ud2Temp = UnitDefinition::convertToSI(ud2);
-
-  if (ud1Temp->getNumUnits() == ud2Temp->getNumUnits())
-  {
-    UnitDefinition::reorder(ud1Temp);
-    UnitDefinition::reorder(ud2Temp);
-    
-    if (ud1Temp->getNumUnits() > 1)
-    {
-      // different multipliers left on different units may not match
-      // but overall they 
-      // e.g (2m)(sec) is tha same unit as (m)(2sec) but unit by unit
-      // comparison will fail
-      double multiplier1 = extractMultiplier(ud1Temp);
-      double multiplier2 = extractMultiplier(ud2Temp);
-
-      if (util_isEqual(multiplier1, multiplier2) == false)
-      {
-        delete ud1Temp;
-        delete ud2Temp;
-        return identical;
-      }
-    }
-
-    n = 0;
-    while (n < ud1Temp->getNumUnits())
-    {
-      Unit* u1 = ud1Temp->getUnit(n);
-      Unit* u2 = ud2Temp->getUnit(n);
-      // if the unit is dimensionless it does not matter 
-      // what numerical factors it has
-      // but put this check here rather than in the unit areIdentical
-      // so that Unit::areIdentical is trully a test for identical
-      bool both_dimensionless = 
-           u1->getKind() == UNIT_KIND_DIMENSIONLESS 
-        && u2->getKind() == UNIT_KIND_DIMENSIONLESS;
-
-      if ( both_dimensionless || Unit::areIdentical(u1, u2) )
-      {
-        n++;
-      }
-      else
-      {
-        break;
-      }
-    }
-    if (n == ud1Temp->getNumUnits())
-    {
-      identical = true;
-    }
-  }
-
-  delete ud1Temp;
-  delete ud2Temp;
+  identical = UnitTerms::areIdenticalSIUnits(UnitTerms(*ud1), UnitTerms(*ud2));
 
   return identical;
 }
@@ -2230,11 +2057,8 @@ ListOfUnitDefinitions::get (const std::string& sid)
 const UnitDefinition*
 ListOfUnitDefinitions::get (const std::string& sid) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEqUD(sid) );
-  return (result == mItems.end()) ? NULL : 
-                   static_cast <UnitDefinition*> (*result);
+  unsigned int n = getIndexById(sid);
+  return (n < mItems.size()) ? static_cast <UnitDefinition*> (mItems[n]) : NULL;
 }
 
 
@@ -2273,6 +2097,7 @@ ListOfUnitDefinitions::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <UnitDefinition*> (item);
@@ -2058,6 +2058,63 @@ void example (SBase sb)
  * @param newid the new identifier.
  *
  * <!-- ------------------------------------------------------------------- -->
+ * @class doc_renamesidrefmap_common
+ *
+ * Replaces all uses of several @c SIdRef type attribute values at once.
+ *
+ * This method has the same effect as calling renameSIdRefs(const
+ * std::string& oldid, const std::string& newid) for each pair of
+ * identifiers in @p renamed, but looks at the attributes and mathematical
+ * formulas of this object only once, which makes a difference when many
+ * identifiers are renamed together.  Each value is renamed at most once,
+ * even if its new identifier is itself one of the old identifiers in
+ * @p renamed.  The method does @em not descend into child elements.
+ *
+ * The default implementation calls renameSIdRefs(const std::string& oldid,
+ * const std::string& newid) once for each pair of identifiers, so classes
+ * that override that method should override this one too, both to look
+ * at their attributes only once and to rename each value at most once.
+ *
+ * @param renamed a map from each old identifier to its new identifier.
+ *
+ * <!-- ------------------------------------------------------------------- -->
+ * @class doc_renameunitsidrefmap_common
+ *
+ * Replaces all uses of several @c UnitSIdRef type attribute values at
+ * once.
+ *
+ * This method has the same effect as calling renameUnitSIdRefs(const
+ * std::string& oldid, const std::string& newid) for each pair of
+ * identifiers in @p renamed, but looks at the attributes and mathematical
+ * formulas of this object only once.  Each value is renamed at most once.
+ * The method does @em not descend into child elements.
+ *
+ * The default implementation calls renameUnitSIdRefs(const std::string& oldid,
+ * const std::string& newid) once for each pair of identifiers, so classes
+ * that override that method should override this one too, both to look
+ * at their attributes only once and to rename each value at most once.
+ *
+ * @param renamed a map from each old identifier to its new identifier.
+ *
+ * <!-- ------------------------------------------------------------------- -->
+ * @class doc_renamemetaidrefmap_common
+ *
+ * Replaces all uses of several meta identifier attribute values at once.
+ *
+ * This method has the same effect as calling renameMetaIdRefs(const
+ * std::string& oldid, const std::string& newid) for each pair of
+ * identifiers in @p renamed, but looks at the attributes of this object
+ * only once.  Each value is renamed at most once.  The method does @em not
+ * descend into child elements.
+ *
+ * The default implementation calls renameMetaIdRefs(const std::string& oldid,
+ * const std::string& newid) once for each pair of identifiers, so classes
+ * that override that method should override this one too, both to look
+ * at their attributes only once and to rename each value at most once.
+ *
+ * @param renamed a map from each old identifier to its new identifier.
+ *
+ * <!-- ------------------------------------------------------------------- -->
  * @class doc_section_using_sbml_converters
  *
  * @section using-converters General information about the use of SBML converters
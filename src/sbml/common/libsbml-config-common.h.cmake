@@ -117,4 +117,7 @@
    libsbml have used the flag it is always on */
 #cmakedefine LIBSBML_USE_LEGACY_MATH 1
 
+/* Define to 1 if libSBML was built with support for multiple threads. */
+#cmakedefine LIBSBML_USE_THREADS 1
+
 #include <sbml/common/libsbml-config-packages.h>
@@ -189,14 +189,13 @@ SBMLIdConverter::convert()
   }
 
   // update all references that we changed
-  std::map<std::string, std::string>::const_iterator it;
-  for (ListIterator iter = allElements->begin(); iter != allElements->end(); ++iter)
+  if (!renamed.empty())
   {
-    SBase* current = static_cast<SBase*>(*iter);
-	  for (it = renamed.begin(); it != renamed.end(); ++it)
-	  {
-	    current->renameSIdRefs(it->first, it->second);
-	  }
+    for (ListIterator iter = allElements->begin(); iter != allElements->end(); ++iter)
+    {
+      SBase* current = static_cast<SBase*>(*iter);
+      current->renameSIdRefs(renamed);
+    }
   }
   
   delete allElements;
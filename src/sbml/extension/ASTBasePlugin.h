@@ -107,6 +107,17 @@ public:
   virtual bool isMathMLNodeTag(ASTNodeType_t type) const;
   virtual ExtendedMathType_t getExtendedMathType() const;
   virtual double evaluateASTNode(const ASTNode * node, const Model * m = NULL) const;
+#ifndef SWIG
+  /*
+   * Evaluates the node using the given values rather than the values
+   * shared by SBMLTransforms; plugins whose nodes have children should
+   * override this and evaluate the children with the same values.
+   * The default implementation calls evaluateASTNode(node, m).
+   */
+  virtual double evaluateASTNode(const ASTNode * node,
+     const std::map<const std::string, std::pair<double, bool> >& values,
+     const Model * m = NULL) const;
+#endif
   virtual UnitDefinition * getUnitDefinitionFromPackage(UnitFormulaFormatter* uff, const ASTNode * node, bool inKL, int reactNo) const;
 
   const ASTNodeValues_t* getASTNodeValue(unsigned int n) const;
@@ -426,6 +426,42 @@ SBasePlugin::renameUnitSIdRefs(const std::string& , const std::string& )
 }
 /** @endcond */
 
+/** @cond doxygenLibsbmlInternal */
+void 
+SBasePlugin::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::map<std::string, std::string>::const_iterator it;
+  for (it = renamed.begin(); it != renamed.end(); ++it)
+  {
+    renameSIdRefs(it->first, it->second);
+  }
+}
+/** @endcond */
+
+/** @cond doxygenLibsbmlInternal */
+void 
+SBasePlugin::renameMetaIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::map<std::string, std::string>::const_iterator it;
+  for (it = renamed.begin(); it != renamed.end(); ++it)
+  {
+    renameMetaIdRefs(it->first, it->second);
+  }
+}
+/** @endcond */
+
+/** @cond doxygenLibsbmlInternal */
+void 
+SBasePlugin::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::map<std::string, std::string>::const_iterator it;
+  for (it = renamed.begin(); it != renamed.end(); ++it)
+  {
+    renameUnitSIdRefs(it->first, it->second);
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 int 
 SBasePlugin::transformIdentifiers(IdentifierTransformer* )
@@ -606,6 +606,24 @@ public:
   virtual void renameUnitSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /**
+   * @copydoc doc_renamesidrefmap_common
+   */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
+  /**
+   * @copydoc doc_renamemetaidrefmap_common
+   */
+  virtual void renameMetaIdRefs(const std::map<std::string, std::string>& renamed);
+
+
+  /**
+   * @copydoc doc_renameunitsidrefmap_common
+   */
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
   /** @cond doxygenLibsbmlInternal */
   virtual int transformIdentifiers(IdentifierTransformer* sidTransformer);
   /** @endcond */
@@ -244,7 +244,7 @@ LIBSBML_EXTERN
 ASTNode::ASTNode (ASTNodeType_t type)
 {
   unsetSemanticsFlag();
-  mDefinitionURL = new XMLAttributes();
+  mDefinitionURL = NULL;
   mReal          = 0;
   mExponent      = 0;
   mType          = AST_UNKNOWN;
@@ -253,18 +253,13 @@ ASTNode::ASTNode (ASTNodeType_t type)
   mInteger       = 0;
   mDenominator   = 1;
   mParentSBMLObject = NULL;
-  mUnits         = "";
-  mId			 = "";
-  mClass		 = "";
-  mStyle		 = "";
   mIsBvar = false;
   mUserData      = NULL;
+  mExtra         = NULL;
 
   // move to after we have loaded plugins
   //setType(type);
 
-  mChildren             = new List;
-  mSemanticsAnnotations = new List;
   // only load plugins when we need to
   //if (type > AST_END_OF_CORE && type < AST_UNKNOWN)
   //{
@@ -290,7 +285,7 @@ LIBSBML_EXTERN
 ASTNode::ASTNode (Token_t* token)
 {
   unsetSemanticsFlag();
-  mDefinitionURL = new XMLAttributes();
+  mDefinitionURL = NULL;
   mReal          = 0;
   mExponent      = 0;
   mType          = AST_UNKNOWN;
@@ -299,15 +294,10 @@ ASTNode::ASTNode (Token_t* token)
   mInteger       = 0;
   mDenominator   = 1;
   mParentSBMLObject = NULL;
-  mUnits         = "";
-  mId			 = "";
-  mClass		 = "";
-  mStyle		 = "";
   mIsBvar = false;
   mUserData      = NULL;
+  mExtra         = NULL;
 
-  mChildren             = new List;
-  mSemanticsAnnotations = new List;
 
   if (token != NULL)
   {
@@ -360,37 +350,38 @@ LIBSBML_EXTERN
 ASTNode::ASTNode (const ASTNode& orig) :
   mType                 ( orig.mType )
  ,mChar                 ( orig.mChar )
+ ,hasSemantics          ( orig.hasSemantics )
+ ,mIsBvar               ( orig.mIsBvar)
  ,mName                 ( NULL )
  ,mInteger              ( orig.mInteger )
  ,mReal                 ( orig.mReal )
  ,mDenominator          ( orig.mDenominator )
  ,mExponent             ( orig.mExponent )
- ,mDefinitionURL        ( orig.mDefinitionURL->clone() )	
- ,hasSemantics          ( orig.hasSemantics )
- ,mChildren             ( new List() )
- ,mSemanticsAnnotations ( new List() )
+ ,mDefinitionURL        ( NULL )
+ ,mChildren             ( )
  ,mParentSBMLObject     ( orig.mParentSBMLObject )
- ,mUnits                ( orig.mUnits)
- ,mId                   ( orig.mId)
- ,mClass                ( orig.mClass)
- ,mStyle                ( orig.mStyle)
- ,mIsBvar               ( orig.mIsBvar)
  ,mUserData             ( orig.mUserData )
+ ,mExtra                ( NULL )
 {
   if (orig.mName)
   {
     mName = safe_strdup(orig.mName);
   }
 
-  for (unsigned int c = 0; c < orig.getNumChildren(); ++c)
+  XMLAttributes* url = orig.mDefinitionURL;
+  if (url != NULL)
   {
-    addChild( orig.getChild(c)->deepCopy() );
+    mDefinitionURL = url->clone();
   }
 
-  for (unsigned int c = 0; c < orig.getNumSemanticsAnnotations(); ++c)
+  mChildren.reserve(orig.mChildren.size());
+  for (unsigned int c = 0; c < orig.getNumChildren(); ++c)
   {
-    addSemanticsAnnotation( orig.getSemanticsAnnotation(c)->clone() );
+    addChild( orig.getChild(c)->deepCopy() );
   }
+
+  copyExtraAttributes(orig);
+
   mPlugins.resize(orig.mPlugins.size());
   transform(orig.mPlugins.begin(), orig.mPlugins.end(),
     mPlugins.begin(), CloneASTPluginEntity());
@@ -418,10 +409,6 @@ ASTNode& ASTNode::operator=(const ASTNode& rhs)
     mExponent             = rhs.mExponent;
     hasSemantics          = rhs.hasSemantics;
     mParentSBMLObject     = rhs.mParentSBMLObject;
-    mUnits                = rhs.mUnits;
-    mId                   = rhs.mId;
-    mClass                = rhs.mClass;
-    mStyle                = rhs.mStyle;
     mIsBvar               = rhs.mIsBvar;
     mUserData             = rhs.mUserData;
     freeName();
@@ -434,28 +421,20 @@ ASTNode& ASTNode::operator=(const ASTNode& rhs)
       mName = NULL;
     }
 
-    unsigned int size = mChildren->getSize();
-    while (size--) delete static_cast<ASTNode*>( mChildren->remove(0) );
-    delete mChildren;
-    mChildren = new List();
+    deleteChildren();
+    mChildren.reserve(rhs.mChildren.size());
 
     for (unsigned int c = 0; c < rhs.getNumChildren(); ++c)
     {
       addChild( rhs.getChild(c)->deepCopy() );
     }
 
-    size = mSemanticsAnnotations->getSize();
-    while (size--)  delete static_cast<XMLNode*>(mSemanticsAnnotations->remove(0) );
-    delete mSemanticsAnnotations;
-    mSemanticsAnnotations = new List();
+    copyExtraAttributes(rhs);
 
-    for (unsigned int c = 0; c < rhs.getNumSemanticsAnnotations(); ++c)
-    {
-      addSemanticsAnnotation( rhs.getSemanticsAnnotation(c)->clone() );
-    }
-    
-    delete mDefinitionURL;
-    mDefinitionURL        = rhs.mDefinitionURL->clone();	
+    XMLAttributes* url    = mDefinitionURL;
+    delete url;
+    url                   = rhs.mDefinitionURL;
+    mDefinitionURL        = (url != NULL) ? url->clone() : NULL;
     clearPlugins();
     mPlugins.resize(rhs.mPlugins.size());
     transform(rhs.mPlugins.begin(), rhs.mPlugins.end(),
@@ -470,17 +449,12 @@ ASTNode& ASTNode::operator=(const ASTNode& rhs)
 LIBSBML_EXTERN
 ASTNode::~ASTNode ()
 {
-  unsigned int size = getNumChildren();
-
+  deleteChildren();
 
-  while (size--) delete static_cast<ASTNode*>( mChildren->remove(0) );
-  delete mChildren;
+  deleteExtraAttributes();
 
-  size = mSemanticsAnnotations->getSize();
-  while (size--)  delete static_cast<XMLNode*>(mSemanticsAnnotations->remove(0) );
-  delete mSemanticsAnnotations;
-
-  delete mDefinitionURL;
+  XMLAttributes* url = mDefinitionURL;
+  delete url;
   
   freeName();
   clearPlugins();
@@ -488,6 +462,73 @@ ASTNode::~ASTNode ()
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Deletes the children of this node.
+ */
+void
+ASTNode::deleteChildren()
+{
+  for (size_t c = 0; c < mChildren.size(); ++c)
+  {
+    delete mChildren[c];
+  }
+  mChildren.clear();
+}
+
+
+/*
+ * Returns the record of rarely used attributes, creating it if needed.
+ */
+ASTNode::ExtraAttributes&
+ASTNode::getExtraAttributes()
+{
+  if (mExtra == NULL)
+  {
+    mExtra = new ExtraAttributes();
+  }
+  return *mExtra;
+}
+
+
+/*
+ * Replaces the rarely used attributes of this node by copies of those
+ * of orig.
+ */
+void
+ASTNode::copyExtraAttributes(const ASTNode& orig)
+{
+  deleteExtraAttributes();
+  if (orig.mExtra == NULL) return;
+
+  mExtra = new ExtraAttributes();
+  mExtra->mUnits = orig.mExtra->mUnits;
+  mExtra->mId    = orig.mExtra->mId;
+  mExtra->mClass = orig.mExtra->mClass;
+  mExtra->mStyle = orig.mExtra->mStyle;
+
+  for (unsigned int c = 0; c < orig.getNumSemanticsAnnotations(); ++c)
+  {
+    addSemanticsAnnotation( orig.getSemanticsAnnotation(c)->clone() );
+  }
+}
+
+
+void
+ASTNode::deleteExtraAttributes()
+{
+  if (mExtra == NULL) return;
+
+  for (size_t c = 0; c < mExtra->mSemanticsAnnotations.size(); ++c)
+  {
+    delete mExtra->mSemanticsAnnotations[c];
+  }
+  delete mExtra;
+  mExtra = NULL;
+}
+/** @endcond */
+
+
 /*
  * Frees the name of this ASTNode and sets it to NULL.
  * 
@@ -831,7 +872,12 @@ ASTNode::addChild (ASTNode* child, bool inRead)
 {
 
   unsigned int numBefore = getNumChildren();
-  mChildren->add(child);
+  // most nodes are binary; allocate room for both children at once
+  if (mChildren.capacity() == 0)
+  {
+    mChildren.reserve(2);
+  }
+  mChildren.push_back(child);
 
   /* HACK to allow representsBVar function to be correct */
   if (inRead == false && this->getType() == AST_LAMBDA
@@ -869,7 +915,7 @@ ASTNode::prependChild (ASTNode* child)
   if (child == NULL) return LIBSBML_INVALID_OBJECT;
 
   unsigned int numBefore = getNumChildren();
-  mChildren->prepend(child);
+  mChildren.insert(mChildren.begin(), child);
 
   if (getNumChildren() == numBefore + 1)
   {
@@ -890,7 +936,7 @@ ASTNode::removeChild(unsigned int n)
   unsigned int size = getNumChildren();
   if (n < size)
   {
-    mChildren->remove(n);
+    mChildren.erase(mChildren.begin() + n);
     if (getNumChildren() == size-1)
     {
       removed = LIBSBML_OPERATION_SUCCESS;
@@ -911,7 +957,8 @@ ASTNode::replaceChild(unsigned int n, ASTNode *newChild, bool delreplaced)
   unsigned int size = getNumChildren();
   if (n < size)
   {
-    ASTNode* rep = static_cast<ASTNode*>(mChildren->remove(n));
+    ASTNode* rep = mChildren[n];
+    mChildren.erase(mChildren.begin() + n);
     if (delreplaced) 
     {
       delete rep;
@@ -931,38 +978,12 @@ ASTNode::insertChild(unsigned int n, ASTNode *newChild)
 
   int inserted = LIBSBML_INDEX_EXCEEDS_SIZE;
 
-  unsigned int i, size = getNumChildren();
-  if (n == 0)
+  unsigned int size = getNumChildren();
+  if (n <= size) 
   {
-    prependChild(newChild);
+    mChildren.insert(mChildren.begin() + n, newChild);
     inserted = LIBSBML_OPERATION_SUCCESS;
   }
-  else if (n <= size) 
-  {
-    /* starting at the end take each child in the list and prepend it
-    * then remove it from the end
-    * at the insertion point prepend the newChild
-    * eg list: a, b, c 
-    * inserting d at position 2
-    * list goes: c, a, b :  d, c, a, b : b, d, c, a : a, b, d, c
-    */
-    for (i = size-1; i >= n; i--)
-    {
-      prependChild(getChild(size-1));
-      mChildren->remove(size);
-    }
-
-    prependChild(newChild);
-
-    for (i = 0; i < n; i++)
-    {
-      prependChild(getChild(size));
-      mChildren->remove(size+1);
-    }
-
-    if (getNumChildren() == size + 1)
-      inserted = LIBSBML_OPERATION_SUCCESS;
-  }
 
   /* HACK TO Make representBvar work */
   // mark all but last child as bvar
@@ -998,7 +1019,7 @@ LIBSBML_EXTERN
 ASTNode*
 ASTNode::getChild (unsigned int n) const
 {
-  return static_cast<ASTNode*>( mChildren->get(n) );
+  return (n < mChildren.size()) ? mChildren[n] : NULL;
 }
 
 
@@ -1010,7 +1031,7 @@ LIBSBML_EXTERN
 ASTNode*
 ASTNode::getLeftChild () const
 {
-  return static_cast<ASTNode*>( mChildren->get(0) );
+  return mChildren.empty() ? NULL : mChildren[0];
 }
 
 
@@ -1027,7 +1048,7 @@ ASTNode::getRightChild () const
   unsigned int nc = getNumChildren();
 
 
-  return (nc > 1) ? static_cast<ASTNode*>( mChildren->get(nc - 1) ): NULL;
+  return (nc > 1) ? mChildren[nc - 1] : NULL;
 }
 
 
@@ -1039,7 +1060,7 @@ LIBSBML_EXTERN
 unsigned int
 ASTNode::getNumChildren () const
 {
-  return mChildren->getSize();
+  return (unsigned int)(mChildren.size());
 }
 
 
@@ -1054,7 +1075,7 @@ ASTNode::addSemanticsAnnotation (XMLNode* sAnnotation)
   {
     return LIBSBML_OPERATION_FAILED;
   }
-  mSemanticsAnnotations->add(sAnnotation);
+  getExtraAttributes().mSemanticsAnnotations.push_back(sAnnotation);
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -1066,7 +1087,8 @@ LIBSBML_EXTERN
 unsigned int 
 ASTNode::getNumSemanticsAnnotations () const
 {
-  return mSemanticsAnnotations->getSize();
+  return (mExtra != NULL) ?
+         (unsigned int)(mExtra->mSemanticsAnnotations.size()) : 0;
 }
 
 
@@ -1078,7 +1100,11 @@ LIBSBML_EXTERN
 XMLNode* 
 ASTNode::getSemanticsAnnotation (unsigned int n) const
 {
-  return static_cast<XMLNode*>( mSemanticsAnnotations->get(n) );
+  if (n >= getNumSemanticsAnnotations())
+  {
+    return NULL;
+  }
+  return mExtra->mSemanticsAnnotations[n];
 }
 
 /*
@@ -1449,28 +1475,28 @@ LIBSBML_EXTERN
 std::string
 ASTNode::getId() const
 {
-  return mId;
+  return (mExtra != NULL) ? mExtra->mId : std::string();
 }
 
 LIBSBML_EXTERN
 std::string
 ASTNode::getClass() const
 {
-  return mClass;
+  return (mExtra != NULL) ? mExtra->mClass : std::string();
 }
 
 LIBSBML_EXTERN
 std::string
 ASTNode::getStyle() const
 {
-  return mStyle;
+  return (mExtra != NULL) ? mExtra->mStyle : std::string();
 }
 
 LIBSBML_EXTERN
 std::string
 ASTNode::getUnits() const
 {
-  return mUnits;
+  return (mExtra != NULL) ? mExtra->mUnits : std::string();
 }
 
 /** @cond doxygenLibsbmlInternal */
@@ -1997,28 +2023,28 @@ LIBSBML_EXTERN
 bool 
 ASTNode::isSetId() const
 {
-  return (mId.empty() == false);
+  return (mExtra != NULL && mExtra->mId.empty() == false);
 }
   
 LIBSBML_EXTERN
 bool 
 ASTNode::isSetClass() const
 {
-  return (mClass.empty() == false);
+  return (mExtra != NULL && mExtra->mClass.empty() == false);
 }
   
 LIBSBML_EXTERN
 bool 
 ASTNode::isSetStyle() const
 {
-  return (mStyle.empty() == false);
+  return (mExtra != NULL && mExtra->mStyle.empty() == false);
 }
   
 LIBSBML_EXTERN
 bool 
 ASTNode::isSetUnits() const
 {
-  return (mUnits.empty() == false);
+  return (mExtra != NULL && mExtra->mUnits.empty() == false);
 }
   
 
@@ -2199,21 +2225,15 @@ ASTNode::setType (ASTNodeType_t type)
     //{
       mReal = 6.02214179e23;
     //}
-    mDefinitionURL->clear();
-    mDefinitionURL->add("definitionURL", 
-                        "http://www.sbml.org/sbml/symbols/avogadro");
+    setDefinitionURL("http://www.sbml.org/sbml/symbols/avogadro");
   }
   else if (type == AST_NAME_TIME)
   {
-    mDefinitionURL->clear();
-    mDefinitionURL->add("definitionURL", 
-                        "http://www.sbml.org/sbml/symbols/time");
+    setDefinitionURL("http://www.sbml.org/sbml/symbols/time");
   }
   else if (type == AST_FUNCTION_DELAY)
   {
-    mDefinitionURL->clear();
-    mDefinitionURL->add("definitionURL", 
-                        "http://www.sbml.org/sbml/symbols/delay");
+    setDefinitionURL("http://www.sbml.org/sbml/symbols/delay");
   }
 
   /*
@@ -2278,13 +2298,19 @@ ASTNode::setType (ASTNodeType_t type)
   {
     mType = AST_UNKNOWN;
     mChar = 0;
-    mDefinitionURL->clear();
+    XMLAttributes* url = mDefinitionURL;
+    if (url != NULL)
+    {
+      url->clear();
+    }
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
   }
 
-  if (clearDefinitionURL == true && getSemanticsFlag() == false)
+  // the attributes are kept, as callers may still hold them
+  XMLAttributes* url = mDefinitionURL;
+  if (clearDefinitionURL == true && getSemanticsFlag() == false && url != NULL)
   {
-    mDefinitionURL->clear();
+    url->clear();
   }
 
     
@@ -2296,7 +2322,7 @@ LIBSBML_EXTERN
 int
 ASTNode::setId (const std::string& id)
 {
-  mId     = id;
+  getExtraAttributes().mId = id;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2304,7 +2330,7 @@ LIBSBML_EXTERN
 int
 ASTNode::setClass (const std::string& className)
 {
-  mClass   = className;
+  getExtraAttributes().mClass = className;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2312,7 +2338,7 @@ LIBSBML_EXTERN
 int
 ASTNode::setStyle (const std::string& style)
 {
-  mStyle     = style;
+  getExtraAttributes().mStyle = style;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2328,7 +2354,7 @@ ASTNode::setUnits (const std::string& units)
   if (!SyntaxChecker::isValidInternalUnitSId(units))
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
 
-  mUnits     = units;
+  getExtraAttributes().mUnits = units;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2343,9 +2369,7 @@ ASTNode::swapChildren (ASTNode *that)
   if (that == NULL)
     return LIBSBML_OPERATION_FAILED;
 
-  List *temp      = this->mChildren;
-  this->mChildren = that->mChildren;
-  that->mChildren = temp;
+  this->mChildren.swap(that->mChildren);
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2379,6 +2403,41 @@ ASTNode::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+LIBSBML_EXTERN
+void 
+ASTNode::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  if (getType() == AST_NAME ||
+      getType() == AST_FUNCTION ||
+      getType() == AST_UNKNOWN) {
+    const char* name = getName();
+    if (name != NULL) {
+      std::map<std::string, std::string>::const_iterator it = renamed.find(name);
+      if (it != renamed.end()) {
+        setName(it->second.c_str());
+      }
+    }
+  }
+  for (unsigned int child=0; child<getNumChildren(); child++) {
+    getChild(child)->renameSIdRefs(renamed);
+  }
+}
+
+LIBSBML_EXTERN
+void 
+ASTNode::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  if (isSetUnits()) {
+    std::map<std::string, std::string>::const_iterator it = renamed.find(getUnits());
+    if (it != renamed.end()) {
+      setUnits(it->second);
+    }
+  }
+  for (unsigned int child=0; child<getNumChildren(); child++) {
+    getChild(child)->renameUnitSIdRefs(renamed);
+  }
+}
+
 
 /** @cond doxygenLibsbmlInternal */
 LIBSBML_EXTERN
@@ -2419,9 +2478,12 @@ LIBSBML_EXTERN
 int
 ASTNode::unsetId ()
 {
-  mId.erase();
+  if (mExtra != NULL)
+  {
+    mExtra->mId.erase();
+  }
 
-  if (mId.empty())
+  if (!isSetId())
   {
     return LIBSBML_OPERATION_SUCCESS;
   }
@@ -2436,9 +2498,12 @@ LIBSBML_EXTERN
 int
 ASTNode::unsetClass ()
 {
-  mClass.erase();
+  if (mExtra != NULL)
+  {
+    mExtra->mClass.erase();
+  }
 
-  if (mClass.empty())
+  if (!isSetClass())
   {
     return LIBSBML_OPERATION_SUCCESS;
   }
@@ -2452,9 +2517,12 @@ LIBSBML_EXTERN
 int
 ASTNode::unsetStyle ()
 {
-  mStyle.erase();
+  if (mExtra != NULL)
+  {
+    mExtra->mStyle.erase();
+  }
 
-  if (mStyle.empty())
+  if (!isSetStyle())
   {
     return LIBSBML_OPERATION_SUCCESS;
   }
@@ -2471,9 +2539,12 @@ ASTNode::unsetUnits ()
   if (!isNumber())
     return LIBSBML_UNEXPECTED_ATTRIBUTE;
 
-  mUnits.erase();
+  if (mExtra != NULL)
+  {
+    mExtra->mUnits.erase();
+  }
 
-  if (mUnits.empty())
+  if (!isSetUnits())
   {
     return LIBSBML_OPERATION_SUCCESS;
   }
@@ -2537,7 +2608,8 @@ ASTNode::getSemanticsFlag() const
 int 
 ASTNode::setDefinitionURL(XMLAttributes url)
 {
-  delete mDefinitionURL;
+  XMLAttributes* old = mDefinitionURL;
+  delete old;
   mDefinitionURL = static_cast<XMLAttributes *>(url.clone());
   return LIBSBML_OPERATION_SUCCESS;
 }
@@ -2549,8 +2621,8 @@ ASTNode::setDefinitionURL(XMLAttributes url)
 int 
 ASTNode::setDefinitionURL(const std::string& url)
 {
-  mDefinitionURL->clear();
-  mDefinitionURL->add("definitionURL", url);
+  getDefinitionURL()->clear();
+  getDefinitionURL()->add("definitionURL", url);
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2929,7 +3001,32 @@ LIBSBML_EXTERN
 XMLAttributes*
 ASTNode::getDefinitionURL() const
 {
-  return mDefinitionURL;
+  XMLAttributes* url = mDefinitionURL;
+  if (url == NULL)
+  {
+    url = new XMLAttributes();
+#if defined(LIBSBML_USE_THREADS)
+    // another thread may have created them in the meantime
+    XMLAttributes* current = NULL;
+    if (!mDefinitionURL.compare_exchange_strong(current, url))
+    {
+      delete url;
+      url = current;
+    }
+#else
+    mDefinitionURL = url;
+#endif
+  }
+  return url;
+}
+
+
+LIBSBML_EXTERN
+bool
+ASTNode::isSetDefinitionURL() const
+{
+  const XMLAttributes* url = mDefinitionURL;
+  return (url != NULL && !url->isEmpty());
 }
 
 
@@ -2938,13 +3035,14 @@ LIBSBML_EXTERN
 std::string
 ASTNode::getDefinitionURLString() const
 {
-  if (mDefinitionURL == NULL)
+  const XMLAttributes* url = mDefinitionURL;
+  if (url == NULL)
   {
     return "";
   }
   else
   {
-    return mDefinitionURL->getValue("definitionURL");
+    return url->getValue("definitionURL");
   }
 }
 
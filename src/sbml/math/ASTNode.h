@@ -189,6 +189,10 @@
 #include <sbml/extension/ASTBasePlugin.h>
 //#include <sbml/math/ExtendedMathList.h>
 
+#if defined(LIBSBML_USE_THREADS) && !defined(SWIG)
+#include <atomic>
+#endif
+
 LIBSBML_CPP_NAMESPACE_BEGIN
 
 
@@ -1634,6 +1638,26 @@ setValue(value, 0);
   virtual void renameUnitSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /**
+   * Renames all the SIdRef attributes on this node and any child node that
+   * are keys of the given map, in a single pass over the nodes.
+   *
+   * @param renamed a map from each old identifier to its new identifier.
+   */
+  LIBSBML_EXTERN
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
+  /**
+   * Renames all the UnitSIdRef attributes on this node and any child node
+   * that are keys of the given map, in a single pass over the nodes.
+   *
+   * @param renamed a map from each old identifier to its new identifier.
+   */
+  LIBSBML_EXTERN
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * Replace any nodes of type AST_NAME with the name 'id' from the child 'math' object with the provided ASTNode. 
@@ -1999,6 +2023,19 @@ setValue(value, 0);
   std::string getDefinitionURLString() const;
 
 
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Predicate returning @c true if this node has a non-empty set of
+   * @c definitionURL attributes, without creating them as
+   * getDefinitionURL() does.
+   *
+   * @return @c true if this node has @c definitionURL attributes.
+   */
+  LIBSBML_EXTERN
+  bool isSetDefinitionURL() const;
+  /** @endcond */
+
+
   /** @cond doxygenLibsbmlInternal */
 
   LIBSBML_EXTERN
@@ -2285,34 +2322,59 @@ protected:
   bool canonicalizeRelational ();
 
 
+  /*
+   * Attributes that few nodes carry live in a record that is only
+   * allocated when one of them is set, so that the common node stays
+   * small.
+   */
+  struct ExtraAttributes
+  {
+    std::string mUnits;
+
+    // additional MathML attributes
+    std::string mId;
+    std::string mClass;
+    std::string mStyle;
+
+    std::vector<XMLNode*> mSemanticsAnnotations;
+  };
+
+  ExtraAttributes& getExtraAttributes();
+
+  void copyExtraAttributes(const ASTNode& orig);
+
+  void deleteExtraAttributes();
+
+  void deleteChildren();
+
+
   ASTNodeType_t mType;
 
   char   mChar;
+  bool   hasSemantics;
+  bool   mIsBvar;
+
   char*  mName;
   long   mInteger;
   double mReal;
   long mDenominator;
   long mExponent;
 
-  XMLAttributes* mDefinitionURL;
-  bool hasSemantics;
+  // created on first use, and only cleared after that; nodes shared by
+  // several threads may have getDefinitionURL() called on them at once
+#if defined(LIBSBML_USE_THREADS) && !defined(SWIG)
+  mutable std::atomic<XMLAttributes*> mDefinitionURL;
+#else
+  mutable XMLAttributes* mDefinitionURL;
+#endif
 
-  List *mChildren;
-
-  List *mSemanticsAnnotations;
+  std::vector<ASTNode*> mChildren;
 
   SBase *mParentSBMLObject;
 
-  std::string mUnits;
-
-  // additional MathML attributes
-  std::string mId;
-  std::string mClass;
-  std::string mStyle;
-
-  bool mIsBvar;
   void *mUserData;
-  std::string mPackageName;
+
+  ExtraAttributes* mExtra;
   
   friend class MathMLFormatter;
   friend class MathMLHandler;
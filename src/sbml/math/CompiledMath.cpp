@@ -0,0 +1,903 @@
+/**
+ * @file    CompiledMath.cpp
+ * @brief   Implementation of CompiledMath, a flat program evaluating an ASTNode.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <cmath>
+#include <limits>
+
+#include <sbml/math/CompiledMath.h>
+#include <sbml/math/ASTNode.h>
+#include <sbml/Model.h>
+#include <sbml/SBMLTransforms.h>
+
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Programs needing no more stack than this are evaluated without
+ * allocating.
+ */
+static const unsigned int LOCAL_STACK_SIZE = 64;
+/** @endcond */
+
+
+CompiledMath::CompiledMath()
+  : mMath(NULL)
+  , mMaxDepth(0)
+  , mDepth(0)
+{
+}
+
+
+CompiledMath::CompiledMath(const ASTNode* math, const Model* m)
+  : mMath(NULL)
+  , mMaxDepth(0)
+  , mDepth(0)
+{
+  compile(math, m);
+}
+
+
+CompiledMath::CompiledMath(const CompiledMath& orig)
+  : mMath(NULL)
+  , mMaxDepth(0)
+  , mDepth(0)
+{
+  // the function definitions are already inlined in orig.mMath
+  if (orig.mMath != NULL)
+  {
+    compile(orig.mMath);
+  }
+}
+
+
+CompiledMath&
+CompiledMath::operator=(const CompiledMath& rhs)
+{
+  if (&rhs != this)
+  {
+    if (rhs.mMath != NULL)
+    {
+      compile(rhs.mMath);
+    }
+    else
+    {
+      clear();
+    }
+  }
+  return *this;
+}
+
+
+CompiledMath::~CompiledMath()
+{
+  clear();
+}
+
+
+int
+CompiledMath::compile(const ASTNode* math, const Model* m)
+{
+  if (math == NULL)
+  {
+    clear();
+    return LIBSBML_INVALID_OBJECT;
+  }
+
+  // math may be part of the tree we are about to delete
+  ASTNode* copy = math->deepCopy();
+  clear();
+  mMath = copy;
+
+  if (m != NULL)
+  {
+    SBMLTransforms::replaceFD(mMath, m->getListOfFunctionDefinitions());
+  }
+
+  compileNode(mMath);
+
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+bool
+CompiledMath::isCompiled() const
+{
+  return mMath != NULL;
+}
+
+
+unsigned int
+CompiledMath::getNumVariables() const
+{
+  return (unsigned int)(mVariables.size());
+}
+
+
+const std::string&
+CompiledMath::getVariable(unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mVariables.size()) ? mVariables[n] : empty;
+}
+
+
+int
+CompiledMath::getVariableIndex(const std::string& id) const
+{
+  map<string, unsigned int>::const_iterator it = mVariableIndex.find(id);
+  return (it != mVariableIndex.end()) ? (int)(it->second) : -1;
+}
+
+
+void
+CompiledMath::getInitialValues(const Model* m, std::vector<double>& values) const
+{
+  values.assign(mVariables.size(), numeric_limits<double>::quiet_NaN());
+  if (m == NULL) return;
+
+  SBMLTransforms::IdValueMap modelValues;
+  SBMLTransforms::getComponentValuesForModel(m, modelValues);
+
+  // let evaluateASTNode resolve values that are set by rules
+  ASTNode name(AST_NAME);
+  for (unsigned int i = 0; i < mVariables.size(); ++i)
+  {
+    name.setName(mVariables[i].c_str());
+    values[i] = SBMLTransforms::evaluateASTNode(&name, modelValues, m);
+  }
+}
+
+
+double
+CompiledMath::evaluate(const double* values) const
+{
+  if (mCode.empty())
+  {
+    return numeric_limits<double>::quiet_NaN();
+  }
+
+  if (mMaxDepth <= LOCAL_STACK_SIZE)
+  {
+    double stack[LOCAL_STACK_SIZE];
+    return execute(values, stack);
+  }
+
+  vector<double> stack(mMaxDepth);
+  return execute(values, &stack[0]);
+}
+
+
+double
+CompiledMath::evaluate(const std::vector<double>& values) const
+{
+  if (values.size() >= mVariables.size())
+  {
+    return evaluate(values.empty() ? NULL : &values[0]);
+  }
+
+  vector<double> padded(values);
+  padded.resize(mVariables.size(), numeric_limits<double>::quiet_NaN());
+  return evaluate(&padded[0]);
+}
+
+
+void
+CompiledMath::evaluate(const double* values, unsigned int numSets,
+                       double* results) const
+{
+  if (results == NULL || numSets == 0) return;
+
+  if (mCode.empty())
+  {
+    for (unsigned int i = 0; i < numSets; ++i)
+    {
+      results[i] = numeric_limits<double>::quiet_NaN();
+    }
+    return;
+  }
+
+  vector<double> stack(mMaxDepth);
+  const size_t stride = mVariables.size();
+  for (unsigned int i = 0; i < numSets; ++i)
+  {
+    results[i] = execute(values + i * stride, &stack[0]);
+  }
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+void
+CompiledMath::clear()
+{
+  delete mMath;
+  mMath = NULL;
+  mCode.clear();
+  mVariables.clear();
+  mVariableIndex.clear();
+  mSubtrees.clear();
+  mMaxDepth = 0;
+  mDepth = 0;
+}
+
+
+/*
+ * Appends the instructions computing the value of the node.  The
+ * translation follows SBMLTransforms::evaluateASTNode() case by case;
+ * operands that evaluateASTNode() computes more than once are computed
+ * once, and operands it never looks at are not compiled.
+ */
+void
+CompiledMath::compileNode(const ASTNode* node)
+{
+  if (node == NULL)
+  {
+    emit(OP_CONST, 0, numeric_limits<double>::quiet_NaN());
+    return;
+  }
+
+  unsigned int numChildren = node->getNumChildren();
+
+  switch (node->getType())
+  {
+  case AST_INTEGER:
+    emit(OP_CONST, 0, (double)(node->getInteger()));
+    break;
+
+  case AST_REAL:
+  case AST_REAL_E:
+  case AST_RATIONAL:
+  case AST_NAME_AVOGADRO:
+    emit(OP_CONST, 0, node->getReal());
+    break;
+
+  case AST_NAME:
+    if (node->getName() != NULL)
+    {
+      emit(OP_LOAD, bindVariable(node->getName()));
+    }
+    else
+    {
+      emit(OP_CONST, 0, numeric_limits<double>::quiet_NaN());
+    }
+    break;
+
+  case AST_NAME_TIME:
+  case AST_CONSTANT_FALSE:
+    emit(OP_CONST, 0, 0.0);
+    break;
+
+  case AST_CONSTANT_TRUE:
+    emit(OP_CONST, 0, 1.0);
+    break;
+
+  case AST_CONSTANT_E:
+    emit(OP_CONST, 0, exp(1.0));
+    break;
+
+  case AST_CONSTANT_PI:
+    emit(OP_CONST, 0, 4.0*atan(1.0));
+    break;
+
+  case AST_LAMBDA:
+  case AST_FUNCTION:
+  case AST_FUNCTION_DELAY:
+    // function definitions have been inlined; anything left is undefined
+    emit(OP_CONST, 0, numeric_limits<double>::quiet_NaN());
+    break;
+
+  case AST_PLUS:
+  case AST_TIMES:
+    if (numChildren == 0)
+    {
+      emit(OP_CONST, 0, (node->getType() == AST_PLUS) ? 0.0 : 1.0);
+    }
+    else
+    {
+      Op op = (node->getType() == AST_PLUS) ? OP_ADD : OP_MULTIPLY;
+      compileChild(node, 0);
+      for (unsigned int j = 1; j < numChildren; ++j)
+      {
+        compileChild(node, j);
+        emitOperation(op, 2);
+      }
+    }
+    break;
+
+  case AST_MINUS:
+    if (numChildren == 1)
+    {
+      compileChild(node, 0);
+      emitOperation(OP_NEGATE, 1);
+    }
+    else
+    {
+      compileChild(node, 0);
+      compileChild(node, 1);
+      emitOperation(OP_SUBTRACT, 2);
+    }
+    break;
+
+  case AST_DIVIDE:
+    compileChild(node, 0);
+    compileChild(node, 1);
+    emitOperation(OP_DIVIDE, 2);
+    break;
+
+  case AST_POWER:
+  case AST_FUNCTION_POWER:
+    compileChild(node, 0);
+    compileChild(node, 1);
+    emitOperation(OP_POWER, 2);
+    break;
+
+  case AST_FUNCTION_ROOT:
+    compileChild(node, 0);
+    compileChild(node, 1);
+    emitOperation(OP_ROOT, 2);
+    break;
+
+  case AST_FUNCTION_LOG:
+    // the base is ignored, as by evaluateASTNode
+    compileChild(node, 1);
+    emitOperation(OP_LOG10, 1);
+    break;
+
+  case AST_FUNCTION_ABS:      compileChild(node, 0); emitOperation(OP_ABS, 1);       break;
+  case AST_FUNCTION_ARCCOS:   compileChild(node, 0); emitOperation(OP_ARCCOS, 1);    break;
+  case AST_FUNCTION_ARCCOSH:  compileChild(node, 0); emitOperation(OP_ARCCOSH, 1);   break;
+  case AST_FUNCTION_ARCCOT:   compileChild(node, 0); emitOperation(OP_ARCCOT, 1);    break;
+  case AST_FUNCTION_ARCCOTH:  compileChild(node, 0); emitOperation(OP_ARCCOTH, 1);   break;
+  case AST_FUNCTION_ARCCSC:   compileChild(node, 0); emitOperation(OP_ARCCSC, 1);    break;
+  case AST_FUNCTION_ARCCSCH:  compileChild(node, 0); emitOperation(OP_ARCCSCH, 1);   break;
+  case AST_FUNCTION_ARCSEC:   compileChild(node, 0); emitOperation(OP_ARCSEC, 1);    break;
+  case AST_FUNCTION_ARCSECH:  compileChild(node, 0); emitOperation(OP_ARCSECH, 1);   break;
+  case AST_FUNCTION_ARCSIN:   compileChild(node, 0); emitOperation(OP_ARCSIN, 1);    break;
+  case AST_FUNCTION_ARCSINH:  compileChild(node, 0); emitOperation(OP_ARCSINH, 1);   break;
+  case AST_FUNCTION_ARCTAN:   compileChild(node, 0); emitOperation(OP_ARCTAN, 1);    break;
+  case AST_FUNCTION_ARCTANH:  compileChild(node, 0); emitOperation(OP_ARCTANH, 1);   break;
+  case AST_FUNCTION_CEILING:  compileChild(node, 0); emitOperation(OP_CEILING, 1);   break;
+  case AST_FUNCTION_COS:      compileChild(node, 0); emitOperation(OP_COS, 1);       break;
+  case AST_FUNCTION_COSH:     compileChild(node, 0); emitOperation(OP_COSH, 1);      break;
+  case AST_FUNCTION_COT:      compileChild(node, 0); emitOperation(OP_COT, 1);       break;
+  case AST_FUNCTION_COTH:     compileChild(node, 0); emitOperation(OP_COTH, 1);      break;
+  case AST_FUNCTION_CSC:      compileChild(node, 0); emitOperation(OP_CSC, 1);       break;
+  case AST_FUNCTION_CSCH:     compileChild(node, 0); emitOperation(OP_CSCH, 1);      break;
+  case AST_FUNCTION_EXP:      compileChild(node, 0); emitOperation(OP_EXP, 1);       break;
+  case AST_FUNCTION_FACTORIAL:compileChild(node, 0); emitOperation(OP_FACTORIAL, 1); break;
+  case AST_FUNCTION_FLOOR:    compileChild(node, 0); emitOperation(OP_FLOOR, 1);     break;
+  case AST_FUNCTION_LN:       compileChild(node, 0); emitOperation(OP_LN, 1);        break;
+  case AST_FUNCTION_SEC:      compileChild(node, 0); emitOperation(OP_SEC, 1);       break;
+  case AST_FUNCTION_SECH:     compileChild(node, 0); emitOperation(OP_SECH, 1);      break;
+  case AST_FUNCTION_SIN:      compileChild(node, 0); emitOperation(OP_SIN, 1);       break;
+  case AST_FUNCTION_SINH:     compileChild(node, 0); emitOperation(OP_SINH, 1);      break;
+  case AST_FUNCTION_TAN:      compileChild(node, 0); emitOperation(OP_TAN, 1);       break;
+  case AST_FUNCTION_TANH:     compileChild(node, 0); emitOperation(OP_TANH, 1);      break;
+  case AST_LOGICAL_NOT:       compileChild(node, 0); emitOperation(OP_NOT, 1);       break;
+
+  case AST_FUNCTION_PIECEWISE:
+    for (unsigned int j = 0; j < numChildren; ++j)
+    {
+      compileChild(node, j);
+    }
+    emitOperation(OP_PIECEWISE, numChildren);
+    break;
+
+  case AST_LOGICAL_AND:
+  case AST_LOGICAL_OR:
+  case AST_LOGICAL_XOR:
+    if (numChildren == 0)
+    {
+      emit(OP_CONST, 0, (node->getType() == AST_LOGICAL_AND) ? 1.0 : 0.0);
+    }
+    else if (numChildren == 1)
+    {
+      compileChild(node, 0);
+    }
+    else
+    {
+      // only the first two arguments are considered
+      compileChild(node, 0);
+      compileChild(node, 1);
+      emitOperation(node->getType() == AST_LOGICAL_AND ? OP_AND :
+                    node->getType() == AST_LOGICAL_OR  ? OP_OR  : OP_XOR, 2);
+    }
+    break;
+
+  case AST_RELATIONAL_EQ:
+  case AST_RELATIONAL_GEQ:
+  case AST_RELATIONAL_GT:
+  case AST_RELATIONAL_LEQ:
+  case AST_RELATIONAL_LT:
+  case AST_RELATIONAL_NEQ:
+    if (numChildren < 2)
+    {
+      emit(OP_CONST, 0, 0.0);
+    }
+    else
+    {
+      Op op;
+      switch (node->getType())
+      {
+      case AST_RELATIONAL_EQ:  op = OP_EQ;  break;
+      case AST_RELATIONAL_GEQ: op = OP_GEQ; break;
+      case AST_RELATIONAL_GT:  op = OP_GT;  break;
+      case AST_RELATIONAL_LEQ: op = OP_LEQ; break;
+      case AST_RELATIONAL_LT:  op = OP_LT;  break;
+      default:                 op = OP_NEQ; break;
+      }
+      for (unsigned int j = 0; j < numChildren; ++j)
+      {
+        compileChild(node, j);
+      }
+      emitOperation(op, numChildren);
+    }
+    break;
+
+  default:
+    // types defined by packages are left to SBMLTransforms::evaluateASTNode;
+    // their plugins are loaded now so that evaluation does not modify
+    // the tree
+    bindVariables(node);
+    mSubtrees.push_back(node);
+    emit(OP_EVALUATE, (unsigned int)(mSubtrees.size() - 1));
+    break;
+  }
+}
+
+
+void
+CompiledMath::compileChild(const ASTNode* node, unsigned int n)
+{
+  compileNode(n < node->getNumChildren() ? node->getChild(n) : NULL);
+}
+
+
+void
+CompiledMath::emit(Op op, unsigned int arg, double value)
+{
+  Instruction instruction;
+  instruction.op    = op;
+  instruction.arg   = arg;
+  instruction.value = value;
+  mCode.push_back(instruction);
+
+  if (op == OP_CONST || op == OP_LOAD || op == OP_EVALUATE)
+  {
+    ++mDepth;
+    if (mDepth > mMaxDepth) mMaxDepth = mDepth;
+  }
+}
+
+
+/*
+ * Appends an operation taking its operands from the stack, folding it
+ * into a constant if all of its operands are constants.
+ */
+void
+CompiledMath::emitOperation(Op op, unsigned int numOperands)
+{
+  size_t size = mCode.size();
+  bool constant = (size >= numOperands);
+  for (size_t j = size - numOperands; constant && j < size; ++j)
+  {
+    constant = (mCode[j].op == OP_CONST);
+  }
+
+  if (constant)
+  {
+    vector<double> operands(numOperands + 1);
+    for (unsigned int j = 0; j < numOperands; ++j)
+    {
+      operands[j] = mCode[size - numOperands + j].value;
+    }
+    mCode.resize(size - numOperands);
+    mDepth -= numOperands;
+    emit(OP_CONST, 0, apply(op, numOperands, &operands[0]));
+    return;
+  }
+
+  Instruction instruction;
+  instruction.op    = op;
+  instruction.arg   = numOperands;
+  instruction.value = 0.0;
+  mCode.push_back(instruction);
+
+  mDepth = mDepth - numOperands + 1;
+}
+
+
+void
+CompiledMath::bindVariables(const ASTNode* node)
+{
+  if (node == NULL) return;
+
+  if (node->getNumPlugins() == 0)
+  {
+    const_cast<ASTNode*>(node)->loadASTPlugins(NULL);
+  }
+
+  if (node->getType() == AST_NAME && node->getName() != NULL)
+  {
+    bindVariable(node->getName());
+  }
+
+  for (unsigned int i = 0; i < node->getNumChildren(); ++i)
+  {
+    bindVariables(node->getChild(i));
+  }
+}
+
+
+unsigned int
+CompiledMath::bindVariable(const std::string& id)
+{
+  map<string, unsigned int>::const_iterator it = mVariableIndex.find(id);
+  if (it != mVariableIndex.end())
+  {
+    return it->second;
+  }
+
+  unsigned int n = (unsigned int)(mVariables.size());
+  mVariables.push_back(id);
+  mVariableIndex.insert(pair<string, unsigned int>(id, n));
+  return n;
+}
+
+
+double
+CompiledMath::execute(const double* values, double* stack) const
+{
+  unsigned int sp = 0;
+  const Instruction* code = &mCode[0];
+  const Instruction* end  = code + mCode.size();
+
+  for (; code != end; ++code)
+  {
+    switch (code->op)
+    {
+    case OP_CONST:
+      stack[sp++] = code->value;
+      break;
+
+    case OP_LOAD:
+      stack[sp++] = values[code->arg];
+      break;
+
+    case OP_EVALUATE:
+      stack[sp++] = evaluateSubtree(code->arg, values);
+      break;
+
+    case OP_ADD:
+      --sp;
+      stack[sp - 1] = stack[sp - 1] + stack[sp];
+      break;
+
+    case OP_SUBTRACT:
+      --sp;
+      stack[sp - 1] = stack[sp - 1] - stack[sp];
+      break;
+
+    case OP_MULTIPLY:
+      --sp;
+      stack[sp - 1] = stack[sp - 1] * stack[sp];
+      break;
+
+    case OP_DIVIDE:
+      --sp;
+      stack[sp - 1] = stack[sp - 1] / stack[sp];
+      break;
+
+    default:
+      sp -= code->arg;
+      stack[sp] = apply(code->op, code->arg, stack + sp);
+      ++sp;
+      break;
+    }
+  }
+
+  return stack[0];
+}
+
+
+double
+CompiledMath::evaluateSubtree(unsigned int n, const double* values) const
+{
+  SBMLTransforms::IdValueMap currentSet;
+  for (unsigned int i = 0; i < mVariables.size(); ++i)
+  {
+    currentSet.insert(pair<const string, SBMLTransforms::ValueSet>
+                      (mVariables[i], make_pair(values[i], false)));
+  }
+  return SBMLTransforms::evaluateASTNode(mSubtrees[n], currentSet);
+}
+
+
+/*
+ * Applies the operation to its operands, with the same arithmetic as
+ * SBMLTransforms::evaluateASTNode().
+ */
+double
+CompiledMath::apply(Op op, unsigned int numOperands, const double* operands)
+{
+  double result = 0;
+  double x = (numOperands > 0) ? operands[0] : 0.0;
+  int i;
+
+  switch (op)
+  {
+  case OP_NEGATE:
+    result = -x;
+    break;
+
+  case OP_ADD:
+    result = x + operands[1];
+    break;
+
+  case OP_SUBTRACT:
+    result = x - operands[1];
+    break;
+
+  case OP_MULTIPLY:
+    result = x * operands[1];
+    break;
+
+  case OP_DIVIDE:
+    result = x / operands[1];
+    break;
+
+  case OP_POWER:
+    result = pow(x, operands[1]);
+    break;
+
+  case OP_ROOT:
+    result = pow(operands[1], (1.0 / x));
+    break;
+
+  case OP_ABS:
+    result = (double)(fabs(x));
+    break;
+
+  case OP_ARCCOS:
+    result = acos(x);
+    break;
+
+  case OP_ARCCOSH:
+    /* arccosh(x) = ln(x + sqrt(x-1).sqrt(x+1)) */
+    result = log(x + pow((x - 1), 0.5) * pow((x + 1), 0.5));
+    break;
+
+  case OP_ARCCOT:
+    /* arccot x =  arctan (1 / x) */
+    result = atan(1.0 / x);
+    break;
+
+  case OP_ARCCOTH:
+    /* arccoth x = 1/2 * ln((x+1)/(x-1)) */
+    result = ((1.0 / 2.0) * log((x + 1.0) / (x - 1.0)));
+    break;
+
+  case OP_ARCCSC:
+    /* arccsc(x) = Arcsin(1 / x) */
+    result = asin(1.0 / x);
+    break;
+
+  case OP_ARCCSCH:
+    /* arccsch(x) = ln((1 + sqrt(1 + x^2)) / x) */
+    result = log((1.0 + pow(1.0 + pow(x, 2), 0.5)) / x);
+    break;
+
+  case OP_ARCSEC:
+    /* arcsec(x) = arccos(1/x) */
+    result = acos(1.0 / x);
+    break;
+
+  case OP_ARCSECH:
+    /* arcsech(x) = ln((1 + sqrt(1 - x^2)) / x) */
+    result = log((1.0 + pow((1.0 - pow(x, 2)), 0.5)) / x);
+    break;
+
+  case OP_ARCSIN:
+    result = asin(x);
+    break;
+
+  case OP_ARCSINH:
+    /* arcsinh(x) = ln(x + sqrt(1 + x^2)) */
+    result = log(x + pow((1.0 + pow(x, 2)), 0.5));
+    break;
+
+  case OP_ARCTAN:
+    result = atan(x);
+    break;
+
+  case OP_ARCTANH:
+    /* arctanh = 0.5 * ln((1+x)/(1-x)) */
+    result = 0.5 * log((1.0 + x) / (1.0 - x));
+    break;
+
+  case OP_CEILING:
+    result = ceil(x);
+    break;
+
+  case OP_COS:
+    result = cos(x);
+    break;
+
+  case OP_COSH:
+    result = cosh(x);
+    break;
+
+  case OP_COT:
+    /* cot x = 1 / tan x */
+    result = (1.0 / tan(x));
+    break;
+
+  case OP_COTH:
+    /* coth x = cosh x / sinh x */
+    result = cosh(x) / sinh(x);
+    break;
+
+  case OP_CSC:
+    /* csc x = 1 / sin x */
+    result = (1.0 / sin(x));
+    break;
+
+  case OP_CSCH:
+    /* csch x = 1 / sinh x  */
+    result = (1.0 / sinh(x));
+    break;
+
+  case OP_EXP:
+    result = exp(x);
+    break;
+
+  case OP_FACTORIAL:
+    i = (int)(floor(x));
+    result = 1;
+    for(; i>1; --i)
+    {
+      result *= i;
+    }
+    break;
+
+  case OP_FLOOR:
+    result = floor(x);
+    break;
+
+  case OP_LN:
+    result = log(x);
+    break;
+
+  case OP_LOG10:
+    result = log10(x);
+    break;
+
+  case OP_SEC:
+    /* sec x = 1 / cos x */
+    result = 1.0 / cos(x);
+    break;
+
+  case OP_SECH:
+    /* sech x = 1 / cosh x */
+    result = 1.0 / cosh(x);
+    break;
+
+  case OP_SIN:
+    result = sin(x);
+    break;
+
+  case OP_SINH:
+    result = sinh(x);
+    break;
+
+  case OP_TAN:
+    result = tan(x);
+    break;
+
+  case OP_TANH:
+    result = tanh(x);
+    break;
+
+  case OP_AND:
+    result = (double)(x && operands[1]);
+    break;
+
+  case OP_OR:
+    result = (double)(x || operands[1]);
+    break;
+
+  case OP_XOR:
+    result = (double)((!x && operands[1]) || (x && !operands[1]));
+    break;
+
+  case OP_NOT:
+    result = (double)(!x);
+    break;
+
+  case OP_EQ:
+  case OP_GEQ:
+  case OP_GT:
+  case OP_LEQ:
+  case OP_LT:
+  case OP_NEQ:
+    result = 1.0;
+    for (unsigned int j = 1; j < numOperands; ++j)
+    {
+      double a = operands[j - 1];
+      double b = operands[j];
+      switch (op)
+      {
+      case OP_EQ:  result *= (double)(a == b); break;
+      case OP_GEQ: result *= (double)(a >= b); break;
+      case OP_GT:  result *= (double)(a > b);  break;
+      case OP_LEQ: result *= (double)(a <= b); break;
+      case OP_LT:  result *= (double)(a < b);  break;
+      default:     result *= (double)(a != b); break;
+      }
+    }
+    break;
+
+  case OP_PIECEWISE:
+    {
+      // pieces come in (value, condition) pairs, optionally followed
+      // by an otherwise; two true pieces must agree
+      bool assigned = false;
+      unsigned int numPieces = numOperands - (numOperands % 2);
+      for (unsigned int j = 0; j < numPieces; j += 2)
+      {
+        if (operands[j + 1] == 1.0)
+        {
+          if (assigned == true)
+          {
+            if (operands[j] != result)
+            {
+              result = numeric_limits<double>::quiet_NaN();
+            }
+          }
+          else
+          {
+            result = operands[j];
+            assigned = true;
+          }
+        }
+      }
+      if (!assigned)
+      {
+        result = (numOperands % 2 == 0) ? numeric_limits<double>::quiet_NaN()
+                                         : operands[numOperands - 1];
+      }
+    }
+    break;
+
+  default:
+    result = numeric_limits<double>::quiet_NaN();
+    break;
+  }
+
+  return result;
+}
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_END
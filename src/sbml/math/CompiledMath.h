@@ -0,0 +1,330 @@
+/**
+ * @file    CompiledMath.h
+ * @brief   Definition of CompiledMath, a flat program evaluating an ASTNode.
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class CompiledMath
+ * @sbmlbrief{core} Math compiled for repeated numerical evaluation.
+ *
+ * @htmlinclude libsbml-facility-only-warning.html
+ *
+ * SBMLTransforms::evaluateASTNode() walks the ASTNode tree each time it is
+ * called, looking up every identifier by name and expanding any
+ * FunctionDefinitions it meets.  When the same expression is evaluated
+ * many times with different values, as in a parameter scan, this work is
+ * repeated on every call.
+ *
+ * A CompiledMath is built once from an ASTNode.  The FunctionDefinitions
+ * of the model (if one is given) are inlined, and the expression is
+ * translated into a flat program for a small stack machine.  Each
+ * identifier referenced by the math is bound to a variable slot, numbered
+ * in order of first appearance; callers supply the values for those slots
+ * as an array of doubles.
+ *
+ * The results are the same as those of SBMLTransforms::evaluateASTNode()
+ * given the same values, with two exceptions: identifiers are always read
+ * from the supplied values (the model is not consulted for rules), and the
+ * csymbol @c time always evaluates to zero.  Evaluation does not modify the
+ * object, so one CompiledMath may be evaluated from several threads at
+ * once.
+ *
+ * @see SBMLTransforms
+ */
+
+#ifndef CompiledMath_h
+#define CompiledMath_h
+
+
+#include <sbml/common/extern.h>
+#include <sbml/common/operationReturnValues.h>
+
+
+#ifdef __cplusplus
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class ASTNode;
+class Model;
+
+class LIBSBML_EXTERN CompiledMath
+{
+public:
+
+  /**
+   * Creates a new, empty CompiledMath.
+   *
+   * An empty CompiledMath has no variables and evaluates to NaN.
+   */
+  CompiledMath();
+
+
+  /**
+   * Creates a new CompiledMath from the given math.
+   *
+   * @param math the ASTNode to compile.
+   * @param m an optional Model whose FunctionDefinitions are to be inlined.
+   *
+   * @see compile(const ASTNode* math, const Model* m)
+   */
+  CompiledMath(const ASTNode* math, const Model* m = NULL);
+
+
+  /**
+   * Copy constructor; creates a copy of this CompiledMath.
+   *
+   * @param orig the object to copy.
+   */
+  CompiledMath(const CompiledMath& orig);
+
+
+  /**
+   * Assignment operator for CompiledMath.
+   *
+   * @param rhs the object whose values are used as the basis of the
+   * assignment.
+   */
+  CompiledMath& operator=(const CompiledMath& rhs);
+
+
+  /**
+   * Destroys this CompiledMath.
+   */
+  virtual ~CompiledMath();
+
+
+  /**
+   * Compiles the given math, replacing any program held by this object.
+   *
+   * The math is copied; the caller keeps ownership of @p math.  If @p m is
+   * given, calls to its FunctionDefinitions are expanded before the math
+   * is compiled.
+   *
+   * @param math the ASTNode to compile.
+   * @param m an optional Model whose FunctionDefinitions are to be inlined.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+   */
+  int compile(const ASTNode* math, const Model* m = NULL);
+
+
+  /**
+   * Predicate returning @c true if this object holds a compiled program.
+   *
+   * @return @c true if compile() has succeeded, @c false otherwise.
+   */
+  bool isCompiled() const;
+
+
+  /**
+   * Returns the number of variable slots of the compiled program.
+   *
+   * @return the number of distinct identifiers referenced by the math.
+   */
+  unsigned int getNumVariables() const;
+
+
+  /**
+   * Returns the identifier bound to the nth variable slot.
+   *
+   * @param n the index of the slot.
+   *
+   * @return the identifier, or an empty string if @p n is out of range.
+   */
+  const std::string& getVariable(unsigned int n) const;
+
+
+  /**
+   * Returns the slot bound to the given identifier.
+   *
+   * @param id the identifier to look for.
+   *
+   * @return the index of the slot, or @c -1 if the math does not refer to
+   * @p id.
+   */
+  int getVariableIndex(const std::string& id) const;
+
+
+  /**
+   * Fills @p values with the values the given model assigns to each
+   * variable slot, as SBMLTransforms::evaluateASTNode() would see them.
+   *
+   * @param m the Model to take the values from.
+   * @param values the vector to fill; it is resized to getNumVariables().
+   */
+  void getInitialValues(const Model* m, std::vector<double>& values) const;
+
+
+  /**
+   * Evaluates the compiled program.
+   *
+   * @param values an array of getNumVariables() values, one per slot.
+   *
+   * @return the value of the math, or NaN if nothing has been compiled.
+   */
+  double evaluate(const double* values) const;
+
+
+  /**
+   * Evaluates the compiled program.
+   *
+   * @param values the values, one per slot; missing values are read as NaN.
+   *
+   * @return the value of the math, or NaN if nothing has been compiled.
+   */
+  double evaluate(const std::vector<double>& values) const;
+
+
+  /**
+   * Evaluates the compiled program for a batch of value sets.
+   *
+   * @param values an array of @p numSets rows of getNumVariables() values
+   * each, stored one row after the other.
+   * @param numSets the number of value sets.
+   * @param results an array of @p numSets doubles receiving the results.
+   */
+  void evaluate(const double* values, unsigned int numSets,
+                double* results) const;
+
+
+  /** @cond doxygenLibsbmlInternal */
+
+  /*
+   * The operations of the stack machine.
+   */
+  enum Op
+  {
+    OP_CONST
+  , OP_LOAD
+  , OP_NEGATE
+  , OP_ADD
+  , OP_SUBTRACT
+  , OP_MULTIPLY
+  , OP_DIVIDE
+  , OP_POWER
+  , OP_ROOT
+  , OP_ABS
+  , OP_ARCCOS
+  , OP_ARCCOSH
+  , OP_ARCCOT
+  , OP_ARCCOTH
+  , OP_ARCCSC
+  , OP_ARCCSCH
+  , OP_ARCSEC
+  , OP_ARCSECH
+  , OP_ARCSIN
+  , OP_ARCSINH
+  , OP_ARCTAN
+  , OP_ARCTANH
+  , OP_CEILING
+  , OP_COS
+  , OP_COSH
+  , OP_COT
+  , OP_COTH
+  , OP_CSC
+  , OP_CSCH
+  , OP_EXP
+  , OP_FACTORIAL
+  , OP_FLOOR
+  , OP_LN
+  , OP_LOG10
+  , OP_SEC
+  , OP_SECH
+  , OP_SIN
+  , OP_SINH
+  , OP_TAN
+  , OP_TANH
+  , OP_AND
+  , OP_OR
+  , OP_XOR
+  , OP_NOT
+  , OP_EQ
+  , OP_GEQ
+  , OP_GT
+  , OP_LEQ
+  , OP_LT
+  , OP_NEQ
+  , OP_PIECEWISE
+  , OP_EVALUATE
+  };
+
+  /*
+   * A single instruction: the operation, an integer argument (the slot
+   * for OP_LOAD, the operand count for the n-ary operations, the index
+   * of the subtree for OP_EVALUATE) and a value (for OP_CONST).
+   */
+  struct Instruction
+  {
+    Op           op;
+    unsigned int arg;
+    double       value;
+  };
+
+  /** @endcond */
+
+
+protected:
+  /** @cond doxygenLibsbmlInternal */
+
+  void clear();
+
+  void compileNode(const ASTNode* node);
+
+  void compileChild(const ASTNode* node, unsigned int n);
+
+  void emit(Op op, unsigned int arg = 0, double value = 0.0);
+
+  void emitOperation(Op op, unsigned int numOperands);
+
+  void bindVariables(const ASTNode* node);
+
+  unsigned int bindVariable(const std::string& id);
+
+  double execute(const double* values, double* stack) const;
+
+  double evaluateSubtree(unsigned int n, const double* values) const;
+
+  static double apply(Op op, unsigned int numOperands, const double* operands);
+
+
+  ASTNode* mMath;
+
+  std::vector<Instruction> mCode;
+
+  std::vector<std::string> mVariables;
+
+  std::map<std::string, unsigned int> mVariableIndex;
+
+  std::vector<const ASTNode*> mSubtrees;
+
+  unsigned int mMaxDepth;
+
+  unsigned int mDepth;
+
+  /** @endcond */
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif /* __cplusplus */
+#endif /* !CompiledMath_h */
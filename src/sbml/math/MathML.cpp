@@ -1376,7 +1376,7 @@ writeCI (const ASTNode& node, XMLOutputStream& stream, SBMLNamespaces *sbmlns)
     }
 
 #endif
-    if (node.getDefinitionURL() != NULL)
+    if (node.isSetDefinitionURL())
     {
       stream.writeAttribute("definitionURL", 
                             node.getDefinitionURL()->getValue(0));
@@ -1563,12 +1563,10 @@ static void
 writeDouble (const double& value, XMLOutputStream& stream)
 {
 
-  ostringstream output;
-
-  output.precision(LIBSBML_DOUBLE_PRECISION);
-  output << value;
+  char buffer[XMLOutputStream::DOUBLE_BUFFER_SIZE];
+  XMLOutputStream::formatDouble(buffer, value);
 
-  string            value_string = output.str();
+  const string      value_string = buffer;
   string::size_type position     = value_string.find('e');
 
   if (position == string::npos)
@@ -1578,12 +1576,12 @@ writeDouble (const double& value, XMLOutputStream& stream)
   else
   {
     const string mantissa_string = value_string.substr(0, position);
-    const string exponent_string = value_string.substr(position + 1);
+    long exponent = strtol(value_string.c_str() + position + 1, NULL, 10);
 
-    double mantissa = strtod(mantissa_string.c_str(), 0);
-    long   exponent = strtol(exponent_string.c_str(), 0, 10);
+    ostringstream output;
+    output << exponent;
 
-    writeENotation(mantissa, exponent, stream);
+    writeENotation(mantissa_string, output.str(), stream);
   }
 }
 /** @endcond */
@@ -1600,12 +1598,10 @@ writeENotation (  const double&    mantissa
                 , XMLOutputStream& stream )
 {
 
-  ostringstream output;
-
-  output.precision(LIBSBML_DOUBLE_PRECISION);
-  output << mantissa;
+  char buffer[XMLOutputStream::DOUBLE_BUFFER_SIZE];
+  XMLOutputStream::formatDouble(buffer, mantissa);
 
-  const string      value_string = output.str();
+  const string      value_string = buffer;
   string::size_type position     = value_string.find('e');
 
   if (position != string::npos)
@@ -1614,7 +1610,7 @@ writeENotation (  const double&    mantissa
     exponent += strtol(exponent_string.c_str(), NULL, 10);
   }
 
-  output.str("");
+  ostringstream output;
   output << exponent;
 
   const string mantissa_string = value_string.substr(0, position);
@@ -1801,7 +1797,12 @@ writeLambda (const ASTNode& node, XMLOutputStream& stream, SBMLNamespaces *sbmln
   /* look for the case where the element is missing a body- 
    * not valid I know but it messes up roundtripping
    */
-  if (node.getChild(n)->isBvar() == true)
+  if (node.getNumChildren() == 0)
+  {
+    bvars = 0;
+    bodyPresent = false;
+  }
+  else if (node.getChild(n)->isBvar() == true)
   {
     bvars = bvars + 1;
     bodyPresent = false;
@@ -1974,7 +1975,7 @@ writeSemantics(const ASTNode& node, XMLOutputStream& stream, bool &inSemantics,
   inSemantics = true;
   stream.startElement("semantics");
   writeAttributes(node, stream);
-  if (node.getDefinitionURL())
+  if (node.isSetDefinitionURL())
     stream.writeAttribute("definitionURL", 
                             node.getDefinitionURL()->getValue(0));
   writeNode(node, stream, sbmlns);
@@ -1112,6 +1112,75 @@ START_TEST (test_ASTNode_deepCopy_5)
 END_TEST
 
 
+START_TEST (test_ASTNode_deepCopy_6)
+{
+  ASTNode_t *node = ASTNode_create();
+  ASTNode_t *copy;
+  char *s;
+  XMLAttributes_t *url;
+
+  ASTNode_setType(node, AST_REAL);
+  ASTNode_setReal(node, 1.6);
+  ASTNode_setId(node, "i");
+  ASTNode_setClass(node, "c");
+  ASTNode_setStyle(node, "s");
+  ASTNode_setUnits(node, "mole");
+  ASTNode_addSemanticsAnnotation(node, XMLNode_create());
+
+  /** deepCopy() **/
+  copy = ASTNode_deepCopy(node);
+
+  fail_unless( ASTNode_unsetClass(node) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( ASTNode_isSetClass(node) == 0 );
+
+  s = ASTNode_getId(copy);
+  fail_unless( !strcmp(s, "i") );
+  safe_free(s);
+  s = ASTNode_getClass(copy);
+  fail_unless( !strcmp(s, "c") );
+  safe_free(s);
+  s = ASTNode_getStyle(copy);
+  fail_unless( !strcmp(s, "s") );
+  safe_free(s);
+  s = ASTNode_getUnits(copy);
+  fail_unless( !strcmp(s, "mole") );
+  safe_free(s);
+  fail_unless( ASTNode_getNumSemanticsAnnotations(copy) == 1 );
+  fail_unless( ASTNode_getSemanticsAnnotation(copy, 1) == NULL );
+
+  ASTNode_free(node);
+  ASTNode_free(copy);
+
+  /** attributes are absent until they are set **/
+  node = ASTNode_create();
+  fail_unless( ASTNode_isSetId(node) == 0 );
+  fail_unless( ASTNode_getNumSemanticsAnnotations(node) == 0 );
+  fail_unless( ASTNode_getSemanticsAnnotation(node, 0) == NULL );
+  fail_unless( ASTNode_unsetId(node) == LIBSBML_OPERATION_SUCCESS );
+
+  s = ASTNode_getDefinitionURLString(node);
+  fail_unless( !strcmp(s, "") );
+  safe_free(s);
+  fail_unless( ASTNode_getDefinitionURL(node) != NULL );
+
+  /** the attributes outlive a change of type **/
+  ASTNode_setType(node, AST_NAME_TIME);
+  url = ASTNode_getDefinitionURL(node);
+  fail_unless( url != NULL );
+  fail_unless( XMLAttributes_getLength(url) == 1 );
+
+  ASTNode_setType(node, AST_PLUS);
+  fail_unless( ASTNode_getDefinitionURL(node) == url );
+  fail_unless( XMLAttributes_getLength(url) == 0 );
+  s = ASTNode_getDefinitionURLString(node);
+  fail_unless( !strcmp(s, "") );
+  safe_free(s);
+
+  ASTNode_free(node);
+}
+END_TEST
+
+
 START_TEST (test_ASTNode_getName)
 {
   ASTNode_t *n = ASTNode_create();
@@ -4307,6 +4376,42 @@ START_TEST (test_ASTNode_insertChild)
 END_TEST
 
 
+START_TEST (test_ASTNode_wideChildren)
+{
+  ASTNode_t *node = ASTNode_createWithType(AST_PLUS);
+  ASTNode_t *c;
+  unsigned int n;
+
+  for (n = 0; n < 1000; n++)
+  {
+    c = ASTNode_create();
+    ASTNode_setInteger(c, (long)n);
+    ASTNode_addChild(node, c);
+  }
+
+  fail_unless( ASTNode_getNumChildren(node) == 1000 );
+  fail_unless( ASTNode_getInteger(ASTNode_getChild(node, 999)) == 999 );
+  fail_unless( ASTNode_getChild(node, 1000) == NULL );
+  fail_unless( ASTNode_getInteger(ASTNode_getRightChild(node)) == 999 );
+
+  c = ASTNode_create();
+  ASTNode_setInteger(c, -1);
+  fail_unless( ASTNode_insertChild(node, 500, c) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( ASTNode_getInteger(ASTNode_getChild(node, 499)) == 499 );
+  fail_unless( ASTNode_getInteger(ASTNode_getChild(node, 500)) == -1 );
+  fail_unless( ASTNode_getInteger(ASTNode_getChild(node, 501)) == 500 );
+
+  c = ASTNode_getChild(node, 0);
+  fail_unless( ASTNode_removeChild(node, 0) == LIBSBML_OPERATION_SUCCESS );
+  ASTNode_free(c);
+  fail_unless( ASTNode_getNumChildren(node) == 1000 );
+  fail_unless( ASTNode_getInteger(ASTNode_getLeftChild(node)) == 1 );
+
+  ASTNode_free(node);
+}
+END_TEST
+
+
 START_TEST (test_ASTNode_swapChildren)
 {
   ASTNode_t *node = ASTNode_create();
@@ -5337,6 +5442,7 @@ create_suite_ASTNode (void)
   tcase_add_test( tcase, test_ASTNode_deepCopy_3              );
   tcase_add_test( tcase, test_ASTNode_deepCopy_4              );
   tcase_add_test( tcase, test_ASTNode_deepCopy_5              );
+  tcase_add_test( tcase, test_ASTNode_deepCopy_6              );
   tcase_add_test( tcase, test_ASTNode_getName                 );
   tcase_add_test( tcase, test_ASTNode_getReal                 );
   tcase_add_test( tcase, test_ASTNode_getPrecedence           );
@@ -5402,6 +5508,7 @@ create_suite_ASTNode (void)
   tcase_add_test( tcase, test_ASTNode_removeChild             );
   tcase_add_test( tcase, test_ASTNode_replaceChild            );
   tcase_add_test( tcase, test_ASTNode_insertChild             );
+  tcase_add_test( tcase, test_ASTNode_wideChildren             );
   tcase_add_test( tcase, test_ASTNode_swapChildren            );
   tcase_add_test( tcase, test_ASTNode_addChild1               );
   tcase_add_test( tcase, test_ASTNode_prependChild1           );
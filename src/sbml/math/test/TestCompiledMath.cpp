@@ -0,0 +1,327 @@
+/**
+ * \file    TestCompiledMath.cpp
+ * \brief   Test the CompiledMath evaluator
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <limits>
+#include <vector>
+
+#include <sbml/math/CompiledMath.h>
+#include <sbml/math/L3Parser.h>
+#include <sbml/math/ASTNode.h>
+#include <sbml/SBMLTransforms.h>
+#include <sbml/SBMLTypes.h>
+#include <sbml/util/util.h>
+
+#include <check.h>
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+/** @endcond */
+
+CK_CPPSTART
+
+
+static bool
+sameValue(double a, double b)
+{
+  return (util_isNaN(a) && util_isNaN(b)) || a == b;
+}
+
+
+/*
+ * Compiles the formula and checks that it evaluates as evaluateASTNode
+ * does, with a = 1.5, b = 2.5 and c = 0.5.
+ */
+static bool
+evaluatesAsTransforms(const char* formula)
+{
+  ASTNode* math = SBML_parseL3Formula(formula);
+  if (math == NULL) return false;
+
+  map<string, double> values;
+  values["a"] = 1.5;
+  values["b"] = 2.5;
+  values["c"] = 0.5;
+
+  CompiledMath compiled(math);
+  vector<double> slots;
+  for (unsigned int i = 0; i < compiled.getNumVariables(); ++i)
+  {
+    slots.push_back(values[compiled.getVariable(i)]);
+  }
+
+  double expected = SBMLTransforms::evaluateASTNode(math, values);
+  double result = compiled.evaluate(slots);
+  delete math;
+
+  return sameValue(expected, result);
+}
+
+
+START_TEST (test_CompiledMath_variables)
+{
+  ASTNode* math = SBML_parseL3Formula("b * (a + b) - c");
+  CompiledMath compiled(math);
+  delete math;
+
+  fail_unless( compiled.isCompiled() );
+  fail_unless( compiled.getNumVariables() == 3 );
+  fail_unless( compiled.getVariable(0) == "b" );
+  fail_unless( compiled.getVariable(1) == "a" );
+  fail_unless( compiled.getVariable(2) == "c" );
+  fail_unless( compiled.getVariable(3) == "" );
+  fail_unless( compiled.getVariableIndex("a") == 1 );
+  fail_unless( compiled.getVariableIndex("d") == -1 );
+
+  double values[] = { 2.0, 1.0, 0.5 };
+  fail_unless( compiled.evaluate(values) == 5.5 );
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_null)
+{
+  CompiledMath compiled;
+
+  fail_unless( !compiled.isCompiled() );
+  fail_unless( util_isNaN(compiled.evaluate(NULL)) );
+  fail_unless( compiled.compile(NULL) == LIBSBML_INVALID_OBJECT );
+  fail_unless( compiled.getNumVariables() == 0 );
+
+  ASTNode* math = SBML_parseL3Formula("2 * 3");
+  fail_unless( compiled.compile(math) == LIBSBML_OPERATION_SUCCESS );
+  delete math;
+
+  fail_unless( compiled.evaluate(NULL) == 6.0 );
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_operators)
+{
+  fail_unless( evaluatesAsTransforms("a + b * c") );
+  fail_unless( evaluatesAsTransforms("a - b - c") );
+  fail_unless( evaluatesAsTransforms("-a") );
+  fail_unless( evaluatesAsTransforms("a / b / c") );
+  fail_unless( evaluatesAsTransforms("a ^ b") );
+  fail_unless( evaluatesAsTransforms("pow(b, c)") );
+  fail_unless( evaluatesAsTransforms("a % b") );
+  fail_unless( evaluatesAsTransforms("plus()") );
+  fail_unless( evaluatesAsTransforms("times()") );
+  fail_unless( evaluatesAsTransforms("times(b)") );
+  fail_unless( evaluatesAsTransforms("2 * 3 + 4 / 8") );
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_functions)
+{
+  fail_unless( evaluatesAsTransforms("abs(-a)") );
+  fail_unless( evaluatesAsTransforms("sqrt(b)") );
+  fail_unless( evaluatesAsTransforms("root(3, b)") );
+  fail_unless( evaluatesAsTransforms("ln(b)") );
+  fail_unless( evaluatesAsTransforms("log(b)") );
+  fail_unless( evaluatesAsTransforms("log(2, b)") );
+  fail_unless( evaluatesAsTransforms("exp(a) + floor(b) + ceil(c)") );
+  fail_unless( evaluatesAsTransforms("factorial(b + 2)") );
+  fail_unless( evaluatesAsTransforms("sin(a) + cos(b) + tan(c)") );
+  fail_unless( evaluatesAsTransforms("sec(a) + csc(b) + cot(c)") );
+  fail_unless( evaluatesAsTransforms("sinh(a) + cosh(b) + tanh(c)") );
+  fail_unless( evaluatesAsTransforms("sech(a) + csch(b) + coth(c)") );
+  fail_unless( evaluatesAsTransforms("arcsin(c) + arccos(c) + arctan(b)") );
+  fail_unless( evaluatesAsTransforms("arcsec(b) + arccsc(b) + arccot(b)") );
+  fail_unless( evaluatesAsTransforms("arcsinh(a) + arccosh(b) + arctanh(c)") );
+  fail_unless( evaluatesAsTransforms("arcsech(c) + arccsch(b) + arccoth(b)") );
+  fail_unless( evaluatesAsTransforms("arccosh(c)") );
+  fail_unless( evaluatesAsTransforms("pi * exponentiale + avogadro") );
+  fail_unless( evaluatesAsTransforms("delay(a, b)") );
+  fail_unless( evaluatesAsTransforms("f(a, b)") );
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_logical)
+{
+  fail_unless( evaluatesAsTransforms("a && c") );
+  fail_unless( evaluatesAsTransforms("a && 0") );
+  fail_unless( evaluatesAsTransforms("and()") );
+  fail_unless( evaluatesAsTransforms("or()") );
+  fail_unless( evaluatesAsTransforms("and(a)") );
+  fail_unless( evaluatesAsTransforms("0 || b") );
+  fail_unless( evaluatesAsTransforms("xor(a, 0)") );
+  fail_unless( evaluatesAsTransforms("xor(a, b)") );
+  fail_unless( evaluatesAsTransforms("!a") );
+  fail_unless( evaluatesAsTransforms("true && !false") );
+  fail_unless( evaluatesAsTransforms("c < a < b") );
+  fail_unless( evaluatesAsTransforms("b < a < c") );
+  fail_unless( evaluatesAsTransforms("a >= c") );
+  fail_unless( evaluatesAsTransforms("a > b") );
+  fail_unless( evaluatesAsTransforms("a <= a") );
+  fail_unless( evaluatesAsTransforms("eq(a, a, a)") );
+  fail_unless( evaluatesAsTransforms("neq(a, b)") );
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_piecewise)
+{
+  fail_unless( evaluatesAsTransforms("piecewise(a, b > c, c)") );
+  fail_unless( evaluatesAsTransforms("piecewise(a, b < c, c)") );
+  fail_unless( evaluatesAsTransforms("piecewise(a, b < c)") );
+  fail_unless( evaluatesAsTransforms("piecewise(a, b > c, a, true)") );
+  fail_unless( evaluatesAsTransforms("piecewise(a, b > c, b, true)") );
+  fail_unless( evaluatesAsTransforms("piecewise(a, b > c, b, true, c)") );
+  fail_unless( evaluatesAsTransforms("piecewise(c)") );
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_package)
+{
+  fail_unless( evaluatesAsTransforms("rem(b, a) + quotient(b, c)") );
+  fail_unless( evaluatesAsTransforms("max(a, b, c) - min(a, b, c)") );
+  fail_unless( evaluatesAsTransforms("implies(a, c)") );
+  fail_unless( evaluatesAsTransforms("a * rateOf(b)") );
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_functionDefinitions)
+{
+  SBMLDocument doc(3, 1);
+  Model* m = doc.createModel();
+
+  FunctionDefinition* fd = m->createFunctionDefinition();
+  fd->setId("f");
+  ASTNode* lambda = SBML_parseL3Formula("lambda(x, y, x * y + g(x))");
+  fd->setMath(lambda);
+  delete lambda;
+
+  fd = m->createFunctionDefinition();
+  fd->setId("g");
+  lambda = SBML_parseL3Formula("lambda(x, 2 * x)");
+  fd->setMath(lambda);
+  delete lambda;
+
+  Parameter* p = m->createParameter();
+  p->setId("a");
+  p->setValue(3.0);
+  p = m->createParameter();
+  p->setId("b");
+  p->setValue(4.0);
+
+  ASTNode* math = SBML_parseL3Formula("f(a, b) - g(b)");
+  CompiledMath compiled(math, m);
+
+  fail_unless( compiled.getNumVariables() == 2 );
+  fail_unless( compiled.getVariableIndex("x") == -1 );
+  fail_unless( compiled.getVariableIndex("y") == -1 );
+
+  vector<double> values;
+  compiled.getInitialValues(m, values);
+  fail_unless( values.size() == 2 );
+  fail_unless( values[compiled.getVariableIndex("a")] == 3.0 );
+  fail_unless( values[compiled.getVariableIndex("b")] == 4.0 );
+
+  fail_unless( compiled.evaluate(values) == 10.0 );
+  fail_unless( compiled.evaluate(values) ==
+               SBMLTransforms::evaluateASTNode(math, m) );
+
+  // without the model the calls cannot be resolved
+  CompiledMath unresolved(math);
+  fail_unless( util_isNaN(unresolved.evaluate(values)) );
+
+  CompiledMath copy(compiled);
+  fail_unless( copy.evaluate(values) == 10.0 );
+  unresolved = compiled;
+  fail_unless( unresolved.evaluate(values) == 10.0 );
+
+  delete math;
+}
+END_TEST
+
+
+START_TEST (test_CompiledMath_batch)
+{
+  ASTNode* math = SBML_parseL3Formula("piecewise(x * y, x > y, x + y)");
+  CompiledMath compiled(math);
+  delete math;
+
+  double values[] = { 1.0, 2.0,
+                      3.0, 2.0,
+                      5.0, 0.5 };
+  double results[3];
+  compiled.evaluate(values, 3, results);
+
+  fail_unless( results[0] == 3.0 );
+  fail_unless( results[1] == 6.0 );
+  fail_unless( results[2] == 2.5 );
+
+  vector<double> missing(1, 1.0);
+  fail_unless( util_isNaN(compiled.evaluate(missing)) );
+}
+END_TEST
+
+
+Suite *
+create_suite_TestCompiledMath ()
+{
+  Suite *suite = suite_create("TestCompiledMath");
+  TCase *tcase = tcase_create("TestCompiledMath");
+
+  tcase_add_test( tcase, test_CompiledMath_variables           );
+  tcase_add_test( tcase, test_CompiledMath_null                );
+  tcase_add_test( tcase, test_CompiledMath_operators           );
+  tcase_add_test( tcase, test_CompiledMath_functions           );
+  tcase_add_test( tcase, test_CompiledMath_logical             );
+  tcase_add_test( tcase, test_CompiledMath_piecewise           );
+  tcase_add_test( tcase, test_CompiledMath_package             );
+  tcase_add_test( tcase, test_CompiledMath_functionDefinitions );
+  tcase_add_test( tcase, test_CompiledMath_batch               );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+CK_CPPEND
@@ -43,10 +43,17 @@
 #include <sbml/util/util.h>
 #include <sbml/math/L3Parser.h>
 #include <sbml/math/L3ParserSettings.h>
+#include <sbml/math/L3FormulaFormatter.h>
 #include <sbml/Model.h>
 
 #include <check.h>
 
+#ifdef LIBSBML_USE_THREADS
+#include <thread>
+#include <vector>
+#include <string>
+#endif
+
 #if __cplusplus
 LIBSBML_CPP_NAMESPACE_USE
 CK_CPPSTART
@@ -3758,6 +3765,60 @@ START_TEST(test_SBML_parseL3Formula_named_lambda_arguments7)
 END_TEST
 
 
+#ifdef LIBSBML_USE_THREADS
+/*
+ * Parses formulas, some of them wrong, while other threads do the same,
+ * and counts the results and errors that are not the expected ones.
+ */
+static void
+parseFormulas(unsigned int numFormulas, unsigned int* failures)
+{
+  for (unsigned int n = 0; n < numFormulas; ++n)
+  {
+    ASTNode_t *r = SBML_parseL3Formula("k * S1 / (Km + S1^2) - sin(time)");
+    char *formula = SBML_formulaToL3String(r);
+    if (strcmp(formula, "k * S1 / (Km + S1^2) - sin(time)") != 0) ++(*failures);
+    safe_free(formula);
+    ASTNode_free(r);
+
+    r = SBML_parseL3Formula("3 + ");
+    char *error = SBML_getLastParseL3Error();
+    if (r != NULL ||
+        strcmp(error, "Error when parsing input '3 + ' at position 4:  "
+                      "syntax error, unexpected end of string") != 0)
+    {
+      ++(*failures);
+    }
+    safe_free(error);
+  }
+}
+
+
+START_TEST (test_SBML_parseL3Formula_threads)
+{
+  const unsigned int numThreads = 8;
+  const unsigned int numFormulas = 200;
+
+  std::vector<unsigned int> failures(numThreads, 0);
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    threads.push_back(std::thread(parseFormulas, numFormulas, &failures[t]));
+  }
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    threads[t].join();
+  }
+
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    fail_unless(failures[t] == 0);
+  }
+}
+END_TEST
+#endif
+
+
 Suite *
 create_suite_L3FormulaParser (void) 
 { 
@@ -3888,6 +3949,9 @@ create_suite_L3FormulaParser (void)
   tcase_add_test(tcase, test_SBML_parseL3Formula_named_lambda_arguments5);
   tcase_add_test(tcase, test_SBML_parseL3Formula_named_lambda_arguments6);
   tcase_add_test(tcase, test_SBML_parseL3Formula_named_lambda_arguments7);
+#ifdef LIBSBML_USE_THREADS
+  tcase_add_test(tcase, test_SBML_parseL3Formula_threads);
+#endif
 
 
   suite_add_tcase(suite, tcase);
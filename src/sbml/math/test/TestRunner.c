@@ -80,6 +80,7 @@ Suite *create_suite_TestValidASTNode      (void);
 
 Suite *create_suite_TestChildFunctions    (void);
 Suite *create_suite_TestGetValue          (void);
+Suite *create_suite_TestCompiledMath      (void);
 Suite *create_suite_TestReadFromFileL3V2(void);
 
 /**
@@ -146,6 +147,7 @@ main (void)
 
   srunner_add_suite( runner, create_suite_TestChildFunctions() );
   srunner_add_suite( runner, create_suite_TestGetValue() );
+  srunner_add_suite( runner, create_suite_TestCompiledMath() );
 
   srunner_add_suite(runner, create_suite_TestReadFromFileL3V2());
 
@@ -54,6 +54,11 @@
 #include <sbml/xml/XMLToken.h>
 #include <sbml/xml/XMLNode.h>
 
+#ifdef LIBSBML_USE_THREADS
+#include <thread>
+#include <vector>
+#endif
+
 /** @cond doxygenIgnored */
 
 using namespace std;
@@ -776,6 +781,21 @@ START_TEST (test_MathMLFormatter_lambda_no_bvars)
 END_TEST
 
 
+START_TEST (test_MathMLFormatter_lambda_empty)
+{
+  const char* expected = wrapMathML
+  (
+    "  <lambda/>\n"
+  );
+
+  N = new ASTNode(AST_LAMBDA);
+  S = writeMathMLToString(N);
+
+  fail_unless( equals(expected, S) );
+}
+END_TEST
+
+
 START_TEST (test_MathMLFormatter_piecewise)
 {
   const char* expected = wrapMathML
@@ -1124,6 +1144,64 @@ START_TEST (test_MathMLFormatter_ci_style)
 END_TEST
 
 
+#ifdef LIBSBML_USE_THREADS
+/*
+ * Writes the same math as the other threads, and reads the definitionURL
+ * attributes of its nodes, which are created on first use.
+ */
+static void
+writeSharedMath(const ASTNode* math, const char* expected,
+                std::vector<const XMLAttributes*>* urls, unsigned int* failures)
+{
+  for (unsigned int n = 0; n < 100; ++n)
+  {
+    char* written = writeMathMLToString(math);
+    if (strcmp(expected, written) != 0) ++(*failures);
+    free(written);
+  }
+
+  for (unsigned int c = 0; c < math->getNumChildren(); ++c)
+  {
+    urls->push_back(math->getChild(c)->getDefinitionURL());
+  }
+}
+
+
+START_TEST (test_MathMLFormatter_threads)
+{
+  const unsigned int numThreads = 8;
+
+  N = SBML_parseL3Formula("k * S1 / (Km + S1) * time");
+  S = writeMathMLToString(N);
+
+  std::vector< std::vector<const XMLAttributes*> > urls(numThreads);
+  std::vector<unsigned int> failures(numThreads, 0);
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    threads.push_back(std::thread(writeSharedMath, N, S, &urls[t],
+                                  &failures[t]));
+  }
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    threads[t].join();
+  }
+
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    fail_unless( failures[t] == 0 );
+    fail_unless( urls[t].size() == N->getNumChildren() );
+    for (unsigned int c = 0; c < N->getNumChildren(); ++c)
+    {
+      fail_unless( urls[t][c] != NULL );
+      fail_unless( urls[t][c] == N->getChild(c)->getDefinitionURL() );
+    }
+  }
+}
+END_TEST
+#endif
+
+
 Suite *
 create_suite_WriteMathML ()
 {
@@ -1171,6 +1249,7 @@ create_suite_WriteMathML ()
   tcase_add_test( tcase, test_MathMLFormatter_root                  );
   tcase_add_test( tcase, test_MathMLFormatter_lambda                );
   tcase_add_test( tcase, test_MathMLFormatter_lambda_no_bvars       );
+  tcase_add_test( tcase, test_MathMLFormatter_lambda_empty         );
   tcase_add_test( tcase, test_MathMLFormatter_piecewise             );
   tcase_add_test( tcase, test_MathMLFormatter_piecewise_otherwise   );
 
@@ -1190,6 +1269,9 @@ create_suite_WriteMathML ()
   tcase_add_test( tcase, test_MathMLFormatter_ci_id                    );
   tcase_add_test( tcase, test_MathMLFormatter_ci_class                 );
   tcase_add_test( tcase, test_MathMLFormatter_ci_style                 );
+#ifdef LIBSBML_USE_THREADS
+  tcase_add_test( tcase, test_MathMLFormatter_threads                  );
+#endif
 
   suite_add_tcase(suite, tcase);
 
@@ -175,6 +175,7 @@ ArraysSBMLDocumentPlugin::checkConsistency()
   if (id)
   {
     id_validator.init();
+    id_validator.setProfile(doc->getValidationProfile(), "ArraysIdentifierConsistencyValidator");
     nerrors = id_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0)
@@ -190,6 +191,7 @@ ArraysSBMLDocumentPlugin::checkConsistency()
   if (core)
   {
     core_validator.init();
+    core_validator.setProfile(doc->getValidationProfile(), "ArraysConsistencyValidator");
     nerrors = core_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0)
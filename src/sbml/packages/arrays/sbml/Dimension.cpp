@@ -221,7 +221,9 @@ Dimension::isSetArrayDimension() const
 int
 Dimension::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -273,6 +275,7 @@ int
 Dimension::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -355,6 +358,16 @@ Dimension::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+Dimension::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetSize() && getRenamedId(mSize, renamed, newid))
+  {
+    setSize(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this Dimension object.
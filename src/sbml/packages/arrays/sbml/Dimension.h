@@ -319,6 +319,12 @@ public:
                              const std::string& newid);
 
 
+  /**
+   * @copydoc doc_renamesidrefmap_common
+   */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
   /**
    * Returns the XML element name of this Dimension object.
    *
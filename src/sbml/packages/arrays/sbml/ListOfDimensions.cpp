@@ -191,6 +191,7 @@ ListOfDimensions::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <Dimension*> (item);
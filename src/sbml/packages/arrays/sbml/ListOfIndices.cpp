@@ -188,6 +188,7 @@ ListOfIndices::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <Index*> (item);
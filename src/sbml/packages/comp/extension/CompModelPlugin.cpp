@@ -34,15 +34,19 @@
  *------------------------------------------------------------------------- -->
  */
 
+#include <algorithm>
 #include <ostream>
 #include <iostream>
 #include <vector>
 #include <set>
+#include <map>
 
 #include <sbml/common/libsbml-version.h>
 #include <sbml/packages/comp/common/compfwd.h>
 #include <sbml/packages/comp/extension/CompModelPlugin.h>
 #include <sbml/packages/comp/extension/CompExtension.h>
+#include <sbml/packages/comp/extension/CompSBMLDocumentPlugin.h>
+#include <sbml/packages/comp/util/InstantiationCache.h>
 #include <sbml/packages/comp/validator/CompSBMLError.h>
 #include <sbml/Model.h>
 
@@ -53,6 +57,13 @@
 #include <sbml/packages/fbc/extension/FbcModelPlugin.h>
 #endif // LIBSBML_HAS_PACKAGE_FBC
 
+#ifdef LIBSBML_USE_THREADS
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <thread>
+#endif
+
 
 using namespace std;
 
@@ -66,6 +77,8 @@ CompModelPlugin::CompModelPlugin (const std::string &uri, const std::string &pre
   , mDivider("__")
   , mRemoved()
   , mTransformer(NULL)
+  , mNumFlatteningThreads(1)
+  , mInstantiationCache(NULL)
 {
   connectToChild();
 }
@@ -78,6 +91,8 @@ CompModelPlugin::CompModelPlugin(const CompModelPlugin& orig)
   , mDivider("__")
   , mRemoved() //If we're making a copy, the list of things we've removed is new.
   , mTransformer(orig.mTransformer)
+  , mNumFlatteningThreads(orig.mNumFlatteningThreads)
+  , mInstantiationCache(NULL) //The cache is only for the model it was set on.
 {
   connectToChild();
 }
@@ -98,6 +113,7 @@ CompModelPlugin::operator=(const CompModelPlugin& orig)
     mDivider = orig.mDivider;
     mRemoved.clear(); //If we're making a copy, the list of things we've removed is new.
     mTransformer = orig.mTransformer;
+    mNumFlatteningThreads = orig.mNumFlatteningThreads;
     connectToChild();
   }
   return *this;
@@ -536,6 +552,12 @@ Model* CompModelPlugin::flattenModel() const
   CompModelPlugin* flatplug = 
     static_cast<CompModelPlugin*>(flat->getPlugin(getPrefix()));
 
+  //Each definition is instantiated once, and the other submodels that
+  //refer to it copy that instance.
+  InstantiationCache cache;
+  flatplug->setInstantiationCache(mInstantiationCache != NULL ?
+                                  mInstantiationCache : &cache);
+
   // Now instantiate its submodels and 
   // follow all renaming/deletion/replacement rules.
   vector<const Model*> submods;
@@ -638,8 +660,9 @@ Model* CompModelPlugin::flattenModel() const
 
 
 
-  //Finally, unset the document again.
+  //Finally, unset the document and the cache again.
   flat->setSBMLDocument(NULL);
+  flatplug->setInstantiationCache(NULL);
 
   return flat;
 }
@@ -712,6 +735,158 @@ CompModelPlugin::appendFrom(const Model* model)
   return LIBSBML_OPERATION_SUCCESS;
 }
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Returns true if all the submodels of the given model, and all those
+ * below them, can be instantiated from the models of the document without
+ * an error: each must have an id and a modelRef, the modelRef must name a
+ * Model or ModelDefinition (not an ExternalModelDefinition) with the
+ * 'comp' package enabled, and no model may be instantiated inside itself.
+ * 'visited' holds the modelRefs looked at so far, and whether all the
+ * submodels below them have been checked yet; one that has not, met again
+ * on the way down, is a model instantiated inside itself.
+ */
+static bool
+instantiatesLocally(const CompModelPlugin* plugin,
+                    CompSBMLDocumentPlugin* docplugin,
+                    map<string, bool>& visited)
+{
+  for (unsigned int sm=0; sm<plugin->getNumSubmodels(); sm++)
+  {
+    const Submodel* submodel = plugin->getSubmodel(sm);
+    if (!submodel->hasRequiredAttributes())
+    {
+      return false;
+    }
+
+    const string& modelRef = submodel->getModelRef();
+    map<string, bool>::const_iterator it = visited.find(modelRef);
+    if (it != visited.end())
+    {
+      if (it->second == false) return false;
+      continue;
+    }
+
+    const SBase* origmodel = docplugin->getModel(modelRef);
+    if (origmodel == NULL ||
+        (origmodel->getTypeCode() != SBML_MODEL &&
+         origmodel->getTypeCode() != SBML_COMP_MODELDEFINITION) ||
+        !origmodel->isPackageURIEnabled(submodel->getPackageURI()))
+    {
+      return false;
+    }
+
+    visited[modelRef] = false;
+    const CompModelPlugin* origplugin = static_cast<const CompModelPlugin*>
+      (origmodel->getPlugin(plugin->getPrefix()));
+    if (origplugin != NULL &&
+        !instantiatesLocally(origplugin, docplugin, visited))
+    {
+      return false;
+    }
+    visited[modelRef] = true;
+  }
+  return true;
+}
+
+
+/*
+ * Returns true if all the submodels of the given model, and all those
+ * below them, are instantiated.
+ */
+static bool
+isInstantiated(const CompModelPlugin* plugin)
+{
+  for (unsigned int sm=0; sm<plugin->getNumSubmodels(); sm++)
+  {
+    const Model* inst = plugin->getSubmodel(sm)->getInstantiation();
+    if (inst == NULL)
+    {
+      return false;
+    }
+    const CompModelPlugin* instplugin =
+      static_cast<const CompModelPlugin*>(inst->getPlugin(plugin->getPrefix()));
+    if (instplugin != NULL && !isInstantiated(instplugin))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+#ifdef LIBSBML_USE_THREADS
+/*
+ * The body of each thread started by forEachSubmodel(): it keeps taking
+ * the next submodel nobody has started on yet.  An exception thrown for a
+ * submodel is kept, to be thrown again on the calling thread.
+ */
+static void
+processFromQueue(const std::function<int(unsigned int)>* process,
+                 unsigned int numSubmodels,
+                 std::atomic<unsigned int>* next,
+                 std::vector<int>* results,
+                 std::vector<std::exception_ptr>* exceptions)
+{
+  unsigned int n;
+  while ((n = (*next)++) < numSubmodels)
+  {
+    try
+    {
+      (*results)[n] = (*process)(n);
+    }
+    catch (...)
+    {
+      (*exceptions)[n] = std::current_exception();
+    }
+  }
+}
+
+
+/*
+ * Calls process(n) for each of the first 'numSubmodels' submodels, on up
+ * to 'numThreads' threads.  Returns the first result, in the order of the
+ * submodels, that is not LIBSBML_OPERATION_SUCCESS, or throws again the
+ * first exception thrown.
+ */
+static int
+forEachSubmodel(unsigned int numSubmodels, unsigned int numThreads,
+                const std::function<int(unsigned int)>& process)
+{
+  unsigned int numWorkers = std::min(numThreads, numSubmodels);
+  std::atomic<unsigned int> next(0);
+  std::vector<int> results(numSubmodels, LIBSBML_OPERATION_SUCCESS);
+  std::vector<std::exception_ptr> exceptions(numSubmodels);
+
+  std::vector<std::thread> threads;
+  for (unsigned int t = 1; t < numWorkers; ++t)
+  {
+    threads.push_back(std::thread(processFromQueue, &process, numSubmodels,
+                                  &next, &results, &exceptions));
+  }
+  processFromQueue(&process, numSubmodels, &next, &results, &exceptions);
+  for (size_t t = 0; t < threads.size(); ++t)
+  {
+    threads[t].join();
+  }
+
+  for (unsigned int n = 0; n < numSubmodels; ++n)
+  {
+    if (exceptions[n])
+    {
+      std::rethrow_exception(exceptions[n]);
+    }
+    if (results[n] != LIBSBML_OPERATION_SUCCESS)
+    {
+      return results[n];
+    }
+  }
+  return LIBSBML_OPERATION_SUCCESS;
+}
+#endif
+/** @endcond */
+
+
 /*
  * Loop through all Submodels in this Model, instantiate all of them, 
  * perform all deletions, and synchronize all replacements.  
@@ -728,6 +903,17 @@ CompModelPlugin::instantiateSubmodels()
   
   int ret;
 
+  // With several threads to use, the submodels are instantiated at the
+  // same time first, and the loop below only finds the instances.
+  bool concurrently = canInstantiateConcurrently();
+  if (concurrently)
+  {
+    ret = instantiateConcurrently();
+    if (ret != LIBSBML_OPERATION_SUCCESS) {
+      return ret;
+    }
+  }
+
   // First we instantiate all the submodels.  
   // This acts recursively downward through the stack.
   for (unsigned int sub=0; sub<mListOfSubmodels.size(); sub++) 
@@ -776,7 +962,13 @@ CompModelPlugin::instantiateSubmodels()
   }
 
   //Next, we rename *all* the elements so everything is unique.
-  ret = renameAllIDsAndPrepend("");
+  //Deletions may have removed instances, which renaming would then make
+  // again, so this is only done on several threads if none is missing.
+  unsigned int numThreads = 1;
+  if (concurrently && isInstantiated(this)) {
+    numThreads = mNumFlatteningThreads;
+  }
+  ret = renameAllIDsAndPrepend("", numThreads);
   if (ret != LIBSBML_OPERATION_SUCCESS) {
     return ret;
   }
@@ -800,6 +992,81 @@ CompModelPlugin::instantiateSubmodels()
   return LIBSBML_OPERATION_SUCCESS;
 }
 
+/** @cond doxygenLibsbmlInternal */
+bool
+CompModelPlugin::canInstantiateConcurrently()
+{
+#ifdef LIBSBML_USE_THREADS
+  // Nothing may be read from other files, no error may be logged and
+  // nothing outside the new instances may be changed while the threads
+  // run, so there must be no custom transformer and no element id index
+  // to keep up to date.
+  if (mNumFlatteningThreads < 2 || getNumSubmodels() < 2 ||
+      isSetTransformer())
+  {
+    return false;
+  }
+
+  SBMLDocument* doc = getSBMLDocument();
+  if (doc == NULL || doc->isEnabledElementIdIndex())
+  {
+    return false;
+  }
+
+  CompSBMLDocumentPlugin* docplugin =
+    static_cast<CompSBMLDocumentPlugin*>(doc->getPlugin(getPrefix()));
+  if (docplugin == NULL)
+  {
+    return false;
+  }
+
+  map<string, bool> visited;
+  if (!instantiatesLocally(this, docplugin, visited))
+  {
+    return false;
+  }
+
+  // nothing may be filled in on first use while the threads are reading
+  doc->prepareForConcurrentReading();
+  return true;
+#else
+  return false;
+#endif
+}
+
+
+int
+CompModelPlugin::instantiateConcurrently()
+{
+#ifdef LIBSBML_USE_THREADS
+  int ret = forEachSubmodel(getNumSubmodels(), mNumFlatteningThreads,
+    [this](unsigned int sm) {
+      return getSubmodel(sm)->instantiateInternal(false);
+    });
+  if (ret != LIBSBML_OPERATION_SUCCESS) {
+    return ret;
+  }
+
+  // Call the processing callbacks in the order 'instantiate' would have.
+  // Like it, give up only if a submodel is left without an instance.
+  for (unsigned int sub=0; sub<getNumSubmodels(); sub++)
+  {
+    Submodel* submodel = getSubmodel(sub);
+    ret = submodel->callProcessingCallbacks();
+    if (ret != LIBSBML_OPERATION_SUCCESS &&
+        static_cast<const Submodel*>(submodel)->getInstantiation() == NULL)
+    {
+      return LIBSBML_OPERATION_FAILED;
+    }
+  }
+  return LIBSBML_OPERATION_SUCCESS;
+#else
+  return LIBSBML_OPERATION_FAILED;
+#endif
+}
+/** @endcond */
+
+
 int CompModelPlugin::saveAllReferencedElements()
 {
   set<SBase*> norefs;
@@ -977,6 +1244,15 @@ int CompModelPlugin::saveAllReferencedElements(set<SBase*> uniqueRefs, set<SBase
 
 int 
 CompModelPlugin::renameAllIDsAndPrepend(const std::string& prefix)
+{
+  return renameAllIDsAndPrepend(prefix, 1);
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+int
+CompModelPlugin::renameAllIDsAndPrepend(const std::string& prefix,
+                                        unsigned int numThreads)
 {
   SBMLDocument* doc = getSBMLDocument();
   Model* model = static_cast<Model*>(getParentSBMLObject());
@@ -1020,6 +1296,26 @@ CompModelPlugin::renameAllIDsAndPrepend(const std::string& prefix)
   findUniqueSubmodPrefixes(submodids, allElements);
 
   //Now that we've found valid prefixes for all our submodels, call this function recursively on them.
+#ifdef LIBSBML_USE_THREADS
+  if (numThreads > 1) {
+    // instantiateSubmodels has checked that all the instances are there
+    // and that none of the checks below can fail.
+    int ret = forEachSubmodel(getNumSubmodels(), numThreads,
+      [&](unsigned int sm) {
+        Model* inst = getSubmodel(sm)->getInstantiation();
+        CompModelPlugin* instp =
+          static_cast<CompModelPlugin*>(inst->getPlugin(getPrefix()));
+        return instp->renameAllIDsAndPrepend(prefix + submodids[sm]);
+      });
+    if (ret != LIBSBML_OPERATION_SUCCESS) {
+      delete allElements;
+      return ret;
+    }
+  }
+  else
+#else
+  (void)numThreads;
+#endif
   for (unsigned int sm=0; sm<getNumSubmodels(); sm++) {
     Submodel* subm=getSubmodel(sm); //already checked this above.
     Model* inst = subm->getInstantiation();
@@ -1060,6 +1356,7 @@ CompModelPlugin::renameAllIDsAndPrepend(const std::string& prefix)
 
   return LIBSBML_OPERATION_SUCCESS;
 }
+/** @endcond */
 
 
 /** @cond doxygenLibsbmlInternal */
@@ -1132,9 +1429,9 @@ void CompModelPlugin::findUniqueSubmodPrefixes(vector<string>& submodids, List*
 void CompModelPlugin::renameIDs(List* allElements, const string& prefix)
 {
   if (prefix=="") return; //Nothing to prepend.
-  vector<pair<string, string> > renamedSIds;
-  vector<pair<string, string> > renamedUnitSIds;
-  vector<pair<string, string> > renamedMetaIds;
+  map<string, string> renamedSIds;
+  map<string, string> renamedUnitSIds;
+  map<string, string> renamedMetaIds;
   
   // if a custom prefix transformer was specified, then set the 
   // current prefix
@@ -1162,7 +1459,7 @@ void CompModelPlugin::renameIDs(List* allElements, const string& prefix)
     if (id != newid) {
       int type = element->getTypeCode();
       if (type==SBML_UNIT_DEFINITION) {
-        renamedUnitSIds.push_back(make_pair(id, newid));
+        renamedUnitSIds.insert(make_pair(id, newid));
       }
       else if (type==SBML_COMP_PORT) {
         //Do nothing--these can only be referenced from outside the Model, so they need to be handled specially.
@@ -1171,31 +1468,31 @@ void CompModelPlugin::renameIDs(List* allElements, const string& prefix)
       else {
         //This is a little dangerous, but hey!  What's a little danger between friends!
         //(What we are assuming is that any attribute you can get with 'getId' is of the type 'SId')
-        renamedSIds.push_back(make_pair(id, newid));
+        renamedSIds.insert(make_pair(id, newid));
       }
     }
     if (metaid != newmetaid) {
-      renamedMetaIds.push_back(make_pair(metaid, newmetaid));
+      renamedMetaIds.insert(make_pair(metaid, newmetaid));
     }
   }
 
-  //for (unsigned long el=0; el<allElements->getSize(); el++) {
-  //  SBase* element = static_cast<SBase*>(allElements->get((unsigned int)el));
-  // Using ListIterator is faster
+  //Rewrite the references to all the renamed ids in one pass over each
+  // element, rather than once per renamed id, which made flattening large
+  // hierarchies quadratic.
   for (ListIterator iter = allElements->begin(); iter != allElements->end(); ++iter)
   {
     SBase* element = static_cast<SBase*>(*iter);
-    for (size_t id=0; id<renamedSIds.size(); id++)
+    if (!renamedSIds.empty())
     {
-      element->renameSIdRefs(renamedSIds[id].first, renamedSIds[id].second);
+      element->renameSIdRefs(renamedSIds);
     }
-    for (size_t uid=0; uid<renamedUnitSIds.size(); uid++) 
+    if (!renamedUnitSIds.empty())
     {
-      element->renameUnitSIdRefs(renamedUnitSIds[uid].first, renamedUnitSIds[uid].second);
+      element->renameUnitSIdRefs(renamedUnitSIds);
     }
-    for (size_t mid=0; mid<renamedMetaIds.size(); mid++) 
+    if (!renamedMetaIds.empty())
     {
-      element->renameMetaIdRefs(renamedMetaIds[mid].first, renamedMetaIds[mid].second);
+      element->renameMetaIdRefs(renamedMetaIds);
     }
   }
 }
@@ -1440,6 +1737,37 @@ CompModelPlugin::unsetTransformer()
 }
 
 
+int
+CompModelPlugin::setNumFlatteningThreads(unsigned int numThreads)
+{
+  mNumFlatteningThreads = numThreads;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+unsigned int
+CompModelPlugin::getNumFlatteningThreads() const
+{
+  return mNumFlatteningThreads;
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+void
+CompModelPlugin::setInstantiationCache(InstantiationCache* cache)
+{
+  mInstantiationCache = cache;
+}
+
+
+InstantiationCache*
+CompModelPlugin::getInstantiationCache() const
+{
+  return mInstantiationCache;
+}
+/** @endcond */
+
+
 
 /** @cond doxygenLibsbmlInternal */
 std::set<SBase*>* 
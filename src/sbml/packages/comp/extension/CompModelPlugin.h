@@ -82,6 +82,7 @@
 LIBSBML_CPP_NAMESPACE_BEGIN
 
 class PrefixTransformer;
+class InstantiationCache;
 
 class LIBSBML_EXTERN CompModelPlugin : public CompSBasePlugin
 {
@@ -590,6 +591,67 @@ public:
    */
   void unsetTransformer();
 
+
+  /**
+   * Sets the number of threads flattenModel() may use.
+   *
+   * With more than one thread, the submodels of this model are each
+   * instantiated and renamed, together with all the submodels below them,
+   * at the same time.  Deletions and replacements are then applied, and
+   * the instances merged into the flat model, one after another in the
+   * order of the submodels, so the flat model is exactly the one built on
+   * a single thread.  Processing callbacks registered with
+   * Submodel::addProcessingCallback() are called on the calling thread, in
+   * the usual order, once all the instances have been made.
+   *
+   * Threads are only used when every submodel below this model refers to
+   * a Model or ModelDefinition in the same document, no PrefixTransformer
+   * is set, and the element id index of the document is disabled (see
+   * SBMLDocument::enableElementIdIndex()); nothing is then read from other
+   * files, and nothing outside the new instances is changed while the
+   * threads run.  Otherwise, or if libSBML was built without support for
+   * threads (the @c WITH_THREADS option), the submodels are flattened one
+   * after another whatever the setting.  The document must not be changed
+   * from another thread while it is being flattened.
+   *
+   * @param numThreads the largest number of threads to use; @c 0 and
+   * @c 1 (the default) mean that the submodels are flattened one after
+   * another.
+   *
+   * @copydetails doc_returns_one_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   *
+   * @see getNumFlatteningThreads()
+   */
+  int setNumFlatteningThreads(unsigned int numThreads);
+
+
+  /**
+   * Returns the number of threads flattenModel() may use.
+   *
+   * @return the number of threads set with setNumFlatteningThreads().
+   *
+   * @see setNumFlatteningThreads(unsigned int numThreads)
+   */
+  unsigned int getNumFlatteningThreads() const;
+
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Sets the cache in which the submodels below this model keep the first
+   * instance made of each model definition.  flattenModel() sets one
+   * on the copy of the model it flattens: this one, if set, so that the
+   * caller can read its counts afterwards, or else one of its own.
+   */
+  void setInstantiationCache(InstantiationCache* cache);
+
+
+  /**
+   * Returns the cache set with setInstantiationCache(), or @c NULL.
+   */
+  InstantiationCache* getInstantiationCache() const;
+  /** @endcond */
+
 protected:
 
   /**
@@ -665,6 +727,10 @@ protected:
    * in previous releases. 
    */
   PrefixTransformer* mTransformer;
+
+  unsigned int       mNumFlatteningThreads;
+
+  InstantiationCache* mInstantiationCache;
   /** @endcond */
 
 private:
@@ -691,6 +757,24 @@ private:
    */
   virtual int renameAllIDsAndPrepend(const std::string& prefix);
 
+  /*
+   * Does the work of renameAllIDsAndPrepend(), renaming the instantiated
+   * submodels of this model on up to 'numThreads' threads.
+   */
+  int renameAllIDsAndPrepend(const std::string& prefix, unsigned int numThreads);
+
+  /*
+   * Returns true if instantiateSubmodels() may instantiate and rename the
+   * submodels of this model on several threads.
+   */
+  bool canInstantiateConcurrently();
+
+  /*
+   * Instantiates the submodels of this model on several threads, and then
+   * calls the processing callbacks on the instances one after another.
+   */
+  int instantiateConcurrently();
+
   /** @cond doxygenLibsbmlInternal */
   /*
    * DEPRECATED FUNCTION:  DO NOT USE!!!
@@ -780,6 +780,7 @@ CompSBMLDocumentPlugin::checkConsistency()
   if (id)
   {
     id_validator.init();
+    id_validator.setProfile(doc->getValidationProfile(), "CompIdentifierConsistencyValidator");
     nerrors = id_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
@@ -810,6 +811,7 @@ CompSBMLDocumentPlugin::checkConsistency()
   if (sbml)
   {
     validator.init();
+    validator.setProfile(doc->getValidationProfile(), "CompConsistencyValidator");
     nerrors = validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
@@ -840,6 +842,7 @@ CompSBMLDocumentPlugin::checkConsistency()
   if (units)
   {
     unit_validator.init();
+    unit_validator.setProfile(doc->getValidationProfile(), "CompUnitConsistencyValidator");
     nerrors = unit_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
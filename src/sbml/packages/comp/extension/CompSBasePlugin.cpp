@@ -246,6 +246,26 @@ CompSBasePlugin::getAllElements(ElementFilter *filter)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+CompSBasePlugin::renameSIdRefs(const std::map<std::string, std::string>& )
+{
+}
+
+
+void
+CompSBasePlugin::renameMetaIdRefs(const std::map<std::string, std::string>& )
+{
+}
+
+
+void
+CompSBasePlugin::renameUnitSIdRefs(const std::map<std::string, std::string>& )
+{
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 void
 CompSBasePlugin::addExpectedAttributes(ExpectedAttributes& attributes)
@@ -226,6 +226,25 @@ public:
   /** @endcond */
 
 
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * The 'comp' attributes that refer to other elements all belong to the
+   * children of the parent object (ReplacedElement, ReplacedBy, Submodel,
+   * Port...), which are renamed as elements in their own right, so these
+   * do nothing.
+   */
+  using SBasePlugin::renameSIdRefs;
+  using SBasePlugin::renameMetaIdRefs;
+  using SBasePlugin::renameUnitSIdRefs;
+
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+  virtual void renameMetaIdRefs(const std::map<std::string, std::string>& renamed);
+
+  virtual void renameUnitSIdRefs(const std::map<std::string, std::string>& renamed);
+  /** @endcond */
+
+
 #endif //SWIG
  
 
@@ -121,6 +121,7 @@ Deletion::setId(const string& id)
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
   }
   mId = id;
+  updateElementIdIndex();
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -129,6 +130,7 @@ int
 Deletion::unsetId()
 {
   mId = "";
+  updateElementIdIndex();
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -158,6 +158,7 @@ ExternalModelDefinition::setId(const string& id)
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
   }
   mId = id;
+  updateElementIdIndex();
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -169,6 +170,7 @@ int
 ExternalModelDefinition::unsetId()
 {
   mId = "";
+  updateElementIdIndex();
   return LIBSBML_OPERATION_SUCCESS;
 }
 
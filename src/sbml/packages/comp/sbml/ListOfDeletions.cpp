@@ -104,10 +104,8 @@ ListOfDeletions::get (const std::string& symbol)
 const Deletion*
 ListOfDeletions::get (const std::string& symbol) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEq<Model>(symbol) );
-  return (result == mItems.end()) ? 0 : static_cast <Deletion*> (*result);
+  unsigned int n = getIndexById(symbol);
+  return (n < mItems.size()) ? static_cast <Deletion*> (mItems[n]) : NULL;
 }
 
 /* Removes the nth item from this list */
@@ -130,6 +128,7 @@ ListOfDeletions::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast<Deletion*>(item);
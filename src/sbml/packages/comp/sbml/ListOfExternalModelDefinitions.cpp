@@ -104,10 +104,8 @@ ListOfExternalModelDefinitions::get (const std::string& symbol)
 const ExternalModelDefinition*
 ListOfExternalModelDefinitions::get (const std::string& symbol) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEq<Model>(symbol) );
-  return (result == mItems.end()) ? NULL : static_cast <ExternalModelDefinition*> (*result);
+  unsigned int n = getIndexById(symbol);
+  return (n < mItems.size()) ? static_cast <ExternalModelDefinition*> (mItems[n]) : NULL;
 }
 
 
@@ -124,8 +122,10 @@ ListOfExternalModelDefinitions::remove (const std::string &sid)
   ListItemIter result = find_if( mItems.begin(), mItems.end(), IdEq<ExternalModelDefinition>(sid) );
   if (result == mItems.end()) return NULL;
 
+  SBase* item = *result;
   mItems.erase(result);
-  return static_cast<ExternalModelDefinition*>(*result);
+  itemRemoved(item);
+  return static_cast<ExternalModelDefinition*>(item);
 }
 
 
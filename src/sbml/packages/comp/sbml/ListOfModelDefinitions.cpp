@@ -103,10 +103,8 @@ ListOfModelDefinitions::get (const std::string& symbol)
 const ModelDefinition*
 ListOfModelDefinitions::get (const std::string& symbol) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEq<Model>(symbol) );
-  return (result == mItems.end()) ? 0 : static_cast <ModelDefinition*> (*result);
+  unsigned int n = getIndexById(symbol);
+  return (n < mItems.size()) ? static_cast <ModelDefinition*> (mItems[n]) : NULL;
 }
 
 
@@ -125,8 +123,10 @@ ListOfModelDefinitions::remove (const std::string &sid)
   result = find_if( mItems.begin(), mItems.end(), IdEq<ModelDefinition>(sid) );
   if (result == mItems.end()) return NULL;
 
+  SBase* item = *result;
   mItems.erase(result);
-  return static_cast<ModelDefinition*>(*result);
+  itemRemoved(item);
+  return static_cast<ModelDefinition*>(item);
 }
 
 /*
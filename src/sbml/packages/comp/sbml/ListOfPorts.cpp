@@ -99,11 +99,8 @@ ListOfPorts::get (const std::string& symbol)
 const Port*
 ListOfPorts::get (const std::string& symbol) const
 {
-  for (size_t it=0; it<mItems.size(); it++) {
-    const Port* port = static_cast<Port*>(mItems[it]);
-    if (port->getId() == symbol) return port;
-  }
-  return NULL;
+  unsigned int n = getIndexById(symbol);
+  return (n < mItems.size()) ? static_cast <Port*> (mItems[n]) : NULL;
 }
 
 Port*
@@ -125,6 +122,7 @@ ListOfPorts::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast<Port*>(item);
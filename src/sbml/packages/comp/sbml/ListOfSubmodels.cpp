@@ -99,10 +99,8 @@ ListOfSubmodels::get (const std::string& symbol)
 const Submodel*
 ListOfSubmodels::get (const std::string& symbol) const
 {
-  vector<SBase*>::const_iterator result;
-
-  result = find_if( mItems.begin(), mItems.end(), IdEq<Model>(symbol) );
-  return (result == mItems.end()) ? 0 : static_cast <Submodel*> (*result);
+  unsigned int n = getIndexById(symbol);
+  return (n < mItems.size()) ? static_cast <Submodel*> (mItems[n]) : NULL;
 }
 
 
@@ -125,6 +123,7 @@ ListOfSubmodels::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast<Submodel*>(item);
@@ -108,6 +108,7 @@ Port::setId (const std::string& id)
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
   }
   mId = id;
+  updateElementIdIndex();
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -130,6 +131,7 @@ int
 Port::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty())
   {
@@ -328,6 +330,13 @@ Port::renameSIdRefs(const std::string& oldid, const std::string& newid)
   SBaseRef::renameSIdRefs(oldid, newid);
 }
 
+void
+Port::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  //The idRef is renamed by SBaseRef.
+  SBaseRef::renameSIdRefs(renamed);
+}
+
 
 void
 Port::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
@@ -336,6 +345,14 @@ Port::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
   SBaseRef::renameUnitSIdRefs(oldid, newid);
 }
 
+void
+Port::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (getRenamedId(mUnitRef, renamed, newid)) mUnitRef = newid;
+  renamePluginUnitSIdRefs(renamed);
+}
+
 
 void
 Port::renameMetaIdRefs(const std::string& oldid, const std::string& newid)
@@ -344,6 +361,14 @@ Port::renameMetaIdRefs(const std::string& oldid, const std::string& newid)
   SBaseRef::renameMetaIdRefs(oldid, newid);
 }
 
+void
+Port::renameMetaIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (getRenamedId(mMetaIdRef, renamed, newid)) mMetaIdRef = newid;
+  renamePluginMetaIdRefs(renamed);
+}
+
 
 /** @cond doxygenLibsbmlInternal */
 bool
@@ -335,6 +335,14 @@ ReplacedElement::renameSIdRefs(const std::string& oldid, const std::string& newi
   Replacing::renameSIdRefs(oldid, newid);
 }
 
+void
+ReplacedElement::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (getRenamedId(mDeletion, renamed, newid)) mDeletion = newid;
+  Replacing::renameSIdRefs(renamed);
+}
+
 
 int ReplacedElement::performReplacementAndCollect(set<SBase*>* removed, set<SBase*>* toremove)
 {
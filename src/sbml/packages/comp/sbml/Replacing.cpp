@@ -240,6 +240,15 @@ Replacing::renameSIdRefs(const std::string& oldid, const std::string& newid)
   SBaseRef::renameSIdRefs(oldid, newid);
 }
 
+void
+Replacing::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (getRenamedId(mSubmodelRef, renamed, newid)) mSubmodelRef = newid;
+  if (getRenamedId(mConversionFactor, renamed, newid)) mConversionFactor = newid;
+  SBaseRef::renameSIdRefs(renamed);
+}
+
 /** @cond doxygenLibsbmlInternal */
 void
 Replacing::addExpectedAttributes(ExpectedAttributes& attributes)
@@ -542,6 +542,17 @@ SBaseRef::renameSIdRefs(const std::string& oldid, const std::string& newid)
   SBase::renameSIdRefs(oldid, newid);
 }
 
+void
+SBaseRef::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (getRenamedId(mPortRef, renamed, newid)) mPortRef = newid;
+  if (getRenamedId(mIdRef, renamed, newid)) mIdRef = newid;
+  if (getRenamedId(mUnitRef, renamed, newid)) mUnitRef = newid;
+  if (getRenamedId(mMetaIdRef, renamed, newid)) mMetaIdRef = newid;
+  renamePluginSIdRefs(renamed);
+}
+
 /*
  * Creates a new SBaseRef, adds it to this SBaseRef
  * and returns it.
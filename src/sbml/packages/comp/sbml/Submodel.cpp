@@ -49,6 +49,7 @@
 #include <sbml/packages/comp/extension/CompSBMLDocumentPlugin.h>
 #include <sbml/packages/comp/extension/CompModelPlugin.h>
 #include <sbml/packages/comp/sbml/Submodel.h>
+#include <sbml/packages/comp/util/InstantiationCache.h>
 #include <sbml/packages/comp/validator/CompSBMLError.h>
 
 #include <sbml/util/ElementFilter.h>
@@ -182,6 +183,7 @@ Submodel::setId (const std::string& id)
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
   }
   mId = id;
+  updateElementIdIndex();
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -204,6 +206,7 @@ int
 Submodel::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty())
   {
@@ -720,6 +723,15 @@ Submodel::renameSIdRefs(const std::string& oldid, const std::string& newid)
   CompBase::renameSIdRefs(oldid, newid);
 }
 
+void
+Submodel::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (getRenamedId(mTimeConversionFactor, renamed, newid)) mTimeConversionFactor = newid;
+  if (getRenamedId(mExtentConversionFactor, renamed, newid)) mExtentConversionFactor = newid;
+  renamePluginSIdRefs(renamed);
+}
+
 
 int
 Submodel::getTypeCode () const
@@ -778,9 +790,61 @@ Submodel::connectToChild()
 /** @endcond */
 
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Returns the InstantiationCache of the model being flattened that the
+ * given submodel is part of, or NULL if there is none.
+ */
+static InstantiationCache*
+getInstantiationCache(const Submodel* submodel)
+{
+  const SBase* top = NULL;
+  const SBase* parent = submodel->getParentSBMLObject();
+  while (parent != NULL && parent->getTypeCode() != SBML_DOCUMENT)
+  {
+    if (parent->getTypeCode() == SBML_MODEL ||
+      parent->getTypeCode() == SBML_COMP_MODELDEFINITION)
+    {
+      top = parent;
+    }
+    parent = parent->getParentSBMLObject();
+  }
+  if (top == NULL)
+  {
+    return NULL;
+  }
+
+  const CompModelPlugin* plugin = static_cast<const CompModelPlugin*>
+    (top->getPlugin(submodel->getPackageName()));
+  return plugin != NULL ? plugin->getInstantiationCache() : NULL;
+}
+/** @endcond */
+
+
 int 
 Submodel::instantiate()
 {
+  return instantiateInternal(true);
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+int
+Submodel::instantiateInternal(bool callCallbacks)
+{
+  // The cache keeps instances as they are before the callbacks are called
+  // on them, so the callbacks are called once everything below is made.
+  InstantiationCache* cache = getInstantiationCache(this);
+  if (callCallbacks && cache != NULL)
+  {
+    int ret = instantiateInternal(false);
+    if (ret != LIBSBML_OPERATION_SUCCESS)
+    {
+      return ret;
+    }
+    return callProcessingCallbacks();
+  }
+
   SBMLDocument* doc = getSBMLDocument();
   SBMLDocument* rootdoc = doc;
   if (doc==NULL) 
@@ -844,6 +908,18 @@ Submodel::instantiate()
     rootdoc->getErrorLog()->logPackageError("comp", CompSubmodelMustReferenceModel, getPackageVersion(), getLevel(), getVersion(), error, getLine(), getColumn());
     return LIBSBML_INVALID_OBJECT;
   }
+
+  // Another submodel may have instantiated the same definition already.
+  // Only instances made without errors are kept, so this one cannot be
+  // among its own ancestors either.
+  const Submodel* cached = 
+    (cache != NULL) ? cache->find(origmodel, parentURI) : NULL;
+  if (cached != NULL)
+  {
+    copyInstantiationFrom(cached);
+    return LIBSBML_OPERATION_SUCCESS;
+  }
+
   ExternalModelDefinition* extmod;
   SBMLDocument* origdoc = NULL;
   string newmodel = parentURI + "::" + getModelRef();
@@ -921,9 +997,10 @@ Submodel::instantiate()
     mInstantiatedModel->enablePackageInternal(getPackageURI(), getPrefix(), true);
   }
 
-  // call all registered callbacks
+  // call all registered callbacks, unless callProcessingCallbacks() is
+  // going to call them later
   std::vector<ModelProcessingCallbackData*>::iterator it = mProcessingCBs.begin();
-  while(it != mProcessingCBs.end())
+  while(callCallbacks && it != mProcessingCBs.end())
   {
     ModelProcessingCallbackData* current = *it;
     int result = current->cb(mInstantiatedModel, rootdoc->getErrorLog(), current->data);
@@ -954,7 +1031,7 @@ Submodel::instantiate()
   for (unsigned int sub=0; sub<instmodplug->getNumSubmodels(); sub++) 
   {
     Submodel* instsub = instmodplug->getSubmodel(sub);
-    int ret = instsub->instantiate();
+    int ret = instsub->instantiateInternal(callCallbacks);
     if (ret != LIBSBML_OPERATION_SUCCESS) {
       //'instantiate' already sets its own error messages.
       delete mInstantiatedModel;
@@ -964,8 +1041,104 @@ Submodel::instantiate()
     }
   }
 
+  if (cache != NULL)
+  {
+    Submodel* kept = new Submodel(*this);
+    kept->copyInstantiationFrom(this);
+    cache->add(origmodel, parentURI, kept);
+  }
+
+  return LIBSBML_OPERATION_SUCCESS;
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+void
+Submodel::copyInstantiationFrom(const Submodel* source)
+{
+  const Model* model = source->mInstantiatedModel;
+  mInstantiatedModel = model->clone();
+  mInstantiationOriginalURI = source->mInstantiationOriginalURI;
+  mInstantiatedModel->connectToParent(this);
+  mInstantiatedModel->setSBMLDocument
+    (const_cast<SBMLDocument*>(model->getSBMLDocument()));
+
+  // the copy of a model leaves its submodels without an instantiation;
+  // the kept copies have no document to look the prefix up in
+  const CompModelPlugin* from = 
+    static_cast<const CompModelPlugin*>(model->getPlugin(getPackageName()));
+  CompModelPlugin* to = static_cast<CompModelPlugin*>
+    (mInstantiatedModel->getPlugin(getPackageName()));
+  if (from == NULL || to == NULL)
+  {
+    return;
+  }
+  for (unsigned int sub=0; sub<from->getNumSubmodels(); sub++)
+  {
+    const Submodel* fromsub = from->getSubmodel(sub);
+    if (fromsub->mInstantiatedModel != NULL)
+    {
+      to->getSubmodel(sub)->copyInstantiationFrom(fromsub);
+    }
+  }
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+int
+Submodel::callProcessingCallbacks()
+{
+  if (mInstantiatedModel == NULL)
+  {
+    return LIBSBML_OPERATION_FAILED;
+  }
+
+  SBMLDocument* rootdoc = getSBMLDocument();
+  SBase* parent  = getParentSBMLObject();
+  while (parent != NULL && parent->getTypeCode() != SBML_DOCUMENT) {
+    rootdoc = parent->getSBMLDocument();
+    parent = parent->getParentSBMLObject();
+  }
+
+  CompModelPlugin* instmodplug =
+    static_cast<CompModelPlugin*>(mInstantiatedModel->getPlugin(getPrefix()));
+
+  std::vector<ModelProcessingCallbackData*>::iterator it = mProcessingCBs.begin();
+  while(it != mProcessingCBs.end())
+  {
+    ModelProcessingCallbackData* current = *it;
+    int result = current->cb(mInstantiatedModel, rootdoc->getErrorLog(), current->data);
+    if (result != LIBSBML_OPERATION_SUCCESS)
+    {
+      // instantiate() returns before instantiating the submodels
+      for (unsigned int sub=0; instmodplug != NULL && sub<instmodplug->getNumSubmodels(); sub++)
+      {
+        instmodplug->getSubmodel(sub)->clearInstantiation();
+      }
+      return result;
+    }
+    ++it;
+  }
+
+  if (instmodplug == NULL)
+    return LIBSBML_OPERATION_SUCCESS;
+
+  for (unsigned int sub=0; sub<instmodplug->getNumSubmodels(); sub++)
+  {
+    int ret = instmodplug->getSubmodel(sub)->callProcessingCallbacks();
+    if (ret != LIBSBML_OPERATION_SUCCESS) {
+      delete mInstantiatedModel;
+      mInstantiatedModel = NULL;
+      mInstantiationOriginalURI = "";
+      return ret;
+    }
+  }
+
   return LIBSBML_OPERATION_SUCCESS;
 }
+/** @endcond */
 
 int Submodel::performDeletions()
 {
@@ -639,6 +639,12 @@ public:
   virtual void renameSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+  /**
+   * @copydoc doc_renamesidrefmap_common
+   */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
   /**
    * Returns the libSBML type code of this object instance.
    *
@@ -854,6 +860,27 @@ public:
   static void removeProcessingCallback(ModelProcessingCallback cb);
   /** @endcond */
 
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Does the work of instantiate().  When @p callCallbacks is @c false,
+   * the processing callbacks are not called on the new instance, nor on
+   * those made for the submodels below it, so that nothing outside them
+   * is touched; callProcessingCallbacks() must then be called once they
+   * have all been made.
+   */
+  int instantiateInternal(bool callCallbacks);
+
+
+  /**
+   * Calls the processing callbacks on the instantiated Model and then on
+   * those of the submodels below it, in the order instantiate() calls
+   * them.  Should a callback fail, the submodels below are left without
+   * an instantiation, as instantiate() would have left them.
+   */
+  int callProcessingCallbacks();
+  /** @endcond */
+
 protected:
 
   /** @cond doxygenLibsbmlInternal */
@@ -892,6 +919,12 @@ protected:
   /** @endcond */
 
 private:
+  /**
+   * Makes the instantiation of this submodel a copy of that of the given
+   * one, together with copies of the instantiations below it.
+   */
+  void copyInstantiationFrom(const Submodel* source);
+
   /**
    * Internal function to convert time and extent with the given ASTNodes.
    */
@@ -36,6 +36,7 @@
 
 
 #include <sbml/packages/comp/util/CompFlatteningConverter.h>
+#include <sbml/packages/comp/util/InstantiationCache.h>
 #include <sbml/packages/comp/util/SBMLFileResolver.h>
 #include <sbml/packages/comp/util/SBMLResolverRegistry.h>
 #include <sbml/packages/comp/validator/CompSBMLError.h>
@@ -77,6 +78,8 @@ void CompFlatteningConverter::init()
 CompFlatteningConverter::CompFlatteningConverter() 
   : SBMLConverter("SBML Comp Flattening Converter")
   , mPkgsToStrip (NULL)
+  , mNumInstantiationCacheHits (0)
+  , mNumInstantiationCacheMisses (0)
 {
   mDisabledPackages.clear();
 }
@@ -87,6 +90,8 @@ CompFlatteningConverter::CompFlatteningConverter
 SBMLConverter(orig)
   , mDisabledPackages(orig.mDisabledPackages)
   , mPkgsToStrip (orig.mPkgsToStrip)
+  , mNumInstantiationCacheHits (orig.mNumInstantiationCacheHits)
+  , mNumInstantiationCacheMisses (orig.mNumInstantiationCacheMisses)
 {
 }
 
@@ -132,10 +137,26 @@ CompFlatteningConverter::getDefaultProperties() const
     "specify whether to strip any unflattenable packages ignored by 'abortIfUnflattenable'");
   prop.addOption("stripPackages", "", 
     "comma separated list of packages to be stripped before flattening is attempted");
+  prop.addOption("numThreads", 1,
+    "the largest number of threads on which sibling submodels are instantiated and renamed");
   return prop;
 }
 
 
+unsigned int
+CompFlatteningConverter::getNumInstantiationCacheHits() const
+{
+  return mNumInstantiationCacheHits;
+}
+
+
+unsigned int
+CompFlatteningConverter::getNumInstantiationCacheMisses() const
+{
+  return mNumInstantiationCacheMisses;
+}
+
+
 bool 
 CompFlatteningConverter::matchesProperties
                         (const ConversionProperties &props) const
@@ -312,6 +333,8 @@ int
 CompFlatteningConverter::performConversion()
 {  
   int result = LIBSBML_OPERATION_FAILED;
+  mNumInstantiationCacheHits = 0;
+  mNumInstantiationCacheMisses = 0;
 
   if (mDocument == NULL) 
   {
@@ -394,7 +417,19 @@ CompFlatteningConverter::performConversion()
   mainDoc.abortForRequiredOnly = getAbortForRequired(); 
  
   Submodel::addProcessingCallback(&EnablePackageOnParentDocument, &(mainDoc));
+
+  unsigned int numThreads = modelPlugin->getNumFlatteningThreads();
+  if (getProperties() != NULL && getProperties()->hasOption("numThreads"))
+  {
+    modelPlugin->setNumFlatteningThreads(getNumThreads());
+  }
+  InstantiationCache cache;
+  modelPlugin->setInstantiationCache(&cache);
   Model* flatmodel = modelPlugin->flattenModel();
+  modelPlugin->setInstantiationCache(NULL);
+  modelPlugin->setNumFlatteningThreads(numThreads);
+  mNumInstantiationCacheHits = cache.getNumHits();
+  mNumInstantiationCacheMisses = cache.getNumMisses();
   
 
   if (flatmodel == NULL) 
@@ -885,6 +920,26 @@ CompFlatteningConverter::getPerformValidation() const
 }
 /** @endcond */
 
+/** @cond doxygenLibsbmlInternal */
+unsigned int
+CompFlatteningConverter::getNumThreads() const
+{
+  if (getProperties() == NULL)
+  {
+    return 1;
+  }
+  else if (getProperties()->hasOption("numThreads") == false)
+  {
+    return 1;
+  }
+  else
+  {
+    int numThreads = getProperties()->getIntValue("numThreads");
+    return numThreads > 1 ? (unsigned int)numThreads : 1;
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 bool
 CompFlatteningConverter::getAbortForAll() const
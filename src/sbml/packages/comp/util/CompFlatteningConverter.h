@@ -480,6 +480,12 @@ writer.writeSBML(doc, args[1]);
  * <li> @em "performValidation": Possible values are @c "true" (the default)
  * or @c "false".  Controls whether whether libSBML validates the model
  * before attempting to flatten it.
+ *
+ * <li> @em "numThreads": The value must be a positive integer (default:
+ * 1).  The largest number of threads on which the submodels of the model
+ * are instantiated and renamed at the same time; the flattened model is
+ * the same whatever the number.  See
+ * CompModelPlugin::setNumFlatteningThreads() for when threads are used.
  * </ul>
  */
 
@@ -617,6 +623,35 @@ public:
   virtual ConversionProperties getDefaultProperties() const;
 
 
+  /**
+   * Returns the number of submodels that the last conversion instantiated
+   * by copying an instance it had already made of the same definition.
+   *
+   * While a model is flattened, the first instance made of each
+   * ModelDefinition or ExternalModelDefinition is kept, together with the
+   * instances of the submodels below it.  The other submodels that refer
+   * to the same definition copy it, instead of resolving the definition
+   * and instantiating the submodels below it again.  Submodels below a
+   * copied instance are copied with it and not counted.
+   *
+   * @return the number of submodels instantiated from a kept instance.
+   *
+   * @see getNumInstantiationCacheMisses()
+   */
+  unsigned int getNumInstantiationCacheHits() const;
+
+
+  /**
+   * Returns the number of submodels that the last conversion instantiated
+   * from their definition, as no instance of it had been kept yet.
+   *
+   * @return the number of submodels instantiated from their definition.
+   *
+   * @see getNumInstantiationCacheHits()
+   */
+  unsigned int getNumInstantiationCacheMisses() const;
+
+
 private:
 
   /** @cond doxygenLibsbmlInternal */
@@ -644,6 +679,8 @@ private:
 
   bool getPerformValidation() const;
 
+  unsigned int getNumThreads() const;
+
   bool getAbortForAll() const;
 
   bool getAbortForRequired() const;
@@ -667,6 +704,9 @@ private:
   PackageValueMap mPackageValues;
   IdList * mPkgsToStrip;
 
+  unsigned int mNumInstantiationCacheHits;
+  unsigned int mNumInstantiationCacheMisses;
+
   void analyseDocument();
 
   bool getRequiredStatus(const std::string & package);
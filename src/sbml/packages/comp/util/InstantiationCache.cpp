@@ -0,0 +1,108 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    InstantiationCache.cpp
+ * @brief   Keeps the first instance made of each model definition
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <sbml/packages/comp/util/InstantiationCache.h>
+#include <sbml/packages/comp/sbml/Submodel.h>
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+InstantiationCache::InstantiationCache ()
+  : mInstances()
+  , mNumHits(0)
+  , mNumMisses(0)
+{
+}
+
+
+InstantiationCache::~InstantiationCache ()
+{
+  clear();
+}
+
+
+const Submodel*
+InstantiationCache::find (const SBase* definition, const std::string& uri)
+{
+#ifdef LIBSBML_USE_THREADS
+  std::lock_guard<std::mutex> lock(mMutex);
+#endif
+  InstanceMap::const_iterator it = mInstances.find(make_pair(definition, uri));
+  if (it == mInstances.end())
+  {
+    ++mNumMisses;
+    return NULL;
+  }
+
+  ++mNumHits;
+  return it->second;
+}
+
+
+void
+InstantiationCache::add (const SBase* definition, const std::string& uri,
+                         Submodel* instance)
+{
+#ifdef LIBSBML_USE_THREADS
+  std::lock_guard<std::mutex> lock(mMutex);
+#endif
+  if (!mInstances.insert(make_pair(make_pair(definition, uri), instance)).second)
+  {
+    delete instance;
+  }
+}
+
+
+unsigned int
+InstantiationCache::getNumHits () const
+{
+  return mNumHits;
+}
+
+
+unsigned int
+InstantiationCache::getNumMisses () const
+{
+  return mNumMisses;
+}
+
+
+void
+InstantiationCache::clear ()
+{
+#ifdef LIBSBML_USE_THREADS
+  std::lock_guard<std::mutex> lock(mMutex);
+#endif
+  for (InstanceMap::iterator it = mInstances.begin(); it != mInstances.end(); ++it)
+  {
+    delete it->second;
+  }
+  mInstances.clear();
+  mNumHits = 0;
+  mNumMisses = 0;
+}
+
+LIBSBML_CPP_NAMESPACE_END
+
+/** @endcond */
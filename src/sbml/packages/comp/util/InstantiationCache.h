@@ -0,0 +1,125 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    InstantiationCache.h
+ * @brief   Keeps the first instance made of each model definition
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+#ifndef InstantiationCache_h
+#define InstantiationCache_h
+
+
+#ifdef __cplusplus
+
+
+#include <sbml/common/extern.h>
+#include <sbml/common/libsbml-config-common.h>
+
+#include <map>
+#include <string>
+
+#ifdef LIBSBML_USE_THREADS
+#include <mutex>
+#endif
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class SBase;
+class Submodel;
+
+/*
+ * When many submodels refer to the same ModelDefinition or
+ * ExternalModelDefinition, Submodel::instantiate() would find and resolve
+ * the definition, copy it and instantiate the submodels below it again
+ * for each of them.  While a model is flattened, the InstantiationCache
+ * keeps a copy of the first instance made of each definition, with the
+ * instances of the submodels below it, as it was before the processing
+ * callbacks ran.  The other submodels that refer to the same definition
+ * copy that instead.
+ *
+ * Instances are kept by definition and by the URI of the document the
+ * definition was found in.  The cache owns the copies it keeps, and may
+ * be used from several threads at once.
+ */
+class InstantiationCache
+{
+public:
+
+  InstantiationCache ();
+
+  ~InstantiationCache ();
+
+
+  /*
+   * Returns the instance kept for the given definition and URI (a hit),
+   * or NULL if there is none yet (a miss).  The instance is not changed
+   * once kept, so it may be copied without holding any lock.
+   */
+  const Submodel* find (const SBase* definition, const std::string& uri);
+
+
+  /*
+   * Keeps the given instance for the given definition and URI, and takes
+   * it over.  If another thread kept one first, the given one is deleted.
+   */
+  void add (const SBase* definition, const std::string& uri,
+            Submodel* instance);
+
+
+  /*
+   * Returns the number of times find() found an instance.
+   */
+  unsigned int getNumHits () const;
+
+
+  /*
+   * Returns the number of times find() returned NULL.
+   */
+  unsigned int getNumMisses () const;
+
+
+  /*
+   * Deletes all the instances kept and resets the counts.
+   */
+  void clear ();
+
+
+private:
+
+  InstantiationCache (const InstantiationCache&);
+  InstantiationCache& operator= (const InstantiationCache&);
+
+  typedef std::pair<const SBase*, std::string>  Key;
+  typedef std::map<Key, Submodel*>              InstanceMap;
+
+  InstanceMap  mInstances;
+  unsigned int mNumHits;
+  unsigned int mNumMisses;
+
+#ifdef LIBSBML_USE_THREADS
+  std::mutex   mMutex;
+#endif
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* InstantiationCache_h */
+
+/** @endcond */
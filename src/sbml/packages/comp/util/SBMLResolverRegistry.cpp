@@ -45,11 +45,68 @@
 #include <sbml/packages/comp/util/SBMLResolverRegistry.h>
 #include <sbml/packages/comp/util/SBMLResolver.h>
 #include <sbml/packages/comp/util/SBMLFileResolver.h>
+#include <sbml/packages/comp/util/SBMLUri.h>
 #include <sbml/util/util.h>
 
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef LIBSBML_USE_THREADS
+#include <mutex>
+#endif
+
 using namespace std;
 LIBSBML_CPP_NAMESPACE_BEGIN
 
+#ifdef LIBSBML_USE_THREADS
+/*
+ * Guards the document cache, as documents may be resolved from several
+ * threads at once.
+ */
+static std::mutex sDocumentCacheMutex;
+#endif
+
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Gets the modification time and size of the given file, and returns
+ * false if it is not a file that can be looked at.
+ */
+static bool
+getFileStamp(const string& fileName, time_t& modified, unsigned long& size)
+{
+#if defined(WIN32) && !defined(CYGWIN)
+  struct _stat info;
+  if (_stat(fileName.c_str(), &info) != 0)
+    return false;
+#else
+  struct stat info;
+  if (stat(fileName.c_str(), &info) != 0)
+    return false;
+#endif
+  modified = info.st_mtime;
+  size = (unsigned long)info.st_size;
+  return true;
+}
+
+
+/*
+ * Returns a copy of the given document, together with the errors logged
+ * while it was read, which the copy constructor leaves out.
+ */
+static SBMLDocument*
+copyDocument(const SBMLDocument* doc)
+{
+  SBMLDocument* copy = doc->clone();
+  for (unsigned int i = 0; i < doc->getNumErrors(); ++i)
+  {
+    copy->getErrorLog()->add(*doc->getError(i));
+  }
+  return copy;
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 /** @cond doxygenLibsbmlInternal */
 SBMLResolverRegistry* SBMLResolverRegistry::mInstance = NULL;
@@ -93,6 +150,94 @@ SBMLResolverRegistry::addOwnedSBMLDocument(const SBMLDocument* doc)
   return LIBSBML_OPERATION_SUCCESS;
 }
 
+
+int
+SBMLResolverRegistry::setDocumentCacheSize(unsigned int size)
+{
+#ifdef LIBSBML_USE_THREADS
+  std::lock_guard<std::mutex> lock(sDocumentCacheMutex);
+#endif
+  mDocumentCacheSize = size;
+  shrinkDocumentCache(size);
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+unsigned int
+SBMLResolverRegistry::getDocumentCacheSize() const
+{
+  return mDocumentCacheSize;
+}
+
+
+unsigned int
+SBMLResolverRegistry::getNumCachedDocuments() const
+{
+#ifdef LIBSBML_USE_THREADS
+  std::lock_guard<std::mutex> lock(sDocumentCacheMutex);
+#endif
+  return (unsigned int)mCachedDocuments.size();
+}
+
+
+int
+SBMLResolverRegistry::removeCachedDocument(const std::string &uri, const std::string baseUri/*=""*/)
+{
+  SBMLUri* resolved = resolveUri(uri, baseUri);
+  if (resolved == NULL)
+    return LIBSBML_OPERATION_FAILED;
+
+  const string resolvedUri = resolved->getUri();
+  delete resolved;
+
+#ifdef LIBSBML_USE_THREADS
+  std::lock_guard<std::mutex> lock(sDocumentCacheMutex);
+#endif
+  map<string, CachedDocument>::iterator cached = mCachedDocuments.find(resolvedUri);
+  if (cached == mCachedDocuments.end())
+    return LIBSBML_OPERATION_FAILED;
+
+  delete cached->second.document;
+  mCachedDocumentOrder.erase(cached->second.position);
+  mCachedDocuments.erase(cached);
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+void
+SBMLResolverRegistry::clearDocumentCache()
+{
+#ifdef LIBSBML_USE_THREADS
+  std::lock_guard<std::mutex> lock(sDocumentCacheMutex);
+#endif
+  shrinkDocumentCache(0);
+}
+
+
+unsigned int
+SBMLResolverRegistry::getNumDocumentCacheHits() const
+{
+  return mNumDocumentCacheHits;
+}
+
+
+unsigned int
+SBMLResolverRegistry::getNumDocumentCacheMisses() const
+{
+  return mNumDocumentCacheMisses;
+}
+
+
+void
+SBMLResolverRegistry::resetDocumentCacheStatistics()
+{
+#ifdef LIBSBML_USE_THREADS
+  std::lock_guard<std::mutex> lock(sDocumentCacheMutex);
+#endif
+  mNumDocumentCacheHits = 0;
+  mNumDocumentCacheMisses = 0;
+}
+
 int
 SBMLResolverRegistry::removeResolver(int index)
 {
@@ -126,6 +271,13 @@ SBMLResolverRegistry::getResolverByIndex(int index) const
 
 /** @cond doxygenLibsbmlInternal */
 SBMLResolverRegistry::SBMLResolverRegistry()
+  : mResolvers()
+  , mOwnedDocuments()
+  , mDocumentCacheSize(0)
+  , mCachedDocuments()
+  , mCachedDocumentOrder()
+  , mNumDocumentCacheHits(0)
+  , mNumDocumentCacheMisses(0)
 {
   // for now ensure that we always have a file resolver in there
   // 
@@ -155,10 +307,80 @@ SBMLResolverRegistry::~SBMLResolverRegistry()
     delete doc;
     mOwnedDocuments.erase(doc);
   }
+
+  shrinkDocumentCache(0);
 }
 
 SBMLDocument*
 SBMLResolverRegistry::resolve(const std::string &uri, const std::string baseUri/*=""*/) const
+{
+  if (mDocumentCacheSize == 0)
+    return resolveWithResolvers(uri, baseUri);
+
+  // only documents read from local files are kept, as only for those
+  // can we tell whether they have changed since
+  SBMLUri* resolved = resolveUri(uri, baseUri);
+  if (resolved == NULL)
+    return resolveWithResolvers(uri, baseUri);
+
+  const string resolvedUri = resolved->getUri();
+  const string fileName = resolved->getPath();
+  delete resolved;
+
+  time_t modified;
+  unsigned long size;
+  if (!getFileStamp(fileName, modified, size))
+    return resolveWithResolvers(uri, baseUri);
+
+  {
+#ifdef LIBSBML_USE_THREADS
+    std::lock_guard<std::mutex> lock(sDocumentCacheMutex);
+#endif
+    map<string, CachedDocument>::iterator cached = mCachedDocuments.find(resolvedUri);
+    if (cached != mCachedDocuments.end())
+    {
+      if (cached->second.modified == modified && cached->second.size == size)
+      {
+        ++mNumDocumentCacheHits;
+        mCachedDocumentOrder.splice(mCachedDocumentOrder.begin(),
+                                    mCachedDocumentOrder, cached->second.position);
+        return copyDocument(cached->second.document);
+      }
+
+      // the file has changed, so read it again
+      delete cached->second.document;
+      mCachedDocumentOrder.erase(cached->second.position);
+      mCachedDocuments.erase(cached);
+    }
+    ++mNumDocumentCacheMisses;
+  }
+
+  SBMLDocument* result = resolveWithResolvers(uri, baseUri);
+  if (result == NULL)
+    return NULL;
+
+#ifdef LIBSBML_USE_THREADS
+  std::lock_guard<std::mutex> lock(sDocumentCacheMutex);
+#endif
+  // another thread may have read the same file in the meantime, or the
+  // cache may have been turned off
+  if (mDocumentCacheSize > 0 && mCachedDocuments.find(resolvedUri) == mCachedDocuments.end())
+  {
+    CachedDocument entry;
+    entry.document = copyDocument(result);
+    entry.modified = modified;
+    entry.size = size;
+    entry.position = mCachedDocumentOrder.insert(mCachedDocumentOrder.begin(), resolvedUri);
+    mCachedDocuments.insert(make_pair(resolvedUri, entry));
+    shrinkDocumentCache(mDocumentCacheSize);
+  }
+
+  return result;
+}
+
+
+SBMLDocument*
+SBMLResolverRegistry::resolveWithResolvers(const std::string &uri, const std::string& baseUri) const
 {
   SBMLDocument* result = NULL;
   std::vector<const SBMLResolver*>::const_iterator it = mResolvers.begin();
@@ -186,6 +408,20 @@ SBMLResolverRegistry::resolveUri(const std::string &uri, const std::string baseU
   }
   return result;
 }
+
+
+void
+SBMLResolverRegistry::shrinkDocumentCache(unsigned int size) const
+{
+  while (mCachedDocuments.size() > size)
+  {
+    map<string, CachedDocument>::iterator last =
+      mCachedDocuments.find(mCachedDocumentOrder.back());
+    delete last->second.document;
+    mCachedDocuments.erase(last);
+    mCachedDocumentOrder.pop_back();
+  }
+}
 /** @endcond */
 
 
@@ -65,6 +65,8 @@
 #include <vector>
 #include <string>
 #include <set>
+#include <list>
+#include <ctime>
 
 
 LIBSBML_CPP_NAMESPACE_BEGIN
@@ -184,6 +186,106 @@ public:
    */
   static void deleteResolerRegistryInstance();
 
+
+  /**
+   * Sets the number of documents kept in the document cache of the
+   * registry.
+   *
+   * When the cache is on, a document that resolve() reads from a local
+   * file is kept, together with the modification time and size of the
+   * file.  When the same URI is resolved again, and the file has not
+   * changed since, resolve() returns a copy of the kept document instead
+   * of reading and parsing the file again; the copy is owned by the
+   * caller as before.  Since the registry is a singleton, the cache is
+   * shared by all the documents and conversions in the process.  When
+   * more documents would be kept than the given number, the ones used
+   * least recently are dropped.
+   *
+   * @param size the maximum number of documents to keep; @c 0, the
+   * default, turns the cache off and drops all the documents kept.
+   *
+   * @copydetails doc_returns_one_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   *
+   * @see getDocumentCacheSize()
+   * @see clearDocumentCache()
+   */
+  int setDocumentCacheSize(unsigned int size);
+
+
+  /**
+   * Returns the number of documents the document cache may keep.
+   *
+   * @return the maximum number of documents kept, or @c 0 if the cache
+   * is off.
+   *
+   * @see setDocumentCacheSize(@if java long@endif)
+   */
+  unsigned int getDocumentCacheSize() const;
+
+
+  /**
+   * Returns the number of documents currently kept in the document cache.
+   *
+   * @return the number of documents kept.
+   */
+  unsigned int getNumCachedDocuments() const;
+
+
+  /**
+   * Drops the document kept for the given URI from the document cache, so
+   * that it is read again the next time it is resolved.
+   *
+   * Documents whose file has changed are dropped anyway; this is for
+   * changes that leave the modification time and size of the file as
+   * they were.
+   *
+   * @param uri the URI to the target document.
+   * @param baseUri base URI, in case the URI is a relative one.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_OPERATION_FAILED, OperationReturnValues_t}
+   * if no document was kept for the URI.
+   */
+  int removeCachedDocument(const std::string &uri, const std::string baseUri="");
+
+
+  /**
+   * Drops all the documents kept in the document cache.
+   */
+  void clearDocumentCache();
+
+
+  /**
+   * Returns the number of times resolve() returned a copy of a document
+   * kept in the document cache.
+   *
+   * @return the number of cache hits since the statistics were last reset.
+   *
+   * @see resetDocumentCacheStatistics()
+   */
+  unsigned int getNumDocumentCacheHits() const;
+
+
+  /**
+   * Returns the number of times resolve() had to read a local file,
+   * because the document cache had no document for it, or the file had
+   * changed since.
+   *
+   * @return the number of cache misses since the statistics were last
+   * reset.
+   *
+   * @see resetDocumentCacheStatistics()
+   */
+  unsigned int getNumDocumentCacheMisses() const;
+
+
+  /**
+   * Sets the numbers of document cache hits and misses back to @c 0.
+   */
+  void resetDocumentCacheStatistics();
+
 protected:
 
   /** @cond doxygenLibsbmlInternal */
@@ -191,14 +293,43 @@ protected:
    * protected constructor, use the getInstance() method to access the registry.
    */
   SBMLResolverRegistry();
+
+
+  /**
+   * Asks each resolver in turn to resolve the given URI, without using
+   * the document cache.
+   */
+  SBMLDocument* resolveWithResolvers(const std::string &uri, const std::string& baseUri) const;
+
+
+  /**
+   * Drops the least recently used documents from the document cache
+   * until no more than the given number are left.
+   */
+  void shrinkDocumentCache(unsigned int size) const;
   /** @endcond */
 
 
 protected:
   /** @cond doxygenLibsbmlInternal */
+  struct CachedDocument
+  {
+    SBMLDocument*                    document;
+    time_t                           modified;
+    unsigned long                    size;
+    std::list<std::string>::iterator position;
+  };
+
   std::vector<const SBMLResolver*>  mResolvers;
   std::set<const SBMLDocument*>  mOwnedDocuments;
   static SBMLResolverRegistry* mInstance;
+
+  unsigned int mDocumentCacheSize;
+  // the documents by resolved URI, and the URIs, most recently used first
+  mutable std::map<std::string, CachedDocument> mCachedDocuments;
+  mutable std::list<std::string> mCachedDocumentOrder;
+  mutable unsigned int mNumDocumentCacheHits;
+  mutable unsigned int mNumDocumentCacheMisses;
   /** @endcond */
 };
 
@@ -140,7 +140,7 @@ START_TEST (test_comp_flatten_aggregate)
 }
 END_TEST
 
-void TestFlattenedPair(string file1, string file2)
+void TestFlattenedPair(string file1, string file2, int numThreads = 1)
 {
   string filename(TestDataDirectory);
   //string filename("C:\\Development\\libsbml\\src\\sbml\\packages\\comp\\util\\test\\test-data\\");
@@ -151,6 +151,7 @@ void TestFlattenedPair(string file1, string file2)
   props.addOption("flatten comp");
   props.addOption("basePath", filename);
   props.addOption("performValidation", true);
+  props.addOption("numThreads", numThreads);
 
   SBMLConverter* converter = SBMLConverterRegistry::getInstance().getConverterFor(props);
   
@@ -2105,6 +2106,75 @@ START_TEST(test_comp_flatten_boundary_replace2)
 END_TEST
 
 
+START_TEST(test_comp_flatten_on_threads)
+{
+  // the submodels of these are all instantiated from model definitions in
+  // the same document, so they are flattened on several threads if libSBML
+  // supports it, and the result must be the same
+  TestFlattenedPair("complexified2.xml", "complexified2_flat.xml", 4);
+  TestFlattenedPair("eg-simple-aggregate.xml", "eg-simple-aggregate_flat.xml", 4);
+  TestFlattenedPair("eg-replacement.xml", "eg-replacement_flat.xml", 4);
+  TestFlattenedPair("test9.xml", "test9_flat.xml", 4);
+  TestFlattenedPair("test12.xml", "test12_flat.xml", 4);
+  TestFlattenedPair("boundary_replace1.xml", "boundary_replace1_flat.xml", 4);
+
+  string filename(TestDataDirectory);
+  string cfile = filename + "test9.xml";
+  SBMLDocument* doc = readSBMLFromFile(cfile.c_str());
+  CompModelPlugin* mplug =
+    static_cast<CompModelPlugin*>(doc->getModel()->getPlugin("comp"));
+  fail_unless(mplug->getNumFlatteningThreads() == 1);
+  fail_unless(mplug->setNumFlatteningThreads(4) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(mplug->getNumFlatteningThreads() == 4);
+
+  delete doc;
+}
+END_TEST
+
+
+START_TEST(test_comp_flatten_instantiation_cache)
+{
+  // both submodels of this refer to the same external model definition,
+  // which is resolved once and kept for the second one
+  string filename(TestDataDirectory);
+  string cfile = filename + "enzyme_identical.xml";
+  SBMLDocument* doc = readSBMLFromFile(cfile.c_str());
+
+  ConversionProperties props;
+  props.addOption("flatten comp");
+  props.addOption("performValidation", false);
+
+  CompFlatteningConverter converter;
+  converter.setProperties(&props);
+  fail_unless(converter.getNumInstantiationCacheHits() == 0);
+  fail_unless(converter.getNumInstantiationCacheMisses() == 0);
+
+  converter.setDocument(doc);
+  fail_unless(converter.convert() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(converter.getNumInstantiationCacheHits() == 1);
+  fail_unless(converter.getNumInstantiationCacheMisses() == 1);
+
+  // the counts are those of the last conversion only
+  fail_unless(converter.convert() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(converter.getNumInstantiationCacheHits() == 0);
+  fail_unless(converter.getNumInstantiationCacheMisses() == 0);
+
+  delete doc;
+
+  // moddef1 is used on its own and below moddef2 and moddef3, and moddef2
+  // on its own and below moddef3; each is instantiated once and copied
+  // for the others
+  doc = readSBMLFromFile((filename + "test11.xml").c_str());
+  converter.setDocument(doc);
+  fail_unless(converter.convert() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(converter.getNumInstantiationCacheHits() == 3);
+  fail_unless(converter.getNumInstantiationCacheMisses() == 3);
+
+  delete doc;
+}
+END_TEST
+
+
 START_TEST(test_comp_flatten_conversion_factor)
 {
     TestFlattenedPair("conversion_factor.xml", "conversion_factor_flat.xml");
@@ -2275,6 +2345,8 @@ create_suite_TestFlatteningConverter (void)
   tcase_add_test(tcase, test_comp_flatten_test1_l3v2);
   tcase_add_test(tcase, test_comp_flatten_boundary_replace1);
   tcase_add_test(tcase, test_comp_flatten_boundary_replace2);
+  tcase_add_test(tcase, test_comp_flatten_on_threads);
+  tcase_add_test(tcase, test_comp_flatten_instantiation_cache);
 
   tcase_add_test(tcase, test_comp_flatten_conversion_factor);
   tcase_add_test(tcase, test_comp_flatten_conversion_factor2);
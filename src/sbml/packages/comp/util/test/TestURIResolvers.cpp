@@ -35,6 +35,7 @@
 #include <sbml/common/common.h>
 
 #include <sbml/SBMLReader.h>
+#include <sbml/SBMLWriter.h>
 #include <sbml/SBMLDocument.h>
 #include <sbml/packages/comp/util/SBMLUri.h>
 #include <sbml/packages/comp/util/SBMLFileResolver.h>
@@ -310,6 +311,62 @@ START_TEST (test_comp_resolverregistry_2)
   fail_unless(doc2 == NULL);
 }
 END_TEST
+
+
+START_TEST (test_comp_resolverregistry_document_cache)
+{
+  SBMLResolverRegistry &registry = SBMLResolverRegistry::getInstance();
+  string base = "file:" + string(TestDataDirectory) + "complexified.xml";
+  fail_unless(registry.getDocumentCacheSize() == 0);
+
+  // without the cache, nothing is kept
+  SBMLDocument* doc = registry.resolve("enzyme_model.xml", base);
+  fail_unless(doc != NULL);
+  delete doc;
+  fail_unless(registry.getNumCachedDocuments() == 0);
+  fail_unless(registry.getNumDocumentCacheMisses() == 0);
+
+  fail_unless(registry.setDocumentCacheSize(1) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(registry.getDocumentCacheSize() == 1);
+
+  SBMLDocument* doc1 = registry.resolve("enzyme_model.xml", base);
+  SBMLDocument* doc2 = registry.resolve("enzyme_model.xml", base);
+  fail_unless(doc1 != NULL);
+  fail_unless(doc2 != NULL);
+  fail_unless(doc1 != doc2);
+  fail_unless(writeSBMLToStdString(doc1) == writeSBMLToStdString(doc2));
+  fail_unless(registry.getNumCachedDocuments() == 1);
+  fail_unless(registry.getNumDocumentCacheHits() == 1);
+  fail_unless(registry.getNumDocumentCacheMisses() == 1);
+  delete doc1;
+  delete doc2;
+
+  // the least recently used document makes room for the next one
+  doc = registry.resolve("enzyme_identical.xml", base);
+  delete doc;
+  fail_unless(registry.getNumCachedDocuments() == 1);
+  fail_unless(registry.getNumDocumentCacheMisses() == 2);
+  fail_unless(registry.removeCachedDocument("enzyme_model.xml", base) == LIBSBML_OPERATION_FAILED);
+  fail_unless(registry.removeCachedDocument("enzyme_identical.xml", base) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(registry.getNumCachedDocuments() == 0);
+
+  // files that do not resolve are not counted
+  doc = registry.resolve("non-existent-file.really");
+  fail_unless(doc == NULL);
+  fail_unless(registry.getNumDocumentCacheMisses() == 2);
+
+  doc = registry.resolve("enzyme_model.xml", base);
+  delete doc;
+  fail_unless(registry.getNumCachedDocuments() == 1);
+  registry.clearDocumentCache();
+  fail_unless(registry.getNumCachedDocuments() == 0);
+
+  registry.resetDocumentCacheStatistics();
+  fail_unless(registry.getNumDocumentCacheHits() == 0);
+  fail_unless(registry.getNumDocumentCacheMisses() == 0);
+  fail_unless(registry.setDocumentCacheSize(0) == LIBSBML_OPERATION_SUCCESS);
+}
+END_TEST
   
   
 Suite *
@@ -328,6 +385,7 @@ create_suite_TestURIResolvers (void)
   tcase_add_test(tcase, test_comp_fileresolver_resolve_6);
   tcase_add_test(tcase, test_comp_resolverregistry_1);
   tcase_add_test(tcase, test_comp_resolverregistry_2);
+  tcase_add_test(tcase, test_comp_resolverregistry_document_cache);
   suite_add_tcase(suite, tcase);
 
   return suite;
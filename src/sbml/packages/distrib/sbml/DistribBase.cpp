@@ -174,7 +174,9 @@ DistribBase::isSetName() const
 int
 DistribBase::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -196,6 +198,7 @@ int
 DistribBase::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -193,6 +193,7 @@ ListOfUncertainties::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <Uncertainty*> (item);
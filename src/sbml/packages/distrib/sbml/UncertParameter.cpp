@@ -790,6 +790,23 @@ UncertParameter::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+UncertParameter::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetVar() && getRenamedId(mVar, renamed, newid))
+  {
+    setVar(newid);
+  }
+
+  if (isSetMath()) 
+  {
+      mMath->renameSIdRefs(renamed);
+  }
+}
+
 void
 UncertParameter::renameUnitSIdRefs(const std::string& oldid, const std::string& newid)
 {
@@ -806,6 +823,23 @@ UncertParameter::renameUnitSIdRefs(const std::string& oldid, const std::string&
     }
 }
 
+void
+UncertParameter::renameUnitSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+    renamePluginUnitSIdRefs(renamed);
+
+    std::string newid;
+    if (isSetUnits() && getRenamedId(mUnits, renamed, newid))
+    {
+        setUnits(newid);
+    }
+
+    if (isSetMath()) 
+    {
+        mMath->renameUnitSIdRefs(renamed);
+    }
+}
+
 /** @cond doxygenLibsbmlInternal */
 void
 UncertParameter::replaceSIDWithFunction(const std::string& id, const ASTNode* function)
@@ -386,6 +386,23 @@ UncertSpan::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+UncertSpan::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  UncertParameter::renameSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetVarLower() && getRenamedId(mVarLower, renamed, newid))
+  {
+    setVarLower(newid);
+  }
+
+  if (isSetVarUpper() && getRenamedId(mVarUpper, renamed, newid))
+  {
+    setVarUpper(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this UncertSpan object.
@@ -168,6 +168,7 @@ DynSBMLDocumentPlugin::checkConsistency()
   if (id)
   {
     id_validator.init();
+    id_validator.setProfile(doc->getValidationProfile(), "DynIdentifierConsistencyValidator");
     nerrors = id_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
@@ -184,6 +185,7 @@ DynSBMLDocumentPlugin::checkConsistency()
   if (sbml)
   {
     validator.init();
+    validator.setProfile(doc->getValidationProfile(), "DynConsistencyValidator");
     nerrors = validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
@@ -238,7 +238,9 @@ DynElement::setIdRef(const std::string& idRef)
 int
 DynElement::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -294,6 +296,7 @@ int
 DynElement::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -358,6 +361,18 @@ DynElement::renameSIdRefs(const std::string& oldid, const std::string& newid)
 
 }
 
+void
+DynElement::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetIdRef() == true && getRenamedId(mIdRef, renamed, newid))
+  {
+    setIdRef(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -861,6 +876,7 @@ ListOfDynElements::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
 	return static_cast <DynElement*> (item);
@@ -262,7 +262,9 @@ SpatialComponent::setVariable(const std::string& variable)
 int
 SpatialComponent::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -314,6 +316,7 @@ int
 SpatialComponent::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -359,6 +362,18 @@ SpatialComponent::renameSIdRefs(const std::string& oldid, const std::string& new
 
 }
 
+void
+SpatialComponent::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetVariable() == true && getRenamedId(mVariable, renamed, newid))
+  {
+    setVariable(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -862,6 +877,7 @@ ListOfSpatialComponents::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
 	return static_cast <SpatialComponent*> (item);
@@ -345,6 +345,12 @@ public:
    virtual void renameSIdRefs(const std::string& oldid, const std::string& newid);
 
 
+   /**
+    * @copydoc doc_renamesidrefmap_common
+    */
+   virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
+
   /**
    * Returns the XML element name of this object, which for SpatialComponent, is
    * always @c "spatialComponent".
@@ -335,6 +335,23 @@ FbcReactionPlugin::renameSIdRefs(const std::string& oldid, const std::string& ne
 /** @endcond */
 
 
+/** @cond doxygenLibsbmlInternal */
+void
+FbcReactionPlugin::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetLowerFluxBound())
+  {
+    if (SBase::getRenamedId(mLowerFluxBound, renamed, newid)) mLowerFluxBound=newid;
+  }
+  if (isSetUpperFluxBound())
+  {
+    if (SBase::getRenamedId(mUpperFluxBound, renamed, newid)) mUpperFluxBound=newid;
+  }
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 /*
  * Write values of XMLAttributes to the output stream.
@@ -167,6 +167,7 @@ FbcSBMLDocumentPlugin::checkConsistency()
   if (id)
   {
     id_validator.init();
+    id_validator.setProfile(doc->getValidationProfile(), "FbcIdentifierConsistencyValidator");
     nerrors = id_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
@@ -183,6 +184,7 @@ FbcSBMLDocumentPlugin::checkConsistency()
   if (sbml)
   {
     validator.init();
+    validator.setProfile(doc->getValidationProfile(), "FbcConsistencyValidator");
     nerrors = validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
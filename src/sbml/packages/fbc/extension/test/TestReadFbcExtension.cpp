@@ -578,6 +578,47 @@ START_TEST(test_FbcExtension_read_L3V2V1_check_id)
 }
 END_TEST
 
+START_TEST(test_FbcExtension_read_elementIdIndex)
+{
+  const char* s1 =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<sbml xmlns=\"http://www.sbml.org/sbml/level3/version1/core\" xmlns:fbc=\"http://www.sbml.org/sbml/level3/version1/fbc/version1\" level=\"3\" version=\"1\" fbc:required=\"false\">\n"
+    "  <model>\n"
+    "    <fbc:listOfObjectives fbc:activeObjective=\"obj1\">\n"
+    "      <fbc:objective fbc:id=\"obj1\" fbc:type=\"maximize\"/>\n"
+    "    </fbc:listOfObjectives>\n"
+    "    <fbc:listOfFluxBounds>\n"
+    "      <fbc:fluxBound fbc:id=\"bound1\" fbc:reaction=\"J0\" fbc:operation=\"equal\" fbc:value=\"10\"/>\n"
+    "    </fbc:listOfFluxBounds>\n"
+    "  </model>\n"
+    "</sbml>\n"
+    ;
+
+  SBMLDocument *document = readSBMLFromString(s1);
+  document->enableElementIdIndex(true);
+
+  FbcModelPlugin* mplugin = static_cast<FbcModelPlugin*>(document->getModel()->getPlugin("fbc"));
+  FluxBound* bound = mplugin->getFluxBound(0);
+  Objective* objective = mplugin->getObjective(0);
+
+  fail_unless(document->getElementBySId("bound1") == bound);
+  fail_unless(document->getElementBySId("obj1") == objective);
+
+  // the package setters keep the index up to date
+  fail_unless(bound->setId("bound2") == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(document->getElementBySId("bound1") == NULL);
+  fail_unless(document->getElementBySId("bound2") == bound);
+
+  fail_unless(objective->unsetId() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(document->getElementBySId("obj1") == NULL);
+
+  fail_unless(objective->setId("bound1") == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(document->getElementBySId("bound1") == objective);
+
+  delete document;
+}
+END_TEST
+
 START_TEST(test_FbcExtension_read_L3V1V3)
 {
   char *filename = safe_strcat(TestDataDirectory, "fbc_examplev3.xml");
@@ -621,6 +662,7 @@ create_suite_ReadFbcExtension(void)
   tcase_add_test(tcase, test_FbcExtension_read_and_convert_V1ToV2);
   tcase_add_test(tcase, test_FbcExtension_read_L3V2V1_check_id);
   tcase_add_test(tcase, test_FbcExtension_read_L3V1V3);
+  tcase_add_test(tcase, test_FbcExtension_read_elementIdIndex);
 
   suite_add_tcase(suite, tcase);
 
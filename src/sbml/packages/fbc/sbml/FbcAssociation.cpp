@@ -1074,6 +1074,7 @@ ListOfFbcAssociations::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <FbcAssociation*> (item);
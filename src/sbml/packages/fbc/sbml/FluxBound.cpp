@@ -172,7 +172,9 @@ FluxBound::isSetId () const
 int 
 FluxBound::setId (const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id,mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -183,6 +185,7 @@ int
 FluxBound::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
   if (mId.empty())
   {
     return LIBSBML_OPERATION_SUCCESS;
@@ -433,6 +436,18 @@ FluxBound::renameSIdRefs(const std::string& oldid, const std::string& newid)
 
 }
 
+void
+FluxBound::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetReaction() == true && getRenamedId(mReaction, renamed, newid))
+  {
+    setReaction(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of
@@ -1145,6 +1160,7 @@ ListOfFluxBounds::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <FluxBound*> (item);
@@ -266,7 +266,9 @@ FluxObjective::isSetVariableType() const
 int
 FluxObjective::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -368,6 +370,7 @@ int
 FluxObjective::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -463,6 +466,18 @@ FluxObjective::renameSIdRefs(const std::string& oldid, const std::string& newid)
 
 }
 
+void
+FluxObjective::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetReaction() == true && getRenamedId(mReaction, renamed, newid))
+  {
+    setReaction(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -1351,6 +1366,7 @@ ListOfFluxObjectives::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <FluxObjective*> (item);
@@ -222,7 +222,9 @@ GeneProduct::isSetAssociatedSpecies() const
 int
 GeneProduct::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -277,6 +279,7 @@ int
 GeneProduct::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -360,6 +363,18 @@ GeneProduct::renameSIdRefs(const std::string& oldid, const std::string& newid)
 
 }
 
+void
+GeneProduct::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetAssociatedSpecies() == true && getRenamedId(mAssociatedSpecies, renamed, newid))
+  {
+    setAssociatedSpecies(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -1159,6 +1174,7 @@ ListOfGeneProducts::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <GeneProduct*> (item);
@@ -289,7 +289,9 @@ GeneProductAssociation::isSetAssociation() const
 int
 GeneProductAssociation::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -370,6 +372,7 @@ int
 GeneProductAssociation::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
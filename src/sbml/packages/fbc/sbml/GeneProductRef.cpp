@@ -224,7 +224,9 @@ GeneProductRef::isSetName() const
 int
 GeneProductRef::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -266,6 +268,7 @@ int
 GeneProductRef::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -330,6 +333,18 @@ GeneProductRef::renameSIdRefs(const std::string& oldid, const std::string& newid
 
 }
 
+void
+GeneProductRef::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetGeneProduct() == true && getRenamedId(mGeneProduct, renamed, newid))
+  {
+    setGeneProduct(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -241,7 +241,9 @@ KeyValuePair::setId(const std::string& id)
 
   if (coreLevel == 3 && coreVersion == 1 && pkgVersion == 3)
   {
-    return SyntaxChecker::checkAndSetSId(id, mId);
+    int result = SyntaxChecker::checkAndSetSId(id, mId);
+    updateElementIdIndex();
+    return result;
   }
   else
   {
@@ -345,6 +347,7 @@ int
 KeyValuePair::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -252,6 +252,7 @@ ListOfKeyValuePairs::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <KeyValuePair*> (item);
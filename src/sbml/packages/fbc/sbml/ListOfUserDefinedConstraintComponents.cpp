@@ -205,6 +205,7 @@ ListOfUserDefinedConstraintComponents::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <UserDefinedConstraintComponent*> (item);
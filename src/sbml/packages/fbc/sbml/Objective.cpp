@@ -233,7 +233,9 @@ Objective::isSetType() const
 int
 Objective::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -286,6 +288,7 @@ int
 Objective::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -1486,6 +1489,7 @@ ListOfObjectives::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <Objective*> (item);
@@ -1547,6 +1551,14 @@ ListOfObjectives::renameSIdRefs(const std::string& oldid, const std::string& new
   ListOf::renameSIdRefs(oldid, newid);
 }
 
+void
+ListOfObjectives::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (getRenamedId(mActiveObjective, renamed, newid)) mActiveObjective = newid;
+  renamePluginSIdRefs(renamed);
+}
+
 
 /*
  * Creates a new Objective in this ListOfObjectives
@@ -1260,6 +1260,12 @@ public:
   */
   virtual void renameSIdRefs(const std::string& oldid, const std::string& newid);
 
+
+  /**
+   * @copydoc doc_renamesidrefmap_common
+   */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
 protected:
 
   /** @cond doxygenLibsbmlInternal */
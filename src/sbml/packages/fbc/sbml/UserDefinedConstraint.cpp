@@ -232,7 +232,9 @@ UserDefinedConstraint::setId(const std::string& id)
 
   if (coreLevel == 3 && coreVersion == 1 && pkgVersion == 3)
   {
-    return SyntaxChecker::checkAndSetSId(id, mId);
+    int result = SyntaxChecker::checkAndSetSId(id, mId);
+    updateElementIdIndex();
+    return result;
   }
   else
   {
@@ -328,6 +330,7 @@ int
 UserDefinedConstraint::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -612,6 +615,21 @@ UserDefinedConstraint::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+UserDefinedConstraint::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetLowerBound() && getRenamedId(mLowerBound, renamed, newid))
+  {
+    setLowerBound(newid);
+  }
+
+  if (isSetUpperBound() && getRenamedId(mUpperBound, renamed, newid))
+  {
+    setUpperBound(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this UserDefinedConstraint object.
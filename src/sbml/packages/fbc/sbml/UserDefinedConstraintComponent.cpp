@@ -276,7 +276,9 @@ UserDefinedConstraintComponent::setId(const std::string& id)
 
   if (coreLevel == 3 && coreVersion == 1 && pkgVersion == 3)
   {
-    return SyntaxChecker::checkAndSetSId(id, mId);
+    int result = SyntaxChecker::checkAndSetSId(id, mId);
+    updateElementIdIndex();
+    return result;
   }
   else
   {
@@ -434,6 +436,7 @@ int
 UserDefinedConstraintComponent::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -532,6 +535,16 @@ UserDefinedConstraintComponent::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+UserDefinedConstraintComponent::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetVariable() && getRenamedId(mVariable, renamed, newid))
+  {
+    setVariable(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this UserDefinedConstraintComponent object.
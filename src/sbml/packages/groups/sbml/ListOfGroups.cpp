@@ -188,6 +188,7 @@ ListOfGroups::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <Group*> (item);
@@ -217,7 +217,9 @@ Member::isSetMetaIdRef() const
 int
 Member::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -275,6 +277,7 @@ int
 Member::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -357,6 +360,18 @@ Member::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+Member::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetIdRef() && getRenamedId(mIdRef, renamed, newid))
+  {
+    setIdRef(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this Member object.
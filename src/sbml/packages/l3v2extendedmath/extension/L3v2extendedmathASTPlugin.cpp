@@ -221,6 +221,13 @@ int L3v2extendedmathASTPlugin::checkNumArguments(const ASTNode* node, std::strin
 }
 
 double L3v2extendedmathASTPlugin::evaluateASTNode(const ASTNode * node, const Model * m) const
+{
+  return SBMLTransforms::evaluateASTNode(node, m);
+}
+
+double L3v2extendedmathASTPlugin::evaluateASTNode(const ASTNode * node,
+                                      const SBMLTransforms::IdValueMap& values,
+                                      const Model * m) const
 {
   double result = numeric_limits<double>::quiet_NaN();
   switch(node->getType()) {
@@ -228,8 +235,8 @@ double L3v2extendedmathASTPlugin::evaluateASTNode(const ASTNode * node, const Mo
     if (node->getNumChildren() < 2) result = 0.0;
     else
     {
-      double dividend = SBMLTransforms::evaluateASTNode(node->getChild(0), m);
-      double divisor = SBMLTransforms::evaluateASTNode(node->getChild(1), m);
+      double dividend = SBMLTransforms::evaluateASTNode(node->getChild(0), values, m);
+      double divisor = SBMLTransforms::evaluateASTNode(node->getChild(1), values, m);
       double quotient = floor(dividend / divisor);
 
       result = dividend - (quotient * divisor);
@@ -237,19 +244,19 @@ double L3v2extendedmathASTPlugin::evaluateASTNode(const ASTNode * node, const Mo
     break;
 
   case AST_FUNCTION_MIN:
-    result = SBMLTransforms::evaluateASTNode(node->getChild(0), m);
+    result = SBMLTransforms::evaluateASTNode(node->getChild(0), values, m);
     for (unsigned int j = 1; j < node->getNumChildren(); j++)
     {
-      double nextValue = SBMLTransforms::evaluateASTNode(node->getChild(j), m);
+      double nextValue = SBMLTransforms::evaluateASTNode(node->getChild(j), values, m);
       if (nextValue < result) result = nextValue;
     }
     break;
 
   case AST_FUNCTION_MAX:
-    result = SBMLTransforms::evaluateASTNode(node->getChild(0), m);
+    result = SBMLTransforms::evaluateASTNode(node->getChild(0), values, m);
     for (unsigned int j = 1; j < node->getNumChildren(); j++)
     {
-      double nextValue = SBMLTransforms::evaluateASTNode(node->getChild(j), m);
+      double nextValue = SBMLTransforms::evaluateASTNode(node->getChild(j), values, m);
       if (nextValue > result) result = nextValue;
     }
     break;
@@ -259,10 +266,10 @@ double L3v2extendedmathASTPlugin::evaluateASTNode(const ASTNode * node, const Mo
     if (node->getNumChildren() == 0)
       result = 0.0;
     else if (node->getNumChildren() == 1)
-      result = SBMLTransforms::evaluateASTNode(node->getChild(0), m);
+      result = SBMLTransforms::evaluateASTNode(node->getChild(0), values, m);
     else
-      result = (double)((!(SBMLTransforms::evaluateASTNode(node->getChild(0), m)))
-        || (SBMLTransforms::evaluateASTNode(node->getChild(1), m)));
+      result = (double)((!(SBMLTransforms::evaluateASTNode(node->getChild(0), values, m)))
+        || (SBMLTransforms::evaluateASTNode(node->getChild(1), values, m)));
   }
   break;
 
@@ -270,8 +277,8 @@ double L3v2extendedmathASTPlugin::evaluateASTNode(const ASTNode * node, const Mo
     if (node->getNumChildren() < 2) result = 0.0;
     else 
     {      
-      result = floor(SBMLTransforms::evaluateASTNode(node->getChild(0), m) /
-        SBMLTransforms::evaluateASTNode(node->getChild(1), m));
+      result = floor(SBMLTransforms::evaluateASTNode(node->getChild(0), values, m) /
+        SBMLTransforms::evaluateASTNode(node->getChild(1), values, m));
     }
     break;
 
@@ -109,6 +109,11 @@ public:
 
   virtual int checkNumArguments(const ASTNode* function, std::stringstream& error) const;
   virtual double evaluateASTNode(const ASTNode * node, const Model * m = NULL) const;
+#ifndef SWIG
+  virtual double evaluateASTNode(const ASTNode * node,
+                                 const SBMLTransforms::IdValueMap& values,
+                                 const Model * m = NULL) const;
+#endif
   /** 
    * returns the unitDefinition for the ASTNode from a rem function
    */
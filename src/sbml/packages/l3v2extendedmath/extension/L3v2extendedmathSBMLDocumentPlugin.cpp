@@ -181,6 +181,7 @@ L3v2extendedmathSBMLDocumentPlugin::checkConsistency()
   if (math)
   {
     math_validator.init();
+    math_validator.setProfile(doc->getValidationProfile(), "L3v2extendedmathMathMLConsistencyValidator");
     nerrors = math_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0)
@@ -197,6 +198,7 @@ L3v2extendedmathSBMLDocumentPlugin::checkConsistency()
   if (units)
   {
     unit_validator.init();
+    unit_validator.setProfile(doc->getValidationProfile(), "L3v2extendedmathUnitConsistencyValidator");
     nerrors = unit_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0)
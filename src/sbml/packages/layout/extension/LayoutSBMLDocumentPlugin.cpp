@@ -188,6 +188,7 @@ LayoutSBMLDocumentPlugin::checkConsistency()
   if (id)
   {
     id_validator.init();
+    id_validator.setProfile(doc->getValidationProfile(), "LayoutIdentifierConsistencyValidator");
     nerrors = id_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
@@ -204,6 +205,7 @@ LayoutSBMLDocumentPlugin::checkConsistency()
   if (sbml)
   {
     validator.init();
+    validator.setProfile(doc->getValidationProfile(), "LayoutConsistencyValidator");
     nerrors = validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
@@ -369,7 +369,9 @@ bool BoundingBox::isSetId () const
   */
 int BoundingBox::setId (const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id,mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -379,6 +381,7 @@ int BoundingBox::setId (const std::string& id)
 int BoundingBox::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
   if (mId.empty())
   {
     return LIBSBML_OPERATION_SUCCESS;
@@ -66,6 +66,18 @@ CompartmentGlyph::renameSIdRefs(const std::string& oldid, const std::string& new
   }
 }
 
+void
+CompartmentGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetCompartmentId() && getRenamedId(mCompartment, renamed, newid)) 
+  {
+    setCompartmentId(newid);
+  }
+}
+
 /*
  * Default Constructor which creates a new CompartmentGlyph.  Id and
  * associated compartment id are unset.
@@ -209,7 +209,9 @@ bool Dimensions::isSetId () const
   */
 int Dimensions::setId (const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id,mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -219,6 +221,7 @@ int Dimensions::setId (const std::string& id)
 int Dimensions::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
   if (mId.empty())
   {
     return LIBSBML_OPERATION_SUCCESS;
@@ -83,6 +83,18 @@ GeneralGlyph::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+GeneralGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetReferenceId() && getRenamedId(mReference, renamed, newid)) 
+  {
+    setReferenceId(newid);
+  }
+}
+
 /*
  * Creates a new GeneralGlyph.  The list of reference and sub glyph is
  * empty and the id of the associated element is set to the empty string.
@@ -1164,6 +1176,7 @@ ListOfReferenceGlyphs::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <ReferenceGlyph*> (item);
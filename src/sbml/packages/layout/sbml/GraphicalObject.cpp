@@ -82,6 +82,18 @@ GraphicalObject::renameMetaIdRefs(const std::string& oldid, const std::string& n
   }
 }
 
+void
+GraphicalObject::renameMetaIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginMetaIdRefs(renamed);
+
+  std::string newid;
+  if (isSetMetaIdRef() && getRenamedId(mMetaIdRef, renamed, newid))
+  {
+    mMetaIdRef = newid;
+  }
+}
+
 /*
  * Creates a new GraphicalObject.
  */
@@ -391,7 +403,9 @@ int GraphicalObject::setId(const std::string& id)
 {
   if (id.empty())
     return unsetId();
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -401,6 +415,7 @@ int GraphicalObject::setId(const std::string& id)
 int GraphicalObject::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
   if (mId.empty())
   {
     return LIBSBML_OPERATION_SUCCESS;
@@ -1190,6 +1205,7 @@ ListOfGraphicalObjects::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <GraphicalObject*> (item);
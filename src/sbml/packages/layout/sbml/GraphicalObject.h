@@ -218,6 +218,12 @@ public:
    */
   virtual void renameMetaIdRefs(const std::string& oldid, const std::string& newid);
 
+
+  /**
+   * @copydoc doc_renamemetaidrefmap_common
+   */
+  virtual void renameMetaIdRefs(const std::map<std::string, std::string>& renamed);
+
   /**
    * Returns the value of the "id" attribute of this GraphicalObject.
    *
@@ -453,7 +453,9 @@ bool Layout::isSetName () const
   */
 int Layout::setId (const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id,mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 int Layout::setName (const std::string& name)
@@ -471,6 +473,7 @@ int Layout::setName (const std::string& name)
 int Layout::unsetId ()
 {
   mId.erase();
+  updateElementIdIndex();
   if (mId.empty())
   {
     return LIBSBML_OPERATION_SUCCESS;
@@ -1996,6 +1999,7 @@ ListOfLayouts::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <Layout*> (item);
@@ -2178,6 +2182,7 @@ ListOfCompartmentGlyphs::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <CompartmentGlyph*> (item);
@@ -2330,6 +2335,7 @@ ListOfSpeciesGlyphs::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <SpeciesGlyph*> (item);
@@ -2502,6 +2508,7 @@ ListOfReactionGlyphs::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <ReactionGlyph*> (item);
@@ -2651,6 +2658,7 @@ ListOfTextGlyphs::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <TextGlyph*> (item);
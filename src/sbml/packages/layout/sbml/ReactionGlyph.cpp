@@ -79,6 +79,17 @@ ReactionGlyph::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+ReactionGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetReactionId() && getRenamedId(mReaction, renamed, newid)) {
+    mReaction = newid;
+  }
+}
+
 
 /*
  * Creates a new ReactionGlyph.  The list of species reference glyph is
@@ -961,6 +972,7 @@ ListOfSpeciesReferenceGlyphs::remove (const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <SpeciesReferenceGlyph*> (item);
@@ -79,6 +79,22 @@ ReferenceGlyph::renameSIdRefs(const std::string& oldid, const std::string& newid
   }
 }
 
+void
+ReferenceGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetReferenceId() && getRenamedId(mReference, renamed, newid)) 
+  {
+    mReference = newid;
+  }
+  if (isSetGlyphId() && getRenamedId(mGlyph, renamed, newid))
+  {
+    mGlyph = newid;
+  }
+}
+
 /*
  * Creates a new ReferenceGlyph.  The id if the associated 
  * reference and the id of the associated glyph are set to the
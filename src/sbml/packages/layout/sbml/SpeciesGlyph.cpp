@@ -60,6 +60,18 @@ SpeciesGlyph::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+SpeciesGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetSpeciesId() && getRenamedId(mSpecies, renamed, newid)) 
+  {
+    mSpecies = newid;
+  }
+}
+
 /*
  * Creates a new SpeciesGlyph with the given SBML level, version, and package version
  * and the id of the associated species set to the empty string.
@@ -93,6 +93,22 @@ SpeciesReferenceGlyph::renameSIdRefs(const std::string& oldid, const std::string
   }
 }
 
+void
+SpeciesReferenceGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetSpeciesReferenceId() && getRenamedId(mSpeciesReference, renamed, newid)) 
+  {
+    mSpeciesReference = newid;
+  }
+  if (isSetSpeciesGlyphId() && getRenamedId(mSpeciesGlyph, renamed, newid))
+  {
+    mSpeciesGlyph = newid;
+  }
+}
+
 /*
  * Creates a new SpeciesReferenceGlyph.  The id if the associated species
  * reference and the id of the associated species glyph are set to the
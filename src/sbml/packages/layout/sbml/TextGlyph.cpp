@@ -65,6 +65,22 @@ TextGlyph::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+TextGlyph::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetGraphicalObjectId() && getRenamedId(mGraphicalObject, renamed, newid)) 
+  {
+    mGraphicalObject = newid;
+  }
+  if (isSetOriginOfTextId() && getRenamedId(mOriginOfText, renamed, newid))
+  {
+    mOriginOfText = newid;
+  }
+}
+
 /*
  * Creates a new TextGlyph the ids of the associated GraphicalObject and
  * the originOfText are set to the empty string. The actual text is set to
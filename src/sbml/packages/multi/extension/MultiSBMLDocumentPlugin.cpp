@@ -169,6 +169,7 @@ MultiSBMLDocumentPlugin::checkConsistency()
   if (id)
   {
     id_validator.init();
+    id_validator.setProfile(doc->getValidationProfile(), "MultiIdentifierConsistencyValidator");
     nerrors = id_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
@@ -185,6 +186,7 @@ MultiSBMLDocumentPlugin::checkConsistency()
   if (math)
   {
     math_validator.init();
+    math_validator.setProfile(doc->getValidationProfile(), "MultiMathMLConsistencyValidator");
     nerrors = math_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0)
@@ -201,6 +203,7 @@ MultiSBMLDocumentPlugin::checkConsistency()
   if (sbml)
   {
     validator.init();
+    validator.setProfile(doc->getValidationProfile(), "MultiConsistencyValidator");
     nerrors = validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
@@ -188,7 +188,9 @@ CompartmentReference::isSetCompartment() const
 int
 CompartmentReference::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -228,6 +230,7 @@ int
 CompartmentReference::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -292,6 +295,18 @@ CompartmentReference::renameSIdRefs(const std::string& oldid, const std::string&
 
 }
 
+void
+CompartmentReference::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetCompartment() == true && getRenamedId(mCompartment, renamed, newid))
+  {
+    setCompartment(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -693,6 +708,7 @@ ListOfCompartmentReferences::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <CompartmentReference*> (item);
@@ -212,7 +212,9 @@ InSpeciesTypeBond::isSetBindingSite2() const
 int
 InSpeciesTypeBond::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -270,6 +272,7 @@ int
 InSpeciesTypeBond::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -358,6 +361,23 @@ InSpeciesTypeBond::renameSIdRefs(const std::string& oldid, const std::string& ne
 
 }
 
+void
+InSpeciesTypeBond::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetBindingSite1() == true && getRenamedId(mBindingSite1, renamed, newid))
+  {
+    setBindingSite1(newid);
+  }
+
+  if (isSetBindingSite2() == true && getRenamedId(mBindingSite2, renamed, newid))
+  {
+    setBindingSite2(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -793,6 +813,7 @@ ListOfInSpeciesTypeBonds::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <InSpeciesTypeBond*> (item);
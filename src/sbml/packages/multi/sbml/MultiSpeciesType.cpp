@@ -222,7 +222,9 @@ MultiSpeciesType::isSetCompartment() const
 int
 MultiSpeciesType::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -264,6 +266,7 @@ int
 MultiSpeciesType::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -958,6 +961,18 @@ MultiSpeciesType::renameSIdRefs(const std::string& oldid, const std::string& new
 
 }
 
+void
+MultiSpeciesType::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetCompartment() == true && getRenamedId(mCompartment, renamed, newid))
+  {
+    setCompartment(newid);
+  }
+}
+
 
 List*
 MultiSpeciesType::getAllElements(ElementFilter* filter)
@@ -1577,6 +1592,7 @@ ListOfMultiSpeciesTypes::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <MultiSpeciesType*> (item);
@@ -204,7 +204,9 @@ OutwardBindingSite::isSetComponent() const
 int
 OutwardBindingSite::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -289,6 +291,7 @@ int
 OutwardBindingSite::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -364,6 +367,18 @@ OutwardBindingSite::renameSIdRefs(const std::string& oldid, const std::string& n
 
 }
 
+void
+OutwardBindingSite::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetComponent() == true && getRenamedId(mComponent, renamed, newid))
+  {
+    setComponent(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -793,6 +808,7 @@ ListOfOutwardBindingSites::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <OutwardBindingSite*> (item);
@@ -188,7 +188,9 @@ PossibleSpeciesFeatureValue::isSetNumericValue() const
 int
 PossibleSpeciesFeatureValue::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -228,6 +230,7 @@ int
 PossibleSpeciesFeatureValue::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -292,6 +295,18 @@ PossibleSpeciesFeatureValue::renameSIdRefs(const std::string& oldid, const std::
 
 }
 
+void
+PossibleSpeciesFeatureValue::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetNumericValue() == true && getRenamedId(mNumericValue, renamed, newid))
+  {
+    setNumericValue(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -691,6 +706,7 @@ ListOfPossibleSpeciesFeatureValues::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <PossibleSpeciesFeatureValue*> (item);
@@ -252,7 +252,9 @@ SpeciesFeature::isSetComponent() const
 int
 SpeciesFeature::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -322,6 +324,7 @@ int
 SpeciesFeature::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -587,6 +590,23 @@ SpeciesFeature::renameSIdRefs(const std::string& oldid, const std::string& newid
 
 }
 
+void
+SpeciesFeature::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetSpeciesFeatureType() == true && getRenamedId(mSpeciesFeatureType, renamed, newid))
+  {
+    setSpeciesFeatureType(newid);
+  }
+
+  if (isSetComponent() == true && getRenamedId(mComponent, renamed, newid))
+  {
+    setComponent(newid);
+  }
+}
+
 
 List*
 SpeciesFeature::getAllElements(ElementFilter* filter)
@@ -1179,6 +1199,7 @@ ListOfSpeciesFeatures::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <SpeciesFeature*> (item);
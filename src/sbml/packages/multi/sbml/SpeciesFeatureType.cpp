@@ -209,7 +209,9 @@ SpeciesFeatureType::isSetOccur() const
 int
 SpeciesFeatureType::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -243,6 +245,7 @@ int
 SpeciesFeatureType::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -951,6 +954,7 @@ ListOfSpeciesFeatureTypes::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <SpeciesFeatureType*> (item);
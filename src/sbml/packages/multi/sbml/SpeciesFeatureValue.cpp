@@ -185,6 +185,18 @@ SpeciesFeatureValue::renameSIdRefs(const std::string& oldid, const std::string&
 
 }
 
+void
+SpeciesFeatureValue::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetValue() == true && getRenamedId(mValue, renamed, newid))
+  {
+    setValue(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -538,6 +550,7 @@ ListOfSpeciesFeatureValues::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <SpeciesFeatureValue*> (item);
@@ -209,7 +209,9 @@ SpeciesTypeComponentIndex::isSetIdentifyingParent() const
 int
 SpeciesTypeComponentIndex::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -267,6 +269,7 @@ int
 SpeciesTypeComponentIndex::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -355,6 +358,23 @@ SpeciesTypeComponentIndex::renameSIdRefs(const std::string& oldid, const std::st
 
 }
 
+void
+SpeciesTypeComponentIndex::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetComponent() == true && getRenamedId(mComponent, renamed, newid))
+  {
+    setComponent(newid);
+  }
+
+  if (isSetIdentifyingParent() == true && getRenamedId(mIdentifyingParent, renamed, newid))
+  {
+    setIdentifyingParent(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -812,6 +832,7 @@ ListOfSpeciesTypeComponentIndexes::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <SpeciesTypeComponentIndex*> (item);
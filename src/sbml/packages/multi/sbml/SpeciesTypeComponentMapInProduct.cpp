@@ -230,7 +230,9 @@ SpeciesTypeComponentMapInProduct::isSetProductComponent() const
 int
 SpeciesTypeComponentMapInProduct::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -306,6 +308,7 @@ int
 SpeciesTypeComponentMapInProduct::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -418,6 +421,28 @@ SpeciesTypeComponentMapInProduct::renameSIdRefs(const std::string& oldid, const
 
 }
 
+void
+SpeciesTypeComponentMapInProduct::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetReactant() == true && getRenamedId(mReactant, renamed, newid))
+  {
+    setReactant(newid);
+  }
+
+  if (isSetReactantComponent() == true && getRenamedId(mReactantComponent, renamed, newid))
+  {
+    setReactantComponent(newid);
+  }
+
+  if (isSetProductComponent() == true && getRenamedId(mProductComponent, renamed, newid))
+  {
+    setProductComponent(newid);
+  }
+}
+
 
 
 /*
@@ -881,6 +906,7 @@ ListOfSpeciesTypeComponentMapInProducts::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <SpeciesTypeComponentMapInProduct*> (item);
@@ -212,7 +212,9 @@ SpeciesTypeInstance::isSetCompartmentReference() const
 int
 SpeciesTypeInstance::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -270,6 +272,7 @@ int
 SpeciesTypeInstance::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -358,6 +361,23 @@ SpeciesTypeInstance::renameSIdRefs(const std::string& oldid, const std::string&
 
 }
 
+void
+SpeciesTypeInstance::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetSpeciesType() == true && getRenamedId(mSpeciesType, renamed, newid))
+  {
+    setSpeciesType(newid);
+  }
+
+  if (isSetCompartmentReference() == true && getRenamedId(mCompartmentReference, renamed, newid))
+  {
+    setCompartmentReference(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -806,6 +826,7 @@ ListOfSpeciesTypeInstances::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <SpeciesTypeInstance*> (item);
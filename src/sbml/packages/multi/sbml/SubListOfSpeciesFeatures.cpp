@@ -156,7 +156,9 @@ SubListOfSpeciesFeatures::isSetName() const
 int
 SubListOfSpeciesFeatures::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -178,6 +180,7 @@ int
 SubListOfSpeciesFeatures::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -357,6 +360,7 @@ SubListOfSpeciesFeatures::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <SpeciesFeature*> (item);
@@ -174,6 +174,7 @@ QualSBMLDocumentPlugin::checkConsistency()
   if (id)
   {
     id_validator.init();
+    id_validator.setProfile(doc->getValidationProfile(), "QualIdentifierConsistencyValidator");
     nerrors = id_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
@@ -190,6 +191,7 @@ QualSBMLDocumentPlugin::checkConsistency()
   if (sbml)
   {
     validator.init();
+    validator.setProfile(doc->getValidationProfile(), "QualConsistencyValidator");
     nerrors = validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
@@ -206,6 +208,7 @@ QualSBMLDocumentPlugin::checkConsistency()
   if (math)
   {
     math_validator.init();
+    math_validator.setProfile(doc->getValidationProfile(), "QualMathConsistencyValidator");
     nerrors = math_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0) 
@@ -280,6 +280,16 @@ FunctionTerm::renameSIdRefs(const std::string& oldid, const std::string& newid)
 
 }
 
+void
+FunctionTerm::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+  if (isSetMath() == true)
+  {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -989,6 +999,7 @@ ListOfFunctionTerms::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <FunctionTerm*> (item);
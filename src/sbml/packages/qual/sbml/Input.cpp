@@ -272,7 +272,9 @@ Input::isSetThresholdLevel() const
 int
 Input::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -362,6 +364,7 @@ int
 Input::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -468,6 +471,18 @@ Input::renameSIdRefs(const std::string& oldid, const std::string& newid)
 
 }
 
+void
+Input::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetQualitativeSpecies() == true && getRenamedId(mQualitativeSpecies, renamed, newid))
+  {
+    setQualitativeSpecies(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -1300,6 +1315,7 @@ ListOfInputs::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <Input*> (item);
@@ -248,7 +248,9 @@ Output::isSetOutputLevel() const
 int
 Output::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -321,6 +323,7 @@ int
 Output::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -416,6 +419,18 @@ Output::renameSIdRefs(const std::string& oldid, const std::string& newid)
 
 }
 
+void
+Output::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetQualitativeSpecies() == true && getRenamedId(mQualitativeSpecies, renamed, newid))
+  {
+    setQualitativeSpecies(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -1203,6 +1218,7 @@ ListOfOutputs::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <Output*> (item);
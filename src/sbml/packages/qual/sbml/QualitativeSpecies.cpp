@@ -280,7 +280,9 @@ QualitativeSpecies::isSetMaxLevel() const
 int
 QualitativeSpecies::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -357,6 +359,7 @@ int
 QualitativeSpecies::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -473,6 +476,18 @@ QualitativeSpecies::renameSIdRefs(const std::string& oldid, const std::string& n
 
 }
 
+void
+QualitativeSpecies::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetCompartment() == true && getRenamedId(mCompartment, renamed, newid))
+  {
+    setCompartment(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this object
@@ -1296,6 +1311,7 @@ ListOfQualitativeSpecies::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <QualitativeSpecies*> (item);
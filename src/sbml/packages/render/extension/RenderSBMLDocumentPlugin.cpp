@@ -174,6 +174,7 @@ RenderSBMLDocumentPlugin::checkConsistency()
   if (id)
   {
     id_validator.init();
+    id_validator.setProfile(doc->getValidationProfile(), "RenderIdentifierConsistencyValidator");
     nerrors = id_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0)
@@ -189,6 +190,7 @@ RenderSBMLDocumentPlugin::checkConsistency()
   if (core)
   {
     core_validator.init();
+    core_validator.setProfile(doc->getValidationProfile(), "RenderConsistencyValidator");
     nerrors = core_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0)
@@ -441,7 +441,9 @@ ColorDefinition::isSetValue() const
 int
 ColorDefinition::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -613,6 +615,7 @@ int
 ColorDefinition::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
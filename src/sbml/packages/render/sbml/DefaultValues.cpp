@@ -1995,6 +1995,23 @@ DefaultValues::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+DefaultValues::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetStartHead() && getRenamedId(mStartHead, renamed, newid))
+  {
+    setStartHead(newid);
+  }
+
+  if (isSetEndHead() && getRenamedId(mEndHead, renamed, newid))
+  {
+    setEndHead(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this DefaultValues object.
@@ -330,7 +330,9 @@ GradientBase::isSetSpreadMethod() const
 int
 GradientBase::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -418,6 +420,7 @@ int
 GradientBase::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
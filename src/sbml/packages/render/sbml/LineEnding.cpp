@@ -340,7 +340,9 @@ LineEnding::isSetEnableRotationalMapping() const
 int
 LineEnding::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -364,6 +366,7 @@ int
 LineEnding::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -541,6 +541,7 @@ ListOfGlobalRenderInformation::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <GlobalRenderInformation*> (item);
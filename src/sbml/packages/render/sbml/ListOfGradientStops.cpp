@@ -244,6 +244,7 @@ ListOfGradientStops::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <GradientStop*> (item);
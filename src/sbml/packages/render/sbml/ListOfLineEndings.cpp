@@ -235,6 +235,7 @@ ListOfLineEndings::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <LineEnding*> (item);
@@ -239,6 +239,7 @@ ListOfLocalStyles::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <LocalStyle*> (item);
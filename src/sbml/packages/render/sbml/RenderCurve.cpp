@@ -548,6 +548,23 @@ RenderCurve::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+RenderCurve::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetStartHead() && getRenamedId(mStartHead, renamed, newid))
+  {
+    setStartHead(newid);
+  }
+
+  if (isSetEndHead() && getRenamedId(mEndHead, renamed, newid))
+  {
+    setEndHead(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this RenderCurve object.
@@ -412,7 +412,9 @@ RenderInformationBase::isSetBackgroundColor() const
 int
 RenderInformationBase::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -503,6 +505,7 @@ int
 RenderInformationBase::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -1163,6 +1166,18 @@ RenderInformationBase::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+RenderInformationBase::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  renamePluginSIdRefs(renamed);
+
+  std::string newid;
+  if (isSetReferenceRenderInformation() && getRenamedId(mReferenceRenderInformation, renamed, newid))
+  {
+    setReferenceRenderInformation(newid);
+  }
+}
+
 // render FIX ME
 /*
  * Returns the XML element name of this RenderInformationBase object.
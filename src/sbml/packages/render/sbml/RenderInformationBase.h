@@ -1250,6 +1250,12 @@ public:
   virtual void renameSIdRefs(const std::string& oldid,
                              const std::string& newid);
 
+
+  /**
+   * @copydoc doc_renamesidrefmap_common
+   */
+  virtual void renameSIdRefs(const std::map<std::string, std::string>& renamed);
+
 // render FIX ME
   /**
    * Returns the XML element name of this RenderInformationBase object.
@@ -174,6 +174,7 @@ SpatialSBMLDocumentPlugin::checkConsistency()
   if (id)
   {
     id_validator.init();
+    id_validator.setProfile(doc->getValidationProfile(), "SpatialIdentifierConsistencyValidator");
     nerrors = id_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0)
@@ -189,6 +190,7 @@ SpatialSBMLDocumentPlugin::checkConsistency()
   if (core)
   {
     core_validator.init();
+    core_validator.setProfile(doc->getValidationProfile(), "SpatialConsistencyValidator");
     nerrors = core_validator.validate(*doc);
     total_errors += nerrors;
     if (nerrors > 0)
@@ -220,7 +220,9 @@ AdjacentDomains::isSetDomain2() const
 int
 AdjacentDomains::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -278,6 +280,7 @@ int
 AdjacentDomains::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -365,6 +368,21 @@ AdjacentDomains::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+AdjacentDomains::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetDomain1() && getRenamedId(mDomain1, renamed, newid))
+  {
+    setDomain1(newid);
+  }
+
+  if (isSetDomain2() && getRenamedId(mDomain2, renamed, newid))
+  {
+    setDomain2(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this AdjacentDomains object.
@@ -285,6 +285,16 @@ AdvectionCoefficient::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+AdvectionCoefficient::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetVariable() && getRenamedId(mVariable, renamed, newid))
+  {
+    setVariable(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this AdvectionCoefficient object.
@@ -284,7 +284,9 @@ AnalyticVolume::isSetDomainType() const
 int
 AnalyticVolume::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -374,6 +376,7 @@ int
 AnalyticVolume::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -549,6 +552,21 @@ AnalyticVolume::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+AnalyticVolume::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetDomainType() && getRenamedId(mDomainType, renamed, newid))
+  {
+    setDomainType(newid);
+  }
+
+  if (isSetMath())
+  {
+    mMath->renameSIdRefs(renamed);
+  }
+}
+
 
 /*
  * Returns the XML element name of this AnalyticVolume object.
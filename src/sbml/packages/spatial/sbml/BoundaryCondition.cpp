@@ -421,6 +421,26 @@ BoundaryCondition::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+BoundaryCondition::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetVariable() && getRenamedId(mVariable, renamed, newid))
+  {
+    setVariable(newid);
+  }
+
+  if (isSetCoordinateBoundary() && getRenamedId(mCoordinateBoundary, renamed, newid))
+  {
+    setCoordinateBoundary(newid);
+  }
+
+  if (isSetBoundaryDomainType() && getRenamedId(mBoundaryDomainType, renamed, newid))
+  {
+    setBoundaryDomainType(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this BoundaryCondition object.
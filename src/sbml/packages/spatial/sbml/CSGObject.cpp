@@ -254,7 +254,9 @@ CSGObject::isSetOrdinal() const
 int
 CSGObject::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -306,6 +308,7 @@ int
 CSGObject::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -598,6 +601,16 @@ CSGObject::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+CSGObject::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetDomainType() && getRenamedId(mDomainType, renamed, newid))
+  {
+    setDomainType(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this CSGObject object.
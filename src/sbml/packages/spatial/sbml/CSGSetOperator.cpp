@@ -661,6 +661,21 @@ CSGSetOperator::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+CSGSetOperator::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetComplementA() && getRenamedId(mComplementA, renamed, newid))
+  {
+    setComplementA(newid);
+  }
+
+  if (isSetComplementB() && getRenamedId(mComplementB, renamed, newid))
+  {
+    setComplementB(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this CSGSetOperator object.
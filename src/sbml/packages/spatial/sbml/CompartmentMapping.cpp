@@ -225,7 +225,9 @@ CompartmentMapping::isSetUnitSize() const
 int
 CompartmentMapping::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -277,6 +279,7 @@ int
 CompartmentMapping::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -360,6 +363,16 @@ CompartmentMapping::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+CompartmentMapping::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetDomainType() && getRenamedId(mDomainType, renamed, newid))
+  {
+    setDomainType(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this CompartmentMapping object.
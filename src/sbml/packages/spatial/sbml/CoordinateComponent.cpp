@@ -277,7 +277,9 @@ CoordinateComponent::isSetUnit() const
 int
 CoordinateComponent::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -355,6 +357,7 @@ int
 CoordinateComponent::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -627,6 +630,16 @@ CoordinateComponent::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+CoordinateComponent::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetUnit() && getRenamedId(mUnit, renamed, newid))
+  {
+    setUnit(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this CoordinateComponent object.
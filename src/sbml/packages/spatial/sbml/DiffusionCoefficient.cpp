@@ -465,6 +465,16 @@ DiffusionCoefficient::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+DiffusionCoefficient::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetVariable() && getRenamedId(mVariable, renamed, newid))
+  {
+    setVariable(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this DiffusionCoefficient object.
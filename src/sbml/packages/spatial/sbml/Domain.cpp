@@ -202,7 +202,9 @@ Domain::isSetDomainType() const
 int
 Domain::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -242,6 +244,7 @@ int
 Domain::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -426,6 +429,16 @@ Domain::renameSIdRefs(const std::string& oldid, const std::string& newid)
   }
 }
 
+void
+Domain::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetDomainType() && getRenamedId(mDomainType, renamed, newid))
+  {
+    setDomainType(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this Domain object.
@@ -211,7 +211,9 @@ GeometryDefinition::isSetIsActive() const
 int
 GeometryDefinition::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -245,6 +247,7 @@ int
 GeometryDefinition::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
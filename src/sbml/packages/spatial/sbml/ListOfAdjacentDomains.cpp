@@ -195,6 +195,7 @@ ListOfAdjacentDomains::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <AdjacentDomains*> (item);
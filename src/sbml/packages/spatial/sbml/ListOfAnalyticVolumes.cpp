@@ -196,6 +196,7 @@ ListOfAnalyticVolumes::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <AnalyticVolume*> (item);
@@ -192,6 +192,7 @@ ListOfCSGObjects::remove(const std::string& sid)
   {
     item = *result;
     mItems.erase(result);
+    itemRemoved(item);
   }
 
   return static_cast <CSGObject*> (item);
@@ -261,6 +261,16 @@ OrdinalMapping::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+OrdinalMapping::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetGeometryDefinition() && getRenamedId(mGeometryDefinition, renamed, newid))
+  {
+    setGeometryDefinition(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this OrdinalMapping object.
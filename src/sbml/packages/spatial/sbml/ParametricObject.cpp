@@ -415,7 +415,9 @@ ParametricObject::isSetDataType() const
 int
 ParametricObject::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -610,6 +612,7 @@ int
 ParametricObject::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -741,6 +744,16 @@ ParametricObject::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+ParametricObject::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetDomainType() && getRenamedId(mDomainType, renamed, newid))
+  {
+    setDomainType(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this ParametricObject object.
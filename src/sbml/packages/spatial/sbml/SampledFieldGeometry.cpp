@@ -390,6 +390,16 @@ SampledFieldGeometry::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+SampledFieldGeometry::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetSampledField() && getRenamedId(mSampledField, renamed, newid))
+  {
+    setSampledField(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this SampledFieldGeometry object.
@@ -281,7 +281,9 @@ SampledVolume::isSetMaxValue() const
 int
 SampledVolume::setId(const std::string& id)
 {
-  return SyntaxChecker::checkAndSetSId(id, mId);
+  int result = SyntaxChecker::checkAndSetSId(id, mId);
+  updateElementIdIndex();
+  return result;
 }
 
 
@@ -357,6 +359,7 @@ int
 SampledVolume::unsetId()
 {
   mId.erase();
+  updateElementIdIndex();
 
   if (mId.empty() == true)
   {
@@ -480,6 +483,16 @@ SampledVolume::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+SampledVolume::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetDomainType() && getRenamedId(mDomainType, renamed, newid))
+  {
+    setDomainType(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this SampledVolume object.
@@ -201,6 +201,16 @@ SpatialSymbolReference::renameSIdRefs(const std::string& oldid,
   }
 }
 
+void
+SpatialSymbolReference::renameSIdRefs(const std::map<std::string, std::string>& renamed)
+{
+  std::string newid;
+  if (isSetSpatialRef() && getRenamedId(mSpatialRef, renamed, newid))
+  {
+    setSpatialRef(newid);
+  }
+}
+
 
 /*
  * Returns the XML element name of this SpatialSymbolReference object.
@@ -44,13 +44,41 @@
 #include <sbml/SBMLReader.h>
 #include <sbml/SBMLWriter.h>
 #include <sbml/SBMLTypes.h>
+#include <sbml/validator/ValidatorProfile.h>
+#include <sbml/validator/ValidationCallback.h>
 
 #include <string>
+#include <sstream>
+#include <vector>
 
 #include <check.h>
 
 LIBSBML_CPP_NAMESPACE_USE
 
+
+/*
+ * Records the ids of the failures it is given, and stops the checks
+ * after a given number of them when that is not zero.
+ */
+class RecordingCallback : public ValidationCallback
+{
+public:
+  RecordingCallback() : mFailAfter(0) {}
+
+  virtual int process(const SBMLError& error)
+  {
+    mIds.push_back(error.getErrorId());
+    if (mFailAfter > 0 && mIds.size() >= mFailAfter)
+    {
+      return LIBSBML_OPERATION_FAILED;
+    }
+    return LIBSBML_OPERATION_SUCCESS;
+  }
+
+  std::vector<unsigned int> mIds;
+  size_t mFailAfter;
+};
+
 BEGIN_C_DECLS
 
 
@@ -155,6 +183,441 @@ START_TEST (test_strict_unit_consistency_checks)
 END_TEST
 
 
+/*
+ * Checks two copies of a document, one with the passes run one after
+ * another and one with four threads, with each category switched off in
+ * turn, and fails unless both logs hold the same errors in the same
+ * order.  Both copies are deleted.
+ */
+static void
+compareThreadedChecks (SBMLDocument* serial, SBMLDocument* threaded)
+{
+  const SBMLErrorCategory_t categories[] =
+  {
+    LIBSBML_CAT_IDENTIFIER_CONSISTENCY,
+    LIBSBML_CAT_GENERAL_CONSISTENCY,
+    LIBSBML_CAT_SBO_CONSISTENCY,
+    LIBSBML_CAT_MATHML_CONSISTENCY,
+    LIBSBML_CAT_UNITS_CONSISTENCY,
+    LIBSBML_CAT_OVERDETERMINED_MODEL,
+    LIBSBML_CAT_MODELING_PRACTICE
+  };
+
+  fail_unless(threaded->setNumValidationThreads(4) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(threaded->getNumValidationThreads() == 4);
+  fail_unless(serial->getNumValidationThreads() == 1);
+
+  for (unsigned int c = 0; c <= 7; ++c)
+  {
+    serial->getErrorLog()->clearLog();
+    threaded->getErrorLog()->clearLog();
+    if (c > 0)
+    {
+      serial->setConsistencyChecks(categories[c - 1], false);
+      threaded->setConsistencyChecks(categories[c - 1], false);
+    }
+
+    unsigned int errors = serial->checkConsistency();
+
+    fail_unless(threaded->checkConsistency() == errors);
+    fail_unless(threaded->getNumErrors() == serial->getNumErrors());
+    for (unsigned int n = 0; n < serial->getNumErrors(); ++n)
+    {
+      fail_unless(threaded->getError(n)->getErrorId()
+                  == serial->getError(n)->getErrorId());
+      fail_unless(threaded->getError(n)->getMessage()
+                  == serial->getError(n)->getMessage());
+    }
+  }
+
+  delete serial;
+  delete threaded;
+}
+
+
+static void
+compareThreadedChecksOnFile (const char* file)
+{
+  std::string filename(TestDataDirectory);
+  filename += file;
+
+  compareThreadedChecks(readSBMLFromFile(filename.c_str()),
+                        readSBMLFromFile(filename.c_str()));
+}
+
+
+START_TEST (test_consistency_checks_threads)
+{
+  compareThreadedChecksOnFile("inconsistent.xml");
+  compareThreadedChecksOnFile("inconsistent-l2v1-units.xml");
+  compareThreadedChecksOnFile("l1v1-rules.xml");
+  compareThreadedChecksOnFile("l2v4-new.xml");
+  compareThreadedChecksOnFile("l3v1-new-invalid.xml");
+  compareThreadedChecksOnFile("l2v5-all.xml");
+
+  /* the other passes are not started when the identifiers are bad */
+  std::string filename(TestDataDirectory);
+  filename += "inconsistent.xml";
+  SBMLDocument* d = readSBMLFromFile(filename.c_str());
+  ValidatorProfile profile;
+  d->setValidationProfile(&profile);
+  d->setNumValidationThreads(4);
+
+  fail_unless(d->checkConsistency() == 1);
+  fail_unless(d->getError(0)->getErrorId() == 10301);
+  fail_unless(profile.getValidatorNumCalls("IdentifierConsistencyValidator") > 0);
+  fail_unless(profile.getValidatorNumCalls("ConsistencyValidator") == 0);
+  fail_unless(profile.getValidatorNumCalls("SBOConsistencyValidator") == 0);
+  fail_unless(profile.getValidatorNumCalls("MathMLConsistencyValidator") == 0);
+
+  delete d;
+}
+END_TEST
+
+
+/*
+ * Runs checkInternalConsistency() on two copies of a document, one with
+ * the round trip through the reader always made and one where it is only
+ * made when needed, and fails unless both logs hold the same errors in
+ * the same order.
+ */
+static void
+compareRoundTripChecks (SBMLDocument* doc, SBMLDocument* always)
+{
+  fail_unless(always->enableRoundTripReadChecks(true) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(always->isEnabledRoundTripReadChecks() == true);
+  fail_unless(doc->isEnabledRoundTripReadChecks() == false);
+
+  unsigned int errors = always->checkInternalConsistency();
+
+  fail_unless(doc->checkInternalConsistency() == errors);
+  fail_unless(doc->getNumErrors() == always->getNumErrors());
+  for (unsigned int n = 0; n < always->getNumErrors(); ++n)
+  {
+    fail_unless(doc->getError(n)->getErrorId()
+                == always->getError(n)->getErrorId());
+    fail_unless(doc->getError(n)->getSeverity()
+                == always->getError(n)->getSeverity());
+  }
+}
+
+
+static void
+compareRoundTripChecksOnFile (const char* file)
+{
+  std::string filename(TestDataDirectory);
+  filename += file;
+
+  SBMLDocument* doc    = readSBMLFromFile(filename.c_str());
+  SBMLDocument* always = readSBMLFromFile(filename.c_str());
+
+  compareRoundTripChecks(doc, always);
+
+  delete doc;
+  delete always;
+}
+
+
+START_TEST (test_consistency_checks_threads_components)
+{
+  /* enough components for the checks within each pass to be shared out
+   * between the threads, with failures from several passes in many of
+   * them */
+  SBMLDocument* d = new SBMLDocument(2, 4);
+  Model* m = d->createModel();
+  Compartment* c = m->createCompartment();
+  c->setId("c");
+  c->setSize(1);
+
+  for (unsigned int n = 0; n < 40; ++n)
+  {
+    std::ostringstream id;
+    id << n;
+
+    Species* s = m->createSpecies();
+    s->setId("s" + id.str());
+    s->setCompartment("c");
+    s->setInitialConcentration(1);
+
+    Parameter* p = m->createParameter();
+    p->setId("p" + id.str());
+    p->setConstant(false);
+    if (n % 3 == 0) p->setUnits("second");
+
+    AssignmentRule* ar = m->createAssignmentRule();
+    ar->setVariable("p" + id.str());
+    ar->setFormula("s" + id.str());
+
+    Reaction* r = m->createReaction();
+    r->setId("r" + id.str());
+    r->createReactant()->setSpecies("s" + id.str());
+    r->createKineticLaw()->setFormula("p" + id.str());
+  }
+
+  char* sbml = writeSBMLToString(d);
+  SBMLDocument* serial = readSBMLFromString(sbml);
+  SBMLDocument* threaded = readSBMLFromString(sbml);
+  free(sbml);
+  delete d;
+
+  fail_unless(serial->checkConsistency() == 80);
+  serial->getErrorLog()->clearLog();
+
+  compareThreadedChecks(serial, threaded);
+}
+END_TEST
+
+
+START_TEST (test_internal_consistency_checks_round_trip)
+{
+  compareRoundTripChecksOnFile("inconsistent.xml");
+  compareRoundTripChecksOnFile("l1v1-rules.xml");
+  compareRoundTripChecksOnFile("l2v4-new.xml");
+  compareRoundTripChecksOnFile("l2v5-all.xml");
+  compareRoundTripChecksOnFile("l3v1-new-invalid.xml");
+  compareRoundTripChecksOnFile("l3v2-all.xml");
+  compareRoundTripChecksOnFile("l3v2-extra.xml");
+
+  /* problems only the reader reports, in a document built in memory */
+  SBMLDocument* doc = new SBMLDocument(2, 4);
+  Model* m = doc->createModel();
+  Parameter* p = m->createParameter();
+  p->setId("p");
+  p->setConstant(false);
+  SBMLDocument* always = doc->clone();
+  compareRoundTripChecks(doc, always);
+  fail_unless(doc->getNumErrors() == 0);
+  delete always;
+
+  m->setNotes("<notes><p>no namespace</p></notes>");
+  AssignmentRule* ar = m->createAssignmentRule();
+  ar->setVariable("p");
+  ASTNode* math = SBML_parseL3Formula("max(1, 2)");
+  ar->setMath(math);
+  delete math;
+
+  always = doc->clone();
+  compareRoundTripChecks(doc, always);
+  fail_unless(doc->getNumErrors() > 0);
+  delete always;
+  delete doc;
+}
+END_TEST
+
+
+START_TEST (test_consistency_checks_profile)
+{
+  std::string filename(TestDataDirectory);
+  filename += "inconsistent.xml";
+
+  SBMLDocument* d     = readSBMLFromFile(filename.c_str());
+  SBMLDocument* plain = readSBMLFromFile(filename.c_str());
+  ValidatorProfile profile;
+
+  fail_unless(d->getValidationProfile() == NULL);
+  fail_unless(d->setValidationProfile(&profile) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(d->getValidationProfile() == &profile);
+  fail_unless(profile.getNumEntries() == 0);
+
+  unsigned int errors = d->checkConsistency();
+
+  fail_unless(errors == 1);
+  fail_unless(plain->checkConsistency() == errors);
+  fail_unless(d->getError(0)->getErrorId() == 10301);
+
+  int n = profile.getIndex("IdentifierConsistencyValidator", 10301);
+  fail_unless(n >= 0);
+  fail_unless(profile.getValidator(n) == "IdentifierConsistencyValidator");
+  fail_unless(profile.getConstraintId(n) == 10301);
+  fail_unless(profile.getNumCalls(n) == 1);
+  fail_unless(profile.getNumFailures(n) == 1);
+  fail_unless(profile.getTime(n) >= 0);
+  fail_unless(profile.getValidatorNumFailures("IdentifierConsistencyValidator") == 1);
+  fail_unless(profile.getValidatorNumCalls("IdentifierConsistencyValidator")
+              >= profile.getNumCalls(n));
+  fail_unless(profile.getIndex("ConsistencyValidator", 10301) == -1);
+
+  std::string json = profile.toJSON();
+  fail_unless(json.find("\"name\": \"IdentifierConsistencyValidator\"")
+              != std::string::npos);
+  fail_unless(json.find("{ \"id\": 10301, \"calls\": 1, \"failures\": 1,")
+              != std::string::npos);
+
+  /* the later validators add to the same profile */
+  d->getErrorLog()->clearLog();
+  plain->getErrorLog()->clearLog();
+  d->setConsistencyChecks(LIBSBML_CAT_IDENTIFIER_CONSISTENCY, false);
+  plain->setConsistencyChecks(LIBSBML_CAT_IDENTIFIER_CONSISTENCY, false);
+  errors = d->checkConsistency();
+
+  fail_unless(errors == 2);
+  fail_unless(plain->checkConsistency() == errors);
+  fail_unless(d->getError(0)->getErrorId() == 10214);
+  fail_unless(d->getError(1)->getErrorId() == 20612);
+  fail_unless(profile.getNumCalls(n) == 1);
+  fail_unless(profile.getValidatorNumCalls("ConsistencyValidator") > 0);
+  fail_unless(profile.getValidatorNumFailures("ConsistencyValidator") == 2);
+  fail_unless(profile.getNumFailures(
+              profile.getIndex("ConsistencyValidator", 20612)) == 1);
+  fail_unless(json.find("\"ConsistencyValidator\"") == std::string::npos);
+  fail_unless(profile.toJSON().find("\"ConsistencyValidator\"")
+              != std::string::npos);
+
+  SBMLDocument* copy = d->clone();
+  fail_unless(copy->getValidationProfile() == &profile);
+  delete copy;
+
+  profile.clear();
+  fail_unless(profile.getNumEntries() == 0);
+  fail_unless(profile.getIndex("IdentifierConsistencyValidator", 10301) == -1);
+  fail_unless(profile.getValidator(0) == "");
+  fail_unless(profile.getNumCalls(0) == 0);
+
+  d->setValidationProfile(NULL);
+  d->getErrorLog()->clearLog();
+  fail_unless(d->checkConsistency() == errors);
+  fail_unless(profile.getNumEntries() == 0);
+
+  delete d;
+  delete plain;
+}
+END_TEST
+
+
+START_TEST (test_consistency_checks_callback)
+{
+  std::string filename(TestDataDirectory);
+  filename += "l1v1-units-invalid.xml";
+
+  SBMLDocument* plain = readSBMLFromFile(filename.c_str());
+  unsigned int errors = plain->checkConsistency();
+  unsigned int numErrors = plain->getNumErrors();
+  fail_unless(numErrors > 3);
+
+  unsigned int firstError = numErrors;
+  for (unsigned int n = 0; n < numErrors; ++n)
+  {
+    if (plain->getError(n)->getSeverity() == LIBSBML_SEV_ERROR)
+    {
+      firstError = n;
+      break;
+    }
+  }
+  fail_unless(firstError > 0);
+  fail_unless(firstError < numErrors);
+
+  SBMLDocument* d = readSBMLFromFile(filename.c_str());
+  RecordingCallback callback;
+  fail_unless(d->getValidationCallback() == NULL);
+  fail_unless(d->setValidationCallback(&callback) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(d->getValidationCallback() == &callback);
+
+  /* each failure is passed to process() and logged, in the usual order */
+  fail_unless(d->checkConsistency() == errors);
+  fail_unless(callback.getNumReported() == numErrors);
+  fail_unless(callback.mIds.size() == numErrors);
+  fail_unless(callback.isStopped() == false);
+  fail_unless(d->getNumErrors() == numErrors);
+  for (unsigned int n = 0; n < numErrors; ++n)
+  {
+    fail_unless(callback.mIds[n] == plain->getError(n)->getErrorId());
+    fail_unless(d->getError(n)->getErrorId() == plain->getError(n)->getErrorId());
+  }
+
+  /* process() stops the checks */
+  callback.mIds.clear();
+  callback.mFailAfter = 2;
+  d->getErrorLog()->clearLog();
+  fail_unless(d->checkConsistency() == 2);
+  fail_unless(callback.isStopped() == true);
+  fail_unless(callback.getNumReported() == 2);
+  fail_unless(d->getNumErrors() == 2);
+  fail_unless(d->getError(1)->getErrorId() == plain->getError(1)->getErrorId());
+  callback.mFailAfter = 0;
+
+  /* so does the number of failures */
+  fail_unless(callback.getMaxErrors() == 0);
+  fail_unless(callback.setMaxErrors(3) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(callback.getMaxErrors() == 3);
+  callback.mIds.clear();
+  d->getErrorLog()->clearLog();
+  fail_unless(d->checkConsistency() == 3);
+  fail_unless(callback.isStopped() == true);
+  fail_unless(callback.mIds.size() == 3);
+  fail_unless(d->getNumErrors() == 3);
+  fail_unless(callback.setMaxErrors(0) == LIBSBML_OPERATION_SUCCESS);
+
+  /* and the severity of a failure */
+  fail_unless(callback.isSetStopSeverity() == false);
+  fail_unless(callback.getStopSeverity() == LIBSBML_SEV_NOT_APPLICABLE);
+  fail_unless(callback.setStopSeverity(LIBSBML_SEV_NOT_APPLICABLE)
+              == LIBSBML_INVALID_ATTRIBUTE_VALUE);
+  fail_unless(callback.isSetStopSeverity() == false);
+  fail_unless(callback.setStopSeverity(LIBSBML_SEV_ERROR)
+              == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(callback.isSetStopSeverity() == true);
+  fail_unless(callback.getStopSeverity() == LIBSBML_SEV_ERROR);
+  callback.mIds.clear();
+  d->getErrorLog()->clearLog();
+  d->checkConsistency();
+  fail_unless(callback.isStopped() == true);
+  fail_unless(callback.mIds.size() == firstError + 1);
+  fail_unless(d->getNumErrors() == firstError + 1);
+  fail_unless(d->getError(firstError)->getSeverity() == LIBSBML_SEV_ERROR);
+  fail_unless(callback.unsetStopSeverity() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(callback.isSetStopSeverity() == false);
+
+  /* the failures can be left out of the log, and are still counted */
+  fail_unless(callback.getKeepFailures() == true);
+  fail_unless(callback.setKeepFailures(false) == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(callback.getKeepFailures() == false);
+  callback.mIds.clear();
+  d->getErrorLog()->clearLog();
+  fail_unless(d->checkConsistency() == errors);
+  fail_unless(callback.isStopped() == false);
+  fail_unless(d->getNumErrors() == 0);
+  fail_unless(callback.mIds.size() == numErrors);
+  for (unsigned int n = 0; n < numErrors; ++n)
+  {
+    fail_unless(callback.mIds[n] == plain->getError(n)->getErrorId());
+  }
+
+  /* and the checks still end where they would have */
+  const char* files[] = { "inconsistent.xml", "l1v1-rules.xml",
+                          "l3v1-new-invalid.xml", "l2v5-all.xml" };
+  for (unsigned int f = 0; f < 4; ++f)
+  {
+    std::string other(TestDataDirectory);
+    other += files[f];
+    SBMLDocument* kept = readSBMLFromFile(other.c_str());
+    SBMLDocument* dropped = readSBMLFromFile(other.c_str());
+    kept->getErrorLog()->clearLog();
+    dropped->getErrorLog()->clearLog();
+    errors = kept->checkConsistency();
+
+    callback.mIds.clear();
+    dropped->setValidationCallback(&callback);
+    fail_unless(dropped->checkConsistency() == errors);
+    fail_unless(dropped->getNumErrors() == 0);
+    fail_unless(callback.mIds.size() == kept->getNumErrors());
+    for (unsigned int n = 0; n < callback.mIds.size(); ++n)
+    {
+      fail_unless(callback.mIds[n] == kept->getError(n)->getErrorId());
+    }
+
+    delete kept;
+    delete dropped;
+  }
+
+  d->setValidationCallback(NULL);
+  fail_unless(d->getValidationCallback() == NULL);
+
+  delete d;
+  delete plain;
+}
+END_TEST
+
+
 Suite *
 create_suite_TestConsistencyChecks (void)
 { 
@@ -164,6 +627,11 @@ create_suite_TestConsistencyChecks (void)
 
   tcase_add_test(tcase, test_consistency_checks);
   tcase_add_test(tcase, test_strict_unit_consistency_checks);
+  tcase_add_test(tcase, test_consistency_checks_threads);
+  tcase_add_test(tcase, test_consistency_checks_threads_components);
+  tcase_add_test(tcase, test_internal_consistency_checks_round_trip);
+  tcase_add_test(tcase, test_consistency_checks_profile);
+  tcase_add_test(tcase, test_consistency_checks_callback);
 
   suite_add_tcase(suite, tcase);
 
@@ -1292,6 +1292,42 @@ START_TEST ( test_Rule_clone )
 END_TEST
 
 
+START_TEST ( test_Rule_assignmentOperator_inList )
+{
+    Model m(3, 1);
+    Rule* rule = m.createAssignmentRule();
+    rule->setVariable("x");
+    InitialAssignment* ia = m.createInitialAssignment();
+    ia->setSymbol("x");
+    EventAssignment* ea = m.createEvent()->createEventAssignment();
+    ea->setVariable("x");
+
+    // the lists look the items up by getId() from here on
+    fail_unless(m.getRule("x") == rule);
+    fail_unless(m.getInitialAssignment("x") == ia);
+    fail_unless(m.getEvent(0)->getEventAssignment("x") == ea);
+
+    AssignmentRule otherRule(3, 1);
+    otherRule.setVariable("y");
+    *static_cast<AssignmentRule*>(rule) = otherRule;
+    fail_unless(m.getRule("y") == rule);
+    fail_unless(m.getRule("x") == NULL);
+
+    InitialAssignment otherIA(3, 1);
+    otherIA.setSymbol("y");
+    *ia = otherIA;
+    fail_unless(m.getInitialAssignment("y") == ia);
+    fail_unless(m.getInitialAssignment("x") == NULL);
+
+    EventAssignment otherEA(3, 1);
+    otherEA.setVariable("y");
+    *ea = otherEA;
+    fail_unless(m.getEvent(0)->getEventAssignment("y") == ea);
+    fail_unless(m.getEvent(0)->getEventAssignment("x") == NULL);
+}
+END_TEST
+
+
 START_TEST ( test_Species_copyConstructor )
 {
     Species* o1=new Species(2, 4);
@@ -1772,6 +1808,7 @@ create_suite_CopyAndClone (void)
   tcase_add_test( tcase, test_Rule_copyConstructor );
   tcase_add_test( tcase, test_Rule_assignmentOperator );
   tcase_add_test( tcase, test_Rule_clone );
+  tcase_add_test( tcase, test_Rule_assignmentOperator_inList );
   tcase_add_test( tcase, test_Species_copyConstructor );
   tcase_add_test( tcase, test_Species_assignmentOperator );
   tcase_add_test( tcase, test_Species_clone );
@@ -499,6 +499,177 @@ START_TEST (test_GetMultipleObjects_withFilter)
 }
 END_TEST
 
+START_TEST (test_GetMultipleObjects_indexMatchesWalk)
+{
+  SBMLReader        reader;
+  const char* files[] = { "multiple-ids.xml", "assignments-invalid.xml" };
+
+  for (unsigned int f = 0; f < 2; f++)
+  {
+    std::string filename(TestDataDirectory);
+    filename += files[f];
+
+    SBMLDocument* d = reader.readSBML(filename);
+    fail_unless(d->getModel() != NULL);
+
+    List* list = d->getAllElements();
+    std::vector<std::string> ids;
+    std::vector<std::string> metaids;
+    std::vector<SBase*> byId;
+    std::vector<SBase*> byMetaId;
+    for (ListIterator it = list->begin(); it != list->end(); ++it)
+    {
+      SBase* obj = static_cast<SBase*>(*it);
+      ids.push_back(obj->getId());
+      metaids.push_back(obj->getMetaId());
+      byId.push_back(d->getElementBySId(obj->getId()));
+      byMetaId.push_back(d->getElementByMetaId(obj->getMetaId()));
+    }
+    delete list;
+
+    fail_unless(d->isEnabledElementIdIndex() == false);
+    fail_unless(d->enableElementIdIndex(true) == LIBSBML_OPERATION_SUCCESS);
+    fail_unless(d->isEnabledElementIdIndex() == true);
+
+    for (size_t i = 0; i < ids.size(); i++)
+    {
+      fail_unless(d->getElementBySId(ids[i]) == byId[i]);
+      fail_unless(d->getElementByMetaId(metaids[i]) == byMetaId[i]);
+    }
+    fail_unless(d->getElementBySId("no_id") == NULL);
+    fail_unless(d->getElementByMetaId("no_metaid") == NULL);
+
+    delete d;
+  }
+}
+END_TEST
+
+
+START_TEST (test_GetMultipleObjects_indexTracksEdits)
+{
+  SBMLDocument* d = new SBMLDocument(3, 1);
+  d->enableElementIdIndex(true);
+  Model* m = d->createModel();
+  m->setId("m");
+
+  fail_unless(d->getElementBySId("m") == m);
+  fail_unless(d->getElementBySId("s1") == NULL);
+
+  Species* s = m->createSpecies();
+  s->setId("s1");
+  s->setMetaId("meta_s1");
+  fail_unless(d->getElementBySId("s1") == s);
+  fail_unless(d->getElementByMetaId("meta_s1") == s);
+
+  s->setId("s2");
+  fail_unless(d->getElementBySId("s1") == NULL);
+  fail_unless(d->getElementBySId("s2") == s);
+
+  s->unsetMetaId();
+  fail_unless(d->getElementByMetaId("meta_s1") == NULL);
+
+  Species other(3, 1);
+  other.setId("s3");
+  m->getListOfSpecies()->append(&other);
+  SBase* copy = d->getElementBySId("s3");
+  fail_unless(copy != NULL);
+  fail_unless(copy != &other);
+  fail_unless(copy == m->getSpecies("s3"));
+
+  Species* removed = m->removeSpecies("s2");
+  fail_unless(removed == s);
+  fail_unless(d->getElementBySId("s2") == NULL);
+  delete removed;
+
+  Reaction* r = m->createReaction();
+  r->setId("r1");
+  KineticLaw* kl = r->createKineticLaw();
+  LocalParameter* lp = kl->createLocalParameter();
+  lp->setId("k1");
+  lp->setMetaId("k1_meta");
+  // local parameters live in their own namespace
+  fail_unless(d->getElementBySId("r1") == r);
+  fail_unless(d->getElementBySId("k1") == NULL);
+  fail_unless(d->getElementByMetaId("k1_meta") == lp);
+
+  m->getListOfReactions()->removeFromParentAndDelete();
+  fail_unless(d->getElementBySId("r1") == NULL);
+  fail_unless(d->getElementByMetaId("k1_meta") == NULL);
+
+  // duplicated ids fall back to the document walk (first match)
+  Parameter* p1 = m->createParameter();
+  p1->setId("dup");
+  Compartment* c1 = m->createCompartment();
+  c1->setId("dup");
+  fail_unless(d->getElementBySId("dup") == c1);
+
+  d->enableElementIdIndex(false);
+  fail_unless(d->isEnabledElementIdIndex() == false);
+  fail_unless(d->getElementBySId("s3") == copy);
+
+  delete d;
+}
+END_TEST
+
+
+START_TEST (test_GetMultipleObjects_indexOutlivedElement)
+{
+  SBMLDocument* d = new SBMLDocument(3, 1);
+  d->enableElementIdIndex(true);
+  Model* m = d->createModel();
+  Parameter* p = m->createParameter();
+  p->setId("p");
+  fail_unless(d->getElementBySId("p") == p);
+
+  Parameter* removed = m->removeParameter(0);
+  fail_unless(d->getElementBySId("p") == NULL);
+  m->getListOfParameters()->appendAndOwn(removed);
+  fail_unless(d->getElementBySId("p") == removed);
+
+  removed = m->removeParameter(0);
+  delete d;
+  delete removed;
+}
+END_TEST
+
+
+START_TEST (test_GetMultipleObjects_indexDetachedElement)
+{
+  SBMLDocument* d = new SBMLDocument(3, 1);
+  d->enableElementIdIndex(true);
+  Model* m = d->createModel();
+  Species* s = m->createSpecies();
+  s->setId("s1");
+  Reaction* r = m->createReaction();
+  r->setId("r1");
+  SpeciesReference* sr = r->createReactant();
+  sr->setId("sr1");
+  fail_unless(d->getElementBySId("s1") == s);
+  fail_unless(d->getElementBySId("sr1") == sr);
+
+  // removed elements keep their parent and document, but are no longer
+  // part of the model
+  Species* removed = m->removeSpecies("s1");
+  removed->setId("zz");
+  removed->setMetaId("zz_meta");
+  fail_unless(d->getElementBySId("zz") == NULL);
+  fail_unless(d->getElementByMetaId("zz_meta") == NULL);
+
+  Reaction* removedReaction = m->removeReaction("r1");
+  sr->setId("sr2");
+  fail_unless(d->getElementBySId("sr1") == NULL);
+  fail_unless(d->getElementBySId("sr2") == NULL);
+
+  m->getListOfSpecies()->appendAndOwn(removed);
+  fail_unless(d->getElementBySId("zz") == removed);
+  fail_unless(d->getElementByMetaId("zz_meta") == removed);
+
+  delete removedReaction;
+  delete d;
+}
+END_TEST
+
+
 Suite *
 create_suite_GetMultipleObjects (void)
 {
@@ -513,6 +684,10 @@ create_suite_GetMultipleObjects (void)
   tcase_add_test(tcase, test_GetMultipleObjects_noAssignments);
   tcase_add_test(tcase, test_GetMultipleObjects_allElements);
   tcase_add_test(tcase, test_GetMultipleObjects_withFilter);
+  tcase_add_test(tcase, test_GetMultipleObjects_indexMatchesWalk);
+  tcase_add_test(tcase, test_GetMultipleObjects_indexTracksEdits);
+  tcase_add_test(tcase, test_GetMultipleObjects_indexOutlivedElement);
+  tcase_add_test(tcase, test_GetMultipleObjects_indexDetachedElement);
 
 
   suite_add_tcase(suite, tcase);
@@ -316,6 +316,54 @@ START_TEST(test_ListOf_sort_rules)
 END_TEST
 
 
+START_TEST(test_ListOf_getById)
+{
+    Model_t* m = Model_create(3, 1);
+
+    Species_t* s1 = Model_createSpecies(m);
+    s1->setId("s1");
+    Species_t* s2 = Model_createSpecies(m);
+    s2->setId("s2");
+
+    fail_unless(Model_getSpeciesById(m, "s1") == s1);
+    fail_unless(Model_getSpeciesById(m, "s2") == s2);
+    fail_unless(Model_getSpeciesById(m, "s3") == NULL);
+
+    // appending after a lookup
+    Species_t* s3 = Model_createSpecies(m);
+    s3->setId("s3");
+    fail_unless(Model_getSpeciesById(m, "s3") == s3);
+
+    // renaming
+    s1->setId("s4");
+    fail_unless(Model_getSpeciesById(m, "s1") == NULL);
+    fail_unless(Model_getSpeciesById(m, "s4") == s1);
+
+    // the first of several items with the same id
+    s3->setId("s2");
+    fail_unless(Model_getSpeciesById(m, "s2") == s2);
+    s2->setId("s5");
+    fail_unless(Model_getSpeciesById(m, "s2") == s3);
+
+    // removing shifts the positions of later items
+    Species_free(Model_removeSpecies(m, 0));
+    fail_unless(Model_getSpeciesById(m, "s4") == NULL);
+    fail_unless(Model_getSpeciesById(m, "s5") == s2);
+    fail_unless(Model_getSpeciesById(m, "s2") == s3);
+
+    // rules are found by their variable
+    Rule_t* r = Model_createAssignmentRule(m);
+    r->setVariable("x");
+    fail_unless(Model_getRuleByVar(m, "x") == r);
+    r->setVariable("y");
+    fail_unless(Model_getRuleByVar(m, "x") == NULL);
+    fail_unless(Model_getRuleByVar(m, "y") == r);
+
+    Model_free(m);
+}
+END_TEST
+
+
 
 
 Suite *
@@ -333,6 +381,7 @@ create_suite_ListOf (void)
   tcase_add_test(tcase, test_ListOf_sort      );
   tcase_add_test(tcase, test_ListOf_sort_meta );
   tcase_add_test(tcase, test_ListOf_sort_rules);
+  tcase_add_test(tcase, test_ListOf_getById   );
 
   suite_add_tcase(suite, tcase);
 
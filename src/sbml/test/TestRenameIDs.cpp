@@ -249,6 +249,91 @@ START_TEST (test_RenameIDs)
 END_TEST
 
 
+START_TEST (test_RenameIDs_map)
+{
+  SBMLReader        reader;
+
+  std::string filename(TestDataDirectory);
+  filename += "multiple-ids.xml";
+
+  SBMLDocument* d1 = reader.readSBML(filename);
+  SBMLDocument* d2 = reader.readSBML(filename);
+
+  if (d1 == NULL || d1->getModel() == NULL || d2 == NULL || d2->getModel() == NULL)
+  {
+    fail("readSBML(\"multiple-ids.xml\") returned a NULL pointer.");
+  }
+
+  std::map<std::string, std::string> sids;
+  sids["comp"] = "comp_new";
+  sids["C"] = "C_new";
+  sids["conv"] = "conv_new";
+  sids["b"] = "b_new";
+  sids["b2"] = "b2_new";
+  sids["x"] = "x_new";
+  sids["y"] = "y_new";
+  std::map<std::string, std::string> unitsids;
+  unitsids["volume"] = "volume_new";
+  unitsids["substance"] = "substance_new";
+  unitsids["item"] = "item_new";
+  unitsids["second"] = "second_new";
+  unitsids["litre"] = "litre_new";
+  unitsids["candela"] = "candela_new";
+  unitsids["farad"] = "farad_new";
+  unitsids["coulomb"] = "coulomb_new";
+
+  //Renaming with the maps must give the same model as renaming one id at a time.
+  List* allElements = d1->getAllElements();
+  for (ListIterator iter = allElements->begin(); iter != allElements->end(); ++iter)
+  {
+    SBase* obj = static_cast<SBase*>(*iter);
+    std::map<std::string, std::string>::const_iterator it;
+    for (it = sids.begin(); it != sids.end(); ++it)
+    {
+      obj->renameSIdRefs(it->first, it->second);
+    }
+    for (it = unitsids.begin(); it != unitsids.end(); ++it)
+    {
+      obj->renameUnitSIdRefs(it->first, it->second);
+    }
+  }
+  delete allElements;
+
+  allElements = d2->getAllElements();
+  for (ListIterator iter = allElements->begin(); iter != allElements->end(); ++iter)
+  {
+    SBase* obj = static_cast<SBase*>(*iter);
+    obj->renameSIdRefs(sids);
+    obj->renameUnitSIdRefs(unitsids);
+  }
+  delete allElements;
+
+  char* xml1 = writeSBMLToString(d1);
+  char* xml2 = writeSBMLToString(d2);
+  std::string xmlstr(xml2);
+  fail_unless(xmlstr == xml1);
+  fail_unless(xmlstr.find("comp_new") != std::string::npos);
+  fail_unless(xmlstr.find("volume_new") != std::string::npos);
+  safe_free(xml1);
+  safe_free(xml2);
+
+  //Each reference is renamed at most once, so ids can be swapped.
+  Species* sp = d2->getModel()->getSpecies(0);
+  std::string compartment = sp->getCompartment();
+  std::map<std::string, std::string> swap;
+  swap[compartment] = "other";
+  swap["other"] = compartment;
+  sp->renameSIdRefs(swap);
+  fail_unless(sp->getCompartment() == "other");
+  sp->renameSIdRefs(swap);
+  fail_unless(sp->getCompartment() == compartment);
+
+  delete d1;
+  delete d2;
+}
+END_TEST
+
+
 
 
 Suite *
@@ -259,6 +344,7 @@ create_suite_RenameIDs (void)
 
 
   tcase_add_test(tcase, test_RenameIDs);
+  tcase_add_test(tcase, test_RenameIDs_map);
 
 
   suite_add_tcase(suite, tcase);
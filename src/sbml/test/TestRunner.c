@@ -298,6 +298,7 @@ main (int argc, char* argv[])
   srunner_add_suite( runner, create_suite_SBMLConvertFromL3V2           () );
   srunner_add_suite( runner, create_suite_SBMLDocument                  () );
   srunner_add_suite( runner, create_suite_SBMLError                     () );
+  srunner_add_suite( runner, create_suite_SBMLReader                    () );
   srunner_add_suite( runner, create_suite_TestReadFromFile1             () );
   srunner_add_suite( runner, create_suite_TestReadFromFile2             () );
   srunner_add_suite( runner, create_suite_TestReadFromFile3             () );
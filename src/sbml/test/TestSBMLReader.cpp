@@ -0,0 +1,174 @@
+/**
+ * \file    TestSBMLReader.cpp
+ * \brief   SBMLReader chunk size and memory mapping unit tests
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/common/common.h>
+#include <sbml/SBMLReader.h>
+#include <sbml/SBMLWriter.h>
+#include <sbml/SBMLTypes.h>
+
+#include <string>
+
+#include <check.h>
+
+
+
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+extern char *TestDataDirectory;
+
+
+static std::string
+readAndWrite (SBMLReader& reader, const std::string& filename)
+{
+  SBMLDocument* d = reader.readSBMLFromFile(filename);
+
+  fail_unless( d != NULL );
+  fail_unless( d->getNumErrors() == 0 );
+
+  char* written = writeSBMLToString(d);
+  std::string result = written;
+
+  safe_free(written);
+  delete d;
+
+  return result;
+}
+
+
+START_TEST (test_SBMLReader_chunkSize)
+{
+  SBMLReader reader;
+
+  fail_unless( reader.getChunkSize() == 8192 );
+  fail_unless( reader.getMemoryMapThreshold() == 1048576 );
+
+  fail_unless( reader.setChunkSize(0) == LIBSBML_INVALID_ATTRIBUTE_VALUE );
+  fail_unless( reader.getChunkSize() == 8192 );
+
+  fail_unless( reader.setChunkSize(1 << 20) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( reader.getChunkSize() == 1 << 20 );
+
+  reader.setMemoryMapThreshold(4096);
+  fail_unless( reader.getMemoryMapThreshold() == 4096 );
+}
+END_TEST
+
+
+START_TEST (test_SBMLReader_readSmallChunks)
+{
+  std::string filename(TestDataDirectory);
+  filename += "l2v3-all.xml";
+
+  SBMLReader reader;
+  std::string expected = readAndWrite(reader, filename);
+
+  reader.setChunkSize(7);
+  fail_unless( readAndWrite(reader, filename) == expected );
+
+  reader.setChunkSize(1 << 20);
+  fail_unless( readAndWrite(reader, filename) == expected );
+}
+END_TEST
+
+
+START_TEST (test_SBMLReader_readStringSmallChunks)
+{
+  const char* xml =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<sbml xmlns=\"http://www.sbml.org/sbml/level2/version4\" "
+    "level=\"2\" version=\"4\">\n"
+    "  <model id=\"m\">\n"
+    "    <listOfCompartments>\n"
+    "      <compartment id=\"c\"/>\n"
+    "    </listOfCompartments>\n"
+    "  </model>\n"
+    "</sbml>\n";
+
+  SBMLReader reader;
+  reader.setChunkSize(3);
+
+  SBMLDocument* d = reader.readSBMLFromString(xml);
+
+  fail_unless( d->getNumErrors() == 0 );
+  fail_unless( d->getModel() != NULL );
+  fail_unless( d->getModel()->getId() == "m" );
+  fail_unless( d->getModel()->getCompartment("c") != NULL );
+
+  delete d;
+}
+END_TEST
+
+
+START_TEST (test_SBMLReader_readMapped)
+{
+  std::string filename(TestDataDirectory);
+  filename += "l2v3-all.xml";
+
+  SBMLReader reader;
+  std::string expected = readAndWrite(reader, filename);
+
+  reader.setMemoryMapThreshold(1);
+  fail_unless( readAndWrite(reader, filename) == expected );
+
+  reader.setChunkSize(5);
+  fail_unless( readAndWrite(reader, filename) == expected );
+}
+END_TEST
+
+
+START_TEST (test_SBMLReader_readMappedMissingFile)
+{
+  std::string filename(TestDataDirectory);
+  filename += "no-such-file.xml";
+
+  SBMLReader reader;
+  reader.setMemoryMapThreshold(1);
+
+  SBMLDocument* d = reader.readSBMLFromFile(filename);
+
+  fail_unless( d->getNumErrors() == 1 );
+  fail_unless( d->getError(0)->getErrorId() == XMLFileUnreadable );
+
+  delete d;
+}
+END_TEST
+
+
+Suite *
+create_suite_SBMLReader (void)
+{
+  Suite *suite = suite_create("SBMLReader");
+  TCase *tcase = tcase_create("SBMLReader");
+
+  tcase_add_test(tcase, test_SBMLReader_chunkSize                 );
+  tcase_add_test(tcase, test_SBMLReader_readSmallChunks           );
+  tcase_add_test(tcase, test_SBMLReader_readStringSmallChunks     );
+  tcase_add_test(tcase, test_SBMLReader_readMapped                );
+  tcase_add_test(tcase, test_SBMLReader_readMappedMissingFile     );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+END_C_DECLS
@@ -50,6 +50,11 @@
 #include <check.h>
 
 #include <iostream>
+#include <vector>
+
+#ifdef LIBSBML_USE_THREADS
+#include <thread>
+#endif
 
 LIBSBML_CPP_NAMESPACE_USE
 
@@ -889,7 +894,7 @@ START_TEST(test_SBMLTransforms_L3V2AssignmentNoMath)
 
   SBMLDocument* d = readSBMLFromFile(filename.c_str());
 
-  SBMLTransforms::clearComponentValues();
+  SBMLTransforms::clearComponentValues(d->getModel());
   fail_unless(d->getModel() != NULL);
   SBMLTransforms::IdValueMap values;
   SBMLTransforms::getComponentValuesForModel(d->getModel(), values);
@@ -909,7 +914,7 @@ START_TEST(test_SBMLTransforms_StoichiometryMath)
 
   SBMLDocument* d = readSBMLFromFile(filename.c_str());
 
-  SBMLTransforms::clearComponentValues();
+  SBMLTransforms::clearComponentValues(d->getModel());
   fail_unless(d->getModel() != NULL);
   SBMLTransforms::IdValueMap values;
   SBMLTransforms::getComponentValuesForModel(d->getModel(), values);
@@ -954,6 +959,215 @@ START_TEST(test_SBMLTransforms_evaluateAST_L2SpeciesReference)
 }
 END_TEST
 
+START_TEST (test_SBMLTransforms_evaluateWithModelValues)
+{
+  std::string filename(TestDataDirectory);
+  filename += "initialAssignments.xml";
+
+  SBMLDocument* d1 = readSBMLFromFile(filename.c_str());
+  SBMLDocument* d2 = d1->clone();
+  Model* m1 = d1->getModel();
+  Model* m2 = d2->getModel();
+  m2->getParameter("k1")->setValue(1.0);
+
+  ASTNode* node = SBML_parseL3Formula("compartment");
+
+  // each model has values of its own
+  fail_unless(util_isEqual(SBMLTransforms::evaluateASTNode(node, m1), 25.0));
+  fail_unless(util_isEqual(SBMLTransforms::evaluateASTNode(node, m2), 50.0));
+  fail_unless(util_isEqual(SBMLTransforms::evaluateASTNode(node, m1), 25.0));
+
+  // values that were not mapped follow the model
+  m1->getParameter("k1")->setValue(2.0);
+  fail_unless(util_isEqual(SBMLTransforms::evaluateASTNode(node, m1), 100.0));
+
+  // mapped values are kept until they are cleared
+  SBMLTransforms::mapComponentValues(m1);
+  m1->getParameter("k1")->setValue(1.0);
+  fail_unless(util_isEqual(SBMLTransforms::evaluateASTNode(node, m1), 100.0));
+  SBMLTransforms::clearComponentValues(m1);
+  fail_unless(util_isEqual(SBMLTransforms::evaluateASTNode(node, m1), 50.0));
+
+  // expanding the initial assignments clears them too
+  SBMLTransforms::mapComponentValues(m1);
+  m1->getParameter("k1")->setValue(2.0);
+  fail_unless(SBMLTransforms::expandInitialAssignments(m1));
+  fail_unless(m1->getNumInitialAssignments() == 0);
+  fail_unless(util_isEqual(SBMLTransforms::evaluateASTNode(node, m1), 100.0));
+
+  // and a copy of a model does not take over the values of the one before
+  SBMLTransforms::mapComponentValues(m2);
+  *m2 = *m1;
+  fail_unless(util_isEqual(SBMLTransforms::evaluateASTNode(node, m2), 100.0));
+
+  delete node;
+  delete d2;
+  delete d1;
+}
+END_TEST
+
+
+#ifdef LIBSBML_USE_THREADS
+/*
+ * Evaluates and expands the initial assignments of its own documents
+ * while other threads do the same on theirs.
+ */
+static void
+expandDocuments(std::vector<SBMLDocument*>* docs, unsigned int* failures)
+{
+  for (size_t n = 0; n < docs->size(); ++n)
+  {
+    Model* m = (*docs)[n]->getModel();
+
+    SBMLTransforms::IdValueMap values;
+    SBMLTransforms::getComponentValuesForModel(m, values);
+    double size = SBMLTransforms::evaluateASTNode(
+               m->getInitialAssignment(0)->getMath(), values, m);
+    if (!util_isEqual(size, 25.0)) ++(*failures);
+
+    SBMLTransforms::expandInitialAssignments(m);
+    if (m->getNumInitialAssignments() != 0 ||
+        m->getCompartment(0)->getSize() != 25.0 ||
+        m->getParameter(1)->getValue() != 50)
+    {
+      ++(*failures);
+    }
+  }
+}
+
+
+/*
+ * Evaluates math with the values of its own models, where k1 is one more
+ * than the index of the model, and with the values of a model that all
+ * the threads share.
+ */
+static void
+evaluateDocuments(std::vector<SBMLDocument*>* docs, const Model* shared,
+                  unsigned int* failures)
+{
+  ASTNode* node = SBML_parseL3Formula("compartment");
+
+  for (unsigned int k = 0; k < 10; ++k)
+  {
+    for (size_t n = 0; n < docs->size(); ++n)
+    {
+      const Model* m = (*docs)[n]->getModel();
+      if (!util_isEqual(SBMLTransforms::evaluateASTNode(node, m), 50.0 * (n + 1)))
+      {
+        ++(*failures);
+      }
+    }
+
+    if (!util_isEqual(SBMLTransforms::evaluateASTNode(node, shared), 25.0))
+    {
+      ++(*failures);
+    }
+  }
+
+  delete node;
+}
+
+
+START_TEST (test_SBMLTransforms_threads)
+{
+  std::string filename(TestDataDirectory);
+  filename += "initialAssignments.xml";
+
+  SBMLDocument* d = readSBMLFromFile(filename.c_str());
+  fail_unless(d->getModel() != NULL);
+
+  const unsigned int numThreads = 8;
+  const unsigned int numDocs = 50;
+
+  std::vector< std::vector<SBMLDocument*> > docs(numThreads);
+  std::vector<unsigned int> failures(numThreads, 0);
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    for (unsigned int n = 0; n < numDocs; ++n)
+    {
+      docs[t].push_back(d->clone());
+    }
+  }
+
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    threads.push_back(std::thread(expandDocuments, &docs[t], &failures[t]));
+  }
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    threads[t].join();
+  }
+
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    fail_unless(failures[t] == 0);
+    for (unsigned int n = 0; n < numDocs; ++n)
+    {
+      delete docs[t][n];
+    }
+  }
+
+  // the original document is left alone
+  fail_unless(d->getModel()->getNumInitialAssignments() == 2);
+
+  delete d;
+}
+END_TEST
+
+
+START_TEST (test_SBMLTransforms_threads_evaluateWithModel)
+{
+  std::string filename(TestDataDirectory);
+  filename += "initialAssignments.xml";
+
+  SBMLDocument* d = readSBMLFromFile(filename.c_str());
+  fail_unless(d->getModel() != NULL);
+
+  const unsigned int numThreads = 8;
+  const unsigned int numDocs = 20;
+
+  std::vector< std::vector<SBMLDocument*> > docs(numThreads);
+  std::vector<unsigned int> failures(numThreads, 0);
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    for (unsigned int n = 0; n < numDocs; ++n)
+    {
+      SBMLDocument* copy = d->clone();
+      copy->getModel()->getParameter("k1")->setValue(n + 1);
+      docs[t].push_back(copy);
+    }
+  }
+
+  // the shared model has its values worked out before the threads start
+  SBMLTransforms::mapComponentValues(d->getModel());
+
+  std::vector<std::thread> threads;
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    threads.push_back(std::thread(evaluateDocuments, &docs[t],
+                                  d->getModel(), &failures[t]));
+  }
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    threads[t].join();
+  }
+
+  for (unsigned int t = 0; t < numThreads; ++t)
+  {
+    fail_unless(failures[t] == 0);
+    for (unsigned int n = 0; n < numDocs; ++n)
+    {
+      delete docs[t][n];
+    }
+  }
+
+  delete d;
+}
+END_TEST
+#endif
+
+
 Suite *
 create_suite_SBMLTransforms (void)
 {
@@ -972,6 +1186,11 @@ create_suite_SBMLTransforms (void)
   tcase_add_test(tcase, test_SBMLTransforms_evaluateL3V2ASTWithModel);
   tcase_add_test(tcase, test_SBMLTransforms_L3V2AssignmentNoMath);
   tcase_add_test(tcase, test_SBMLTransforms_StoichiometryMath);
+  tcase_add_test(tcase, test_SBMLTransforms_evaluateWithModelValues);
+#ifdef LIBSBML_USE_THREADS
+  tcase_add_test(tcase, test_SBMLTransforms_threads);
+  tcase_add_test(tcase, test_SBMLTransforms_threads_evaluateWithModel);
+#endif
 
 
   suite_add_tcase(suite, tcase);
@@ -43,6 +43,7 @@
 #include <sstream>
 
 #include <sbml/xml/XMLOutputStream.h>
+#include <sbml/xml/XMLOutputSink.h>
 #include <sbml/xml/XMLNode.h>
 #include <sbml/util/util.h>
 
@@ -2939,6 +2940,53 @@ START_TEST (test_WriteSBML_locale)
 END_TEST
 
 
+START_TEST (test_WriteSBML_sink)
+{
+  const unsigned int filenum = 4;
+  const char* file[filenum] = {
+                        "../../../examples/sample-models/from-spec/level-2/enzymekinetics.xml",
+                        "../../../examples/sample-models/from-spec/level-2/events.xml",
+                        "../../../examples/sample-models/from-spec/level-2/functiondef.xml",
+                        "../../../examples/sample-models/from-spec/level-2/units.xml"
+                        };
+
+  for(unsigned int i=0; i < filenum; i++)
+  {
+    SBMLDocument* d = readSBML(file[i]);
+    fail_unless( d != NULL);
+
+    // written character by character to a plain stream
+    ostringstream plain;
+    {
+      XMLOutputStream xos(plain, "UTF-8", true);
+      d->write(xos);
+      plain << endl;
+    }
+
+    // written through a sink that flushes every few bytes
+    ostringstream blocks;
+    {
+      XMLOutputSink sink(blocks, 7);
+      XMLOutputStream xos(sink, "UTF-8", true);
+      d->write(xos);
+      sink << endl;
+    }
+
+    string S = writeSBMLToStdString(d);
+
+    fail_unless( equals(plain.str().c_str(), S.c_str()) );
+    fail_unless( equals(plain.str().c_str(), blocks.str().c_str()) );
+
+    char* C = writeSBMLToString(d);
+    fail_unless( equals(plain.str().c_str(), C) );
+    safe_free(C);
+
+    delete d;
+  }
+}
+END_TEST
+
+
 #ifdef USE_ZLIB
 START_TEST (test_WriteSBML_gzip)
 {
@@ -3432,6 +3480,7 @@ create_suite_WriteSBML ()
   tcase_add_test( tcase, test_WriteSBML_INF     );
   tcase_add_test( tcase, test_WriteSBML_NegINF  );
   tcase_add_test( tcase, test_WriteSBML_locale  );
+  tcase_add_test( tcase, test_WriteSBML_sink    );
 
   // Compressed SBML
 #ifdef USE_ZLIB 
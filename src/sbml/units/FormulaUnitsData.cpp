@@ -56,6 +56,7 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 FormulaUnitsData::FormulaUnitsData()
 {
   mUnitReferenceId = "";
+  mSignature = "";
   mContainsUndeclaredUnits = false;
   mCanIgnoreUndeclaredUnits = true;
   mContainsInconsistency = false;
@@ -79,6 +80,7 @@ FormulaUnitsData::FormulaUnitsData()
 
 FormulaUnitsData::FormulaUnitsData(const FormulaUnitsData& orig)
   : mUnitReferenceId ( orig.mUnitReferenceId )
+  , mSignature ( orig.mSignature )
   , mContainsUndeclaredUnits ( orig.mContainsUndeclaredUnits )
   , mCanIgnoreUndeclaredUnits ( orig.mCanIgnoreUndeclaredUnits )
   , mContainsInconsistency ( orig.mContainsInconsistency)
@@ -128,6 +130,7 @@ FormulaUnitsData& FormulaUnitsData::operator=(const FormulaUnitsData& rhs)
   if(&rhs!=this)
   {
     mUnitReferenceId = rhs.mUnitReferenceId;
+    mSignature = rhs.mSignature;
     mContainsUndeclaredUnits = 
                             rhs.mContainsUndeclaredUnits;
     mCanIgnoreUndeclaredUnits = rhs.mCanIgnoreUndeclaredUnits;
@@ -309,6 +312,16 @@ FormulaUnitsData::getCanIgnoreUndeclaredUnits() const
   return mCanIgnoreUndeclaredUnits;
 }
 
+/*
+ * @return the summary of the parts of the model that the units of this
+ * FormulaUnitsData were worked out from.
+ */
+const std::string&
+FormulaUnitsData::getSignature() const
+{
+  return mSignature;
+}
+
 /**
   * Get the unit definition for this FormulaUnitsData.
   * 
@@ -483,6 +496,13 @@ FormulaUnitsData::setContainsInconsistency(bool flag)
   mContainsInconsistency = flag;
 }
 
+
+void
+FormulaUnitsData::setSignature(const std::string& signature)
+{
+  mSignature = signature;
+}
+
 /**
   * Set the unit definition for this FormulaUnitsData.
   * 
@@ -256,6 +256,16 @@ public:
   bool getContainsInconsistency() const;
 
 
+  /**
+   * Get the signature of this FormulaUnitsData.
+   *
+   * @return a summary of the parts of the model that the units of this
+   * FormulaUnitsData were worked out from, which is compared with the
+   * model as it is now to tell whether they need working out again.
+   */
+  const std::string& getSignature() const;
+
+
   /**
    * Get the unit definition for this FormulaUnitsData.
    * 
@@ -383,6 +393,15 @@ public:
   void setContainsInconsistency(bool flag);
 
 
+  /**
+   * Set the signature of this FormulaUnitsData.
+   *
+   * @param signature a summary of the parts of the model that the units
+   * of this FormulaUnitsData were worked out from.
+   */
+  void setSignature(const std::string& signature);
+
+
   /**
    * Set the unit definition for this FormulaUnitsData.
    * 
@@ -418,6 +437,7 @@ public:
 protected:
   /** @cond doxygenLibsbmlInternal */
     std::string mUnitReferenceId;
+    std::string mSignature;
 
     bool mContainsUndeclaredUnits;
     bool mCanIgnoreUndeclaredUnits;
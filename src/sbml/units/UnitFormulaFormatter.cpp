@@ -42,6 +42,7 @@
  * ---------------------------------------------------------------------- -->*/
 
 #include <sbml/units/UnitFormulaFormatter.h>
+#include <sbml/units/UnitTerms.h>
 #include <sbml/SBMLTransforms.h>
 #include <sbml/SBMLDocument.h>
 #include <sbml/util/util.h>
@@ -56,6 +57,8 @@ LIBSBML_CPP_NAMESPACE_BEGIN
  */
 UnitFormulaFormatter::UnitFormulaFormatter(const Model *m)
  : model(m)
+ , mLevel(0)
+ , mVersion(0)
 {
   mContainsUndeclaredUnits = false;
   mContainsInconsistentUnits = false;
@@ -72,27 +75,307 @@ UnitFormulaFormatter::~UnitFormulaFormatter()
 
 /*
   * visits the ASTNode and returns the unitDefinition of the formula
-  * this function is really a dispatcher to the other
-  * UnitFormulaFormatter::getUnitdefinition functions
   */
 UnitDefinition * 
 UnitFormulaFormatter::getUnitDefinition(const ASTNode * node, 
                                         bool inKL, int reactNo)
+{  
+  return createUnitDefinition(getUnitTerms(node, inKL, reactNo));
+}
+
+
+/* @cond doxygenLibsbmlInternal */
+/** 
+  * returns the unitDefinition for the ASTNode from a function
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromFunction(const ASTNode * node, 
+                                        bool inKL, int reactNo)
+{
+  return createUnitDefinition(getUnitTermsFromFunction(node, inKL, reactNo));
+}
+/* @endcond */
+
+
+/* @cond doxygenLibsbmlInternal */
+/** 
+  * returns the unitDefinition for the ASTNode from a times function
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromTimes(const ASTNode * node, 
+                                        bool inKL, int reactNo)
+{
+  return createUnitDefinition(getUnitTermsFromTimes(node, inKL, reactNo));
+}
+/* @endcond */
+
+
+/* @cond doxygenLibsbmlInternal */
+/** 
+  * returns the unitDefinition for the ASTNode from a divide function
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromDivide(const ASTNode * node, 
+                                        bool inKL, int reactNo)
+{
+  return createUnitDefinition(getUnitTermsFromDivide(node, inKL, reactNo));
+}
+/* @endcond */
+
+
+/* @cond doxygenLibsbmlInternal */
+/** 
+  * returns the unitDefinition for the ASTNode from a power function
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromPower(const ASTNode * node, 
+                                        bool inKL, int reactNo)
+{
+  return createUnitDefinition(getUnitTermsFromPower(node, inKL, reactNo));
+}
+/* @endcond */
+
+
+/* @cond doxygenLibsbmlInternal */
+/** 
+  * returns the unitDefinition for the ASTNode from a piecewise function
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromPiecewise(const ASTNode * node, 
+                                        bool inKL, int reactNo)
+{
+  return createUnitDefinition(getUnitTermsFromPiecewise(node, inKL, reactNo));
+}
+/* @endcond */
+
+
+/* @cond doxygenLibsbmlInternal */
+/** 
+  * returns the unitDefinition for the ASTNode from a root function
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromRoot(const ASTNode * node, 
+                                        bool inKL, int reactNo)
+{
+  return createUnitDefinition(getUnitTermsFromRoot(node, inKL, reactNo));
+}
+/* @endcond */
+
+
+/* @cond doxygenLibsbmlInternal */
+/** 
+  * returns the unitDefinition for the ASTNode from a function returning dimensionless value
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromDimensionlessReturnFunction(const ASTNode * node, 
+                                        bool inKL, int reactNo)
+{
+  return createUnitDefinition(getUnitTermsFromDimensionlessReturnFunction(node, inKL, reactNo));
+}
+/* @endcond */
+
+
+/* @cond doxygenLibsbmlInternal */
+/** 
+  * returns the unitDefinition for the ASTNode from a function returning value with same units as argument(s)
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromArgUnitsReturnFunction(const ASTNode * node, 
+                                        bool inKL, int reactNo)
+{
+  return createUnitDefinition(getUnitTermsFromArgUnitsReturnFunction(node, inKL, reactNo));
+}
+/* @endcond */
+
+
+/* @cond doxygenLibsbmlInternal */
+/** 
+  * returns the unitDefinition for the ASTNode from a delay function
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromDelay(const ASTNode * node, 
+                                        bool inKL, int reactNo)
+{
+  return createUnitDefinition(getUnitTermsFromDelay(node, inKL, reactNo));
+}
+/* @endcond */
+
+
+/* @cond doxygenLibsbmlInternal */
+/** 
+  * returns the unitDefinition for the ASTNode from anything else
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node, 
+                                        bool inKL, int reactNo)
+{
+  return createUnitDefinition(getUnitTermsFromOther(node, inKL, reactNo));
+}
+/* @endcond */
+
+
+/** 
+  * returns the unitDefinition for the units of the compartment
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromCompartment(const Compartment * compartment)
+{
+  return createUnitDefinition(getUnitTermsFromCompartment(compartment));
+}
+
+
+/** 
+  * returns the unitDefinition for the units of the species
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromSpecies(const Species * species)
+{
+  return createUnitDefinition(getUnitTermsFromSpecies(species));
+}
+
+
+/** 
+  * returns the unitDefinition for the units of the parameter
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromParameter(const Parameter * parameter)
+{
+  return createUnitDefinition(getUnitTermsFromParameter(parameter));
+}
+
+
+/** 
+  * returns the unitDefinition for the time units of the event
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getUnitDefinitionFromEventTime(const Event * event)
+{
+  return createUnitDefinition(getUnitTermsFromEventTime(event));
+}
+
+
+/** 
+  * returns the unitDefinition for the extent units of the model
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getExtentUnitDefinition()
+{
+  return createUnitDefinition(getExtentUnitTerms());
+}
+
+
+/** 
+  * returns the unitDefinition for the time units of the model
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getTimeUnitDefinition()
+{
+  return createUnitDefinition(getTimeUnitTerms());
+}
+
+
+/** 
+  * returns the unitDefinition for the substance units of the species
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getSpeciesSubstanceUnitDefinition(const Species * species)
+{
+  return createUnitDefinition(getSpeciesSubstanceUnitTerms(species));
+}
+
+
+/** 
+  * returns the unitDefinition for the extent units of the species
+  */
+UnitDefinition * 
+UnitFormulaFormatter::getSpeciesExtentUnitDefinition(const Species * species)
+{
+  return createUnitDefinition(getSpeciesExtentUnitTerms(species));
+}
+
+
+/* @cond doxygenLibsbmlInternal */
+/*
+ * returns empty units, with the level and version that a new 
+ * UnitDefinition for the model would have
+ */
+UnitTerms * 
+UnitFormulaFormatter::createUnitTerms()
+{
+  if (mLevel == 0)
+  {
+    try
+    {
+      UnitDefinition ud(model->getSBMLNamespaces());
+      mLevel = ud.getLevel();
+      mVersion = ud.getVersion();
+    }
+    catch ( ... )
+    {
+      mLevel = SBMLDocument::getDefaultLevel();
+      mVersion = SBMLDocument::getDefaultVersion();
+    }
+  }
+
+  return new UnitTerms(mLevel, mVersion);
+}
+/* @endcond */
+
+
+/* @cond doxygenLibsbmlInternal */
+/*
+ * returns a new UnitDefinition with the given units, which are deleted
+ */
+UnitDefinition * 
+UnitFormulaFormatter::createUnitDefinition(UnitTerms * terms)
+{
+  if (terms == NULL)
+  {
+    return NULL;
+  }
+
+  UnitDefinition * ud;
+  try
+  {
+    ud = new UnitDefinition(model->getSBMLNamespaces());
+  }
+  catch ( ... )
+  {
+    ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
+      SBMLDocument::getDefaultVersion());
+  }
+  terms->copyTo(*ud);
+
+  delete terms;
+  return ud;
+}
+/* @endcond */
+
+
+/* @cond doxygenLibsbmlInternal */
+/*
+  * visits the ASTNode and returns the units of the formula
+  * this function is really a dispatcher to the other
+  * UnitFormulaFormatter::getUnitTerms functions
+  */
+UnitTerms * 
+UnitFormulaFormatter::getUnitTerms(const ASTNode * node, 
+                                   bool inKL, int reactNo)
 {  
   /** 
-    * returns a copy of existing UnitDefinition* object (if any) that 
+    * returns a copy of existing UnitTerms object (if any) that 
     * corresponds to a given ASTNode*. 
     * (This is for avoiding redundant recursive calls.)
     */
 
-  std::map<const ASTNode*, UnitDefinition*>::iterator it = 
-                                                unitDefinitionMap.find(node);
-  if(it != unitDefinitionMap.end()) {
-    return static_cast<UnitDefinition*>(it->second->clone());
+  std::map<const ASTNode*, UnitTerms*>::iterator it = 
+                                                unitTermsMap.find(node);
+  if(it != unitTermsMap.end()) {
+    return new UnitTerms(*(it->second));
   }
 
     
-  UnitDefinition * ud = NULL;
+  UnitTerms * ud = NULL;
 
   if (node == NULL)
   {
@@ -162,7 +445,7 @@ UnitFormulaFormatter::getUnitDefinition(const ASTNode * node,
     case AST_RELATIONAL_LT:
     case AST_RELATIONAL_NEQ:
 
-      ud = getUnitDefinitionFromDimensionlessReturnFunction
+      ud = getUnitTermsFromDimensionlessReturnFunction
                                                         (node, inKL, reactNo);
       break;
 
@@ -173,58 +456,58 @@ UnitFormulaFormatter::getUnitDefinition(const ASTNode * node,
     case AST_FUNCTION_CEILING:
     case AST_FUNCTION_FLOOR:
   
-      ud = getUnitDefinitionFromArgUnitsReturnFunction(node, inKL, reactNo);
+      ud = getUnitTermsFromArgUnitsReturnFunction(node, inKL, reactNo);
       break;
 
   /* power functions */
     case AST_POWER:
     case AST_FUNCTION_POWER:
   
-      ud = getUnitDefinitionFromPower(node, inKL, reactNo);
+      ud = getUnitTermsFromPower(node, inKL, reactNo);
       break;
 
   /* times functions */
     case AST_TIMES:
   
-      ud = getUnitDefinitionFromTimes(node, inKL, reactNo);
+      ud = getUnitTermsFromTimes(node, inKL, reactNo);
       break;
 
   /* divide functions */
     case AST_DIVIDE:
   
-      ud = getUnitDefinitionFromDivide(node, inKL, reactNo);
+      ud = getUnitTermsFromDivide(node, inKL, reactNo);
       break;
 
   /* piecewise functions */
     case AST_FUNCTION_PIECEWISE:
   
-      ud = getUnitDefinitionFromPiecewise(node, inKL, reactNo);
+      ud = getUnitTermsFromPiecewise(node, inKL, reactNo);
       break;
 
   /* root functions */
     case AST_FUNCTION_ROOT:
   
-      ud = getUnitDefinitionFromRoot(node, inKL, reactNo);
+      ud = getUnitTermsFromRoot(node, inKL, reactNo);
       break;
 
   /* functions */
     case AST_LAMBDA:
     case AST_FUNCTION:
   
-      ud = getUnitDefinitionFromFunction(node, inKL, reactNo);
+      ud = getUnitTermsFromFunction(node, inKL, reactNo);
       break;
     
   /* delay */
     case AST_FUNCTION_DELAY:
   
-      ud = getUnitDefinitionFromDelay(node, inKL, reactNo);
+      ud = getUnitTermsFromDelay(node, inKL, reactNo);
       break;
 
     //  /* new types */
     //case AST_QUALIFIER_DEGREE:
     //case AST_QUALIFIER_LOGBASE:
 
-    //  ud = getUnitDefinition(node->getChild(0), inKL, reactNo);
+    //  ud = getUnitTerms(node->getChild(0), inKL, reactNo);
     //  break;
 
   /* others */
@@ -245,7 +528,7 @@ UnitFormulaFormatter::getUnitDefinition(const ASTNode * node,
     /* name of another component in the model */
     case AST_NAME:
 
-      ud = getUnitDefinitionFromOther(node, inKL, reactNo);
+      ud = getUnitTermsFromOther(node, inKL, reactNo);
       break;
 
     case AST_UNKNOWN:
@@ -261,7 +544,11 @@ UnitFormulaFormatter::getUnitDefinition(const ASTNode * node,
         if (baseplugin->defines(node->getType()))
         {
           found = true;
-          ud = baseplugin->getUnitDefinitionFromPackage(this, node, inKL, reactNo);
+          UnitDefinition* pluginUD = 
+            baseplugin->getUnitDefinitionFromPackage(this, node, inKL, reactNo);
+          delete ud;
+          ud = (pluginUD != NULL) ? new UnitTerms(*pluginUD) : NULL;
+          delete pluginUD;
         }
       }
       if (!found)
@@ -269,19 +556,11 @@ UnitFormulaFormatter::getUnitDefinition(const ASTNode * node,
         if (node->isQualifier() == true)
         {
           /* code so that old and new ast classes will do the right thing */
-          ud = getUnitDefinition(node->getChild(0), inKL, reactNo);
+          ud = getUnitTerms(node->getChild(0), inKL, reactNo);
         }
         else
         {
-          try
-          {
-            ud = new UnitDefinition(model->getSBMLNamespaces());
-          }
-          catch (...)
-          {
-            ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-              SBMLDocument::getDefaultVersion());
-          }
+          ud = createUnitTerms();
         }
       }
       break;
@@ -289,31 +568,23 @@ UnitFormulaFormatter::getUnitDefinition(const ASTNode * node,
   // as a safety catch 
   if (ud == NULL)
   {
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    ud = createUnitTerms();
   }
 
   // dont simplify an empty ud
   if (ud->getNumUnits() > 1)
-    UnitDefinition::simplify(ud);
+    UnitTerms::simplify(*ud);
 
   --depthRecursiveCall;
 
   if ( depthRecursiveCall != 0 )
   {
-    if (unitDefinitionMap.end() == unitDefinitionMap.find(node))
+    if (unitTermsMap.end() == unitTermsMap.find(node))
     {
       /* adds a pair of ASTNode* (node) and 
-         UnitDefinition* (ud) to the UnitDefinitionMap */
-      unitDefinitionMap.insert(std::pair<const ASTNode*, 
-        UnitDefinition*>(node,static_cast<UnitDefinition*>(ud->clone())));
+         UnitTerms* (ud) to the unitTermsMap */
+      unitTermsMap.insert(std::pair<const ASTNode*, 
+        UnitTerms*>(node, new UnitTerms(*ud)));
       undeclaredUnitsMap.insert(std::pair<const ASTNode*, 
                                     bool>(node,mContainsUndeclaredUnits));
       inconsistentUnitsMap.insert(std::pair<const ASTNode*, bool>
@@ -327,14 +598,14 @@ UnitFormulaFormatter::getUnitDefinition(const ASTNode * node,
     /** 
       * Clears two map objects because all recursive call has finished.
       */ 
-    std::map<const ASTNode*, UnitDefinition*>::iterator it1 =
-                                                unitDefinitionMap.begin();
-    while( it1 != unitDefinitionMap.end() )
+    std::map<const ASTNode*, UnitTerms*>::iterator it1 =
+                                                unitTermsMap.begin();
+    while( it1 != unitTermsMap.end() )
     {
       delete it1->second;
       ++it1;
     }
-    unitDefinitionMap.clear();
+    unitTermsMap.clear();
     undeclaredUnitsMap.clear();
     inconsistentUnitsMap.clear();
     canIgnoreUndeclaredUnitsMap.clear();
@@ -357,19 +628,20 @@ UnitFormulaFormatter::getUnitDefinition(const ASTNode * node,
 
   return ud;
 }
+/* @endcond */
 
 
 /* @cond doxygenLibsbmlInternal */
 /** 
-  * returns the unitDefinition for the ASTNode from a function
+  * returns the units of the ASTNode from a function
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromFunction(const ASTNode * node, 
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromFunction(const ASTNode * node, 
                                         bool inKL, int reactNo)
 { 
-  UnitDefinition * ud;
+  UnitTerms * ud;
   unsigned int i, nodeCount;
-  Unit * unit;
+  UnitTerm * unit;
   ASTNode * fdMath;
   // ASTNode *newMath;
   //bool needDelete = false;
@@ -399,20 +671,12 @@ UnitFormulaFormatter::getUnitDefinitionFromFunction(const ASTNode * node,
                                             node->getChild(nodeCount));
 		nodeCount++;
       }
-      ud = getUnitDefinition(fdMath, inKL, reactNo);
+      ud = getUnitTerms(fdMath, inKL, reactNo);
       delete fdMath;
     }
     else
     {
-      try
-      {
-        ud = new UnitDefinition(model->getSBMLNamespaces());
-      }
-      catch ( ... )
-      {
-        ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-          SBMLDocument::getDefaultVersion());
-      }
+      ud = createUnitTerms();
     }
   }
   else
@@ -420,15 +684,7 @@ UnitFormulaFormatter::getUnitDefinitionFromFunction(const ASTNode * node,
     /**
      * function is a lambda function - which wont have any units
      */
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    ud = createUnitTerms();
     unit = ud->createUnit();
     unit->setKind(UNIT_KIND_DIMENSIONLESS);
     unit->initDefaults();
@@ -443,12 +699,12 @@ UnitFormulaFormatter::getUnitDefinitionFromFunction(const ASTNode * node,
 /** 
   * returns the unitDefinition for the ASTNode from a times function
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromTimes(const ASTNode * node, 
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromTimes(const ASTNode * node, 
                                         bool inKL, int reactNo)
 { 
-  UnitDefinition * ud;
-  UnitDefinition * tempUD;
+  UnitTerms * ud;
+  UnitTerms * tempUD;
   unsigned int numChildren = node->getNumChildren();
   unsigned int n = 0;
   unsigned int i;
@@ -457,29 +713,21 @@ UnitFormulaFormatter::getUnitDefinitionFromTimes(const ASTNode * node,
   if (numChildren == 0)
   {
     /* times with no arguments is the identity which is 1 dimensionless */
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
-    Unit * u = ud->createUnit();
+    ud = createUnitTerms();
+    UnitTerm * u = ud->createUnit();
     u->initDefaults();
     u->setKind(UNIT_KIND_DIMENSIONLESS);
   }
   else
   {
-    ud = getUnitDefinition(node->getChild(n), inKL, reactNo);
+    ud = getUnitTerms(node->getChild(n), inKL, reactNo);
     if (mCanIgnoreUndeclaredUnits == 0) currentIgnore = 0;
 
     if (ud)
     {
       for(n = 1; n < numChildren; n++)
       {
-        tempUD = getUnitDefinition(node->getChild(n), inKL, reactNo);
+        tempUD = getUnitTerms(node->getChild(n), inKL, reactNo);
         if (mCanIgnoreUndeclaredUnits == 0) currentIgnore = 0;
         for (i = 0; i < tempUD->getNumUnits(); i++)
         {
@@ -490,15 +738,7 @@ UnitFormulaFormatter::getUnitDefinitionFromTimes(const ASTNode * node,
     }
     else
     {
-      try
-      {
-        ud = new UnitDefinition(model->getSBMLNamespaces());
-      }
-      catch ( ... )
-      {
-        ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-          SBMLDocument::getDefaultVersion());
-      }
+      ud = createUnitTerms();
     }
   }
 
@@ -512,20 +752,20 @@ UnitFormulaFormatter::getUnitDefinitionFromTimes(const ASTNode * node,
 /** 
   * returns the unitDefinition for the ASTNode from a divide function
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromDivide(const ASTNode * node, 
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromDivide(const ASTNode * node, 
                                         bool inKL, int reactNo)
 { 
-  UnitDefinition * ud;
-  UnitDefinition * tempUD;
+  UnitTerms * ud;
+  UnitTerms * tempUD;
   unsigned int i;
-  Unit * unit;
+  UnitTerm * unit;
 
-  ud = getUnitDefinition(node->getLeftChild(), inKL, reactNo);
+  ud = getUnitTerms(node->getLeftChild(), inKL, reactNo);
 
   if (node->getNumChildren() == 1)
     return ud;
-  tempUD = getUnitDefinition(node->getRightChild(), inKL, reactNo);
+  tempUD = getUnitTerms(node->getRightChild(), inKL, reactNo);
   for (i = 0; i < tempUD->getNumUnits(); i++)
   {
     unit = tempUD->getUnit(i);
@@ -546,28 +786,20 @@ UnitFormulaFormatter::getUnitDefinitionFromDivide(const ASTNode * node,
 /** 
   * returns the unitDefinition for the ASTNode from a power function
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromPower(const ASTNode * node,
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromPower(const ASTNode * node,
                                                  bool inKL, int reactNo)
 { 
   unsigned int numChildren = node->getNumChildren();
 
   if (numChildren == 0 || numChildren > 2)
   {
-    UnitDefinition* ud;
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    UnitTerms* ud;
+    ud = createUnitTerms();
     return ud;
   }
 
-  UnitDefinition * variableUD = getUnitDefinition(
+  UnitTerms * variableUD = getUnitTerms(
                                        node->getLeftChild(), inKL, reactNo);
 
   if (numChildren == 1)
@@ -585,20 +817,21 @@ UnitFormulaFormatter::getUnitDefinitionFromPower(const ASTNode * node,
 
   // is the exponent dimensionless or a number because if not it is a problem
   bool inconsistent = false;
-  UnitDefinition* exponentUD = getUnitDefinition(exponentNode, inKL, reactNo);
-  UnitDefinition::simplify(exponentUD);
+  UnitTerms* exponentUD = getUnitTerms(exponentNode, inKL, reactNo);
+  UnitTerms::simplify(*exponentUD);
 
   if (exponentNode->isInteger() == true ||
     exponentNode->isReal() == true ||
     exponentUD->isVariantOfDimensionless())
   {
-    SBMLTransforms::mapComponentValues(model);
-    exponentValue = SBMLTransforms::evaluateASTNode(node->getRightChild(), model);
-    SBMLTransforms::clearComponentValues();
+    SBMLTransforms::IdValueMap values;
+    SBMLTransforms::getComponentValuesForModel(model, values);
+    exponentValue = SBMLTransforms::evaluateASTNode(node->getRightChild(), 
+                                                    values, model);
 
     for (unsigned int n = 0; n < variableUD->getNumUnits(); n++)
     {
-      Unit * unit = variableUD->getUnit(n);
+      UnitTerm * unit = variableUD->getUnit(n);
       unit->setExponentUnitChecking(exponentValue * unit->getExponentAsDouble());
     }
 
@@ -618,11 +851,7 @@ UnitFormulaFormatter::getUnitDefinitionFromPower(const ASTNode * node,
   delete exponentUD;
   if (inconsistent)
   {
-    for (unsigned int n = variableUD->getNumUnits(); n > 0; --n)
-    {
-      Unit * unit = variableUD->removeUnit(n-1);
-      delete unit;
-    }
+    variableUD->removeUnits();
     mContainsInconsistentUnits = true;
   }
 
@@ -637,17 +866,17 @@ UnitFormulaFormatter::getUnitDefinitionFromPower(const ASTNode * node,
   * returns the unitDefinition for the ASTNode from 
   * a piecewise function
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromPiecewise(const ASTNode * node, 
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromPiecewise(const ASTNode * node, 
                                         bool inKL, int reactNo)
 { 
-  UnitDefinition * ud;
+  UnitTerms * ud;
   unsigned int n = 0;
-  UnitDefinition *tempUD1 = NULL;
+  UnitTerms *tempUD1 = NULL;
   /* this is fine if all other return branches have units
    * but if there are undeclared units these get ignored
    */
-  ud = getUnitDefinition(node->getLeftChild(), inKL, reactNo);
+  ud = getUnitTerms(node->getLeftChild(), inKL, reactNo);
   
  /* piecewise(a0, a1, a2, a3, ...)
    * a0 and a2, a(n_even) must have same units
@@ -656,7 +885,7 @@ UnitFormulaFormatter::getUnitDefinitionFromPiecewise(const ASTNode * node,
   while (!mContainsUndeclaredUnits && n < node->getNumChildren())
   {
     n+=2;
-    tempUD1 = getUnitDefinition(node->getChild(n), inKL, reactNo);
+    tempUD1 = getUnitTerms(node->getChild(n), inKL, reactNo);
   
     if (tempUD1) delete tempUD1;
   }
@@ -671,11 +900,11 @@ UnitFormulaFormatter::getUnitDefinitionFromPiecewise(const ASTNode * node,
 /** 
   * returns the unitDefinition for the ASTNode from a root function
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromRoot(const ASTNode * node, 
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromRoot(const ASTNode * node, 
                                         bool inKL, int reactNo)
 { 
-  UnitDefinition * ud;
+  UnitTerms * ud;
 /* this only works is the exponent is an integer - 
    * since a unit can only have an integral exponent 
    * but the mathml might do something like
@@ -683,22 +912,14 @@ UnitFormulaFormatter::getUnitDefinitionFromRoot(const ASTNode * node,
    * unless we challenge the sqrt(m) !!
    */
 
-  UnitDefinition * tempUD;
-  UnitDefinition *tempUD2 = NULL;
+  UnitTerms * tempUD;
+  UnitTerms *tempUD2 = NULL;
   unsigned int i;
-  Unit * unit;
+  UnitTerm * unit;
   ASTNode * child, * child1;
 
-  tempUD = getUnitDefinition(node->getRightChild(), inKL, reactNo);
-  try
-  {
-    ud = new UnitDefinition(model->getSBMLNamespaces());
-  }
-  catch ( ... )
-  {
-    ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-      SBMLDocument::getDefaultVersion());
-  }
+  tempUD = getUnitTerms(node->getRightChild(), inKL, reactNo);
+  ud = createUnitTerms();
 
   if (node->getNumChildren() == 1)
     return ud;
@@ -742,16 +963,16 @@ UnitFormulaFormatter::getUnitDefinitionFromRoot(const ASTNode * node,
       else
       {
 
-        tempUD2 = getUnitDefinition(child, inKL, reactNo);
+        tempUD2 = getUnitTerms(child, inKL, reactNo);
         if (tempUD2 && tempUD2->getNumUnits() > 0)
         {
-          UnitDefinition::simplify(tempUD2);
+          UnitTerms::simplify(*tempUD2);
 
           if (tempUD2->isVariantOfDimensionless())
           {
-            SBMLTransforms::mapComponentValues(model);
-            double value = SBMLTransforms::evaluateASTNode(child);
-            SBMLTransforms::clearComponentValues();
+            SBMLTransforms::IdValueMap values;
+            SBMLTransforms::getComponentValuesForModel(model, values);
+            double value = SBMLTransforms::evaluateASTNode(child, values);
             if (!util_isNaN(value))
             {
               double doubleExponent =
@@ -804,13 +1025,13 @@ UnitFormulaFormatter::getUnitDefinitionFromRoot(const ASTNode * node,
   * returns the unitDefinition for the ASTNode from 
   * a delay function
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromDelay(const ASTNode * node, 
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromDelay(const ASTNode * node, 
                                         bool inKL, int reactNo)
 { 
-  UnitDefinition * ud;
+  UnitTerms * ud;
   
-  ud = getUnitDefinition(node->getLeftChild(), inKL, reactNo);
+  ud = getUnitTerms(node->getLeftChild(), inKL, reactNo);
 
   return ud;
 }
@@ -822,22 +1043,14 @@ UnitFormulaFormatter::getUnitDefinitionFromDelay(const ASTNode * node,
   * returns the unitDefinition for the ASTNode from 
   * a function returning dimensionless value
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromDimensionlessReturnFunction(
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromDimensionlessReturnFunction(
                                 const ASTNode *node, bool inKL, int reactNo )
 { 
-  UnitDefinition * ud;
-  Unit *unit;
+  UnitTerms * ud;
+  UnitTerm *unit;
     
-  try
-  {
-    ud = new UnitDefinition(model->getSBMLNamespaces());
-  }
-  catch ( ... )
-  {
-    ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-      SBMLDocument::getDefaultVersion());
-  }
+  ud = createUnitTerms();
     
   unit = ud->createUnit();
   unit->setKind(UNIT_KIND_DIMENSIONLESS);
@@ -850,11 +1063,11 @@ UnitFormulaFormatter::getUnitDefinitionFromDimensionlessReturnFunction(
   //bool currentUndeclared = mContainsUndeclaredUnits;
 
   // check for undeclared units in child expressions
-  UnitDefinition * tempUd;
+  UnitTerms * tempUd;
   unsigned int noUndeclared = 0;
   for (unsigned int i = 0; i < node->getNumChildren(); i++)
   {
-    tempUd = getUnitDefinition(node->getChild(i), inKL, reactNo);
+    tempUd = getUnitTerms(node->getChild(i), inKL, reactNo);
     if (getContainsUndeclaredUnits() == true)
     {
       // if we have used logbase we dont want to 
@@ -897,13 +1110,13 @@ UnitFormulaFormatter::getUnitDefinitionFromDimensionlessReturnFunction(
   * returns the unitDefinition for the ASTNode from 
   * a function returning value with same units as argument(s)
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromArgUnitsReturnFunction
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromArgUnitsReturnFunction
                                        (const ASTNode * node, 
                                         bool inKL, int reactNo)
 { 
-  UnitDefinition * ud;
-  UnitDefinition * tempUd;
+  UnitTerms * ud;
+  UnitTerms * tempUd;
   unsigned int i = 0;
   unsigned int n = 0;
   bool conflictingUnits = false;
@@ -915,7 +1128,7 @@ UnitFormulaFormatter::getUnitDefinitionFromArgUnitsReturnFunction
   bool currentUndeclared = mContainsUndeclaredUnits;
 
   /* get first arg that is not a parameter with undeclared units */
-  ud = getUnitDefinition(node->getChild(i), inKL, reactNo);
+  ud = getUnitTerms(node->getChild(i), inKL, reactNo);
   while (getContainsUndeclaredUnits() == true
     && i < node->getNumChildren()-1)
   {
@@ -930,7 +1143,7 @@ UnitFormulaFormatter::getUnitDefinitionFromArgUnitsReturnFunction
     i++;
     delete ud;
     resetFlags();
-    ud = getUnitDefinition(node->getChild(i), inKL, reactNo);
+    ud = getUnitTerms(node->getChild(i), inKL, reactNo);
   }
 
   /* loop thru remain children to determine undeclaredUnit status */
@@ -944,10 +1157,10 @@ UnitFormulaFormatter::getUnitDefinitionFromArgUnitsReturnFunction
     for (n = i+1; n < node->getNumChildren(); n++)
     {
       resetFlags();
-      tempUd = getUnitDefinition(node->getChild(n), inKL, reactNo);
+      tempUd = getUnitTerms(node->getChild(n), inKL, reactNo);
       if (tempUd->getNumUnits() > 0)
       {
-        if (!UnitDefinition::areEquivalent(ud, tempUd))
+        if (ud == NULL || !UnitTerms::areEquivalent(*ud, *tempUd))
         {
           conflictingUnits = true;
         }
@@ -978,11 +1191,7 @@ UnitFormulaFormatter::getUnitDefinitionFromArgUnitsReturnFunction
   if (conflictingUnits)
   {
     mContainsInconsistentUnits = true;
-    for (unsigned int j = ud->getNumUnits(); j > 0; --j)
-    {
-      Unit * unit = ud->removeUnit(j - 1);
-      delete unit;
-    }
+    ud->removeUnits();
     
   }
   
@@ -997,13 +1206,13 @@ UnitFormulaFormatter::getUnitDefinitionFromArgUnitsReturnFunction
 /** 
   * returns the unitDefinition for the ASTNode from anything else
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromOther(const ASTNode * node,
     bool inKL, int reactNo)
 { 
-  UnitDefinition * ud = NULL;
+  UnitTerms * ud = NULL;
   const UnitDefinition * tempUd;
-  Unit * unit = NULL;
+  UnitTerm * unit = NULL;
 
   unsigned int n, found;
   double exponent;
@@ -1018,15 +1227,7 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
   if (node->isNumber())
   {
     /* in L3 a number can have units */
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    ud = createUnitTerms();
     if (node->isSetUnits())
     {
       std::string units = node->getUnits();
@@ -1062,29 +1263,13 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
   }
   else if (node->getType() == AST_CONSTANT_E)
   {
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    ud = createUnitTerms();
     mContainsUndeclaredUnits = true;
     mCanIgnoreUndeclaredUnits = 0;
   }
   else if (node->getType() == AST_CONSTANT_PI)
   {
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    ud = createUnitTerms();
     unit = ud->createUnit();
     unit->setKind(UNIT_KIND_DIMENSIONLESS);
     unit->initDefaults();
@@ -1093,7 +1278,7 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
   {
     if (node->getType() == AST_NAME_TIME)
     {
-      ud = getTimeUnitDefinition();
+      ud = getTimeUnitTerms();
 
       //try
       //{
@@ -1128,7 +1313,7 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
         if (model->getReaction((unsigned int)reactNo)->isSetKineticLaw())
         {
           kl = model->getReaction((unsigned int)reactNo)->getKineticLaw();
-          ud = getUnitDefinitionFromParameter(
+          ud = getUnitTermsFromParameter(
                                            kl->getParameter(node->getName()));
           if (ud != NULL)
           {
@@ -1138,7 +1323,7 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
       }
       if (found == 0)// && n < model->getNumCompartments())
       {
-        ud = getUnitDefinitionFromCompartment(
+        ud = getUnitTermsFromCompartment(
                                       model->getCompartment(node->getName()));
         if (ud != NULL)
         {
@@ -1148,7 +1333,7 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
 
       if (found == 0)//&& n < model->getNumSpecies())
       {
-        ud = getUnitDefinitionFromSpecies(
+        ud = getUnitTermsFromSpecies(
                                           model->getSpecies(node->getName()));
         if (ud != NULL)
         {
@@ -1158,7 +1343,7 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
 
       if (found == 0 )//&& n < model->getNumParameters())
       {
-        ud = getUnitDefinitionFromParameter(
+        ud = getUnitTermsFromParameter(
                                        model->getParameter(node->getName()));
         if (ud != NULL)
         {
@@ -1171,16 +1356,8 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
         // check for sr
         if (model->getSpeciesReference(node->getName()))
         {
-          try
-          {
-            ud = new UnitDefinition(model->getSBMLNamespaces());
-          }
-          catch ( ... )
-          {
-            ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-              SBMLDocument::getDefaultVersion());
-          }
-          Unit *u = ud->createUnit();
+          ud = createUnitTerms();
+          UnitTerm *u = ud->createUnit();
           u->setKind(UNIT_KIND_DIMENSIONLESS);
           u->initDefaults();
           found = 1;
@@ -1192,15 +1369,7 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
       {
         if (model->getReaction(node->getName()))
         {
-          try
-          {
-            ud = new UnitDefinition(model->getSBMLNamespaces());
-          }
-          catch ( ... )
-          {
-            ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-              SBMLDocument::getDefaultVersion());
-          }
+          ud = createUnitTerms();
           // <ci> element refers to reaction
           // units should be substance per time
           // NOTE: whether the KL has correct units is
@@ -1242,11 +1411,10 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
             {
               for (n = 0; n < tempUd->getNumUnits(); n++)
               {
-                unit = (const_cast<Unit*>(tempUd->getUnit(n)))->clone();
-                exponent = unit->getExponent();
-                unit->setExponentUnitChecking(exponent * -1);
-                ud->addUnit(unit);
-                delete unit;
+                UnitTerm perTime(*(tempUd->getUnit(n)));
+                exponent = perTime.getExponent();
+                perTime.setExponentUnitChecking(exponent * -1);
+                ud->addUnit(&perTime);
               }
             }
           }
@@ -1260,7 +1428,7 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
                                                model->getLevel(), 
                                                model->getVersion()))
             {
-              Unit* u = ud->createUnit();
+              UnitTerm* u = ud->createUnit();
               u->setKind(UnitKind_forName(extentUnits.c_str()));
               u->initDefaults();
             }
@@ -1275,7 +1443,7 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
                           model->getUnitDefinition(extentUnits)->getUnit(n1);
                 if (uFromModel  != NULL)
                 {
-                  Unit* u = ud->createUnit();
+                  UnitTerm* u = ud->createUnit();
                   u->setKind(uFromModel->getKind());
                   u->setExponent(uFromModel->getExponent());
                   u->setScale(uFromModel->getScale());
@@ -1294,7 +1462,7 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
                                                model->getLevel(), 
                                                model->getVersion()))
             {
-              Unit* u = ud->createUnit();
+              UnitTerm* u = ud->createUnit();
               u->setKind(UnitKind_forName(timeUnits.c_str()));
               u->initDefaults();
               u->setExponent(-1);
@@ -1310,7 +1478,7 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
                             model->getUnitDefinition(timeUnits)->getUnit(n1);
                 if (uFromModel  != NULL)
                 {
-                  Unit* u = ud->createUnit();
+                  UnitTerm* u = ud->createUnit();
                   u->setKind(uFromModel->getKind());
                   u->setExponent(uFromModel->getExponent() * -1);
                   u->setScale(uFromModel->getScale());
@@ -1336,15 +1504,7 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
    */
   if (ud == NULL)
   {
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    ud = createUnitTerms();
   }
   return ud;
 }
@@ -1354,8 +1514,8 @@ UnitFormulaFormatter::getUnitDefinitionFromOther(const ASTNode * node,
 /** 
   * returns the unitDefinition for the units of the compartment
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromCompartment
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromCompartment
                                              (const Compartment * compartment)
 {
   if (compartment == NULL)
@@ -1363,9 +1523,9 @@ UnitFormulaFormatter::getUnitDefinitionFromCompartment
     return NULL;
   }
 
-  UnitDefinition * ud = NULL;
+  UnitTerms * ud = NULL;
   const UnitDefinition * tempUD;
-  Unit * unit = NULL;
+  UnitTerm * unit = NULL;
   unsigned int n, p;
 
   const char * units = compartment->getUnits().c_str();
@@ -1402,15 +1562,7 @@ UnitFormulaFormatter::getUnitDefinitionFromCompartment
   {
     if (model->getLevel() < 3)
     {
-      try
-      {
-        ud = new UnitDefinition(model->getSBMLNamespaces());
-      }
-      catch ( ... )
-      {
-        ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-          SBMLDocument::getDefaultVersion());
-      }
+      ud = createUnitTerms();
       switch ((int)(compartment->getSpatialDimensions()))
       {
         case 0:
@@ -1486,15 +1638,7 @@ UnitFormulaFormatter::getUnitDefinitionFromCompartment
     /* units can be a predefined unit kind
     * a unit definition id or a builtin unit
     */
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    ud = createUnitTerms();
     if (UnitKind_isValidUnitKindString(units, 
                           compartment->getLevel(), compartment->getVersion()))
     {
@@ -1556,15 +1700,7 @@ UnitFormulaFormatter::getUnitDefinitionFromCompartment
   // as a safety catch 
   if (ud == NULL)
   {
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    ud = createUnitTerms();
   }
 
   return ud;
@@ -1573,19 +1709,19 @@ UnitFormulaFormatter::getUnitDefinitionFromCompartment
 /** 
   * returns the unitDefinition for the units of the species
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromSpecies(const Species * species)
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromSpecies(const Species * species)
 {
   if (species == NULL)
   {
     return NULL;
   }
   
-  UnitDefinition * ud = NULL;
+  UnitTerms * ud = NULL;
   const UnitDefinition * tempUd;
-  UnitDefinition *subsUD = NULL;
-  UnitDefinition *sizeUD = NULL;
-  Unit * unit = NULL;
+  UnitTerms *subsUD = NULL;
+  UnitTerms *sizeUD = NULL;
+  UnitTerm * unit = NULL;
   const Compartment * c;
   unsigned int n, p;
 
@@ -1606,15 +1742,7 @@ UnitFormulaFormatter::getUnitDefinitionFromSpecies(const Species * species)
    */
   if (!strcmp(units, ""))
   {
-    try
-    {
-      subsUD = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      subsUD = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    subsUD = createUnitTerms();
     if (species->getLevel() < 3)
     {
       /* check for builtin unit substance redefined */
@@ -1652,15 +1780,7 @@ UnitFormulaFormatter::getUnitDefinitionFromSpecies(const Species * species)
     if (UnitKind_isValidUnitKindString(units, 
                                  species->getLevel(), species->getVersion()))
     {
-      try
-      {
-        subsUD = new UnitDefinition(model->getSBMLNamespaces());
-      }
-      catch ( ... )
-      {
-        subsUD = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-          SBMLDocument::getDefaultVersion());
-      }
+      subsUD = createUnitTerms();
       unit = subsUD->createUnit();
       unit->setKind(UnitKind_forName(units));
       unit->initDefaults();
@@ -1672,15 +1792,7 @@ UnitFormulaFormatter::getUnitDefinitionFromSpecies(const Species * species)
       {
         if (units == model->getUnitDefinition(n)->getId())
         {
-          try
-          {
-            subsUD = new UnitDefinition(model->getSBMLNamespaces());
-          }
-          catch ( ... )
-          {
-            subsUD = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-              SBMLDocument::getDefaultVersion());
-          }
+          subsUD = createUnitTerms();
           
           for (p = 0; p < model->getUnitDefinition(n)->getNumUnits(); p++)
           {
@@ -1707,15 +1819,7 @@ UnitFormulaFormatter::getUnitDefinitionFromSpecies(const Species * species)
      */
     if (Unit_isBuiltIn(units, model->getLevel()) && subsUD == NULL)
     {
-      try
-      {
-        subsUD = new UnitDefinition(model->getSBMLNamespaces());
-      }
-      catch ( ... )
-      {
-        subsUD = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-          SBMLDocument::getDefaultVersion());
-      }
+      subsUD = createUnitTerms();
 
       if (!strcmp(units, "substance"))
       {
@@ -1730,15 +1834,7 @@ UnitFormulaFormatter::getUnitDefinitionFromSpecies(const Species * species)
       // units is undefined 
 
       // as a safety catch
-      try
-      {
-        subsUD = new UnitDefinition(model->getSBMLNamespaces());
-      }
-      catch ( ... )
-      {
-        subsUD = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-          SBMLDocument::getDefaultVersion());
-      }
+      subsUD = createUnitTerms();
       return subsUD;
     }
 
@@ -1765,35 +1861,19 @@ UnitFormulaFormatter::getUnitDefinitionFromSpecies(const Species * species)
   /* no units declared implies they default to the value of compartment size */
   if (!strcmp(spatialUnits, ""))
   {
-    sizeUD   = getUnitDefinitionFromCompartment(c);
+    sizeUD   = getUnitTermsFromCompartment(c);
     if (species->getLevel() > 2 && sizeUD && sizeUD->getNumUnits() == 0)
     {
       /* compartment units are not defined */
       delete sizeUD;
       if (subsUD != NULL) delete subsUD;
-      try
-      {
-        subsUD = new UnitDefinition(model->getSBMLNamespaces());
-      }
-      catch ( ... )
-      {
-        subsUD = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-          SBMLDocument::getDefaultVersion());
-      }
+      subsUD = createUnitTerms();
       return subsUD;
     }
   }
   else
   {
-    try
-    {
-      sizeUD = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      sizeUD = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    sizeUD = createUnitTerms();
     if (UnitKind_isValidUnitKindString(spatialUnits, species->getLevel(), 
                                                      species->getVersion()))
     {
@@ -1874,15 +1954,7 @@ UnitFormulaFormatter::getUnitDefinitionFromSpecies(const Species * species)
   // as a safety catch 
   if (ud == NULL)
   {
-    try
-    {
-      subsUD = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      subsUD = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    subsUD = createUnitTerms();
   }
 
   delete sizeUD;
@@ -1893,8 +1965,8 @@ UnitFormulaFormatter::getUnitDefinitionFromSpecies(const Species * species)
 /** 
   * returns the unitDefinition for the units of the parameter
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromParameter
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromParameter
                                                 (const Parameter * parameter)
 {
   if (parameter == NULL)
@@ -1902,8 +1974,8 @@ UnitFormulaFormatter::getUnitDefinitionFromParameter
     return NULL;
   }
 
-  UnitDefinition * ud = NULL;
-  Unit * unit = NULL;
+  UnitTerms * ud = NULL;
+  UnitTerm * unit = NULL;
   unsigned int n, p;
 
   const char * units = parameter->getUnits().c_str();
@@ -1911,15 +1983,7 @@ UnitFormulaFormatter::getUnitDefinitionFromParameter
  /* no units declared */
   if (!strcmp(units, ""))
   {
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    ud = createUnitTerms();
     mContainsUndeclaredUnits = true;
     mCanIgnoreUndeclaredUnits = 0;
   }
@@ -1929,15 +1993,7 @@ UnitFormulaFormatter::getUnitDefinitionFromParameter
     * a unit definition id or a builtin unit
     */
 
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    ud = createUnitTerms();
     if (UnitKind_isValidUnitKindString(units, 
                               parameter->getLevel(), parameter->getVersion()))
     {
@@ -2012,15 +2068,7 @@ UnitFormulaFormatter::getUnitDefinitionFromParameter
   // as a safety catch 
   if (ud == NULL)
   {
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    ud = createUnitTerms();
   }
 
   return ud;
@@ -2029,16 +2077,16 @@ UnitFormulaFormatter::getUnitDefinitionFromParameter
 /** 
   * returns the unitDefinition for the time units of the event
   */
-UnitDefinition * 
-UnitFormulaFormatter::getUnitDefinitionFromEventTime(const Event * event)
+UnitTerms * 
+UnitFormulaFormatter::getUnitTermsFromEventTime(const Event * event)
 {
   if (event == NULL)
   {
     return NULL;
   }
-  UnitDefinition * ud = NULL;
-  UnitDefinition * tempUd = NULL;
-  Unit * unit;
+  UnitTerms * ud = NULL;
+  const UnitDefinition * tempUd = NULL;
+  UnitTerm * unit;
   unsigned int n, p;
 
   const char * units = event->getTimeUnits().c_str();
@@ -2053,17 +2101,9 @@ UnitFormulaFormatter::getUnitDefinitionFromEventTime(const Event * event)
     */
     if (event->getLevel() < 3)
     {
-      tempUd = (UnitDefinition*)(model->getUnitDefinition("time"));
+      tempUd = model->getUnitDefinition("time");
 
-      try
-      {
-        ud = new UnitDefinition(model->getSBMLNamespaces());
-      }
-      catch ( ... )
-      {
-        ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-          SBMLDocument::getDefaultVersion());
-      }
+      ud = createUnitTerms();
       if (tempUd == NULL) 
       {
         unit = ud->createUnit();
@@ -2085,15 +2125,7 @@ UnitFormulaFormatter::getUnitDefinitionFromEventTime(const Event * event)
     * a unit definition id or a builtin unit
     */
 
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    ud = createUnitTerms();
     if (UnitKind_isValidUnitKindString(units, 
                                      event->getLevel(), event->getVersion()))
     {
@@ -2146,15 +2178,7 @@ UnitFormulaFormatter::getUnitDefinitionFromEventTime(const Event * event)
   // as a safety catch 
   if (ud == NULL)
   {
-    try
-    {
-      ud = new UnitDefinition(model->getSBMLNamespaces());
-    }
-    catch ( ... )
-    {
-      ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-        SBMLDocument::getDefaultVersion());
-    }
+    ud = createUnitTerms();
   }
 
   return ud;
@@ -2164,20 +2188,12 @@ UnitFormulaFormatter::getUnitDefinitionFromEventTime(const Event * event)
  * Returns the unitDefinition constructed
  * from the extent units of this Model.
  */
-UnitDefinition * 
-UnitFormulaFormatter::getExtentUnitDefinition()
+UnitTerms * 
+UnitFormulaFormatter::getExtentUnitTerms()
 {
-  UnitDefinition * ud;
-  try
-  {
-    ud = new UnitDefinition(model->getSBMLNamespaces());
-  }
-  catch ( ... )
-  {
-    ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-      SBMLDocument::getDefaultVersion());
-  }
-  Unit * unit = NULL;
+  UnitTerms * ud;
+  ud = createUnitTerms();
+  UnitTerm * unit = NULL;
   unsigned int n, p;
 
   const char * units = model->getExtentUnits().c_str();
@@ -2227,26 +2243,18 @@ UnitFormulaFormatter::getExtentUnitDefinition()
   return ud;
 }
 
-UnitDefinition * 
-UnitFormulaFormatter::getSpeciesSubstanceUnitDefinition(const Species * species)
+UnitTerms * 
+UnitFormulaFormatter::getSpeciesSubstanceUnitTerms(const Species * species)
 {
   if (species == NULL)
   {
     return NULL;
   }
   
-  UnitDefinition * ud;
-  try
-  {
-    ud = new UnitDefinition(model->getSBMLNamespaces());
-  }
-  catch ( ... )
-  {
-    ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-      SBMLDocument::getDefaultVersion());
-  }
+  UnitTerms * ud;
+  ud = createUnitTerms();
   const UnitDefinition * tempUd = NULL;
-  Unit * unit = NULL;
+  UnitTerm * unit = NULL;
   unsigned int n, p;
 
   const char * units        = species->getSubstanceUnits().c_str();
@@ -2348,28 +2356,20 @@ UnitFormulaFormatter::getSpeciesSubstanceUnitDefinition(const Species * species)
   return ud;
 }
 
-UnitDefinition * 
-UnitFormulaFormatter::getSpeciesExtentUnitDefinition(const Species * species)
+UnitTerms * 
+UnitFormulaFormatter::getSpeciesExtentUnitTerms(const Species * species)
 {
   if (species == NULL)
   {
     return NULL;
   }
   unsigned int n;
-  UnitDefinition * ud;
-  try
-  {
-    ud = new UnitDefinition(model->getSBMLNamespaces());
-  }
-  catch ( ... )
-  {
-    ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-      SBMLDocument::getDefaultVersion());
-  }
-  Unit * unit = NULL;
+  UnitTerms * ud;
+  ud = createUnitTerms();
+  UnitTerm * unit = NULL;
 
   /* get model extent - if there is none then species has none */
-  UnitDefinition * modelExtent = getExtentUnitDefinition();
+  UnitTerms * modelExtent = getExtentUnitTerms();
   if (modelExtent == NULL || modelExtent->getNumUnits() == 0)
   {
     mContainsUndeclaredUnits = true;
@@ -2378,17 +2378,17 @@ UnitFormulaFormatter::getSpeciesExtentUnitDefinition(const Species * species)
     return ud;
   }
 
-  UnitDefinition *conversion = NULL;
+  UnitTerms *conversion = NULL;
 
   /* get conversionFactor - if none or if it has no units bail*/
   if (species->isSetConversionFactor())
   {
-    conversion = getUnitDefinitionFromParameter(
+    conversion = getUnitTermsFromParameter(
       model->getParameter(species->getConversionFactor()));
   }
   else if (model->isSetConversionFactor())
   {
-    conversion = getUnitDefinitionFromParameter(
+    conversion = getUnitTermsFromParameter(
       model->getParameter(model->getConversionFactor()));
   }
     
@@ -2429,7 +2429,7 @@ UnitFormulaFormatter::getSpeciesExtentUnitDefinition(const Species * species)
             conversion->getUnit(n)->getOffset());
   }
 
-  UnitDefinition::simplify(ud);
+  UnitTerms::simplify(*ud);
 
   delete modelExtent;
   delete conversion;
@@ -2438,10 +2438,10 @@ UnitFormulaFormatter::getSpeciesExtentUnitDefinition(const Species * species)
 
   /* @cond doxygenLibsbmlInternal */
 
-UnitDefinition * 
-UnitFormulaFormatter::getTimeUnitDefinition()
+UnitTerms * 
+UnitFormulaFormatter::getTimeUnitTerms()
 {
-  UnitDefinition * ud = NULL;
+  UnitTerms * ud = NULL;
 
   std::string timeUnits = model->getTimeUnits();
   if (model->getLevel() < 3)
@@ -2453,21 +2453,13 @@ UnitFormulaFormatter::getTimeUnitDefinition()
   }
 
   char * charTime = safe_strdup(timeUnits.c_str());
-  try
-  {
-    ud = new UnitDefinition(model->getSBMLNamespaces());
-  }
-  catch ( ... )
-  {
-    ud = new UnitDefinition(SBMLDocument::getDefaultLevel(),
-      SBMLDocument::getDefaultVersion());
-  }
+  ud = createUnitTerms();
 
   if (UnitKind_isValidUnitKindString(charTime,
                                       model->getLevel(), 
                                       model->getVersion()))
   {
-    Unit* u = ud->createUnit();
+    UnitTerm* u = ud->createUnit();
     u->setKind(UnitKind_forName(charTime));
     u->initDefaults();
   }
@@ -2482,7 +2474,7 @@ UnitFormulaFormatter::getTimeUnitDefinition()
                   model->getUnitDefinition(timeUnits)->getUnit(n1);
       if (uFromModel  != NULL)
       {
-        Unit* u = ud->createUnit();
+        UnitTerm* u = ud->createUnit();
         u->setKind(uFromModel->getKind());
         u->setExponent(uFromModel->getExponent());
         u->setScale(uFromModel->getScale());
@@ -2716,8 +2708,10 @@ UnitFormulaFormatter::inverseFunctionOnUnits(UnitDefinition* expectedUD,
       if (mathUD == NULL || mathUD->getNumUnits() == 0 
         || mathUD->isVariantOfDimensionless() == true)
       {
-        SBMLTransforms::mapComponentValues(this->model);
-        double exp = 1.0/(SBMLTransforms::evaluateASTNode(math, this->model));
+        SBMLTransforms::IdValueMap values;
+        SBMLTransforms::getComponentValuesForModel(this->model, values);
+        double exp = 1.0/(SBMLTransforms::evaluateASTNode(math, values, 
+                                                          this->model));
         resolvedUD = new UnitDefinition(*expectedUD);
         for (unsigned int i = 0; i < resolvedUD->getNumUnits(); i++)
         {
@@ -81,6 +81,7 @@
 LIBSBML_CPP_NAMESPACE_BEGIN
 
 class FormulaUnitsData;
+class UnitTerms;
 
 class ASTNode;
 
@@ -379,10 +380,14 @@ private:
   bool mContainsInconsistentUnits;
   unsigned int mCanIgnoreUndeclaredUnits;
 
-  /* a depth of recursive call of getUnitDefinition()*/
+  /* the level and version of the units created, once known */
+  unsigned int mLevel;
+  unsigned int mVersion;
+
+  /* a depth of recursive call of getUnitTerms()*/
   int depthRecursiveCall;
 
-  std::map<const ASTNode*, UnitDefinition*> unitDefinitionMap;
+  std::map<const ASTNode*, UnitTerms*>      unitTermsMap;
   std::map<const ASTNode*, bool>            undeclaredUnitsMap;
   std::map<const ASTNode*, bool>            inconsistentUnitsMap;
   std::map<const ASTNode*, unsigned int>    canIgnoreUndeclaredUnitsMap;
@@ -391,6 +396,63 @@ private:
     const ASTNode * math, ASTNodeType_t functionType, bool inKL, int reactNo, 
     bool unknownInLeftChild = false);
 
+  /* 
+   * The units are worked out as UnitTerms, which are converted to a
+   * UnitDefinition only when they are handed back by one of the public
+   * functions above.
+   */
+  UnitTerms * getUnitTerms(const ASTNode * node, bool inKL, int reactNo);
+
+  UnitTerms * getUnitTermsFromFunction(const ASTNode * node, 
+    bool inKL, int reactNo);
+
+  UnitTerms * getUnitTermsFromTimes(const ASTNode * node, 
+    bool inKL, int reactNo);
+
+  UnitTerms * getUnitTermsFromDivide(const ASTNode * node, 
+    bool inKL, int reactNo);
+
+  UnitTerms * getUnitTermsFromPower(const ASTNode * node, 
+    bool inKL, int reactNo);
+
+  UnitTerms * getUnitTermsFromPiecewise(const ASTNode * node, 
+    bool inKL, int reactNo);
+
+  UnitTerms * getUnitTermsFromRoot(const ASTNode * node, 
+    bool inKL, int reactNo);
+
+  UnitTerms * getUnitTermsFromDimensionlessReturnFunction(
+    const ASTNode * node, bool inKL, int reactNo);
+
+  UnitTerms * getUnitTermsFromArgUnitsReturnFunction(const ASTNode * node, 
+    bool inKL, int reactNo);
+
+  UnitTerms * getUnitTermsFromDelay(const ASTNode * node, 
+    bool inKL, int reactNo);
+
+  UnitTerms * getUnitTermsFromOther(const ASTNode * node, 
+    bool inKL, int reactNo);
+
+  UnitTerms * getUnitTermsFromCompartment(const Compartment * compartment);
+
+  UnitTerms * getUnitTermsFromSpecies(const Species * species);
+
+  UnitTerms * getUnitTermsFromParameter(const Parameter * parameter);
+
+  UnitTerms * getUnitTermsFromEventTime(const Event * event);
+
+  UnitTerms * getExtentUnitTerms();
+
+  UnitTerms * getTimeUnitTerms();
+
+  UnitTerms * getSpeciesSubstanceUnitTerms(const Species * species);
+
+  UnitTerms * getSpeciesExtentUnitTerms(const Species * species);
+
+  UnitTerms * createUnitTerms();
+
+  UnitDefinition * createUnitDefinition(UnitTerms * terms);
+
   /** @endcond */
 
 };
@@ -0,0 +1,1096 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    UnitTerms.cpp
+ * @brief   Value types holding the units worked out during unit checking
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include <sbml/units/UnitTerms.h>
+#include <sbml/Unit.h>
+#include <sbml/UnitDefinition.h>
+#include <sbml/util/util.h>
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+#ifdef __cplusplus
+
+/*
+ * As in Unit.cpp: forces x to be a double with at most num_digits of
+ * precision when written in decimal.  A multiplier of 1 is by far the
+ * most common, and is left as it is without the round trip.
+ */
+static double
+truncateDoublePrecision (double x, int num_digits = 15)
+{
+  if (x == 1.0) return x;
+
+  std::ostringstream oss;
+  oss.precision(num_digits);
+  oss << x;
+  return c_locale_strtod(oss.str().c_str(), NULL);
+}
+
+
+/*
+ * As in Unit.cpp: slightly less restrictive than util_isEqual.
+ */
+static bool
+isEqualMultiplier (double a, double b)
+{
+  double tol;
+  if (a < b)
+    tol = a * 1e-10;
+  else
+    tol = b * 1e-10;
+  return (fabs(a-b) < sqrt(tol)) ? true : false;
+}
+
+
+static bool
+lessKind (const UnitTerm& term1, const UnitTerm& term2)
+{
+  return (int)(term1.getKind()) < (int)(term2.getKind());
+}
+
+
+UnitTerm::UnitTerm (unsigned int level, unsigned int version) :
+    mKind       ( UNIT_KIND_INVALID )
+  , mExponent   ( 1   )
+  , mExponentDouble ( 1 )
+  , mScale      ( 0   )
+  , mMultiplier ( 1.0 )
+  , mOffset     ( 0.0 )
+  , mLevel      ( (unsigned char)level   )
+  , mVersion    ( (unsigned char)version )
+  , mIsSetExponent    ( false )
+  , mIsSetScale       ( false )
+  , mIsSetMultiplier  ( false )
+  , mExplicitlySetExponent   ( false )
+  , mExplicitlySetMultiplier ( false )
+  , mExplicitlySetScale      ( false )
+  , mExplicitlySetOffset     ( false )
+  , mInternalUnitCheckingFlag ( false )
+{
+  // if level 3 values have no defaults
+  if (level == 3)
+  {
+    mExponentDouble = numeric_limits<double>::quiet_NaN();
+    mScale = numeric_limits<int>::max();
+    mMultiplier = numeric_limits<double>::quiet_NaN();
+  }
+  // before level 3 exponent, scale and multiplier were set by default
+  if (level < 3)
+  {
+    mIsSetExponent = true;
+    mIsSetScale = true;
+    mIsSetMultiplier = true;
+  }
+}
+
+
+UnitTerm::UnitTerm (const Unit& unit) :
+    mKind       ( unit.mKind       )
+  , mExponent   ( unit.mExponent   )
+  , mExponentDouble ( unit.mExponentDouble )
+  , mScale      ( unit.mScale      )
+  , mMultiplier ( unit.mMultiplier )
+  , mOffset     ( unit.mOffset     )
+  , mLevel      ( (unsigned char)unit.getLevel()   )
+  , mVersion    ( (unsigned char)unit.getVersion() )
+  , mIsSetExponent    ( unit.mIsSetExponent   )
+  , mIsSetScale       ( unit.mIsSetScale      )
+  , mIsSetMultiplier  ( unit.mIsSetMultiplier )
+  , mExplicitlySetExponent   ( unit.mExplicitlySetExponent   )
+  , mExplicitlySetMultiplier ( unit.mExplicitlySetMultiplier )
+  , mExplicitlySetScale      ( unit.mExplicitlySetScale      )
+  , mExplicitlySetOffset     ( unit.mExplicitlySetOffset     )
+  , mInternalUnitCheckingFlag ( unit.mInternalUnitCheckingFlag )
+{
+}
+
+
+void
+UnitTerm::copyTo (Unit& unit) const
+{
+  unit.mKind           = mKind;
+  unit.mExponent       = mExponent;
+  unit.mExponentDouble = mExponentDouble;
+  unit.mScale          = mScale;
+  unit.mMultiplier     = mMultiplier;
+  unit.mOffset         = mOffset;
+
+  unit.mIsSetExponent   = mIsSetExponent;
+  unit.mIsSetScale      = mIsSetScale;
+  unit.mIsSetMultiplier = mIsSetMultiplier;
+
+  unit.mExplicitlySetExponent   = mExplicitlySetExponent;
+  unit.mExplicitlySetMultiplier = mExplicitlySetMultiplier;
+  unit.mExplicitlySetScale      = mExplicitlySetScale;
+  unit.mExplicitlySetOffset     = mExplicitlySetOffset;
+
+  unit.mInternalUnitCheckingFlag = mInternalUnitCheckingFlag;
+}
+
+
+int
+UnitTerm::getExponent () const
+{
+  if (mLevel < 3)
+  {
+    return mExponent;
+  }
+  else
+  {
+    if (isSetExponent())
+    {
+      if (ceil(mExponentDouble) == floor(mExponentDouble))
+      {
+        return static_cast<int>(mExponentDouble);
+      }
+      else
+      {
+        return 0;
+      }
+    }
+    else
+    {
+      if (util_isNaN(mExponentDouble))
+      {
+        return 0;
+      }
+      else
+      {
+        return static_cast<int>(mExponentDouble);
+      }
+    }
+  }
+}
+
+
+double
+UnitTerm::getExponentAsDouble () const
+{
+  if (mLevel > 2)
+    return mExponentDouble;
+  else
+    return static_cast<double>(mExponent);
+}
+
+
+bool
+UnitTerm::hasRequiredAttributes () const
+{
+  bool allPresent = true;
+
+  if (!isSetKind())
+    allPresent = false;
+
+  if (mLevel > 2 && !isSetExponent())
+    allPresent = false;
+
+  if (mLevel > 2 && !isSetMultiplier())
+    allPresent = false;
+
+  if (mLevel > 2 && !isSetScale())
+    allPresent = false;
+
+  return allPresent;
+}
+
+
+void
+UnitTerm::setKind (UnitKind_t kind)
+{
+  if (UnitKind_isValidUnitKindString(UnitKind_toString(kind),
+                                     mLevel, mVersion))
+  {
+    mKind = kind;
+  }
+}
+
+
+void
+UnitTerm::setExponent (double value)
+{
+  bool representsInteger = true;
+  if (floor(value) != value)
+    representsInteger = false;
+
+  if (mLevel < 3)
+  {
+    if (representsInteger)
+    {
+      mExponentDouble = value;
+      mExponent = (int) (value);
+      mIsSetExponent = true;
+      mExplicitlySetExponent = true;
+    }
+    return;
+  }
+
+  mExponentDouble = value;
+  mExponent = (int) (value);
+  mIsSetExponent = true;
+}
+
+
+void
+UnitTerm::setExponentUnitChecking (double value)
+{
+  mExponentDouble = value;
+  mExponent = (int)(value);
+  mIsSetExponent = true;
+  mInternalUnitCheckingFlag = true;
+}
+
+
+void
+UnitTerm::setScale (int value)
+{
+  mScale = value;
+  mIsSetScale = true;
+  mExplicitlySetScale = true;
+}
+
+
+void
+UnitTerm::setMultiplier (double value)
+{
+  mMultiplier = value;
+  if (mLevel >= 2)
+  {
+    mIsSetMultiplier = true;
+    mExplicitlySetMultiplier = true;
+  }
+}
+
+
+void
+UnitTerm::setOffset (double value)
+{
+  if (!(mLevel == 2 && mVersion == 1))
+  {
+    mOffset = 0;
+  }
+  else
+  {
+    mOffset = value;
+    mExplicitlySetOffset = true;
+  }
+}
+
+
+void
+UnitTerm::initDefaults ()
+{
+  setExponent  ( 1   );
+  setScale     ( 0   );
+  setMultiplier( 1.0 );
+  setOffset    ( 0.0 );
+
+  mExplicitlySetExponent   = false;
+  mExplicitlySetScale      = false;
+  mExplicitlySetMultiplier = false;
+  mExplicitlySetOffset     = (mLevel == 2 && mVersion == 1);
+}
+
+
+void
+UnitTerm::removeScale (UnitTerm& term)
+{
+  double scaleFactor = pow(10.0, term.getScale());
+  double newMultiplier = term.getMultiplier() * scaleFactor;
+  term.setMultiplier(truncateDoublePrecision(newMultiplier));
+  term.setScale(0);
+}
+
+
+void
+UnitTerm::merge (UnitTerm& term1, UnitTerm& term2)
+{
+  double newExponent;
+  double newMultiplier;
+
+  /* only applies if units have same kind */
+  if (term1.getKind() != term2.getKind())
+    return;
+
+  /* not yet implemented if offsets != 0 */
+  if (term1.getOffset() != 0 || term2.getOffset() != 0)
+    return;
+
+  UnitTerm::removeScale(term1);
+  UnitTerm::removeScale(term2);
+
+  newExponent = term1.getExponentAsDouble() + term2.getExponentAsDouble();
+
+  // if we are merging units where 1 exponent was zero
+  // but we had a multiplier that was not 1
+  // need to preserve that multiplier
+  double term1Multi = pow(term1.getMultiplier(), term1.getExponentAsDouble());
+  if (util_isEqual(term1.getExponentAsDouble(), 0.0)
+    && (!util_isEqual(term1.getMultiplier(), 1.0)))
+  {
+    term1Multi = term1.getMultiplier();
+  }
+
+  double term2Multi = pow(term2.getMultiplier(), term2.getExponentAsDouble());
+  if (util_isEqual(term2.getExponentAsDouble(), 0.0)
+    && (!util_isEqual(term2.getMultiplier(), 1.0)))
+  {
+    term2Multi = term2.getMultiplier();
+  }
+
+  if (newExponent == 0)
+  {
+    newMultiplier = term1Multi * term2Multi;
+  }
+  else
+  {
+    newMultiplier = pow(term1Multi * term2Multi, 1/(double)(newExponent));
+  }
+
+  term1.setScale(0);
+  term1.setExponent(newExponent);
+  term1.setMultiplier(truncateDoublePrecision(newMultiplier));
+}
+
+
+bool
+UnitTerm::areIdentical (const UnitTerm& term1, const UnitTerm& term2)
+{
+  return term1.getKind() == term2.getKind()
+      && isEqualMultiplier(term1.getMultiplier(), term2.getMultiplier())
+      && term1.getScale()    == term2.getScale()
+      && term1.getOffset()   == term2.getOffset()
+      && term1.getExponent() == term2.getExponent();
+}
+
+
+bool
+UnitTerm::areEquivalent (const UnitTerm& term1, const UnitTerm& term2)
+{
+  if (term1.getKind() != term2.getKind())
+  {
+    return false;
+  }
+
+  // if the kind is dimensionless it doesnt matter
+  // what the exponent is
+  if (term1.getKind() == UNIT_KIND_DIMENSIONLESS)
+  {
+    return true;
+  }
+
+  if (term1.isUnitChecking() || term2.isUnitChecking())
+  {
+    return term1.getOffset() == term2.getOffset()
+        && util_isEqual(term1.getExponentUnitChecking(),
+                        term2.getExponentUnitChecking());
+  }
+
+  return term1.getOffset()   == term2.getOffset()
+      && term1.getExponent() == term2.getExponent();
+}
+
+
+UnitTerms::UnitTerms (unsigned int level, unsigned int version) :
+    mLevel   ( (unsigned char)level   )
+  , mVersion ( (unsigned char)version )
+{
+}
+
+
+UnitTerms::UnitTerms (const UnitDefinition& ud) :
+    mLevel   ( (unsigned char)ud.getLevel()   )
+  , mVersion ( (unsigned char)ud.getVersion() )
+{
+  mUnits.reserve(ud.getNumUnits());
+  for (unsigned int n = 0; n < ud.getNumUnits(); n++)
+  {
+    mUnits.push_back(UnitTerm(*(ud.getUnit(n))));
+  }
+}
+
+
+void
+UnitTerms::copyTo (UnitDefinition& ud) const
+{
+  for (size_t n = 0; n < mUnits.size(); n++)
+  {
+    Unit* unit = ud.createUnit();
+    if (unit != NULL)
+    {
+      mUnits[n].copyTo(*unit);
+    }
+  }
+}
+
+
+UnitTerm*
+UnitTerms::getUnit (unsigned int n)
+{
+  return (n < mUnits.size()) ? &mUnits[n] : NULL;
+}
+
+
+const UnitTerm*
+UnitTerms::getUnit (unsigned int n) const
+{
+  return (n < mUnits.size()) ? &mUnits[n] : NULL;
+}
+
+
+UnitTerm*
+UnitTerms::createUnit ()
+{
+  mUnits.push_back(UnitTerm(mLevel, mVersion));
+  return &mUnits.back();
+}
+
+
+void
+UnitTerms::addUnit (const UnitTerm* unit)
+{
+  if (unit == NULL || !unit->hasRequiredAttributes()
+    || unit->getLevel() != mLevel || unit->getVersion() != mVersion)
+  {
+    return;
+  }
+
+  mUnits.push_back(*unit);
+}
+
+
+void
+UnitTerms::addUnit (const Unit* unit)
+{
+  if (unit == NULL || !unit->hasRequiredAttributes()
+    || unit->getLevel() != mLevel || unit->getVersion() != mVersion)
+  {
+    return;
+  }
+
+  mUnits.push_back(UnitTerm(*unit));
+}
+
+
+void
+UnitTerms::removeUnits ()
+{
+  mUnits.clear();
+}
+
+
+bool
+UnitTerms::isVariantOfDimensionless () const
+{
+  // careful here if we have no units simplify will add dimensionless
+  if (mUnits.empty())
+  {
+    return false;
+  }
+
+  UnitTerms terms(*this);
+  UnitTerms::simplify(terms);
+
+  return terms.getNumUnits() == 1
+      && terms.getUnit(0)->getKind() == UNIT_KIND_DIMENSIONLESS;
+}
+
+
+/*
+ * Follows UnitDefinition::simplify() step by step, as the multipliers it
+ * works out depend on the order in which the units are merged.
+ */
+void
+UnitTerms::simplify (UnitTerms& terms)
+{
+  vector<UnitTerm>& units = terms.mUnits;
+  int cancelFlag = 0;
+  bool dimensionlessPresent = false;
+
+  for (size_t n = 0; n < units.size(); n++)
+  {
+    if (units[n].getKind() == UNIT_KIND_DIMENSIONLESS)
+    {
+      dimensionlessPresent = true;
+    }
+  }
+
+  double dimMultfactor = 1.0;
+  double dimMultfactorSaved = 1.0;
+
+  /* if only one unit cannot be simplified any further */
+  if (units.size() > 1)
+  {
+    if (dimensionlessPresent)
+    {
+      /* if contains a dimensionless unit and any others then
+        dimensionless is unecessary
+        unless it has a multiplier attached
+        */
+      for (size_t n = units.size(); n > 0; n--)
+      {
+        UnitTerm& unit = units[n-1];
+        UnitTerm::removeScale(unit);
+
+        if (unit.getKind() == UNIT_KIND_DIMENSIONLESS)
+        {
+          dimMultfactor = pow(unit.getMultiplier(), unit.getExponent());
+          if (util_isEqual(dimMultfactor, 1.0) == false)
+          {
+            cancelFlag = 1;
+            dimMultfactorSaved = dimMultfactorSaved * dimMultfactor;
+          }
+          units.erase(units.begin() + (n-1));
+        }
+      }
+    }
+
+    /* if it contains two units with same kind these must be combined */
+    for (size_t n = 0; n < units.size(); n++)
+    {
+      /* find other occurences and merge */
+      for (size_t i = n+1; i < units.size();)
+      {
+        if (units[i].getKind() == units[n].getKind())
+        {
+          UnitTerm::merge(units[n], units[i]);
+          units.erase(units.begin() + i);
+        }
+        else
+        {
+          i++;
+        }
+      }
+    }
+  }
+
+  /* may have cancelled units - in which case exponent will be 0 */
+  // might need to propagate a multiplier though
+  double newMultiplier = dimMultfactorSaved;
+  for (size_t n = units.size(); n > 0; n--)
+  {
+    const UnitTerm& unit = units[n-1];
+    bool cancelled = unit.isUnitChecking()
+                   ? (unit.getExponentUnitChecking() == 0)
+                   : (unit.getExponent() == 0);
+    if (cancelled)
+    {
+      newMultiplier = newMultiplier * unit.getMultiplier();
+      units.erase(units.begin() + (n-1));
+      cancelFlag = 1;
+    }
+  }
+
+  /* if all units have been cancelled need to add dimensionless */
+  /* or indeed if one or more have been cancelled need to
+   * propagate any remaining multiplier */
+  if (cancelFlag == 1 || (dimensionlessPresent && units.empty()))
+  {
+    if (units.empty())
+    {
+      UnitTerm unit(terms.mLevel, terms.mVersion);
+      unit.setKind(UNIT_KIND_DIMENSIONLESS);
+      unit.initDefaults();
+      unit.setMultiplier(newMultiplier);
+      terms.addUnit(&unit);
+    }
+    else if (util_isEqual(newMultiplier, 1.0) == false)
+    {
+      UnitTerm& unit = units[0];
+      unit.setMultiplier(unit.getMultiplier() *
+        pow(newMultiplier, 1.0/unit.getExponentAsDouble()));
+    }
+  }
+}
+
+
+/*
+ * Orders the units by kind, keeping units of the same kind in the order
+ * they were in.
+ */
+void
+UnitTerms::reorder (UnitTerms& terms)
+{
+  stable_sort(terms.mUnits.begin(), terms.mUnits.end(), lessKind);
+}
+
+
+UnitTerms
+UnitTerms::convertToSI (const UnitTerms& terms)
+{
+  UnitTerms result(terms.mLevel, terms.mVersion);
+
+  for (size_t n = 0; n < terms.mUnits.size(); n++)
+  {
+    const UnitTerm& original = terms.mUnits[n];
+    UnitTerms converted(original.getLevel(), original.getVersion());
+    UnitTerms::convertToSI(original, converted);
+
+    for (size_t p = 0; p < converted.mUnits.size(); p++)
+    {
+      const UnitTerm& from = converted.mUnits[p];
+      UnitTerm unit(terms.mLevel, terms.mVersion);
+      unit.setKind(from.getKind());
+      if (from.isUnitChecking())
+      {
+        unit.setExponentUnitChecking(from.getExponentUnitChecking());
+      }
+      else
+      {
+        unit.setExponent(from.getExponent());
+      }
+      unit.setScale(from.getScale());
+      unit.setMultiplier(from.getMultiplier());
+      result.addUnit(&unit);
+    }
+  }
+
+  UnitTerms::simplify(result);
+  return result;
+}
+
+
+/*
+ * Follows Unit::convertToSI(), adding the SI units for the given unit to
+ * result.
+ */
+void
+UnitTerms::convertToSI (const UnitTerm& unit, UnitTerms& result)
+{
+  double newMultiplier;
+  UnitKind_t uKind = unit.getKind();
+  UnitTerm newUnit(unit.getLevel(), unit.getVersion());
+  newUnit.setKind(uKind);
+  if (unit.isUnitChecking())
+  {
+    newUnit.setExponentUnitChecking(unit.getExponentUnitChecking());
+  }
+  else
+  {
+    newUnit.setExponent(unit.getExponent());
+  }
+  newUnit.setScale(unit.getScale());
+  newUnit.setMultiplier(unit.getMultiplier());
+
+  UnitTerm::removeScale(newUnit);
+
+  const double exponent = unit.getExponentUnitChecking();
+
+  switch (uKind)
+  {
+    case UNIT_KIND_AMPERE:
+    case UNIT_KIND_CANDELA:
+    case UNIT_KIND_KELVIN:
+    case UNIT_KIND_KILOGRAM:
+    case UNIT_KIND_MOLE:
+    case UNIT_KIND_SECOND:
+      /* SI units */
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_AVOGADRO:
+      /* 1 Avogadro = 6.02214179e23 dimensionless */
+      newUnit.setKind(UNIT_KIND_DIMENSIONLESS);
+      newMultiplier = newUnit.getMultiplier()*6.02214179e23;
+      newUnit.setMultiplier(truncateDoublePrecision(newMultiplier));
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_BECQUEREL:
+    case UNIT_KIND_HERTZ:
+      /* 1 becquerel = 1 sec^-1 = (0.1 sec)^-1 */
+      /* 1 hertz = 1 sec^-1 = (0.1 sec) ^-1*/
+      newUnit.setKind(UNIT_KIND_SECOND);
+      newUnit.setExponentUnitChecking(newUnit.getExponentUnitChecking()*-1);
+      newMultiplier = pow(newUnit.getMultiplier(), -1.0);
+      newUnit.setMultiplier(truncateDoublePrecision(newMultiplier));
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_CELSIUS:
+      /* 1 celsius = 1 Kelvin + 273.15*/
+      newUnit.setKind(UNIT_KIND_KELVIN);
+      newUnit.setOffset(273.15);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_COULOMB:
+      /* 1 coulomb = 1 Ampere second */
+      newUnit.setKind(UNIT_KIND_AMPERE);
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_SECOND);
+      newUnit.setExponentUnitChecking(exponent);
+      newUnit.setMultiplier(1);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_DIMENSIONLESS:
+    case UNIT_KIND_RADIAN:
+    case UNIT_KIND_STERADIAN:
+      /* all dimensionless */
+      newUnit.setKind(UNIT_KIND_DIMENSIONLESS);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_FARAD:
+    case UNIT_KIND_SIEMENS:
+      /* 1 Farad = 1 m^-2 kg^-1 s^4 A^2 */
+      /* 1 siemen = 1 m^-2 kg^-1 s^3 A^2 */
+      newUnit.setKind(UNIT_KIND_AMPERE);
+      newMultiplier = sqrt(newUnit.getMultiplier());
+      newUnit.setMultiplier(truncateDoublePrecision(newMultiplier));
+      newUnit.setExponentUnitChecking(2*newUnit.getExponentUnitChecking());
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_KILOGRAM);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(-1*exponent);
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_METRE);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(-2*exponent);
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_SECOND);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(
+        (uKind == UNIT_KIND_FARAD ? 4 : 3) * exponent);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_GRAM:
+      /* 1 gram = 0.001 Kg */
+      newUnit.setKind(UNIT_KIND_KILOGRAM);
+      newUnit.setMultiplier(0.001 * newUnit.getMultiplier());
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_GRAY:
+    case UNIT_KIND_SIEVERT:
+      /* 1 Gray = 1 m^2 sec^-2 */
+      /* 1 Sievert = 1 m^2 sec^-2 */
+      newUnit.setKind(UNIT_KIND_METRE);
+      newMultiplier = sqrt(newUnit.getMultiplier());
+      newUnit.setMultiplier(truncateDoublePrecision(newMultiplier));
+      newUnit.setExponentUnitChecking(2*newUnit.getExponentUnitChecking());
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_SECOND);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(-2*exponent);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_HENRY:
+    case UNIT_KIND_OHM:
+      /* 1 Henry = 1 m^2 kg s^-2 A^-2 */
+      /* 1 ohm = 1 m^2 kg s^-3 A^-2 */
+      newUnit.setKind(UNIT_KIND_AMPERE);
+      newMultiplier = (1.0/sqrt(newUnit.getMultiplier()));
+      newUnit.setMultiplier(truncateDoublePrecision(newMultiplier));
+      newUnit.setExponentUnitChecking(-2*newUnit.getExponentUnitChecking());
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_KILOGRAM);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(exponent);
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_METRE);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(2*exponent);
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_SECOND);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(
+        (uKind == UNIT_KIND_HENRY ? -2 : -3) * exponent);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_ITEM:
+      newUnit.setKind(UNIT_KIND_ITEM);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_JOULE:
+    case UNIT_KIND_WATT:
+      /* 1 joule = 1 m^2 kg s^-2 */
+      /* 1 watt = 1 m^2 kg s^-3 */
+      newUnit.setKind(UNIT_KIND_KILOGRAM);
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_METRE);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(2*exponent);
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_SECOND);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(
+        (uKind == UNIT_KIND_JOULE ? -2 : -3) * exponent);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_KATAL:
+      /* 1 katal = 1 mol s^-1 */
+      newUnit.setKind(UNIT_KIND_MOLE);
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_SECOND);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(-1*exponent);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_LITER:
+    case UNIT_KIND_LITRE:
+      /* 1 litre = 0.001 m^3 = (0.1 m)^3*/
+      newUnit.setKind(UNIT_KIND_METRE);
+      newUnit.setExponentUnitChecking(newUnit.getExponentUnitChecking()*3);
+      newMultiplier = pow((newUnit.getMultiplier() * 0.001), 1.0/3.0);
+      newUnit.setMultiplier(truncateDoublePrecision(newMultiplier));
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_LUMEN:
+      /* 1 lumen = 1 candela*/
+      newUnit.setKind(UNIT_KIND_CANDELA);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_LUX:
+      /* 1 lux = 1 candela m^-2*/
+      newUnit.setKind(UNIT_KIND_CANDELA);
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_METRE);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(-2*exponent);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_METER:
+    case UNIT_KIND_METRE:
+      /* metre is the SI unit of length */
+      newUnit.setKind(UNIT_KIND_METRE);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_NEWTON:
+    case UNIT_KIND_PASCAL:
+      /* 1 newton = 1 m kg s^-2 */
+      /* 1 pascal = 1 m^-1 kg s^-2 */
+      newUnit.setKind(UNIT_KIND_KILOGRAM);
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_METRE);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(
+        (uKind == UNIT_KIND_NEWTON ? 1 : -1) * exponent);
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_SECOND);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(-2*exponent);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_TESLA:
+    case UNIT_KIND_VOLT:
+    case UNIT_KIND_WEBER:
+      /* 1 tesla = 1 kg s^-2 A^-1 */
+      /* 1 volt = 1 m^2 kg s^-3 A^-1 */
+      /* 1 weber = 1 m^2 kg s^-2 A^-1 */
+      newUnit.setKind(UNIT_KIND_AMPERE);
+      newMultiplier = (1.0/(newUnit.getMultiplier()));
+      newUnit.setMultiplier(truncateDoublePrecision(newMultiplier));
+      newUnit.setExponentUnitChecking(-1*newUnit.getExponentUnitChecking());
+      result.addUnit(&newUnit);
+      newUnit.setKind(UNIT_KIND_KILOGRAM);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(exponent);
+      result.addUnit(&newUnit);
+      if (uKind != UNIT_KIND_TESLA)
+      {
+        newUnit.setKind(UNIT_KIND_METRE);
+        newUnit.setMultiplier(1.0);
+        newUnit.setExponentUnitChecking(2*exponent);
+        result.addUnit(&newUnit);
+      }
+      newUnit.setKind(UNIT_KIND_SECOND);
+      newUnit.setMultiplier(1.0);
+      newUnit.setExponentUnitChecking(
+        (uKind == UNIT_KIND_VOLT ? -3 : -2) * exponent);
+      result.addUnit(&newUnit);
+      break;
+
+    case UNIT_KIND_INVALID:
+      break;
+  }
+}
+
+
+double
+UnitTerms::extractMultiplier (UnitTerms& terms)
+{
+  double multiplier = 1.0;
+
+  for (size_t i = 0; i < terms.mUnits.size(); i++)
+  {
+    UnitTerm& unit = terms.mUnits[i];
+    UnitTerm::removeScale(unit);
+    multiplier = multiplier * pow(unit.getMultiplier(),
+                                  unit.getExponentAsDouble());
+    unit.setMultiplier(1.0);
+    unit.setScale(0);
+  }
+  return multiplier;
+}
+
+
+/*
+ * The terms are those that UnitDefinition::areIdentical() would have
+ * copied into its temporary UnitDefinitions.
+ */
+bool
+UnitTerms::areIdentical (const UnitTerms& terms1, const UnitTerms& terms2)
+{
+  if (terms1.mLevel != terms2.mLevel || terms1.mVersion != terms2.mVersion)
+  {
+    return false;
+  }
+
+  UnitTerms ud1Temp(terms1);
+  UnitTerms ud2Temp(terms2);
+
+  UnitTerms::simplify(ud1Temp);
+  UnitTerms::simplify(ud2Temp);
+
+  if (ud1Temp.getNumUnits() != ud2Temp.getNumUnits())
+  {
+    return false;
+  }
+
+  UnitTerms::reorder(ud1Temp);
+  UnitTerms::reorder(ud2Temp);
+
+  if (ud1Temp.getNumUnits() > 1)
+  {
+    // different multipliers left on different units may not match
+    // but overall they
+    // e.g (2m)(sec) is tha same unit as (m)(2sec) but unit by unit
+    // comparison will fail
+    double multiplier1 = extractMultiplier(ud1Temp);
+    double multiplier2 = extractMultiplier(ud2Temp);
+
+    if (util_isEqual(multiplier1, multiplier2) == false)
+    {
+      return false;
+    }
+  }
+
+  for (size_t n = 0; n < ud1Temp.mUnits.size(); n++)
+  {
+    if (!UnitTerm::areIdentical(ud1Temp.mUnits[n], ud2Temp.mUnits[n]))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+bool
+UnitTerms::areEquivalent (const UnitTerms& terms1, const UnitTerms& terms2)
+{
+  UnitTerms ud1Temp = UnitTerms::convertToSI(terms1);
+  UnitTerms ud2Temp = UnitTerms::convertToSI(terms2);
+
+  if (ud1Temp.getNumUnits() != ud2Temp.getNumUnits())
+  {
+    return false;
+  }
+
+  UnitTerms::reorder(ud1Temp);
+  UnitTerms::reorder(ud2Temp);
+
+  for (size_t n = 0; n < ud1Temp.mUnits.size(); n++)
+  {
+    if (!UnitTerm::areEquivalent(ud1Temp.mUnits[n], ud2Temp.mUnits[n]))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+bool
+UnitTerms::areIdenticalSIUnits (const UnitTerms& terms1,
+                                const UnitTerms& terms2)
+{
+  UnitTerms ud1Temp = UnitTerms::convertToSI(terms1);
+  UnitTerms ud2Temp = UnitTerms::convertToSI(terms2);
+
+  if (ud1Temp.getNumUnits() != ud2Temp.getNumUnits())
+  {
+    return false;
+  }
+
+  UnitTerms::reorder(ud1Temp);
+  UnitTerms::reorder(ud2Temp);
+
+  if (ud1Temp.getNumUnits() > 1)
+  {
+    // different multipliers left on different units may not match
+    // but overall they
+    // e.g (2m)(sec) is tha same unit as (m)(2sec) but unit by unit
+    // comparison will fail
+    double multiplier1 = extractMultiplier(ud1Temp);
+    double multiplier2 = extractMultiplier(ud2Temp);
+
+    if (util_isEqual(multiplier1, multiplier2) == false)
+    {
+      return false;
+    }
+  }
+
+  for (size_t n = 0; n < ud1Temp.mUnits.size(); n++)
+  {
+    const UnitTerm& u1 = ud1Temp.mUnits[n];
+    const UnitTerm& u2 = ud2Temp.mUnits[n];
+    // if the unit is dimensionless it does not matter
+    // what numerical factors it has
+    bool both_dimensionless =
+         u1.getKind() == UNIT_KIND_DIMENSIONLESS
+      && u2.getKind() == UNIT_KIND_DIMENSIONLESS;
+
+    if (!both_dimensionless && !UnitTerm::areIdentical(u1, u2))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+#endif /* __cplusplus */
+LIBSBML_CPP_NAMESPACE_END
+/** @endcond */
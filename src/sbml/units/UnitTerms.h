@@ -0,0 +1,229 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    UnitTerms.h
+ * @brief   Value types holding the units worked out during unit checking
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#ifndef UnitTerms_h
+#define UnitTerms_h
+
+
+#ifdef __cplusplus
+
+#include <vector>
+
+#include <sbml/common/extern.h>
+#include <sbml/UnitKind.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class Unit;
+class UnitDefinition;
+
+/*
+ * The attributes of a Unit, without the rest of an SBase.
+ *
+ * Working out the units of a formula creates and throws away a great many
+ * units, and creating a Unit object means copying namespaces and loading
+ * plugins.  A UnitTerm can be copied about freely instead.  Its setters
+ * and getters behave exactly as those of Unit do for the given Level and
+ * Version, so that code written for Unit gives the same results when
+ * ported to UnitTerm.
+ */
+class UnitTerm
+{
+public:
+
+  /*
+   * Creates a term as a new Unit of the given Level and Version would be.
+   */
+  UnitTerm (unsigned int level, unsigned int version);
+
+
+  /*
+   * Creates a term with the attributes of the given Unit.
+   */
+  explicit UnitTerm (const Unit& unit);
+
+
+  /*
+   * Sets the attributes of the given Unit, which must have the same Level
+   * and Version as this term, to those of this term.
+   */
+  void copyTo (Unit& unit) const;
+
+
+  unsigned int getLevel () const   { return mLevel;   }
+  unsigned int getVersion () const { return mVersion; }
+
+  UnitKind_t getKind () const        { return mKind;       }
+  int        getScale () const       { return mScale;      }
+  double     getMultiplier () const  { return mMultiplier; }
+  double     getOffset () const      { return mOffset;     }
+  int        getExponent () const;
+  double     getExponentAsDouble () const;
+  double     getExponentUnitChecking () const { return mExponentDouble; }
+  bool       isUnitChecking () const { return mInternalUnitCheckingFlag; }
+
+  bool isSetKind () const       { return mKind != UNIT_KIND_INVALID; }
+  bool isSetExponent () const   { return mIsSetExponent;   }
+  bool isSetScale () const      { return mIsSetScale;      }
+  bool isSetMultiplier () const { return mIsSetMultiplier; }
+  bool hasRequiredAttributes () const;
+
+  void setKind (UnitKind_t kind);
+  void setExponent (double value);
+  void setExponentUnitChecking (double value);
+  void setScale (int value);
+  void setMultiplier (double value);
+  void setOffset (double value);
+  void initDefaults ();
+
+
+  /*
+   * These match the static functions of Unit with the same names.
+   */
+  static void removeScale (UnitTerm& term);
+  static void merge (UnitTerm& term1, UnitTerm& term2);
+  static bool areIdentical (const UnitTerm& term1, const UnitTerm& term2);
+  static bool areEquivalent (const UnitTerm& term1, const UnitTerm& term2);
+
+
+private:
+
+  UnitKind_t    mKind;
+  int           mExponent;
+  double        mExponentDouble;
+  int           mScale;
+  double        mMultiplier;
+  double        mOffset;
+
+  unsigned char mLevel;
+  unsigned char mVersion;
+
+  bool          mIsSetExponent;
+  bool          mIsSetScale;
+  bool          mIsSetMultiplier;
+
+  bool          mExplicitlySetExponent;
+  bool          mExplicitlySetMultiplier;
+  bool          mExplicitlySetScale;
+  bool          mExplicitlySetOffset;
+
+  bool          mInternalUnitCheckingFlag;
+};
+
+
+/*
+ * The list of units of a UnitDefinition, as UnitTerm values.
+ *
+ * The UnitFormulaFormatter works out the units of each node of a formula
+ * as UnitTerms, and the comparisons of UnitDefinition convert and simplify
+ * copies of their arguments as UnitTerms, so that the only SBase objects
+ * created are the UnitDefinitions handed back to the caller.  The units
+ * are kept in the order in which they were added, and simplify() and
+ * convertToSI() give the same units as the UnitDefinition functions with
+ * those names, as the messages logged by the unit checks report the units
+ * in that form.
+ */
+class UnitTerms
+{
+public:
+
+  /*
+   * Creates an empty list of units, as a new UnitDefinition of the given
+   * Level and Version would have.
+   */
+  UnitTerms (unsigned int level, unsigned int version);
+
+
+  /*
+   * Creates a list of the units of the given UnitDefinition.
+   */
+  explicit UnitTerms (const UnitDefinition& ud);
+
+
+  /*
+   * Adds units with the attributes of these terms to the given
+   * UnitDefinition, which must have the same Level and Version.
+   */
+  void copyTo (UnitDefinition& ud) const;
+
+
+  unsigned int getLevel () const   { return mLevel;   }
+  unsigned int getVersion () const { return mVersion; }
+
+  unsigned int getNumUnits () const { return (unsigned int)mUnits.size(); }
+
+  UnitTerm*       getUnit (unsigned int n);
+  const UnitTerm* getUnit (unsigned int n) const;
+
+
+  /*
+   * Appends a new unit, which has no attributes set, and returns it.
+   */
+  UnitTerm* createUnit ();
+
+
+  /*
+   * Appends a copy of the given unit, if UnitDefinition::addUnit() would
+   * accept it.
+   */
+  void addUnit (const UnitTerm* unit);
+  void addUnit (const Unit* unit);
+
+
+  /*
+   * Removes all the units.
+   */
+  void removeUnits ();
+
+
+  /*
+   * These match the functions of UnitDefinition with the same names.
+   */
+  bool isVariantOfDimensionless () const;
+
+  static void simplify (UnitTerms& terms);
+  static void reorder (UnitTerms& terms);
+  static UnitTerms convertToSI (const UnitTerms& terms);
+
+  static bool areIdentical (const UnitTerms& terms1, const UnitTerms& terms2);
+  static bool areEquivalent (const UnitTerms& terms1,
+                             const UnitTerms& terms2);
+  static bool areIdenticalSIUnits (const UnitTerms& terms1,
+                                   const UnitTerms& terms2);
+
+
+private:
+
+  static void convertToSI (const UnitTerm& term, UnitTerms& result);
+
+  static double extractMultiplier (UnitTerms& terms);
+
+  unsigned char         mLevel;
+  unsigned char         mVersion;
+  std::vector<UnitTerm> mUnits;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* UnitTerms_h */
+/** @endcond */
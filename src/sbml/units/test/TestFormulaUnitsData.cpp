@@ -748,6 +748,101 @@ END_TEST
 
 
 
+/*
+ * Returns true if the two models have the same derived units.
+ */
+static bool
+haveSameUnits (Model* model1, Model* model2)
+{
+  unsigned int num = model1->getNumFormulaUnitsData();
+  if (num != model2->getNumFormulaUnitsData())
+  {
+    return false;
+  }
+
+  for (unsigned int n = 0; n < num; ++n)
+  {
+    FormulaUnitsData* fud1 = model1->getFormulaUnitsData(n);
+    FormulaUnitsData* fud2 = model2->getFormulaUnitsData(n);
+
+    if (fud1->getUnitReferenceId() != fud2->getUnitReferenceId()
+      || fud1->getComponentTypecode() != fud2->getComponentTypecode()
+      || fud1->getContainsUndeclaredUnits()
+                                      != fud2->getContainsUndeclaredUnits()
+      || fud1->getCanIgnoreUndeclaredUnits()
+                                      != fud2->getCanIgnoreUndeclaredUnits()
+      || !UnitDefinition::areIdentical(fud1->getUnitDefinition(),
+                                       fud2->getUnitDefinition()))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Returns true if the units of the model are those populating the list
+ * of a copy of it gives.
+ */
+static bool
+isUpToDate (Model* model)
+{
+  Model* copy = model->clone();
+  copy->populateListFormulaUnitsData();
+  bool same = haveSameUnits(model, copy);
+  delete copy;
+
+  return same;
+}
+
+
+START_TEST (test_FormulaUnitsData_update)
+{
+  fail_unless(isUpToDate(m));
+
+  /* the units of a parameter the rate rule refers to, and the math of
+   * that rule */
+  m->getParameter("k1")->setUnits("second");
+  m->updateListFormulaUnitsData();
+  fail_unless(isUpToDate(m));
+
+  ASTNode* math = SBML_parseFormula("k2 * cell");
+  m->getRule(1)->setMath(math);
+  delete math;
+  m->updateListFormulaUnitsData();
+  fail_unless(isUpToDate(m));
+
+  /* a new parameter, with a rule for it */
+  Parameter* p = m->createParameter();
+  p->setId("k4");
+  p->setUnits("litre");
+  p->setConstant(false);
+
+  Rule* r = m->createAssignmentRule();
+  r->setVariable("k4");
+  math = SBML_parseFormula("cell * k1");
+  r->setMath(math);
+  delete math;
+  m->updateListFormulaUnitsData();
+  fail_unless(m->getFormulaUnitsData("k4", SBML_ASSIGNMENT_RULE) != NULL);
+  fail_unless(isUpToDate(m));
+
+  /* a unit definition the compartments and local parameters use */
+  m->getUnitDefinition("length")->getUnit(0)->setScale(-3);
+  Model_updateListFormulaUnitsData(m);
+  fail_unless(isUpToDate(m));
+
+  /* removing the reaction */
+  delete m->removeReaction(0);
+  Model_updateListFormulaUnitsData(m);
+  fail_unless(m->getFormulaUnitsData("R", SBML_KINETIC_LAW) == NULL);
+  fail_unless(isUpToDate(m));
+}
+END_TEST
+
+
 Suite *
 create_suite_FormulaUnitsData (void)
 {
@@ -769,6 +864,7 @@ create_suite_FormulaUnitsData (void)
   tcase_add_test(tcase, test_FormulaUnitsData_getevent );
   tcase_add_test(tcase, test_FormulaUnitsData_getById );
   tcase_add_test(tcase, test_FormulaUnitsData_setters );
+  tcase_add_test(tcase, test_FormulaUnitsData_update );
   suite_add_tcase(suite, tcase);
 
   return suite;
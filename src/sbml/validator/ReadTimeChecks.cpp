@@ -0,0 +1,1029 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ReadTimeChecks.cpp
+ * @brief   Makes the checks done while reading SBML on the object tree
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <sbml/validator/ReadTimeChecks.h>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/SBMLErrorLog.h>
+#include <sbml/SyntaxChecker.h>
+#include <sbml/SBO.h>
+#include <sbml/math/ASTNode.h>
+#include <sbml/annotation/CVTerm.h>
+#include <sbml/annotation/ModelHistory.h>
+#include <sbml/annotation/RDFAnnotationParser.h>
+#include <sbml/extension/SBasePlugin.h>
+#include <sbml/util/List.h>
+#include <sbml/util/util.h>
+#include <sbml/xml/XMLNode.h>
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Returns true if the text is made only of white space, which is dropped
+ * when XML is read into an XMLNode.
+ */
+static bool
+isWhiteSpace (const string& text)
+{
+  return text.find_first_not_of(" \t\r\n") == string::npos;
+}
+
+
+/*
+ * Appends to children the elements below the given one, in the order
+ * they are written out (and so read back).
+ */
+static void
+getChildElements (SBase& element, vector<SBase*>& children)
+{
+  switch (element.getTypeCode())
+  {
+  case SBML_DOCUMENT:
+    children.push_back(static_cast<SBMLDocument&>(element).getModel());
+    break;
+
+  case SBML_LIST_OF:
+    {
+      ListOf& list = static_cast<ListOf&>(element);
+      for (unsigned int n = 0; n < list.size(); n++)
+      {
+        children.push_back(list.get(n));
+      }
+    }
+    break;
+
+  case SBML_MODEL:
+    {
+      Model& m = static_cast<Model&>(element);
+      children.push_back(m.getListOfFunctionDefinitions());
+      children.push_back(m.getListOfUnitDefinitions());
+      children.push_back(m.getListOfCompartmentTypes());
+      children.push_back(m.getListOfSpeciesTypes());
+      children.push_back(m.getListOfCompartments());
+      children.push_back(m.getListOfSpecies());
+      children.push_back(m.getListOfParameters());
+      children.push_back(m.getListOfInitialAssignments());
+      children.push_back(m.getListOfRules());
+      children.push_back(m.getListOfConstraints());
+      children.push_back(m.getListOfReactions());
+      children.push_back(m.getListOfEvents());
+    }
+    break;
+
+  case SBML_UNIT_DEFINITION:
+    children.push_back(static_cast<UnitDefinition&>(element).getListOfUnits());
+    break;
+
+  case SBML_REACTION:
+    {
+      Reaction& r = static_cast<Reaction&>(element);
+      children.push_back(r.getListOfReactants());
+      children.push_back(r.getListOfProducts());
+      children.push_back(r.getListOfModifiers());
+      if (r.isSetKineticLaw())
+      {
+        children.push_back(r.getKineticLaw());
+      }
+    }
+    break;
+
+  case SBML_KINETIC_LAW:
+    {
+      // from Level 3 the parameters are the local parameters
+      KineticLaw& kl = static_cast<KineticLaw&>(element);
+      children.push_back(kl.getListOfParameters());
+    }
+    break;
+
+  case SBML_SPECIES_REFERENCE:
+    {
+      SpeciesReference& sr = static_cast<SpeciesReference&>(element);
+      if (sr.isSetStoichiometryMath())
+      {
+        children.push_back(sr.getStoichiometryMath());
+      }
+    }
+    break;
+
+  case SBML_EVENT:
+    {
+      Event& e = static_cast<Event&>(element);
+      if (e.isSetTrigger())
+      {
+        children.push_back(e.getTrigger());
+      }
+      if (e.isSetDelay())
+      {
+        children.push_back(e.getDelay());
+      }
+      if (e.isSetPriority())
+      {
+        children.push_back(e.getPriority());
+      }
+      children.push_back(e.getListOfEventAssignments());
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+
+/*
+ * Logs to log the errors that reading the document back after writing it
+ * out would log, and returns true; or returns false, having logged
+ * nothing, if the document holds something that is not covered here.
+ */
+bool
+ReadTimeChecks::logReadErrors (SBMLDocument& doc, SBMLErrorLog& log)
+{
+  const unsigned int level   = doc.getLevel();
+  const unsigned int version = doc.getVersion();
+
+  // Level 1 is read with its own rules, and package content is read by
+  // the package extensions; neither is covered here
+  if (level < 2 || doc.getModel() == NULL)
+  {
+    return false;
+  }
+
+  if (level > 3 || version < 1 || (level == 2 && version > 5)
+    || (level == 3 && version > 2))
+  {
+    return false;
+  }
+
+  if (doc.getNumUnknownPackages() > 0)
+  {
+    return false;
+  }
+
+  // the reader only checks some content while it has logged nothing, so
+  // the errors are collected apart from whatever the log already holds
+  SBMLErrorLog errors;
+  ReadTimeChecks checks(doc, errors);
+
+  if (!checks.checkElement(doc))
+  {
+    return false;
+  }
+
+  for (unsigned int n = 0; n < errors.getNumErrors(); n++)
+  {
+    log.add(*errors.getError(n));
+  }
+
+  return true;
+}
+
+
+ReadTimeChecks::ReadTimeChecks (SBMLDocument& doc, SBMLErrorLog& log)
+  : mDocument (doc)
+  , mLog      (log)
+  , mLevel    (doc.getLevel())
+  , mVersion  (doc.getVersion())
+{
+}
+
+
+/*
+ * Makes the checks of the reader on an element and the elements below
+ * it, in the order it makes them: the attributes first, then the notes,
+ * the annotation and the elements below.  Returns false if any of them
+ * holds something that is not covered.
+ */
+bool
+ReadTimeChecks::checkElement (SBase& element)
+{
+  // an empty list is not written out, except from L3v2 when it has
+  // something else to show
+  const bool isEmptyList = (element.getTypeCode() == SBML_LIST_OF
+    && static_cast<ListOf&>(element).size() == 0);
+
+  if (isEmptyList)
+  {
+    const ListOf& list = static_cast<const ListOf&>(element);
+    if (mLevel < 3 || mVersion < 2
+      || (!list.hasOptionalElements() && !list.hasOptionalAttributes()
+          && !list.isExplicitlyListed()))
+    {
+      return true;
+    }
+  }
+
+  if (!isCovered(element))
+  {
+    return false;
+  }
+
+  checkIdentifiers(element);
+
+  // the term of the document itself is only checked from L2v3, where
+  // every element has one
+  if (element.getTypeCode() == SBML_DOCUMENT && element.isSetSBOTerm()
+    && (mLevel > 2 || mVersion > 2)
+    && !SBO::isModellingFramework(element.getSBOTerm()))
+  {
+    logError(InvalidSBMLElementSBOTerm, SBO::intToString(element.getSBOTerm())
+      + " does not derive from the modelling framework branch.");
+  }
+
+  if (element.getTypeCode() == SBML_COMPARTMENT && mLevel == 2
+    && static_cast<Compartment&>(element).getSpatialDimensions() > 3)
+  {
+    logError(NotSchemaConformant, "The spatialDimensions attribute on "
+      "a <compartment> may only have values 0, 1, 2 or 3.");
+  }
+
+  // of the unit kinds, the reader only checks that celsius is not used
+  // after L2v1
+  if (element.getTypeCode() == SBML_UNIT
+    && static_cast<Unit&>(element).getKind() == UNIT_KIND_CELSIUS
+    && (mLevel > 2 || mVersion > 1))
+  {
+    SBMLError error(CelsiusNoLongerValid);
+    logError(NotSchemaConformant, error.getMessage());
+  }
+
+  if (element.isSetNotes() && !checkXHTML(element.getNotes(), element))
+  {
+    return false;
+  }
+
+  if (!checkAnnotation(element))
+  {
+    return false;
+  }
+
+  // the message of a constraint is read after its math
+  if (element.getTypeCode() == SBML_CONSTRAINT)
+  {
+    const Constraint& c = static_cast<const Constraint&>(element);
+    if (c.isSetMessage() && !checkXHTML(c.getMessage(), element))
+    {
+      return false;
+    }
+  }
+
+  vector<SBase*> children;
+  getChildElements(element, children);
+
+  for (vector<SBase*>::iterator it = children.begin(); it != children.end(); ++it)
+  {
+    if (!checkElement(**it))
+    {
+      return false;
+    }
+  }
+
+  // an empty list, or a kinetic law with nothing in it, is reported once
+  // it has been read
+  if (isEmptyList)
+  {
+    logEmptyList(static_cast<const ListOf&>(element));
+  }
+  else if (element.getTypeCode() == SBML_KINETIC_LAW)
+  {
+    const KineticLaw& kl = static_cast<const KineticLaw&>(element);
+    if (!kl.isSetMath() && !kl.isSetFormula() && !kl.isSetTimeUnits()
+      && !kl.isSetSubstanceUnits() && !kl.isSetSBOTerm()
+      && kl.getNumParameters() == 0)
+    {
+      logError(EmptyListInReaction);
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Returns false if the element holds something whose checks are not
+ * covered here: an element that may not appear in the Level and Version,
+ * package content, a missing required attribute, an SBO term out of
+ * range, or math that the reader would complain about.
+ */
+bool
+ReadTimeChecks::isCovered (SBase& element)
+{
+  if (element.getLevel() != mLevel || element.getVersion() != mVersion)
+  {
+    return false;
+  }
+
+  // the L3v2 core math is a plugin in the core namespace; anything else
+  // is package content
+  if (element.getNumDisabledPlugins() > 0)
+  {
+    return false;
+  }
+
+  for (unsigned int n = 0; n < element.getNumPlugins(); n++)
+  {
+    if (element.getPlugin(n)->getURI() != element.getURI())
+    {
+      return false;
+    }
+  }
+
+  switch (element.getTypeCode())
+  {
+  case SBML_COMPARTMENT_TYPE:
+  case SBML_SPECIES_TYPE:
+    if (mLevel != 2 || mVersion < 2) return false;
+    break;
+
+  case SBML_INITIAL_ASSIGNMENT:
+  case SBML_CONSTRAINT:
+    if (mLevel == 2 && mVersion < 2) return false;
+    break;
+
+  case SBML_STOICHIOMETRY_MATH:
+    if (mLevel != 2) return false;
+    break;
+
+  case SBML_PRIORITY:
+  case SBML_LOCAL_PARAMETER:
+    if (mLevel < 3) return false;
+    break;
+
+  default:
+    break;
+  }
+
+  // a missing attribute is reported by the reader, but a missing element
+  // is not: what is missing is simply not written
+  if (!element.hasRequiredAttributes())
+  {
+    return false;
+  }
+
+  if (element.isSetSBOTerm() && !SBO::checkTerm(element.getSBOTerm()))
+  {
+    return false;
+  }
+
+  if (element.isSetMath())
+  {
+    bool allowLambda = (element.getTypeCode() == SBML_FUNCTION_DEFINITION);
+    if (!checkMath(element.getMath(), allowLambda))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Checks the syntax of the identifiers of an element, and of the
+ * references to identifiers that the reader checks for that element.
+ */
+void
+ReadTimeChecks::checkIdentifiers (const SBase& element)
+{
+  const int type = element.getTypeCode();
+
+  if (element.isSetMetaId() && !SyntaxChecker::isValidXMLID(element.getMetaId()))
+  {
+    logError(InvalidMetaidSyntax, "The metaid '" + element.getMetaId()
+      + "' does not conform to the syntax.");
+  }
+
+  // from L3v2 the id of any element is read by SBase; before, only by the
+  // elements that have one.  Rules and assignments are not checked here,
+  // as their id is their variable
+  const string& id = element.getIdAttribute();
+
+  if (mLevel == 3 && mVersion > 1)
+  {
+    if (type != SBML_ASSIGNMENT_RULE && type != SBML_RATE_RULE
+      && type != SBML_ALGEBRAIC_RULE && type != SBML_EVENT_ASSIGNMENT
+      && type != SBML_INITIAL_ASSIGNMENT
+      && !SyntaxChecker::isValidInternalSId(id))
+    {
+      logError(InvalidIdSyntax);
+    }
+  }
+  else
+  {
+    bool hasId = false;
+
+    switch (type)
+    {
+    case SBML_MODEL:
+    case SBML_FUNCTION_DEFINITION:
+    case SBML_UNIT_DEFINITION:
+    case SBML_COMPARTMENT_TYPE:
+    case SBML_SPECIES_TYPE:
+    case SBML_COMPARTMENT:
+    case SBML_SPECIES:
+    case SBML_PARAMETER:
+    case SBML_LOCAL_PARAMETER:
+    case SBML_REACTION:
+    case SBML_EVENT:
+      hasId = true;
+      break;
+
+    case SBML_SPECIES_REFERENCE:
+    case SBML_MODIFIER_SPECIES_REFERENCE:
+      hasId = (mLevel > 2 || mVersion > 1);
+      break;
+
+    default:
+      break;
+    }
+
+    if (hasId && !SyntaxChecker::isValidInternalSId(id))
+    {
+      logError(InvalidIdSyntax, "The id '" + id
+        + "' does not conform to the syntax.");
+    }
+  }
+
+  switch (type)
+  {
+  case SBML_MODEL:
+    if (mLevel > 2)
+    {
+      const Model& m = static_cast<const Model&>(element);
+      checkUnits(m.getSubstanceUnits(), "substanceUnits");
+      checkUnits(m.getTimeUnits(), "timeUnits");
+      checkUnits(m.getVolumeUnits(), "volumeUnits");
+      checkUnits(m.getAreaUnits(), "areaUnits");
+      checkUnits(m.getLengthUnits(), "lengthUnits");
+      checkUnits(m.getExtentUnits(), "extentUnits");
+    }
+    break;
+
+  case SBML_COMPARTMENT:
+    checkUnits(static_cast<const Compartment&>(element).getUnits(), "units");
+    break;
+
+  case SBML_SPECIES:
+    {
+      const Species& s = static_cast<const Species&>(element);
+      checkUnits(s.getSubstanceUnits(), "substanceUnits");
+      if (mLevel == 2 && mVersion < 3)
+      {
+        checkUnits(s.getSpatialSizeUnits(), "spatialSizeUnits");
+      }
+      if (mLevel > 2 && !SyntaxChecker::isValidInternalSId(s.getConversionFactor()))
+      {
+        logError(InvalidIdSyntax, "The conversionFactor '"
+          + s.getConversionFactor() + "' does not conform to the syntax.");
+      }
+    }
+    break;
+
+  case SBML_PARAMETER:
+  case SBML_LOCAL_PARAMETER:
+    checkUnits(static_cast<const Parameter&>(element).getUnits(), "units");
+    break;
+
+  case SBML_EVENT:
+    if (mLevel == 2 && mVersion < 3)
+    {
+      checkUnits(static_cast<const Event&>(element).getTimeUnits(), "timeUnits");
+    }
+    break;
+
+  case SBML_REACTION:
+    {
+      const Reaction& r = static_cast<const Reaction&>(element);
+      if (mLevel > 2 && !SyntaxChecker::isValidInternalSId(r.getCompartment()))
+      {
+        logError(InvalidIdSyntax, "The compartment '" + r.getCompartment()
+          + "' does not conform to the syntax.");
+      }
+    }
+    break;
+
+  case SBML_ASSIGNMENT_RULE:
+  case SBML_RATE_RULE:
+  case SBML_EVENT_ASSIGNMENT:
+  case SBML_INITIAL_ASSIGNMENT:
+    // the variable (or symbol) is what getId() returns for these
+    if (!SyntaxChecker::isValidInternalSId(element.getId()))
+    {
+      logError(InvalidIdSyntax, "The id '" + element.getId()
+        + "' does not conform to the syntax.");
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+
+/*
+ * Checks the syntax of a reference to a unit, as the reader does.
+ */
+void
+ReadTimeChecks::checkUnits (const string& units, const string& attribute)
+{
+  if (!SyntaxChecker::isValidInternalUnitSId(units))
+  {
+    logError(InvalidUnitIdSyntax, "The " + attribute + " attribute '"
+      + units + "' does not conform to the syntax.");
+  }
+}
+
+
+/*
+ * Checks notes or a constraint message the way SBase::readNotes() and
+ * SBase::checkXHTML() do when they are read: the content is only looked
+ * at while nothing at all has been logged.  Returns false if the content
+ * would not be read back as it is.
+ */
+bool
+ReadTimeChecks::checkXHTML (const XMLNode* xhtml, const SBase& element)
+{
+  const bool isNotes = (xhtml->getName() == "notes");
+  const unsigned int errorNS   = isNotes ? NotesNotInXHTMLNamespace
+                                         : ConstraintNotInXHTMLNamespace;
+  const unsigned int errorELEM = isNotes ? InvalidNotesContent
+                                         : InvalidConstraintContent;
+
+  const string& defaultURI = xhtml->getNamespaces().getURI("");
+  if (!defaultURI.empty() && defaultURI != element.getURI())
+  {
+    logError(NotSchemaConformant, "xmlns=\"" + defaultURI + "\" in <"
+      + xhtml->getName() + "> element is an invalid namespace.");
+  }
+
+  // text made only of white space is dropped when it is read, and text
+  // next to text would be read as one
+  vector<const XMLNode*> children;
+  for (unsigned int i = 0; i < xhtml->getNumChildren(); i++)
+  {
+    const XMLNode& child = xhtml->getChild(i);
+    if (child.isText())
+    {
+      if (isWhiteSpace(child.getCharacters()))
+      {
+        continue;
+      }
+      if (!children.empty() && children.back()->isText())
+      {
+        return false;
+      }
+    }
+    children.push_back(&child);
+  }
+
+  if (mLog.getNumErrors() > 0)
+  {
+    return true;
+  }
+
+  const XMLNamespaces* toplevelNS = mDocument.getNamespaces();
+
+  if (children.size() > 1)
+  {
+    for (unsigned int i = 0; i < children.size(); i++)
+    {
+      if (!SyntaxChecker::isAllowedElement(*children[i]))
+      {
+        logError(errorELEM);
+      }
+      else if (!SyntaxChecker::hasDeclaredNS(*children[i], toplevelNS))
+      {
+        logError(errorNS);
+      }
+    }
+  }
+  else if (children.empty())
+  {
+    logError(errorELEM);
+  }
+  else
+  {
+    const XMLNode& top = *children[0];
+    const string& name = top.getName();
+
+    if (name != "html" && name != "body" && !SyntaxChecker::isAllowedElement(top))
+    {
+      logError(errorELEM);
+    }
+    else
+    {
+      if (!SyntaxChecker::hasDeclaredNS(top, toplevelNS))
+      {
+        logError(errorNS);
+      }
+      if (name == "html" && !SyntaxChecker::isCorrectHTMLNode(top))
+      {
+        logError(errorELEM);
+      }
+    }
+  }
+
+  return true;
+}
+
+
+/*
+ * Checks the annotation of an element, as it would be written, the way
+ * SBase::checkAnnotation() does when it is read, then its RDF.  Returns
+ * false if it would not be read back as it is.
+ */
+bool
+ReadTimeChecks::checkAnnotation (SBase& element)
+{
+  const XMLNode* annotation = element.getAnnotation();
+  if (annotation == NULL)
+  {
+    return true;
+  }
+
+  const string& defaultURI = annotation->getNamespaces().getURI("");
+  if (!defaultURI.empty() && defaultURI != element.getURI())
+  {
+    logError(NotSchemaConformant, "xmlns=\"" + defaultURI
+      + "\" in <annotation> element is an invalid namespace.");
+  }
+
+  const XMLNamespaces* toplevelNS = mDocument.getNamespaces();
+  vector<string> uris;
+  bool lastWasText = false;
+
+  for (unsigned int i = 0; i < annotation->getNumChildren(); i++)
+  {
+    const XMLNode& top = annotation->getChild(i);
+
+    if (!top.isStart())
+    {
+      // as for notes, white space is dropped and text next to text is
+      // read as one
+      if (top.isText() && isWhiteSpace(top.getCharacters()))
+      {
+        continue;
+      }
+      if (lastWasText)
+      {
+        return false;
+      }
+      lastWasText = top.isText();
+      logError(AnnotationNotElement);
+      continue;
+    }
+    lastWasText = false;
+
+    const string& uri = top.getURI();
+    const string& prefix = top.getPrefix();
+
+    // a prefix that is not declared is an error of the XML parser
+    if (uri.empty() && !prefix.empty())
+    {
+      return false;
+    }
+
+    if (!uri.empty())
+    {
+      if (find(uris.begin(), uris.end(), uri) != uris.end())
+      {
+        logError(DuplicateAnnotationNamespaces, "An SBML <"
+          + element.getElementName() + "> element has an <annotation> child "
+          "with multiple children with the same namespace.");
+      }
+      uris.push_back(uri);
+    }
+
+    bool implicitNSdecl = false;
+    if (top.getNamespaces().getLength() == 0)
+    {
+      for (int n = 0; toplevelNS != NULL && n < toplevelNS->getLength(); n++)
+      {
+        if (toplevelNS->getPrefix(n) == prefix)
+        {
+          implicitNSdecl = true;
+          break;
+        }
+      }
+
+      if (!implicitNSdecl)
+      {
+        logError(MissingAnnotationNamespace);
+      }
+    }
+
+    bool match = false;
+    for (int n = 0; !match && n < top.getNamespaces().getLength(); n++)
+    {
+      match = SBMLNamespaces::isSBMLNamespace(top.getNamespaces().getURI(n));
+    }
+
+    if (match)
+    {
+      logError(SBMLNamespaceInAnnotation, "An SBML <"
+        + element.getElementName() + "> element uses a restricted namespace "
+        "on an element in its child <annotation>.");
+      break;
+    }
+
+    if (implicitNSdecl && prefix.empty())
+    {
+      if (mLevel < 3)
+      {
+        logError(MissingAnnotationNamespace);
+      }
+      logError(SBMLNamespaceInAnnotation);
+    }
+  }
+
+  checkRDF(element, annotation);
+  return true;
+}
+
+
+/*
+ * Makes the checks of the RDF parser on an annotation: the rdf:about of
+ * the description is checked each time the model history or the
+ * CVTerms are read from it.  The model history is read for the model and
+ * species references, and for any element from Level 3; nested CVTerms
+ * are only reported where SBase reads the annotation.
+ */
+void
+ReadTimeChecks::checkRDF (const SBase& element, const XMLNode* annotation)
+{
+  const int type = element.getTypeCode();
+  const bool readByElement = (type == SBML_MODEL || type == SBML_SPECIES_REFERENCE);
+
+  const bool hasHistory = (readByElement || mLevel > 2)
+    && RDFAnnotationParser::hasHistoryRDFAnnotation(annotation);
+  const bool hasCVTerms = RDFAnnotationParser::hasCVTermRDFAnnotation(annotation);
+
+  if (!hasHistory && !hasCVTerms)
+  {
+    return;
+  }
+
+  const XMLTriple rdfAbout("about",
+    "http://www.w3.org/1999/02/22-rdf-syntax-ns#", "rdf");
+  const XMLNode& desc = annotation->getChild("RDF").getChild("Description");
+
+  unsigned int aboutError = 0;
+  if (desc.hasAttr(rdfAbout) || desc.hasAttr("rdf:about"))
+  {
+    const string about = desc.hasAttr(rdfAbout) ? desc.getAttrValue(rdfAbout)
+                                                : desc.getAttrValue("rdf:about");
+    if (about.empty())
+    {
+      aboutError = RDFEmptyAboutTag;
+    }
+    else if (about.find(element.getMetaId()) == string::npos)
+    {
+      aboutError = RDFAboutTagNotMetaid;
+    }
+  }
+  else
+  {
+    aboutError = RDFMissingAboutTag;
+  }
+
+  if (hasHistory)
+  {
+    if (aboutError != 0)
+    {
+      logError(aboutError);
+    }
+    else
+    {
+      ModelHistory* history = RDFAnnotationParser::parseRDFAnnotation(
+        annotation, element.getMetaId().c_str());
+      if (history != NULL && !history->hasRequiredAttributes())
+      {
+        logError(RDFNotCompleteModelHistory,
+          "An invalid ModelHistory element has been stored.");
+      }
+      delete history;
+    }
+  }
+
+  if (hasCVTerms)
+  {
+    if (aboutError != 0)
+    {
+      logError(aboutError);
+    }
+    else if (!readByElement && (mLevel != 2 || mVersion != 5))
+    {
+      List terms;
+      RDFAnnotationParser::parseRDFAnnotation(annotation, &terms,
+        element.getMetaId().c_str());
+
+      bool hasNestedTerms = false;
+      for (unsigned int n = 0; n < terms.getSize(); n++)
+      {
+        CVTerm* term = static_cast<CVTerm*>(terms.get(n));
+        hasNestedTerms = hasNestedTerms || term->getNumNestedCVTerms() > 0;
+        delete term;
+      }
+
+      if (hasNestedTerms)
+      {
+        logError(NestedAnnotationNotAllowed, "The nested annotation has "
+          "been stored but will not be written out.");
+      }
+    }
+  }
+}
+
+
+/*
+ * Logs the error SBase::checkListOfPopulated() logs for an empty list.
+ */
+void
+ReadTimeChecks::logEmptyList (const ListOf& list)
+{
+  const SBase* parent = list.getParentSBMLObject();
+  unsigned int error = EmptyListElement;
+
+  switch (list.getItemTypeCode())
+  {
+  case SBML_UNIT:
+    error = (mLevel < 3) ? EmptyListOfUnits : EmptyUnitListElement;
+    break;
+
+  case SBML_SPECIES_REFERENCE:
+  case SBML_MODIFIER_SPECIES_REFERENCE:
+    error = EmptyListInReaction;
+    break;
+
+  case SBML_PARAMETER:
+    if (parent != NULL && parent->getTypeCode() == SBML_KINETIC_LAW)
+    {
+      error = EmptyListInKineticLaw;
+    }
+    break;
+
+  case SBML_LOCAL_PARAMETER:
+    error = EmptyListInKineticLaw;
+    break;
+
+  case SBML_EVENT_ASSIGNMENT:
+    if (mLevel > 2)
+    {
+      error = MissingEventAssignment;
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  logError(error);
+}
+
+
+/*
+ * Logs an error with the Level and Version of the document, as the
+ * reader does.
+ */
+void
+ReadTimeChecks::logError (unsigned int errorId, const string& details)
+{
+  mLog.logError(errorId, mLevel, mVersion, details);
+}
+
+
+/*
+ * Checks that the math would be written with MathML elements and
+ * attributes the reader accepts for the Level and Version, and that every
+ * operator has the right number of arguments.  A lambda is allowed only
+ * at the top of the math of a function definition.
+ */
+bool
+ReadTimeChecks::checkMath (const ASTNode* node, bool allowLambda)
+{
+  if (node == NULL)
+  {
+    return false;
+  }
+
+  const ASTNodeType_t type = node->getType();
+
+  switch (type)
+  {
+  case AST_PLUS:
+  case AST_MINUS:
+  case AST_TIMES:
+  case AST_DIVIDE:
+  case AST_POWER:
+    break;
+
+  case AST_LAMBDA:
+    if (!allowLambda) return false;
+    break;
+
+  case AST_NAME_AVOGADRO:
+    if (mLevel < 3) return false;
+    break;
+
+  case AST_FUNCTION_MAX:
+  case AST_FUNCTION_MIN:
+  case AST_FUNCTION_QUOTIENT:
+  case AST_FUNCTION_RATE_OF:
+  case AST_FUNCTION_REM:
+  case AST_LOGICAL_IMPLIES:
+    if (mLevel < 3 || (mLevel == 3 && mVersion < 2)) return false;
+    break;
+
+  default:
+    if (type < AST_INTEGER || type > AST_RELATIONAL_NEQ) return false;
+    break;
+  }
+
+  if (node->isSetDefinitionURL()
+    && type != AST_NAME_TIME && type != AST_FUNCTION_DELAY
+    && type != AST_NAME_AVOGADRO && type != AST_FUNCTION_RATE_OF)
+  {
+    return false;
+  }
+
+  if (node->isSemantics() || node->getNumSemanticsAnnotations() > 0)
+  {
+    return false;
+  }
+
+  if (node->isSetUnits())
+  {
+    if (mLevel < 3 || !node->isNumber()
+      || !SyntaxChecker::isValidInternalUnitSId(node->getUnits()))
+    {
+      return false;
+    }
+  }
+
+  switch (type)
+  {
+  case AST_REAL:
+  case AST_REAL_E:
+    if (!util_isFinite(node->getReal())) return false;
+    break;
+
+  case AST_RATIONAL:
+    if (node->getDenominator() == 0) return false;
+    break;
+
+  case AST_NAME:
+  case AST_FUNCTION:
+    if (node->getName() == NULL || *node->getName() == '\0'
+      || !SyntaxChecker::isValidInternalSId(node->getName()))
+    {
+      return false;
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  if (!node->hasCorrectNumberArguments())
+  {
+    return false;
+  }
+
+  for (unsigned int n = 0; n < node->getNumChildren(); n++)
+  {
+    if (!checkMath(node->getChild(n), false))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+LIBSBML_CPP_NAMESPACE_END
+
+/** @endcond */
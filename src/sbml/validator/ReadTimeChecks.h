@@ -0,0 +1,106 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ReadTimeChecks.h
+ * @brief   Makes the checks done while reading SBML on the object tree
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#ifndef ReadTimeChecks_h
+#define ReadTimeChecks_h
+
+
+#ifdef __cplusplus
+
+
+#include <sbml/common/extern.h>
+
+#include <string>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class SBMLDocument;
+class SBMLErrorLog;
+class SBase;
+class ListOf;
+class ASTNode;
+class XMLNode;
+
+/*
+ * Many checks are only made while SBML is being read: the syntax of
+ * identifiers, the MathML elements and attributes allowed in a Level and
+ * Version, the content of notes and annotations, and so on.  To report
+ * them for a document built in memory, checkInternalConsistency() used to
+ * write the document out and read it back.
+ *
+ * ReadTimeChecks makes the same checks on the object tree itself, element
+ * by element in the order the reader would meet them, and logs the errors
+ * the reader would log, with the same codes.  What it does not cover
+ * (Level 1, packages, math, SBO terms and missing attributes, among
+ * others) it only detects, in which case the caller falls back on the
+ * round trip.
+ */
+class ReadTimeChecks
+{
+public:
+
+  /*
+   * Logs to @p log the errors that reading the document back after
+   * writing it out would log, and returns true; or returns false, having
+   * logged nothing, if the document holds something that is not covered
+   * here.  The annotations of the document are synchronized as they would
+   * be by writing it.
+   */
+  static bool logReadErrors (SBMLDocument& doc, SBMLErrorLog& log);
+
+
+private:
+
+  ReadTimeChecks (SBMLDocument& doc, SBMLErrorLog& log);
+
+  bool checkElement (SBase& element);
+
+  bool isCovered (SBase& element);
+
+  void checkIdentifiers (const SBase& element);
+
+  void checkUnits (const std::string& units, const std::string& attribute);
+
+  bool checkXHTML (const XMLNode* xhtml, const SBase& element);
+
+  bool checkAnnotation (SBase& element);
+
+  void checkRDF (const SBase& element, const XMLNode* annotation);
+
+  bool checkMath (const ASTNode* node, bool allowLambda);
+
+  void logEmptyList (const ListOf& list);
+
+  void logError (unsigned int errorId, const std::string& details = "");
+
+
+  SBMLDocument& mDocument;
+  SBMLErrorLog& mLog;
+  unsigned int  mLevel;
+  unsigned int  mVersion;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* ReadTimeChecks_h */
+/** @endcond */
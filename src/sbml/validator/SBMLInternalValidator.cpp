@@ -48,6 +48,12 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <set>
+
+#ifdef LIBSBML_USE_THREADS
+#include <atomic>
+#include <thread>
+#endif
 
 #include <sbml/validator/ConsistencyValidator.h>
 #include <sbml/validator/IdentifierConsistencyValidator.h>
@@ -64,9 +70,14 @@
 #include <sbml/validator/L3v1CompatibilityValidator.h>
 #include <sbml/validator/L3v2CompatibilityValidator.h>
 #include <sbml/validator/InternalConsistencyValidator.h>
+#include <sbml/validator/ReadTimeChecks.h>
+#include <sbml/validator/ValidatedState.h>
+#include <sbml/validator/ValidationCallback.h>
+#include <sbml/validator/ValidatorCache.h>
 #include <sbml/SBMLDocument.h>
 #include <sbml/SBMLWriter.h>
 #include <sbml/SBMLReader.h>
+#include <sbml/SBO.h>
 #include <sbml/AlgebraicRule.h>
 #include <sbml/AssignmentRule.h>
 #include <sbml/RateRule.h>
@@ -82,6 +93,12 @@ SBMLInternalValidator::SBMLInternalValidator()
   : SBMLValidator()
   , mApplicableValidators(0)
   , mApplicableValidatorsForConversion(0)
+  , mNumThreads(1)
+  , mRoundTripReadChecks(false)
+  , mProfile(NULL)
+  , mCallback(NULL)
+  , mValidatedState(NULL)
+  , mCheckIncrementally(false)
 {
 
 }
@@ -91,6 +108,12 @@ SBMLInternalValidator::SBMLInternalValidator(const SBMLInternalValidator& orig)
   : SBMLValidator(orig)
   , mApplicableValidators(orig.mApplicableValidators)
   , mApplicableValidatorsForConversion(orig.mApplicableValidatorsForConversion)
+  , mNumThreads(orig.mNumThreads)
+  , mRoundTripReadChecks(orig.mRoundTripReadChecks)
+  , mProfile(orig.mProfile)
+  , mCallback(orig.mCallback)
+  , mValidatedState(NULL)
+  , mCheckIncrementally(false)
 {
 }
 
@@ -106,6 +129,7 @@ SBMLInternalValidator::clone() const
  */
 SBMLInternalValidator::~SBMLInternalValidator ()
 {
+  delete mValidatedState;
 
 }
 
@@ -304,262 +328,858 @@ SBMLInternalValidator::setConsistencyChecksForConversion(SBMLErrorCategory_t cat
   }
 
 }
+/** @cond doxygenLibsbmlInternal */
+#ifdef LIBSBML_USE_THREADS
 /*
- * Performs a set of semantic consistency checks on the document.  Query
- * the results by calling getNumErrors() and getError().
+ * A piece of the work runConcurrently() shares out between its threads:
+ * a pass run on its own validator or, when the checks the pass makes of
+ * single objects are shared out, the checks of some of the components of
+ * the model on another validator of the same category.
+ */
+struct PassJob
+{
+  PassJob (CachedValidator* p, bool o) : pass(p), own(o), finished(false) { }
+
+  CachedValidator*        pass;
+  bool                    own;
+  std::set<const SBase*>  components;
+  std::list<SBMLError>    failures;
+  std::list<unsigned int> positions;
+  bool                    finished;
+};
+
+
+/*
+ * Returns true if the checks of single objects made by the pass of the
+ * given category can be shared out.  The SBO pass drops failures once it
+ * has found them all, and the overdetermined pass only checks the model
+ * as a whole.
+ */
+static bool
+canShareOut(SBMLErrorCategory_t category)
+{
+  return category != LIBSBML_CAT_SBO_CONSISTENCY
+    && category != LIBSBML_CAT_OVERDETERMINED_MODEL;
+}
+
+
+/*
+ * Adds the components of the model (the children of its ListOf objects)
+ * in the order in which the validators come to them.
+ */
+static void
+getComponents(const Model& m, std::vector<const SBase*>& components)
+{
+  const ListOf* lists[] =
+  {
+    m.getListOfFunctionDefinitions(),
+    m.getListOfUnitDefinitions(),
+    m.getListOfCompartmentTypes(),
+    m.getListOfSpeciesTypes(),
+    m.getListOfCompartments(),
+    m.getListOfSpecies(),
+    m.getListOfParameters(),
+    m.getListOfInitialAssignments(),
+    m.getListOfRules(),
+    m.getListOfConstraints(),
+    m.getListOfReactions(),
+    m.getListOfEvents()
+  };
+
+  for (size_t n = 0; n < sizeof(lists) / sizeof(lists[0]); ++n)
+  {
+    for (unsigned int i = 0; i < lists[n]->size(); ++i)
+    {
+      components.push_back(lists[n]->get(i));
+    }
+  }
+}
+
+
+/*
+ * The body of each thread started by runConcurrently(): it keeps taking
+ * the next job nobody has started yet, so that one slow job does not
+ * hold up the others.  A job that throws is left unfinished.
+ */
+static void
+runJobsFromQueue(std::vector<PassJob>* jobs, const SBMLDocument* doc,
+                 ValidatorProfile* profile, std::atomic<size_t>* next)
+{
+  size_t n;
+  while ((n = (*next)++) < jobs->size())
+  {
+    PassJob& job = (*jobs)[n];
+    try
+    {
+      if (job.own)
+      {
+        job.pass->get().validate(*doc);
+      }
+      else
+      {
+        CachedValidator validator(job.pass->getCategory(), profile);
+        validator.get().setComponentsToCheck(&job.components);
+        validator.get().setCheckWholeModel(false);
+        validator.get().validate(*doc);
+        job.failures = validator.get().getFailures();
+        job.positions = validator.get().getFailurePositions();
+      }
+      job.finished = true;
+    }
+    catch (...)
+    {
+    }
+  }
+}
+#endif
+
+
+/*
+ * Runs the given validators on the document on up to numThreads threads
+ * and records in 'done' the ones that have finished, whose failures are
+ * then waiting in them.  When shareOut is true, the checks a pass makes
+ * of single objects are shared out as well: the components of the model
+ * are dealt out between runs, each checked on a validator of its own,
+ * while the pass's own validator only checks the document and the model
+ * as a whole.  The failures of the runs are then
+ * merged with those of the pass's validator by where in the checks they
+ * were found (see Validator::getFailurePositions()), which puts them in
+ * the order they would be found on one thread.
  *
- * @return the number of failed checks (errors) encountered.
+ * A pass one of whose jobs threw is reset, to be run again (and throw
+ * again) on the calling thread.  Without thread support, or with fewer
+ * than two jobs or threads, this does nothing and the validators are run
+ * by runValidator() as they are reached.
  */
-unsigned int
-SBMLInternalValidator::checkConsistency (bool writeDocument)
+static void
+runConcurrently(const std::vector<CachedValidator*>& validators,
+                SBMLDocument& doc, unsigned int numThreads, bool shareOut,
+                ValidatorProfile* profile,
+                std::set<const CachedValidator*>& done)
 {
-  unsigned int nerrors = 0;
-  unsigned int total_errors = 0;
+#ifdef LIBSBML_USE_THREADS
+  if (validators.empty() || numThreads < 2)
+  {
+    return;
+  }
 
-  //if (getLevel() == 3)
-  //{
-  //  logError(L3NotSupported);
-  //  return 1;
-  //}
-  /* determine which validators to run */
-  bool id    = ((mApplicableValidators & 0x01) == 0x01);
-  bool sbml  = ((mApplicableValidators & 0x02) == 0x02);
-  bool sbo   = ((mApplicableValidators & 0x04) == 0x04);
-  bool math  = ((mApplicableValidators & 0x08) == 0x08);
-  bool units = ((mApplicableValidators & 0x10) == 0x10);
-  bool over  = ((mApplicableValidators & 0x20) == 0x20);
-  bool practice = ((mApplicableValidators & 0x40) == 0x40);
-
-  /* taken the state machine concept out for now
-  if (LibSBMLStateMachine::isActive()) 
-  {
-    units = LibSBMLStateMachine::getUnitState();
-  }
-  */
-
-  SBMLDocument *doc;
-  SBMLErrorLog *log = getErrorLog();
-  
-  if (writeDocument)
+  std::vector<const SBase*> components;
+  if (shareOut && doc.getModel() != NULL)
   {
-    char* sbmlString = writeSBMLToString(getDocument());
-    log->clearLog();
-    doc = readSBMLFromString(sbmlString);
-    free (sbmlString);  
+    getComponents(*doc.getModel(), components);
   }
-  else
+
+  // each run goes through the whole model, so there is one per thread;
+  // the components are dealt out in turn, so that each run gets its share
+  // of the reactions and rules, which take longest to check
+  size_t numRuns = std::min(components.size(), (size_t)numThreads);
+  if (numRuns < 2)
   {
-    doc = getDocument();
+    numRuns = 0;
   }
 
-  /* calls each specified validator in turn 
-   * - stopping when errors are encountered */
+  std::vector<PassJob> jobs;
+  for (size_t v = 0; v < validators.size(); ++v)
+  {
+    jobs.push_back(PassJob(validators[v], true));
+    if (!canShareOut(validators[v]->getCategory()))
+    {
+      continue;
+    }
 
-  /* look to see if we have serious errors from the read
-   * these may cause other validators to crash
-   * although hopefully not it is probably best to guard
-   * against trying
-   */
-  bool seriousErrors = doc->getNumErrors(LIBSBML_SEV_FATAL) > 0
-    || doc->getNumErrors(LIBSBML_SEV_ERROR) > 0;
+    size_t first = jobs.size();
+    for (size_t r = 0; r < numRuns; ++r)
+    {
+      jobs.push_back(PassJob(validators[v], false));
+    }
+    for (size_t c = 0; c < components.size() && numRuns > 0; ++c)
+    {
+      jobs[first + c % numRuns].components.insert(components[c]);
+    }
+  }
 
+  if (jobs.size() < 2)
+  {
+    return;
+  }
 
-  // do not try and go further but do not report the errors as these
-  // will have been recorded elsewhere and do not come from the validators
-  if (seriousErrors == true)
+  // the validators of the passes are acquired here, not by the threads;
+  // those whose checks are shared out check none of the components
+  std::set<const SBase*> none;
+  for (size_t n = 0; n < jobs.size(); ++n)
   {
-    return 0;
+    if (jobs[n].own && n + 1 < jobs.size() && !jobs[n + 1].own)
+    {
+      jobs[n].pass->get().setComponentsToCheck(&none);
+    }
+    else if (jobs[n].own)
+    {
+      jobs[n].pass->get();
+    }
   }
 
+  // nothing may be filled in on first use while the threads are reading;
+  // this includes the SBO tree behind the SBO::is...() checks
+  doc.prepareForConcurrentReading();
+  SBO::isQuantitativeParameter(0);
+
+  size_t numWorkers = std::min((size_t)numThreads, jobs.size());
+  std::atomic<size_t> next(0);
+
+  std::vector<std::thread> threads;
+  for (size_t t = 1; t < numWorkers; ++t)
+  {
+    threads.push_back(std::thread(runJobsFromQueue, &jobs, &doc, profile,
+                                  &next));
+  }
+  runJobsFromQueue(&jobs, &doc, profile, &next);
+  for (size_t t = 0; t < threads.size(); ++t)
+  {
+    threads[t].join();
+  }
 
-  if (id)
+  size_t n = 0;
+  while (n < jobs.size())
   {
-    IdentifierConsistencyValidator id_validator;
-    id_validator.init();
-    nerrors = id_validator.validate(*doc);
-    if (nerrors > 0) 
+    CachedValidator* pass = jobs[n].pass;
+    size_t first = n;
+    bool finished = true;
+    for (; n < jobs.size() && jobs[n].pass == pass; ++n)
+    {
+      finished = finished && jobs[n].finished;
+    }
+
+    Validator& validator = pass->get();
+    if (n - first > 1)
     {
-      unsigned int origNum = log->getNumErrors();
-      log->add( id_validator.getFailures() );
+      validator.setComponentsToCheck(NULL);
+    }
 
-      if (origNum > 0 && log->contains(InvalidUnitIdSyntax) == true)
+    if (!finished)
+    {
+      validator.reset();
+      continue;
+    }
+
+    if (n - first > 1)
+    {
+      std::multimap<unsigned int, SBMLError> merged;
+      for (size_t j = first; j < n; ++j)
       {
-        /* do not log dangling ref */
-        while (log->contains(DanglingUnitSIdRef) == true)
+        const std::list<SBMLError>& failures =
+          jobs[j].own ? validator.getFailures() : jobs[j].failures;
+        const std::list<unsigned int>& positions =
+          jobs[j].own ? validator.getFailurePositions() : jobs[j].positions;
+
+        std::list<SBMLError>::const_iterator it = failures.begin();
+        std::list<unsigned int>::const_iterator pos = positions.begin();
+        for (; it != failures.end(); ++it, ++pos)
         {
-          log->remove(DanglingUnitSIdRef);
-          nerrors--;
-        }
-        
-        total_errors += nerrors;
-        if (nerrors > 0)
-        {
-          if (writeDocument)
-            SBMLDocument_free(doc);
-          return total_errors;
+          merged.insert(std::make_pair(*pos, *it));
         }
       }
-      else if (log->contains(DanglingUnitSIdRef) == false)
+
+      validator.clearFailures();
+      std::multimap<unsigned int, SBMLError>::const_iterator it;
+      for (it = merged.begin(); it != merged.end(); ++it)
       {
-        total_errors += nerrors;
-        if (writeDocument)
-          SBMLDocument_free(doc);
-        return total_errors;
+        validator.logFailure(it->second);
       }
-      else
-      {
-        bool onlyDangRef = true;
-        for (unsigned int a = 0; a < log->getNumErrors(); a++)
-        {
-          if (log->getError(a)->getErrorId() != DanglingUnitSIdRef)
-          {
-            onlyDangRef = false;
-            break;
-          }
-        }
-        total_errors += nerrors;
+    }
+    done.insert(pass);
+  }
+#else
+  (void)validators;
+  (void)doc;
+  (void)numThreads;
+  (void)shareOut;
+  (void)profile;
+  (void)done;
+#endif
+}
 
-        if (onlyDangRef == false)
-        {
-          if (writeDocument)
-            SBMLDocument_free(doc);
-          return total_errors;
-        }
-      }
+
+/*
+ * Adds the validator to those to be run by runConcurrently().  When the
+ * document is checked incrementally the validator is first got ready for
+ * it, and left out if the failures kept for its category are up to date.
+ */
+static void
+addPass(std::vector<CachedValidator*>& passes, CachedValidator& validator,
+        const ValidatedState* state)
+{
+  if (state != NULL)
+  {
+    if (state->isUpToDate(validator.getCategory()))
+    {
+      return;
     }
+    state->prepare(validator.getCategory(), validator.get());
   }
 
-  if (sbml)
+  passes.push_back(&validator);
+}
+
+
+/*
+ * Returns the number of failures the validator finds in the document,
+ * running it first unless runConcurrently() already has.  When the
+ * document is checked incrementally (state is not NULL) the validator
+ * only checks what has changed, and the failures are kept for next time.
+ * Each failure is passed to the callback, if not NULL, as it is found;
+ * failures found by a validator that was stopped are not kept, and
+ * neither are any when the callback does not keep them.
+ */
+static unsigned int
+runValidator(CachedValidator& validator, const SBMLDocument& doc,
+             const std::set<const CachedValidator*>& done,
+             ValidatedState* state, ValidationCallback* callback)
+{
+  validator.get().setCallback(callback);
+  unsigned int reported = (callback != NULL) ? callback->getNumReported() : 0;
+
+  if (state == NULL)
   {
-    ConsistencyValidator validator;
-    validator.init();
-    nerrors = validator.validate(*doc);
-    total_errors += nerrors;
-    if (nerrors > 0) 
+    if (done.find(&validator) == done.end())
+    {
+      validator.get().validate(doc);
+    }
+  }
+  else
+  {
+    SBMLErrorCategory_t category = validator.getCategory();
+    if (done.find(&validator) == done.end())
     {
-      log->add( validator.getFailures() );
-      /* only want to bail if errors not warnings */
-      if (log->getNumFailsWithSeverity(LIBSBML_SEV_ERROR) > 0)
+      state->prepare(category, validator.get());
+      if (!state->isUpToDate(category))
       {
-        if (writeDocument)
-          SBMLDocument_free(doc);
-        return total_errors;
+        validator.get().validate(doc);
       }
     }
+
+    if (!validator.get().isStopped())
+    {
+      state->keep(category, validator.get());
+    }
+  }
+
+  if (callback != NULL && !callback->getKeepFailures())
+  {
+    return callback->getNumReported() - reported;
+  }
+  return (unsigned int)validator.get().getFailures().size();
+}
+
+
+/*
+ * Adds the failures to the log.  A pass whose failures are only final
+ * once they have all been found is run without the callback; its failures
+ * are passed to the callback here instead (except those with the given
+ * id, which are dropped from the log later) and the rest are left out
+ * once it stops the checks.  Unless keep is true, failures passed to the
+ * callback are not added to the log.
+ *
+ * @return the number of failures added to the log or passed on.
+ */
+static unsigned int
+addFailures(SBMLErrorLog& log, const std::list<SBMLError>& failures,
+            ValidationCallback* callback, bool keep, unsigned int skipId = 0)
+{
+  if (callback == NULL)
+  {
+    log.add(failures);
+    return (unsigned int)failures.size();
   }
 
-  if (sbo)
+  unsigned int added = 0;
+  std::list<SBMLError>::const_iterator it;
+  for (it = failures.begin(); it != failures.end(); ++it)
+  {
+    if (keep)
+    {
+      log.add(*it);
+    }
+    ++added;
+
+    if (it->getErrorId() != skipId && !callback->report(*it))
+    {
+      break;
+    }
+  }
+
+  return added;
+}
+
+
+static bool
+isStopped(const ValidationCallback* callback)
+{
+  return callback != NULL && callback->isStopped();
+}
+
+
+/*
+ * Returns true if an error (rather than a warning) is in the log, or has
+ * been passed to a callback that does not keep the failures.
+ */
+static bool
+hasErrors(const SBMLErrorLog& log, const ValidationCallback* callback)
+{
+  return log.getNumFailsWithSeverity(LIBSBML_SEV_ERROR) > 0
+    || (callback != NULL && !callback->getKeepFailures()
+        && callback->getNumReportedErrors() > 0);
+}
+
+
+static bool
+containsError(const std::list<SBMLError>& failures, unsigned int errorId)
+{
+  std::list<SBMLError>::const_iterator it;
+  for (it = failures.begin(); it != failures.end(); ++it)
+  {
+    if (it->getErrorId() == errorId) return true;
+  }
+
+  return false;
+}
+
+
+/*
+ * What the passes run by checkConsistency() share.
+ */
+struct PassRun
+{
+  SBMLDocument*       doc;
+  SBMLErrorLog*       log;
+  ValidatedState*     state;
+  ValidationCallback* callback;
+  bool                keepFailures;
+  unsigned int        numThreads;
+  ValidatorProfile*   profile;
+  std::set<const CachedValidator*> done;
+};
+
+
+/*
+ * Runs the identifier pass and adds its failures to the log, less those
+ * that are dropped.  Returns true if the other passes are to be run: the
+ * identifiers came back clean, or the only failures are dangling
+ * references to unit definitions.
+ */
+static bool
+checkIdentifiers(PassRun& run, CachedValidator& validator,
+                 unsigned int& total_errors)
+{
+  SBMLErrorLog* log = run.log;
+  ValidationCallback* callback = run.callback;
+
+  /* when the log already holds errors, some of the failures may be
+   * dropped below, so they are only passed to the callback afterwards;
+   * the same goes for failures that are not kept, as what is done next
+   * depends on them */
+  unsigned int origNum = log->getNumErrors();
+  bool streamed = origNum == 0 && run.keepFailures;
+  unsigned int nerrors = runValidator(validator, *run.doc, run.done,
+                                      run.state, streamed ? callback : NULL);
+  if (nerrors == 0)
+  {
+    return true;
+  }
+
+  /* failures that are not kept only go to a copy of the log */
+  SBMLErrorLog copy;
+  SBMLErrorLog* idLog = log;
+  if (!run.keepFailures)
+  {
+    copy = *log;
+    idLog = &copy;
+  }
+
+  const std::list<SBMLError>& failures = validator.get().getFailures();
+  if (streamed)
+  {
+    idLog->add(failures);
+  }
+  else
+  {
+    bool dropDangling = idLog->contains(InvalidUnitIdSyntax)
+                        || containsError(failures, InvalidUnitIdSyntax);
+    nerrors = addFailures(*idLog, failures, callback, true,
+                          dropDangling ? DanglingUnitSIdRef : 0);
+  }
+
+  if (isStopped(callback))
   {
-    SBOConsistencyValidator sbo_validator;
-    sbo_validator.init();
-    nerrors = sbo_validator.validate(*doc);
     total_errors += nerrors;
-    if (nerrors > 0) 
+    return false;
+  }
+  else if (origNum > 0 && idLog->contains(InvalidUnitIdSyntax) == true)
+  {
+    /* do not log dangling ref */
+    while (idLog->contains(DanglingUnitSIdRef) == true)
     {
-      log->add( sbo_validator.getFailures() );
-      /* only want to bail if errors not warnings */
-      if (log->getNumFailsWithSeverity(LIBSBML_SEV_ERROR) > 0)
-      {
-        if (writeDocument)
-          SBMLDocument_free(doc);
-        return total_errors;
-      }
+      idLog->remove(DanglingUnitSIdRef);
+      nerrors--;
+    }
+
+    total_errors += nerrors;
+    return nerrors == 0;
+  }
+  else if (idLog->contains(DanglingUnitSIdRef) == false)
+  {
+    total_errors += nerrors;
+    return false;
+  }
+
+  bool onlyDangRef = true;
+  for (unsigned int a = 0; a < idLog->getNumErrors(); a++)
+  {
+    if (idLog->getError(a)->getErrorId() != DanglingUnitSIdRef)
+    {
+      onlyDangRef = false;
+      break;
+    }
+  }
+  total_errors += nerrors;
+
+  return onlyDangRef;
+}
+
+
+/*
+ * Runs the pass and adds its failures to the log.  Returns false if the
+ * other passes are not to be run: the pass found errors (rather than
+ * warnings), or the callback has stopped the checks.
+ */
+static bool
+checkPass(PassRun& run, CachedValidator& validator,
+          unsigned int& total_errors)
+{
+  unsigned int nerrors = runValidator(validator, *run.doc, run.done,
+                                      run.state, run.callback);
+  total_errors += nerrors;
+  if (nerrors == 0)
+  {
+    return true;
+  }
+
+  run.log->add( validator.get().getFailures() );
+  /* only want to bail if errors not warnings */
+  return !hasErrors(*run.log, run.callback) && !isStopped(run.callback);
+}
+
+
+/*
+ * As checkPass(), for the SBO pass: an unrecognised term drops the other
+ * failures once all are found, so the callback is only given them then.
+ */
+static bool
+checkSBO(PassRun& run, CachedValidator& validator,
+         unsigned int& total_errors)
+{
+  unsigned int nerrors = runValidator(validator, *run.doc, run.done,
+                                      run.state, NULL);
+  if (nerrors > 0)
+  {
+    nerrors = addFailures(*run.log, validator.get().getFailures(),
+                          run.callback, run.keepFailures);
+  }
+  total_errors += nerrors;
+
+  /* only want to bail if errors not warnings */
+  return nerrors == 0
+    || (!hasErrors(*run.log, run.callback) && !isStopped(run.callback));
+}
+
+
+/*
+ * Runs the modeling practice pass and adds its failures to the log.
+ * Without the unit checks the failures about missing units are dropped,
+ * so the callback is only given the others once the pass is done.
+ *
+ * @return the number of failures added to the log or passed on.
+ */
+static unsigned int
+checkModelingPractice(PassRun& run, CachedValidator& validator, bool units)
+{
+  ValidationCallback* callback = run.callback;
+  unsigned int nerrors = runValidator(validator, *run.doc, run.done,
+                                      run.state, units ? callback : NULL);
+  if (nerrors == 0 || (units && !run.keepFailures))
+  {
+    /* any have only been passed to the callback */
+    return nerrors;
+  }
+
+  unsigned int errorsAdded = 0;
+  const std::list<SBMLError> practiceErrors = validator.get().getFailures();
+  list<SBMLError>::const_iterator end = practiceErrors.end();
+  list<SBMLError>::const_iterator iter;
+  for (iter = practiceErrors.begin(); iter != end; ++iter)
+  {
+    if (!units && iter->getErrorId() == 80701)
+    {
+      continue;
+    }
+
+    if (run.keepFailures) run.log->add( SBMLError(*iter) );
+    errorsAdded++;
+
+    if (!units && callback != NULL && !callback->report(*iter))
+    {
+      break;
     }
   }
 
+  return errorsAdded;
+}
+
+
+/*
+ * Runs the passes selected in the mask of applicable validators on the
+ * document, in turn, stopping after a pass that finds errors.
+ *
+ * With several threads the identifier checks still run on their own, as
+ * the other passes are not run on a document with bad identifiers.  Once
+ * they came back clean the general, SBO and MathML passes run together,
+ * and the remaining passes together once those came back clean (the unit
+ * checks may crash on bad math); the checks of single objects made by
+ * each pass are shared out between the threads as well.  The failures
+ * are still merged one pass at a time, in the usual order and under the
+ * usual rules for stopping, so the log does not depend on the threads.
+ * With a callback the passes run one after another, so that it is given
+ * the failures in that order as they are found.
+ *
+ * @return the number of failures found.
+ */
+static unsigned int
+runPasses(PassRun& run, unsigned char applicable)
+{
+  bool id    = ((applicable & 0x01) == 0x01);
+  bool sbml  = ((applicable & 0x02) == 0x02);
+  bool sbo   = ((applicable & 0x04) == 0x04);
+  bool math  = ((applicable & 0x08) == 0x08);
+  bool units = ((applicable & 0x10) == 0x10);
+  bool over  = ((applicable & 0x20) == 0x20);
+  bool practice = ((applicable & 0x40) == 0x40);
+
+  /* the validators come initialized from the cache and go back to it */
+  CachedValidator id_validator      (LIBSBML_CAT_IDENTIFIER_CONSISTENCY, run.profile);
+  CachedValidator validator         (LIBSBML_CAT_GENERAL_CONSISTENCY, run.profile);
+  CachedValidator sbo_validator     (LIBSBML_CAT_SBO_CONSISTENCY, run.profile);
+  CachedValidator math_validator    (LIBSBML_CAT_MATHML_CONSISTENCY, run.profile);
+  CachedValidator unit_validator    (LIBSBML_CAT_UNITS_CONSISTENCY, run.profile);
+  CachedValidator over_validator    (LIBSBML_CAT_OVERDETERMINED_MODEL, run.profile);
+  CachedValidator practice_validator(LIBSBML_CAT_MODELING_PRACTICE, run.profile);
+
+  bool together = run.numThreads > 1 && run.callback == NULL;
+  /* the components checked incrementally are already picked out */
+  bool shareOut = run.state == NULL;
+  unsigned int total_errors = 0;
+
+  if (id && !checkIdentifiers(run, id_validator, total_errors))
+  {
+    return total_errors;
+  }
+
+  if (together)
+  {
+    std::vector<CachedValidator*> passes;
+    if (sbml) addPass(passes, validator, run.state);
+    if (sbo)  addPass(passes, sbo_validator, run.state);
+    if (math) addPass(passes, math_validator, run.state);
+    runConcurrently(passes, *run.doc, run.numThreads, shareOut, run.profile,
+                    run.done);
+  }
+
+  if (sbml && !checkPass(run, validator, total_errors))
+  {
+    return total_errors;
+  }
+
+  if (sbo && !checkSBO(run, sbo_validator, total_errors))
+  {
+    return total_errors;
+  }
+
   if (math)
   {
-    MathMLConsistencyValidator math_validator;
-    math_validator.init();
-    nerrors = math_validator.validate(*doc);
+    unsigned int nerrors = runValidator(math_validator, *run.doc, run.done,
+                                        run.state, run.callback);
     total_errors += nerrors;
-    if (nerrors > 0) 
+    if (nerrors > 0)
     {
-      log->add( math_validator.getFailures() );
+      run.log->add( math_validator.get().getFailures() );
       /* at this point bail if any problems
        * unit checks may crash if there have been math errors/warnings
        */
-      if (writeDocument)
-        SBMLDocument_free(doc);
       return total_errors;
     }
   }
 
+  /* bring the unit data up to date with any edits made to the model since
+   * it was last worked out, before the passes that read it are run
+   */
+  Model* m = run.doc->getModel();
+  if (units && m != NULL)
+  {
+    m->updateListFormulaUnitsData();
+  }
 
-  if (units)
+  if (together)
   {
-    UnitConsistencyValidator unit_validator;
-    unit_validator.init();
-    nerrors = unit_validator.validate(*doc);
-    total_errors += nerrors;
-    if (nerrors > 0) 
-    {
-      log->add( unit_validator.getFailures() );
-      /* only want to bail if errors not warnings */
-      if (log->getNumFailsWithSeverity(LIBSBML_SEV_ERROR) > 0)
-      {
-        if (writeDocument)
-          SBMLDocument_free(doc);
-        return total_errors;
-      }
-    }
+    std::vector<CachedValidator*> passes;
+    if (units)    addPass(passes, unit_validator, run.state);
+    if (over)     addPass(passes, over_validator, run.state);
+    if (practice) addPass(passes, practice_validator, run.state);
+    runConcurrently(passes, *run.doc, run.numThreads, shareOut, run.profile,
+                    run.done);
+  }
+
+  if (units && !checkPass(run, unit_validator, total_errors))
+  {
+    return total_errors;
   }
 
   /* do not even try if there have been unit warnings 
    * changed this as would have bailed */
-  if (over)
+  if (over && !checkPass(run, over_validator, total_errors))
   {
-    OverdeterminedValidator over_validator;
-    over_validator.init();
-    nerrors = over_validator.validate(*doc);
-    total_errors += nerrors;
-    if (nerrors > 0) 
-    {
-      log->add( over_validator.getFailures() );
-      /* only want to bail if errors not warnings */
-      if (log->getNumFailsWithSeverity(LIBSBML_SEV_ERROR) > 0)
-      {
-        if (writeDocument)
-          SBMLDocument_free(doc);
-        return total_errors;
-      }
-    }
+    return total_errors;
   }
 
   if (practice)
   {
-    ModelingPracticeValidator practice_validator;
-    practice_validator.init();
-    nerrors = practice_validator.validate(*doc);
-    if (nerrors > 0) 
+    total_errors += checkModelingPractice(run, practice_validator, units);
+  }
+
+  return total_errors;
+}
+
+
+/*
+ * Returns the document the passes are to check.  When writeDocument is
+ * true this is the document as read back from the SBML written for it,
+ * which the caller frees, unless it would read back without errors, in
+ * which case writeDocument is set to false and the document itself is
+ * checked.  NULL is returned for a document that would read back with
+ * serious errors, which is not checked at all.  (Warnings from the reader
+ * may change what is read back, so the round trip is still made for
+ * those.)  With roundTrip, the round trip is always made.
+ */
+static SBMLDocument*
+getDocumentToCheck(SBMLDocument* document, bool& writeDocument,
+                   bool roundTrip, SBMLErrorLog* log)
+{
+  if (writeDocument && !roundTrip)
+  {
+    SBMLErrorLog readErrors;
+    if (ReadTimeChecks::logReadErrors(*document, readErrors))
     {
-      unsigned int errorsAdded = 0;
-      const std::list<SBMLError> practiceErrors = practice_validator.getFailures();
-      list<SBMLError>::const_iterator end = practiceErrors.end();
-      list<SBMLError>::const_iterator iter;
-      for (iter = practiceErrors.begin(); iter != end; ++iter)
+      if (readErrors.getNumFailsWithSeverity(LIBSBML_SEV_ERROR) > 0
+        || readErrors.getNumFailsWithSeverity(LIBSBML_SEV_FATAL) > 0)
       {
-        if (SBMLError(*iter).getErrorId() != 80701)
-        {
-          log->add( SBMLError(*iter) );
-          errorsAdded++;
-        }
-        else
-        {
-          if (units) 
-          {
-            log->add( SBMLError(*iter) );
-            errorsAdded++;
-          }
-        }
+        log->clearLog();
+        return NULL;
       }
-      total_errors += errorsAdded;
 
+      if (readErrors.getNumErrors() == 0)
+      {
+        log->clearLog();
+        writeDocument = false;
+      }
     }
   }
 
+  if (!writeDocument)
+  {
+    return document;
+  }
+
+  char* sbmlString = writeSBMLToString(document);
+  log->clearLog();
+  SBMLDocument* doc = readSBMLFromString(sbmlString);
+  free (sbmlString);
+
+  return doc;
+}
+/** @endcond */
+
+
+/*
+ * Performs a set of semantic consistency checks on the document.  Query
+ * the results by calling getNumErrors() and getError().
+ *
+ * @return the number of failed checks (errors) encountered.
+ */
+unsigned int
+SBMLInternalValidator::checkConsistency (bool writeDocument)
+{
+  PassRun run;
+  run.log = getErrorLog();
+  run.callback = mCallback;
+  run.keepFailures = mCallback == NULL || mCallback->getKeepFailures();
+  /* failures that are not kept cannot be reused by the next check */
+  run.state = (mCheckIncrementally && run.keepFailures)
+              ? mValidatedState : NULL;
+  run.numThreads = mNumThreads;
+  run.profile = mProfile;
+
+  if (mCallback != NULL)
+  {
+    mCallback->start();
+  }
+
+  run.doc = getDocumentToCheck(getDocument(), writeDocument,
+                               mRoundTripReadChecks, run.log);
+  if (run.doc == NULL)
+  {
+    return 0;
+  }
+
+  /* look to see if we have serious errors from the read
+   * these may cause other validators to crash
+   * although hopefully not it is probably best to guard
+   * against trying;
+   * do not try and go further but do not report the errors as these
+   * will have been recorded elsewhere and do not come from the validators
+   */
+  unsigned int total_errors = 0;
+  if (run.doc->getNumErrors(LIBSBML_SEV_FATAL) == 0
+    && run.doc->getNumErrors(LIBSBML_SEV_ERROR) == 0)
+  {
+    total_errors = runPasses(run, mApplicableValidators);
+  }
+
   if (writeDocument)
-    SBMLDocument_free(doc);
+    SBMLDocument_free(run.doc);
+  return total_errors;
+}
+
+
+/*
+ * Performs the same checks as checkConsistency(), but only checks again
+ * what has changed since the last time this was called.
+ *
+ * @return the number of failed checks (errors) encountered.
+ */
+unsigned int
+SBMLInternalValidator::checkConsistencyIncremental ()
+{
+  if (mValidatedState == NULL)
+  {
+    mValidatedState = new ValidatedState();
+  }
+
+  mValidatedState->resetLog(*getErrorLog());
+  mValidatedState->compare(*getDocument());
+
+  mCheckIncrementally = true;
+  unsigned int total_errors = checkConsistency(false);
+  mCheckIncrementally = false;
+
+  mValidatedState->dropUnchecked();
+
   return total_errors;
 }
 
@@ -578,17 +1198,33 @@ SBMLInternalValidator::checkInternalConsistency()
   unsigned int nerrors = 0;
   unsigned int totalerrors = 0;
 
-  InternalConsistencyValidator validator;
+  CachedValidator validator(LIBSBML_CAT_INTERNAL_CONSISTENCY, mProfile);
 
-  validator.init();
-  nerrors = validator.validate(*getDocument());
+  nerrors = validator.get().validate(*getDocument());
   if (nerrors > 0) 
   {
-    getErrorLog()->add( validator.getFailures() );
+    getErrorLog()->add( validator.get().getFailures() );
   }
   totalerrors += nerrors;
   
-  /* hack to catch errors normally caught at read time */
+  /* errors normally caught at read time are found on the object tree;
+   * the round trip is only made for what is not covered there, or when
+   * the reader's own messages are wanted
+   */
+  if (!mRoundTripReadChecks)
+  {
+    SBMLErrorLog readErrors;
+    if (ReadTimeChecks::logReadErrors(*getDocument(), readErrors))
+    {
+      nerrors = readErrors.getNumErrors();
+      for (unsigned int i = 0; i < nerrors; i++)
+      {
+        getErrorLog()->add(*(readErrors.getError(i)));
+      }
+      return totalerrors + nerrors;
+    }
+  }
+
   char* doc = writeSBMLToString(getDocument());
   SBMLDocument *d = readSBMLFromString(doc);
   util_free(doc);
@@ -618,11 +1254,10 @@ SBMLInternalValidator::checkL1Compatibility ()
 {
   if (getModel() == NULL) return 0;
 
-  L1CompatibilityValidator validator;
-  validator.init();
+  CachedValidator validator(LIBSBML_CAT_SBML_L1_COMPAT, mProfile);
 
-  unsigned int nerrors = validator.validate(*getDocument());
-  if (nerrors > 0) getErrorLog()->add( validator.getFailures() );
+  unsigned int nerrors = validator.get().validate(*getDocument());
+  if (nerrors > 0) getErrorLog()->add( validator.get().getFailures() );
 
   return nerrors;
 }
@@ -640,11 +1275,10 @@ SBMLInternalValidator::checkL2v1Compatibility ()
 {
   if (getModel() == NULL) return 0;
 
-  L2v1CompatibilityValidator validator;
-  validator.init();
+  CachedValidator validator(LIBSBML_CAT_SBML_L2V1_COMPAT, mProfile);
 
-  unsigned int nerrors = validator.validate(*getDocument());
-  if (nerrors > 0) getErrorLog()->add( validator.getFailures() );
+  unsigned int nerrors = validator.get().validate(*getDocument());
+  if (nerrors > 0) getErrorLog()->add( validator.get().getFailures() );
 
   return nerrors;
 }
@@ -662,11 +1296,10 @@ SBMLInternalValidator::checkL2v2Compatibility ()
 {
   if (getModel() == NULL) return 0;
 
-  L2v2CompatibilityValidator validator;
-  validator.init();
+  CachedValidator validator(LIBSBML_CAT_SBML_L2V2_COMPAT, mProfile);
 
-  unsigned int nerrors = validator.validate(*getDocument());
-  if (nerrors > 0) getErrorLog()->add( validator.getFailures() );
+  unsigned int nerrors = validator.get().validate(*getDocument());
+  if (nerrors > 0) getErrorLog()->add( validator.get().getFailures() );
 
   return nerrors;
 }
@@ -683,11 +1316,10 @@ SBMLInternalValidator::checkL2v3Compatibility ()
 {
   if (getModel() == NULL) return 0;
 
-  L2v3CompatibilityValidator validator;
-  validator.init();
+  CachedValidator validator(LIBSBML_CAT_SBML_L2V3_COMPAT, mProfile);
 
-  unsigned int nerrors = validator.validate(*getDocument());
-  if (nerrors > 0) getErrorLog()->add( validator.getFailures() );
+  unsigned int nerrors = validator.get().validate(*getDocument());
+  if (nerrors > 0) getErrorLog()->add( validator.get().getFailures() );
 
   return nerrors;
 }
@@ -704,11 +1336,10 @@ SBMLInternalValidator::checkL2v4Compatibility ()
 {
   if (getModel() == NULL) return 0;
 
-  L2v4CompatibilityValidator validator;
-  validator.init();
+  CachedValidator validator(LIBSBML_CAT_SBML_L2V4_COMPAT, mProfile);
 
-  unsigned int nerrors = validator.validate(*getDocument());
-  if (nerrors > 0) getErrorLog()->add( validator.getFailures() );
+  unsigned int nerrors = validator.get().validate(*getDocument());
+  if (nerrors > 0) getErrorLog()->add( validator.get().getFailures() );
 
   return nerrors;
 }
@@ -728,11 +1359,10 @@ SBMLInternalValidator::checkL2v5Compatibility ()
   if (getModel() == NULL) return 0;
 
   // use the L2V4 validator as it is identical
-  L2v4CompatibilityValidator validator;
-  validator.init();
+  CachedValidator validator(LIBSBML_CAT_SBML_L2V4_COMPAT, mProfile);
 
-  unsigned int nerrors = validator.validate(*getDocument());
-  if (nerrors > 0) getErrorLog()->add( validator.getFailures() );
+  unsigned int nerrors = validator.get().validate(*getDocument());
+  if (nerrors > 0) getErrorLog()->add( validator.get().getFailures() );
 
   return nerrors;
 }
@@ -751,11 +1381,10 @@ SBMLInternalValidator::checkL3v1Compatibility ()
 {
   if (getModel() == NULL) return 0;
 
-  L3v1CompatibilityValidator validator;
-  validator.init();
+  CachedValidator validator(LIBSBML_CAT_SBML_L3V1_COMPAT, mProfile);
 
-  unsigned int nerrors = validator.validate(*getDocument());
-  if (nerrors > 0) getErrorLog()->add( validator.getFailures() );
+  unsigned int nerrors = validator.get().validate(*getDocument());
+  if (nerrors > 0) getErrorLog()->add( validator.get().getFailures() );
 
   return nerrors;
 }
@@ -773,11 +1402,10 @@ SBMLInternalValidator::checkL3v2Compatibility()
 {
   if (getModel() == NULL) return 0;
 
-  L3v2CompatibilityValidator validator;
-  validator.init();
+  CachedValidator validator(LIBSBML_CAT_SBML_L3V2_COMPAT, mProfile);
 
-  unsigned int nerrors = validator.validate(*getDocument());
-  if (nerrors > 0) getErrorLog()->add(validator.getFailures());
+  unsigned int nerrors = validator.get().validate(*getDocument());
+  if (nerrors > 0) getErrorLog()->add( validator.get().getFailures() );
 
   return nerrors;
 }
@@ -810,6 +1438,62 @@ SBMLInternalValidator::setConversionValidators(unsigned char appl)
   mApplicableValidatorsForConversion = appl;
 }
 
+
+void
+SBMLInternalValidator::setNumThreads(unsigned int numThreads)
+{
+  mNumThreads = numThreads;
+}
+
+
+unsigned int
+SBMLInternalValidator::getNumThreads() const
+{
+  return mNumThreads;
+}
+
+
+void
+SBMLInternalValidator::setRoundTripReadChecks(bool roundTrip)
+{
+  mRoundTripReadChecks = roundTrip;
+}
+
+
+bool
+SBMLInternalValidator::getRoundTripReadChecks() const
+{
+  return mRoundTripReadChecks;
+}
+
+
+void
+SBMLInternalValidator::setProfile(ValidatorProfile* profile)
+{
+  mProfile = profile;
+}
+
+
+ValidatorProfile*
+SBMLInternalValidator::getProfile() const
+{
+  return mProfile;
+}
+
+
+void
+SBMLInternalValidator::setCallback(ValidationCallback* callback)
+{
+  mCallback = callback;
+}
+
+
+ValidationCallback*
+SBMLInternalValidator::getCallback() const
+{
+  return mCallback;
+}
+
 unsigned int 
   SBMLInternalValidator::validate()
 {
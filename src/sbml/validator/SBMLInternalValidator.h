@@ -78,6 +78,10 @@
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
+class ValidatorProfile;
+class ValidatedState;
+class ValidationCallback;
+
 
 class LIBSBML_EXTERN SBMLInternalValidator : public SBMLValidator
 {
@@ -310,6 +314,28 @@ public:
    */
   unsigned int checkConsistency (bool writeDocument=false);
 
+
+  /**
+   * Performs the same checks as checkConsistency(), but only checks again
+   * what has changed since it was last called.
+   *
+   * The first call checks the whole document, and remembers it together
+   * with the failures found.  Each later call compares the document with
+   * the one remembered, and checks the components of the model (the
+   * children of its ListOf objects) that have been changed, added or
+   * removed, those that refer to them and those they refer to.  The
+   * checks of the model as a whole are made again too.  The failures
+   * found last time for the other components are kept.
+   *
+   * The error log is left holding what it held before the first call,
+   * followed by the failures now found.
+   *
+   * @return the number of failed checks (errors) encountered.
+   *
+   * @see checkConsistency()
+   */
+  unsigned int checkConsistencyIncremental ();
+
   
   /**
    * Performs consistency checking on libSBML's internal representation of 
@@ -465,6 +491,82 @@ public:
   void setConversionValidators(unsigned char appl);
 
 
+  /**
+   * Sets the number of threads checkConsistency() may use.
+   *
+   * @param numThreads the largest number of threads to use; @c 0 and
+   * @c 1 mean that the validators run one after another.
+   *
+   * @see SBMLDocument::setNumValidationThreads(unsigned int numThreads)
+   */
+  void setNumThreads(unsigned int numThreads);
+
+
+  /**
+   * @return the number of threads checkConsistency() may use.
+   */
+  unsigned int getNumThreads() const;
+
+
+  /**
+   * Sets whether checkInternalConsistency() and checkConsistency() always
+   * write the document out and read it back to find the errors that are
+   * only checked on reading.
+   *
+   * @param roundTrip @c true to always make the round trip; @c false (the
+   * default) to make the checks of the reader on the document itself, and
+   * the round trip only for what they do not cover.
+   *
+   * @see SBMLDocument::enableRoundTripReadChecks(bool flag)
+   */
+  void setRoundTripReadChecks(bool roundTrip);
+
+
+  /**
+   * @return @c true if checkInternalConsistency() and checkConsistency()
+   * always write the document out and read it back.
+   */
+  bool getRoundTripReadChecks() const;
+
+
+  /**
+   * Sets the ValidatorProfile in which the validators run by this
+   * SBMLInternalValidator record the time taken by their constraints.
+   *
+   * @param profile the ValidatorProfile to add to, or @c NULL (the
+   * default) not to profile the validators.  It is not owned by this
+   * SBMLInternalValidator.
+   *
+   * @see SBMLDocument::setValidationProfile(ValidatorProfile* profile)
+   */
+  void setProfile(ValidatorProfile* profile);
+
+
+  /**
+   * @return the ValidatorProfile set with setProfile(), or @c NULL.
+   */
+  ValidatorProfile* getProfile() const;
+
+
+  /**
+   * Sets the ValidationCallback that checkConsistency() passes each
+   * failure to as it is found, and that may stop the checks early.
+   *
+   * @param callback the ValidationCallback to use, or @c NULL (the
+   * default) to only log the failures.  It is not owned by this
+   * SBMLInternalValidator.
+   *
+   * @see SBMLDocument::setValidationCallback(ValidationCallback* callback)
+   */
+  void setCallback(ValidationCallback* callback);
+
+
+  /**
+   * @return the ValidationCallback set with setCallback(), or @c NULL.
+   */
+  ValidationCallback* getCallback() const;
+
+
   /**
    * Constructor.
    */
@@ -509,6 +611,12 @@ protected:
   /** @cond doxygenLibsbmlInternal */
   unsigned char mApplicableValidators;
   unsigned char mApplicableValidatorsForConversion;
+  unsigned int mNumThreads;
+  bool mRoundTripReadChecks;
+  ValidatorProfile* mProfile;
+  ValidationCallback* mCallback;
+  ValidatedState* mValidatedState;
+  bool mCheckIncrementally;
 
   /** @endcond */
 
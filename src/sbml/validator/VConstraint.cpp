@@ -83,6 +83,31 @@ VConstraint::getSeverity () const
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Clears whatever this constraint remembers from the objects it has
+ * checked so far.
+ */
+void
+VConstraint::reset ()
+{
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * @return false: a constraint checks the object it is applied to as a
+ * whole, unless it says otherwise.
+ */
+bool
+VConstraint::checksSingleObjects () const
+{
+  return false;
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 /*
  * Logs a constraint failure to the validator for the given SBML object.
@@ -104,25 +129,26 @@ VConstraint::logFailure (const SBase& object)
 void
 VConstraint::logFailure (const SBase& object, const std::string& message)
 {
+  unsigned int id = mId;
   std::string pkg = object.getPackageName();
   unsigned int pkgVersion = object.getPackageVersion();
-  if (mId > 99999 && pkg == "core")
+  if (id > 99999 && pkg == "core")
   {
     // we are dealing with a core object that is logging errors 
     // relating to a package
     // need to work out which pkg
 
-    unsigned int offset = (unsigned int)(floor((double)mId/100000.0)) * 100000;
+    unsigned int offset = (unsigned int)(floor((double)id/100000.0)) * 100000;
 
     if (offset == 9900000)
     {
       // we are dealing with the strict units validator
-      mId = mId - offset;
+      id = id - offset;
     }
     else if (offset == 1400000 && object.getLevel() == 3 && object.getVersion() == 2)
     {
       // we are using the l3v2extended math package but in l3v2 which means we want to report core
-      mId = mId - offset;
+      id = id - offset;
     }
     else
     {
@@ -152,7 +178,7 @@ VConstraint::logFailure (const SBase& object, const std::string& message)
   // but for now only with 98000 numbers
   unsigned int level = object.getLevel();
   unsigned int version = object.getVersion();
-  if ((98000 < mId) && (mId < 98999))
+  if ((98000 < id) && (id < 98999))
   {
     if (mValidator.getConsistencyLevel() != 0)
     {
@@ -161,7 +187,7 @@ VConstraint::logFailure (const SBase& object, const std::string& message)
     }
   }
 
-  SBMLError error = SBMLError( mId, level, version,
+  SBMLError error = SBMLError( id, level, version,
 			       message, object.getLine(), object.getColumn(),
              LIBSBML_SEV_UNKNOWN, LIBSBML_CAT_SBML, pkg, pkgVersion);
 
@@ -57,6 +57,7 @@
 
 #include <sbml/SBase.h>
 #include <sbml/validator/Validator.h>
+#include <sbml/validator/ValidatorProfile.h>
 #include <sbml/units/UnitFormulaFormatter.h>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
@@ -114,6 +115,26 @@ public:
   unsigned int getSeverity () const;
 
 
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Clears whatever this constraint remembers from the objects it has
+   * checked so far, so that it can check another document as though it
+   * had just been created.  The default does nothing; constraints that
+   * collect identifiers or other state across calls override it.
+   */
+  virtual void reset ();
+
+
+  /**
+   * Returns @c true if this constraint, although it is applied to the
+   * model as a whole, checks the objects within the model one at a time
+   * and leaves out those that Validator::isToBeChecked() says not to
+   * check.  The default returns @c false.
+   */
+  virtual bool checksSingleObjects () const;
+  /** @endcond */
+
+
 protected:
   /** @cond doxygenLibsbmlInternal */
   /**
@@ -157,6 +178,15 @@ public:
    */
   void check (const Model& m, const T& object)
   {
+    if (mValidator.isStopped()) return;
+
+    ValidatorProfile* profile = mValidator.getProfile();
+    if (profile != NULL)
+    {
+      checkProfiled(*profile, m, object);
+      return;
+    }
+
     mLogMsg = false;
 
     check_(m, object);
@@ -172,6 +202,30 @@ protected:
    */
   virtual void check_ (const Model&, const T&) { };
 
+
+  /**
+   * Does what check() does, recording the time taken and the failures
+   * logged in the given profile.
+   */
+  void checkProfiled (ValidatorProfile& profile, const Model& m,
+                      const T& object)
+  {
+    size_t before = mValidator.getFailures().size();
+    double start  = ValidatorProfile::now();
+
+    mLogMsg = false;
+
+    check_(m, object);
+
+    if (mLogMsg) logFailure(object);
+
+    double elapsed = ValidatorProfile::now() - start;
+    size_t logged  = mValidator.getFailures().size() - before;
+
+    profile.record(mValidator.getProfileName(), mId, elapsed,
+                   (unsigned int)logged);
+  }
+
   /** @endcond */
 };
 /** @endcond */
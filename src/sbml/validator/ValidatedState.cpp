@@ -0,0 +1,719 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ValidatedState.cpp
+ * @brief   Remembers a checked document for checking it again incrementally
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/validator/ValidatedState.h>
+
+#include <cctype>
+#include <cstdio>
+#include <sstream>
+
+#include <sbml/validator/Validator.h>
+#include <sbml/SBMLDocument.h>
+#include <sbml/SBMLErrorLog.h>
+#include <sbml/Model.h>
+#include <sbml/Rule.h>
+#include <sbml/InitialAssignment.h>
+#include <sbml/Reaction.h>
+#include <sbml/Event.h>
+#include <sbml/FunctionDefinition.h>
+#include <sbml/Constraint.h>
+#include <sbml/KineticLaw.h>
+#include <sbml/StoichiometryMath.h>
+#include <sbml/Trigger.h>
+#include <sbml/Delay.h>
+#include <sbml/Priority.h>
+#include <sbml/EventAssignment.h>
+#include <sbml/math/ASTNode.h>
+#include <sbml/xml/XMLNode.h>
+#include <sbml/xml/XMLOutputStream.h>
+#include <sbml/util/List.h>
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+typedef map< string, vector<const SBase*> > IdMap;
+
+
+/*
+ * Adds each identifier in the given text to the set.
+ */
+static void
+addNames (const string& text, set<string>& names)
+{
+  size_t n = 0;
+
+  while (n < text.size())
+  {
+    char c = text[n];
+    if (!(isalpha((unsigned char)c) || c == '_'))
+    {
+      ++n;
+      continue;
+    }
+
+    size_t start = n;
+    while (n < text.size() &&
+           (isalnum((unsigned char)text[n]) || text[n] == '_'))
+    {
+      ++n;
+    }
+
+    names.insert(text.substr(start, n - start));
+  }
+}
+
+
+/*
+ * Appends to 'tokens' each of the given names that is one of the given
+ * ids.
+ */
+static void
+findIds (const vector<string>& names, const IdMap& ids, vector<string>& tokens)
+{
+  for (size_t n = 0; n < names.size(); ++n)
+  {
+    if (ids.find(names[n]) != ids.end())
+    {
+      tokens.push_back(names[n]);
+    }
+  }
+}
+
+
+/*
+ * Appends a description of the given math to the signature, adding the
+ * names it uses to the set.  Math that could not be written out, such
+ * as a lambda with no body, is described all the same.
+ */
+static void
+addMath (const ASTNode* node, string& signature, set<string>& names)
+{
+  if (node == NULL)
+  {
+    signature += "~";
+    return;
+  }
+
+  char buffer[64];
+  sprintf(buffer, "(%d", (int)node->getType());
+  signature += buffer;
+
+  if (node->isInteger())
+  {
+    sprintf(buffer, " %ld", node->getInteger());
+    signature += buffer;
+  }
+  else if (node->isRational())
+  {
+    sprintf(buffer, " %ld/%ld", node->getNumerator(), node->getDenominator());
+    signature += buffer;
+  }
+  else if (node->getType() == AST_REAL_E)
+  {
+    sprintf(buffer, " %.17ge%ld", node->getMantissa(), node->getExponent());
+    signature += buffer;
+  }
+  else if (node->isReal())
+  {
+    sprintf(buffer, " %.17g", node->getReal());
+    signature += buffer;
+  }
+
+  if ((node->isName() || node->getType() == AST_FUNCTION)
+      && node->getName() != NULL)
+  {
+    signature += " ";
+    signature += node->getName();
+    names.insert(node->getName());
+  }
+
+  if (node->isSetUnits())
+  {
+    signature += " " + node->getUnits();
+    names.insert(node->getUnits());
+  }
+
+  sprintf(buffer, " %u", node->getNumSemanticsAnnotations());
+  signature += buffer;
+
+  for (unsigned int n = 0; n < node->getNumChildren(); ++n)
+  {
+    addMath(node->getChild(n), signature, names);
+  }
+  signature += ")";
+}
+
+
+/*
+ * Appends a description of the given notes or annotation to the
+ * signature.
+ */
+static void
+addXML (const XMLNode* node, string& signature)
+{
+  if (node == NULL)
+  {
+    return;
+  }
+
+  if (node->isText())
+  {
+    signature += node->getCharacters();
+    return;
+  }
+
+  signature += "<" + node->getURI() + " " + node->getName();
+
+  const XMLNamespaces& xmlns = node->getNamespaces();
+  for (int n = 0; n < xmlns.getNumNamespaces(); ++n)
+  {
+    signature += " " + xmlns.getPrefix(n) + "=" + xmlns.getURI(n);
+  }
+
+  const XMLAttributes& attributes = node->getAttributes();
+  for (int n = 0; n < attributes.getLength(); ++n)
+  {
+    signature += " " + attributes.getURI(n) + " " + attributes.getName(n)
+               + "=" + attributes.getValue(n);
+  }
+  signature += ">";
+
+  for (unsigned int n = 0; n < node->getNumChildren(); ++n)
+  {
+    addXML(&node->getChild(n), signature);
+  }
+  signature += "</>";
+}
+
+
+/*
+ * Returns the math of the given object of SBML Level 3 Core, or NULL.
+ */
+static const ASTNode*
+getMath (const SBase& object)
+{
+  if (object.getPackageName() != "core")
+  {
+    return NULL;
+  }
+
+  switch (object.getTypeCode())
+  {
+  case SBML_FUNCTION_DEFINITION:
+    return static_cast<const FunctionDefinition&>(object).getMath();
+  case SBML_INITIAL_ASSIGNMENT:
+    return static_cast<const InitialAssignment&>(object).getMath();
+  case SBML_ALGEBRAIC_RULE:
+  case SBML_ASSIGNMENT_RULE:
+  case SBML_RATE_RULE:
+    return static_cast<const Rule&>(object).getMath();
+  case SBML_CONSTRAINT:
+    return static_cast<const Constraint&>(object).getMath();
+  case SBML_KINETIC_LAW:
+    return static_cast<const KineticLaw&>(object).getMath();
+  case SBML_EVENT_ASSIGNMENT:
+    return static_cast<const EventAssignment&>(object).getMath();
+  case SBML_TRIGGER:
+    return static_cast<const Trigger&>(object).getMath();
+  case SBML_DELAY:
+    return static_cast<const Delay&>(object).getMath();
+  case SBML_PRIORITY:
+    return static_cast<const Priority&>(object).getMath();
+  case SBML_STOICHIOMETRY_MATH:
+    return static_cast<const StoichiometryMath&>(object).getMath();
+  default:
+    return NULL;
+  }
+}
+
+
+/*
+ * Returns true if the given id is that of a unit that an SBML Level 1 or
+ * 2 model can redefine, and which is used where no units are given.
+ */
+static bool
+isBuiltInUnit (const string& id)
+{
+  return id == "substance" || id == "volume" || id == "area"
+    || id == "length" || id == "time";
+}
+
+
+/*
+ * Returns the attributes of the model that the checks of its components
+ * look at, adding the ids they refer to to the given set.
+ */
+static string
+getModelSignature (const SBMLDocument& doc, const Model& m,
+                   set<string>& ids)
+{
+  const string* refs[] =
+  {
+    &m.getSubstanceUnits(),
+    &m.getTimeUnits(),
+    &m.getVolumeUnits(),
+    &m.getAreaUnits(),
+    &m.getLengthUnits(),
+    &m.getExtentUnits(),
+    &m.getConversionFactor()
+  };
+
+  char buffer[32];
+  sprintf(buffer, "%u.%u", doc.getLevel(), doc.getVersion());
+
+  string signature = buffer;
+  for (size_t n = 0; n < sizeof(refs) / sizeof(refs[0]); ++n)
+  {
+    signature += ";" + *refs[n];
+    if (!refs[n]->empty()) ids.insert(*refs[n]);
+  }
+  return signature;
+}
+
+
+ValidatedState::ValidatedState () :
+    mCompared  ( false )
+  , mUnchanged ( false )
+  , mAllChanged( true  )
+  , mLogKept   ( false )
+{
+}
+
+
+/*
+ * Describes the given component and adds it, with the ids other
+ * components may refer to it by, to the map.
+ */
+void
+ValidatedState::addComponent (ComponentMap& components,
+                              const SBase* component) const
+{
+  Component& entry = components[component];
+
+  char buffer[32];
+  sprintf(buffer, "%u:%u;", component->getLine(), component->getColumn());
+  entry.signature = buffer;
+
+  /* the component and everything below it: the attributes, which give
+   * the ids each object refers to, the math and the notes and annotation
+   */
+  List* elements = const_cast<SBase*>(component)->getAllElements();
+  set<string> names;
+
+  for (unsigned int n = 0; n <= elements->getSize(); ++n)
+  {
+    const SBase* object = (n == 0) ? component
+                        : static_cast<const SBase*>(elements->get(n - 1));
+
+    ostringstream attributes;
+    XMLOutputStream stream(attributes, "UTF-8", false);
+    object->writeAttributes(stream);
+    object->writeExtensionAttributes(stream);
+
+    sprintf(buffer, "<%d ", object->getTypeCode());
+    entry.signature += buffer + object->getElementName()
+                     + attributes.str() + ">";
+    addNames(attributes.str(), names);
+
+    addMath(getMath(*object), entry.signature, names);
+    addXML(object->getNotes(), entry.signature);
+    addXML(object->getAnnotation(), entry.signature);
+  }
+  delete elements;
+
+  entry.names.assign(names.begin(), names.end());
+
+  entry.typecode = component->getTypeCode();
+  if (component->isSetId())
+  {
+    entry.ids.push_back(component->getId());
+  }
+
+  const Rule* rule = dynamic_cast<const Rule*>(component);
+  if (rule != NULL && rule->isSetVariable())
+  {
+    entry.ids.push_back(rule->getVariable());
+  }
+
+  const InitialAssignment* ia =
+    dynamic_cast<const InitialAssignment*>(component);
+  if (ia != NULL && ia->isSetSymbol())
+  {
+    entry.ids.push_back(ia->getSymbol());
+  }
+
+  const Event* e = dynamic_cast<const Event*>(component);
+  if (e != NULL)
+  {
+    for (unsigned int n = 0; n < e->getNumEventAssignments(); ++n)
+    {
+      if (e->getEventAssignment(n)->isSetVariable())
+        entry.ids.push_back(e->getEventAssignment(n)->getVariable());
+    }
+  }
+
+  const Reaction* r = dynamic_cast<const Reaction*>(component);
+  if (r != NULL)
+  {
+    for (unsigned int n = 0; n < r->getNumReactants(); ++n)
+    {
+      if (r->getReactant(n)->isSetId())
+        entry.ids.push_back(r->getReactant(n)->getId());
+    }
+    for (unsigned int n = 0; n < r->getNumProducts(); ++n)
+    {
+      if (r->getProduct(n)->isSetId())
+        entry.ids.push_back(r->getProduct(n)->getId());
+    }
+    for (unsigned int n = 0; n < r->getNumModifiers(); ++n)
+    {
+      if (r->getModifier(n)->isSetId())
+        entry.ids.push_back(r->getModifier(n)->getId());
+    }
+  }
+}
+
+
+/*
+ * Compares the given document with the one last compared.
+ */
+void
+ValidatedState::compare (const SBMLDocument& doc)
+{
+  const Model* m = doc.getModel();
+
+  for (FailuresMap::iterator it = mFailures.begin(); it != mFailures.end(); ++it)
+  {
+    it->second.checked = false;
+  }
+
+  ComponentMap components;
+  string modelSignature;
+
+  if (m != NULL)
+  {
+    const ListOf* lists[] =
+    {
+      m->getListOfFunctionDefinitions(),
+      m->getListOfUnitDefinitions(),
+      m->getListOfCompartmentTypes(),
+      m->getListOfSpeciesTypes(),
+      m->getListOfCompartments(),
+      m->getListOfSpecies(),
+      m->getListOfParameters(),
+      m->getListOfInitialAssignments(),
+      m->getListOfRules(),
+      m->getListOfConstraints(),
+      m->getListOfReactions(),
+      m->getListOfEvents()
+    };
+
+    for (size_t n = 0; n < sizeof(lists) / sizeof(lists[0]); ++n)
+    {
+      for (unsigned int i = 0; i < lists[n]->size(); ++i)
+      {
+        addComponent(components, lists[n]->get(i));
+      }
+    }
+
+    mModelIds.clear();
+    modelSignature = getModelSignature(doc, *m, mModelIds);
+  }
+
+  mToCheck.clear();
+  mUnchanged  = false;
+  mAllChanged = (!mCompared || m == NULL || modelSignature != mModelSignature);
+
+  if (!mAllChanged)
+  {
+    findComponentsToCheck(components);
+  }
+
+  mComponents.swap(components);
+  mModelSignature = modelSignature;
+  mCompared = (m != NULL);
+}
+
+
+/*
+ * Works out which of the given components, which are those of the
+ * document being compared, have to be checked again.
+ */
+void
+ValidatedState::findComponentsToCheck (const ComponentMap& components)
+{
+  vector<const Component*> changed;
+  ComponentMap::const_iterator it, old;
+
+  for (it = components.begin(); it != components.end(); ++it)
+  {
+    old = mComponents.find(it->first);
+    if (old == mComponents.end() || old->second.signature != it->second.signature)
+    {
+      mToCheck.insert(it->first);
+      changed.push_back(&(it->second));
+      if (old != mComponents.end()) changed.push_back(&(old->second));
+    }
+  }
+
+  for (old = mComponents.begin(); old != mComponents.end(); ++old)
+  {
+    if (components.find(old->first) == components.end())
+    {
+      changed.push_back(&(old->second));
+    }
+  }
+
+  if (changed.empty())
+  {
+    mUnchanged = true;
+    return;
+  }
+
+  /* the model refers to some ids for all its components */
+  size_t n, i;
+  for (n = 0; n < changed.size(); ++n)
+  {
+    for (i = 0; i < changed[n]->ids.size(); ++i)
+    {
+      const string& id = changed[n]->ids[i];
+      if (mModelIds.find(id) != mModelIds.end()
+          || (changed[n]->typecode == SBML_UNIT_DEFINITION
+              && isBuiltInUnit(id)))
+      {
+        mAllChanged = true;
+        return;
+      }
+    }
+  }
+
+  /* the components by each of their ids, and all the ids that are or
+   * were in use */
+  IdMap owners;
+  for (it = components.begin(); it != components.end(); ++it)
+  {
+    for (i = 0; i < it->second.ids.size(); ++i)
+    {
+      owners[it->second.ids[i]].push_back(it->first);
+    }
+  }
+
+  IdMap known = owners;
+  vector<string> queue;
+  for (n = 0; n < changed.size(); ++n)
+  {
+    for (i = 0; i < changed[n]->ids.size(); ++i)
+    {
+      known[changed[n]->ids[i]];
+      queue.push_back(changed[n]->ids[i]);
+    }
+  }
+
+  /* the components whose ids the changed ones refer to; an algebraic
+   * rule may determine any of these, so they count as changed too */
+  for (n = 0; n < changed.size(); ++n)
+  {
+    vector<string> refs;
+    findIds(changed[n]->names, owners, refs);
+    for (i = 0; i < refs.size(); ++i)
+    {
+      const vector<const SBase*>& found = owners[refs[i]];
+      mToCheck.insert(found.begin(), found.end());
+      if (changed[n]->typecode == SBML_ALGEBRAIC_RULE)
+      {
+        queue.push_back(refs[i]);
+      }
+    }
+  }
+
+  /* the components that refer to the changed ones, or to others that
+   * have to be checked again for that reason */
+  IdMap referrers;
+  for (it = components.begin(); it != components.end(); ++it)
+  {
+    vector<string> refs;
+    findIds(it->second.names, known, refs);
+    for (i = 0; i < refs.size(); ++i)
+    {
+      referrers[refs[i]].push_back(it->first);
+    }
+  }
+
+  set<string> queued(queue.begin(), queue.end());
+  set<const SBase*> reached;
+  while (!queue.empty())
+  {
+    IdMap::const_iterator refs = referrers.find(queue.back());
+    queue.pop_back();
+    if (refs == referrers.end()) continue;
+
+    for (n = 0; n < refs->second.size(); ++n)
+    {
+      const SBase* referrer = refs->second[n];
+      if (!reached.insert(referrer).second) continue;
+
+      mToCheck.insert(referrer);
+
+      const vector<string>& ids = components.find(referrer)->second.ids;
+      for (i = 0; i < ids.size(); ++i)
+      {
+        if (queued.insert(ids[i]).second) queue.push_back(ids[i]);
+      }
+    }
+  }
+}
+
+
+/*
+ * Forgets the document last compared and all the failures kept.
+ */
+void
+ValidatedState::clear ()
+{
+  mCompared   = false;
+  mUnchanged  = false;
+  mAllChanged = true;
+  mModelSignature.clear();
+  mModelIds.clear();
+  mComponents.clear();
+  mToCheck.clear();
+  mFailures.clear();
+  mLogKept = false;
+  mLog.clear();
+}
+
+
+/*
+ * Returns true if the failures kept for the category are still those of
+ * the document.
+ */
+bool
+ValidatedState::isUpToDate (SBMLErrorCategory_t category) const
+{
+  return mUnchanged && mFailures.find(category) != mFailures.end();
+}
+
+
+/*
+ * Gets the validator ready to check the document compared last.
+ */
+void
+ValidatedState::prepare (SBMLErrorCategory_t category,
+                         Validator& validator) const
+{
+  /* this may be called again for a validator that has been run already,
+   * on another thread, where it threw */
+  validator.clearFailures();
+
+  FailuresMap::const_iterator it = mFailures.find(category);
+  if (it == mFailures.end() || mAllChanged)
+  {
+    validator.setComponentsToCheck(NULL);
+    return;
+  }
+
+  validator.setComponentsToCheck(&mToCheck);
+
+  const Failures& failures = it->second;
+  list<SBMLError>::const_iterator error = failures.errors.begin();
+  list<const SBase*>::const_iterator component = failures.components.begin();
+  for ( ; error != failures.errors.end(); ++error, ++component)
+  {
+    if (mUnchanged || (*component != NULL
+                       && mComponents.find(*component) != mComponents.end()
+                       && mToCheck.find(*component) == mToCheck.end()))
+    {
+      validator.setCheckedObject(*component);
+      validator.logFailure(*error);
+    }
+  }
+  validator.setCheckedObject(NULL);
+}
+
+
+/*
+ * Keeps the failures the validator found for the next time.
+ */
+void
+ValidatedState::keep (SBMLErrorCategory_t category, const Validator& validator)
+{
+  Failures& failures = mFailures[category];
+  failures.errors = validator.getFailures();
+  failures.components.clear();
+  failures.checked = true;
+
+  const list<const SBase*>& objects = validator.getFailedObjects();
+  list<const SBase*>::const_iterator it;
+  for (it = objects.begin(); it != objects.end(); ++it)
+  {
+    failures.components.push_back(
+      (*it != NULL) ? Validator::getComponent(**it) : NULL);
+  }
+}
+
+
+/*
+ * Drops the failures kept for the categories not checked this time.
+ */
+void
+ValidatedState::dropUnchecked ()
+{
+  FailuresMap::iterator it = mFailures.begin();
+  while (it != mFailures.end())
+  {
+    if (it->second.checked)
+    {
+      ++it;
+    }
+    else
+    {
+      mFailures.erase(it++);
+    }
+  }
+}
+
+
+/*
+ * Remembers the errors in the log before the first incremental check,
+ * or puts them back in place of everything logged since.
+ */
+void
+ValidatedState::resetLog (SBMLErrorLog& log)
+{
+  if (!mLogKept)
+  {
+    for (unsigned int n = 0; n < log.getNumErrors(); ++n)
+    {
+      mLog.push_back(*log.getError(n));
+    }
+    mLogKept = true;
+    return;
+  }
+
+  log.clearLog();
+  log.add(mLog);
+}
+
+LIBSBML_CPP_NAMESPACE_END
+
+/** @endcond */
@@ -0,0 +1,175 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ValidatedState.h
+ * @brief   Remembers a checked document for checking it again incrementally
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#ifndef ValidatedState_h
+#define ValidatedState_h
+
+
+#ifdef __cplusplus
+
+
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <sbml/common/extern.h>
+#include <sbml/SBMLError.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class SBase;
+class SBMLDocument;
+class SBMLErrorLog;
+class Validator;
+
+/*
+ * The ValidatedState remembers what a document looked like when it was
+ * last checked, and the failures each validator found in it, so that
+ * SBMLInternalValidator::checkConsistencyIncremental() only needs to check
+ * again what has been changed since.
+ *
+ * The setters of the SBML objects do not tell anyone that they were
+ * called, and math can be edited in place, so changes are found by
+ * comparing the document with the last one checked.  This is done for
+ * each component of the model (each child of one of its ListOf objects,
+ * together with everything below it): the attributes of each of these
+ * objects, its math, notes and annotation are described in a signature,
+ * which is compared with the one made last time.  Only the math of SBML
+ * Core is described, as only the core validators are run incrementally.
+ *
+ * A component that has changed has to be checked again, and so has one
+ * whose own checks look at it: this is taken to be any component that
+ * refers to its id, directly or through other components that have to be
+ * checked again, and any component whose id it refers to.  The variables
+ * of an event's assignments count as its ids, and so does every id an
+ * algebraic rule refers to.  When the attributes of the model change, or
+ * a component they refer to or a built-in unit is redefined, all the
+ * components are checked again.
+ *
+ * Only the checks each validator makes of a single component are left
+ * out for the others; the failures they found last time are kept.  The
+ * checks of the model as a whole are always made again, unless nothing
+ * at all has changed.
+ */
+class ValidatedState
+{
+public:
+
+  ValidatedState ();
+
+
+  /*
+   * Compares the given document with the one last compared, working out
+   * which components have to be checked again, and remembers it for the
+   * next time.
+   */
+  void compare (const SBMLDocument& doc);
+
+
+  /*
+   * Forgets the document last compared and all the failures kept.
+   */
+  void clear ();
+
+
+  /*
+   * Returns true if the document has not changed since the failures kept
+   * for the given category were found, so that they can be reported again
+   * without running the validator.
+   */
+  bool isUpToDate (SBMLErrorCategory_t category) const;
+
+
+  /*
+   * Gets the given validator ready to check the document compared last:
+   * it is told which components to check, and is given the failures kept
+   * for the others.  If nothing is kept for the category, the validator
+   * checks everything.
+   */
+  void prepare (SBMLErrorCategory_t category, Validator& validator) const;
+
+
+  /*
+   * Keeps the failures the validator found, once it has been run, for the
+   * next time the category is checked.
+   */
+  void keep (SBMLErrorCategory_t category, const Validator& validator);
+
+
+  /*
+   * Drops the failures kept for the categories that were not checked
+   * since the last call to compare(), as these are out of date.
+   */
+  void dropUnchecked ();
+
+
+  /*
+   * Remembers the errors in the given log before the first incremental
+   * check, which are then put back into it before each later one.
+   */
+  void resetLog (SBMLErrorLog& log);
+
+
+private:
+
+  struct Component
+  {
+    std::string              signature;
+    std::vector<std::string> names;
+    std::vector<std::string> ids;
+    int                      typecode;
+  };
+
+  struct Failures
+  {
+    std::list<SBMLError>    errors;
+    std::list<const SBase*> components;
+    bool                    checked;
+  };
+
+  typedef std::map<const SBase*, Component>    ComponentMap;
+  typedef std::map<int, Failures>              FailuresMap;
+
+  void addComponent (ComponentMap& components, const SBase* component) const;
+
+  void findComponentsToCheck (const ComponentMap& components);
+
+  bool                    mCompared;
+  bool                    mUnchanged;
+  bool                    mAllChanged;
+  std::string             mModelSignature;
+  std::set<std::string>   mModelIds;
+  ComponentMap            mComponents;
+  std::set<const SBase*>  mToCheck;
+  FailuresMap             mFailures;
+
+  bool                    mLogKept;
+  std::list<SBMLError>    mLog;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* ValidatedState_h */
+/** @endcond */
@@ -0,0 +1,182 @@
+/**
+ * @file    ValidationCallback.cpp
+ * @brief   Receives the failures of a consistency check as they are found
+ * @author  libSBML Team
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/common/libsbml-config.h>
+#include <sbml/common/operationReturnValues.h>
+#include <sbml/validator/ValidationCallback.h>
+#include <sbml/SBMLError.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+
+ValidationCallback::ValidationCallback ()
+  : mMaxErrors    ( 0 )
+  , mStopSeverity ( LIBSBML_SEV_NOT_APPLICABLE )
+  , mNumReported  ( 0 )
+  , mNumReportedErrors ( 0 )
+  , mStopped      ( false )
+  , mKeepFailures ( true )
+{
+}
+
+
+ValidationCallback::~ValidationCallback ()
+{
+}
+
+
+int
+ValidationCallback::process (const SBMLError&)
+{
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+int
+ValidationCallback::setMaxErrors (unsigned int maxErrors)
+{
+  mMaxErrors = maxErrors;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+unsigned int
+ValidationCallback::getMaxErrors () const
+{
+  return mMaxErrors;
+}
+
+
+int
+ValidationCallback::setStopSeverity (unsigned int severity)
+{
+  if (severity > LIBSBML_SEV_FATAL)
+  {
+    return LIBSBML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  mStopSeverity = severity;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+unsigned int
+ValidationCallback::getStopSeverity () const
+{
+  return mStopSeverity;
+}
+
+
+bool
+ValidationCallback::isSetStopSeverity () const
+{
+  return mStopSeverity != LIBSBML_SEV_NOT_APPLICABLE;
+}
+
+
+int
+ValidationCallback::unsetStopSeverity ()
+{
+  mStopSeverity = LIBSBML_SEV_NOT_APPLICABLE;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+int
+ValidationCallback::setKeepFailures (bool keep)
+{
+  mKeepFailures = keep;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+bool
+ValidationCallback::getKeepFailures () const
+{
+  return mKeepFailures;
+}
+
+
+unsigned int
+ValidationCallback::getNumReported () const
+{
+  return mNumReported;
+}
+
+
+bool
+ValidationCallback::isStopped () const
+{
+  return mStopped;
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+void
+ValidationCallback::start ()
+{
+  mNumReported = 0;
+  mNumReportedErrors = 0;
+  mStopped = false;
+}
+
+
+unsigned int
+ValidationCallback::getNumReportedErrors () const
+{
+  return mNumReportedErrors;
+}
+
+
+bool
+ValidationCallback::report (const SBMLError& error)
+{
+  if (mStopped)
+  {
+    return false;
+  }
+
+  ++mNumReported;
+  if (error.getSeverity() == LIBSBML_SEV_ERROR)
+  {
+    ++mNumReportedErrors;
+  }
+
+  if (process(error) != LIBSBML_OPERATION_SUCCESS)
+  {
+    mStopped = true;
+  }
+  else if (mMaxErrors > 0 && mNumReported >= mMaxErrors)
+  {
+    mStopped = true;
+  }
+  else if (isSetStopSeverity() && error.getSeverity() <= LIBSBML_SEV_FATAL
+           && error.getSeverity() >= mStopSeverity)
+  {
+    mStopped = true;
+  }
+
+  return !mStopped;
+}
+/** @endcond */
+
+
+LIBSBML_CPP_NAMESPACE_END
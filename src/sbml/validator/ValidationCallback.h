@@ -0,0 +1,251 @@
+/**
+ * @file    ValidationCallback.h
+ * @brief   Receives the failures of a consistency check as they are found
+ * @author  libSBML Team
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class ValidationCallback
+ * @sbmlbrief{core} Receives validation failures as they are found.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * SBMLDocument::checkConsistency() normally reports nothing until all the
+ * checks have been made, when the failures can be read from the error log
+ * of the document.  A ValidationCallback attached to the document with
+ * SBMLDocument::setValidationCallback() is instead given each failure as
+ * soon as it is found, through its process() method, which programs
+ * override to show or store the failure.  Each failure is added to the
+ * error log of the document as well, in the usual order.
+ *
+ * The callback can also stop the checks early: when process() returns a
+ * value other than @sbmlconstant{LIBSBML_OPERATION_SUCCESS,
+ * OperationReturnValues_t}, once a given number of failures has been
+ * reported (see setMaxErrors()), or once a failure of a given severity
+ * or worse has been reported (see setStopSeverity()).  The checks in
+ * progress are then abandoned and no further failures are found, so a
+ * badly broken model does not fill the error log with more failures than
+ * are wanted.
+ *
+ * Each failure passed to process() can also be left out of the error
+ * log, so that checking a model with a great many failures does not hold
+ * them all in memory (see setKeepFailures()).  The value returned by
+ * SBMLDocument::checkConsistency() still counts them.
+ *
+ * The same callback may be attached to several documents, as long as
+ * they are not checked at the same time; what it counts starts again
+ * with each check.
+ */
+
+#ifndef ValidationCallback_h
+#define ValidationCallback_h
+
+
+#include <sbml/common/extern.h>
+
+
+#ifdef __cplusplus
+
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class SBMLError;
+
+
+class LIBSBML_EXTERN ValidationCallback
+{
+public:
+
+  /**
+   * Creates a new ValidationCallback that never stops the checks by
+   * itself.
+   */
+  ValidationCallback ();
+
+
+  /**
+   * Destroys this ValidationCallback.
+   */
+  virtual ~ValidationCallback ();
+
+
+  /**
+   * Called with each failure as soon as it is found.
+   *
+   * The default implementation does nothing.
+   *
+   * @param error the failure found; it is only valid during the call.
+   *
+   * @return @sbmlconstant{LIBSBML_OPERATION_SUCCESS,
+   * OperationReturnValues_t} to carry on checking, any other value to
+   * stop.
+   */
+  virtual int process (const SBMLError& error);
+
+
+  /**
+   * Sets the number of failures after which the checks stop.
+   *
+   * @param maxErrors the number of failures to report at most; @c 0 (the
+   * default) means there is no limit.
+   *
+   * @copydetails doc_returns_one_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   */
+  int setMaxErrors (unsigned int maxErrors);
+
+
+  /**
+   * Returns the number of failures after which the checks stop.
+   *
+   * @return the number set with setMaxErrors(), or @c 0 if there is no
+   * limit.
+   */
+  unsigned int getMaxErrors () const;
+
+
+  /**
+   * Sets the severity of the failures that stop the checks.
+   *
+   * @param severity the severity, such as
+   * @sbmlconstant{LIBSBML_SEV_ERROR, XMLErrorSeverity_t}; the checks stop
+   * after the first failure of this severity or a more serious one.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   *
+   * @see unsetStopSeverity()
+   */
+  int setStopSeverity (unsigned int severity);
+
+
+  /**
+   * Returns the severity of the failures that stop the checks.
+   *
+   * @return the severity set with setStopSeverity(), or
+   * @sbmlconstant{LIBSBML_SEV_NOT_APPLICABLE, XMLErrorSeverity_t} if
+   * none is set.
+   */
+  unsigned int getStopSeverity () const;
+
+
+  /**
+   * Returns @c true if the checks stop at a failure of a given severity.
+   *
+   * @return @c true if setStopSeverity() has been called, @c false
+   * otherwise.
+   */
+  bool isSetStopSeverity () const;
+
+
+  /**
+   * Stops the checks from stopping at failures of any given severity.
+   *
+   * @copydetails doc_returns_one_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   */
+  int unsetStopSeverity ();
+
+
+  /**
+   * Sets whether the failures passed to process() are kept as well.
+   *
+   * @param keep @c true (the default) to add each failure to the error
+   * log of the document too, @c false to only pass it to process().  The
+   * failures of package validators, and of those added with
+   * SBMLDocument::addValidator(), are always added to the error log.
+   *
+   * @copydetails doc_returns_one_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   */
+  int setKeepFailures (bool keep);
+
+
+  /**
+   * Returns @c true if the failures passed to process() are kept as well.
+   *
+   * @return the value set with setKeepFailures(), @c true by default.
+   */
+  bool getKeepFailures () const;
+
+
+  /**
+   * Returns the number of failures reported during the last check.
+   *
+   * @return the number of times process() was called since the last check
+   * began.
+   */
+  unsigned int getNumReported () const;
+
+
+  /**
+   * Returns @c true if this callback stopped the last check early.
+   *
+   * @return @c true if the last check was stopped by process(), by the
+   * number of failures or by their severity, @c false otherwise.
+   */
+  bool isStopped () const;
+
+
+  /** @cond doxygenLibsbmlInternal */
+
+  /**
+   * Gets this callback ready for a new check.
+   */
+  void start ();
+
+
+  /**
+   * Returns the number of failures of severity
+   * @sbmlconstant{LIBSBML_SEV_ERROR, XMLErrorSeverity_t} reported during
+   * the last check.
+   */
+  unsigned int getNumReportedErrors () const;
+
+
+  /**
+   * Passes the given failure to process(), unless the check has already
+   * been stopped.
+   *
+   * @return @c true if the check is to carry on.
+   */
+  bool report (const SBMLError& error);
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygenLibsbmlInternal */
+
+  ValidationCallback (const ValidationCallback&);
+  ValidationCallback& operator= (const ValidationCallback&);
+
+  unsigned int mMaxErrors;
+  unsigned int mStopSeverity;
+  unsigned int mNumReported;
+  unsigned int mNumReportedErrors;
+  bool         mStopped;
+  bool         mKeepFailures;
+
+  /** @endcond */
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* ValidationCallback_h */
@@ -49,6 +49,7 @@
 
 #include <sbml/validator/VConstraint.h>
 #include <sbml/validator/Validator.h>
+#include <sbml/validator/ValidationCallback.h>
 #include <sbml/validator/UnitConsistencyValidator.h>
 #include <sbml/AlgebraicRule.h>
 #include <sbml/AssignmentRule.h>
@@ -125,6 +126,22 @@ public:
     for_each(constraints.begin(), constraints.end(), Apply<T>(model, object));
   }
 
+  /*
+   * Applies the Constraints in this ConstraintSet that check the objects
+   * within the given SBML object one at a time.
+   */
+  void applySingleObjectChecksTo (const Model& model, const T& object)
+  {
+    typename std::list< TConstraint<T>* >::iterator it;
+    for (it = constraints.begin(); it != constraints.end(); ++it)
+    {
+      if ((*it)->checksSingleObjects())
+      {
+        (*it)->check(model, object);
+      }
+    }
+  }
+
   /*
    * Returns @c true if this ConstraintSet is empty, @c false otherwise.
    *
@@ -194,6 +211,7 @@ struct ValidatorConstraints
 
   ~ValidatorConstraints ();
   void add (VConstraint* c);
+  void reset ();
 };
 
 /*
@@ -217,6 +235,22 @@ ValidatorConstraints::~ValidatorConstraints ()
 }
 
 
+/*
+ * Resets every constraint once, whichever ConstraintSets it is stored in.
+ */
+void
+ValidatorConstraints::reset ()
+{
+  map<VConstraint*,bool>::iterator it = ptrMap.begin();
+
+  while(it != ptrMap.end())
+  {
+     it->first->reset();
+     ++it;
+  }
+}
+
+
 /*
  * Adds the given Contraint to the appropriate ConstraintSet.
  */
@@ -447,24 +481,34 @@ public:
 
   void visit (const SBMLDocument& x)
   {
-    v.mConstraints->mSBMLDocument.applyTo(m, x);
+    if (v.mCheckWholeModel)
+    {
+      v.mConstraints->mSBMLDocument.applyTo(m, x);
+    }
   }
 
 
   void visit (const Model& x)
   {
-    v.mConstraints->mModel.applyTo(m, x);
+    if (v.mCheckWholeModel)
+    {
+      v.mConstraints->mModel.applyTo(m, x);
+    }
+    else
+    {
+      v.mConstraints->mModel.applySingleObjectChecksTo(m, x);
+    }
   }
 
 
   void visit (const KineticLaw& x)
   {
-    v.mConstraints->mKineticLaw.applyTo(m, x);
+    apply(v.mConstraints->mKineticLaw, x);
   }
 
   void visit (const Priority& x)
   {
-    v.mConstraints->mPriority.applyTo(m, x);
+    apply(v.mConstraints->mPriority, x);
   }
 
 
@@ -479,7 +523,7 @@ public:
 
   bool visit (const FunctionDefinition& x)
   {
-    v.mConstraints->mFunctionDefinition.applyTo(m, x);
+    apply(v.mConstraints->mFunctionDefinition, x);
     return !v.mConstraints->mFunctionDefinition.empty();
   }
 
@@ -493,7 +537,7 @@ public:
 
   bool visit (const UnitDefinition& x)
   {
-    v.mConstraints->mUnitDefinition.applyTo(m, x);
+    apply(v.mConstraints->mUnitDefinition, x);
 
     return
       !v.mConstraints->mUnitDefinition.empty() ||
@@ -503,21 +547,21 @@ public:
 
   bool visit (const Unit& x)
   {
-    v.mConstraints->mUnit.applyTo(m, x);
+    apply(v.mConstraints->mUnit, x);
     return !v.mConstraints->mUnit.empty();
   }
 
 
   bool visit (const Compartment &x)
   {
-    v.mConstraints->mCompartment.applyTo(m, x);
+    apply(v.mConstraints->mCompartment, x);
     return !v.mConstraints->mCompartment.empty();
   }
 
 
   bool visit (const Species& x)
   {
-    v.mConstraints->mSpecies.applyTo(m, x);
+    apply(v.mConstraints->mSpecies, x);
     return !v.mConstraints->mSpecies.empty();
   }
 
@@ -530,7 +574,7 @@ public:
     }
     else
     {
-      v.mConstraints->mParameter.applyTo(m, x);
+      apply(v.mConstraints->mParameter, x);
       return !v.mConstraints->mParameter.empty();
     }
 
@@ -539,7 +583,7 @@ public:
 
   bool visit (const Rule& x)
   {
-    v.mConstraints->mRule.applyTo(m, x);
+    apply(v.mConstraints->mRule, x);
     return true;
   }
 
@@ -547,7 +591,7 @@ public:
   bool visit (const AlgebraicRule& x)
   {
     visit( static_cast<const Rule&>(x) );
-    v.mConstraints->mAlgebraicRule.applyTo(m, x);
+    apply(v.mConstraints->mAlgebraicRule, x);
 
     return true;
   }
@@ -556,7 +600,7 @@ public:
   bool visit (const AssignmentRule& x)
   {
     visit( static_cast<const Rule&>(x) );
-    v.mConstraints->mAssignmentRule.applyTo(m, x);
+    apply(v.mConstraints->mAssignmentRule, x);
 
     return true;
   }
@@ -565,7 +609,7 @@ public:
   bool visit (const RateRule& x)
   {
     visit( static_cast<const Rule&>(x) );
-    v.mConstraints->mRateRule.applyTo(m, x);
+    apply(v.mConstraints->mRateRule, x);
 
     return true;
   }
@@ -573,14 +617,14 @@ public:
 
   bool visit (const Reaction& x)
   {
-    v.mConstraints->mReaction.applyTo(m, x);
+    apply(v.mConstraints->mReaction, x);
     return true;
   }
 
 
   bool visit (const SimpleSpeciesReference& x)
   {
-    v.mConstraints->mSimpleSpeciesReference.applyTo(m, x);
+    apply(v.mConstraints->mSimpleSpeciesReference, x);
     return true;
   }
 
@@ -588,7 +632,7 @@ public:
   bool visit (const SpeciesReference& x)
   {
     visit( static_cast<const SimpleSpeciesReference&>(x) );
-    v.mConstraints->mSpeciesReference.applyTo(m, x);
+    apply(v.mConstraints->mSpeciesReference, x);
 
     return
       !v.mConstraints->mSimpleSpeciesReference.empty() ||
@@ -599,7 +643,7 @@ public:
   bool visit (const ModifierSpeciesReference& x)
   {
     visit( static_cast<const SimpleSpeciesReference&>(x) );
-    v.mConstraints->mModifierSpeciesReference.applyTo(m, x);
+    apply(v.mConstraints->mModifierSpeciesReference, x);
 
     return
       !v.mConstraints->mSimpleSpeciesReference  .empty() ||
@@ -608,7 +652,7 @@ public:
 
   bool visit(const StoichiometryMath& x)
   {
-    v.mConstraints->mStoichiometryMath.applyTo(m, x);
+    apply(v.mConstraints->mStoichiometryMath, x);
 
     return
       !v.mConstraints->mStoichiometryMath.empty();
@@ -618,7 +662,7 @@ public:
 
   bool visit (const Event& x)
   {
-    v.mConstraints->mEvent.applyTo(m, x);
+    apply(v.mConstraints->mEvent, x);
 
     return
       !v.mConstraints->mEvent          .empty() ||
@@ -628,54 +672,69 @@ public:
 
   bool visit (const EventAssignment& x)
   {
-    v.mConstraints->mEventAssignment.applyTo(m, x);
+    apply(v.mConstraints->mEventAssignment, x);
     return !v.mConstraints->mEventAssignment.empty();
   }
 
   bool visit (const InitialAssignment& x)
   {
-    v.mConstraints->mInitialAssignment.applyTo(m, x);
+    apply(v.mConstraints->mInitialAssignment, x);
     return !v.mConstraints->mInitialAssignment.empty();
   }
 
   bool visit (const Constraint& x)
   {
-    v.mConstraints->mConstraint.applyTo(m, x);
+    apply(v.mConstraints->mConstraint, x);
     return !v.mConstraints->mConstraint.empty();
   }
 
   bool visit (const Trigger& x)
   {
-    v.mConstraints->mTrigger.applyTo(m, x);
+    apply(v.mConstraints->mTrigger, x);
     return !v.mConstraints->mTrigger.empty();
   }
 
   bool visit (const Delay& x)
   {
-    v.mConstraints->mDelay.applyTo(m, x);
+    apply(v.mConstraints->mDelay, x);
     return !v.mConstraints->mDelay.empty();
   }
 
   bool visit (const CompartmentType& x)
   {
-    v.mConstraints->mCompartmentType.applyTo(m, x);
+    apply(v.mConstraints->mCompartmentType, x);
     return !v.mConstraints->mCompartmentType.empty();
   }
 
   bool visit (const SpeciesType& x)
   {
-    v.mConstraints->mSpeciesType.applyTo(m, x);
+    apply(v.mConstraints->mSpeciesType, x);
     return !v.mConstraints->mSpeciesType.empty();
   }
 
   bool visit (const LocalParameter& x)
   {
-    v.mConstraints->mLocalParameter.applyTo(m, x);
+    apply(v.mConstraints->mLocalParameter, x);
     return !v.mConstraints->mLocalParameter.empty();
   }
 
 protected:
 
+  /*
+   * Applies the given constraints to an object other than the model or
+   * document, unless the validator leaves it out; any failures logged
+   * are put down to the object.
+   */
+  template <typename T>
+  void apply (ConstraintSet<T>& constraints, const T& x)
+  {
+    if (!v.isToBeChecked(x)) return;
+
+    v.setCheckedObject(&x);
+    constraints.applyTo(m, x);
+    v.setCheckedObject(NULL);
+  }
+
   /** @cond doxygenLibsbmlInternal */
   Validator&   v;
   const Model& m;
@@ -697,6 +756,12 @@ Validator::Validator (const SBMLErrorCategory_t category)
 {
   mCategory = category;
   mConstraints = new ValidatorConstraints();
+  mProfile = NULL;
+  mComponentsToCheck = NULL;
+  mCheckWholeModel = true;
+  mCheckedObject = NULL;
+  mNumToBeChecked = 0;
+  mCallback = NULL;
 
   switch(category)
   {
@@ -763,6 +828,27 @@ void
 Validator::clearFailures ()
 {
   mFailures.clear();
+  mFailedObjects.clear();
+  mFailurePositions.clear();
+}
+
+
+/*
+ * Clears this Validator's list of validation failures and the state its
+ * constraints keep from the last document validated.
+ */
+void
+Validator::reset ()
+{
+  mFailures.clear();
+  mFailedObjects.clear();
+  mFailurePositions.clear();
+  mComponentsToCheck = NULL;
+  mCheckWholeModel = true;
+  mCheckedObject = NULL;
+  mNumToBeChecked = 0;
+  mCallback = NULL;
+  mConstraints->reset();
 }
 
 
@@ -786,6 +872,38 @@ Validator::getFailures () const
 }
 
 
+/*
+ * Sets the ValidatorProfile that records the time taken by each constraint
+ * of this Validator.
+ */
+void
+Validator::setProfile (ValidatorProfile* profile, const std::string& name)
+{
+  mProfile = profile;
+  mProfileName = name;
+}
+
+
+/*
+ * @return the ValidatorProfile of this Validator, or NULL.
+ */
+ValidatorProfile*
+Validator::getProfile () const
+{
+  return mProfile;
+}
+
+
+/*
+ * @return the name under which this Validator is recorded in its profile.
+ */
+const std::string&
+Validator::getProfileName () const
+{
+  return mProfileName;
+}
+
+
 /** @cond doxygenLibsbmlInternal */
 
 unsigned int 
@@ -816,9 +934,160 @@ Validator::getConsistencyVersion()
 void
 Validator::logFailure (const SBMLError& msg)
 {
+  // a check of the model as a whole made by a constraint that otherwise
+  // checks single objects; it is up to the validator that checks the
+  // whole model to log it
+  if (!mCheckWholeModel && mCheckedObject == NULL)
+  {
+    return;
+  }
+
+  if (mCallback != NULL)
+  {
+    if (mCallback->isStopped()) return;
+    mCallback->report(msg);
+    if (!mCallback->getKeepFailures()) return;
+  }
+
   mFailures.push_back(msg);
+  mFailedObjects.push_back(mCheckedObject);
+  mFailurePositions.push_back(2 * mNumToBeChecked
+                              + (mCheckedObject == NULL ? 1 : 0));
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Restricts the checks of single objects to those within the given
+ * components, or lifts the restriction if components is NULL.
+ */
+void
+Validator::setComponentsToCheck (const std::set<const SBase*>* components)
+{
+  mComponentsToCheck = components;
+}
+
+
+/*
+ * @return true if the checks of the given object are to be made.
+ */
+bool
+Validator::isToBeChecked (const SBase& object) const
+{
+  ++mNumToBeChecked;
+
+  if (isStopped())
+  {
+    return false;
+  }
+
+  if (mComponentsToCheck == NULL)
+  {
+    return true;
+  }
+
+  const SBase* component = getComponent(object);
+  if (component == NULL)
+  {
+    return mCheckWholeModel;
+  }
+
+  return mComponentsToCheck->find(component) != mComponentsToCheck->end();
+}
+
+
+/*
+ * Sets whether the document, the model and the objects outside the
+ * components of the model are checked.
+ */
+void
+Validator::setCheckWholeModel (bool check)
+{
+  mCheckWholeModel = check;
+}
+
+
+/*
+ * Sets the callback each failure is passed to as it is logged.
+ */
+void
+Validator::setCallback (ValidationCallback* callback)
+{
+  mCallback = callback;
+}
+
+
+/*
+ * @return true if the callback has stopped the checks.
+ */
+bool
+Validator::isStopped () const
+{
+  return mCallback != NULL && mCallback->isStopped();
 }
 
+
+/*
+ * Sets the object whose own checks are being made.
+ */
+void
+Validator::setCheckedObject (const SBase* object)
+{
+  mCheckedObject = object;
+}
+
+
+/*
+ * @return the objects that the failures were put down to.
+ */
+const std::list<const SBase*>&
+Validator::getFailedObjects () const
+{
+  return mFailedObjects;
+}
+
+
+/*
+ * @return where in the checks each failure was found.
+ */
+const std::list<unsigned int>&
+Validator::getFailurePositions () const
+{
+  return mFailurePositions;
+}
+
+
+/*
+ * @return the component of the model that the given object is within.
+ */
+const SBase*
+Validator::getComponent (const SBase& object)
+{
+  const SBMLDocument* doc = object.getSBMLDocument();
+  const Model* model = (doc != NULL) ? doc->getModel() : NULL;
+  if (model == NULL)
+  {
+    return NULL;
+  }
+
+  const SBase* child = &object;
+  const SBase* parent = child->getParentSBMLObject();
+  while (parent != NULL)
+  {
+    if (parent->getTypeCode() == SBML_LIST_OF
+        && parent->getParentSBMLObject() == model)
+    {
+      return child;
+    }
+
+    child = parent;
+    parent = child->getParentSBMLObject();
+  }
+
+  return NULL;
+}
+/** @endcond */
+
 /*
  * Helper class used by
  * validate
@@ -861,6 +1130,7 @@ unsigned int
 Validator::validate (const SBMLDocument& d)
 {
   Model* m = const_cast<SBMLDocument&>(d).getModel();
+  mNumToBeChecked = 0;
 
   if (m != NULL)
   {
@@ -898,11 +1168,24 @@ Validator::validate (const SBMLDocument& d)
 
     if (unrecognisedTerm)
     {
-      std::list<SBMLError>::iterator it;
-      it = remove_if(mFailures.begin(), mFailures.end(),DontMatchId(99701));
-      mFailures.erase(it, mFailures.end());
-
-      //remove_if(mFailures.begin(), mFailures.end(), DontMatchId(99701));
+      std::list<SBMLError>::iterator it = mFailures.begin();
+      std::list<const SBase*>::iterator object = mFailedObjects.begin();
+      std::list<unsigned int>::iterator position = mFailurePositions.begin();
+      while (it != mFailures.end())
+      {
+        if (DontMatchId(99701)(*it))
+        {
+          it = mFailures.erase(it);
+          object = mFailedObjects.erase(object);
+          position = mFailurePositions.erase(position);
+        }
+        else
+        {
+          ++it;
+          ++object;
+          ++position;
+        }
+      }
     }
   }
 
@@ -74,6 +74,7 @@
 
 /** @cond doxygenLibsbmlInternal */
 #include <list>
+#include <set>
 #include <string>
 /** @endcond */
 
@@ -84,7 +85,10 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 
 class VConstraint;
 struct ValidatorConstraints;
+class SBase;
 class SBMLDocument;
+class ValidatorProfile;
+class ValidationCallback;
 
 
 class LIBSBML_EXTERN Validator
@@ -141,6 +145,17 @@ public:
   void clearFailures ();
 
 
+  /**
+   * Clears this Validator's list of validation failures, together with
+   * anything its constraints remember from the last document validated.
+   *
+   * An initialized Validator can validate any number of documents, one
+   * at a time, if this method is called before each new document; this
+   * saves calling init() for every document.
+   */
+  void reset ();
+
+
   /**
    * Get the category of validation rules covered by this validator.
    *
@@ -192,12 +207,134 @@ public:
    */
   virtual unsigned int validate (const std::string& filename);
 
+  /**
+   * Sets the ValidatorProfile that records how long each constraint of
+   * this Validator takes to check.
+   *
+   * @param profile the ValidatorProfile to add to, or @c NULL to stop
+   * profiling.  The profile is not owned by this Validator.
+   * @param name the name under which the constraints of this Validator
+   * are recorded in the profile.
+   */
+  void setProfile (ValidatorProfile* profile, const std::string& name);
+
+
+  /**
+   * Returns the ValidatorProfile of this Validator.
+   *
+   * @return the ValidatorProfile set with setProfile(), or @c NULL if this
+   * Validator is not being profiled.
+   */
+  ValidatorProfile* getProfile () const;
+
+
+  /**
+   * Returns the name under which this Validator is recorded in its
+   * ValidatorProfile.
+   *
+   * @return the name given to setProfile().
+   */
+  const std::string& getProfileName () const;
+
+
     /** @cond doxygenLibsbmlInternal */
 
     unsigned int getConsistencyLevel();
 
     unsigned int getConsistencyVersion();
 
+
+  /**
+   * Restricts the checks this Validator makes of single objects to the
+   * objects within the given components of the model (the children of
+   * its ListOf objects).  The checks of the model as a whole are still
+   * made, as are those of objects that are not within any component,
+   * unless setCheckWholeModel() says otherwise.
+   *
+   * @param components the components to check, or @c NULL to check all
+   * of them.  The set is not owned by this Validator.
+   */
+  void setComponentsToCheck (const std::set<const SBase*>* components);
+
+
+  /**
+   * Returns @c true if the checks of the given object are to be made, as
+   * set by setComponentsToCheck().  Each object is asked about in turn as
+   * the checks come to it, whether it is checked or not; the number of
+   * objects asked about so far marks how far the checks have got.
+   */
+  bool isToBeChecked (const SBase& object) const;
+
+
+  /**
+   * Sets whether this Validator makes the checks of the document and the
+   * model as a whole, and of the objects that are not within any
+   * component.  With @c false, only the components given to
+   * setComponentsToCheck() are checked, so that the components of one
+   * model can be shared out between several validators; constraints on
+   * the model are only applied if they check the objects within it one
+   * at a time (see VConstraint::checksSingleObjects()), and failures that
+   * are not put down to an object are dropped.
+   *
+   * @param check @c true (the default) to make these checks.
+   */
+  void setCheckWholeModel (bool check);
+
+
+  /**
+   * Sets the object whose own checks are being made, which failures
+   * logged from now on are put down to; @c NULL for the checks of the
+   * model as a whole.
+   */
+  void setCheckedObject (const SBase* object);
+
+
+  /**
+   * Returns the objects that the failures were put down to, in the order
+   * of getFailures(); @c NULL where a failure came from a check of the
+   * model as a whole.
+   */
+  const std::list<const SBase*>& getFailedObjects () const;
+
+
+  /**
+   * Returns where in the checks each failure was found, in the order of
+   * getFailures(): twice the number of objects asked about by then (see
+   * isToBeChecked()), plus one where the failure came from a check of
+   * the model as a whole.  Sorting the failures of validators that share
+   * out the components of a model by these positions puts them in the
+   * order one validator checking the whole model would find them.
+   */
+  const std::list<unsigned int>& getFailurePositions () const;
+
+
+  /**
+   * Returns the component of the model (the child of one of its ListOf
+   * objects) that the given object is, or is within, or @c NULL if there
+   * is none.
+   */
+  static const SBase* getComponent (const SBase& object);
+
+
+  /**
+   * Sets the ValidationCallback that each failure is passed to as it is
+   * logged.  Once the callback stops the checks, no more constraints are
+   * checked and no more failures are logged.
+   *
+   * @param callback the callback, or @c NULL (the default) to only log
+   * the failures.  It is not owned by this Validator.  Unless it keeps
+   * the failures (see ValidationCallback::setKeepFailures()), they are
+   * only passed to it and not logged.
+   */
+  void setCallback (ValidationCallback* callback);
+
+
+  /**
+   * Returns @c true if the callback set with setCallback() has stopped
+   * the checks.
+   */
+  bool isStopped () const;
+
   /** @endcond */
 
 protected:
@@ -207,6 +344,16 @@ protected:
   unsigned int          mCategory;
   unsigned int          mConsistencyLevel;
   unsigned int          mConsistencyVersion;
+  ValidatorProfile*     mProfile;
+  std::string           mProfileName;
+
+  const std::set<const SBase*>* mComponentsToCheck;
+  bool                          mCheckWholeModel;
+  const SBase*                  mCheckedObject;
+  std::list<const SBase*>       mFailedObjects;
+  std::list<unsigned int>       mFailurePositions;
+  mutable unsigned int          mNumToBeChecked;
+  ValidationCallback*           mCallback;
 
 
   friend class ValidatingVisitor;
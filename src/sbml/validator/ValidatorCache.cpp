@@ -0,0 +1,309 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ValidatorCache.cpp
+ * @brief   Keeps initialized validators for reuse across documents
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/validator/ValidatorCache.h>
+
+#include <map>
+#include <vector>
+
+#ifdef LIBSBML_USE_THREADS
+#include <mutex>
+#endif
+
+#include <sbml/validator/ConsistencyValidator.h>
+#include <sbml/validator/IdentifierConsistencyValidator.h>
+#include <sbml/validator/MathMLConsistencyValidator.h>
+#include <sbml/validator/SBOConsistencyValidator.h>
+#include <sbml/validator/UnitConsistencyValidator.h>
+#include <sbml/validator/OverdeterminedValidator.h>
+#include <sbml/validator/ModelingPracticeValidator.h>
+#include <sbml/validator/InternalConsistencyValidator.h>
+#include <sbml/validator/L1CompatibilityValidator.h>
+#include <sbml/validator/L2v1CompatibilityValidator.h>
+#include <sbml/validator/L2v2CompatibilityValidator.h>
+#include <sbml/validator/L2v3CompatibilityValidator.h>
+#include <sbml/validator/L2v4CompatibilityValidator.h>
+#include <sbml/validator/L3v1CompatibilityValidator.h>
+#include <sbml/validator/L3v2CompatibilityValidator.h>
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * The validators not in use, by category.  The validators left over are
+ * deleted when the library is unloaded.
+ */
+struct ValidatorCacheStore
+{
+  typedef map< int, vector<Validator*> > IdleMap;
+
+  IdleMap idle;
+#ifdef LIBSBML_USE_THREADS
+  std::mutex mutex;
+#endif
+
+  ~ValidatorCacheStore ()
+  {
+    deleteIdle();
+  }
+
+  void deleteIdle ()
+  {
+    for (IdleMap::iterator it = idle.begin(); it != idle.end(); ++it)
+    {
+      for (size_t n = 0; n < it->second.size(); ++n)
+      {
+        delete it->second[n];
+      }
+    }
+    idle.clear();
+  }
+};
+
+
+static ValidatorCacheStore&
+getStore ()
+{
+  static ValidatorCacheStore store;
+  return store;
+}
+
+
+/*
+ * Returns a new, uninitialized validator for the given category, or NULL.
+ */
+static Validator*
+createValidator (SBMLErrorCategory_t category)
+{
+  switch (category)
+  {
+  case LIBSBML_CAT_IDENTIFIER_CONSISTENCY:
+    return new IdentifierConsistencyValidator();
+  case LIBSBML_CAT_GENERAL_CONSISTENCY:
+    return new ConsistencyValidator();
+  case LIBSBML_CAT_SBO_CONSISTENCY:
+    return new SBOConsistencyValidator();
+  case LIBSBML_CAT_MATHML_CONSISTENCY:
+    return new MathMLConsistencyValidator();
+  case LIBSBML_CAT_UNITS_CONSISTENCY:
+    return new UnitConsistencyValidator();
+  case LIBSBML_CAT_OVERDETERMINED_MODEL:
+    return new OverdeterminedValidator();
+  case LIBSBML_CAT_MODELING_PRACTICE:
+    return new ModelingPracticeValidator();
+  case LIBSBML_CAT_INTERNAL_CONSISTENCY:
+    return new InternalConsistencyValidator();
+  case LIBSBML_CAT_SBML_L1_COMPAT:
+    return new L1CompatibilityValidator();
+  case LIBSBML_CAT_SBML_L2V1_COMPAT:
+    return new L2v1CompatibilityValidator();
+  case LIBSBML_CAT_SBML_L2V2_COMPAT:
+    return new L2v2CompatibilityValidator();
+  case LIBSBML_CAT_SBML_L2V3_COMPAT:
+    return new L2v3CompatibilityValidator();
+  case LIBSBML_CAT_SBML_L2V4_COMPAT:
+    return new L2v4CompatibilityValidator();
+  case LIBSBML_CAT_SBML_L3V1_COMPAT:
+    return new L3v1CompatibilityValidator();
+  case LIBSBML_CAT_SBML_L3V2_COMPAT:
+    return new L3v2CompatibilityValidator();
+  default:
+    return NULL;
+  }
+}
+
+
+/*
+ * Returns the name of the class of the validators of the given category.
+ */
+const char*
+ValidatorCache::getName (SBMLErrorCategory_t category)
+{
+  switch (category)
+  {
+  case LIBSBML_CAT_IDENTIFIER_CONSISTENCY:
+    return "IdentifierConsistencyValidator";
+  case LIBSBML_CAT_GENERAL_CONSISTENCY:
+    return "ConsistencyValidator";
+  case LIBSBML_CAT_SBO_CONSISTENCY:
+    return "SBOConsistencyValidator";
+  case LIBSBML_CAT_MATHML_CONSISTENCY:
+    return "MathMLConsistencyValidator";
+  case LIBSBML_CAT_UNITS_CONSISTENCY:
+    return "UnitConsistencyValidator";
+  case LIBSBML_CAT_OVERDETERMINED_MODEL:
+    return "OverdeterminedValidator";
+  case LIBSBML_CAT_MODELING_PRACTICE:
+    return "ModelingPracticeValidator";
+  case LIBSBML_CAT_INTERNAL_CONSISTENCY:
+    return "InternalConsistencyValidator";
+  case LIBSBML_CAT_SBML_L1_COMPAT:
+    return "L1CompatibilityValidator";
+  case LIBSBML_CAT_SBML_L2V1_COMPAT:
+    return "L2v1CompatibilityValidator";
+  case LIBSBML_CAT_SBML_L2V2_COMPAT:
+    return "L2v2CompatibilityValidator";
+  case LIBSBML_CAT_SBML_L2V3_COMPAT:
+    return "L2v3CompatibilityValidator";
+  case LIBSBML_CAT_SBML_L2V4_COMPAT:
+    return "L2v4CompatibilityValidator";
+  case LIBSBML_CAT_SBML_L3V1_COMPAT:
+    return "L3v1CompatibilityValidator";
+  case LIBSBML_CAT_SBML_L3V2_COMPAT:
+    return "L3v2CompatibilityValidator";
+  default:
+    return "";
+  }
+}
+
+
+/*
+ * Returns an initialized validator for the given category, taken from the
+ * cache if one is free and created otherwise.
+ */
+Validator*
+ValidatorCache::acquire (SBMLErrorCategory_t category)
+{
+  ValidatorCacheStore& store = getStore();
+
+  {
+#ifdef LIBSBML_USE_THREADS
+    std::lock_guard<std::mutex> lock(store.mutex);
+#endif
+    vector<Validator*>& idle = store.idle[category];
+    if (!idle.empty())
+    {
+      Validator* validator = idle.back();
+      idle.pop_back();
+      return validator;
+    }
+  }
+
+  // created outside the lock, so that threads starting together do not
+  // wait for each other
+  Validator* validator = createValidator(category);
+  if (validator == NULL) return NULL;
+
+  try
+  {
+    validator->init();
+  }
+  catch (...)
+  {
+    delete validator;
+    throw;
+  }
+
+  return validator;
+}
+
+
+/*
+ * Resets the given validator and keeps it for the next caller.
+ */
+void
+ValidatorCache::release (SBMLErrorCategory_t category, Validator* validator)
+{
+  if (validator == NULL) return;
+
+  validator->reset();
+  validator->setProfile(NULL, "");
+
+  ValidatorCacheStore& store = getStore();
+#ifdef LIBSBML_USE_THREADS
+  std::lock_guard<std::mutex> lock(store.mutex);
+#endif
+  store.idle[category].push_back(validator);
+}
+
+
+/*
+ * Deletes all the validators kept that are not in use.
+ */
+void
+ValidatorCache::clear ()
+{
+  ValidatorCacheStore& store = getStore();
+#ifdef LIBSBML_USE_THREADS
+  std::lock_guard<std::mutex> lock(store.mutex);
+#endif
+  store.deleteIdle();
+}
+
+
+CachedValidator::CachedValidator (SBMLErrorCategory_t category,
+                                  ValidatorProfile* profile) :
+    mCategory ( category )
+  , mProfile  ( profile  )
+  , mValidator( NULL     )
+{
+}
+
+
+/*
+ * Gives the validator, if one was acquired, back to the cache.
+ */
+CachedValidator::~CachedValidator ()
+{
+  try
+  {
+    ValidatorCache::release(mCategory, mValidator);
+  }
+  catch (...)
+  {
+    delete mValidator;
+  }
+}
+
+
+/*
+ * Returns the validator, acquiring it first if need be.
+ */
+Validator&
+CachedValidator::get ()
+{
+  if (mValidator == NULL)
+  {
+    mValidator = ValidatorCache::acquire(mCategory);
+    if (mValidator != NULL && mProfile != NULL)
+    {
+      mValidator->setProfile(mProfile, ValidatorCache::getName(mCategory));
+    }
+  }
+
+  return *mValidator;
+}
+
+
+/*
+ * Returns the category of the validator.
+ */
+SBMLErrorCategory_t
+CachedValidator::getCategory () const
+{
+  return mCategory;
+}
+
+LIBSBML_CPP_NAMESPACE_END
+
+/** @endcond */
@@ -0,0 +1,126 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ValidatorCache.h
+ * @brief   Keeps initialized validators for reuse across documents
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#ifndef ValidatorCache_h
+#define ValidatorCache_h
+
+
+#ifdef __cplusplus
+
+
+#include <sbml/common/extern.h>
+#include <sbml/SBMLError.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class Validator;
+class ValidatorProfile;
+
+/*
+ * Validator::init() creates several hundred constraints, which for a small
+ * model takes longer than checking them.  The ValidatorCache keeps the
+ * validators used by SBMLInternalValidator once they have been initialized,
+ * and hands them out again, reset, for the next document.
+ *
+ * A constraint remembers things from the document it is checking, so a
+ * validator can only check one document at a time.  The cache is shared by
+ * all threads: each caller gets a validator nobody else is using, and a
+ * new one is only created when all those of its category are in use.
+ */
+class ValidatorCache
+{
+public:
+
+  /*
+   * Returns an initialized validator for the given category, which the
+   * caller has to itself until it is given back with release().  Returns
+   * NULL for a category the cache does not cover.
+   */
+  static Validator* acquire (SBMLErrorCategory_t category);
+
+
+  /*
+   * Resets the given validator, which acquire() returned for the given
+   * category, and keeps it for the next caller.  (The category is passed
+   * in as the ModelingPracticeValidator reports another one.)
+   */
+  static void release (SBMLErrorCategory_t category, Validator* validator);
+
+
+  /*
+   * Deletes all the validators kept that are not in use.
+   */
+  static void clear ();
+
+
+  /*
+   * Returns the name of the class of the validators of the given category,
+   * under which they are recorded in a ValidatorProfile.
+   */
+  static const char* getName (SBMLErrorCategory_t category);
+};
+
+
+/*
+ * Holds a validator from the cache for as long as it is in scope.  The
+ * validator is only acquired when it is first asked for, so one that is
+ * never used costs nothing.
+ */
+class CachedValidator
+{
+public:
+
+  /*
+   * The validator will record its constraints in the given profile, if
+   * that is not NULL.
+   */
+  explicit CachedValidator (SBMLErrorCategory_t category,
+                            ValidatorProfile* profile = NULL);
+
+  ~CachedValidator ();
+
+  /*
+   * Returns the validator, acquiring it first if need be.
+   */
+  Validator& get ();
+
+  /*
+   * Returns the category of the validator.
+   */
+  SBMLErrorCategory_t getCategory () const;
+
+
+private:
+
+  CachedValidator (const CachedValidator&);
+  CachedValidator& operator= (const CachedValidator&);
+
+  SBMLErrorCategory_t mCategory;
+  ValidatorProfile*   mProfile;
+  Validator*          mValidator;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* ValidatorCache_h */
+/** @endcond */
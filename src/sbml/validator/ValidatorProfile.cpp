@@ -0,0 +1,391 @@
+/**
+ * @file    ValidatorProfile.cpp
+ * @brief   Records how long each validation constraint takes
+ * @author  libSBML Team
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/common/libsbml-config.h>
+#include <sbml/validator/ValidatorProfile.h>
+
+#include <algorithm>
+#include <fstream>
+#include <locale>
+#include <sstream>
+
+#if __cplusplus >= 201103L || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#define LIBSBML_PROFILE_STEADY_CLOCK
+#include <chrono>
+#else
+#include <ctime>
+#endif
+
+#ifdef LIBSBML_USE_THREADS
+#include <mutex>
+#endif
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygenLibsbmlInternal */
+
+#ifdef LIBSBML_USE_THREADS
+#define PROFILE_LOCK \
+  std::lock_guard<std::mutex> lock(*static_cast<std::mutex*>(mMutex))
+#else
+#define PROFILE_LOCK
+#endif
+
+
+/*
+ * The figures of one validator, or of one of its constraints.
+ */
+struct ProfileTotals
+{
+  unsigned int id;
+  unsigned int calls;
+  unsigned int failures;
+  double       time;
+};
+
+
+static bool
+slowerThan (const ProfileTotals& a, const ProfileTotals& b)
+{
+  if (a.time != b.time) return a.time > b.time;
+  return a.id < b.id;
+}
+
+
+static void
+writeString (ostream& out, const string& s)
+{
+  out << '"';
+  for (string::const_iterator it = s.begin(); it != s.end(); ++it)
+  {
+    if (*it == '"' || *it == '\\') out << '\\';
+    out << *it;
+  }
+  out << '"';
+}
+
+
+static void
+writeTotals (ostream& out, const ProfileTotals& totals)
+{
+  out << "\"calls\": "    << totals.calls
+      << ", \"failures\": " << totals.failures
+      << ", \"time\": "     << totals.time;
+}
+
+/** @endcond */
+
+
+ValidatorProfile::ValidatorProfile ()
+  : mMutex ( NULL )
+{
+#ifdef LIBSBML_USE_THREADS
+  mMutex = new std::mutex();
+#endif
+}
+
+
+ValidatorProfile::~ValidatorProfile ()
+{
+#ifdef LIBSBML_USE_THREADS
+  delete static_cast<std::mutex*>(mMutex);
+#endif
+}
+
+
+/*
+ * Removes all the entries of this profile.
+ */
+void
+ValidatorProfile::clear ()
+{
+  PROFILE_LOCK;
+  mEntries.clear();
+  mIndex.clear();
+}
+
+
+/*
+ * @return the number of entries in this profile.
+ */
+unsigned int
+ValidatorProfile::getNumEntries () const
+{
+  PROFILE_LOCK;
+  return (unsigned int)mEntries.size();
+}
+
+
+/*
+ * @return the name of the validator of the nth entry.
+ */
+std::string
+ValidatorProfile::getValidator (unsigned int n) const
+{
+  PROFILE_LOCK;
+  return (n < mEntries.size()) ? mEntries[n].validator : "";
+}
+
+
+/*
+ * @return the id of the constraint of the nth entry.
+ */
+unsigned int
+ValidatorProfile::getConstraintId (unsigned int n) const
+{
+  PROFILE_LOCK;
+  return (n < mEntries.size()) ? mEntries[n].id : 0;
+}
+
+
+/*
+ * @return the number of times the constraint of the nth entry was checked.
+ */
+unsigned int
+ValidatorProfile::getNumCalls (unsigned int n) const
+{
+  PROFILE_LOCK;
+  return (n < mEntries.size()) ? mEntries[n].calls : 0;
+}
+
+
+/*
+ * @return the number of failures logged by the constraint of the nth entry.
+ */
+unsigned int
+ValidatorProfile::getNumFailures (unsigned int n) const
+{
+  PROFILE_LOCK;
+  return (n < mEntries.size()) ? mEntries[n].failures : 0;
+}
+
+
+/*
+ * @return the time, in seconds, spent checking the constraint of the nth
+ * entry.
+ */
+double
+ValidatorProfile::getTime (unsigned int n) const
+{
+  PROFILE_LOCK;
+  return (n < mEntries.size()) ? mEntries[n].time : 0;
+}
+
+
+/*
+ * @return the index of the entry for the given validator and constraint,
+ * or -1.
+ */
+int
+ValidatorProfile::getIndex (const std::string& validator, unsigned int id) const
+{
+  PROFILE_LOCK;
+  IndexMap::const_iterator it = mIndex.find(make_pair(validator, id));
+  return (it != mIndex.end()) ? (int)it->second : -1;
+}
+
+
+/*
+ * @return the number of constraint checks made by the given validator.
+ */
+unsigned int
+ValidatorProfile::getValidatorNumCalls (const std::string& validator) const
+{
+  PROFILE_LOCK;
+  unsigned int calls = 0;
+  for (size_t n = 0; n < mEntries.size(); ++n)
+  {
+    if (mEntries[n].validator == validator) calls += mEntries[n].calls;
+  }
+  return calls;
+}
+
+
+/*
+ * @return the number of failures logged by the given validator.
+ */
+unsigned int
+ValidatorProfile::getValidatorNumFailures (const std::string& validator) const
+{
+  PROFILE_LOCK;
+  unsigned int failures = 0;
+  for (size_t n = 0; n < mEntries.size(); ++n)
+  {
+    if (mEntries[n].validator == validator) failures += mEntries[n].failures;
+  }
+  return failures;
+}
+
+
+/*
+ * @return the time, in seconds, spent in the constraints of the given
+ * validator.
+ */
+double
+ValidatorProfile::getValidatorTime (const std::string& validator) const
+{
+  PROFILE_LOCK;
+  double time = 0;
+  for (size_t n = 0; n < mEntries.size(); ++n)
+  {
+    if (mEntries[n].validator == validator) time += mEntries[n].time;
+  }
+  return time;
+}
+
+
+/*
+ * @return this profile as a JSON object.
+ */
+std::string
+ValidatorProfile::toJSON () const
+{
+  // group the entries by validator, which the index has them sorted by
+  typedef vector< pair<string, vector<ProfileTotals> > > Grouped;
+  Grouped grouped;
+
+  {
+    PROFILE_LOCK;
+    for (IndexMap::const_iterator it = mIndex.begin(); it != mIndex.end(); ++it)
+    {
+      const Entry& entry = mEntries[it->second];
+      if (grouped.empty() || grouped.back().first != entry.validator)
+      {
+        grouped.push_back(make_pair(entry.validator, vector<ProfileTotals>()));
+      }
+
+      ProfileTotals totals;
+      totals.id       = entry.id;
+      totals.calls    = entry.calls;
+      totals.failures = entry.failures;
+      totals.time     = entry.time;
+      grouped.back().second.push_back(totals);
+    }
+  }
+
+  ostringstream out;
+  out.imbue(std::locale::classic());
+  out.precision(9);
+
+  out << "{\n  \"validators\": [";
+  for (Grouped::iterator v = grouped.begin(); v != grouped.end(); ++v)
+  {
+    vector<ProfileTotals>& constraints = v->second;
+    sort(constraints.begin(), constraints.end(), slowerThan);
+
+    ProfileTotals sum = { 0, 0, 0, 0 };
+    for (size_t n = 0; n < constraints.size(); ++n)
+    {
+      sum.calls    += constraints[n].calls;
+      sum.failures += constraints[n].failures;
+      sum.time     += constraints[n].time;
+    }
+
+    out << (v == grouped.begin() ? "\n" : ",\n");
+    out << "    {\n      \"name\": ";
+    writeString(out, v->first);
+    out << ", ";
+    writeTotals(out, sum);
+    out << ",\n      \"constraints\": [";
+
+    for (size_t n = 0; n < constraints.size(); ++n)
+    {
+      out << (n == 0 ? "\n" : ",\n");
+      out << "        { \"id\": " << constraints[n].id << ", ";
+      writeTotals(out, constraints[n]);
+      out << " }";
+    }
+
+    out << "\n      ]\n    }";
+  }
+  out << "\n  ]\n}\n";
+
+  return out.str();
+}
+
+
+/*
+ * Writes this profile as JSON to the given file.
+ */
+bool
+ValidatorProfile::writeJSON (const std::string& filename) const
+{
+  ofstream file(filename.c_str());
+  if (!file) return false;
+
+  file << toJSON();
+  file.close();
+
+  return !file.fail();
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Adds one check of the given constraint of the given validator.
+ */
+void
+ValidatorProfile::record (const std::string& validator, unsigned int id,
+                          double seconds, unsigned int failures)
+{
+  PROFILE_LOCK;
+
+  pair<IndexMap::iterator, bool> inserted =
+    mIndex.insert(make_pair(make_pair(validator, id), mEntries.size()));
+
+  if (inserted.second)
+  {
+    Entry entry;
+    entry.validator = validator;
+    entry.id        = id;
+    entry.calls     = 0;
+    entry.failures  = 0;
+    entry.time      = 0;
+    mEntries.push_back(entry);
+  }
+
+  Entry& entry = mEntries[inserted.first->second];
+  entry.calls++;
+  entry.failures += failures;
+  entry.time     += seconds;
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * @return the current time in seconds, for timing constraint checks.
+ */
+double
+ValidatorProfile::now ()
+{
+#ifdef LIBSBML_PROFILE_STEADY_CLOCK
+  return std::chrono::duration<double>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+#else
+  return (double)std::clock() / CLOCKS_PER_SEC;
+#endif
+}
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_END
@@ -0,0 +1,270 @@
+/**
+ * @file    ValidatorProfile.h
+ * @brief   Records how long each validation constraint takes
+ * @author  libSBML Team
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class ValidatorProfile
+ * @sbmlbrief{core} Time spent in each validation constraint.
+ *
+ * @htmlinclude not-sbml-warning.html
+ *
+ * A ValidatorProfile collects, for every constraint run by
+ * SBMLDocument::checkConsistency() and the related methods, how many times
+ * the constraint was checked, how long the checks took in total and how
+ * many failures they logged.  It is attached to a document with
+ * SBMLDocument::setValidationProfile(); while it is attached, every
+ * validator run on the document, including those of SBML Level&nbsp;3
+ * packages, adds to it.  The same profile may be attached to several
+ * documents to add up the figures for all of them.
+ *
+ * Each entry of the profile is identified by the name of the validator
+ * (such as "UnitConsistencyValidator") and the id of the constraint, which
+ * is the number of the error the constraint logs.  The entries can be read
+ * one by one, in the order the constraints were first checked, or all at
+ * once as JSON with toJSON().  A constraint that is slow on a given set of models can then
+ * be turned off, where its category allows, with
+ * SBMLDocument::setConsistencyChecks().
+ *
+ * Checking the time of every constraint costs time itself, so the figures
+ * are only collected while a profile is attached.
+ */
+
+#ifndef ValidatorProfile_h
+#define ValidatorProfile_h
+
+
+#include <sbml/common/extern.h>
+
+
+#ifdef __cplusplus
+
+
+/** @cond doxygenLibsbmlInternal */
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSBML_EXTERN ValidatorProfile
+{
+public:
+
+  /**
+   * Creates a new, empty ValidatorProfile.
+   */
+  ValidatorProfile ();
+
+
+  /**
+   * Destroys this ValidatorProfile.
+   */
+  virtual ~ValidatorProfile ();
+
+
+  /**
+   * Removes all the entries of this profile.
+   */
+  void clear ();
+
+
+  /**
+   * Returns the number of entries in this profile, one for each constraint
+   * of each validator that has been checked at least once.
+   *
+   * @return the number of entries.
+   */
+  unsigned int getNumEntries () const;
+
+
+  /**
+   * Returns the name of the validator of the <em>n</em>th entry.
+   *
+   * @param n the index of the entry.
+   *
+   * @return the name of the validator, or an empty string if @p n is out
+   * of range.
+   */
+  std::string getValidator (unsigned int n) const;
+
+
+  /**
+   * Returns the id of the constraint of the <em>n</em>th entry.
+   *
+   * @param n the index of the entry.
+   *
+   * @return the constraint id, or @c 0 if @p n is out of range.
+   */
+  unsigned int getConstraintId (unsigned int n) const;
+
+
+  /**
+   * Returns the number of times the constraint of the <em>n</em>th entry
+   * was checked.
+   *
+   * @param n the index of the entry.
+   *
+   * @return the number of checks, or @c 0 if @p n is out of range.
+   */
+  unsigned int getNumCalls (unsigned int n) const;
+
+
+  /**
+   * Returns the number of failures logged by the constraint of the
+   * <em>n</em>th entry.
+   *
+   * @param n the index of the entry.
+   *
+   * @return the number of failures, or @c 0 if @p n is out of range.
+   */
+  unsigned int getNumFailures (unsigned int n) const;
+
+
+  /**
+   * Returns the time spent checking the constraint of the <em>n</em>th
+   * entry.
+   *
+   * @param n the index of the entry.
+   *
+   * @return the time in seconds, or @c 0 if @p n is out of range.
+   */
+  double getTime (unsigned int n) const;
+
+
+  /**
+   * Returns the index of the entry for the given validator and constraint.
+   *
+   * @param validator the name of the validator.
+   * @param id the id of the constraint.
+   *
+   * @return the index of the entry, or @c -1 if the constraint has not
+   * been checked by that validator.
+   */
+  int getIndex (const std::string& validator, unsigned int id) const;
+
+
+  /**
+   * Returns the number of constraint checks made by the given validator.
+   *
+   * @param validator the name of the validator.
+   *
+   * @return the number of checks made by all the constraints of the
+   * validator.
+   */
+  unsigned int getValidatorNumCalls (const std::string& validator) const;
+
+
+  /**
+   * Returns the number of failures logged by the given validator.
+   *
+   * @param validator the name of the validator.
+   *
+   * @return the number of failures logged by all the constraints of the
+   * validator.
+   */
+  unsigned int getValidatorNumFailures (const std::string& validator) const;
+
+
+  /**
+   * Returns the time spent in the constraints of the given validator.
+   *
+   * @param validator the name of the validator.
+   *
+   * @return the time in seconds.
+   */
+  double getValidatorTime (const std::string& validator) const;
+
+
+  /**
+   * Returns this profile as a JSON object.
+   *
+   * The object has a single member, "validators", an array with one
+   * object for each validator in the profile.  Each of those gives the
+   * "name" of the validator, its total "calls", "failures" and "time" (in
+   * seconds), and in "constraints" the same figures for each of its
+   * constraints, slowest first.
+   *
+   * @return a string holding the JSON text.
+   */
+  std::string toJSON () const;
+
+
+  /**
+   * Writes this profile as JSON, as returned by toJSON(), to the given
+   * file.
+   *
+   * @param filename the path of the file to write.
+   *
+   * @return @c true if the file was written, @c false otherwise.
+   */
+  bool writeJSON (const std::string& filename) const;
+
+
+  /** @cond doxygenLibsbmlInternal */
+
+  /**
+   * Adds one check of the given constraint of the given validator, which
+   * took the given time and logged the given number of failures.
+   */
+  void record (const std::string& validator, unsigned int id,
+               double seconds, unsigned int failures);
+
+
+  /**
+   * Returns the current time in seconds, measured from an arbitrary
+   * point, for timing constraint checks.
+   */
+  static double now ();
+
+  /** @endcond */
+
+
+private:
+  /** @cond doxygenLibsbmlInternal */
+
+  struct Entry
+  {
+    std::string  validator;
+    unsigned int id;
+    unsigned int calls;
+    unsigned int failures;
+    double       time;
+  };
+
+  typedef std::map<std::pair<std::string, unsigned int>, size_t> IndexMap;
+
+  ValidatorProfile (const ValidatorProfile&);
+  ValidatorProfile& operator= (const ValidatorProfile&);
+
+  std::vector<Entry> mEntries;
+  IndexMap           mIndex;
+
+  /* a std::mutex, when libSBML is built with threads */
+  void*              mMutex;
+
+  /** @endcond */
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* ValidatorProfile_h */
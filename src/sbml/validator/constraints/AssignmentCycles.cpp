@@ -42,6 +42,7 @@
  * ---------------------------------------------------------------------- -->*/
 
 #include <cstring>
+#include <set>
 
 #include <sbml/Model.h>
 #include <sbml/Rule.h>
@@ -91,7 +92,7 @@ AssignmentCycles::check_ (const Model& m, const Model& object)
 
   unsigned int n;
 
-  mIdMap.clear();
+  mGraph.clear();
 
   /* create map of id mapped to id that it refers to that is
    * also the id of a Reaction, AssignmentRule or InitialAssignment
@@ -125,7 +126,6 @@ AssignmentCycles::check_ (const Model& m, const Model& object)
   // check for self assignment
   checkForSelfAssignment(m);
 
-  determineAllDependencies();
   determineCycles(m);
 
   checkForImplicitCompartmentReference(m);
@@ -151,15 +151,15 @@ AssignmentCycles::addInitialAssignmentDependencies(const Model& m,
 
     if (m.getReaction(name))
     {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+      mGraph.addEdge(thisId, name);
     }
     else if (m.getRule(name) && m.getRule(name)->isAssignment())
     {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+      mGraph.addEdge(thisId, name);
     }
     else if (m.getInitialAssignment(name))
     {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+      mGraph.addEdge(thisId, name);
     }
   }
 
@@ -192,15 +192,15 @@ AssignmentCycles::addReactionDependencies(const Model& m, const Reaction& object
 
     if (m.getReaction(name))
     {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+      mGraph.addEdge(thisId, name);
     }
     else if (m.getRule(name) && m.getRule(name)->isAssignment())
     {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+      mGraph.addEdge(thisId, name);
     }
     else if (m.getInitialAssignment(name))
     {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+      mGraph.addEdge(thisId, name);
     }
   }
 
@@ -227,15 +227,15 @@ AssignmentCycles::addRuleDependencies(const Model& m, const Rule& object)
 
     if (m.getReaction(name))
     {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+      mGraph.addEdge(thisId, name);
     }
     else if (m.getRule(name) && m.getRule(name)->isAssignment())
     {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+      mGraph.addEdge(thisId, name);
     }
     else if (m.getInitialAssignment(name))
     {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+      mGraph.addEdge(thisId, name);
     }
   }
 
@@ -243,63 +243,20 @@ AssignmentCycles::addRuleDependencies(const Model& m, const Rule& object)
 }
 
 
-void 
-AssignmentCycles::determineAllDependencies()
-{
-  IdIter iterator;
-  IdIter inner_it;
-  IdRange range;
-
-  /* for each pair in the map (x, y)
-   * retrieve all other pairs where y is first (e.g. (y, s))
-   * and create pairs showing that x depends on these e.g. (x, s)
-   * check whether the pair already exists in the map
-   * and add it if not
-   */
-  for (iterator = mIdMap.begin(); iterator != mIdMap.end(); iterator++)
-  {
-    range = mIdMap.equal_range((*iterator).second);
-    for (inner_it = range.first; inner_it != range.second; inner_it++)
-    {
-      const pair<const std::string, std::string> &depend = 
-            pair<const std::string, std::string>((*iterator).first, (*inner_it).second);
-      if (!alreadyExistsInMap(mIdMap, depend))
-        mIdMap.insert(depend);
-    }
-  }
-}
-
-
-bool 
-AssignmentCycles::alreadyExistsInMap(IdMap map, 
-                                     pair<const std::string, std::string> dependency)
-{
-  bool exists = false;
-
-  IdIter it;
-  
-  for (it = map.begin(); it != map.end(); it++)
-  {
-    if (((*it).first == dependency.first)
-      && ((*it).second == dependency.second))
-      exists = true;
-  }
-
-  return exists;
-}
-
-  
 void 
 AssignmentCycles::checkForSelfAssignment(const Model& m)
 {
-  IdIter the_iterator;
+  vector<unsigned int> nodes = mGraph.getNodesById();
 
-  for (the_iterator = mIdMap.begin();
-    the_iterator != mIdMap.end(); the_iterator++)
+  for (size_t n = 0; n < nodes.size(); n++)
   {
-    if ((*the_iterator).first == (*the_iterator).second)
+    const vector<unsigned int>& edges = mGraph.getEdges(nodes[n]);
+    for (size_t e = 0; e < edges.size(); e++)
     {
-      logMathRefersToSelf(m, (*the_iterator).first);
+      if (edges[e] == nodes[n])
+      {
+        logMathRefersToSelf(m, mGraph.getId(nodes[n]));
+      }
     }
   }
 }
@@ -308,44 +265,32 @@ AssignmentCycles::checkForSelfAssignment(const Model& m)
 void 
 AssignmentCycles::determineCycles(const Model& m)
 {
-  IdIter it;
-  IdRange range;
-  IdList variables;
-  IdMap logged;
-  std::string id;
-  variables.clear();
+  vector<unsigned int> nodes = mGraph.getNodesById();
+  vector<unsigned int> dependencies;
+  set< pair<unsigned int, unsigned int> > logged;
 
-  /* create a list of variables that are cycles ie (x, x) */
-  for (it = mIdMap.begin(); it != mIdMap.end(); it++)
-  {
-    if ((*it).first == (*it).second)
-    {
-      id = (*it).first;
-      if (!variables.contains(id))
-      {
-        variables.append(id);
-      }
-    }
-  }
+  mGraph.findCycles();
 
-  /* loop thru other dependencies for each; if the dependent is also
-   * in the list then this is the cycle
+  /* for each variable that is in a cycle, log each other variable
+   * in a cycle that it depends on
    * keep a record of logged dependencies to avoid logging twice
    */
-   
-  for (unsigned int n = 0; n < variables.size(); n++)
+  for (size_t n = 0; n < nodes.size(); n++)
   {
-    id = variables.at((int)n);
-    range = mIdMap.equal_range(id);
-    for (it = range.first; it != range.second; it++)
+    unsigned int id = nodes[n];
+    if (!mGraph.isInCycle(id)) continue;
+
+    mGraph.getDependencies(id, dependencies);
+    for (size_t d = 0; d < dependencies.size(); d++)
     {
-      if (((*it).second != id)
-        && (variables.contains((*it).second))
-        && !alreadyExistsInMap(logged, pair<const std::string, std::string>(id, (*it).second))
-        && !alreadyExistsInMap(logged, pair<const std::string, std::string>((*it).second, id)))
+      unsigned int id1 = dependencies[d];
+      if (id1 != id
+        && mGraph.isInCycle(id1)
+        && logged.find(make_pair(id, id1)) == logged.end()
+        && logged.find(make_pair(id1, id)) == logged.end())
       {
-        logCycle(m, id, (*it).second);
-        logged.insert(pair<const std::string, std::string>(id, (*it).second));
+        logCycle(m, mGraph.getId(id), mGraph.getId(id1));
+        logged.insert(make_pair(id, id1));
       }
     }
   }
@@ -355,7 +300,7 @@ AssignmentCycles::determineCycles(const Model& m)
 void 
 AssignmentCycles::checkForImplicitCompartmentReference(const Model& m)
 {
-  mIdMap.clear();
+  mGraph.clear();
 
   unsigned int i, ns;
   std::string id;
@@ -374,8 +319,8 @@ AssignmentCycles::checkForImplicitCompartmentReference(const Model& m)
         {
           ASTNode* node = static_cast<ASTNode*>( variables->get(ns) );
           string   name = node->getName() ? node->getName() : "";
-          if (!name.empty() && !alreadyExistsInMap(mIdMap, pair<const std::string, std::string>(id, name)))
-            mIdMap.insert(pair<const std::string, std::string>(id, name));
+          if (!name.empty())
+            mGraph.addEdge(id, name);
         }
         delete variables;
       }
@@ -395,24 +340,28 @@ AssignmentCycles::checkForImplicitCompartmentReference(const Model& m)
         {
           ASTNode* node = static_cast<ASTNode*>( variables->get(ns) );
           string   name = node->getName() ? node->getName() : "";
-          if (!name.empty() && !alreadyExistsInMap(mIdMap, pair<const std::string, std::string>(id, name)))
-            mIdMap.insert(pair<const std::string, std::string>(id, name));
+          if (!name.empty())
+            mGraph.addEdge(id, name);
         }
         delete variables;
       }
     }
   }
 
-  IdIter it;
-  IdRange range;
-
   for (i = 0; i < m.getNumCompartments(); i++)
   {
     std::string id1 = m.getCompartment(i)->getId();
-    range = mIdMap.equal_range(id1);
-    for (it = range.first; it != range.second; it++)
+    int index = mGraph.getIndex(id1);
+    if (index < 0) continue;
+
+    /* each species is only reported once */
+    set<unsigned int> checked;
+    const vector<unsigned int>& edges = mGraph.getEdges((unsigned int)index);
+    for (size_t e = 0; e < edges.size(); e++)
     {
-      const Species *s = m.getSpecies((*it).second);
+      if (!checked.insert(edges[e]).second) continue;
+
+      const Species *s = m.getSpecies(mGraph.getId(edges[e]));
       if (s && s->getCompartment() == id1
         && s->getHasOnlySubstanceUnits() == false)
       {
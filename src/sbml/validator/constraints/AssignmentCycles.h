@@ -50,14 +50,10 @@
 #include <string>
 #include <sbml/validator/VConstraint.h>
 
-#include <sbml/util/IdList.h>
+#include "DependencyGraph.h"
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
-typedef std::multimap<const std::string, std::string> IdMap;
-typedef IdMap::iterator                               IdIter;
-typedef std::pair<IdIter, IdIter>                     IdRange;
-
 class AssignmentCycles: public TConstraint<Model>
 {
 public:
@@ -88,19 +84,11 @@ protected:
   void addRuleDependencies(const Model &, const Rule &);
 
   
-  void determineAllDependencies();
-
-
-  /* helper function to check if a pair already exists */
-  bool alreadyExistsInMap(IdMap map, 
-                          std::pair<const std::string, std::string> dependency);
-
-  
   /* check for explicit use of original variable */
   void checkForSelfAssignment(const Model &);
 
 
-  /* find cycles in the map of dependencies */
+  /* find cycles in the graph of dependencies */
   void determineCycles(const Model& m);
 
 
@@ -142,7 +130,7 @@ protected:
                              const Species* conflict);
 
   
-  IdMap mIdMap;
+  DependencyGraph mGraph;
 
 };
 
@@ -0,0 +1,253 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    DependencyGraph.cpp
+ * @brief   Graph of the ids that depend on each other, for the cycle checks
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include "DependencyGraph.h"
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+#ifdef __cplusplus
+
+static const unsigned int UNVISITED = (unsigned int)(-1);
+
+
+DependencyGraph::DependencyGraph ()
+{
+}
+
+
+/*
+ * Removes all the ids and edges of this graph.
+ */
+void
+DependencyGraph::clear ()
+{
+  mIds.clear();
+  mIndex.clear();
+  mEdges.clear();
+  mInCycle.clear();
+}
+
+
+/*
+ * Records that the id 'from' depends on the id 'to'.
+ */
+void
+DependencyGraph::addEdge (const std::string& from, const std::string& to)
+{
+  unsigned int n = addNode(from);
+  unsigned int m = addNode(to);
+
+  mEdges[n].push_back(m);
+}
+
+
+unsigned int
+DependencyGraph::getNumNodes () const
+{
+  return (unsigned int)mIds.size();
+}
+
+
+const std::string&
+DependencyGraph::getId (unsigned int n) const
+{
+  return mIds[n];
+}
+
+
+int
+DependencyGraph::getIndex (const std::string& id) const
+{
+  map<string, unsigned int>::const_iterator it = mIndex.find(id);
+  return (it != mIndex.end()) ? (int)it->second : -1;
+}
+
+
+const std::vector<unsigned int>&
+DependencyGraph::getEdges (unsigned int n) const
+{
+  return mEdges[n];
+}
+
+
+/*
+ * Returns the numbers of all the ids, sorted by id.
+ */
+std::vector<unsigned int>
+DependencyGraph::getNodesById () const
+{
+  vector<unsigned int> nodes;
+  nodes.reserve(mIds.size());
+
+  for (map<string, unsigned int>::const_iterator it = mIndex.begin();
+       it != mIndex.end(); ++it)
+  {
+    nodes.push_back(it->second);
+  }
+
+  return nodes;
+}
+
+
+/*
+ * Tarjan's algorithm, with an explicit stack so that a long chain of
+ * dependencies cannot overflow the call stack.  An id is in a cycle if
+ * its component has more than one id, or if it depends on itself.
+ */
+void
+DependencyGraph::findCycles ()
+{
+  unsigned int numNodes = getNumNodes();
+
+  vector<unsigned int> index   (numNodes, UNVISITED);
+  vector<unsigned int> lowlink (numNodes, 0);
+  vector<unsigned int> nextEdge(numNodes, 0);
+  vector<bool>         onStack (numNodes, false);
+  vector<unsigned int> stack;
+  vector<unsigned int> path;
+  unsigned int         counter = 0;
+
+  mInCycle.assign(numNodes, false);
+
+  for (unsigned int root = 0; root < numNodes; ++root)
+  {
+    if (index[root] != UNVISITED) continue;
+
+    index[root] = lowlink[root] = counter++;
+    stack.push_back(root);
+    onStack[root] = true;
+    path.push_back(root);
+
+    while (!path.empty())
+    {
+      unsigned int v = path.back();
+
+      if (nextEdge[v] < mEdges[v].size())
+      {
+        unsigned int w = mEdges[v][nextEdge[v]++];
+
+        if (w == v)
+        {
+          mInCycle[v] = true;
+        }
+        else if (index[w] == UNVISITED)
+        {
+          index[w] = lowlink[w] = counter++;
+          stack.push_back(w);
+          onStack[w] = true;
+          path.push_back(w);
+        }
+        else if (onStack[w] && index[w] < lowlink[v])
+        {
+          lowlink[v] = index[w];
+        }
+        continue;
+      }
+
+      path.pop_back();
+      if (!path.empty() && lowlink[v] < lowlink[path.back()])
+      {
+        lowlink[path.back()] = lowlink[v];
+      }
+
+      if (lowlink[v] != index[v]) continue;
+
+      // v is the root of a component, which is the top of the stack
+      size_t start = stack.size() - 1;
+      while (stack[start] != v) --start;
+
+      bool cycle = (stack.size() - start > 1);
+      for (size_t k = start; k < stack.size(); ++k)
+      {
+        onStack[stack[k]] = false;
+        if (cycle) mInCycle[stack[k]] = true;
+      }
+      stack.resize(start);
+    }
+  }
+}
+
+
+bool
+DependencyGraph::isInCycle (unsigned int n) const
+{
+  return n < mInCycle.size() && mInCycle[n];
+}
+
+
+/*
+ * The direct dependencies come first, repeats included, as the messages
+ * logged by the constraints have always listed them that way.
+ */
+void
+DependencyGraph::getDependencies (unsigned int n,
+                                  std::vector<unsigned int>& dependencies) const
+{
+  vector<bool> seen    (mIds.size(), false);
+  vector<bool> expanded(mIds.size(), false);
+
+  dependencies = mEdges[n];
+  for (size_t i = 0; i < dependencies.size(); ++i)
+  {
+    seen[dependencies[i]] = true;
+  }
+
+  for (size_t i = 0; i < dependencies.size(); ++i)
+  {
+    unsigned int d = dependencies[i];
+    if (expanded[d]) continue;
+    expanded[d] = true;
+
+    const vector<unsigned int>& edges = mEdges[d];
+    for (size_t e = 0; e < edges.size(); ++e)
+    {
+      if (!seen[edges[e]])
+      {
+        seen[edges[e]] = true;
+        dependencies.push_back(edges[e]);
+      }
+    }
+  }
+}
+
+
+unsigned int
+DependencyGraph::addNode (const std::string& id)
+{
+  pair<map<string, unsigned int>::iterator, bool> inserted =
+    mIndex.insert(make_pair(id, (unsigned int)mIds.size()));
+
+  if (inserted.second)
+  {
+    mIds.push_back(id);
+    mEdges.push_back(vector<unsigned int>());
+  }
+
+  return inserted.first->second;
+}
+
+#endif /* __cplusplus */
+LIBSBML_CPP_NAMESPACE_END
+/** @endcond */
@@ -0,0 +1,133 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    DependencyGraph.h
+ * @brief   Graph of the ids that depend on each other, for the cycle checks
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#ifndef DependencyGraph_h
+#define DependencyGraph_h
+
+
+#ifdef __cplusplus
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sbml/common/extern.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * The constraints that look for cycles (AssignmentCycles, RateOfCycles,
+ * FunctionDefinitionRecursion) record that one id depends on another as
+ * an edge of this graph.  Each id is numbered once, when it is first
+ * added, and the edges are kept as lists of those numbers, so that the
+ * cycles can be found with a single pass over the graph rather than by
+ * building up every pair of ids that depend on each other.
+ */
+class DependencyGraph
+{
+public:
+
+  DependencyGraph ();
+
+
+  /*
+   * Removes all the ids and edges of this graph.
+   */
+  void clear ();
+
+
+  /*
+   * Records that the id 'from' depends on the id 'to'.  An edge that is
+   * added twice is kept twice.
+   */
+  void addEdge (const std::string& from, const std::string& to);
+
+
+  /*
+   * Returns the number of ids in this graph.
+   */
+  unsigned int getNumNodes () const;
+
+
+  /*
+   * Returns the id numbered n.
+   */
+  const std::string& getId (unsigned int n) const;
+
+
+  /*
+   * Returns the number of the given id, or -1 if it is not in the graph.
+   */
+  int getIndex (const std::string& id) const;
+
+
+  /*
+   * Returns the numbers of the ids the nth id depends on directly, in the
+   * order the edges were added.
+   */
+  const std::vector<unsigned int>& getEdges (unsigned int n) const;
+
+
+  /*
+   * Returns the numbers of all the ids, sorted by id.
+   */
+  std::vector<unsigned int> getNodesById () const;
+
+
+  /*
+   * Finds the strongly connected components of the graph, after which
+   * isInCycle() says which ids depend on themselves.
+   */
+  void findCycles ();
+
+
+  /*
+   * Returns true if the nth id depends, directly or not, on itself.
+   * Only valid after findCycles().
+   */
+  bool isInCycle (unsigned int n) const;
+
+
+  /*
+   * Puts into 'dependencies' the ids the nth id depends on directly, as
+   * returned by getEdges(), followed by those it depends on through them,
+   * each once, in breadth first order.
+   */
+  void getDependencies (unsigned int n,
+                        std::vector<unsigned int>& dependencies) const;
+
+
+private:
+
+  unsigned int addNode (const std::string& id);
+
+  std::vector<std::string>                 mIds;
+  std::map<std::string, unsigned int>      mIndex;
+  std::vector< std::vector<unsigned int> > mEdges;
+  std::vector<bool>                        mInCycle;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* DependencyGraph_h */
+/** @endcond */
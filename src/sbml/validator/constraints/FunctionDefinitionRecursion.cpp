@@ -41,6 +41,8 @@
  * and also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <set>
+
 #include <sbml/Model.h>
 #include <sbml/Rule.h>
 #include <sbml/Event.h>
@@ -80,7 +82,7 @@ FunctionDefinitionRecursion::~FunctionDefinitionRecursion ()
 void
 FunctionDefinitionRecursion::check_ (const Model& m, const Model&)
 {
-  mIdMap.clear();
+  mGraph.clear();
 
   for (unsigned n = 0; n < m.getNumFunctionDefinitions(); ++n)
   { 
@@ -93,7 +95,6 @@ FunctionDefinitionRecursion::check_ (const Model& m, const Model&)
   // check for self assignment
   checkForSelfAssignment(m);
 
-  determineAllDependencies();
   determineCycles(m);
 
 }
@@ -117,71 +118,28 @@ FunctionDefinitionRecursion::addDependencies(const Model& m,
 
     if (m.getFunctionDefinition(name))
     {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+      mGraph.addEdge(thisId, name);
     }
   }
 
   delete variables;
 }
 
-void 
-FunctionDefinitionRecursion::determineAllDependencies()
-{
-  IdIter iterator;
-  IdIter inner_it;
-  IdRange range;
-
-  /* for each pair in the map (x, y)
-   * retrieve all other pairs where y is first (e.g. (y, s))
-   * and create pairs showing that x depends on these e.g. (x, s)
-   * check whether the pair already exists in the map
-   * and add it if not
-   */
-  for (iterator = mIdMap.begin(); iterator != mIdMap.end(); iterator++)
-  {
-    range = mIdMap.equal_range((*iterator).second);
-    for (inner_it = range.first; inner_it != range.second; inner_it++)
-    {
-      const pair<const std::string, std::string> &depend = 
-            pair<const std::string, std::string>((*iterator).first, (*inner_it).second);
-      if (!alreadyExistsInMap(mIdMap, depend))
-        mIdMap.insert(depend);
-    }
-  }
-}
-
-
-bool 
-FunctionDefinitionRecursion::alreadyExistsInMap(IdMap map, 
-                                     pair<const std::string, std::string> dependency)
-{
-  bool exists = false;
-
-  IdIter it;
-  
-  for (it = map.begin(); it != map.end(); it++)
-  {
-    if (((*it).first == dependency.first)
-      && ((*it).second == dependency.second))
-      exists = true;
-  }
-
-  return exists;
-}
-
-  
 void 
 FunctionDefinitionRecursion::checkForSelfAssignment(const Model& m)
 {
-  IdIter the_iterator;
+  vector<unsigned int> nodes = mGraph.getNodesById();
 
-  for (the_iterator = mIdMap.begin();
-    the_iterator != mIdMap.end(); the_iterator++)
+  for (size_t n = 0; n < nodes.size(); n++)
   {
-    if ((*the_iterator).first == (*the_iterator).second)
+    const vector<unsigned int>& edges = mGraph.getEdges(nodes[n]);
+    for (size_t e = 0; e < edges.size(); e++)
     {
-      logSelfRecursion(*(m.getFunctionDefinition((*the_iterator).first)), 
-        (*the_iterator).first);
+      if (edges[e] == nodes[n])
+      {
+        logSelfRecursion(*(m.getFunctionDefinition(mGraph.getId(nodes[n]))), 
+          mGraph.getId(nodes[n]));
+      }
     }
   }
 }
@@ -190,46 +148,33 @@ FunctionDefinitionRecursion::checkForSelfAssignment(const Model& m)
 void 
 FunctionDefinitionRecursion::determineCycles(const Model& m)
 {
-  IdIter it;
-  IdRange range;
-  IdList variables;
-  IdMap logged;
-  std::string id;
-  variables.clear();
-
-  /* create a list of variables that are cycles ie (x, x) */
-  for (it = mIdMap.begin(); it != mIdMap.end(); it++)
-  {
-    if ((*it).first == (*it).second)
-    {
-      id = (*it).first;
-      if (!variables.contains(id))
-      {
-        variables.append(id);
-      }
-    }
-  }
+  vector<unsigned int> nodes = mGraph.getNodesById();
+  vector<unsigned int> dependencies;
+  set< pair<unsigned int, unsigned int> > logged;
+
+  mGraph.findCycles();
 
-  /* loop thru other dependencies for each; if the dependent is also
-   * in the list then this is the cycle
+  /* for each function that is in a cycle, log each other function
+   * in a cycle that it depends on
    * keep a record of logged dependencies to avoid logging twice
    */
-   
-  for (unsigned int n = 0; n < variables.size(); n++)
+  for (size_t n = 0; n < nodes.size(); n++)
   {
-    id = variables.at((int)n);
-    range = mIdMap.equal_range(id);
-    for (it = range.first; it != range.second; it++)
+    unsigned int id = nodes[n];
+    if (!mGraph.isInCycle(id)) continue;
+
+    mGraph.getDependencies(id, dependencies);
+    for (size_t d = 0; d < dependencies.size(); d++)
     {
-      if (((*it).second != id)
-        && (variables.contains((*it).second))
-        && !alreadyExistsInMap(logged, 
-                   pair<const std::string, std::string>(id, (*it).second))
-        && !alreadyExistsInMap(logged, 
-                   pair<const std::string, std::string>((*it).second, id)))
+      unsigned int id1 = dependencies[d];
+      if (id1 != id
+        && mGraph.isInCycle(id1)
+        && logged.find(make_pair(id, id1)) == logged.end()
+        && logged.find(make_pair(id1, id)) == logged.end())
       {
-        logCycle(m.getFunctionDefinition(id), m.getFunctionDefinition((*it).second));
-        logged.insert(pair<const std::string, std::string>(id, (*it).second));
+        logCycle(m.getFunctionDefinition(mGraph.getId(id)), 
+                 m.getFunctionDefinition(mGraph.getId(id1)));
+        logged.insert(make_pair(id, id1));
       }
     }
   }
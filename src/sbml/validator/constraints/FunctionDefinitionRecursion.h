@@ -51,14 +51,10 @@
 
 #include <sbml/validator/VConstraint.h>
 
-#include <sbml/util/IdList.h>
+#include "DependencyGraph.h"
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
-typedef std::multimap<const std::string, std::string> IdMap;
-typedef IdMap::iterator                               IdIter;
-typedef std::pair<IdIter, IdIter>                     IdRange;
-
 class FunctionDefinitionRecursion: public TConstraint<Model>
 {
 public:
@@ -86,19 +82,11 @@ protected:
   void addDependencies(const Model &, const FunctionDefinition &);
 
   
-  void determineAllDependencies();
-
-
-  /* helper function to check if a pair already exists */
-  bool alreadyExistsInMap(IdMap map, 
-                          std::pair<const std::string, std::string> dependency);
-
-  
   /* check for explicit use of original variable */
   void checkForSelfAssignment(const Model &);
 
 
-  /* find cycles in the map of dependencies */
+  /* find cycles in the graph of dependencies */
   void determineCycles(const Model& m);
 
   /**
@@ -111,7 +99,7 @@ protected:
   void logCycle (const FunctionDefinition* object, const FunctionDefinition* conflict);
 
 
-  IdMap mIdMap;
+  DependencyGraph mGraph;
 
 };
 
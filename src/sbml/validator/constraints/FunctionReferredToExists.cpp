@@ -74,6 +74,16 @@ FunctionReferredToExists::~FunctionReferredToExists ()
 }
 
 
+/*
+ * Clears the identifiers collected from the last document checked.
+ */
+void
+FunctionReferredToExists::reset ()
+{
+  mFunctions.clear();
+}
+
+
 /*
  * Checks that all ids on the following Model objects are unique:
  * event assignments and assignment rules.
@@ -173,7 +173,9 @@ START_CONSTRAINT (91008, SpeciesReference, sr)
           if (!math->isInteger() && !math->isRational())
           {
             // do a last minute check on whether the math will evaluate to an integer
-            double value = SBMLTransforms::evaluateASTNode(math, &m);
+            SBMLTransforms::IdValueMap values;
+            SBMLTransforms::getComponentValuesForModel(&m, values);
+            double value = SBMLTransforms::evaluateASTNode(math, values, &m);
             if (!util_isNaN(value))
             {
               if (!util_isEqual(value, floor(value)))
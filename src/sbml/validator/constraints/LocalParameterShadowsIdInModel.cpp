@@ -73,6 +73,16 @@ LocalParameterShadowsIdInModel::~LocalParameterShadowsIdInModel ()
 }
 
 
+/*
+ * Clears the identifiers collected from the last document checked.
+ */
+void
+LocalParameterShadowsIdInModel::reset ()
+{
+  mAll.clear();
+}
+
+
 /*
   * Checks that any species with boundary condition false
   * is not set by reaction and rules
@@ -69,6 +69,11 @@ public:
    */
   virtual ~LocalParameterShadowsIdInModel ();
 
+  /**
+   * Clears the identifiers collected from the last document checked.
+   */
+  virtual void reset ();
+
 
 protected:
 
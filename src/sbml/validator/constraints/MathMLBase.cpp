@@ -76,6 +76,34 @@ MathMLBase::~MathMLBase ()
 }
 
 
+/*
+ * Clears the identifiers and the equation matching kept from the last
+ * document checked.
+ */
+void
+MathMLBase::reset ()
+{
+  mLocalParameters.clear();
+  mNumericFunctionsChecked.clear();
+  mFunctionsChecked.clear();
+
+  delete mEqnMatch;
+  mEqnMatch = NULL;
+  mEqnMatchingRun = false;
+}
+
+
+/*
+ * @return true: the math of each object is checked on its own, unless
+ * the validator leaves the object out.
+ */
+bool
+MathMLBase::checksSingleObjects () const
+{
+  return true;
+}
+
+
 /*
  * @return the fieldname to use logging constraint violations.  If not
  * overridden, "math" is returned.
@@ -129,7 +157,7 @@ MathMLBase::check_ (const Model& m, const Model& object)
   {
     if (m.getRule(n)->isSetMath())
     {
-      checkMath(m, *m.getRule(n)->getMath(), *m.getRule(n));
+      checkMathOf(m, *m.getRule(n)->getMath(), *m.getRule(n));
     }
   }
 
@@ -140,7 +168,7 @@ MathMLBase::check_ (const Model& m, const Model& object)
       if (m.getReaction(n)->getKineticLaw()->isSetMath())
       {
         mKLCount = n;
-        checkMath(m, *m.getReaction(n)->getKineticLaw()->getMath(), 
+        checkMathOf(m, *m.getReaction(n)->getKineticLaw()->getMath(), 
           *m.getReaction(n)->getKineticLaw());
       }
     }
@@ -150,7 +178,7 @@ MathMLBase::check_ (const Model& m, const Model& object)
       {
         const StoichiometryMath* smm = m.getReaction(n)->getProduct(sr)->getStoichiometryMath();
         if (smm->isSetMath())
-          checkMath(m, *smm->getMath(), *m.getReaction(n)->getProduct(sr));
+          checkMathOf(m, *smm->getMath(), *m.getReaction(n)->getProduct(sr));
       }
     }
     for (sr = 0; sr < m.getReaction(n)->getNumReactants(); sr++)
@@ -159,7 +187,7 @@ MathMLBase::check_ (const Model& m, const Model& object)
       {
         const StoichiometryMath* smm = m.getReaction(n)->getReactant(sr)->getStoichiometryMath();
         if (smm->isSetMath())
-          checkMath(m, *smm->getMath(), *m.getReaction(n)->getReactant(sr));
+          checkMathOf(m, *smm->getMath(), *m.getReaction(n)->getReactant(sr));
       }
     }
   }
@@ -172,7 +200,7 @@ MathMLBase::check_ (const Model& m, const Model& object)
       if (m.getEvent(n)->getTrigger()->isSetMath())
       {
         mIsTrigger = 1;
-        checkMath(m, *m.getEvent(n)->getTrigger()->getMath(), 
+        checkMathOf(m, *m.getEvent(n)->getTrigger()->getMath(), 
                                                *m.getEvent(n));
       }
     }
@@ -181,7 +209,7 @@ MathMLBase::check_ (const Model& m, const Model& object)
       if (m.getEvent(n)->getDelay()->isSetMath())
       {
         mIsTrigger = 0;
-        checkMath(m, *m.getEvent(n)->getDelay()->getMath(), 
+        checkMathOf(m, *m.getEvent(n)->getDelay()->getMath(), 
                                             *m.getEvent(n));
       }
     }
@@ -190,7 +218,7 @@ MathMLBase::check_ (const Model& m, const Model& object)
       if (m.getEvent(n)->getPriority()->isSetMath())
       {
         mIsTrigger = 0;
-        checkMath(m, *m.getEvent(n)->getPriority()->getMath(), 
+        checkMathOf(m, *m.getEvent(n)->getPriority()->getMath(), 
                                             *m.getEvent(n));
       }
     }
@@ -198,7 +226,7 @@ MathMLBase::check_ (const Model& m, const Model& object)
     {
       if (m.getEvent(n)->getEventAssignment(ea)->isSetMath())
       {
-        checkMath(m, *m.getEvent(n)->getEventAssignment(ea)->getMath(), 
+        checkMathOf(m, *m.getEvent(n)->getEventAssignment(ea)->getMath(), 
           *m.getEvent(n)->getEventAssignment(ea));
       }
     }
@@ -208,7 +236,7 @@ MathMLBase::check_ (const Model& m, const Model& object)
   {
     if (m.getInitialAssignment(n)->isSetMath())
     {
-      checkMath(m, *m.getInitialAssignment(n)->getMath(), *m.getInitialAssignment(n));
+      checkMathOf(m, *m.getInitialAssignment(n)->getMath(), *m.getInitialAssignment(n));
     }
   }
 
@@ -216,12 +244,27 @@ MathMLBase::check_ (const Model& m, const Model& object)
   {
     if (m.getConstraint(n)->isSetMath())
     {
-      checkMath(m, *m.getConstraint(n)->getMath(), *m.getConstraint(n));
+      checkMathOf(m, *m.getConstraint(n)->getMath(), *m.getConstraint(n));
     }
   }
 }
 
 
+/*
+ * Calls checkMath() for the math of the given object, unless the validator
+ * leaves the object out.
+ */
+void
+MathMLBase::checkMathOf (const Model& m, const ASTNode& node, const SBase & sb)
+{
+  if (!mValidator.isToBeChecked(sb)) return;
+
+  mValidator.setCheckedObject(&sb);
+  checkMath(m, node, sb);
+  mValidator.setCheckedObject(NULL);
+}
+
+
 /*
   * Checks the MathML of the children of ASTnode 
   * forces recursion through the AST tree
@@ -80,6 +80,17 @@ public:
    */
   virtual ~MathMLBase ();
 
+  /**
+   * Clears the identifiers and the equation matching kept from the last
+   * document checked.
+   */
+  virtual void reset ();
+
+  /**
+   * Returns true: the math of each object is checked on its own.
+   */
+  virtual bool checksSingleObjects () const;
+
 
 protected:
 
@@ -96,6 +107,12 @@ protected:
    */
   virtual void checkMath (const Model& m, const ASTNode& node, const SBase & sb) = 0;
  
+  /**
+   * Calls checkMath() for the math of the given object, unless the validator
+   * leaves the object out; the failures logged are put down to it.
+   */
+  void checkMathOf (const Model& m, const ASTNode& node, const SBase & sb);
+
   /**
    * Checks the MathML of the children of ASTnode 
    * forces recursion through the AST tree
@@ -49,7 +49,8 @@
 #include "OverDeterminedCheck.h"
 
 #include <iostream>
-#include <cstring>
+#include <sstream>
+#include <set>
 
 /** @cond doxygenIgnored */
 using namespace std;
@@ -153,27 +154,70 @@ OverDeterminedCheck::logOverDetermined (const Model& m)
   logFailure(m);
 }
 
+/* marks an equation or variable that is not matched */
+static const unsigned int NO_MATCH = (unsigned int)(-1);
+
+
 EquationMatching::EquationMatching()
+  : mNumVariables(0)
 {
 }
 
 EquationMatching::~EquationMatching ()
 {
-  mEquations.clear(); // list of equation vertexes
-  mVariables.clear(); // list of variable vertexes
-  mGraph.clear();
+}
 
-  /* these are to enable the bipartite matching without passing variables */
-  mMatching.clear();
-  mVarNeighInPrev.clear();
-  mEqnNeighInPrev.clear();
 
-  revisited.clear();
-  visited.clear();
+void
+EquationMatching::addEquation(const std::string& eq)
+{
+  mEquations.push_back(eq);
+  mGraph.push_back(std::vector<unsigned int>());
+}
+
 
+/*
+ * a variable id that is written twice (such as the empty id of two
+ * species references) is the one vertex, as it was when vertexes were
+ * looked up by id
+ */
+void
+EquationMatching::addVariable(const std::string& var)
+{
+  mNumVariables++;
+
+  if (mVariableIndex.find(var) == mVariableIndex.end())
+  {
+    mVariableIndex[var] = (unsigned int)mVariables.size();
+    mVariables.push_back(var);
+  }
 }
 
 
+/*
+ * adds an edge from the equation to every variable named in the math
+ */
+void
+EquationMatching::addEdges(unsigned int eq, const ASTNode* math)
+{
+  List * names = math->getListOfNodes( ASTNode_isName );
+
+  for (unsigned int n = 0; n < names->getSize(); n++)
+  {
+    const ASTNode* node = static_cast<ASTNode*>( names->get(n) );
+    std::string name = node->getName() ? node->getName() : "";
+
+    std::map<std::string, unsigned int>::const_iterator it
+      = mVariableIndex.find(name);
+    if (it != mVariableIndex.end())
+    {
+      mGraph[eq].push_back(it->second);
+    }
+  }
+
+  delete names;
+}
+
 
 /* 
  * creates equation vertexes according to the L2V2 spec 4.11.5 for every
@@ -190,6 +234,7 @@ EquationMatching::writeEquationVertexes(const Model& m)
   const Species* s;
   string rule;
   string react;
+  std::set<std::string> speciesAdded;
 
   unsigned int n, sr;
 
@@ -206,20 +251,20 @@ EquationMatching::writeEquationVertexes(const Model& m)
       for (sr = 0; sr < r->getNumReactants(); sr++)
       {
         s = m.getSpecies(r->getReactant(sr)->getSpecies());
-        if (!s->getBoundaryCondition() && !s->getConstant())
+        if (s != NULL && !s->getBoundaryCondition() && !s->getConstant())
         {
-          if (!mEquations.contains(s->getId()))
-            mEquations.append(s->getId());
+          if (speciesAdded.insert(s->getId()).second)
+            addEquation(s->getId());
         }
       }
 
       for (sr = 0; sr < r->getNumProducts(); sr++)
       {
         s = m.getSpecies(r->getProduct(sr)->getSpecies());
-        if (!s->getBoundaryCondition() && !s->getConstant())
+        if (s != NULL && !s->getBoundaryCondition() && !s->getConstant())
         {
-          if (!mEquations.contains(s->getId()))
-            mEquations.append(s->getId());
+          if (speciesAdded.insert(s->getId()).second)
+            addEquation(s->getId());
         }
       }
     }
@@ -229,7 +274,7 @@ EquationMatching::writeEquationVertexes(const Model& m)
   for (n = 0; n < m.getNumRules(); n++)
   {
     SET_NAME(rule, "rule_", n);
-    mEquations.append(rule);
+    addEquation(rule);
   }
 
   /* a Kinetic Law structure */
@@ -238,7 +283,7 @@ EquationMatching::writeEquationVertexes(const Model& m)
     if (m.getReaction(n)->isSetKineticLaw())
     {
         SET_NAME(react, "KL_", n);
-        mEquations.append(react);
+        addEquation(react);
     }
   }
 }
@@ -259,11 +304,11 @@ EquationMatching::writeVariableVertexes(const Model& m)
   {
     if (!m.getCompartment(n)->getConstant())
     {
-      mVariables.append(m.getCompartment(n)->getId());
+      addVariable(m.getCompartment(n)->getId());
     }
     else if (m.getLevel() == 1)
     {
-      mVariables.append(m.getCompartment(n)->getId());
+      addVariable(m.getCompartment(n)->getId());
     }
   }
 
@@ -271,11 +316,11 @@ EquationMatching::writeVariableVertexes(const Model& m)
   {
     if (!m.getSpecies(n)->getConstant())
     {
-      mVariables.append(m.getSpecies(n)->getId());
+      addVariable(m.getSpecies(n)->getId());
     }
     else if (m.getLevel() == 1)
     {
-      mVariables.append(m.getSpecies(n)->getId());
+      addVariable(m.getSpecies(n)->getId());
     }
   }
 
@@ -283,11 +328,11 @@ EquationMatching::writeVariableVertexes(const Model& m)
   {
     if (!m.getParameter(n)->getConstant())
     {
-      mVariables.append(m.getParameter(n)->getId());
+      addVariable(m.getParameter(n)->getId());
     }
     else if (m.getLevel() == 1)
     {
-      mVariables.append(m.getParameter(n)->getId());
+      addVariable(m.getParameter(n)->getId());
     }
   }
 
@@ -295,7 +340,7 @@ EquationMatching::writeVariableVertexes(const Model& m)
   {
     if (m.getReaction(n)->isSetKineticLaw())
     {
-      mVariables.append(m.getReaction(n)->getId());
+      addVariable(m.getReaction(n)->getId());
     }
     if (m.getLevel() > 2)
     {
@@ -307,14 +352,14 @@ EquationMatching::writeVariableVertexes(const Model& m)
       {
         if (m.getReaction(n)->getReactant(k)->getConstant() == false )
         {
-          mVariables.append(m.getReaction(n)->getReactant(k)->getId());
+          addVariable(m.getReaction(n)->getReactant(k)->getId());
         }
       }
       for (k = 0; k < m.getReaction(n)->getNumProducts(); k++)
       {
         if (m.getReaction(n)->getProduct(k)->getConstant() == false )
         {
-          mVariables.append(m.getReaction(n)->getProduct(k)->getId());
+          addVariable(m.getReaction(n)->getProduct(k)->getId());
         }
       }
     }
@@ -324,34 +369,26 @@ EquationMatching::writeVariableVertexes(const Model& m)
 unsigned int 
 EquationMatching::getNumEquations()
 {
-  return mEquations.size();
+  return (unsigned int)mEquations.size();
 }
 unsigned int 
 EquationMatching::getNumVariables()
 {
-  return mVariables.size();
+  return mNumVariables;
 }
 /*
  * creates a bipartite graph according to the L2V2 spec 4.11.5 
  * creates edges between the equation vertexes and the variable vertexes
- * graph produced is an id representimg the equation and an IdList
- * listing the edges the equation vertex is connected to
+ * the edges of each equation vertex are the indexes of the variable
+ * vertexes it is connected to
  */
 void
 EquationMatching::createGraph(const Model& m)
 {
-  IdList joined;
-  IdList speciesAdded;
-  unsigned int n, sr;
-  const Reaction *r;
-  const Species *s;
-  const char * sId;
+  unsigned int n;
   const Rule *rule;
-  const ASTNode *math;
   const KineticLaw * kl;
-  List * names;
-  ASTNode * node;
-  string name;
+  std::map<std::string, unsigned int>::const_iterator it;
 
   /* create a list of ids relating to
    * 1. species
@@ -370,6 +407,15 @@ EquationMatching::createGraph(const Model& m)
 
   /* create the edges for the graph */
 
+  unsigned int numKineticLaws = 0;
+  for (n = 0; n < m.getNumReactions(); n++)
+  {
+    if (m.getReaction(n)->isSetKineticLaw()) numKineticLaws++;
+  }
+
+  const unsigned int numSpeciesEqns =
+    (unsigned int)mEquations.size() - m.getNumRules() - numKineticLaws;
+
   /*
    * a Species structure that has the boundaryCondition field set to false 
    * and constant field set to false and which is referenced by the reactant 
@@ -377,53 +423,13 @@ EquationMatching::createGraph(const Model& m)
    * The edge connects the vertex representing the species 
    *    to the vertex representing the species' equation
    */
-
-  speciesAdded.clear();
   unsigned int eqnCount = 0;
-  for (n = 0; n < m.getNumReactions(); n++)
+  for (; eqnCount < numSpeciesEqns; eqnCount++)
   {
-    if (m.getReaction(n)->isSetKineticLaw())
+    it = mVariableIndex.find(mEquations[eqnCount]);
+    if (it != mVariableIndex.end())
     {
-      r = m.getReaction(n);
-      for (sr = 0; sr < r->getNumReactants(); sr++)
-      {
-        s = m.getSpecies(r->getReactant(sr)->getSpecies());
-        sId = s->getId().c_str();
-
-        if (mEquations.contains(sId) 
-          && mVariables.contains(sId)
-          && !speciesAdded.contains(sId))
-        {
-          joined.append(sId);
-          speciesAdded.append(sId);
-        }
-        if (joined.size() > 0)
-        {
-          mGraph[mEquations.at((int)eqnCount)] = joined;
-          joined.clear();
-          eqnCount++;
-        }
-      }
-
-      for (sr = 0; sr < r->getNumProducts(); sr++)
-      {
-        s = m.getSpecies(r->getProduct(sr)->getSpecies());
-        sId = s->getId().c_str();
-
-        if (mEquations.contains(sId) 
-          && mVariables.contains(sId)
-          && !speciesAdded.contains(sId))
-        {
-          joined.append(sId);
-          speciesAdded.append(sId);
-        }
-        if (joined.size() > 0)
-        {
-          mGraph[mEquations.at((int)eqnCount)] = joined;
-          joined.clear();
-          eqnCount++;
-        }
-      }
+      mGraph[eqnCount].push_back(it->second);
     }
   }
 
@@ -439,9 +445,10 @@ EquationMatching::createGraph(const Model& m)
      */
     if (rule->isAssignment() || rule->isRate())
     {
-      if (mVariables.contains(rule->getVariable()))
+      it = mVariableIndex.find(rule->getVariable());
+      if (it != mVariableIndex.end())
       {
-        joined.append(rule->getVariable());
+        mGraph[eqnCount].push_back(it->second);
       }
     }
 
@@ -456,25 +463,9 @@ EquationMatching::createGraph(const Model& m)
      */
     if (rule->isSetMath())
     {
-      math = rule->getMath();
-      names = math->getListOfNodes( ASTNode_isName );
-
-      for (sr = 0; sr < names->getSize(); sr++)
-      {
-        node = static_cast<ASTNode*>( names->get(sr) );
-        name = node->getName() ? node->getName() : "";
-        if (mVariables.contains(name))
-        {
-          joined.append(name);
-        }
-      }
-
-      delete names;
-
+      addEdges(eqnCount, rule->getMath());
     }
 
-    mGraph[mEquations.at((int)eqnCount)] = joined;
-    joined.clear();
     eqnCount++;
   }
 
@@ -489,9 +480,10 @@ EquationMatching::createGraph(const Model& m)
        * to the variable vertex representing the Reaction containing the 
        * KineticLaw.
        */
-      if (mVariables.contains(m.getReaction(n)->getId()))
+      it = mVariableIndex.find(m.getReaction(n)->getId());
+      if (it != mVariableIndex.end())
       {
-        joined.append(m.getReaction(n)->getId());
+        mGraph[eqnCount].push_back(it->second);
       }
 
       /*
@@ -507,34 +499,16 @@ EquationMatching::createGraph(const Model& m)
 
       if (kl->isSetMath())
       {
-        math = kl->getMath();
-        names = math->getListOfNodes( ASTNode_isName );
-
-        for (sr = 0; sr < names->getSize(); sr++)
-        {
-          node = static_cast<ASTNode*>( names->get(sr) );
-          name = node->getName() ? node->getName() : "";
-          if (mVariables.contains(name))
-          {
-            joined.append(name);
-          }
-        }
-
-  delete names;
-  
+        addEdges(eqnCount, kl->getMath());
       }
-      mGraph[mEquations.at((int)eqnCount)] = joined;
-      joined.clear();
+
       eqnCount++;
     }
   }
 }
 
 /*
- * finds a maximal matching of the bipartite graph
- * adapted from the only implementation I could find:
- * # Hopcroft-Karp bipartite max-cardinality mMatching and max independent set
- * # David Eppstein, UC Irvine, 27 Apr 2002 - Python Cookbook
+ * finds a maximum matching of the bipartite graph (Hopcroft-Karp)
  *
  * returns an IdList of any equation vertexes that are unconnected 
  * in the maximal matching
@@ -542,238 +516,174 @@ EquationMatching::createGraph(const Model& m)
 IdList 
 EquationMatching::findMatching()
 {
-  IdList unmatchedEquations;
+  const unsigned int numEquations = (unsigned int)mEquations.size();
+  unsigned int n, p;
 
+  mEquationMatch.assign(numEquations, NO_MATCH);
+  mVariableMatch.assign(mVariables.size(), NO_MATCH);
 
-  unsigned int n, p;
-  IdList temp;
-  IdList tempVarsInMatching;
-  IdList unmatch;
-  IdList layer;
-  IdList unmatchFlag;
-  unmatchFlag.append("unmatched");
-  graph newLayer;
-
-  /* create greedy mMatching */
-  for (n = 0; n < mEquations.size(); n++)
+  /* create greedy matching */
+  for (n = 0; n < numEquations; n++)
   {
-    for (p = 0; p < mGraph[mEquations.at((int)n)].size(); p++)
+    for (p = 0; p < mGraph[n].size(); p++)
     {
-      if (mMatching.count(mGraph[mEquations.at((int)n)].at((int)p)) == 0)
+      if (mVariableMatch[mGraph[n][p]] == NO_MATCH)
       {
-        temp.append(mEquations.at((int)n));
-        mMatching[mGraph[mEquations.at((int)n)].at((int)p)] = temp;
-        temp.clear();
+        mEquationMatch[n] = mGraph[n][p];
+        mVariableMatch[mGraph[n][p]] = n;
         break;
       }
     }
   }
 
-  unsigned int maximal = 1;
-  while (maximal == 1)
-  {
-    unmatch.clear();
-    mVarNeighInPrev.clear();
+  /* add shortest augmenting paths until there are none */
+  std::vector<unsigned int> layer(numEquations);
+  std::vector<unsigned int> nextEdge(numEquations);
+  std::vector<unsigned int> path;
 
-    /* create mEqnNeighInPrev - graph giving neighbour in previous layer */
+  unsigned int last = layerEquations(layer);
+  while (last != NO_MATCH)
+  {
+    nextEdge.assign(numEquations, 0);
 
-    /* list of variables in mMatching */
-    tempVarsInMatching.clear();
-    for (graph::iterator iter = mMatching.begin(); iter != mMatching.end(); iter++)
+    bool augmented = false;
+    for (n = 0; n < numEquations; n++)
     {
-      tempVarsInMatching.append((*iter).second.at(0));
+      if (mEquationMatch[n] == NO_MATCH
+        && augmentFrom(n, last, layer, nextEdge, path))
+      {
+        augmented = true;
+      }
     }
 
+    if (!augmented) break;
+
+    last = layerEquations(layer);
+  }
 
-    for (n = 0; n < mEquations.size(); n++)
+  /* list any equations that are not matched */
+  IdList unmatchedEquations;
+  for (n = 0; n < numEquations; n++)
+  {
+    if (mEquationMatch[n] == NO_MATCH)
     {
-      if (!tempVarsInMatching.contains(mEquations.at((int)n)))
-      {
-        mEqnNeighInPrev[mEquations.at((int)n)] = unmatchFlag;
-        layer.append(mEquations.at((int)n));
-      }
+      unmatchedEquations.append(mEquations[n]);
     }
+  }
 
-    /* extend layering structure */
-    while (layer.size() > 0 && unmatch.size() == 0)
-    {
-      graph::iterator iter;
+  return unmatchedEquations;
+}
 
-      newLayer.clear();
 
-      temp.clear();
-      for (iter = mVarNeighInPrev.begin(); 
-                        iter != mVarNeighInPrev.end(); iter++)
-      {
-        temp.append((*iter).first); 
-      }
-      for (n = 0; n < layer.size(); n++)
-      {
-        for (p = 0; p < mGraph[layer.at((int)n)].size(); p++)
-        {
-          if (!temp.contains(mGraph[layer.at((int)n)].at((int)p)))
-          {
-            newLayer[mGraph[layer.at((int)n)].at((int)p)].append(layer.at((int)n));
-          }
-        }
-      }
-
-      layer.clear();
-      temp.clear();
-      for (iter = newLayer.begin(); 
-                        iter != newLayer.end(); iter++)
-      {
-        mVarNeighInPrev[(*iter).first] = (*iter).second;
-        if (tempVarsInMatching.contains((*iter).first))
-        {
-          layer.append(mMatching[(*iter).first].at(0));
-          temp.append((*iter).first);
-          mEqnNeighInPrev[mMatching[(*iter).first].at(0)] = temp;
-        }
-        else
-        {
-          unmatch.append((*iter).first);
-        }
-      }
-    } // end of extending layers while statement
+/*
+ * layers the equations, breadth first from the unmatched ones; an
+ * equation is in the layer after the equation whose edge leads to the
+ * variable it is matched to
+ */
+unsigned int
+EquationMatching::layerEquations(std::vector<unsigned int>& layer)
+{
+  const unsigned int numEquations = (unsigned int)mEquations.size();
+  std::vector<unsigned int> queue;
+  unsigned int last = NO_MATCH;
 
-    /* finished without needing alternative paths */
-    if (unmatch.size() == 0)
+  queue.reserve(numEquations);
+  for (unsigned int n = 0; n < numEquations; n++)
+  {
+    if (mEquationMatch[n] == NO_MATCH)
     {
-      /* list any equations that are not matched */
-      temp.clear();
-      for (graph::iterator iter = mMatching.begin(); 
-                        iter != mMatching.end(); iter++)
-      {
-        temp.append(mMatching[(*iter).first].at(0));
-      }
-
-      for (n = 0; n < mEquations.size(); n++)
-      {
-        if (!temp.contains(mEquations.at((int)n)))
-        {
-          unmatchedEquations.append(mEquations.at((int)n));
-        }
-      }
-      maximal = 0;
+      layer[n] = 0;
+      queue.push_back(n);
     }
     else
     {
-      for (n = 0; n < unmatch.size(); n++)
-      {
-        maximal = Recurse(unmatch.at((int)n));
-        if (maximal == 2) break;
-      }
+      layer[n] = NO_MATCH;
     }
   }
 
-  if (maximal == 2)
+  for (size_t q = 0; q < queue.size(); q++)
   {
-    // we have a flip flopping set of matches
-    unmatchedEquations.append(mMatching[unmatch.at((int)n)].at(0));
+    const unsigned int eq = queue[q];
+
+    /* no shorter path is found beyond the layer that ends one */
+    if (last != NO_MATCH && layer[eq] >= last) continue;
+
+    const std::vector<unsigned int>& edges = mGraph[eq];
+    for (size_t p = 0; p < edges.size(); p++)
+    {
+      const unsigned int next = mVariableMatch[edges[p]];
+      if (next == NO_MATCH)
+      {
+        last = layer[eq];
+      }
+      else if (layer[next] == NO_MATCH)
+      {
+        layer[next] = layer[eq] + 1;
+        queue.push_back(next);
+      }
+    }
   }
-  return unmatchedEquations;
 
+  return last;
 }
 
 
 /*
- * function that looks for alternative paths and adds these to the matching
- * where necessary
+ * follows the layers depth first from the given unmatched equation, with
+ * the path kept in a vector rather than on the stack; equations that lead
+ * nowhere are taken out of the layers so that no path visits them again
  */
-unsigned int
-EquationMatching::Recurse(std::string v)
+bool
+EquationMatching::augmentFrom(unsigned int eq, unsigned int last,
+                              std::vector<unsigned int>& layer,
+                              std::vector<unsigned int>& nextEdge,
+                              std::vector<unsigned int>& path)
 {
-  //static graph revisited;
-  //static IdList visited;
-  unsigned int rec = 0;
-  unsigned int n;
-  IdList tempVarNeigh;
-  IdList tempEqnNeigh;
-  IdList L;
-  IdList pu;
-  IdList prev;
-
-  graph::iterator iter;
+  path.clear();
+  path.push_back(eq);
 
-  tempVarNeigh.clear();
-  for (iter = mVarNeighInPrev.begin(); 
-                    iter != mVarNeighInPrev.end(); iter++)
+  while (!path.empty())
   {
-    tempVarNeigh.append((*iter).first);
-  }
+    const unsigned int current = path.back();
+    const std::vector<unsigned int>& edges = mGraph[current];
 
-  tempEqnNeigh.clear();
-  for (iter = mEqnNeighInPrev.begin(); 
-                    iter != mEqnNeighInPrev.end(); iter++)
-  {
-    tempEqnNeigh.append((*iter).first);
-  }
+    if (layer[current] == NO_MATCH || nextEdge[current] >= edges.size())
+    {
+      layer[current] = NO_MATCH;
+      path.pop_back();
+      continue;
+    }
 
-  if (tempVarNeigh.contains(v))
-  {
-    L = mVarNeighInPrev[v];
-    mVarNeighInPrev.erase(v);
+    const unsigned int var  = edges[nextEdge[current]];
+    const unsigned int next = mVariableMatch[var];
 
-    for (n = 0; n < L.size(); n++)
+    if (next == NO_MATCH)
     {
-      if (tempEqnNeigh.contains(L.at((int)n)))
+      if (layer[current] == last)
       {
-        pu = mEqnNeighInPrev[L.at((int)n)];
-        mEqnNeighInPrev.erase(L.at((int)n));
-
-        if (pu.size() == 0)
-          break;
-
-        if (pu.size() == 1 && !strcmp(pu.at(0).c_str(), "unmatched"))
-        {
-          /* look to see if variable has been here before
-           * in order t catch variables that are flip flopping
-           * between equations
-           */
-          bool repeat = false;
-          if (!visited.contains(v))
-          {
-            visited.append(v);
-            revisited[v] = L;
-          }
-          else
-          {
-            prev = revisited[v];
-            unsigned int i;
-            for (i = 0; i < L.size(); i++)
-            {
-              if (prev.contains(L.at((int)i)))
-              {
-                repeat = true;
-              }
-              else
-              {
-                prev.append(L.at((int)i));
-              }
-              if (repeat) break;
-            }
-          }
-          if (!repeat)
-          {
-            mMatching[v] = L;
-            rec = 1;
-          }
-          else
-          {
-            rec = 2;
-            return rec;
-          }
-        }
-        else if (Recurse(pu.at(0)))
+        /* each equation on the path takes the variable it leads to */
+        for (size_t n = 0; n < path.size(); n++)
         {
-          mMatching[v] = L;
-          rec = 1;
+          const unsigned int e = path[n];
+          const unsigned int v = mGraph[e][nextEdge[e]];
+          mEquationMatch[e] = v;
+          mVariableMatch[v] = e;
         }
+        return true;
       }
+      nextEdge[current]++;
+    }
+    else if (layer[next] != NO_MATCH && layer[next] == layer[current] + 1)
+    {
+      path.push_back(next);
+    }
+    else
+    {
+      nextEdge[current]++;
     }
   }
-  return rec;
+
+  return false;
 }
 
 
@@ -782,14 +692,15 @@ EquationMatching::Recurse(std::string v)
 bool
 EquationMatching::match_dependency(const std::string& var, const std::string& eq)
 {
-  bool match = false;
-  IdList matches = mMatching[var];
+  std::map<std::string, unsigned int>::const_iterator it
+    = mVariableIndex.find(var);
 
-  if (matches.size() == 1 && matches.at(0) == eq)
-    match = true;
+  if (it == mVariableIndex.end() || it->second >= mVariableMatch.size())
+    return false;
 
-  
-  return match;
+  const unsigned int matched = mVariableMatch[it->second];
+
+  return (matched != NO_MATCH && mEquations[matched] == eq);
 }
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
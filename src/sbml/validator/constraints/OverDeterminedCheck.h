@@ -51,10 +51,6 @@
 
 #include <string>
 #include <vector>
-
-#include <algorithm>
-#include <functional>
-
 #include <map>
 
 #include <sbml/validator/VConstraint.h>
@@ -62,11 +58,18 @@
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
-typedef std::map< std::string, IdList> graph;
-
 class Model;
 class Validator;
+class ASTNode;
 
+/*
+ * The bipartite graph of equations and variables of L2V2 section 4.11.5,
+ * and a maximal matching of it.
+ *
+ * Vertexes are numbered in the order they are created, and the edges of
+ * each equation are kept as the indexes of its variables, so that the
+ * matching can be found without looking up any identifiers.
+ */
 class EquationMatching
 {
 public:
@@ -99,16 +102,16 @@ public:
   /**
    * creates a bipartite graph according to the L2V2 spec 4.11.5 
    * creates edges between the equation vertexes and the variable vertexes
-   * graph produced is an id representimg the equation and an IdList
-   * listing the edges the equation vertex is connected to
+   * the edges of each equation vertex are the indexes of the variable
+   * vertexes it is connected to
    */
   void createGraph(const Model &);
 
   /**
-   * finds a maximal matching of the bipartite graph
-   * adapted from the only implementation I could find:
-   * # Hopcroft-Karp bipartite max-cardinality mMatching and max independent set
-   * # David Eppstein, UC Irvine, 27 Apr 2002 - Python Cookbook
+   * finds a maximum matching of the bipartite graph, starting from a
+   * greedy matching and adding the shortest augmenting paths in phases
+   * (Hopcroft-Karp); the paths are followed without recursion so that
+   * large models cannot exhaust the stack
    *
    * returns an IdList of any equation vertexes that are unconnected 
    * in the maximal matching
@@ -116,25 +119,47 @@ public:
   IdList findMatching();
 
   /**
-  * function that looks for alternative paths and adds these to the matching
-  * where necessary
-  */
-  unsigned int Recurse(std::string);
-
+   * returns true if the variable is matched to the equation
+   */
   bool match_dependency(const std::string& var, const std::string& eq); 
 
 
-  IdList mEquations; // list of equation vertexes
-  IdList mVariables; // list of variable vertexes
-  graph mGraph;
+private:
+
+  void addEquation(const std::string& eq);
+
+  void addVariable(const std::string& var);
+
+  void addEdges(unsigned int eq, const ASTNode* math);
+
+  /* layers the equations by the length of the shortest alternating path
+   * to them from an unmatched equation; returns the layer of the
+   * equations that end the shortest augmenting paths, or NO_MATCH if the
+   * matching is maximal */
+  unsigned int layerEquations(std::vector<unsigned int>& layer);
 
-  /* these are to enable the bipartite matching without passing variables */
-  graph mMatching;
-  graph mVarNeighInPrev;
-  graph mEqnNeighInPrev;
+  /* looks for an augmenting path from the given unmatched equation along
+   * the layers and, if it finds one, flips the matching along it */
+  bool augmentFrom(unsigned int eq, unsigned int last,
+                   std::vector<unsigned int>& layer,
+                   std::vector<unsigned int>& nextEdge,
+                   std::vector<unsigned int>& path);
 
-  graph revisited;
-  IdList visited;
+
+  std::vector<std::string> mEquations; // names of the equation vertexes
+  std::vector<std::string> mVariables; // ids of the variable vertexes
+  std::map<std::string, unsigned int> mVariableIndex;
+
+  /* the number of variable vertexes written, counting any repeated id */
+  unsigned int mNumVariables;
+
+  /* the variables each equation is connected to */
+  std::vector< std::vector<unsigned int> > mGraph;
+
+  /* the variable matched to each equation and the equation matched to
+   * each variable, or NO_MATCH */
+  std::vector<unsigned int> mEquationMatch;
+  std::vector<unsigned int> mVariableMatch;
 };
 
 class OverDeterminedCheck: public TConstraint<Model>
@@ -159,69 +184,12 @@ protected:
    */
   virtual void check_ (const Model& m, const Model& object);
 
-  ///** 
-  // * creates equation vertexes according to the L2V2 spec 4.11.5 for every
-  // * 1. a Species object that has the boundaryCondition field set to false 
-  // * and constant field set to false and which is referenced by one or more 
-  // * reactant or product lists of a Reaction object containing a KineticLaw object
-  // * 2. a Rule object
-  // * 3. a KineticLaw object
-  // */
-  //void writeEquationVertexes(const Model &);
-
-  ///**
-  // * creates variable vertexes according to the L2V2 spec 4.11.5 for
-  // * (a) every Species, Compartment and Parameter object which has the
-  // * Constant field set to false; and 
-  // * (b) for every Reaction object.
-  // */
-  //void writeVariableVertexes(const Model &);
-
-  ///**
-  // * creates a bipartite graph according to the L2V2 spec 4.11.5 
-  // * creates edges between the equation vertexes and the variable vertexes
-  // * graph produced is an id representimg the equation and an IdList
-  // * listing the edges the equation vertex is connected to
-  // */
-  //void createGraph(const Model &);
-
-  ///**
-  // * finds a maximal matching of the bipartite graph
-  // * adapted from the only implementation I could find:
-  // * # Hopcroft-Karp bipartite max-cardinality mMatching and max independent set
-  // * # David Eppstein, UC Irvine, 27 Apr 2002 - Python Cookbook
-  // *
-  // * returns an IdList of any equation vertexes that are unconnected 
-  // * in the maximal matching
-  // */
-  //IdList findMatching();
-
-  ///**
-  //* function that looks for alternative paths and adds these to the matching
-  //* where necessary
-  //*/
-  //unsigned int Recurse(std::string);
-
   /**
    * Logs a message about overdetermined model.
    * As yet this only reports the problem - it doesnt really give
    * any additional information
    */
   void logOverDetermined (const Model &);
-
-
-  //IdList mEquations; // list of equation vertexes
-  //IdList mVariables; // list of variable vertexes
-  //graph mGraph;
-
-  ///* these are to enable the bipartite matching without passing variables */
-  //graph mMatching;
-  //graph mVarNeighInPrev;
-  //graph mEqnNeighInPrev;
-
-  //graph revisited;
-  //IdList visited;
-
 };
 
 LIBSBML_CPP_NAMESPACE_END
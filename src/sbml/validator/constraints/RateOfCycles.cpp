@@ -92,7 +92,7 @@ RateOfCycles::check_ (const Model& m, const Model& object)
 
   unsigned int n;
 
-  mIdMap.clear();
+  mGraph.clear();
   mRnSpeciesMap.clear();
 
   for (n = 0; n < m.getNumRules(); ++n)
@@ -131,7 +131,6 @@ RateOfCycles::check_ (const Model& m, const Model& object)
   // check for self assignment
   checkForSelfAssignment(m);
 
-  determineAllDependencies();
   determineCycles(m);
 }
  
@@ -228,11 +227,11 @@ RateOfCycles::addRuleDependencies(const Model& m, const Rule& object)
       
       if (m.getRule(name) && m.getRule(name)->isRate())
       {
-        mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+        mGraph.addEdge(thisId, name);
       }
       else if (assignedByReaction(m, name))
       {
-        mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+        mGraph.addEdge(thisId, name);
       }
     }
   }
@@ -250,7 +249,7 @@ RateOfCycles::addRuleDependencies(const Model& m, const Rule& object)
     string   name = node->getName() ? node->getName() : "";
     if (isEdgeCaseAssignment(m, name))
     {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+      mGraph.addEdge(thisId, name);
     }
   }
 
@@ -286,11 +285,11 @@ RateOfCycles::addAssignmentRuleDependencies(const Model& m, const Rule& object)
       
       if (m.getRule(name) && m.getRule(name)->isRate())
       {
-        mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+        mGraph.addEdge(thisId, name);
       }
       else if (assignedByReaction(m, name))
       {
-        mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+        mGraph.addEdge(thisId, name);
       }
     }
   }
@@ -326,11 +325,11 @@ RateOfCycles::addInitialAssignmentDependencies(const Model& m, const InitialAssi
       
       if (m.getRule(name) && m.getRule(name)->isRate())
       {
-        mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+        mGraph.addEdge(thisId, name);
       }
       else if (assignedByReaction(m, name))
       {
-        mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+        mGraph.addEdge(thisId, name);
       }
     }
   }
@@ -344,15 +343,13 @@ RateOfCycles::addRnSpeciesDependencies(const std::string& name, const Reaction &
 {
   for (unsigned int i = 0; i < r.getNumReactants(); i++)
   {
-    mIdMap.insert(pair<const std::string, std::string>
-      (r.getReactant(i)->getSpecies(), name));
+    mGraph.addEdge(r.getReactant(i)->getSpecies(), name);
     mRnSpeciesMap.insert(pair<const std::string, const std::string>
       (r.getId(), r.getReactant(i)->getSpecies()));
   }
   for (unsigned int i = 0; i < r.getNumProducts(); i++)
   {
-    mIdMap.insert(pair<const std::string, std::string>
-      (r.getProduct(i)->getSpecies(), name));
+    mGraph.addEdge(r.getProduct(i)->getSpecies(), name);
     mRnSpeciesMap.insert(pair<const std::string, const std::string>
       (r.getId(), r.getProduct(i)->getSpecies()));
   }
@@ -439,63 +436,20 @@ RateOfCycles::isEdgeCaseAssignment(const Model& m, const std::string& id)
   return isEdgeCase;
 }
 
-void 
-RateOfCycles::determineAllDependencies()
-{
-  IdIter iterator;
-  IdIter inner_it;
-  IdRange range;
-
-  /* for each pair in the map (x, y)
-   * retrieve all other pairs where y is first (e.g. (y, s))
-   * and create pairs showing that x depends on these e.g. (x, s)
-   * check whether the pair already exists in the map
-   * and add it if not
-   */
-  for (iterator = mIdMap.begin(); iterator != mIdMap.end(); iterator++)
-  {
-    range = mIdMap.equal_range((*iterator).second);
-    for (inner_it = range.first; inner_it != range.second; inner_it++)
-    {
-      const pair<const std::string, std::string> &depend = 
-            pair<const std::string, std::string>((*iterator).first, (*inner_it).second);
-      if (!alreadyExistsInMap(mIdMap, depend))
-        mIdMap.insert(depend);
-    }
-  }
-}
-
-
-bool 
-RateOfCycles::alreadyExistsInMap(IdMap map, 
-                                     pair<const std::string, std::string> dependency)
-{
-  bool exists = false;
-
-  IdIter it;
-  
-  for (it = map.begin(); it != map.end(); it++)
-  {
-    if (((*it).first == dependency.first)
-      && ((*it).second == dependency.second))
-      exists = true;
-  }
-
-  return exists;
-}
-
-  
 void 
 RateOfCycles::checkForSelfAssignment(const Model& m)
 {
-  IdIter the_iterator;
+  vector<unsigned int> nodes = mGraph.getNodesById();
 
-  for (the_iterator = mIdMap.begin();
-    the_iterator != mIdMap.end(); the_iterator++)
+  for (size_t n = 0; n < nodes.size(); n++)
   {
-    if ((*the_iterator).first == (*the_iterator).second)
+    const vector<unsigned int>& edges = mGraph.getEdges(nodes[n]);
+    for (size_t e = 0; e < edges.size(); e++)
     {
-      logMathRefersToSelf(m, (*the_iterator).first);
+      if (edges[e] == nodes[n])
+      {
+        logMathRefersToSelf(m, mGraph.getId(nodes[n]));
+      }
     }
   }
 }
@@ -504,54 +458,30 @@ RateOfCycles::checkForSelfAssignment(const Model& m)
 void 
 RateOfCycles::determineCycles(const Model& m)
 {
-  IdIter it;
-  IdRange range;
-  IdList variables;
-  IdMap logged;
+  vector<unsigned int> nodes = mGraph.getNodesById();
+  vector<unsigned int> dependencies;
   std::vector<IdList> cycle; 
-  std::string id;
-  variables.clear();
-  cycle.clear();
 
-  /* create a list of variables that are cycles ie (x, x) */
-  for (it = mIdMap.begin(); it != mIdMap.end(); it++)
-  {
-    if ((*it).first == (*it).second)
-    {
-      id = (*it).first;
-      if (!variables.contains(id))
-      {
-        variables.append(id);
-      }
-    }
-  }
+  mGraph.findCycles();
 
-  /* loop thru other dependencies for each; if the dependent is also
-   * in the list then this is the cycle
-   * keep a record of logged dependencies to avoid logging twice
+  /* for each variable that is in a cycle, list everything it depends on
+   * keep a record of logged cycles to avoid logging the same one twice
    */
-  IdList temp, temp2;
-  unsigned int n = 0;
-  while (n < variables.size())
+  IdList temp;
+  for (size_t n = 0; n < nodes.size(); n++)
   {
+    unsigned int id = nodes[n];
+    if (!mGraph.isInCycle(id)) continue;
+
     temp.clear();
-    id = variables.at((int)n);
-    temp.append(id);
-    range = mIdMap.equal_range(id);
-    for (it = range.first; it != range.second; it++)
+    temp.append(mGraph.getId(id));
+
+    mGraph.getDependencies(id, dependencies);
+    for (size_t d = 0; d < dependencies.size(); d++)
     {
-      //if (((*it).second != id)
-      //  && (variables.contains((*it).second))
-      //  && !alreadyExistsInMap(logged, pair<const std::string, std::string>(id, (*it).second))
-      //  && !alreadyExistsInMap(logged, pair<const std::string, std::string>((*it).second, id)))
-      //{
-      //  logCycle(m, id, (*it).second);
-      //  logged.insert(pair<const std::string, std::string>(id, (*it).second));
-      //}
-
-      if ((*it).second != id)
+      if (dependencies[d] != id)
       {
-        temp.append((*it).second);  
+        temp.append(mGraph.getId(dependencies[d]));  
       }
     }
     if (temp.size() > 1 && !alreadyExistsInCycle(cycle, temp))
@@ -560,8 +490,6 @@ RateOfCycles::determineCycles(const Model& m)
 
       logCycle(m, temp);
     }
-    n++;
-
   }
 }
  
@@ -52,6 +52,8 @@
 
 #include <sbml/util/IdList.h>
 
+#include "DependencyGraph.h"
+
 LIBSBML_CPP_NAMESPACE_BEGIN
 
 typedef std::multimap<const std::string, std::string> IdMap;
@@ -101,14 +103,6 @@ protected:
   bool isEdgeCaseAssignment(const Model& m, const std::string& id);
 
 
-  void determineAllDependencies();
-
-
-  /* helper function to check if a pair already exists */
-  bool alreadyExistsInMap(IdMap map, 
-                          std::pair<const std::string, std::string> dependency);
-
-
   bool alreadyExistsInCycle(std::vector<IdList> cycle, IdList list);
 
   bool containSameElements(IdList listA, IdList listB);
@@ -118,7 +112,7 @@ protected:
   void checkForSelfAssignment(const Model &);
 
 
-  /* find cycles in the map of dependencies */
+  /* find cycles in the graph of dependencies */
   void determineCycles(const Model& m);
 
 
@@ -149,7 +143,7 @@ protected:
   void logMathRefersToSelf (const Model& m, std::string id);
 
   
-  IdMap mIdMap;
+  DependencyGraph mGraph;
 
   IdMap mRnSpeciesMap;
 
@@ -75,6 +75,17 @@ SpeciesReactionOrRule::~SpeciesReactionOrRule ()
 }
 
 
+/*
+ * Clears the identifiers collected from the last document checked.
+ */
+void
+SpeciesReactionOrRule::reset ()
+{
+  mReactions.clear();
+  mRules.clear();
+}
+
+
 /*
   * Checks that any species with boundary condition false
   * is not set by reaction and rules
@@ -73,6 +73,16 @@ StoichiometryMathVars::~StoichiometryMathVars ()
 }
 
 
+/*
+ * Clears the identifiers collected from the last document checked.
+ */
+void
+StoichiometryMathVars::reset ()
+{
+  mSpecies.clear();
+}
+
+
 /*
  * Checks that all variables referenced in FunctionDefinition bodies are
  * bound variables (function arguments).
@@ -71,6 +71,11 @@ public:
    */
   virtual ~StoichiometryMathVars ();
 
+  /**
+   * Clears the identifiers collected from the last document checked.
+   */
+  virtual void reset ();
+
 
 protected:
 
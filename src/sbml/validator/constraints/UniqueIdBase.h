@@ -81,7 +81,7 @@ protected:
    * Resets the state of this GlobalConstraint by clearing its internal
    * list of error messages.
    */
-  void reset ();
+  virtual void reset ();
 
   /**
    * Called by check().  Override this method to define your own subset.
@@ -80,6 +80,18 @@ UnitsBase::~UnitsBase ()
 {
 }
 
+
+/*
+ * @return true: the units of the math of each object are checked on
+ * their own, unless the validator leaves the object out.
+ */
+bool
+UnitsBase::checksSingleObjects () const
+{
+  return true;
+}
+
+
 /**
  * @return the fieldname to use logging constraint violations.  If not
  * overridden, "id" is returned.
@@ -121,7 +133,7 @@ UnitsBase::check_ (const Model& m, const Model& )
   {
     if (m.getRule(n)->isSetMath())
     {
-      checkUnits(m, *m.getRule(n)->getMath(), *m.getRule(n));
+      checkUnitsOf(m, *m.getRule(n)->getMath(), *m.getRule(n));
     }
   }
 
@@ -131,7 +143,7 @@ UnitsBase::check_ (const Model& m, const Model& )
     {
       if (m.getReaction(n)->getKineticLaw()->isSetMath())
       {
-        checkUnits(m, *m.getReaction(n)->getKineticLaw()->getMath(), 
+        checkUnitsOf(m, *m.getReaction(n)->getKineticLaw()->getMath(), 
           *m.getReaction(n)->getKineticLaw(), 1, (int)n);
       }
     }
@@ -140,7 +152,7 @@ UnitsBase::check_ (const Model& m, const Model& )
       if (m.getReaction(n)->getProduct(sr)->isSetStoichiometryMath() && 
         m.getReaction(n)->getProduct(sr)->getStoichiometryMath()->isSetMath())
       {
-        checkUnits(m, 
+        checkUnitsOf(m, 
           *m.getReaction(n)->getProduct(sr)->getStoichiometryMath()->getMath(), 
           *m.getReaction(n)->getProduct(sr));
       }
@@ -150,7 +162,7 @@ UnitsBase::check_ (const Model& m, const Model& )
       if (m.getReaction(n)->getReactant(sr)->isSetStoichiometryMath() &&
         m.getReaction(n)->getReactant(sr)->getStoichiometryMath()->isSetMath())
       {
-        checkUnits(m, 
+        checkUnitsOf(m, 
           *m.getReaction(n)->getReactant(sr)->getStoichiometryMath()->getMath(), 
           *m.getReaction(n)->getReactant(sr));
       }
@@ -163,7 +175,7 @@ UnitsBase::check_ (const Model& m, const Model& )
     {
       if (m.getEvent(n)->getTrigger()->isSetMath())
       {
-        checkUnits(m, *m.getEvent(n)->getTrigger()->getMath(), 
+        checkUnitsOf(m, *m.getEvent(n)->getTrigger()->getMath(), 
                                               *m.getEvent(n));
       }
     }
@@ -171,7 +183,7 @@ UnitsBase::check_ (const Model& m, const Model& )
     {
       if (m.getEvent(n)->getDelay()->isSetMath())
       {
-        checkUnits(m, *m.getEvent(n)->getDelay()->getMath(), 
+        checkUnitsOf(m, *m.getEvent(n)->getDelay()->getMath(), 
                                              *m.getEvent(n));
       }
     }
@@ -179,7 +191,7 @@ UnitsBase::check_ (const Model& m, const Model& )
     {
       if (m.getEvent(n)->getEventAssignment(ea)->isSetMath())
       {
-        checkUnits(m, *m.getEvent(n)->getEventAssignment(ea)->getMath(), 
+        checkUnitsOf(m, *m.getEvent(n)->getEventAssignment(ea)->getMath(), 
           *m.getEvent(n)->getEventAssignment(ea));
       }
     }
@@ -189,7 +201,7 @@ UnitsBase::check_ (const Model& m, const Model& )
   {
     if (m.getInitialAssignment(n)->isSetMath())
     {
-      checkUnits(m, *m.getInitialAssignment(n)->getMath(), *m.getInitialAssignment(n));
+      checkUnitsOf(m, *m.getInitialAssignment(n)->getMath(), *m.getInitialAssignment(n));
     }
   }
 
@@ -197,10 +209,28 @@ UnitsBase::check_ (const Model& m, const Model& )
   {
     if (m.getConstraint(n)->isSetMath())
     {
-      checkUnits(m, *m.getConstraint(n)->getMath(), *m.getConstraint(n));
+      checkUnitsOf(m, *m.getConstraint(n)->getMath(), *m.getConstraint(n));
     }
   }
 }
+
+
+/*
+ * Calls checkUnits() for the math of the given object, unless the validator
+ * leaves the object out.
+ */
+void
+UnitsBase::checkUnitsOf (const Model& m, const ASTNode& node, const SBase & sb,
+    bool inKL, int reactNo)
+{
+  if (!mValidator.isToBeChecked(sb)) return;
+
+  mValidator.setCheckedObject(&sb);
+  checkUnits(m, node, sb, inKL, reactNo);
+  mValidator.setCheckedObject(NULL);
+}
+
+
 /**
   * Checks that the units of the children of ASTnode 
   * are appropriate for the function being performed
@@ -74,6 +74,12 @@ public:
    */
   virtual ~UnitsBase ();
 
+  /**
+   * Returns true: the units of the math of each object are checked on
+   * their own.
+   */
+  virtual bool checksSingleObjects () const;
+
 
 protected:
 
@@ -92,6 +98,13 @@ protected:
   virtual void checkUnits (const Model& m, const ASTNode& node, const SBase & sb,
     bool inKL = false, int reactNo = -1) = 0;
  
+  /**
+   * Calls checkUnits() for the math of the given object, unless the validator
+   * leaves the object out; the failures logged are put down to it.
+   */
+  void checkUnitsOf (const Model& m, const ASTNode& node, const SBase & sb,
+    bool inKL = false, int reactNo = -1);
+
   /**
    * Checks that the units of the ASTnode 
    * are appropriate for the function being performed
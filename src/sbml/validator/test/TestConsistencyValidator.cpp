@@ -43,6 +43,7 @@
 
 #include <iostream>
 #include <set>
+#include <vector>
 
 #include <algorithm>
 
@@ -63,6 +64,7 @@
 #include "L3v1CompatibilityValidator.h"
 #include <sbml/validator/ModelingPracticeValidator.h>
 #include <sbml/SBase.h>
+#include <sbml/SBMLTypes.h>
 
 #ifdef LIBSBML_USE_VLD
   #include <vld.h>
@@ -391,6 +393,183 @@ runModelingPracticeTest (const TestFile& file)
 }
 
 
+/*
+ * The Validator runReusedTest() checks every file with.
+ */
+static Validator* reusedValidator = NULL;
+
+
+/**
+ * @return true if the Validator behaved as expected when validating
+ * TestFile, false otherwise.  The same Validator is used for every file
+ * and reset in between.
+ */
+bool
+runReusedTest (const TestFile& file)
+{
+  reusedValidator->reset();
+
+  TestValidator tester(*reusedValidator);
+
+  return tester.test(file);
+}
+
+
+/**
+ * Makes the nth of a series of edits to the model of the document: the
+ * first removes a component that others may refer to, the second gives a
+ * reaction a rate law using an undeclared id and the third gives it a
+ * constant rate instead.
+ */
+static void
+editModel (SBMLDocument* document, unsigned int edit)
+{
+  Model* m = document->getModel();
+  if (m == NULL) return;
+
+  if (edit == 1)
+  {
+    ListOf* lists[] =
+    {
+      m->getListOfCompartments(),
+      m->getListOfSpecies(),
+      m->getListOfParameters(),
+      m->getListOfFunctionDefinitions(),
+      m->getListOfUnitDefinitions()
+    };
+
+    for (size_t n = 0; n < sizeof(lists) / sizeof(lists[0]); ++n)
+    {
+      if (lists[n]->size() > 0)
+      {
+        delete lists[n]->remove(0);
+        break;
+      }
+    }
+  }
+  else if (m->getNumReactions() > 0 && m->getReaction(0)->isSetKineticLaw())
+  {
+    KineticLaw* kl = m->getReaction(0)->getKineticLaw();
+    ASTNode* math = SBML_parseL3Formula(edit == 2 ? "2 * undeclared" : "2");
+    kl->setMath(math);
+    delete math;
+  }
+}
+
+
+/**
+ * Returns the ids of the errors in the log from the given one on, in
+ * order.
+ */
+static vector<unsigned int>
+getErrorIds (const SBMLDocument* document, unsigned int from)
+{
+  vector<unsigned int> ids;
+  for (unsigned int n = from; n < document->getNumErrors(); ++n)
+  {
+    ids.push_back(document->getError(n)->getErrorId());
+  }
+  sort(ids.begin(), ids.end());
+  return ids;
+}
+
+
+/**
+ * @return true if checking the document in TestFile with
+ * SBMLDocument::checkConsistencyIncremental(), as read and after each of
+ * a series of edits, finds the same failures as checking a copy of it
+ * with SBMLDocument::checkConsistency().
+ */
+bool
+runIncrementalTest (const TestFile& file)
+{
+  SBMLDocument* document = readSBML(file.getFullname().c_str());
+  unsigned int  numRead  = document->getNumErrors();
+  bool          result   = true;
+
+  for (unsigned int edit = 0; edit < 4 && result; ++edit)
+  {
+    editModel(document, edit);
+    unsigned int incremental = document->checkConsistencyIncremental();
+
+    SBMLDocument* copy = readSBML(file.getFullname().c_str());
+    for (unsigned int n = 0; n <= edit; ++n)
+    {
+      editModel(copy, n);
+    }
+    unsigned int full = copy->checkConsistency();
+
+    result = (incremental == full
+              && getErrorIds(document, numRead)
+                 == getErrorIds(copy, numRead));
+    delete copy;
+  }
+
+  if (!result)
+  {
+    cout << "Incremental check differs for " << file.getFilename() << endl;
+  }
+
+  delete document;
+  return result;
+}
+
+
+/**
+ * Returns the ids and severities of the errors in the log from the given
+ * one on, in order.
+ */
+static vector< pair<unsigned int, unsigned int> >
+getErrors (const SBMLDocument* document, unsigned int from)
+{
+  vector< pair<unsigned int, unsigned int> > errors;
+  for (unsigned int n = from; n < document->getNumErrors(); ++n)
+  {
+    errors.push_back(make_pair(document->getError(n)->getErrorId(),
+                               document->getError(n)->getSeverity()));
+  }
+  return errors;
+}
+
+
+/**
+ * @return true if checking the document in TestFile with the checks of
+ * the reader made on the object tree finds the same errors as checking a
+ * copy of it that is written out and read back, both with
+ * SBMLDocument::checkInternalConsistency(), which reports them, and with
+ * SBMLDocument::checkConsistency(), which does not go on after serious
+ * ones.
+ */
+bool
+runReadChecksTest (const TestFile& file)
+{
+  SBMLDocument* document = readSBML(file.getFullname().c_str());
+  SBMLDocument* always   = readSBML(file.getFullname().c_str());
+  unsigned int  numRead  = document->getNumErrors();
+
+  always->enableRoundTripReadChecks(true);
+
+  bool result = (document->checkInternalConsistency()
+                 == always->checkInternalConsistency()
+                 && getErrors(document, numRead) == getErrors(always, numRead));
+
+  if (result)
+  {
+    result = (document->checkConsistency() == always->checkConsistency()
+              && getErrors(document, 0) == getErrors(always, 0));
+  }
+
+  if (!result)
+  {
+    cout << "Read-time checks differ for " << file.getFilename() << endl;
+  }
+
+  delete document;
+  delete always;
+  return result;
+}
+
+
 /**
  * Run a given set of tests and print the results.
  */
@@ -418,6 +597,30 @@ runTests ( const string& msg,
   return failures;
 }
 
+
+/**
+ * Run a given set of tests with the given Validator, initialized once and
+ * reset between the files the way SBMLInternalValidator reuses its
+ * validators, and print the results.
+ */
+unsigned int
+runReusedTests ( const string& msg,
+                 const string& directory,
+                 unsigned int  begin,
+                 unsigned int  end,
+                 Validator&    validator,
+                 unsigned int  library)
+{
+  validator.init();
+  reusedValidator = &validator;
+
+  unsigned int failures =
+    runTests(msg, directory, begin, end, runReusedTest, library);
+
+  reusedValidator = NULL;
+  return failures;
+}
+
 /**
  * Runs the libSBML ConsistencyValidator on all consistency TestFiles in
  * the test-data/ directory.
@@ -571,6 +774,81 @@ main (int argc, char* argv[])
   failed += runTests("Testing Modeling Practice Constraints (80000 - 89999)",
 		     testThisDataDir, 80000, 89999, runModelingPracticeTest, library);
 
+  /* the constraints that remember what they have seen must forget it when
+   * their validator is reset for the next document */
+  IdentifierConsistencyValidator id_validator;
+  ConsistencyValidator           validator;
+  MathMLConsistencyValidator     math_validator;
+  UnitConsistencyValidator       unit_validator;
+  OverdeterminedValidator        over_validator;
+  SBOConsistencyValidator        sbo_validator;
+  ModelingPracticeValidator      practice_validator;
+  L2v1CompatibilityValidator     l2v1_validator;
+
+  testThisDataDir = testDataDir + "/" + "sbml-identifier-constraints";
+  failed += runReusedTests( "Testing Id Consistency Constraints with one validator",
+		      testThisDataDir, 0, 0, id_validator, library);
+
+  testThisDataDir = testDataDir + "/" + "sbml-general-consistency-constraints";
+  failed += runReusedTests( "Testing Model Consistency Constraints with one validator",
+		      testThisDataDir, 20000, 29999, validator, library);
+
+  testThisDataDir = testDataDir + "/" + "sbml-mathml-constraints";
+  failed += runReusedTests( "Testing MathML Consistency Constraints with one validator",
+		      testThisDataDir, 10200, 10299, math_validator, library);
+
+  testThisDataDir = testDataDir + "/" + "sbml-unit-constraints";
+  failed += runReusedTests( "Testing Unit Consistency Constraints with one validator",
+		      testThisDataDir, 10500, 10599, unit_validator, library);
+
+  testThisDataDir = testDataDir + "/" + "sbml-modeldefinition-constraints";
+  failed += runReusedTests( "Testing Overdetermined Constraints with one validator",
+		      testThisDataDir, 10600, 10699, over_validator, library);
+
+  testThisDataDir = testDataDir + "/" + "sbml-sbo-constraints";
+  failed += runReusedTests( "Testing SBO Consistency Constraints with one validator",
+		      testThisDataDir, 10700, 10799, sbo_validator, library);
+
+  testThisDataDir = testDataDir + "/" + "sbml-modeling-practice-constraints";
+  failed += runReusedTests( "Testing Modeling Practice Constraints with one validator",
+		      testThisDataDir, 80000, 89999, practice_validator, library);
+
+  failed += runReusedTests( "Testing L2v1 Compatibility Constraints with one validator",
+		      testDataConversionDir, 92000, 92999, l2v1_validator, library);
+
+  const char* directories[] =
+  {
+    "sbml-xml-constraints",
+    "sbml-mathml-constraints",
+    "sbml-identifier-constraints",
+    "sbml-annotation-constraints",
+    "sbml-unit-constraints",
+    "sbml-modeldefinition-constraints",
+    "sbml-sbo-constraints",
+    "sbml-notes-constraints",
+    "sbml-general-consistency-constraints",
+    "sbml-modeling-practice-constraints",
+    "libsbml-constraints"
+  };
+
+  for (size_t n = 0; n < sizeof(directories) / sizeof(directories[0]); ++n)
+  {
+    testThisDataDir = testDataDir + "/" + directories[n];
+    failed += runTests( string("Testing incremental checks of ") + directories[n],
+          testThisDataDir, 0, 0, runIncrementalTest, library);
+  }
+
+  testThisDataDir = testDataDir + "/" + "xml-parser-constraints";
+  failed += runTests( "Testing read-time checks of xml-parser-constraints",
+        testThisDataDir, 0, 0, runReadChecksTest, library);
+
+  for (size_t n = 0; n < sizeof(directories) / sizeof(directories[0]); ++n)
+  {
+    testThisDataDir = testDataDir + "/" + directories[n];
+    failed += runTests( string("Testing read-time checks of ") + directories[n],
+          testThisDataDir, 0, 0, runReadChecksTest, library);
+  }
+
   return failed;
 }
 
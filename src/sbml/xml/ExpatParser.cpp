@@ -60,8 +60,6 @@ using namespace std;
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
-static const int BUFFER_SIZE = 8192;
-
 /*
  * Expat's error messages are conveniently defined as a consecutive
  * sequence starting from 0.  This makes a translation table easy to
@@ -169,7 +167,7 @@ ExpatParser::ExpatParser (XMLHandler& handler) :
  , mBuffer ( NULL )
  , mSource ( NULL )
 {
-  if (mParser != NULL) mBuffer = XML_GetBuffer(mParser, BUFFER_SIZE);
+  if (mParser != NULL) mBuffer = XML_GetBuffer(mParser, DEFAULT_CHUNK_SIZE);
 }
 
 
@@ -276,7 +274,7 @@ ExpatParser::parseFirst (const char* content, bool isFile)
   {
     try
     {
-      mSource = new XMLFileBuffer(content);
+      mSource = createFileBuffer(content);
     }
     catch ( ZlibNotLinked& )
     {
@@ -334,35 +332,53 @@ ExpatParser::parseNext ()
 {
   if ( error() ) return false;
 
-  mBuffer = XML_GetBuffer(mParser, BUFFER_SIZE);
+  unsigned int length;
+  const char*  chunk = mSource->nextChunk(mChunkSize, length);
+  int          done;
+  XML_Status   status;
+
+  if ( chunk != NULL )
+  {
+    // The source holds its content in memory, so hand it to Expat as it is
+    // rather than copying it into the Expat buffer first.
 
-  if ( mBuffer == NULL )
+    done   = (length == 0);
+    status = XML_Parse(mParser, chunk, (int)length, done);
+  }
+  else
   {
-    // See if Expat logged an error.  There are only two things that
-    // XML_GetErrorCode will report: parser state errors and "out of memory".
-    // So we check for the first and default to the out-of-memory case.
+    mBuffer = XML_GetBuffer(mParser, (int)mChunkSize);
 
-    switch ( XML_GetErrorCode(mParser) )
+    if ( mBuffer == NULL )
     {
-    case XML_ERROR_SUSPENDED:
-    case XML_ERROR_FINISHED:
-      reportError(InternalXMLParserError);
-      break;
-
-    default:
-      reportError(XMLOutOfMemory);
-      break;
+      // See if Expat logged an error.  There are only two things that
+      // XML_GetErrorCode will report: parser state errors and "out of
+      // memory".  So we check for the first and default to the
+      // out-of-memory case.
+
+      switch ( XML_GetErrorCode(mParser) )
+      {
+      case XML_ERROR_SUSPENDED:
+      case XML_ERROR_FINISHED:
+        reportError(InternalXMLParserError);
+        break;
+
+      default:
+        reportError(XMLOutOfMemory);
+        break;
+      }
+
+      return false;
     }
 
-    return false;
+    int bytes = mSource->copyTo(mBuffer, mChunkSize);
+    done      = (bytes == 0);
+    status    = XML_ParseBuffer(mParser, bytes, done);
   }
 
-  int bytes = mSource->copyTo(mBuffer, BUFFER_SIZE);
-  int done  = (bytes == 0);
-
-  // Attempt to parse the content, checking for the Expat return status.
+  // Check for the Expat return status.
 
-  if ( XML_ParseBuffer(mParser, bytes, done) == XML_STATUS_ERROR )
+  if ( status == XML_STATUS_ERROR )
   {
     reportError(translateError(XML_GetErrorCode(mParser)), "",
 		XML_GetCurrentLineNumber(mParser),
@@ -42,6 +42,7 @@
  * ---------------------------------------------------------------------- -->*/
 
 #include <iostream>
+#include <new>
 #include <sstream>
 
 #include <libxml/xmlerror.h>
@@ -59,8 +60,6 @@ using namespace std;
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
-static const int BUFFER_SIZE = 8192;
-
 /*
  * Table mapping libXML error codes to ours.  The error code numbers are not
  * contiguous, hence the table has to map pairs of numbers rather than
@@ -243,10 +242,11 @@ LibXMLParser::reportError (const XMLErrorCode_t code,
  * of parse events and errors.
  */
 LibXMLParser::LibXMLParser (XMLHandler& handler) :
-   mParser ( NULL                  )
- , mHandler( handler               )
- , mBuffer ( new char[BUFFER_SIZE] )
- , mSource ( NULL                  )
+   mParser    ( NULL    )
+ , mHandler   ( handler )
+ , mBuffer    ( NULL    )
+ , mSource    ( NULL    )
+ , mBufferSize( 0       )
 {
   xmlSAXHandler* sax  = LibXMLHandler::getInternalHandler();
   void*          data = static_cast<void*>(&mHandler);
@@ -273,7 +273,7 @@ LibXMLParser::~LibXMLParser ()
 bool
 LibXMLParser::error () const
 {
-  bool error = (mParser == NULL || mBuffer == NULL);
+  bool error = (mParser == NULL);
 
   if (mSource != NULL) error = error || mSource->error();
   return error;
@@ -353,7 +353,7 @@ LibXMLParser::parseFirst (const char* content, bool isFile)
   {
     try
     {
-      mSource = new XMLFileBuffer(content);
+      mSource = createFileBuffer(content);
     }
     catch ( ZlibNotLinked& )
     {
@@ -412,7 +412,32 @@ LibXMLParser::parseNext ()
 {
   if ( error() ) return false;
 
-  int bytes = (int)mSource->copyTo(mBuffer, BUFFER_SIZE);
+  unsigned int length;
+  const char*  chunk = mSource->nextChunk(mChunkSize, length);
+
+  if ( chunk == NULL )
+  {
+    // The source does not hold its content in memory, so read the next
+    // chunk into our own buffer, (re)allocating it if the size changed.
+
+    if ( mBuffer == NULL || mBufferSize != mChunkSize )
+    {
+      delete [] mBuffer;
+      mBuffer     = new(std::nothrow) char[mChunkSize];
+      mBufferSize = (mBuffer != NULL) ? mChunkSize : 0;
+
+      if ( mBuffer == NULL )
+      {
+        reportError(XMLOutOfMemory);
+        return false;
+      }
+    }
+
+    length = mSource->copyTo(mBuffer, mChunkSize);
+    chunk  = mBuffer;
+  }
+
+  int bytes = (int)length;
   int done  = (bytes == 0);
 
   if ( mSource->error() )
@@ -422,7 +447,7 @@ LibXMLParser::parseNext ()
     return false;
   }
 
-  if ( xmlParseChunk(mParser, mBuffer, bytes, done) )
+  if ( xmlParseChunk(mParser, chunk, bytes, done) )
   {
     xmlErrorPtr libxmlError = xmlGetLastError();
 
@@ -149,6 +149,7 @@ protected:
   LibXMLHandler   mHandler;
   char*           mBuffer;
   XMLBuffer*      mSource;
+  unsigned int    mBufferSize;
 
 
 private:
@@ -41,6 +41,7 @@
  * also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <cstddef>
 #include <sbml/xml/XMLBuffer.h>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
@@ -60,5 +61,18 @@ XMLBuffer::~XMLBuffer ()
 {
 }
 
+
+/*
+ * Returns a pointer to the next block of at most bytes bytes of this
+ * XMLBuffer, or NULL if the content is not held in memory.  This default
+ * implementation always returns NULL.
+ */
+const char*
+XMLBuffer::nextChunk (unsigned int /*bytes*/, unsigned int& length)
+{
+  length = 0;
+  return NULL;
+}
+
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
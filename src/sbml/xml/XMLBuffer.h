@@ -67,6 +67,25 @@ public:
   virtual unsigned int copyTo (void* destination, unsigned int bytes) = 0;
 
 
+  /**
+   * Returns a pointer to the next block of at most @p bytes bytes of this
+   * XMLBuffer and moves past it, so that the block can be handed to a
+   * parser without first being copied.
+   *
+   * Buffers that do not hold their content in memory return @c NULL, and
+   * callers should then use copyTo() instead.  The block remains valid
+   * until this XMLBuffer is destroyed.
+   *
+   * @param bytes the maximum number of bytes to return.
+   * @param length set to the number of bytes in the block (0 at the end of
+   * the buffer).
+   *
+   * @return a pointer to the block, or @c NULL if this XMLBuffer cannot
+   * hand out its content directly.
+   */
+  virtual const char* nextChunk (unsigned int bytes, unsigned int& length);
+
+
   /**
    * Returns @c true if there was an error reading from the underlying buffer,
    * @c false otherwise.
@@ -59,7 +59,9 @@ class XMLParser;
 XMLInputStream::XMLInputStream (  const char*   content
                                 , bool          isFile
                                 , const std::string  library 
-                                , XMLErrorLog*  errorLog ) :
+                                , XMLErrorLog*  errorLog
+                                , unsigned int  chunkSize
+                                , size_t        memoryMapThreshold ) :
 
 
    mIsError ( false )
@@ -72,6 +74,8 @@ XMLInputStream::XMLInputStream (  const char*   content
 
   if ( !isGood() ) return;
   if ( errorLog != NULL ) setErrorLog(errorLog);
+  if ( chunkSize > 0 ) mParser->setChunkSize(chunkSize);
+  mParser->setMemoryMapThreshold(memoryMapThreshold);
   // if this fails we should probably flag the stream as error
   if (!mParser->parseFirst(content, isFile))
     mIsError = true; 
@@ -151,12 +151,21 @@ public:
    *
    * @param errorLog the XMLErrorLog object to use.
    *
+   * @param chunkSize the number of bytes to read from @p content at a
+   * time, or @c 0 to use the default of the parser.
+   *
+   * @param memoryMapThreshold the size from which an uncompressed file is
+   * memory-mapped rather than read through a stream, or @c 0 to never map
+   * files.
+   *
    * @ifnot hasDefaultArgs @htmlinclude warn-default-args-in-docs.html @endif@~
    */
   XMLInputStream (  const char*        content
                   , bool               isFile   = true
                   , const std::string  library  = "" 
-                  , XMLErrorLog*       errorLog = NULL );
+                  , XMLErrorLog*       errorLog = NULL
+                  , unsigned int       chunkSize = 0
+                  , size_t             memoryMapThreshold = 0 );
 
 
   /**
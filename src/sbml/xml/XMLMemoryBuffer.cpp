@@ -97,6 +97,27 @@ XMLMemoryBuffer::copyTo (void* destination, unsigned int bytes)
 }
 
 
+/*
+ * Returns a pointer to the next block of at most nbytes of this
+ * XMLMemoryBuffer and moves past it.
+ */
+const char*
+XMLMemoryBuffer::nextChunk (unsigned int bytes, unsigned int& length)
+{
+  length = 0;
+  if (mBuffer == NULL) return NULL;
+
+  if (mOffset > mLength) return mBuffer + mLength;
+  if (mOffset + bytes > mLength) bytes = mLength - mOffset;
+
+  const char* chunk = mBuffer + mOffset;
+  mOffset += bytes;
+  length   = bytes;
+
+  return chunk;
+}
+
+
 /*
  * @return @c true if there was an error reading from the underlying buffer
  * (i.e. it's null), false otherwise.
@@ -76,6 +76,16 @@ public:
   virtual unsigned int copyTo (void* destination, unsigned int bytes);
 
 
+  /**
+   * Returns a pointer to the next block of at most nbytes of this
+   * XMLMemoryBuffer and moves past it.
+   *
+   * @return a pointer into the local copy of the buffer, or @c NULL if
+   * there was an error.
+   */
+  virtual const char* nextChunk (unsigned int bytes, unsigned int& length);
+
+
   /**
    * Returns @c true if there was an error reading from the underlying buffer
    * (i.e. it's null), @c false otherwise.
@@ -0,0 +1,221 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLMmapBuffer.cpp
+ * @brief   XMLMmapBuffer implements the XMLBuffer interface for mapped files
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <cstring>
+#include <sbml/xml/XMLMmapBuffer.h>
+
+#if defined(WIN32) && !defined(CYGWIN)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#endif
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Mapping an empty file fails on most platforms, so empty files are
+ * represented by this (empty) block instead.
+ */
+static const char EMPTY_FILE[] = "";
+
+
+/*
+ * Creates a XMLBuffer based on the given file.  The whole file is mapped
+ * into memory read-only, so that its content can be handed to the parser
+ * without being copied.
+ */
+XMLMmapBuffer::XMLMmapBuffer (const string& filename) :
+   mData  ( NULL  )
+ , mLength( 0     )
+ , mOffset( 0     )
+ , mError ( true  )
+#if defined(WIN32) && !defined(CYGWIN)
+ , mFile   ( INVALID_HANDLE_VALUE )
+ , mMapping( NULL )
+#endif
+{
+#if defined(WIN32) && !defined(CYGWIN)
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN,
+                            NULL);
+  if (file == INVALID_HANDLE_VALUE) return;
+  mFile = file;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) return;
+
+  if (size.QuadPart == 0)
+  {
+    mData  = EMPTY_FILE;
+    mError = false;
+    return;
+  }
+
+  if ((unsigned long long)size.QuadPart > (size_t)-1) return;
+
+  HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+  if (mapping == NULL) return;
+  mMapping = mapping;
+
+  void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+  if (data == NULL) return;
+
+  mData   = static_cast<const char*>(data);
+  mLength = (size_t)size.QuadPart;
+  mError  = false;
+#else
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0) return;
+
+  struct stat info;
+  if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode))
+  {
+    close(fd);
+    return;
+  }
+
+  if (info.st_size == 0)
+  {
+    close(fd);
+    mData  = EMPTY_FILE;
+    mError = false;
+    return;
+  }
+
+  void* data = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+  // the mapping keeps its own reference to the file
+  close(fd);
+
+  if (data == MAP_FAILED) return;
+
+#ifdef MADV_SEQUENTIAL
+  // the parser reads the file once, front to back: ask for aggressive
+  // read-ahead and let the kernel drop pages behind the parser
+  madvise(data, (size_t)info.st_size, MADV_SEQUENTIAL);
+#endif
+
+  mData   = static_cast<const char*>(data);
+  mLength = (size_t)info.st_size;
+  mError  = false;
+#endif
+}
+
+
+/*
+ * Destroys this XMLMmapBuffer and unmaps the underlying file.
+ */
+XMLMmapBuffer::~XMLMmapBuffer ()
+{
+#if defined(WIN32) && !defined(CYGWIN)
+  if (mData != NULL && mData != EMPTY_FILE) UnmapViewOfFile(mData);
+  if (mMapping != NULL) CloseHandle(mMapping);
+  if (mFile != INVALID_HANDLE_VALUE) CloseHandle(mFile);
+#else
+  if (mData != NULL && mData != EMPTY_FILE)
+  {
+    munmap(const_cast<char*>(mData), mLength);
+  }
+#endif
+}
+
+
+/*
+ * Copies at most nbytes from this XMLMmapBuffer to the memory pointed
+ * to by destination.
+ *
+ * @return the number of bytes actually copied (may be 0).
+ */
+unsigned int
+XMLMmapBuffer::copyTo (void* destination, unsigned int bytes)
+{
+  unsigned int length;
+  const char*  chunk = nextChunk(bytes, length);
+
+  if (chunk == NULL) return 0;
+
+  memcpy(destination, chunk, length);
+  return length;
+}
+
+
+/*
+ * Returns a pointer to the next block of at most nbytes of the mapped
+ * file and moves past it.
+ */
+const char*
+XMLMmapBuffer::nextChunk (unsigned int bytes, unsigned int& length)
+{
+  length = 0;
+  if (mData == NULL) return NULL;
+
+  if (bytes > mLength - mOffset) bytes = (unsigned int)(mLength - mOffset);
+
+  const char* chunk = mData + mOffset;
+  mOffset += bytes;
+  length   = bytes;
+
+  return chunk;
+}
+
+
+/*
+ * @return @c true if the file could not be opened or mapped, @c false
+ * otherwise.
+ */
+bool
+XMLMmapBuffer::error ()
+{
+  return mError;
+}
+
+
+/*
+ * @return the start of the mapped file.
+ */
+const char*
+XMLMmapBuffer::getData () const
+{
+  return mData;
+}
+
+
+/*
+ * @return the size of the mapped file.
+ */
+size_t
+XMLMmapBuffer::getSize () const
+{
+  return mLength;
+}
+
+
+LIBSBML_CPP_NAMESPACE_END
+/** @endcond */
@@ -0,0 +1,121 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLMmapBuffer.h
+ * @brief   XMLMmapBuffer implements the XMLBuffer interface for mapped files
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#ifndef XMLMmapBuffer_h
+#define XMLMmapBuffer_h
+
+#include <cstddef>
+#include <string>
+#include <sbml/xml/XMLBuffer.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class XMLMmapBuffer : public XMLBuffer
+{
+public:
+
+  /**
+   * Creates a XMLBuffer based on the given file.  The whole file is mapped
+   * into memory read-only, so that its content can be handed to the parser
+   * without being copied.  The file must not be compressed.
+   *
+   * The mapping is marked for sequential access, so that the system reads
+   * ahead of the parser and can release pages it has passed.
+   */
+  XMLMmapBuffer (const std::string& filename);
+
+
+  /**
+   * Destroys this XMLMmapBuffer and unmaps the underlying file.
+   */
+  virtual ~XMLMmapBuffer ();
+
+
+  /**
+   * Copies at most nbytes from this XMLMmapBuffer to the memory pointed
+   * to by destination.
+   *
+   * @return the number of bytes actually copied (may be 0).
+   */
+  virtual unsigned int copyTo (void* destination, unsigned int bytes);
+
+
+  /**
+   * Returns a pointer to the next block of at most nbytes of the mapped
+   * file and moves past it.
+   *
+   * @return a pointer into the mapped file, or @c NULL if the file could
+   * not be mapped.
+   */
+  virtual const char* nextChunk (unsigned int bytes, unsigned int& length);
+
+
+  /**
+   * Returns @c true if the file could not be opened or mapped, @c false
+   * otherwise.
+   *
+   * @return @c true if there was an error reading from the underlying file,
+   * @c false otherwise.
+   */
+  virtual bool error ();
+
+
+  /**
+   * Returns the start of the mapped file, for parsers that read the whole
+   * file from memory themselves.
+   *
+   * @return a pointer to the mapped file, or @c NULL if the file could not
+   * be mapped.
+   */
+  const char* getData () const;
+
+
+  /**
+   * Returns the size of the mapped file in bytes.
+   *
+   * @return the size of the mapped file.
+   */
+  size_t getSize () const;
+
+
+private:
+
+  XMLMmapBuffer ();
+  XMLMmapBuffer (const XMLMmapBuffer&);
+  XMLMmapBuffer& operator= (const XMLMmapBuffer&);
+
+
+  const char*  mData;
+  size_t       mLength;
+  size_t       mOffset;
+  bool         mError;
+
+#if defined(WIN32) && !defined(CYGWIN)
+  void*        mFile;
+  void*        mMapping;
+#endif
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* XMLMmapBuffer_h */
+/** @endcond */
@@ -0,0 +1,119 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLOutputSink.cpp
+ * @brief   XMLOutputSink collects XML output in a contiguous buffer
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <limits>
+#include <sbml/xml/XMLOutputSink.h>
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * Creates a sink that writes to the given stream in blocks of capacity
+ * bytes.
+ */
+XMLOutputSink::XMLOutputSink (std::ostream& stream, size_t capacity) :
+   std::ostream  ( NULL    )
+ , mStreamBuffer ( *this   )
+ , mStream       ( &stream )
+ , mOut          ( &mBuffer )
+ , mCapacity     ( capacity > 0 ? capacity : 1 )
+{
+  rdbuf(&mStreamBuffer);
+  mBuffer.reserve(mCapacity);
+}
+
+
+/*
+ * Creates a sink that appends everything to the given string.
+ */
+XMLOutputSink::XMLOutputSink (std::string& target) :
+   std::ostream  ( NULL    )
+ , mStreamBuffer ( *this   )
+ , mStream       ( NULL    )
+ , mOut          ( &target )
+ , mCapacity     ( numeric_limits<size_t>::max() )
+{
+  rdbuf(&mStreamBuffer);
+}
+
+
+/*
+ * Writes the pending output to the underlying stream and destroys this
+ * sink.
+ */
+XMLOutputSink::~XMLOutputSink ()
+{
+  try
+  {
+    flushBuffer();
+  }
+  catch (...)
+  {
+  }
+}
+
+
+/*
+ * Writes the pending output to the underlying stream.
+ */
+void
+XMLOutputSink::flushBuffer ()
+{
+  if (mStream == NULL || mBuffer.empty()) return;
+
+  mStream->write(mBuffer.data(), (streamsize)mBuffer.size());
+  mBuffer.clear();
+}
+
+
+/*
+ * Appends a single character written through the std::ostream interface.
+ * The buffer is not flushed here, so that errors of the underlying stream
+ * surface from append() or flushBuffer() rather than being swallowed by
+ * the std::ostream operator.
+ */
+XMLOutputSink::Buffer::int_type
+XMLOutputSink::Buffer::overflow (int_type c)
+{
+  if (!traits_type::eq_int_type(c, traits_type::eof()))
+  {
+    mSink.mOut->push_back(traits_type::to_char_type(c));
+  }
+
+  return traits_type::not_eof(c);
+}
+
+
+/*
+ * Appends characters written through the std::ostream interface.
+ */
+std::streamsize
+XMLOutputSink::Buffer::xsputn (const char* chars, std::streamsize n)
+{
+  mSink.mOut->append(chars, (size_t)n);
+  return n;
+}
+
+LIBSBML_CPP_NAMESPACE_END
+
+/** @endcond */
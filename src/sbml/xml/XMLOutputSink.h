@@ -0,0 +1,149 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    XMLOutputSink.h
+ * @brief   XMLOutputSink collects XML output in a contiguous buffer
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution and
+ * also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#ifndef XMLOutputSink_h
+#define XMLOutputSink_h
+
+#include <cstddef>
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <sbml/common/extern.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * An output stream that collects everything written to it in one large
+ * buffer.  The buffer is written to an underlying stream (a file, a string
+ * stream or one of the compressing streams) in blocks of the given
+ * capacity, or, if the sink was created for a string, everything goes
+ * straight into that string.
+ *
+ * XMLOutputStream recognizes a sink and calls append() directly, which
+ * skips the sentry and locale handling that std::ostream goes through
+ * for every character.  Anything written through the std::ostream
+ * interface ends up in the same buffer, in order.
+ */
+class XMLOutputSink : public std::ostream
+{
+public:
+
+  /**
+   * The number of bytes collected before they are written to the
+   * underlying stream.
+   */
+  static const size_t DEFAULT_CAPACITY = 65536;
+
+
+  /**
+   * Creates a sink that writes to the given stream in blocks of
+   * @p capacity bytes.
+   */
+  XMLOutputSink (std::ostream& stream, size_t capacity = DEFAULT_CAPACITY);
+
+
+  /**
+   * Creates a sink that appends everything to the given string.
+   */
+  explicit XMLOutputSink (std::string& target);
+
+
+  /**
+   * Writes the pending output to the underlying stream and destroys this
+   * sink.  Errors from the underlying stream are ignored here; call
+   * flushBuffer() first to see them.
+   */
+  virtual ~XMLOutputSink ();
+
+
+  /**
+   * Appends the given character.
+   */
+  void append (char c)
+  {
+    mOut->push_back(c);
+    if (mOut->size() >= mCapacity) flushBuffer();
+  }
+
+
+  /**
+   * Appends the given characters.
+   */
+  void append (const char* chars, size_t length)
+  {
+    mOut->append(chars, length);
+    if (mOut->size() >= mCapacity) flushBuffer();
+  }
+
+
+  /**
+   * Appends the given string.
+   */
+  void append (const std::string& chars)
+  {
+    append(chars.data(), chars.size());
+  }
+
+
+  /**
+   * Writes the pending output to the underlying stream.  This does nothing
+   * for a sink that writes to a string.
+   *
+   * Exceptions the underlying stream is set up to throw are passed on.
+   */
+  void flushBuffer ();
+
+
+private:
+
+  /*
+   * The stream buffer behind the std::ostream interface.  It has no put
+   * area of its own, so every write lands in the sink's buffer.
+   */
+  class Buffer : public std::streambuf
+  {
+  public:
+    Buffer (XMLOutputSink& sink) : mSink(sink) { }
+
+  protected:
+    virtual int_type overflow (int_type c);
+    virtual std::streamsize xsputn (const char* chars, std::streamsize n);
+
+  private:
+    XMLOutputSink& mSink;
+  };
+
+  XMLOutputSink (const XMLOutputSink&);
+  XMLOutputSink& operator= (const XMLOutputSink&);
+
+
+  Buffer        mStreamBuffer;
+  std::ostream* mStream;
+  std::string   mBuffer;
+  std::string*  mOut;
+  size_t        mCapacity;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* XMLOutputSink_h */
+/** @endcond */
@@ -46,8 +46,10 @@
 #include <fstream>
 
 #include <cstdio>
+#include <cstring>
 #include <sbml/xml/XMLTriple.h>
 #include <sbml/xml/XMLOutputStream.h>
+#include <sbml/xml/XMLOutputSink.h>
 #include <sbml/xml/XMLAttributes.h>
 #include <sbml/xml/XMLConstructorException.h>
 #include <sbml/util/util.h>
@@ -185,6 +187,412 @@ bool hasPredefinedEntity(const std::string &chars, size_t index)
 }   
 
 
+/*
+ * The powers of ten that are exactly representable as doubles.  The
+ * product or quotient of one of them and an integer below 2^53 is the
+ * correctly rounded value of the corresponding decimal, which is what
+ * strtod() returns for it.
+ */
+static const double POWERS_OF_TEN[] =
+{
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const int    MAX_POWER_OF_TEN = 22;
+static const double TWO_TO_THE_53    = 9007199254740992.0;
+
+
+/*
+ * Finds the shortest integer digits such that digits * 10^exponent reads
+ * back as the given positive value, for the values where this can be
+ * decided with exact double arithmetic.  Returns false for the others.
+ */
+static bool
+findShortestDecimal (double value, unsigned long long& digits, int& exponent)
+{
+  if (value < TWO_TO_THE_53)
+  {
+    for (int k = 0; k <= MAX_POWER_OF_TEN; ++k)
+    {
+      const double scaled = value * POWERS_OF_TEN[k];
+      if (scaled >= TWO_TO_THE_53) break;
+
+      const unsigned long long n = (unsigned long long)(scaled + 0.5);
+      if ((double)n / POWERS_OF_TEN[k] == value)
+      {
+        digits   = n;
+        exponent = -k;
+        return true;
+      }
+    }
+  }
+  else
+  {
+    for (int k = 1; k <= MAX_POWER_OF_TEN; ++k)
+    {
+      const double scaled = value / POWERS_OF_TEN[k];
+      if (scaled >= TWO_TO_THE_53) continue;
+
+      const unsigned long long n = (unsigned long long)(scaled + 0.5);
+      if ((double)n * POWERS_OF_TEN[k] == value)
+      {
+        digits   = n;
+        exponent = k;
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+
+/*
+ * Writes the significant digits, whose first digit stands for
+ * 10^exponent, the way printf("%.<precision>g") lays them out.
+ */
+static unsigned int
+layoutDecimal (  char*       buffer
+               , bool        negative
+               , const char* digits
+               , int         numDigits
+               , int         exponent )
+{
+  const int precision = (numDigits > 15) ? numDigits : 15;
+  char*     p         = buffer;
+
+  if (negative) *p++ = '-';
+
+  if (exponent < -4 || exponent >= precision)
+  {
+    *p++ = digits[0];
+    if (numDigits > 1)
+    {
+      *p++ = '.';
+      for (int i = 1; i < numDigits; ++i) *p++ = digits[i];
+    }
+
+    *p++ = 'e';
+    *p++ = (exponent < 0) ? '-' : '+';
+
+    int magnitude = (exponent < 0) ? -exponent : exponent;
+    if (magnitude >= 100) *p++ = (char)('0' + magnitude / 100);
+    *p++ = (char)('0' + (magnitude / 10) % 10);
+    *p++ = (char)('0' + magnitude % 10);
+  }
+  else if (exponent >= 0)
+  {
+    for (int i = 0; i <= exponent; ++i)
+    {
+      *p++ = (i < numDigits) ? digits[i] : '0';
+    }
+    if (numDigits > exponent + 1)
+    {
+      *p++ = '.';
+      for (int i = exponent + 1; i < numDigits; ++i) *p++ = digits[i];
+    }
+  }
+  else
+  {
+    *p++ = '0';
+    *p++ = '.';
+    for (int i = exponent + 1; i < 0; ++i) *p++ = '0';
+    for (int i = 0; i < numDigits; ++i) *p++ = digits[i];
+  }
+
+  *p = '\0';
+  return (unsigned int)(p - buffer);
+}
+
+
+/*
+ * Normalized 64-bit approximations of 10^-348, 10^-340, ..., 10^340, as
+ * used by the Grisu algorithm (F. Loitsch, "Printing Floating-Point
+ * Numbers Quickly and Accurately with Integers", PLDI 2010).  Each power
+ * is CACHED_POWER_F[i] * 2^CACHED_POWER_E[i].
+ */
+static const unsigned long long CACHED_POWER_F[] =
+{
+  0xfa8fd5a0081c0288ULL, 0xbaaee17fa23ebf76ULL, 0x8b16fb203055ac76ULL,
+  0xcf42894a5dce35eaULL, 0x9a6bb0aa55653b2dULL, 0xe61acf033d1a45dfULL,
+  0xab70fe17c79ac6caULL, 0xff77b1fcbebcdc4fULL, 0xbe5691ef416bd60cULL,
+  0x8dd01fad907ffc3cULL, 0xd3515c2831559a83ULL, 0x9d71ac8fada6c9b5ULL,
+  0xea9c227723ee8bcbULL, 0xaecc49914078536dULL, 0x823c12795db6ce57ULL,
+  0xc21094364dfb5637ULL, 0x9096ea6f3848984fULL, 0xd77485cb25823ac7ULL,
+  0xa086cfcd97bf97f4ULL, 0xef340a98172aace5ULL, 0xb23867fb2a35b28eULL,
+  0x84c8d4dfd2c63f3bULL, 0xc5dd44271ad3cdbaULL, 0x936b9fcebb25c996ULL,
+  0xdbac6c247d62a584ULL, 0xa3ab66580d5fdaf6ULL, 0xf3e2f893dec3f126ULL,
+  0xb5b5ada8aaff80b8ULL, 0x87625f056c7c4a8bULL, 0xc9bcff6034c13053ULL,
+  0x964e858c91ba2655ULL, 0xdff9772470297ebdULL, 0xa6dfbd9fb8e5b88fULL,
+  0xf8a95fcf88747d94ULL, 0xb94470938fa89bcfULL, 0x8a08f0f8bf0f156bULL,
+  0xcdb02555653131b6ULL, 0x993fe2c6d07b7facULL, 0xe45c10c42a2b3b06ULL,
+  0xaa242499697392d3ULL, 0xfd87b5f28300ca0eULL, 0xbce5086492111aebULL,
+  0x8cbccc096f5088ccULL, 0xd1b71758e219652cULL, 0x9c40000000000000ULL,
+  0xe8d4a51000000000ULL, 0xad78ebc5ac620000ULL, 0x813f3978f8940984ULL,
+  0xc097ce7bc90715b3ULL, 0x8f7e32ce7bea5c70ULL, 0xd5d238a4abe98068ULL,
+  0x9f4f2726179a2245ULL, 0xed63a231d4c4fb27ULL, 0xb0de65388cc8ada8ULL,
+  0x83c7088e1aab65dbULL, 0xc45d1df942711d9aULL, 0x924d692ca61be758ULL,
+  0xda01ee641a708deaULL, 0xa26da3999aef774aULL, 0xf209787bb47d6b85ULL,
+  0xb454e4a179dd1877ULL, 0x865b86925b9bc5c2ULL, 0xc83553c5c8965d3dULL,
+  0x952ab45cfa97a0b3ULL, 0xde469fbd99a05fe3ULL, 0xa59bc234db398c25ULL,
+  0xf6c69a72a3989f5cULL, 0xb7dcbf5354e9beceULL, 0x88fcf317f22241e2ULL,
+  0xcc20ce9bd35c78a5ULL, 0x98165af37b2153dfULL, 0xe2a0b5dc971f303aULL,
+  0xa8d9d1535ce3b396ULL, 0xfb9b7cd9a4a7443cULL, 0xbb764c4ca7a44410ULL,
+  0x8bab8eefb6409c1aULL, 0xd01fef10a657842cULL, 0x9b10a4e5e9913129ULL,
+  0xe7109bfba19c0c9dULL, 0xac2820d9623bf429ULL, 0x80444b5e7aa7cf85ULL,
+  0xbf21e44003acdd2dULL, 0x8e679c2f5e44ff8fULL, 0xd433179d9c8cb841ULL,
+  0x9e19db92b4e31ba9ULL, 0xeb96bf6ebadf77d9ULL, 0xaf87023b9bf0ee6bULL
+};
+
+static const short CACHED_POWER_E[] =
+{
+  -1220, -1193, -1166, -1140, -1113, -1087, -1060, -1034, -1007,  -980,
+   -954,  -927,  -901,  -874,  -847,  -821,  -794,  -768,  -741,  -715,
+   -688,  -661,  -635,  -608,  -582,  -555,  -529,  -502,  -475,  -449,
+   -422,  -396,  -369,  -343,  -316,  -289,  -263,  -236,  -210,  -183,
+   -157,  -130,  -103,   -77,   -50,   -24,     3,    30,    56,    83,
+    109,   136,   162,   189,   216,   242,   269,   295,   322,   348,
+    375,   402,   428,   455,   481,   508,   534,   561,   588,   614,
+    641,   667,   694,   720,   747,   774,   800,   827,   853,   880,
+    907,   933,   960,   986,  1013,  1039,  1066
+};
+
+
+/*
+ * A floating-point number f * 2^e with a 64-bit significand.
+ */
+struct DiyFp
+{
+  unsigned long long f;
+  int                e;
+
+  DiyFp (unsigned long long f_, int e_) : f(f_), e(e_) { }
+
+  DiyFp operator- (const DiyFp& rhs) const
+  {
+    return DiyFp(f - rhs.f, e);
+  }
+
+  /* the upper 64 bits of the 128-bit product, rounded */
+  DiyFp operator* (const DiyFp& rhs) const
+  {
+    const unsigned long long M32 = 0xFFFFFFFFULL;
+
+    const unsigned long long a = f >> 32, b = f & M32;
+    const unsigned long long c = rhs.f >> 32, d = rhs.f & M32;
+
+    const unsigned long long ac = a * c, bc = b * c, ad = a * d, bd = b * d;
+
+    unsigned long long tmp = (bd >> 32) + (ad & M32) + (bc & M32);
+    tmp += 1ULL << 31;
+
+    return DiyFp(ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), e + rhs.e + 64);
+  }
+
+  DiyFp normalize () const
+  {
+    DiyFp result = *this;
+    while (!(result.f & (1ULL << 63)))
+    {
+      result.f <<= 1;
+      result.e--;
+    }
+    return result;
+  }
+};
+
+
+static const unsigned long long POWERS_OF_TEN_INT[] =
+{
+  1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+  10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+  100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+  100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+  100000000000000000ULL, 1000000000000000000ULL, 10000000000000000000ULL
+};
+
+
+/*
+ * Moves the last generated digit towards the exact value, as long as the
+ * result stays inside the rounding interval.
+ */
+static void
+grisuRound (  char*              digits
+            , int                numDigits
+            , unsigned long long delta
+            , unsigned long long rest
+            , unsigned long long tenKappa
+            , unsigned long long distance )
+{
+  while (rest < distance && delta - rest >= tenKappa &&
+         (rest + tenKappa < distance ||
+          distance - rest > rest + tenKappa - distance))
+  {
+    digits[numDigits - 1]--;
+    rest += tenKappa;
+  }
+}
+
+
+/*
+ * Generates the digits of the scaled value W, stopping as soon as they
+ * identify a number within delta below the scaled upper boundary Mp.
+ */
+static void
+grisuDigitGen (  const DiyFp&       W
+               , const DiyFp&       Mp
+               , unsigned long long delta
+               , char*              digits
+               , int&               numDigits
+               , int&               K )
+{
+  const DiyFp one(1ULL << -Mp.e, Mp.e);
+  const DiyFp distance = Mp - W;
+
+  unsigned int       p1 = (unsigned int)(Mp.f >> -one.e);
+  unsigned long long p2 = Mp.f & (one.f - 1);
+
+  int kappa = 1;
+  while (kappa < 10 && p1 >= POWERS_OF_TEN_INT[kappa]) ++kappa;
+
+  numDigits = 0;
+
+  while (kappa > 0)
+  {
+    const unsigned int d = (unsigned int)(p1 / POWERS_OF_TEN_INT[kappa - 1]);
+    p1 %= (unsigned int)POWERS_OF_TEN_INT[kappa - 1];
+
+    if (d != 0 || numDigits != 0) digits[numDigits++] = (char)('0' + d);
+
+    kappa--;
+
+    const unsigned long long rest = ((unsigned long long)p1 << -one.e) + p2;
+    if (rest <= delta)
+    {
+      K += kappa;
+      grisuRound(digits, numDigits, delta, rest,
+                 POWERS_OF_TEN_INT[kappa] << -one.e, distance.f);
+      return;
+    }
+  }
+
+  for (;;)
+  {
+    p2    *= 10;
+    delta *= 10;
+
+    const char d = (char)(p2 >> -one.e);
+    if (d != 0 || numDigits != 0) digits[numDigits++] = (char)('0' + d);
+
+    p2 &= one.f - 1;
+    kappa--;
+
+    if (p2 < delta)
+    {
+      K += kappa;
+      const int index = -kappa;
+      grisuRound(digits, numDigits, delta, p2, one.f,
+                 distance.f * (index < 20 ? POWERS_OF_TEN_INT[index] : 0));
+      return;
+    }
+  }
+}
+
+
+/*
+ * Writes the significant digits of the given positive finite value with
+ * Grisu2, so that digits * 10^K reads back as the value.  The digits are
+ * the shortest ones in all but a few rare cases.
+ */
+static void
+grisu2 (double value, char* digits, int& numDigits, int& K)
+{
+  unsigned long long bits;
+  memcpy(&bits, &value, sizeof(bits));
+
+  const unsigned long long hiddenBit   = 1ULL << 52;
+  const unsigned long long significand = bits & (hiddenBit - 1);
+  const int                biasedExp   = (int)((bits >> 52) & 0x7FF);
+
+  const DiyFp v = (biasedExp != 0) ?
+    DiyFp(significand + hiddenBit, biasedExp - 1075) :
+    DiyFp(significand, -1074);
+
+  // the boundaries halfway to the neighbouring doubles
+  DiyFp plus((v.f << 1) + 1, v.e - 1);
+  plus = plus.normalize();
+
+  DiyFp minus = (v.f == hiddenBit) ?
+    DiyFp((v.f << 2) - 1, v.e - 2) : DiyFp((v.f << 1) - 1, v.e - 1);
+  minus.f <<= minus.e - plus.e;
+  minus.e   = plus.e;
+
+  // a cached power of ten that brings the exponent into [-60, -32]
+  const double dk = (-61 - plus.e) * 0.30102999566398114 + 347;
+  int k = (int)dk;
+  if (dk - k > 0.0) k++;
+
+  const unsigned int index = (unsigned int)((k >> 3) + 1);
+  const DiyFp c_mk(CACHED_POWER_F[index], CACHED_POWER_E[index]);
+  K = -(-348 + (int)index * 8);
+
+  const DiyFp W  = v.normalize() * c_mk;
+  DiyFp       Wp = plus * c_mk;
+  DiyFp       Wm = minus * c_mk;
+  Wm.f++;
+  Wp.f--;
+
+  grisuDigitGen(W, Wp, Wp.f - Wm.f, digits, numDigits, K);
+}
+
+
+/*
+ * Grisu2 may return 16 or 17 digits where 15 would do.  Rounds the digits
+ * to 15 and keeps them if they read back as the same value.  The digits
+ * are passed to strtod() without a decimal point, so that the check does
+ * not depend on the current locale.
+ */
+static void
+shortenTo15Digits (  double value
+                   , char*  digits
+                   , int&   numDigits
+                   , int&   exponent )
+{
+  char rounded[16];
+  memcpy(rounded, digits, 15);
+
+  int roundedExponent = exponent + numDigits - 15;
+
+  if (digits[15] >= '5')
+  {
+    int i = 14;
+    while (i >= 0 && rounded[i] == '9') rounded[i--] = '0';
+
+    if (i >= 0)
+    {
+      rounded[i]++;
+    }
+    else
+    {
+      rounded[0] = '1';
+      roundedExponent++;
+    }
+  }
+
+  char text[32];
+  memcpy(text, rounded, 15);
+  sprintf(text + 15, "e%d", roundedExponent);
+
+  if (strtod(text, NULL) == value)
+  {
+    memcpy(digits, rounded, 15);
+    numDigits = 15;
+    exponent  = roundedExponent;
+  }
+}
+
+
 // boolean indicating whether the comment on the top of the file is
 // written (enabled by default)
 bool XMLOutputStream::mWriteComment = true;
@@ -200,6 +608,100 @@ std::string XMLOutputStream::mLibraryName = "libSBML";
 std::string XMLOutputStream::mLibraryVersion = getLibSBMLDottedVersion();
 
 
+/*
+ * Outputs the given character to the underlying stream, or straight into
+ * its buffer if the stream is an XMLOutputSink.
+ */
+inline void
+XMLOutputStream::put (char c)
+{
+  if (mSink != NULL) mSink->append(c);
+  else mStream << c;
+}
+
+
+/*
+ * Outputs the given characters to the underlying stream or sink.
+ */
+inline void
+XMLOutputStream::put (const char* chars, size_t length)
+{
+  if (mSink != NULL) mSink->append(chars, length);
+  else mStream.write(chars, (streamsize)length);
+}
+
+
+/*
+ * Outputs the given NUL-terminated characters to the underlying stream or
+ * sink.
+ */
+inline void
+XMLOutputStream::put (const char* chars)
+{
+  put(chars, strlen(chars));
+}
+
+
+/*
+ * Outputs the given string to the underlying stream or sink.
+ */
+inline void
+XMLOutputStream::put (const std::string& chars)
+{
+  put(chars.data(), chars.size());
+}
+
+
+/*
+ * Outputs the given integer to the underlying stream or sink.  The stream
+ * uses the classic locale, so both write plain digits.
+ */
+inline void
+XMLOutputStream::putNumber (long value)
+{
+  if (mSink != NULL)
+  {
+    char buffer[24];
+    int length = snprintf(buffer, sizeof(buffer), "%ld", value);
+    mSink->append(buffer, (size_t)length);
+  }
+  else
+  {
+    mStream << value;
+  }
+}
+
+
+/*
+ * Outputs the given unsigned integer to the underlying stream or sink.
+ */
+inline void
+XMLOutputStream::putNumber (unsigned int value)
+{
+  if (mSink != NULL)
+  {
+    char buffer[24];
+    int length = snprintf(buffer, sizeof(buffer), "%u", value);
+    mSink->append(buffer, (size_t)length);
+  }
+  else
+  {
+    mStream << value;
+  }
+}
+
+
+/*
+ * Ends the current line.  A plain stream is also flushed, as before.
+ */
+inline void
+XMLOutputStream::putNewline ()
+{
+  if (mSink != NULL) mSink->append('\n');
+  else mStream << endl;
+}
+
+
 /**
  * Copy Constructor, made private so as to notify users, that copying an input stream is not supported. 
  */
@@ -213,6 +715,7 @@ XMLOutputStream::XMLOutputStream (const XMLOutputStream& other)
   , mSkipNextIndent(other.mSkipNextIndent)
   , mNextAmpersandIsRef(other.mNextAmpersandIsRef)
   , mStringStream(other.mStringStream)
+  , mSink(other.mSink)
 {
 }
 
@@ -243,6 +746,7 @@ XMLOutputStream::XMLOutputStream (  std::ostream&       stream
  , mSkipNextIndent ( false    )
  , mNextAmpersandIsRef( false )
  , mSBMLns (NULL)
+ , mSink  ( dynamic_cast<XMLOutputSink*>(&stream) )
 {
 
   unsetStringStream();
@@ -262,24 +766,24 @@ XMLOutputStream::endElement (const std::string& name, const std::string prefix)
   if (mInStart)
   {
     mInStart = false;
-    mStream << '/' << '>';
+    put("/>");
   }
   else if (mInText)
   {
     mInText = false;
     mSkipNextIndent = false;
-    mStream << '<' << '/';
+    put("</");
     writeName(name, prefix);
-    mStream << '>';
+    put('>');
   }
   else
   {
     downIndent();
     writeIndent(true); 
 
-    mStream << '<' << '/';
+    put("</");
     writeName(name, prefix);
-    mStream << '>';
+    put('>');
   }
 }
 
@@ -295,24 +799,24 @@ XMLOutputStream::endElement (const XMLTriple& triple, bool text)
   if (mInStart)
   {
     mInStart = false;
-    mStream << '/' << '>';
+    put("/>");
   }
   else if (mInText || text)
   {
     mInText = false;
     mSkipNextIndent = false;
-    mStream << '<' << '/';
+    put("</");
     writeName(triple);
-    mStream << '>';
+    put('>');
   }
   else
   {
     downIndent();
     writeIndent(true); 
 
-    mStream << '<' << '/';
+    put("</");
     writeName(triple);
-    mStream << '>';
+    put('>');
   }
 }
 
@@ -336,7 +840,7 @@ XMLOutputStream::startElement (const std::string& name, const std::string prefix
 
   if (mInStart)
   {
-    mStream << '>';
+    put('>');
     upIndent();
   }
 
@@ -351,7 +855,7 @@ XMLOutputStream::startElement (const std::string& name, const std::string prefix
     writeIndent();
   }
 
-  mStream << '<';
+  put('<');
   writeName(name, prefix);
 }
 
@@ -366,7 +870,7 @@ XMLOutputStream::startElement (const XMLTriple& triple)
 
   if (mInStart)
   {
-    mStream << '>';
+    put('>');
     upIndent();
   }
 
@@ -381,7 +885,7 @@ XMLOutputStream::startElement (const XMLTriple& triple)
     writeIndent();
   }
 
-  mStream << '<';
+  put('<');
   writeName(triple);
 }
 
@@ -395,7 +899,7 @@ XMLOutputStream::startEndElement (const std::string& name, const std::string pre
 
   if (mInStart)
   {
-    mStream << '>';
+    put('>');
     upIndent();
   }
 
@@ -413,9 +917,9 @@ XMLOutputStream::startEndElement (const std::string& name, const std::string pre
     writeIndent();
   }
 
-  mStream << '<';
+  put('<');
   writeName(name, prefix);
-  mStream << '/' << '>';
+  put("/>");
 }
 
 
@@ -429,7 +933,7 @@ XMLOutputStream::startEndElement (const XMLTriple& triple)
 
   if (mInStart)
   {
-    mStream << '>';
+    put('>');
     upIndent();
   }
 
@@ -447,9 +951,9 @@ XMLOutputStream::startEndElement (const XMLTriple& triple)
     writeIndent();
   }
 
-  mStream << '<';
+  put('<');
   writeName(triple);
-  mStream << '/' << '>';
+  put("/>");
 }
 
 
@@ -461,7 +965,7 @@ XMLOutputStream::writeAttribute (const std::string& name, const std::string& val
 {
   if ( value.empty() ) return; 
 
-  mStream << ' ';
+  put(' ');
 
   writeName ( name  );
   writeValue( value );
@@ -476,7 +980,7 @@ XMLOutputStream::writeAttribute (const std::string& name, const std::string& pre
 {
   if ( value.empty() ) return;
 
-  mStream << ' ';
+  put(' ');
 
   writeName ( name , prefix );
   writeValue( value );
@@ -490,7 +994,7 @@ XMLOutputStream::writeAttribute (const std::string& name, const std::string& pre
 void
 XMLOutputStream::writeAttribute (const XMLTriple& triple, const std::string& value)
 {
-  mStream << ' ';
+  put(' ');
 
   writeName ( triple );
   writeValue( value  );
@@ -505,7 +1009,7 @@ XMLOutputStream::writeAttribute (const std::string& name, const char* value)
 {
   if ( !value || strcmp(value,"") == 0) return;
 
-  mStream << ' ';
+  put(' ');
   
   writeName ( name  );
   writeValue( value );
@@ -520,7 +1024,7 @@ XMLOutputStream::writeAttribute (const std::string& name, const std::string& pre
 {
   if ( !value || strcmp(value,"") == 0) return;
 
-  mStream << ' ';
+  put(' ');
 
   writeName ( name , prefix );
   writeValue( value );
@@ -536,7 +1040,7 @@ XMLOutputStream::writeAttribute (const XMLTriple& triple, const char* value)
 {
   if ( !value || strcmp(value,"") == 0) return;
 
-  mStream << ' ';
+  put(' ');
 
   writeName ( triple );
   writeValue( value  );
@@ -551,7 +1055,7 @@ void
 XMLOutputStream::writeAttribute (const std::string& name, const bool& value)
 {
 
-  mStream << ' ';
+  put(' ');
 
   writeName ( name  );
   writeValue( value );
@@ -565,7 +1069,7 @@ XMLOutputStream::writeAttribute (const std::string& name, const bool& value)
 void
 XMLOutputStream::writeAttribute (const std::string& name, const std::string& prefix, const bool& value)
 {
-  mStream << ' ';
+  put(' ');
 
   writeName ( name , prefix );
   writeValue( value );
@@ -580,7 +1084,7 @@ void
 XMLOutputStream::writeAttribute (const XMLTriple& triple, const bool& value)
 {
 
-  mStream << ' ';
+  put(' ');
 
   writeName ( triple );
   writeValue( value  );
@@ -594,7 +1098,7 @@ void
 XMLOutputStream::writeAttribute (const std::string& name, const double& value)
 {
 
-  mStream << ' ';
+  put(' ');
 
   writeName ( name  );
   writeValue( value );
@@ -607,7 +1111,7 @@ XMLOutputStream::writeAttribute (const std::string& name, const double& value)
 void
 XMLOutputStream::writeAttribute (const std::string& name, const std::string& prefix, const double& value)
 {
-  mStream << ' ';
+  put(' ');
 
   writeName ( name , prefix );
   writeValue( value );
@@ -620,7 +1124,7 @@ XMLOutputStream::writeAttribute (const std::string& name, const std::string& pre
 void
 XMLOutputStream::writeAttribute (const XMLTriple& triple, const double& value)
 {
-  mStream << ' ';
+  put(' ');
 
   writeName ( triple );
   writeValue( value  );
@@ -634,7 +1138,7 @@ void
 XMLOutputStream::writeAttribute (const std::string& name, const long& value)
 {
 
-  mStream << ' ';
+  put(' ');
 
   writeName ( name  );
   writeValue( value );
@@ -647,7 +1151,7 @@ XMLOutputStream::writeAttribute (const std::string& name, const long& value)
 void
 XMLOutputStream::writeAttribute (const std::string& name, const std::string& prefix, const long& value)
 {
-  mStream << ' ';
+  put(' ');
 
   writeName ( name , prefix );
   writeValue( value );
@@ -661,7 +1165,7 @@ XMLOutputStream::writeAttribute (const std::string& name, const std::string& pre
 void
 XMLOutputStream::writeAttribute (const XMLTriple& triple, const long& value)
 {
-  mStream << ' ';
+  put(' ');
 
   writeName ( triple );
   writeValue( value  );
@@ -675,7 +1179,7 @@ void
 XMLOutputStream::writeAttribute (const std::string& name, const int& value)
 {
 
-  mStream << ' ';
+  put(' ');
 
   writeName ( name  );
   writeValue( value );
@@ -688,7 +1192,7 @@ XMLOutputStream::writeAttribute (const std::string& name, const int& value)
 void
 XMLOutputStream::writeAttribute (const std::string& name, const std::string& prefix, const int& value)
 {
-  mStream << ' ';
+  put(' ');
 
   writeName ( name , prefix );
   writeValue( value );
@@ -703,7 +1207,7 @@ void
 XMLOutputStream::writeAttribute (const XMLTriple& triple, const int& value)
 {
 
-  mStream << ' ';
+  put(' ');
 
   writeName ( triple );
   writeValue( value  );
@@ -717,7 +1221,7 @@ void
 XMLOutputStream::writeAttribute (const std::string& name, const unsigned int& value)
 {
 
-  mStream << ' ';
+  put(' ');
 
   writeName ( name  );
   writeValue( value );
@@ -730,7 +1234,7 @@ XMLOutputStream::writeAttribute (const std::string& name, const unsigned int& va
 void
 XMLOutputStream::writeAttribute (const std::string& name, const std::string& prefix, const unsigned int& value)
 {
-  mStream << ' ';
+  put(' ');
 
   writeName ( name , prefix );
   writeValue( value );
@@ -746,7 +1250,7 @@ XMLOutputStream::writeAttribute (  const XMLTriple&     triple
                                  , const unsigned int&  value )
 {
 
-  mStream << ' ';
+  put(' ');
 
   writeName ( triple );
   writeValue( value  );
@@ -786,8 +1290,8 @@ XMLOutputStream::writeIndent (bool isEnd)
 {
   if (mDoIndent)
   {
-    if (mIndent > 0 || isEnd) mStream << endl;
-    for (unsigned int n = 0; n < mIndent; ++n) mStream << ' ' << ' ';
+    if (mIndent > 0 || isEnd) putNewline();
+    for (unsigned int n = 0; n < mIndent; ++n) put("  ");
   }
 }
 
@@ -798,9 +1302,17 @@ XMLOutputStream::writeIndent (bool isEnd)
 void
 XMLOutputStream::writeChars (const std::string& chars)
 {
+  // runs of characters that need no escaping are written in one go
+  size_t start = 0;
+
   for (size_t i=0; i < chars.length(); i++)
   {
     const char& c = chars.at(i);
+    if (c != '&' && c != '<' && c != '>' && c != '"' && c != '\'') continue;
+
+    if (i > start) put(chars.data() + start, i - start);
+    start = i + 1;
+
     if ( c == '&' && 
         (LIBSBML_CPP_NAMESPACE ::hasCharacterReference(chars, i) || 
          LIBSBML_CPP_NAMESPACE ::hasPredefinedEntity(chars,i)) )
@@ -808,6 +1320,11 @@ XMLOutputStream::writeChars (const std::string& chars)
 
     *this << c;
   }
+
+  if (chars.length() > start)
+  {
+    put(chars.data() + start, chars.length() - start);
+  }
 }
 
 
@@ -820,7 +1337,7 @@ XMLOutputStream::writeName (const std::string& name, const std::string prefix)
   if ( !prefix.empty() )
   {
     writeChars( prefix );
-    mStream << ':';
+    put(':');
   }
 
   writeChars(name);
@@ -836,7 +1353,7 @@ XMLOutputStream::writeName (const XMLTriple& triple)
   if ( !triple.getPrefix().empty() )
   {
     writeChars( triple.getPrefix() );
-    mStream << ':';
+    put(':');
   }
 
   writeChars( triple.getName() );
@@ -849,9 +1366,9 @@ XMLOutputStream::writeName (const XMLTriple& triple)
 void
 XMLOutputStream::writeValue (const std::string& value)
 {
-  mStream << '=' << '"';
+  put("=\"");
   writeChars(value);
-  mStream << '"';
+  put('"');
 }
 
 /*
@@ -860,9 +1377,9 @@ XMLOutputStream::writeValue (const std::string& value)
 void
 XMLOutputStream::writeValue (const char* value)
 {
-  mStream << '=' << '"';
+  put("=\"");
   writeChars(value);
-  mStream << '"';
+  put('"');
 }
 
 
@@ -872,7 +1389,9 @@ XMLOutputStream::writeValue (const char* value)
 void
 XMLOutputStream::writeValue (const bool& value)
 {
-  mStream << '=' << '"' << (value ? "true" : "false") << '"';
+  put("=\"");
+  put(value ? "true" : "false");
+  put('"');
 }
 
 
@@ -882,27 +1401,27 @@ XMLOutputStream::writeValue (const bool& value)
 void
 XMLOutputStream::writeValue (const double& value)
 {
-  mStream << '=' << '"';
+  put("=\"");
 
   if (value != value)
   {
-    mStream << "NaN";
+    put("NaN");
   }
   else if (value == numeric_limits<double>::infinity())
   {
-    mStream << "INF";
+    put("INF");
   }
   else if (value == - numeric_limits<double>::infinity())
   {
-    mStream << "-INF";
+    put("-INF");
   }
   else
   {
-    mStream.precision(LIBSBML_DOUBLE_PRECISION);
-    mStream <<   value;
+    char buffer[DOUBLE_BUFFER_SIZE];
+    put(buffer, formatDouble(buffer, value));
   }
 
-  mStream << '"';
+  put('"');
 }
 
 
@@ -912,7 +1431,9 @@ XMLOutputStream::writeValue (const double& value)
 void
 XMLOutputStream::writeValue (const long& value)
 {
-  mStream << '=' << '"' << value << '"';
+  put("=\"");
+  putNumber(value);
+  put('"');
 }
 
 
@@ -922,7 +1443,9 @@ XMLOutputStream::writeValue (const long& value)
 void
 XMLOutputStream::writeValue (const int& value)
 {
-  mStream << '=' << '"' << value << '"';
+  put("=\"");
+  putNumber((long)value);
+  put('"');
 }
 
 
@@ -932,7 +1455,9 @@ XMLOutputStream::writeValue (const int& value)
 void
 XMLOutputStream::writeValue (const unsigned int& value)
 {
-  mStream << '=' << '"' << value << '"';
+  put("=\"");
+  putNumber(value);
+  put('"');
 }
 
 void
@@ -955,12 +1480,12 @@ XMLOutputStream::unsetStringStream()
 void
 XMLOutputStream::writeXMLDecl ()
 {
-  mStream << "<?xml version=\"1.0\"";
+  put("<?xml version=\"1.0\"");
 
   if ( !mEncoding.empty() ) writeAttribute("encoding", mEncoding);
 
-  mStream << "?>";
-  mStream << endl;
+  put("?>");
+  putNewline();
 }
 
 
@@ -978,12 +1503,14 @@ XMLOutputStream::writeComment (const std::string& programName,
   if (programName.empty())
     return;
 
-  mStream << "<!-- Created by " << programName;
+  put("<!-- Created by ");
+  put(programName);
 
   // only write program version if we have it
   if (!programVersion.empty())
   {
-    mStream << " version " << programVersion;
+    put(" version ");
+    put(programVersion);
   }
 
   // only compute timestamp if we need to
@@ -1002,22 +1529,25 @@ XMLOutputStream::writeComment (const std::string& programName,
             now->tm_year+1900, now->tm_mon+1, now->tm_mday,
             now->tm_hour, now->tm_min);
 #endif
-    mStream << " on " << formattedDateAndTime;
+    put(" on ");
+    put(formattedDateAndTime);
   }
 
   // write library information
   if (!mLibraryName.empty())
   {
-    mStream << " with " << mLibraryName;
+    put(" with ");
+    put(mLibraryName);
 
     if (!mLibraryVersion.empty())
     {
-      mStream << " version " << mLibraryVersion;
+      put(" version ");
+      put(mLibraryVersion);
     }
   }
 
-  mStream << ". -->";
-  mStream << endl;
+  put(". -->");
+  putNewline();
 
 }
 
@@ -1031,7 +1561,7 @@ XMLOutputStream::operator<< (const std::string& chars)
   if (mInStart)
   {
     mInStart = false;
-    mStream << '>';
+    put('>');
   }
 
   writeChars(chars);
@@ -1051,10 +1581,11 @@ XMLOutputStream::operator<< (const double& value)
   if (mInStart)
   {
     mInStart = false;
-    mStream << '>';
+    put('>');
   }
 
-  mStream << value;
+  char buffer[DOUBLE_BUFFER_SIZE];
+  put(buffer, formatDouble(buffer, value));
 
   return *this;
 }
@@ -1069,10 +1600,10 @@ XMLOutputStream::operator<< (const long& value)
   if (mInStart)
   {
     mInStart = false;
-    mStream << '>';
+    put('>');
   }
 
-  mStream << value;
+  putNumber(value);
 
   return *this;
 }
@@ -1088,19 +1619,19 @@ XMLOutputStream::operator<< (const char& c)
   {
     // outputs '&' as-is because the '&' is the first letter
     // of a character reference (e.g. &#0168; )
-    mStream << c;
+    put(c);
     mNextAmpersandIsRef = false;
     return *this;
   }
   
   switch (c)
   {
-    case '&' : mStream << "&amp;" ; break;
-    case '\'': mStream << "&apos;"; break;
-    case '<' : mStream << "&lt;"  ; break;
-    case '>' : mStream << "&gt;"  ; break;
-    case '"' : mStream << "&quot;"; break;
-    default  : mStream << c;        break;
+    case '&' : put("&amp;" ); break;
+    case '\'': put("&apos;"); break;
+    case '<' : put("&lt;"  ); break;
+    case '>' : put("&gt;"  ); break;
+    case '"' : put("&quot;"); break;
+    default  : put(c);        break;
   }
 
   return *this;
@@ -1175,6 +1706,71 @@ void XMLOutputStream::setIndent(unsigned int indent)
   mIndent = indent;
 }
 
+
+/*
+ * Writes the given double in the style of printf("%.15g"), with as many
+ * digits as it takes to read back the same value.
+ */
+unsigned int
+XMLOutputStream::formatDouble (char* buffer, double value)
+{
+  if (value == 0)
+  {
+    return layoutDecimal(buffer, util_isNegZero(value) != 0, "0", 1, 0);
+  }
+  else if (value != value)
+  {
+    strcpy(buffer, "nan");
+    return 3;
+  }
+
+  const bool negative = (value < 0);
+  const double magnitude = negative ? -value : value;
+
+  if (util_isInf(value))
+  {
+    strcpy(buffer, negative ? "-inf" : "inf");
+    return negative ? 4 : 3;
+  }
+
+  char text[24];
+  int  numDigits = 0;
+  int  exponent  = 0;
+
+  unsigned long long digits;
+
+  if (findShortestDecimal(magnitude, digits, exponent))
+  {
+    for (char* p = text + sizeof(text); digits > 0; digits /= 10)
+    {
+      *--p = (char)('0' + digits % 10);
+      ++numDigits;
+    }
+
+    memmove(text, text + sizeof(text) - numDigits, numDigits);
+  }
+  else
+  {
+    grisu2(magnitude, text, numDigits, exponent);
+
+    // findShortestDecimal() finds any decimal of up to 15 digits between
+    // 1e-7 and 1e37; outside that range Grisu2 has to be checked
+    if (numDigits > 15 && (magnitude < 1e-7 || magnitude >= 1e37))
+    {
+      shortenTo15Digits(magnitude, text, numDigits, exponent);
+    }
+  }
+
+  while (numDigits > 1 && text[numDigits - 1] == '0')
+  {
+    --numDigits;
+    ++exponent;
+  }
+
+  return layoutDecimal(buffer, negative, text, numDigits,
+                       exponent + numDigits - 1);
+}
+
 XMLOutputStream::~XMLOutputStream()
 {
   if (mSBMLns != NULL) 
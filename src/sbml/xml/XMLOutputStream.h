@@ -243,6 +243,7 @@ on yyyy-MM-dd HH:mm with libSBML version <libsbml version>. -->
 LIBSBML_CPP_NAMESPACE_BEGIN
 
 class XMLTriple;
+class XMLOutputSink;
 
 
 class LIBLAX_EXTERN XMLOutputStream
@@ -777,6 +778,33 @@ on yyyy-MM-dd HH:mm with libSBML version <libsbml version>. -->
   /** @cond doxygenLibsbmlInternal */
   unsigned int getIndent();
   void setIndent(unsigned int indent);
+
+
+  /**
+   * The size of a buffer large enough for any value written by
+   * formatDouble(), including the terminating NUL.
+   */
+  static const unsigned int DOUBLE_BUFFER_SIZE = 32;
+
+
+  /**
+   * Writes the given double to @p buffer in the style of
+   * <code>printf("%.15g")</code>, independently of the current locale.
+   *
+   * The shortest decimal that reads back as the same double is written.
+   * Values that need no more than 15 significant digits are written
+   * exactly as with a precision of 15; the others get 16 or 17 digits,
+   * so that no value loses precision.  Infinity and NaN are written as
+   * "inf", "-inf" and "nan"; callers that need the XML spellings handle
+   * them before calling this.
+   *
+   * @param buffer a buffer of at least DOUBLE_BUFFER_SIZE characters.
+   * @param value the value to write.
+   *
+   * @return the number of characters written, not counting the
+   * terminating NUL.
+   */
+  static unsigned int formatDouble (char* buffer, double value);
   /** @endcond */
 
 private:
@@ -873,6 +901,29 @@ protected:
   void writeValue (const unsigned int& value);
 
 
+  /**
+   * Outputs the given characters to the underlying stream, or straight
+   * into its buffer if the stream is an XMLOutputSink.
+   */
+  void put (char c);
+  void put (const char* chars);
+  void put (const char* chars, size_t length);
+  void put (const std::string& chars);
+
+
+  /**
+   * Outputs the given number to the underlying stream or sink.
+   */
+  void putNumber (long value);
+  void putNumber (unsigned int value);
+
+
+  /**
+   * Ends the current line.
+   */
+  void putNewline ();
+
+
   std::ostream& mStream;
   std::string   mEncoding;
 
@@ -907,6 +958,9 @@ protected:
   void setStringStream();
   void unsetStringStream();
 
+  // the wrapped stream if it is an XMLOutputSink, NULL otherwise
+  XMLOutputSink* mSink;
+
   /** @endcond */
 };
 
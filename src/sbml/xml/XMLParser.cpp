@@ -43,6 +43,8 @@
  * also available online as http://sbml.org/software/libsbml/license.html
  * ---------------------------------------------------------------------- -->*/
 
+#include <climits>
+#include <sys/stat.h>
 
 #ifdef USE_EXPAT
 #include <sbml/xml/ExpatParser.h>
@@ -57,6 +59,8 @@
 #endif
 
 #include <sbml/xml/XMLErrorLog.h>
+#include <sbml/xml/XMLFileBuffer.h>
+#include <sbml/xml/XMLMmapBuffer.h>
 #include <sbml/xml/XMLParser.h>
 
 using namespace std;
@@ -67,7 +71,10 @@ LIBSBML_CPP_NAMESPACE_BEGIN
  * Creates a new XMLParser.  The parser will notify the given XMLHandler
  * of parse events and errors.
  */
-XMLParser::XMLParser () : mErrorLog(NULL)
+XMLParser::XMLParser () :
+   mErrorLog          ( NULL )
+ , mChunkSize         ( DEFAULT_CHUNK_SIZE )
+ , mMemoryMapThreshold( 0 )
 {
 }
 
@@ -140,5 +147,96 @@ XMLParser::setErrorLog (XMLErrorLog* log)
 }
 
 
+/*
+ * @return the number of bytes this parser reads from its input at a time.
+ */
+unsigned int
+XMLParser::getChunkSize () const
+{
+  return mChunkSize;
+}
+
+
+/*
+ * Sets the number of bytes this parser reads from its input at a time.
+ */
+int
+XMLParser::setChunkSize (unsigned int size)
+{
+  // the underlying libraries take chunk lengths as int
+  if (size == 0 || size > (unsigned int)INT_MAX)
+  {
+    return LIBSBML_INVALID_ATTRIBUTE_VALUE;
+  }
+
+  mChunkSize = size;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/*
+ * @return the size from which uncompressed files are memory-mapped.
+ */
+size_t
+XMLParser::getMemoryMapThreshold () const
+{
+  return mMemoryMapThreshold;
+}
+
+
+/*
+ * Sets the size from which uncompressed files are memory-mapped.
+ */
+void
+XMLParser::setMemoryMapThreshold (size_t size)
+{
+  mMemoryMapThreshold = size;
+}
+
+
+/*
+ * Creates the XMLBuffer reading the given file.
+ */
+XMLBuffer*
+XMLParser::createFileBuffer (const char* filename)
+{
+  if ( isMemoryMapCandidate(filename) )
+  {
+    XMLMmapBuffer* buffer = new XMLMmapBuffer(filename);
+    if ( !buffer->error() ) return buffer;
+
+    // fall back to reading the file through a stream
+    delete buffer;
+  }
+
+  return new XMLFileBuffer(filename);
+}
+
+
+/*
+ * @return true if the given file is uncompressed and at least
+ * getMemoryMapThreshold() bytes long.
+ */
+bool
+XMLParser::isMemoryMapCandidate (const char* filename) const
+{
+  if ( mMemoryMapThreshold == 0 || filename == NULL ) return false;
+
+  const string name = filename;
+
+  bool compressed =
+    ( string::npos != name.find(".gz",  name.length() - 3) ) ||
+    ( string::npos != name.find(".bz2", name.length() - 4) ) ||
+    ( string::npos != name.find(".zip", name.length() - 4) );
+
+  if ( compressed ) return false;
+
+  struct stat info;
+
+  return ( stat(filename, &info) == 0 &&
+           (size_t)info.st_size >= mMemoryMapThreshold );
+}
+
+
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
@@ -54,12 +54,14 @@
 
 #ifdef __cplusplus
 
+#include <cstddef>
 #include <string>
 #include <sbml/xml/XMLExtern.h>
 #include <sbml/common/operationReturnValues.h>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
+class XMLBuffer;
 class XMLErrorLog;
 class XMLHandler;
 
@@ -179,6 +181,67 @@ public:
   int setErrorLog (XMLErrorLog* log);
 
 
+  /**
+   * Returns the number of bytes this parser reads from its input at a
+   * time.
+   *
+   * @return the chunk size in bytes.
+   */
+  unsigned int getChunkSize () const;
+
+
+  /**
+   * Sets the number of bytes this parser reads from its input at a time.
+   * Larger chunks mean fewer reads (and, for input that cannot be mapped,
+   * fewer copies) when parsing large documents.  The default is
+   * XMLParser::DEFAULT_CHUNK_SIZE.  The new size takes effect with the
+   * next call to parseNext().
+   *
+   * @param size the chunk size in bytes; must be greater than zero and no
+   * larger than @c INT_MAX.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_ATTRIBUTE_VALUE, OperationReturnValues_t}
+   */
+  int setChunkSize (unsigned int size);
+
+
+  /**
+   * Returns the size from which uncompressed files are memory-mapped
+   * rather than read through a stream.
+   *
+   * @return the threshold in bytes; @c 0 means files are never mapped.
+   */
+  size_t getMemoryMapThreshold () const;
+
+
+  /**
+   * Sets the size from which uncompressed files are memory-mapped rather
+   * than read through a stream.  The content of a mapped file is handed to
+   * the underlying XML library directly, without first being copied into
+   * an intermediate buffer.  Compressed files are never mapped.  The new
+   * threshold takes effect with the next call to parseFirst().
+   *
+   * @param size the threshold in bytes; @c 0 disables mapping.
+   */
+  void setMemoryMapThreshold (size_t size);
+
+
+  /**
+   * The default number of bytes read from the input at a time.
+   */
+  static const unsigned int DEFAULT_CHUNK_SIZE = 8192;
+
+
+  /**
+   * The file size from which SBMLReader memory-maps files by default.
+   * Smaller files are read in a few chunks, so there is little to gain
+   * from mapping them.
+   */
+  static const size_t DEFAULT_MEMORY_MAP_THRESHOLD = 1048576;
+
+
 protected:
   /**
    * Creates a new XMLParser.  The parser will notify the given XMLHandler
@@ -189,7 +252,30 @@ protected:
    */
   XMLParser ();
 
+
+  /**
+   * Creates the XMLBuffer reading the given file: an XMLMmapBuffer if the
+   * file is uncompressed and at least getMemoryMapThreshold() bytes long,
+   * an XMLFileBuffer otherwise.
+   *
+   * @throws ZlibNotLinked, Bzip2NotLinked as XMLFileBuffer does.
+   */
+  XMLBuffer* createFileBuffer (const char* filename);
+
+
+  /**
+   * Returns @c true if the given file is uncompressed and at least
+   * getMemoryMapThreshold() bytes long, so that it should be mapped
+   * rather than read through a stream.
+   */
+  bool isMemoryMapCandidate (const char* filename) const;
+
+
   XMLErrorLog* mErrorLog;
+
+  unsigned int mChunkSize;
+
+  size_t       mMemoryMapThreshold;
 };
 
 
@@ -55,6 +55,7 @@
 
 #include <sbml/xml/XMLHandler.h>
 #include <sbml/xml/XMLErrorLog.h>
+#include <sbml/xml/XMLMmapBuffer.h>
 
 #include <sbml/xml/XercesTranscode.h>
 #include <sbml/xml/XercesParser.h>
@@ -365,6 +366,7 @@ XercesParser::XercesParser (XMLHandler& handler) :
    mReader         ( NULL    )
  , mSource         ( NULL    )
  , mHandler        ( handler )
+ , mMappedFile     ( NULL    )
 {
   try
   {
@@ -393,6 +395,7 @@ XercesParser::~XercesParser ()
 {
   delete mReader;
   delete mSource;
+  delete mMappedFile;
   XMLPlatformUtils::Terminate();
 }
 
@@ -480,18 +483,53 @@ XercesParser::createSource (const char* content, bool isFile)
     }
     else
     {
-      XMLCh* filename = XMLString::transcode(content);
+      if ( isMemoryMapCandidate(content) )
+      {
+        mMappedFile = new XMLMmapBuffer(content);
+
+        // fall back to reading the file through Xerces
+        if ( mMappedFile->error() )
+        {
+          delete mMappedFile;
+          mMappedFile = NULL;
+        }
+      }
 
-      try
+      if ( mMappedFile != NULL )
       {
-        source = new LocalFileInputSource(filename);
+        // Xerces reads the mapped file in place; the mapping is kept until
+        // parseReset() has deleted the source.
+
+        const XMLByte* bytes =
+          reinterpret_cast<const XMLByte*>(mMappedFile->getData());
+
+        try
+        {
+          source = new MemBufInputSource(bytes,
+                                         (XercesSize_t)mMappedFile->getSize(),
+                                         content, false);
+        }
+        catch (...)
+        {
+        }
+
+        if ( source == NULL ) reportError(XMLOutOfMemory, content, 0, 0);
       }
-      catch (const XMLException& )
+      else
       {
-        reportError(XMLFileUnreadable, content, 0, 0);
+        XMLCh* filename = XMLString::transcode(content);
+
+        try
+        {
+          source = new LocalFileInputSource(filename);
+        }
+        catch (const XMLException& )
+        {
+          reportError(XMLFileUnreadable, content, 0, 0);
+        }
+
+        XMLString::release(&filename);
       }
-
-      XMLString::release(&filename);
     }
   }
   else
@@ -704,6 +742,9 @@ XercesParser::parseReset ()
 
   delete mSource;
   mSource = NULL;
+
+  delete mMappedFile;
+  mMappedFile = NULL;
 }
 
 LIBSBML_CPP_NAMESPACE_END
@@ -57,6 +57,7 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 
 class SAX2XMLReader;
 class XMLHandler;
+class XMLMmapBuffer;
 
 
 class XercesParser : public XMLParser
@@ -159,6 +160,7 @@ protected:
   xercesc::InputSource*    mSource;
   xercesc::XMLPScanToken   mToken;
   XercesHandler            mHandler;
+  XMLMmapBuffer*           mMappedFile;
 
 
 private:
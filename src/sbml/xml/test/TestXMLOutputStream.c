@@ -178,6 +178,34 @@ START_TEST (test_XMLOutputStream_Elements)
 }
 END_TEST
 
+START_TEST (test_XMLOutputStream_Doubles)
+{
+  XMLOutputStream_t *stream = XMLOutputStream_createAsString("", 0);
+  XMLOutputStream_startElement(stream, "fred");
+  XMLOutputStream_writeAttributeDouble(stream, "a", 0.1);
+  XMLOutputStream_writeAttributeDouble(stream, "b", -3.5e-7);
+  XMLOutputStream_writeAttributeDouble(stream, "c", 6.02214179e23);
+  XMLOutputStream_writeAttributeDouble(stream, "d", 123456789012345.0);
+  XMLOutputStream_writeAttributeDouble(stream, "e", 1.0/3.0);
+  XMLOutputStream_writeAttributeDouble(stream, "f", 0.1 + 0.2);
+  XMLOutputStream_writeAttributeDouble(stream, "g", 1e-300);
+  XMLOutputStream_writeAttributeDouble(stream, "h", 0.0);
+  XMLOutputStream_endElement(stream, "fred");
+
+  const char * expected = "<fred a=\"0.1\" b=\"-3.5e-07\" c=\"6.02214179e+23\" "
+    "d=\"123456789012345\" e=\"0.3333333333333333\" "
+    "f=\"0.30000000000000004\" g=\"1e-300\" h=\"0\"/>";
+  const char * s = XMLOutputStream_getString(stream);
+
+  fail_unless(!strcmp(s,expected));
+  
+  safe_free((void*)(s));
+
+  XMLOutputStream_free(stream);
+
+}
+END_TEST
+
 START_TEST (test_XMLOutputStream_CharacterReference)
 {
   XMLOutputStream_t *stream = XMLOutputStream_createAsString("", 0);
@@ -300,6 +328,7 @@ create_suite_XMLOutputStream (void)
   tcase_add_test( tcase, test_XMLOutputStream_createStringWithProgramInfo  );
   tcase_add_test( tcase, test_XMLOutputStream_startEnd  );
   tcase_add_test( tcase, test_XMLOutputStream_Elements  );
+  tcase_add_test( tcase, test_XMLOutputStream_Doubles  );
   tcase_add_test( tcase, test_XMLOutputStream_CharacterReference );
   tcase_add_test( tcase, test_XMLOutputStream_PredefinedEntity );
 